@@ -0,0 +1,46 @@
+dnl -*- mode: autoconf -*-
+
+dnl
+dnl This file is part of the Score-P software (http://www.score-p.org)
+dnl
+dnl Copyright (c) 2026,
+dnl Forschungszentrum Juelich GmbH, Germany
+dnl
+dnl This software may be modified and distributed under the terms of
+dnl a BSD-style license.  See the COPYING file in the package base
+dnl directory for details.
+dnl
+
+dnl file scorep_atomic_builtins.m4
+
+# SCOREP_ATOMIC_BUILTINS
+# ----------------------
+# Check whether the C compiler provides the __atomic builtins on 64 bit
+# integers and pointers, as used by SCOREP_Atomic.h.
+# Defines HAVE_SCOREP_ATOMIC_BUILTINS.
+AC_DEFUN([SCOREP_ATOMIC_BUILTINS], [
+AC_LANG_PUSH([C])
+AC_MSG_CHECKING([for __atomic builtins])
+AC_LINK_IFELSE(
+    [AC_LANG_SOURCE([[
+#include <stdint.h>
+uint64_t value;
+void*    pointer;
+int main()
+{
+    uint64_t expected = __atomic_load_n( &value, __ATOMIC_ACQUIRE );
+    __atomic_store_n( &value, expected + 1, __ATOMIC_RELEASE );
+    __atomic_fetch_add( &value, 1, __ATOMIC_RELAXED );
+    __atomic_fetch_sub( &value, 1, __ATOMIC_ACQ_REL );
+    __atomic_compare_exchange_n( &value, &expected, 0, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED );
+    __atomic_exchange_n( &pointer, &value, __ATOMIC_ACQ_REL );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    return 0;
+}
+        ]])],
+    [AC_MSG_RESULT(yes)
+     AC_DEFINE(HAVE_SCOREP_ATOMIC_BUILTINS, 1, [Can link the __atomic builtins])],
+    [AC_MSG_RESULT([no, using __sync builtins])
+    ])
+AC_LANG_POP([C])
+]) # SCOREP_ATOMIC_BUILTINS
@@ -163,6 +163,9 @@ AC_SUBST([SCOREP_HAVE_PTHREAD_SUPPORT], [${scorep_pthread_support}])
 AFS_AM_CONDITIONAL([HAVE_PTHREAD_SUPPORT], [test "x${scorep_pthread_support}" = x1], [false])
 AFS_AM_CONDITIONAL([HAVE_PTHREAD_WITHOUT_FLAGS],
     [test "x${PTHREAD_CFLAGS}" = x && test "x${PTHREAD_LIBS}" = x], [false])
+AC_SCOREP_COND_HAVE([METRIC_SYSTEM_SAMPLER],
+                    [test "x${scorep_pthread_support}" = x1],
+                    [Defined if the system metric sampler is available.])
 AM_COND_IF([HAVE_PTHREAD_SUPPORT],
    [AFS_SUMMARY([Pthread support], [yes, using ${PTHREAD_CC} ${PTHREAD_CFLAGS} ${PTHREAD_LIBS}])],
    [AFS_SUMMARY([Pthread support], [no${scorep_pthread_summary_reason}])])
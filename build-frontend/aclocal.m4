@@ -1244,6 +1244,7 @@ m4_include([../build-config/m4/ltoptions.m4])
 m4_include([../build-config/m4/ltsugar.m4])
 m4_include([../build-config/m4/ltversion.m4])
 m4_include([../build-config/m4/lt~obsolete.m4])
+m4_include([../build-config/m4/scorep_atomic_builtins.m4])
 m4_include([../build-config/m4/scorep_cobi.m4])
 m4_include([../build-config/m4/scorep_dirent.m4])
 m4_include([../build-config/m4/scorep_error_codes.m4])
@@ -1156,6 +1156,7 @@ m4_include([../vendor/common/build-config/m4/ac_scorep_svn_controlled.m4])
 m4_include([../vendor/common/build-config/m4/afs_maintainer_mode.m4])
 m4_include([../vendor/common/build-config/m4/afs_summary.m4])
 m4_include([../vendor/common/build-config/m4/ax_compiler_vendor.m4])
+m4_include([../vendor/common/build-config/m4/ax_pthread.m4])
 m4_include([../build-config/m4/libtool.m4])
 m4_include([../build-config/m4/ltoptions.m4])
 m4_include([../build-config/m4/ltsugar.m4])
@@ -1164,3 +1165,4 @@ m4_include([../build-config/m4/lt~obsolete.m4])
 m4_include([../build-config/m4/scorep_cube4.m4])
 m4_include([../build-config/m4/scorep_error_codes.m4])
 m4_include([../build-config/m4/scorep_estimator.m4])
+m4_include([../build-config/m4/scorep_pthread.m4])
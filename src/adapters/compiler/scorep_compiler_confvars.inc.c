@@ -39,12 +39,18 @@
 #include <SCOREP_Config.h>
 
 #include <stdlib.h>
+#include <stdbool.h>
 
 /**
    Filename of file containing nm -l output for compiler instrumentation.
  */
 char* scorep_compiler_nm_symbols = NULL;
 
+/**
+   Whether symbols are resolved on the first entry of a function.
+ */
+bool scorep_compiler_lazy_symbols;
+
 /**
    Configuration variables for the compiler adapter.
    Current configuration variables are:
@@ -67,6 +73,21 @@ static const SCOREP_ConfigVariable scorep_compiler_confvars[] = {
         "Only needed if generating the file at measurement initialization time fails, e.g., "
         "if using the 'system()' command from the compute nodes isn't possible."
     },
+    {
+        "lazy_symbols",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_compiler_lazy_symbols,
+        NULL,
+        "false",
+        "Resolve function symbols on their first entry for compiler instrumentation",
+        "Instead of reading, demangling, and filtering the whole symbol table of "
+        "the <application> at measurement initialization, look up a function "
+        "address in the ELF symbol tables of the loaded executable and shared "
+        "objects when the function is entered the first time. Shared objects "
+        "loaded later via dlopen are covered too. Only the called functions are "
+        "demangled and filtered. Source file and line number are not available "
+        "for the regions in this mode. Ignored if SCOREP_NM_SYMBOLS is set."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
 
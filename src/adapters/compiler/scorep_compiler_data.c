@@ -44,53 +44,43 @@
 
 #define SCOREP_DEBUG_MODULE_NAME COMPILER
 #include <UTILS_Debug.h>
+#include <UTILS_Error.h>
 #include <UTILS_CStr.h>
 
 #include <SCOREP_Definitions.h>
+#include <SCOREP_Hashtab.h>
 
 /**
-   A hash table which stores information about regions under their name as
-   key. Mainly used to obtain the region handle from the region name.
+   A hash table which stores information about regions under their address as
+   key. Mainly used to obtain the region handle from the function address.
  */
-static
-scorep_compiler_hash_node* region_hash_table[ SCOREP_COMPILER_REGION_SLOTS ];
+static SCOREP_ConcurrentHashtab* region_hash_table;
 
 /* ***************************************************************************************
    Region hash table functions
 *****************************************************************************************/
 
-/* Initialize slots of compiler hash table. */
+/* Initialize compiler hash table. */
 void
 scorep_compiler_hash_init( void )
 {
-    uint64_t i;
-
-    for ( i = 0; i < SCOREP_COMPILER_REGION_SLOTS; i++ )
-    {
-        region_hash_table[ i ] = NULL;
-    }
+    region_hash_table = SCOREP_ConcurrentHashtab_CreateSize( SCOREP_COMPILER_REGION_SLOTS,
+                                                             &SCOREP_Hashtab_HashInt64,
+                                                             &SCOREP_Hashtab_CompareUint64 );
+    UTILS_BUG_ON( region_hash_table == NULL, "Failed to create the compiler region table." );
 }
 
 /* Get hash table entry for given ID. */
 scorep_compiler_hash_node*
 scorep_compiler_hash_get( uint64_t key )
 {
-    uint64_t hash_code = key % SCOREP_COMPILER_REGION_SLOTS;
+    UTILS_DEBUG( "key %" PRIx64, key );
 
-    UTILS_DEBUG( "hash code %" PRIx64, hash_code );
-
-    scorep_compiler_hash_node* curr = region_hash_table[ hash_code ];
-    /* The tail after curr will never change because, new elements are inserted before
-       curr. Thus, it allows a parallel @ref scorep_compiler_hash_put which can only
-       insert a new element before curr.
-     */
-    while ( curr )
+    /* Lookups do not need to be synchronized with @ref scorep_compiler_hash_put. */
+    SCOREP_Hashtab_Entry* entry = SCOREP_ConcurrentHashtab_Find( region_hash_table, &key, NULL );
+    if ( entry )
     {
-        if ( curr->key == key )
-        {
-            return curr;
-        }
-        curr = curr->next;
+        return entry->value.ptr;
     }
     return NULL;
 }
@@ -98,64 +88,48 @@ scorep_compiler_hash_get( uint64_t key )
 
 /* Stores function name under hash code */
 scorep_compiler_hash_node*
-scorep_compiler_hash_put( uint64_t      key,
-                          const char*   region_name_mangled,
-                          const char*   region_name_demangled,
-                          const char*   file_name,
-                          SCOREP_LineNo line_no_begin )
+scorep_compiler_hash_put( uint64_t            key,
+                          const char*         region_name_mangled,
+                          const char*         region_name_demangled,
+                          const char*         file_name,
+                          SCOREP_LineNo       line_no_begin,
+                          SCOREP_RegionHandle region_handle )
 {
-    uint64_t                   hash_code = key % SCOREP_COMPILER_REGION_SLOTS;
-    scorep_compiler_hash_node* add       = ( scorep_compiler_hash_node* )
-                                           malloc( sizeof( scorep_compiler_hash_node ) );
+    scorep_compiler_hash_node* add = ( scorep_compiler_hash_node* )
+                                     malloc( sizeof( scorep_compiler_hash_node ) );
     add->key                   = key;
     add->region_name_mangled   = UTILS_CStr_dup( region_name_mangled );
     add->region_name_demangled = UTILS_CStr_dup( region_name_demangled );
     add->file_name             = UTILS_CStr_dup( file_name );
     add->line_no_begin         = line_no_begin;
     add->line_no_end           = SCOREP_INVALID_LINE_NO;
-    add->region_handle         = SCOREP_INVALID_REGION;
-    /* Inserting elements at the head allows parallel calls to
-       @ref scorep_compiler_hash_get
-     */
-    add->next                      = region_hash_table[ hash_code ];
-    region_hash_table[ hash_code ] = add;
+    add->region_handle         = region_handle;
+    /* The node becomes visible to @ref scorep_compiler_hash_get only after
+       it is initialized. */
+    SCOREP_ConcurrentHashtab_InsertPtr( region_hash_table, &add->key, add, NULL );
     return add;
 }
 
 
+static void
+delete_node( void* item )
+{
+    scorep_compiler_hash_node* node = item;
+    free( node->region_name_mangled );
+    free( node->region_name_demangled );
+    free( node->file_name );
+    free( node );
+}
+
 /* Free elements of compiler hash table. */
 void
 scorep_compiler_hash_free( void )
 {
-    scorep_compiler_hash_node* next;
-    scorep_compiler_hash_node* cur;
-    uint64_t                   i;
-    for ( i = 0; i < SCOREP_COMPILER_REGION_SLOTS; i++ )
-    {
-        if ( region_hash_table[ i ] )
-        {
-            cur = region_hash_table[ i ];
-            while ( cur != NULL )
-            {
-                next = cur->next;
-                if ( cur->region_name_mangled != NULL )
-                {
-                    free( cur->region_name_mangled );
-                }
-                if ( cur->region_name_demangled != NULL )
-                {
-                    free( cur->region_name_demangled );
-                }
-                if ( cur->file_name != NULL )
-                {
-                    free( cur->file_name );
-                }
-                free( cur );
-                cur = next;
-            }
-            region_hash_table[ i ] = NULL;
-        }
-    }
+    /* The key is part of the node. */
+    SCOREP_ConcurrentHashtab_FreeAll( region_hash_table,
+                                      &SCOREP_Hashtab_DeleteNone,
+                                      &delete_node );
+    region_hash_table = NULL;
 }
 
 /* Register a new region to the measurement system */
@@ -181,32 +155,6 @@ scorep_compiler_register_region( scorep_compiler_hash_node* node )
 void
 scorep_compiler_get_hash_statistics( void )
 {
-#if HAVE( UTILS_DEBUG )
-    unsigned elements         = 0;
-    unsigned occupied_buckets = 0;
-    unsigned collisions       = 0;
-    unsigned buckets          = SCOREP_COMPILER_REGION_SLOTS;
-    for ( int i = 0; i < SCOREP_COMPILER_REGION_SLOTS; ++i )
-    {
-        if ( !region_hash_table[ i ] )
-        {
-            continue;
-        }
-        scorep_compiler_hash_node* node = region_hash_table[ i ];
-        ++elements;
-        ++occupied_buckets;
-        while ( node->next )
-        {
-            ++elements;
-            ++collisions;
-            node = node->next;
-        }
-    }
-    UTILS_DEBUG( "Hashtable of size %d contains %d"
-                 " elements and exhibits %d collisions. Fill rate is %d%%.",
-                 buckets,
-                 elements,
-                 collisions,
-                 ( unsigned )( occupied_buckets / ( double )buckets * 100 ) );
-#endif
+    UTILS_DEBUG( "Hashtable contains %zu elements.",
+                 SCOREP_ConcurrentHashtab_Size( region_hash_table ) );
 }
@@ -45,9 +45,10 @@
 #include <SCOREP_Types.h>
 
 /**
-   @def SCOREP_COMPILER_HASH_MAX The number of slots in the region hash table.
+   @def SCOREP_COMPILER_REGION_SLOTS The initial number of slots in the region
+   hash table.
  */
-#define SCOREP_COMPILER_REGION_SLOTS 1021
+#define SCOREP_COMPILER_REGION_SLOTS 1024
 
 /**
    @def SCOREP_COMPILER_FILE_SLOTS The number of slots in the file hash table.
@@ -65,25 +66,25 @@
  * @param line_no_begin         line number of begin of function
  * @param line_no_end           line number of end of function
  * @param region_handle         region identifier
- * @param next                  pointer to next element with the same hash value.
  */
 typedef struct scorep_compiler_hash_node
 {
-    uint64_t                          key;
-    char*                             region_name_mangled;
-    char*                             region_name_demangled;
-    char*                             file_name;
-    SCOREP_LineNo                     line_no_begin;
-    SCOREP_LineNo                     line_no_end;
-    SCOREP_RegionHandle               region_handle;
-    struct scorep_compiler_hash_node* next;
+    uint64_t            key;
+    char*               region_name_mangled;
+    char*               region_name_demangled;
+    char*               file_name;
+    SCOREP_LineNo       line_no_begin;
+    SCOREP_LineNo       line_no_end;
+    SCOREP_RegionHandle region_handle;
 } scorep_compiler_hash_node;
 
 /**
    Returns the hash_node for the given key. If no node with the requested key exists,
    it returns NULL. In multithreaded environments, calls to this function do not need
    to be locked if it is guaranteed that initialization is already finished and
-   finalization will not start before this function returns.
+   finalization will not start before this function returns. It may run
+   concurrently to @ref scorep_compiler_hash_put, but might then miss the
+   node that is being added.
    @param key The key value.
    @returns the hash_node for the given key.
  */
@@ -91,20 +92,26 @@ extern scorep_compiler_hash_node*
 scorep_compiler_hash_get( uint64_t key );
 
 /**
-   Creates a new entry for the region hashtable with the given values.
+   Creates a new entry for the region hashtable with the given values. Calls
+   need to be serialized.
    @param key                   The key under which the new entry is stored.
    @param region_name_mangled   The mangled name of the region.
    @param region_name_demangled The demangled name of the region.
    @param file_name             The name of the source file of the registered region.
    @param line_no_begin         The source code line number where the region starts.
+   @param region_handle         The initial region handle of the entry, either
+                                SCOREP_INVALID_REGION or SCOREP_FILTERED_REGION.
+                                It is set before the entry becomes visible to
+                                @ref scorep_compiler_hash_get.
    @returns a pointer to the newly created hash node.
  */
 extern scorep_compiler_hash_node*
-scorep_compiler_hash_put( uint64_t      key,
-                          const char*   region_name_mangled,
-                          const char*   region_name_demangled,
-                          const char*   file_name,
-                          SCOREP_LineNo line_no_begin );
+scorep_compiler_hash_put( uint64_t            key,
+                          const char*         region_name_mangled,
+                          const char*         region_name_demangled,
+                          const char*         file_name,
+                          SCOREP_LineNo       line_no_begin,
+                          SCOREP_RegionHandle region_handle );
 
 /**
    Frees the memory allocated for the hash table.
@@ -128,8 +135,8 @@ scorep_compiler_register_region( scorep_compiler_hash_node* node );
 
 
 /**
- * In debug mode SCOREP_DEBUG_COMPILER, calculate and print hash table
- * statistics like number of elements and collisions and fill rate.
+ * In debug mode SCOREP_DEBUG_COMPILER, print hash table statistics like
+ * the number of elements.
  */
 extern void
 scorep_compiler_get_hash_statistics( void );
@@ -48,6 +48,7 @@
 
 #include "SCOREP_Compiler_Init.h"
 #include "scorep_compiler_data.h"
+#include "scorep_compiler_symbol_table.h"
 
 /* ***************************************************************************************
    Implementation of functions called by compiler instrumentation
@@ -90,18 +91,24 @@ SCOREP_COMPILER_GNU_FUNC_ENTER( void* func,
 
     scorep_compiler_hash_node* hash_node =
         scorep_compiler_hash_get( ( long )func );
-    if ( hash_node )
+    if ( hash_node == NULL && scorep_compiler_lazy_symbols )
     {
+        /* -- function entered the first time, look up its symbol -- */
+        hash_node = scorep_compiler_resolve_symbol( ( long )func );
+    }
+    if ( hash_node && hash_node->region_handle == SCOREP_INVALID_REGION )
+    {
+        SCOREP_MutexLock( scorep_compiler_region_mutex );
         if ( hash_node->region_handle == SCOREP_INVALID_REGION )
         {
-            SCOREP_MutexLock( scorep_compiler_region_mutex );
-            if ( hash_node->region_handle == SCOREP_INVALID_REGION )
-            {
-                /* -- region entered the first time, register region -- */
-                scorep_compiler_register_region( hash_node );
-            }
-            SCOREP_MutexUnlock( scorep_compiler_region_mutex );
+            /* -- region entered the first time, register region -- */
+            scorep_compiler_register_region( hash_node );
         }
+        SCOREP_MutexUnlock( scorep_compiler_region_mutex );
+    }
+    /* Check the handle again, it might have been set while waiting for the lock */
+    if ( hash_node && hash_node->region_handle != SCOREP_FILTERED_REGION )
+    {
         SCOREP_EnterRegion( hash_node->region_handle );
     }
 
@@ -137,7 +144,8 @@ SCOREP_COMPILER_GNU_FUNC_EXIT( void* func,
 #endif
 
     scorep_compiler_hash_node* hash_node;
-    if ( ( hash_node = scorep_compiler_hash_get( ( long )func ) ) )
+    if ( ( hash_node = scorep_compiler_hash_get( ( long )func ) )
+         && hash_node->region_handle != SCOREP_FILTERED_REGION )
     {
         SCOREP_ExitRegion( hash_node->region_handle );
     }
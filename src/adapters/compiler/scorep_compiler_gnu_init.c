@@ -95,6 +95,9 @@ scorep_compiler_subsystem_finalize( void )
     {
         /* Delete hash table */
         scorep_compiler_hash_free();
+
+        /* Release the symbol index of SCOREP_LAZY_SYMBOLS */
+        scorep_compiler_symbol_index_finalize();
     }
 
     /* Delete region mutex */
@@ -78,6 +78,75 @@ static int scorep_compiler_demangle_style = SCOREP_COMPILER_DEMANGLE_PARAMS  |
                                             SCOREP_COMPILER_DEMANGLE_TYPES;
 #endif /* HAVE( DEMANGLE ) */
 
+/**
+ * Looks up the region name in the hash table and registers the region
+ * if it is not already registered. The hash table allows a single writer
+ * only, thus the caller needs to hold scorep_compiler_region_mutex.
+ * @ param region_name function name
+ * @ param file_name   file name
+ * @ param line_no     line number
+ */
+static scorep_compiler_hash_node*
+get_region_locked( const char* region_name,
+                   const char* file_name,
+                   int         line_no )
+{
+    scorep_compiler_hash_node* hash_node;
+    long                       region_key = ( long )region_name;
+    if ( ( hash_node = scorep_compiler_hash_get( region_key ) ) == 0 )
+    {
+        char* file = UTILS_CStr_dup( file_name );
+        UTILS_IO_SimplifyPath( file );
+
+        const char* region_name_demangled = NULL;
+#if HAVE( DEMANGLE )
+        /* use demangled name if possible */
+        region_name_demangled = cplus_demangle( region_name,
+                                                scorep_compiler_demangle_style );
+#endif  /* HAVE( DEMANGLE ) */
+        if ( region_name_demangled == NULL )
+        {
+            region_name_demangled = region_name;
+            region_name           = NULL;
+        }
+
+        hash_node = scorep_compiler_hash_put( region_key,
+                                              region_name,
+                                              region_name_demangled,
+                                              file, line_no,
+                                              SCOREP_INVALID_REGION );
+        UTILS_DEBUG( "number %ld and put name -- %s -- to list",
+                     region_key, region_name );
+
+        /* Check for filters:
+             1. In case OpenMP is used, the XL compiler creates some
+                functions like <func_name>:<func_name>$OL$OL.1 on BG/P or
+                <func_name>@OL@1 on AIX which cause the measurement system
+                to crash. Thus, filter functions which names contain a '$'
+                or '@' symbol.
+                or the symbol starts with '__xl_' and has '_OL_' in it
+             2. POMP and POMP2 functions.
+         */
+        if ( strchr( region_name_demangled, '$' ) ||
+             strchr( region_name_demangled, '@' ) ||
+             strncmp( region_name_demangled, "POMP", 4 ) == 0 ||
+             strncmp( region_name_demangled, "Pomp", 4 ) == 0 ||
+             strncmp( region_name_demangled, "pomp", 4 ) == 0 ||
+             ( strncmp( region_name_demangled, "__xl_", 5 ) == 0 && strstr( region_name_demangled, "_OL_" ) ) ||
+             SCOREP_Filtering_Match( file, region_name_demangled, region_name ) )
+        {
+            hash_node->region_handle = SCOREP_INVALID_REGION;
+        }
+        else
+        {
+            scorep_compiler_register_region( hash_node );
+        }
+
+        free( file );
+    }
+    return hash_node;
+}
+
 /**
  * Looks up the region name in the hash table, registers the region
  * if it is not already registered and returns the region handle.
@@ -93,71 +162,14 @@ get_region_handle( const char* region_name,
 {
     UTILS_DEBUG_ENTRY( "%s in %s:%d", region_name, file_name, line_no );
 
-    /* put function to list */
     scorep_compiler_hash_node* hash_node;
-    long                       region_key = ( long )region_name;
-    if ( ( hash_node = scorep_compiler_hash_get( region_key ) ) == 0 )
+    if ( ( hash_node = scorep_compiler_hash_get( ( long )region_name ) ) == 0 )
     {
-        /* The IBM compiler instruments outlined functions of OpenMP parallel regions.
-           These functions are called at a stage, where locks do not yet work. Thus,
-           make sure that in case of race conditions, functions can only get filtered.
-         */
-#if defined( __IBMC__ ) && __IBMC__ <= 1100
+        /* The IBM compiler instruments outlined functions of OpenMP parallel
+           regions, thus several threads may see a new function at once. */
         SCOREP_MutexLock( scorep_compiler_region_mutex );
-#endif
-        if ( ( hash_node = scorep_compiler_hash_get( region_key ) ) == 0 )
-        {
-            char* file = UTILS_CStr_dup( file_name );
-            UTILS_IO_SimplifyPath( file );
-
-            const char* region_name_demangled = NULL;
-#if HAVE( DEMANGLE )
-            /* use demangled name if possible */
-            region_name_demangled = cplus_demangle( region_name,
-                                                    scorep_compiler_demangle_style );
-#endif      /* HAVE( DEMANGLE ) */
-            if ( region_name_demangled == NULL )
-            {
-                region_name_demangled = region_name;
-                region_name           = NULL;
-            }
-
-            hash_node = scorep_compiler_hash_put( region_key,
-                                                  region_name,
-                                                  region_name_demangled,
-                                                  file, line_no );
-            UTILS_DEBUG( "number %ld and put name -- %s -- to list",
-                         region_key, region_name );
-
-            /* Check for filters:
-                 1. In case OpenMP is used, the XL compiler creates some
-                    functions like <func_name>:<func_name>$OL$OL.1 on BG/P or
-                    <func_name>@OL@1 on AIX which cause the measurement system
-                    to crash. Thus, filter functions which names contain a '$'
-                    or '@' symbol.
-                    or the symbol starts with '__xl_' and has '_OL_' in it
-                 2. POMP and POMP2 functions.
-             */
-            if ( strchr( region_name_demangled, '$' ) ||
-                 strchr( region_name_demangled, '@' ) ||
-                 strncmp( region_name_demangled, "POMP", 4 ) == 0 ||
-                 strncmp( region_name_demangled, "Pomp", 4 ) == 0 ||
-                 strncmp( region_name_demangled, "pomp", 4 ) == 0 ||
-                 ( strncmp( region_name_demangled, "__xl_", 5 ) == 0 && strstr( region_name_demangled, "_OL_" ) ) ||
-                 SCOREP_Filtering_Match( file, region_name_demangled, region_name ) )
-            {
-                hash_node->region_handle = SCOREP_INVALID_REGION;
-            }
-            else
-            {
-                scorep_compiler_register_region( hash_node );
-            }
-
-            free( file );
-        }
-#if defined( __IBMC__ ) && __IBMC__ <= 1100
+        hash_node = get_region_locked( region_name, file_name, line_no );
         SCOREP_MutexUnlock( scorep_compiler_region_mutex );
-#endif
     }
     return hash_node->region_handle;
 }
@@ -199,7 +211,8 @@ __func_trace_enter( const char*          region_name,
         SCOREP_MutexLock( scorep_compiler_region_mutex );
         if ( *handle == 0 )
         {
-            SCOREP_RegionHandle region = get_region_handle( region_name, file_name, line_no );
+            SCOREP_RegionHandle region =
+                get_region_locked( region_name, file_name, line_no )->region_handle;
             if ( region == SCOREP_INVALID_REGION )
             {
                 *handle = SCOREP_FILTERED_REGION;
@@ -59,6 +59,7 @@
 #include <scorep_environment.h>
 #include <SCOREP_RuntimeManagement.h>
 
+#include "SCOREP_Compiler_Init.h"
 #include "scorep_compiler_data.h"
 
 /* ***************************************************************************************
@@ -90,13 +91,18 @@ static int scorep_compiler_demangle_style = SCOREP_COMPILER_DEMANGLE_PARAMS  |
    helper functions for symbol table analysis
 *****************************************************************************************/
 
-static void
-process_symbol( long         address,
-                const char*  funcname,
-                const char*  filename,
-                unsigned int lno )
+/**
+ * Adds the function to the hash table, unless it is filtered.
+ * @returns the new hash node, or NULL if the function is filtered.
+ */
+static scorep_compiler_hash_node*
+add_symbol( long         address,
+            const char*  funcname,
+            const char*  filename,
+            unsigned int lno )
 {
-    char* path = NULL;
+    scorep_compiler_hash_node* node = NULL;
+    char*                      path = NULL;
     if ( filename != NULL )
     {
         path = UTILS_CStr_dup( filename );
@@ -151,7 +157,8 @@ process_symbol( long         address,
 
     if ( use_address )
     {
-        scorep_compiler_hash_put( address, funcname, funcname_demangled, path, lno );
+        node = scorep_compiler_hash_put( address, funcname, funcname_demangled, path, lno,
+                                         SCOREP_INVALID_REGION );
         UTILS_DEBUG( "hash table: added %p:%s:%s:%d", address, funcname_demangled, path, lno );
     }
     else
@@ -160,6 +167,17 @@ process_symbol( long         address,
     }
 
     free( path );
+    return node;
+}
+
+
+static void
+process_symbol( long         address,
+                const char*  funcname,
+                const char*  filename,
+                unsigned int lno )
+{
+    add_symbol( address, funcname, filename, lno );
 }
 
 
@@ -331,6 +349,19 @@ scorep_compiler_load_symbols( void )
     bool        executable_name_is_file;
     const char* executable = SCOREP_GetExecutableName( &executable_name_is_file );
 
+    /* A provided symbol file takes precedence */
+    if ( scorep_compiler_lazy_symbols && !symbols_provided() )
+    {
+        if ( scorep_compiler_symbol_index_initialize() )
+        {
+            UTILS_DEBUG( "Resolving symbols on first function entry." );
+            return;
+        }
+        UTILS_WARNING( "SCOREP_LAZY_SYMBOLS is not supported on this platform, "
+                       "reading the whole symbol table instead." );
+    }
+    scorep_compiler_lazy_symbols = false;
+
     if ( symbols_provided() )
     {
         extern char* scorep_compiler_nm_symbols;
@@ -349,3 +380,35 @@ scorep_compiler_load_symbols( void )
                      "preferably with full path, via SCOREP_EXECUTABLE." );
     }
 }
+
+
+scorep_compiler_hash_node*
+scorep_compiler_resolve_symbol( long address )
+{
+    /* Look up the name outside of the region mutex, reading the program
+       headers takes the lock of the dynamic loader. */
+    const char* funcname = scorep_compiler_symbol_index_lookup( address );
+
+    SCOREP_MutexLock( scorep_compiler_region_mutex );
+    scorep_compiler_hash_node* node = scorep_compiler_hash_get( address );
+    if ( node == NULL )
+    {
+        if ( funcname != NULL )
+        {
+            node = add_symbol( address, funcname, "", SCOREP_INVALID_LINE_NO );
+        }
+        if ( node == NULL )
+        {
+            /* Lookups without the lock must never see this node unfiltered */
+            node = scorep_compiler_hash_put( address,
+                                             funcname ? funcname : "",
+                                             funcname ? funcname : "",
+                                             "",
+                                             SCOREP_INVALID_LINE_NO,
+                                             SCOREP_FILTERED_REGION );
+        }
+    }
+    SCOREP_MutexUnlock( scorep_compiler_region_mutex );
+
+    return node;
+}
@@ -32,6 +32,16 @@
 #define SCOREP_COMPILER_SYMBOL_TABLE_H
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+struct scorep_compiler_hash_node;
+
+/**
+   Whether symbols are resolved on the first entry of a function instead of
+   reading the whole symbol table at initialization (SCOREP_LAZY_SYMBOLS).
+ */
+extern bool scorep_compiler_lazy_symbols;
 
 typedef void
 ( * scorep_compiler_process_symbol_cb )( long         addr,
@@ -64,4 +74,38 @@ void
 scorep_compiler_parse_nm_file( const char*                       nmFilename,
                                scorep_compiler_process_symbol_cb processSymbol );
 
+/**
+ * Looks up the function that starts at @a address in the symbol tables of
+ * the loaded objects and adds it to the hash table, if SCOREP_LAZY_SYMBOLS is
+ * set. Functions that are filtered are added with the region handle
+ * SCOREP_FILTERED_REGION, thus every address is looked up only once.
+ * Must be called without holding the region mutex.
+ *
+ * @param address The address of the function.
+ * @returns the hash node for @a address, or NULL if no function starts there.
+ */
+struct scorep_compiler_hash_node*
+scorep_compiler_resolve_symbol( long address );
+
+/**
+ * Prepares the symbol index used if SCOREP_LAZY_SYMBOLS is set.
+ * @returns false if the platform does not support the symbol index.
+ */
+bool
+scorep_compiler_symbol_index_initialize( void );
+
+/**
+ * Returns the name of the function that starts at @a address, or NULL if
+ * there is none. Reads the symbol tables of objects that were not indexed
+ * before. The name remains valid until the index is finalized.
+ */
+const char*
+scorep_compiler_symbol_index_lookup( uint64_t address );
+
+/**
+ * Releases the symbol index.
+ */
+void
+scorep_compiler_symbol_index_finalize( void );
+
 #endif /* SCOREP_COMPILER_SYMBOL_TABLE_H */
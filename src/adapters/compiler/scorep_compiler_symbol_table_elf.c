@@ -0,0 +1,490 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * @brief Address-sorted index of the ELF symbol tables of the loaded objects.
+ *
+ * Used if SCOREP_LAZY_SYMBOLS is set. Scanning the program headers with
+ * dl_iterate_phdr records only the address ranges of the objects. The symbol
+ * table of an object is read from the mmap'd file when an address inside the
+ * object is looked up the first time. Objects loaded later via dlopen are
+ * found by rescanning the program headers, which also drops the objects that
+ * were unloaded meanwhile.
+ */
+
+#include <config.h>
+
+#include "scorep_compiler_symbol_table.h"
+
+#include <UTILS_Error.h>
+#define SCOREP_DEBUG_MODULE_NAME COMPILER
+#include <UTILS_Debug.h>
+
+#include <SCOREP_Mutex.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#if defined( __ELF__ )
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+typedef struct elf_symbol
+{
+    uint64_t    address;
+    const char* name;
+    int         binding;
+} elf_symbol;
+
+
+typedef struct elf_object elf_object;
+struct elf_object
+{
+    elf_object* next;
+    char*       pathname;     /* File to read the symbols from */
+    uint64_t    bias;         /* Difference of the load and link addresses */
+    uint64_t    text_start;   /* Start of the executable segments */
+    uint64_t    text_end;     /* End of the executable segments */
+    bool        symbols_read; /* Set once read_symbols was called */
+    const char* image;        /* Mapped file, the names point into it */
+    size_t      image_size;
+    elf_symbol* symbols;      /* Sorted by address */
+    size_t      number_of_symbols;
+};
+
+
+/* Executable segments of an object, as reported by dl_iterate_phdr */
+typedef struct loaded_object
+{
+    char*    pathname;
+    uint64_t bias;
+    uint64_t text_start;
+    uint64_t text_end;
+} loaded_object;
+
+
+typedef struct
+{
+    loaded_object* objects;
+    size_t         size;
+    size_t         capacity;
+} loaded_objects;
+
+
+static SCOREP_Mutex index_mutex;
+static bool         index_initialized;
+static elf_object*  objects;
+/* Unloaded objects, kept until finalization because the returned names
+ * point into their images */
+static elf_object*  unloaded_objects;
+
+
+/* Call with the index mutex locked. */
+static elf_object*
+find_object( uint64_t address )
+{
+    for ( elf_object* object = objects; object; object = object->next )
+    {
+        if ( object->text_start <= address && address < object->text_end )
+        {
+            return object;
+        }
+    }
+    return NULL;
+}
+
+
+static int
+compare_symbols( const void* a,
+                 const void* b )
+{
+    const elf_symbol* lhs = a;
+    const elf_symbol* rhs = b;
+    if ( lhs->address != rhs->address )
+    {
+        return lhs->address < rhs->address ? -1 : 1;
+    }
+    /* Prefer global over weak over local aliases */
+    int lhs_rank = lhs->binding == STB_GLOBAL ? 0 : lhs->binding == STB_WEAK ? 1 : 2;
+    int rhs_rank = rhs->binding == STB_GLOBAL ? 0 : rhs->binding == STB_WEAK ? 1 : 2;
+    if ( lhs_rank != rhs_rank )
+    {
+        return lhs_rank - rhs_rank;
+    }
+    return strcmp( lhs->name, rhs->name );
+}
+
+
+/* Reads the function symbols of @a object. Leaves @a object without
+ * symbols if the file cannot be read. Call with the index mutex locked. */
+static void
+read_symbols( elf_object* object )
+{
+    object->symbols_read = true;
+
+    int fd = open( object->pathname, O_RDONLY );
+    if ( fd == -1 )
+    {
+        UTILS_DEBUG( "Cannot open \"%s\"", object->pathname );
+        return;
+    }
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 || ( size_t )st.st_size < sizeof( ElfW( Ehdr ) ) )
+    {
+        close( fd );
+        return;
+    }
+    size_t      size  = st.st_size;
+    const char* image = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( image == MAP_FAILED )
+    {
+        return;
+    }
+
+    const ElfW( Ehdr )* ehdr = ( const ElfW( Ehdr )* )image;
+    if ( memcmp( ehdr->e_ident, ELFMAG, SELFMAG ) != 0
+         || ehdr->e_ident[ EI_CLASS ] != ( sizeof( void* ) == 8 ? ELFCLASS64 : ELFCLASS32 )
+         || ehdr->e_shoff + ( uint64_t )ehdr->e_shnum * sizeof( ElfW( Shdr ) ) > size )
+    {
+        munmap( ( void* )image, size );
+        return;
+    }
+
+    /* Prefer the full symbol table over the dynamic one */
+    const ElfW( Shdr )* shdrs  = ( const ElfW( Shdr )* )( image + ehdr->e_shoff );
+    const ElfW( Shdr )* symtab = NULL;
+    for ( ElfW( Half ) i = 0; i < ehdr->e_shnum; i++ )
+    {
+        if ( shdrs[ i ].sh_type == SHT_SYMTAB
+             || ( shdrs[ i ].sh_type == SHT_DYNSYM && symtab == NULL ) )
+        {
+            symtab = &shdrs[ i ];
+        }
+    }
+    if ( symtab == NULL
+         || symtab->sh_link >= ehdr->e_shnum
+         || symtab->sh_offset + symtab->sh_size > size
+         || shdrs[ symtab->sh_link ].sh_offset + shdrs[ symtab->sh_link ].sh_size > size )
+    {
+        munmap( ( void* )image, size );
+        return;
+    }
+
+    const ElfW( Sym )* syms           = ( const ElfW( Sym )* )( image + symtab->sh_offset );
+    size_t             number_of_syms = symtab->sh_size / sizeof( ElfW( Sym ) );
+    const char*        strings        = image + shdrs[ symtab->sh_link ].sh_offset;
+    size_t             strings_size   = shdrs[ symtab->sh_link ].sh_size;
+
+    elf_symbol* symbols = malloc( number_of_syms * sizeof( *symbols ) );
+    if ( symbols == NULL )
+    {
+        munmap( ( void* )image, size );
+        return;
+    }
+    size_t number_of_symbols = 0;
+    for ( size_t i = 0; i < number_of_syms; i++ )
+    {
+        /* ELF32_ST_TYPE is also used for 64-bit symbols */
+        const ElfW( Sym )* sym = &syms[ i ];
+        if ( ELF32_ST_TYPE( sym->st_info ) != STT_FUNC
+             || sym->st_shndx == SHN_UNDEF
+             || sym->st_name == 0
+             || sym->st_name >= strings_size
+             || memchr( strings + sym->st_name, 0, strings_size - sym->st_name ) == NULL )
+        {
+            continue;
+        }
+
+        uint64_t address = sym->st_value + object->bias;
+#if HAVE( PLATFORM_ARM )
+        /* Thumb functions have the least significant bit set */
+        address &= ~( uint64_t )1;
+#endif
+        if ( address < object->text_start || address >= object->text_end )
+        {
+            continue;
+        }
+        symbols[ number_of_symbols ].address = address;
+        symbols[ number_of_symbols ].name    = strings + sym->st_name;
+        symbols[ number_of_symbols ].binding = ELF32_ST_BIND( sym->st_info );
+        number_of_symbols++;
+    }
+    qsort( symbols, number_of_symbols, sizeof( *symbols ), compare_symbols );
+
+    /* Keep only the preferred alias of each address */
+    size_t unique = 0;
+    for ( size_t i = 0; i < number_of_symbols; i++ )
+    {
+        if ( unique == 0 || symbols[ unique - 1 ].address != symbols[ i ].address )
+        {
+            symbols[ unique++ ] = symbols[ i ];
+        }
+    }
+
+    UTILS_DEBUG( "Indexed %zu functions of \"%s\"", unique, object->pathname );
+
+    object->image             = image;
+    object->image_size        = size;
+    object->symbols           = symbols;
+    object->number_of_symbols = unique;
+}
+
+
+static int
+collect_object( struct dl_phdr_info* info,
+                size_t               size,
+                void*                data )
+{
+    loaded_objects* loaded     = data;
+    uint64_t        text_start = UINT64_MAX;
+    uint64_t        text_end   = 0;
+    for ( ElfW( Half ) i = 0; i < info->dlpi_phnum; i++ )
+    {
+        const ElfW( Phdr )* phdr = &info->dlpi_phdr[ i ];
+        if ( phdr->p_type == PT_LOAD && ( phdr->p_flags & PF_X ) )
+        {
+            uint64_t start = info->dlpi_addr + phdr->p_vaddr;
+            uint64_t end   = start + phdr->p_memsz;
+            text_start = start < text_start ? start : text_start;
+            text_end   = end > text_end ? end : text_end;
+        }
+    }
+    if ( text_start >= text_end )
+    {
+        return 0;
+    }
+
+    if ( loaded->size == loaded->capacity )
+    {
+        size_t         capacity = loaded->capacity ? 2 * loaded->capacity : 16;
+        loaded_object* objects  = realloc( loaded->objects, capacity * sizeof( *objects ) );
+        if ( objects == NULL )
+        {
+            return 1;
+        }
+        loaded->objects  = objects;
+        loaded->capacity = capacity;
+    }
+
+    /* The executable has an empty name */
+    const char*    pathname = info->dlpi_name && *info->dlpi_name ? info->dlpi_name : "/proc/self/exe";
+    loaded_object* object   = &loaded->objects[ loaded->size++ ];
+    object->pathname   = strdup( pathname );
+    object->bias       = info->dlpi_addr;
+    object->text_start = text_start;
+    object->text_end   = text_end;
+    return 0;
+}
+
+
+/* Returns whether @a object is still one of the @a loaded objects */
+static bool
+is_loaded( const elf_object*     object,
+           const loaded_objects* loaded )
+{
+    for ( size_t i = 0; i < loaded->size; i++ )
+    {
+        if ( loaded->objects[ i ].pathname != NULL
+             && loaded->objects[ i ].text_start == object->text_start
+             && loaded->objects[ i ].text_end == object->text_end
+             && strcmp( loaded->objects[ i ].pathname, object->pathname ) == 0 )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* Updates the index to the objects that are loaded now. Records only the
+ * address ranges of new objects, their symbols are read on the first lookup.
+ * Must be called without the index mutex, because dl_iterate_phdr takes the
+ * lock of the dynamic loader. */
+static void
+scan_objects( void )
+{
+    loaded_objects loaded = { NULL, 0, 0 };
+    dl_iterate_phdr( collect_object, &loaded );
+
+    SCOREP_MutexLock( index_mutex );
+
+    /* Drop the objects that were unloaded via dlclose */
+    elf_object** link = &objects;
+    while ( *link )
+    {
+        elf_object* object = *link;
+        if ( is_loaded( object, &loaded ) )
+        {
+            link = &object->next;
+            continue;
+        }
+        UTILS_DEBUG( "Dropping unloaded \"%s\"", object->pathname );
+        *link            = object->next;
+        object->next     = unloaded_objects;
+        unloaded_objects = object;
+    }
+
+    for ( size_t i = 0; i < loaded.size; i++ )
+    {
+        if ( loaded.objects[ i ].pathname != NULL
+             && find_object( loaded.objects[ i ].text_start ) == NULL )
+        {
+            elf_object* object = calloc( 1, sizeof( *object ) );
+            UTILS_BUG_ON( object == NULL, "Failed to allocate symbol index." );
+            object->pathname   = loaded.objects[ i ].pathname;
+            object->bias       = loaded.objects[ i ].bias;
+            object->text_start = loaded.objects[ i ].text_start;
+            object->text_end   = loaded.objects[ i ].text_end;
+            object->next       = objects;
+            objects            = object;
+
+            loaded.objects[ i ].pathname = NULL;
+        }
+        free( loaded.objects[ i ].pathname );
+    }
+    SCOREP_MutexUnlock( index_mutex );
+
+    free( loaded.objects );
+}
+
+
+/* Returns the object that contains @a address, after reading its symbols
+ * if this was not done before. */
+static elf_object*
+get_object( uint64_t address )
+{
+    SCOREP_MutexLock( index_mutex );
+    elf_object* object = find_object( address );
+    if ( object != NULL && !object->symbols_read )
+    {
+        read_symbols( object );
+    }
+    SCOREP_MutexUnlock( index_mutex );
+    return object;
+}
+
+
+bool
+scorep_compiler_symbol_index_initialize( void )
+{
+    SCOREP_MutexCreate( &index_mutex );
+    index_initialized = true;
+    return true;
+}
+
+
+const char*
+scorep_compiler_symbol_index_lookup( uint64_t address )
+{
+    elf_object* object = get_object( address );
+    if ( object == NULL )
+    {
+        scan_objects();
+
+        object = get_object( address );
+        if ( object == NULL )
+        {
+            return NULL;
+        }
+    }
+
+    /* The symbols are not changed after they were read, and unloaded
+     * objects are only released on finalization */
+    size_t low  = 0;
+    size_t high = object->number_of_symbols;
+    while ( low < high )
+    {
+        size_t mid = low + ( high - low ) / 2;
+        if ( object->symbols[ mid ].address < address )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if ( low < object->number_of_symbols && object->symbols[ low ].address == address )
+    {
+        return object->symbols[ low ].name;
+    }
+    return NULL;
+}
+
+
+static void
+free_objects( elf_object* list )
+{
+    while ( list )
+    {
+        elf_object* object = list;
+        list = object->next;
+        if ( object->image )
+        {
+            munmap( ( void* )object->image, object->image_size );
+        }
+        free( object->symbols );
+        free( object->pathname );
+        free( object );
+    }
+}
+
+
+void
+scorep_compiler_symbol_index_finalize( void )
+{
+    if ( !index_initialized )
+    {
+        return;
+    }
+
+    free_objects( objects );
+    objects = NULL;
+    free_objects( unloaded_objects );
+    unloaded_objects = NULL;
+
+    SCOREP_MutexDestroy( &index_mutex );
+    index_initialized = false;
+}
+
+#else /* !defined( __ELF__ ) */
+
+bool
+scorep_compiler_symbol_index_initialize( void )
+{
+    return false;
+}
+
+
+const char*
+scorep_compiler_symbol_index_lookup( uint64_t address )
+{
+    return NULL;
+}
+
+
+void
+scorep_compiler_symbol_index_finalize( void )
+{
+}
+
+#endif /* !defined( __ELF__ ) */
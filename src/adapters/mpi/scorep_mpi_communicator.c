@@ -78,13 +78,6 @@ extern uint64_t scorep_mpi_max_windows;
 /* ------------------------------------------------ Definitions for MPI Window handling */
 #ifndef SCOREP_MPI_NO_RMA
 
-/**
- *  @internal
- *  Index in the scorep_mpi_windows array of last valid entry in window tracking data
- *  structure.
- */
-static int32_t scorep_mpi_last_window = 0;
-
 /**
  *  @internal
  *  Mutex for mpi window definitions.
@@ -95,12 +88,6 @@ extern SCOREP_Mutex scorep_mpi_window_mutex;
 
 /* ------------------------------------------- Definitions for communicators and groups */
 
-/**
- *  @internal
- *  Index into the scorep_mpi_groups array to the last entry.
- */
-static int32_t scorep_mpi_last_group = 0;
-
 /**
  *  @internal
  *  Internal array used for rank translation.
@@ -164,21 +151,21 @@ scorep_mpi_win_create( const char* name,
     SCOREP_RmaWindowHandle handle = SCOREP_INVALID_RMA_WINDOW;
 
     SCOREP_MutexLock( scorep_mpi_window_mutex );
-    if ( scorep_mpi_last_window >= SCOREP_MPI_MAX_WIN )
-    {
-        UTILS_ERROR( SCOREP_ERROR_MPI_TOO_MANY_WINDOWS,
-                     "Hint: Increase SCOREP_MPI_MAX_WINDOWS configuration variable." );
-    }
 
     /* register mpi window definition */
     handle = SCOREP_Definitions_NewRmaWindow( name ? name : "MPI Window",
                                               SCOREP_MPI_COMM_HANDLE( comm ) );
 
-    /* enter win in scorep_mpi_windows[] array */
-    scorep_mpi_windows[ scorep_mpi_last_window ].win    = win;
-    scorep_mpi_windows[ scorep_mpi_last_window ].handle = handle;
-
-    scorep_mpi_last_window++;
+    if ( scorep_mpi_windows.size >= SCOREP_MPI_MAX_WIN )
+    {
+        UTILS_ERROR( SCOREP_ERROR_MPI_TOO_MANY_WINDOWS,
+                     "Hint: Increase SCOREP_MPI_MAX_WINDOWS configuration variable." );
+    }
+    else
+    {
+        /* enter win in scorep_mpi_windows table */
+        scorep_mpi_handle_table_insert( &scorep_mpi_windows, SCOREP_MPI_HANDLE_KEY( win ), handle );
+    }
     SCOREP_MutexUnlock( scorep_mpi_window_mutex );
 
     return handle;
@@ -188,27 +175,11 @@ void
 scorep_mpi_win_free( MPI_Win win )
 {
     SCOREP_MutexLock( scorep_mpi_window_mutex );
-    if ( scorep_mpi_last_window == 1 && scorep_mpi_windows[ 0 ].win == win )
-    {
-        scorep_mpi_last_window = 0;
-    }
-    else if ( scorep_mpi_last_window > 1 )
+    scorep_mpi_handle_entry* entry =
+        scorep_mpi_handle_table_get( &scorep_mpi_windows, SCOREP_MPI_HANDLE_KEY( win ) );
+    if ( entry )
     {
-        int i = 0;
-
-        while ( i < scorep_mpi_last_window && scorep_mpi_windows[ i ].win != win )
-        {
-            i++;
-        }
-
-        if ( i < scorep_mpi_last_window-- )
-        {
-            scorep_mpi_windows[ i ] = scorep_mpi_windows[ scorep_mpi_last_window ];
-        }
-        else
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_WINDOW, "" );
-        }
+        scorep_mpi_handle_table_remove( &scorep_mpi_windows, entry );
     }
     else
     {
@@ -220,22 +191,14 @@ scorep_mpi_win_free( MPI_Win win )
 SCOREP_RmaWindowHandle
 scorep_mpi_win_handle( MPI_Win win )
 {
-    int i = 0;
-
-    SCOREP_MutexLock( scorep_mpi_window_mutex );
-    while ( i < scorep_mpi_last_window && scorep_mpi_windows[ i ].win != win )
-    {
-        i++;
-    }
-
-    if ( i != scorep_mpi_last_window )
+    SCOREP_RmaWindowHandle handle;
+    if ( scorep_mpi_handle_table_lookup( &scorep_mpi_windows, SCOREP_MPI_HANDLE_KEY( win ),
+                                         &handle, NULL ) )
     {
-        SCOREP_MutexUnlock( scorep_mpi_window_mutex );
-        return scorep_mpi_windows[ i ].handle;
+        return handle;
     }
     else
     {
-        SCOREP_MutexUnlock( scorep_mpi_window_mutex );
         UTILS_ERROR( SCOREP_ERROR_MPI_NO_WINDOW,
                      "You are using a window that was not tracked. "
                      "Please contact the Score-P support team." );
@@ -311,36 +274,16 @@ scorep_mpi_comm_free( MPI_Comm comm )
     /* Lock communicator definition */
     SCOREP_MutexLock( scorep_mpi_communicator_mutex );
 
-    /* if only one communicator exists, we just need to decrease \a
-     * scorep_mpi_last_comm */
-    if ( scorep_mpi_last_comm == 1 && scorep_mpi_comms[ 0 ].comm == comm )
+    scorep_mpi_handle_entry* entry =
+        scorep_mpi_handle_table_get( &scorep_mpi_comms, SCOREP_MPI_HANDLE_KEY( comm ) );
+    if ( entry )
     {
-        scorep_mpi_last_comm = 0;
-    }
-    /* if more than one communicator exists, we need to search for the
-     * entry */
-    else if ( scorep_mpi_last_comm > 1 )
-    {
-        int i = 0;
-
-        while ( i < scorep_mpi_last_comm && scorep_mpi_comms[ i ].comm != comm )
-        {
-            i++;
-        }
-
-        if ( i < scorep_mpi_last_comm-- )
-        {
-            /* swap deletion candidate with last entry in the list */
-            scorep_mpi_comms[ i ] = scorep_mpi_comms[ scorep_mpi_last_comm ];
-        }
-        else
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM, "scorep_mpi_comm_free1 %s", message );
-        }
+        /* also invalidates the per-thread caches of the last communicator */
+        scorep_mpi_handle_table_remove( &scorep_mpi_comms, entry );
     }
     else
     {
-        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM, "scorep_mpi_comm_free2 %s", message );
+        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM, "scorep_mpi_comm_free %s", message );
     }
 
     /* Unlock communicator definition */
@@ -401,18 +344,21 @@ scorep_mpi_comm_set_default_names( void )
 /**
  * @internal
  * @brief  Search internal data structures for the entry of a given MPI
- *         group handle.
+ *         group handle. Needs the communicator lock.
  * @param  group  MPI group handle
- * @return Index of entry or -1 if entry could not be found.
+ * @return Entry or NULL if entry could not be found.
  */
-static int32_t
-scorep_mpi_group_search( MPI_Group group );
+static inline scorep_mpi_handle_entry*
+scorep_mpi_group_search( MPI_Group group )
+{
+    return scorep_mpi_handle_table_get( &scorep_mpi_groups, SCOREP_MPI_HANDLE_KEY( group ) );
+}
 
 void
 scorep_mpi_group_create( MPI_Group group )
 {
-    int32_t            i;
-    SCOREP_GroupHandle handle;
+    scorep_mpi_handle_entry* entry;
+    SCOREP_GroupHandle       handle;
 
     /* Check if communicator handling has been initialized.
      * Prevents crashes with broken MPI implementations (e.g. mvapich-0.9.x)
@@ -430,9 +376,9 @@ scorep_mpi_group_create( MPI_Group group )
     SCOREP_MutexLock( scorep_mpi_communicator_mutex );
 
     /* check if group already exists */
-    if ( ( i = scorep_mpi_group_search( group ) ) == -1 )
+    if ( ( entry = scorep_mpi_group_search( group ) ) == NULL )
     {
-        if ( scorep_mpi_last_group >= SCOREP_MPI_MAX_GROUP )
+        if ( scorep_mpi_groups.size >= SCOREP_MPI_MAX_GROUP )
         {
             UTILS_ERROR( SCOREP_ERROR_MPI_TOO_MANY_GROUPS,
                          "Hint: Increase SCOREP_MPI_MAX_GROUPS configuration variable." );
@@ -450,16 +396,13 @@ scorep_mpi_group_create( MPI_Group group )
             size,
             ( const uint32_t* )scorep_mpi_ranks );
 
-        /* enter group in scorep_mpi_groups[] array */
-        scorep_mpi_groups[ scorep_mpi_last_group ].group  = group;
-        scorep_mpi_groups[ scorep_mpi_last_group ].handle = handle;
-        scorep_mpi_groups[ scorep_mpi_last_group ].refcnt = 1;
-        scorep_mpi_last_group++;
+        /* enter group in scorep_mpi_groups table */
+        scorep_mpi_handle_table_insert( &scorep_mpi_groups, SCOREP_MPI_HANDLE_KEY( group ), handle );
     }
     else
     {
         /* count additional reference on group */
-        scorep_mpi_groups[ i ].refcnt++;
+        entry->refcnt++;
     }
 
     /* Unlock communicator definition */
@@ -483,33 +426,16 @@ scorep_mpi_group_free( MPI_Group group )
 
     SCOREP_MutexLock( scorep_mpi_communicator_mutex );
 
-    if ( scorep_mpi_last_group == 1 && scorep_mpi_groups[ 0 ].group == group )
-    {
-        scorep_mpi_groups[ 0 ].refcnt--;
-
-        if ( scorep_mpi_groups[ 0 ].refcnt == 0 )
-        {
-            scorep_mpi_last_group--;
-        }
-    }
-    else if ( scorep_mpi_last_group > 1 )
+    scorep_mpi_handle_entry* entry = scorep_mpi_group_search( group );
+    if ( entry )
     {
-        int32_t i;
+        /* decrease reference count on entry */
+        entry->refcnt--;
 
-        if ( ( i = scorep_mpi_group_search( group ) ) != -1 )
-        {
-            /* decrease reference count on entry */
-            scorep_mpi_groups[ i ].refcnt--;
-
-            /* check if entry can be deleted */
-            if ( scorep_mpi_groups[ i ].refcnt == 0 )
-            {
-                scorep_mpi_groups[ i ] = scorep_mpi_groups[ --scorep_mpi_last_group ];
-            }
-        }
-        else
+        /* check if entry can be deleted */
+        if ( entry->refcnt == 0 )
         {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_GROUP, "" );
+            scorep_mpi_handle_table_remove( &scorep_mpi_groups, entry );
         }
     }
     else
@@ -523,47 +449,19 @@ scorep_mpi_group_free( MPI_Group group )
 SCOREP_Mpi_GroupHandle
 scorep_mpi_group_handle( MPI_Group group )
 {
-    int32_t i = 0;
-
-    SCOREP_MutexLock( scorep_mpi_communicator_mutex );
-    while ( ( i < scorep_mpi_last_group ) && ( scorep_mpi_groups[ i ].group != group ) )
-    {
-        i++;
-    }
-
-    if ( i != scorep_mpi_last_group )
+    SCOREP_Mpi_GroupHandle handle;
+    if ( scorep_mpi_handle_table_lookup( &scorep_mpi_groups, SCOREP_MPI_HANDLE_KEY( group ),
+                                         &handle, NULL ) )
     {
-        SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
-        return scorep_mpi_groups[ i ].handle;
+        return handle;
     }
     else
     {
-        SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
         UTILS_ERROR( SCOREP_ERROR_MPI_NO_GROUP, "" );
         return SCOREP_INVALID_MPI_GROUP;
     }
 }
 
-static int32_t
-scorep_mpi_group_search( MPI_Group group )
-{
-    int32_t i = 0;
-
-    while ( ( i < scorep_mpi_last_group ) && ( scorep_mpi_groups[ i ].group != group ) )
-    {
-        i++;
-    }
-
-    if ( i != scorep_mpi_last_group )
-    {
-        return i;
-    }
-    else
-    {
-        return -1;
-    }
-}
-
 /*
  * -----------------------------------------------------------------------------
  *
@@ -26,6 +26,7 @@
 #include "SCOREP_Mpi.h"
 
 #include <SCOREP_Mutex.h>
+#include <SCOREP_Atomic.h>
 #include <UTILS_Error.h>
 #include <SCOREP_Memory.h>
 
@@ -33,6 +34,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 extern uint64_t scorep_mpi_max_windows;
@@ -58,9 +60,9 @@ SCOREP_Mutex scorep_mpi_window_mutex = SCOREP_INVALID_MUTEX;
 
 /**
  *  @internal
- *  Window tracking array
+ *  Window tracking table
  */
-struct scorep_mpi_win_type* scorep_mpi_windows = NULL;
+scorep_mpi_handle_table scorep_mpi_windows;
 
 /**
  *  @internal
@@ -121,26 +123,271 @@ struct scorep_mpi_id_root_pair
 
 /**
  *  @internal
- *  Communicator tracking data structure. Array of created communicators' handles.
+ *  Communicator tracking data structure. Table of created communicators' handles.
  */
-struct scorep_mpi_communicator_type* scorep_mpi_comms = NULL;
+scorep_mpi_handle_table scorep_mpi_comms;
 
 /**
  *  @internal
- *  Group tracking data structure. Array of created groups' handles.
+ *  Group tracking data structure. Table of created groups' handles.
  */
-struct scorep_mpi_group_type* scorep_mpi_groups = NULL;
+scorep_mpi_handle_table scorep_mpi_groups;
 
 /**
    Rank of local process in esd_comm_world
  */
 static int scorep_mpi_my_global_rank = SCOREP_INVALID_ROOT_RANK;
 
+#if HAVE( THREAD_LOCAL_STORAGE )
 /**
  *  @internal
- *  Index into the scorep_mpi_comms array to the last entry.
+ *  Per-thread cache of the last looked-up communicator. Valid as long as
+ *  no communicator was freed since, i.e., @a generation equals the
+ *  generation of scorep_mpi_comms.
  */
-int32_t scorep_mpi_last_comm = 0;
+static SCOREP_THREAD_LOCAL_STORAGE_SPECIFIER struct
+{
+    uint64_t                         key;
+    SCOREP_InterimCommunicatorHandle handle;
+    uint32_t                         generation;
+} scorep_mpi_last_comm_cache = { 0, SCOREP_INVALID_INTERIM_COMMUNICATOR, 0 };
+#endif
+
+enum
+{
+    SCOREP_MPI_HANDLE_ENTRY_EMPTY = 0,
+    SCOREP_MPI_HANDLE_ENTRY_USED,
+    SCOREP_MPI_HANDLE_ENTRY_DELETED
+};
+
+static inline uint32_t
+handle_table_slot( const scorep_mpi_handle_table* table,
+                   uint64_t                       key )
+{
+    /* Fibonacci hashing, MPI handles are often aligned pointers or
+       consecutive integers with a common prefix. */
+    return ( uint32_t )( ( key * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> 32 ) & table->mask;
+}
+
+bool
+scorep_mpi_handle_table_init( scorep_mpi_handle_table* table,
+                              uint64_t                 maxEntries )
+{
+    /* Keep the load factor of the live entries below 0.5. Together with the
+       tombstones at most three quarters of the slots are occupied, see
+       handle_table_rehash(). */
+    uint64_t capacity = 2;
+    while ( capacity < 2 * maxEntries )
+    {
+        capacity *= 2;
+    }
+    if ( capacity > UINT32_MAX )
+    {
+        table->entries = NULL;
+        return false;
+    }
+
+    table->entries = SCOREP_Memory_AllocForMisc( capacity * sizeof( *table->entries ) );
+    if ( table->entries == NULL )
+    {
+        return false;
+    }
+    memset( table->entries, 0, capacity * sizeof( *table->entries ) );
+    table->mask       = capacity - 1;
+    table->size       = 0;
+    table->deleted    = 0;
+    table->generation = 0;
+    return true;
+}
+
+scorep_mpi_handle_entry*
+scorep_mpi_handle_table_get( scorep_mpi_handle_table* table,
+                             uint64_t                 key )
+{
+    if ( table->entries == NULL )
+    {
+        return NULL;
+    }
+
+    uint32_t slot = handle_table_slot( table, key );
+    for ( uint32_t i = 0; i <= table->mask; i++ )
+    {
+        scorep_mpi_handle_entry* entry = &table->entries[ slot ];
+        if ( entry->state == SCOREP_MPI_HANDLE_ENTRY_EMPTY )
+        {
+            return NULL;
+        }
+        if ( entry->state == SCOREP_MPI_HANDLE_ENTRY_USED && entry->key == key )
+        {
+            return entry;
+        }
+        slot = ( slot + 1 ) & table->mask;
+    }
+    return NULL;
+}
+
+bool
+scorep_mpi_handle_table_lookup( scorep_mpi_handle_table* table,
+                                uint64_t                 key,
+                                SCOREP_AnyHandle*        handle,
+                                uint32_t*                generation )
+{
+    if ( table->entries == NULL )
+    {
+        return false;
+    }
+
+    while ( true )
+    {
+        uint32_t start = SCOREP_ATOMIC_LOAD( &table->generation, SCOREP_ATOMIC_ACQUIRE );
+        if ( start & 1 )
+        {
+            /* Entries are being rehashed */
+            continue;
+        }
+
+        bool             found = false;
+        SCOREP_AnyHandle value = SCOREP_MOVABLE_NULL;
+        uint32_t         slot  = handle_table_slot( table, key );
+        for ( uint32_t i = 0; i <= table->mask; i++ )
+        {
+            scorep_mpi_handle_entry* entry = &table->entries[ slot ];
+            uint32_t                 state = SCOREP_ATOMIC_LOAD( &entry->state, SCOREP_ATOMIC_ACQUIRE );
+            if ( state == SCOREP_MPI_HANDLE_ENTRY_EMPTY )
+            {
+                break;
+            }
+            if ( state == SCOREP_MPI_HANDLE_ENTRY_USED
+                 && SCOREP_ATOMIC_LOAD( &entry->key, SCOREP_ATOMIC_RELAXED ) == key )
+            {
+                value = SCOREP_ATOMIC_LOAD( &entry->handle, SCOREP_ATOMIC_RELAXED );
+                found = true;
+                break;
+            }
+            slot = ( slot + 1 ) & table->mask;
+        }
+
+        /* The entry may have been removed and its slot reused, or moved by a
+           rehash, while we read it */
+        SCOREP_ATOMIC_THREAD_FENCE( SCOREP_ATOMIC_ACQUIRE );
+        if ( SCOREP_ATOMIC_LOAD( &table->generation, SCOREP_ATOMIC_RELAXED ) == start )
+        {
+            *handle = value;
+            if ( generation )
+            {
+                *generation = start;
+            }
+            return found;
+        }
+    }
+}
+
+static void
+handle_table_put( scorep_mpi_handle_table* table,
+                  uint64_t                 key,
+                  SCOREP_AnyHandle         handle,
+                  int32_t                  refcnt )
+{
+    uint32_t slot = handle_table_slot( table, key );
+    while ( table->entries[ slot ].state == SCOREP_MPI_HANDLE_ENTRY_USED )
+    {
+        slot = ( slot + 1 ) & table->mask;
+    }
+
+    /* Publish the entry only after key and handle are in place. */
+    scorep_mpi_handle_entry* entry = &table->entries[ slot ];
+    if ( entry->state == SCOREP_MPI_HANDLE_ENTRY_DELETED )
+    {
+        table->deleted--;
+    }
+    SCOREP_ATOMIC_STORE( &entry->key, key, SCOREP_ATOMIC_RELAXED );
+    SCOREP_ATOMIC_STORE( &entry->handle, handle, SCOREP_ATOMIC_RELAXED );
+    entry->refcnt = refcnt;
+    SCOREP_ATOMIC_STORE( &entry->state, SCOREP_MPI_HANDLE_ENTRY_USED, SCOREP_ATOMIC_RELEASE );
+}
+
+/**
+ * Drops all tombstones by inserting the live entries again into the emptied
+ * slots. Concurrent lookups retry until the generation is even again.
+ */
+static void
+handle_table_rehash( scorep_mpi_handle_table* table )
+{
+    scorep_mpi_handle_entry* live = malloc( table->size * sizeof( *live ) );
+    if ( live == NULL )
+    {
+        /* Lookups only get slower */
+        return;
+    }
+
+    uint32_t n = 0;
+    for ( uint32_t slot = 0; slot <= table->mask; slot++ )
+    {
+        if ( table->entries[ slot ].state == SCOREP_MPI_HANDLE_ENTRY_USED )
+        {
+            live[ n++ ] = table->entries[ slot ];
+        }
+    }
+
+    SCOREP_ATOMIC_FETCH_ADD( &table->generation, 1, SCOREP_ATOMIC_RELAXED );
+    SCOREP_ATOMIC_THREAD_FENCE( SCOREP_ATOMIC_RELEASE );
+
+    for ( uint32_t slot = 0; slot <= table->mask; slot++ )
+    {
+        SCOREP_ATOMIC_STORE( &table->entries[ slot ].state,
+                             SCOREP_MPI_HANDLE_ENTRY_EMPTY,
+                             SCOREP_ATOMIC_RELAXED );
+    }
+    table->deleted = 0;
+    for ( uint32_t i = 0; i < n; i++ )
+    {
+        handle_table_put( table, live[ i ].key, live[ i ].handle, live[ i ].refcnt );
+    }
+
+    SCOREP_ATOMIC_FETCH_ADD( &table->generation, 1, SCOREP_ATOMIC_RELEASE );
+    free( live );
+}
+
+void
+scorep_mpi_handle_table_insert( scorep_mpi_handle_table* table,
+                                uint64_t                 key,
+                                SCOREP_AnyHandle         handle )
+{
+    UTILS_BUG_ON( table->entries == NULL || table->size > table->mask,
+                  "No free slot in MPI handle table." );
+
+    handle_table_put( table, key, handle, 1 );
+    table->size++;
+}
+
+void
+scorep_mpi_handle_table_remove( scorep_mpi_handle_table* table,
+                                scorep_mpi_handle_entry* entry )
+{
+    /* If the next slot is empty, no probe sequence passes this slot and it
+       can become empty again. Otherwise leave a tombstone. */
+    uint32_t slot = ( entry - table->entries + 1 ) & table->mask;
+    if ( table->entries[ slot ].state == SCOREP_MPI_HANDLE_ENTRY_EMPTY )
+    {
+        SCOREP_ATOMIC_STORE( &entry->state, SCOREP_MPI_HANDLE_ENTRY_EMPTY, SCOREP_ATOMIC_RELAXED );
+    }
+    else
+    {
+        SCOREP_ATOMIC_STORE( &entry->state, SCOREP_MPI_HANDLE_ENTRY_DELETED, SCOREP_ATOMIC_RELAXED );
+        table->deleted++;
+    }
+    /* Lookups that read this entry before retry. The fence orders the
+       generation before the key and handle stores of a later insert into
+       this slot, a lookup that reads those also reads the new generation. */
+    SCOREP_ATOMIC_FETCH_ADD( &table->generation, 2, SCOREP_ATOMIC_RELAXED );
+    SCOREP_ATOMIC_THREAD_FENCE( SCOREP_ATOMIC_RELEASE );
+    table->size--;
+
+    if ( 4 * ( uint64_t )( table->size + table->deleted ) > 3 * ( ( uint64_t )table->mask + 1 ) )
+    {
+        handle_table_rehash( table );
+    }
+}
 
 void
 scorep_mpi_win_init( void )
@@ -169,9 +416,7 @@ scorep_mpi_win_init( void )
         }
 
 
-        scorep_mpi_windows = ( struct scorep_mpi_win_type* )SCOREP_Memory_AllocForMisc
-                                 ( sizeof( struct scorep_mpi_win_type ) * SCOREP_MPI_MAX_WIN );
-        if ( scorep_mpi_windows == NULL )
+        if ( !scorep_mpi_handle_table_init( &scorep_mpi_windows, SCOREP_MPI_MAX_WIN ) )
         {
             UTILS_ERROR( SCOREP_ERROR_MEM_ALLOC_FAILED,
                          "Failed to allocate memory for MPI window tracking.\n"
@@ -291,7 +536,7 @@ scorep_mpi_comm_create_finalize( MPI_Comm                         comm,
     SCOREP_MutexLock( scorep_mpi_communicator_mutex );
 
     /* is storage available */
-    if ( scorep_mpi_last_comm >= SCOREP_MPI_MAX_COMM )
+    if ( scorep_mpi_comms.size >= SCOREP_MPI_MAX_COMM )
     {
         SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
         UTILS_ERROR( SCOREP_ERROR_MPI_TOO_MANY_COMMS,
@@ -319,10 +564,8 @@ scorep_mpi_comm_create_finalize( MPI_Comm                         comm,
     comm_payload->root_id           = id;
     comm_payload->io_handle_counter = 0;
 
-    /* enter comm in scorep_mpi_comms[] array */
-    scorep_mpi_comms[ scorep_mpi_last_comm ].comm = comm;
-    scorep_mpi_comms[ scorep_mpi_last_comm ].cid  = handle;
-    scorep_mpi_last_comm++;
+    /* enter comm in scorep_mpi_comms table */
+    scorep_mpi_handle_table_insert( &scorep_mpi_comms, SCOREP_MPI_HANDLE_KEY( comm ), handle );
 
     /* clean up */
     SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
@@ -472,10 +715,7 @@ scorep_mpi_comm_init( void )
     if ( !scorep_mpi_comm_initialized )
     {
         /* Create tracking structures */
-        scorep_mpi_comms = ( struct scorep_mpi_communicator_type* )SCOREP_Memory_AllocForMisc
-                               ( sizeof( struct scorep_mpi_communicator_type ) * SCOREP_MPI_MAX_COMM );
-
-        if ( scorep_mpi_comms == NULL )
+        if ( !scorep_mpi_handle_table_init( &scorep_mpi_comms, SCOREP_MPI_MAX_COMM ) )
         {
             UTILS_ERROR( SCOREP_ERROR_MEM_ALLOC_FAILED,
                          "Failed to allocate memory for communicator tracking.\n"
@@ -484,9 +724,7 @@ scorep_mpi_comm_init( void )
                          "SCOREP_MPI_MAX_COMMUNICATORS.", SCOREP_MPI_MAX_COMM );
         }
 
-        scorep_mpi_groups = ( struct scorep_mpi_group_type* )SCOREP_Memory_AllocForMisc
-                                ( sizeof( struct scorep_mpi_group_type ) *  SCOREP_MPI_MAX_GROUP );
-        if ( scorep_mpi_groups == NULL )
+        if ( !scorep_mpi_handle_table_init( &scorep_mpi_groups, SCOREP_MPI_MAX_GROUP ) )
         {
             UTILS_ERROR( SCOREP_ERROR_MEM_ALLOC_FAILED,
                          "Failed to allocate memory for MPI group tracking.\n"
@@ -512,28 +750,33 @@ scorep_mpi_comm_init( void )
 SCOREP_InterimCommunicatorHandle
 scorep_mpi_comm_handle( MPI_Comm comm )
 {
-    int i = 0;
-
-    /* Lock communicator definition */
-    SCOREP_MutexLock( scorep_mpi_communicator_mutex );
+    uint64_t key = SCOREP_MPI_HANDLE_KEY( comm );
 
-    while ( i < scorep_mpi_last_comm && scorep_mpi_comms[ i ].comm != comm )
+#if HAVE( THREAD_LOCAL_STORAGE )
+    uint32_t generation = SCOREP_ATOMIC_LOAD( &scorep_mpi_comms.generation, SCOREP_ATOMIC_ACQUIRE );
+    if ( scorep_mpi_last_comm_cache.key == key
+         && scorep_mpi_last_comm_cache.generation == generation
+         && scorep_mpi_last_comm_cache.handle != SCOREP_INVALID_INTERIM_COMMUNICATOR )
     {
-        i++;
+        return scorep_mpi_last_comm_cache.handle;
     }
+#endif
 
-    if ( i != scorep_mpi_last_comm )
+    /* Lookups are lock-free, only creation and freeing lock the
+       communicator definition */
+    SCOREP_InterimCommunicatorHandle handle;
+    uint32_t                         lookup_generation;
+    if ( scorep_mpi_handle_table_lookup( &scorep_mpi_comms, key, &handle, &lookup_generation ) )
     {
-        /* Unlock communicator definition */
-        SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
-
-        return scorep_mpi_comms[ i ].cid;
+#if HAVE( THREAD_LOCAL_STORAGE )
+        scorep_mpi_last_comm_cache.key        = key;
+        scorep_mpi_last_comm_cache.handle     = handle;
+        scorep_mpi_last_comm_cache.generation = lookup_generation;
+#endif
+        return handle;
     }
     else
     {
-        /* Unlock communicator definition */
-        SCOREP_MutexUnlock( scorep_mpi_communicator_mutex );
-
         if ( comm == MPI_COMM_WORLD )
         {
             UTILS_WARNING( "This function SHOULD NOT be called with MPI_COMM_WORLD" );
@@ -26,6 +26,7 @@
 
 #include <mpi.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 extern uint64_t scorep_mpi_max_epochs;
 
@@ -63,20 +64,103 @@ typedef SCOREP_GroupHandle SCOREP_Mpi_GroupHandle;
 typedef uint8_t SCOREP_Mpi_EpochType;
 
 /**
- *  @internal
- *  Structure to translate MPI window handles to internal SCOREP IDs.
+ * @def SCOREP_MPI_HANDLE_KEY
+ * Converts an MPI handle, which is an integer or a pointer depending on the
+ * MPI implementation, into a key for a scorep_mpi_handle_table.
  */
-struct scorep_mpi_win_type
+#define SCOREP_MPI_HANDLE_KEY( h ) ( ( uint64_t )( uintptr_t )( h ) )
+
+/**
+ * @internal
+ * Entry of a scorep_mpi_handle_table.
+ */
+typedef struct scorep_mpi_handle_entry
 {
-    MPI_Win                win;    /** MPI window handle */
-    SCOREP_RmaWindowHandle handle; /** Internal SCOREP window handle */
-};
+    uint64_t         key;    /**< MPI handle, see SCOREP_MPI_HANDLE_KEY */
+    SCOREP_AnyHandle handle; /**< Internal Score-P handle */
+    int32_t          refcnt; /**< Number of references, only used for groups */
+    uint32_t         state;  /**< Whether the slot is empty, used, or was deleted */
+} scorep_mpi_handle_entry;
+
+/**
+ * @internal
+ * Maps MPI handles to Score-P handles. Open addressing with linear probing,
+ * sized to twice the maximum number of concurrently used MPI objects.
+ * Inserts and removes need to be serialized by the caller, lookups via
+ * scorep_mpi_handle_table_lookup are lock-free. Removed entries stay as
+ * tombstones, so that concurrent lookups never miss an entry behind them.
+ * When live entries and tombstones occupy three quarters of the slots, the
+ * entries are rehashed in place, which drops the tombstones.
+ *
+ * @a generation works like a sequence lock for the lookups: it is odd while
+ * the entries are rehashed and advanced by 2 on every removal.
+ */
+typedef struct scorep_mpi_handle_table
+{
+    scorep_mpi_handle_entry* entries;
+    uint32_t                 mask;        /**< number of slots minus one */
+    uint32_t                 size;        /**< number of used slots */
+    uint32_t                 deleted;     /**< number of tombstones */
+    uint32_t                 generation;  /**< changed on every removal and rehash */
+} scorep_mpi_handle_table;
+
+/**
+ * @internal
+ * Allocates the slots of @a table for @a maxEntries concurrent entries.
+ *
+ * @return false if the memory could not be allocated.
+ */
+bool
+scorep_mpi_handle_table_init( scorep_mpi_handle_table* table,
+                              uint64_t                 maxEntries );
+
+/**
+ * @internal
+ * Returns the entry for @a key, or NULL. The caller needs to hold the lock
+ * that serializes inserts and removes, as the entry may be moved or reused
+ * otherwise.
+ */
+scorep_mpi_handle_entry*
+scorep_mpi_handle_table_get( scorep_mpi_handle_table* table,
+                             uint64_t                 key );
+
+/**
+ * @internal
+ * Looks up the Score-P handle of @a key without locking. If @a generation
+ * is not NULL, it receives the generation of @a table the result is valid
+ * for.
+ *
+ * @return false if @a key is not in @a table.
+ */
+bool
+scorep_mpi_handle_table_lookup( scorep_mpi_handle_table* table,
+                                uint64_t                 key,
+                                SCOREP_AnyHandle*        handle,
+                                uint32_t*                generation );
+
+/**
+ * @internal
+ * Adds @a key with @a handle and a reference count of 1. The key must not
+ * be in the table already.
+ */
+void
+scorep_mpi_handle_table_insert( scorep_mpi_handle_table* table,
+                                uint64_t                 key,
+                                SCOREP_AnyHandle         handle );
+
+/**
+ * @internal
+ * Removes @a entry, which needs to be obtained by scorep_mpi_handle_table_get.
+ */
+void
+scorep_mpi_handle_table_remove( scorep_mpi_handle_table* table,
+                                scorep_mpi_handle_entry* entry );
 
 /**
  *  @internal
- *  Array which maps all MPI windows to Score-P internal handles.
+ *  Maps all MPI windows to Score-P internal handles.
  */
-extern struct scorep_mpi_win_type* scorep_mpi_windows;
+extern scorep_mpi_handle_table scorep_mpi_windows;
 
 /**
  * @internal
@@ -115,27 +199,6 @@ typedef struct scorep_mpi_comm_definition_payload
  */
 extern struct scorep_mpi_world_type scorep_mpi_world;
 
-/**
- *  @internal
- * structure for communicator tracking
- */
-struct scorep_mpi_communicator_type
-{
-    MPI_Comm                         comm; /**< MPI Communicator handle */
-    SCOREP_InterimCommunicatorHandle cid;  /**< Internal SCOREP Communicator handle */
-};
-
-/**
- * @internal
- * structure for group tracking
- */
-struct scorep_mpi_group_type
-{
-    MPI_Group              group;  /**< MPI group handle */
-    SCOREP_Mpi_GroupHandle handle; /**< Internal SCOREP group handle */
-    int32_t                refcnt; /**< Number of references to this group */
-};
-
 extern uint64_t scorep_mpi_max_communicators;
 /**
  *  @def SCOREP_MPI_MAX_COMM
@@ -164,11 +227,18 @@ extern uint64_t scorep_mpi_max_groups;
  */
 #define SCOREP_MPI_COMM_HANDLE( c ) ( ( c ) == MPI_COMM_WORLD ? SCOREP_MPI_COMM_WORLD_HANDLE : scorep_mpi_comm_handle( c ) )
 
-extern int32_t scorep_mpi_last_comm;
-
-extern struct scorep_mpi_group_type* scorep_mpi_groups;
+/**
+ *  @internal
+ *  Maps all MPI groups to Score-P internal handles.
+ */
+extern scorep_mpi_handle_table scorep_mpi_groups;
 
-extern struct scorep_mpi_communicator_type* scorep_mpi_comms;
+/**
+ *  @internal
+ *  Maps all MPI communicators, except MPI_COMM_WORLD, to Score-P internal
+ *  handles.
+ */
+extern scorep_mpi_handle_table scorep_mpi_comms;
 
 /**
  * @internal
@@ -300,7 +300,7 @@ POMP2_Critical_begin( POMP2_Region_handle* pomp_handle )
         SCOREP_Opari2_Openmp_Region* region = *( SCOREP_Opari2_Openmp_Region** )pomp_handle;
         region->lock->acquisition_order++;
         SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP,
-                                  region->lock->handle,
+                                  region->lock->id,
                                   region->lock->acquisition_order );
         SCOREP_EnterRegion( region->innerBlock );
     }
@@ -320,7 +320,7 @@ POMP2_Critical_end( POMP2_Region_handle* pomp_handle )
         SCOREP_Opari2_Openmp_Region* region = *( SCOREP_Opari2_Openmp_Region** )pomp_handle;
         SCOREP_ExitRegion( region->innerBlock );
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP,
-                                  region->lock->handle,
+                                  region->lock->id,
                                   region->lock->acquisition_order );
     }
 
@@ -1155,16 +1155,16 @@ POMP2_Set_lock( omp_lock_t* s )
         SCOREP_EnterWrapper( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_LOCK ] );
     }
 
+    uint64_t begin_wait = scorep_opari2_recording_on ? SCOREP_Lock_BeginWait() : 0;
     SCOREP_ENTER_WRAPPED_REGION();
     omp_set_lock( s );
     SCOREP_EXIT_WRAPPED_REGION();
 
     if ( scorep_opari2_recording_on )
     {
-        SCOREP_MutexLock( scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireLock( s );
-        SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+        SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
+        SCOREP_Lock_EndWait( begin_wait );
 
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_LOCK ] );
     }
@@ -1194,10 +1194,8 @@ POMP2_Unset_lock( omp_lock_t* s )
     {
         SCOREP_EnterWrappedRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_UNSET_LOCK ] );
 
-        SCOREP_MutexLock( scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetReleaseLock( s );
-        SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+        SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -1250,10 +1248,8 @@ POMP2_Test_lock( omp_lock_t* s )
     {
         if ( result )
         {
-            SCOREP_MutexLock( scorep_opari2_openmp_lock );
             SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireLock( s );
-            SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-            SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+            SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
         }
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_TEST_LOCK ] );
     }
@@ -1370,16 +1366,16 @@ POMP2_Set_nest_lock( omp_nest_lock_t* s )
         SCOREP_EnterWrapper( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_NEST_LOCK ] );
     }
 
+    uint64_t begin_wait = scorep_opari2_recording_on ? SCOREP_Lock_BeginWait() : 0;
     SCOREP_ENTER_WRAPPED_REGION();
     omp_set_nest_lock( s );
     SCOREP_EXIT_WRAPPED_REGION();
 
     if ( scorep_opari2_recording_on )
     {
-        SCOREP_MutexLock( scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireNestLock( s );
-        SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+        SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
+        SCOREP_Lock_EndWait( begin_wait );
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_NEST_LOCK ] );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
@@ -1407,10 +1403,8 @@ POMP2_Unset_nest_lock( omp_nest_lock_t* s )
     if ( scorep_opari2_recording_on )
     {
         SCOREP_EnterWrappedRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_UNSET_NEST_LOCK ] );
-        SCOREP_MutexLock( scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetReleaseNestLock( s );
-        SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+        SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -1463,10 +1457,8 @@ POMP2_Test_nest_lock( omp_nest_lock_t* s )
     {
         if ( result )
         {
-            SCOREP_MutexLock( scorep_opari2_openmp_lock );
             SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireNestLock( s );
-            SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-            SCOREP_MutexUnlock( scorep_opari2_openmp_lock );
+            SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->id, lock->acquisition_order );
         }
 
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_TEST_NEST_LOCK ] );
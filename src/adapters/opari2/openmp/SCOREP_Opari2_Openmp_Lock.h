@@ -39,6 +39,7 @@
  */
 
 #include <scorep/SCOREP_PublicTypes.h>
+#include <SCOREP_LockRegistry.h>
 #include <SCOREP_Mutex.h>
 #include <stdint.h>
 
@@ -67,23 +68,13 @@ enum SCOREP_Opari2_Openmp_Lock_Region_Index
 
 extern SCOREP_RegionHandle scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_LOCK_NUM ];
 
-typedef struct SCOREP_Opari2_Openmp_Lock SCOREP_Opari2_Openmp_Lock;
+/** The scorep lock representation, keyed by the address of the OMP lock or the
+    name of the critical region. The nesting level is only used for nested locks. */
+typedef SCOREP_Lock SCOREP_Opari2_Openmp_Lock;
 
-struct SCOREP_Opari2_Openmp_Lock
-{
-    const void*                          lock;
-    SCOREP_Opari2_Openmp_Lock_HandleType handle;
-    uint32_t                             acquisition_order;
-    uint32_t                             nest_level; // only used for nested locks
-};
-
-/** Mutex to ensure exclusive access to opari2_openmp_lock lock data structure.
- */
-extern SCOREP_Mutex scorep_opari2_openmp_lock;
-
-/** Initializes a new lock handle.
+/** Initializes a new lock handle, or returns the existing one.
     @param lock The OMP lock which should be initialized
-    @returns the new SCOREP lock handle.
+    @returns the SCOREP lock handle.
  */
 SCOREP_Opari2_Openmp_Lock*
 scorep_opari2_openmp_lock_init( const void* lock );
@@ -264,11 +264,7 @@ scorep_opari2_register_openmp_region( SCOREP_Opari2_Openmp_Region* region )
     /* Register locks for critical regions */
     if ( region->regionType == SCOREP_POMP2_Critical )
     {
-        region->lock = SCOREP_Opari2_Openmp_GetLock( region->name );
-        if ( region->lock == NULL )
-        {
-            region->lock = scorep_opari2_openmp_lock_init( region->name );
-        }
+        region->lock = scorep_opari2_openmp_lock_init( region->name );
     }
 }
 
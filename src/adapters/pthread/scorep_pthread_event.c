@@ -556,6 +556,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_mutex_lock )( pthread_mutex_t* pthreadMutex )
 
     SCOREP_EnterWrappedRegion( scorep_pthread_regions[ SCOREP_PTHREAD_MUTEX_LOCK ] );
 
+    uint64_t begin_wait = SCOREP_Lock_BeginWait();
     SCOREP_ENTER_WRAPPED_REGION();
     int result = SCOREP_LIBWRAP_FUNC_CALL( pthread_mutex_lock, ( pthreadMutex ) );
     SCOREP_EXIT_WRAPPED_REGION();
@@ -567,6 +568,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_mutex_lock )( pthread_mutex_t* pthreadMutex )
         if ( result == 0 )
         {
             record_acquire_lock_event( scorep_mutex );
+            SCOREP_Lock_EndWait( begin_wait );
         }
 
         SCOREP_ExitRegion( scorep_pthread_regions[ SCOREP_PTHREAD_MUTEX_LOCK ] );
@@ -584,14 +586,14 @@ record_acquire_lock_event( scorep_pthread_mutex* scorepMutex )
     if ( scorepMutex->process_shared == false )
     {
         /* Inside the lock, save to modify scorepMutex object. */
-        if ( scorepMutex->nesting_level == 0 )
+        if ( scorepMutex->lock.nesting_level == 0 )
         {
-            scorepMutex->acquisition_order++;
+            scorepMutex->lock.acquisition_order++;
         }
-        scorepMutex->nesting_level++;
+        scorepMutex->lock.nesting_level++;
         SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_PTHREAD,
-                                  scorepMutex->id,
-                                  scorepMutex->acquisition_order );
+                                  scorepMutex->lock.id,
+                                  scorepMutex->lock.acquisition_order );
     }
     else
     {
@@ -615,7 +617,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_mutex_unlock )( pthread_mutex_t* pthreadMutex
     scorep_pthread_mutex* scorep_mutex = scorep_pthread_mutex_hash_get( pthreadMutex );
     UTILS_BUG_ON( scorep_mutex == 0,
                   "Undefined behavior: unlocking unlocked mutex %p", pthreadMutex );
-    if ( scorep_mutex->nesting_level == 0 )
+    if ( scorep_mutex->lock.nesting_level == 0 )
     {
         UTILS_WARNING( "Undefined behavior: unlocking unlocked mutex %p", pthreadMutex );
     }
@@ -625,13 +627,13 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_mutex_unlock )( pthread_mutex_t* pthreadMutex
     if ( scorep_mutex->process_shared == false )
     {
         /* Still inside the lock, save to modify scorep_mutex object. */
-        if ( scorep_mutex->nesting_level != 0 )
+        if ( scorep_mutex->lock.nesting_level != 0 )
         {
-            scorep_mutex->nesting_level--;
+            scorep_mutex->lock.nesting_level--;
         }
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_PTHREAD,
-                                  scorep_mutex->id,
-                                  scorep_mutex->acquisition_order );
+                                  scorep_mutex->lock.id,
+                                  scorep_mutex->lock.acquisition_order );
     }
     else
     {
@@ -788,17 +790,17 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_cond_wait )( pthread_cond_t*  cond,
     scorep_pthread_mutex* scorep_mutex = scorep_pthread_mutex_hash_get( pthreadMutex );
     UTILS_BUG_ON( scorep_mutex == 0,
                   "Pthread mutex %p is required to be locked", pthreadMutex );
-    UTILS_BUG_ON( scorep_mutex->nesting_level == 0,
+    UTILS_BUG_ON( scorep_mutex->lock.nesting_level == 0,
                   "Pthread mutex %p is required to be locked", pthreadMutex );
 
     SCOREP_EnterWrappedRegion( scorep_pthread_regions[ SCOREP_PTHREAD_COND_WAIT ] );
 
     if ( scorep_mutex->process_shared == false )
     {
-        scorep_mutex->nesting_level--;
+        scorep_mutex->lock.nesting_level--;
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_PTHREAD,
-                                  scorep_mutex->id,
-                                  scorep_mutex->acquisition_order );
+                                  scorep_mutex->lock.id,
+                                  scorep_mutex->lock.acquisition_order );
     }
     else
     {
@@ -817,11 +819,11 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_cond_wait )( pthread_cond_t*  cond,
     {
         if ( scorep_mutex->process_shared == false )
         {
-            scorep_mutex->acquisition_order++;
-            scorep_mutex->nesting_level++;
+            scorep_mutex->lock.acquisition_order++;
+            scorep_mutex->lock.nesting_level++;
             SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_PTHREAD,
-                                      scorep_mutex->id,
-                                      scorep_mutex->acquisition_order );
+                                      scorep_mutex->lock.id,
+                                      scorep_mutex->lock.acquisition_order );
         }
         else
         {
@@ -858,17 +860,17 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_cond_timedwait )( pthread_cond_t*        cond,
     scorep_pthread_mutex* scorep_mutex = scorep_pthread_mutex_hash_get( pthreadMutex );
     UTILS_BUG_ON( scorep_mutex == 0,
                   "Pthread mutex %p is required to be locked", pthreadMutex );
-    UTILS_BUG_ON( scorep_mutex->nesting_level == 0,
+    UTILS_BUG_ON( scorep_mutex->lock.nesting_level == 0,
                   "Pthread mutex %p is required to be locked", pthreadMutex );
 
     SCOREP_EnterWrappedRegion( scorep_pthread_regions[ SCOREP_PTHREAD_COND_TIMEDWAIT ] );
 
     if ( scorep_mutex->process_shared == false )
     {
-        scorep_mutex->nesting_level--;
+        scorep_mutex->lock.nesting_level--;
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_PTHREAD,
-                                  scorep_mutex->id,
-                                  scorep_mutex->acquisition_order );
+                                  scorep_mutex->lock.id,
+                                  scorep_mutex->lock.acquisition_order );
     }
     else
     {
@@ -887,11 +889,11 @@ SCOREP_LIBWRAP_FUNC_NAME( pthread_cond_timedwait )( pthread_cond_t*        cond,
     {
         if ( scorep_mutex->process_shared == false )
         {
-            scorep_mutex->acquisition_order++;
-            scorep_mutex->nesting_level++;
+            scorep_mutex->lock.acquisition_order++;
+            scorep_mutex->lock.nesting_level++;
             SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_PTHREAD,
-                                      scorep_mutex->id,
-                                      scorep_mutex->acquisition_order );
+                                      scorep_mutex->lock.id,
+                                      scorep_mutex->lock.acquisition_order );
         }
         else
         {
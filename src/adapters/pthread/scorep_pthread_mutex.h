@@ -20,6 +20,8 @@
  */
 
 
+#include <SCOREP_LockRegistry.h>
+
 #include <stdint.h>
 #include <pthread.h>
 #include <stdbool.h>
@@ -28,14 +30,9 @@
 typedef struct scorep_pthread_mutex scorep_pthread_mutex;
 struct scorep_pthread_mutex
 {
-    scorep_pthread_mutex* next;        /* Separate chaining with linked lists. */
-    void*                 key;         /* Used as key to hash function.
-                                        * uintptr_t also possible */
-
-    uint32_t id;                       /* [0, N[ */
-    uint32_t acquisition_order;
-    uint32_t nesting_level;
-    bool     process_shared;
+    SCOREP_Lock lock;                  /* Needs to be the first member,
+                                        * key is the pthread_mutex_t. */
+    bool        process_shared;
 };
 
 
@@ -149,7 +149,7 @@ scorep_shmem_teardown_comm_world( void )
 
     CALL_SHMEM( shmem_barrier_all )();
 
-    free( scorep_shmem_pe_groups.hash_table );
+    scorep_definitions_manager_entry_free_hash_table( &scorep_shmem_pe_groups );
 }
 
 /**
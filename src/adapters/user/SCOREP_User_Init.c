@@ -157,9 +157,10 @@ SCOREP_Mutex scorep_user_region_by_name_mutex = SCOREP_INVALID_MUTEX;
 SCOREP_Hashtab* scorep_user_region_table = NULL;
 
 /*
- * Hastable for the regions by name
+ * Hastable for the regions by name, searched without holding
+ * scorep_user_region_by_name_mutex
  */
-SCOREP_Hashtab* scorep_user_region_by_name_hash_table = NULL;
+SCOREP_ConcurrentHashtab* scorep_user_region_by_name_hash_table = NULL;
 
 void
 scorep_user_init_regions( void )
@@ -170,9 +171,9 @@ scorep_user_init_regions( void )
     scorep_user_region_table = SCOREP_Hashtab_CreateSize( 10, &SCOREP_Hashtab_HashString,
                                                           &SCOREP_Hashtab_CompareStrings );
     /* create empty hashtab for regions by name */
-    scorep_user_region_by_name_hash_table = SCOREP_Hashtab_CreateSize( SCOREP_USER_REGION_BY_NAME_SIZE,
-                                                                       &SCOREP_Hashtab_HashString,
-                                                                       &SCOREP_Hashtab_CompareStrings );
+    scorep_user_region_by_name_hash_table = SCOREP_ConcurrentHashtab_CreateSize( SCOREP_USER_REGION_BY_NAME_SIZE,
+                                                                                 &SCOREP_Hashtab_HashString,
+                                                                                 &SCOREP_Hashtab_CompareStrings );
 }
 
 void
@@ -184,9 +185,9 @@ scorep_user_finalize_regions( void )
                             &SCOREP_Hashtab_DeleteFree,
                             &SCOREP_Hashtab_DeleteNone );
 
-    SCOREP_Hashtab_FreeAll( scorep_user_region_by_name_hash_table,
-                            &SCOREP_Hashtab_DeleteNone,
-                            &SCOREP_Hashtab_DeleteNone );
+    SCOREP_ConcurrentHashtab_FreeAll( scorep_user_region_by_name_hash_table,
+                                      &SCOREP_Hashtab_DeleteNone,
+                                      &SCOREP_Hashtab_DeleteNone );
 
     scorep_user_region_table = NULL;
     SCOREP_MutexDestroy( &scorep_user_file_table_mutex );
@@ -69,7 +69,7 @@ extern SCOREP_Mutex scorep_user_region_by_name_mutex;
 /**
    Maximum size of by name region hash table
  */
-extern SCOREP_Hashtab* scorep_user_region_by_name_hash_table;
+extern SCOREP_ConcurrentHashtab* scorep_user_region_by_name_hash_table;
 
 /**
     @internal
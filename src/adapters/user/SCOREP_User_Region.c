@@ -256,14 +256,14 @@ SCOREP_User_RegionByNameBegin( const char*                  name,
     SCOREP_Hashtab_Entry*    result;
 
     /* search handle in the hashtab */
-    result = SCOREP_Hashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, NULL );
+    result = SCOREP_ConcurrentHashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, NULL );
 
     /* if it's an invalid handle, or added by mistake (==NULL) create new, valid handle */
     if ( result == NULL )
     {
         SCOREP_MutexLock( scorep_user_region_by_name_mutex );
         size_t hash_hint;
-        result = SCOREP_Hashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, &hash_hint );
+        result = SCOREP_ConcurrentHashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, &hash_hint );
         if ( result == NULL )
         {
             SCOREP_User_RegionInit( &handle, NULL, NULL,
@@ -275,18 +275,18 @@ SCOREP_User_RegionByNameBegin( const char*                  name,
                 saved_name[ strlen( name ) ] = '\0';
                 strncpy( saved_name, name, strlen( name ) );
 
-                result = SCOREP_Hashtab_InsertPtr( scorep_user_region_by_name_hash_table,
-                                                   ( void* )saved_name,
-                                                   ( void* )handle,
-                                                   &hash_hint );
+                result = SCOREP_ConcurrentHashtab_InsertPtr( scorep_user_region_by_name_hash_table,
+                                                             ( void* )saved_name,
+                                                             ( void* )handle,
+                                                             &hash_hint );
             }
             else
             {
                 /* insert handle into hashtab, handle is only a ptr hence we can cast to void* */
-                result = SCOREP_Hashtab_InsertPtr( scorep_user_region_by_name_hash_table,
-                                                   ( void* )SCOREP_RegionHandle_GetName( handle->handle ),
-                                                   ( void* )handle,
-                                                   &hash_hint );
+                result = SCOREP_ConcurrentHashtab_InsertPtr( scorep_user_region_by_name_hash_table,
+                                                             ( void* )SCOREP_RegionHandle_GetName( handle->handle ),
+                                                             ( void* )handle,
+                                                             &hash_hint );
             }
         }
         SCOREP_MutexUnlock( scorep_user_region_by_name_mutex );
@@ -325,7 +325,7 @@ SCOREP_User_RegionByNameEnd( const char* name )
     UTILS_DEBUG_ENTRY( "end region by name: %s", name );
 
     /* search for handle in hashtab */
-    SCOREP_Hashtab_Entry* result = SCOREP_Hashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, NULL );
+    SCOREP_Hashtab_Entry* result = SCOREP_ConcurrentHashtab_Find( scorep_user_region_by_name_hash_table, ( void* )name, NULL );
 
     /* if handle not found, end-region without begin-region */
     UTILS_BUG_ON( !result, "Trying to leave a region-by-name never entered: '%s'", name ); /* Error */
@@ -105,6 +105,51 @@ SCOREP_Sample( SCOREP_InterruptGeneratorHandle interruptGeneratorHandle,
 }
 
 
+void
+SCOREP_Location_SampleCallchain( SCOREP_Location*                location,
+                                 uint64_t                        timestamp,
+                                 SCOREP_InterruptGeneratorHandle interruptGeneratorHandle,
+                                 const uint64_t*                 callchain,
+                                 uint32_t                        callchainDepth )
+{
+    UTILS_BUG_ON( !SCOREP_IsUnwindingEnabled(), "Invalid call." );
+
+    /* The sample may have been taken while the measurement processed the
+       last event, keep the order of the timestamps */
+    uint64_t last_timestamp = SCOREP_Location_GetLastTimestamp( location );
+    if ( timestamp < last_timestamp )
+    {
+        timestamp = last_timestamp;
+    }
+    SCOREP_Location_SetLastTimestamp( location, timestamp );
+
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
+
+    SCOREP_CallingContextHandle current_calling_context  = SCOREP_INVALID_CALLING_CONTEXT;
+    SCOREP_CallingContextHandle previous_calling_context = SCOREP_INVALID_CALLING_CONTEXT;
+    uint32_t                    unwind_distance;
+    SCOREP_Unwinding_GetCallchainCallingContext( location,
+                                                 callchain,
+                                                 callchainDepth,
+                                                 &current_calling_context,
+                                                 &previous_calling_context,
+                                                 &unwind_distance );
+    if ( current_calling_context == SCOREP_INVALID_CALLING_CONTEXT )
+    {
+        return;
+    }
+
+    SCOREP_CALL_SUBSTRATE( Sample, SAMPLE,
+                           ( location,
+                             timestamp,
+                             current_calling_context,
+                             previous_calling_context,
+                             unwind_distance,
+                             interruptGeneratorHandle,
+                             metric_values ) );
+}
+
+
 /* Used by the unwinding to trigger a final sample just before CPU deactivation */
 void
 SCOREP_Location_DeactivateCpuSample( SCOREP_Location*            location,
@@ -197,12 +242,30 @@ scorep_calling_context_enter( SCOREP_Location*    location,
 }
 
 
+/**
+ * Records the deferred samples of @a location before its instrumented regions
+ * change. Without a registered sample drain this is only a flag test.
+ */
+static inline void
+drain_samples( SCOREP_Location* location )
+{
+#if HAVE( SAMPLING_SUPPORT )
+    if ( scorep_unwinding_has_sample_drains && SCOREP_IsUnwindingEnabled() )
+    {
+        SCOREP_Unwinding_DrainSamples( location );
+    }
+#endif
+}
+
+
 void
 SCOREP_EnterRegion( SCOREP_RegionHandle regionHandle )
 {
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = scorep_get_timestamp( location );
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+    SCOREP_Location* location = SCOREP_Location_GetCurrentCPULocation();
+    drain_samples( location );
+
+    uint64_t  timestamp     = scorep_get_timestamp( location );
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
 
     if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -256,9 +319,11 @@ SCOREP_Location_EnterRegion( SCOREP_Location*    location,
 void
 SCOREP_EnterWrappedRegion( SCOREP_RegionHandle regionHandle )
 {
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = scorep_get_timestamp( location );
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+    SCOREP_Location* location = SCOREP_Location_GetCurrentCPULocation();
+    drain_samples( location );
+
+    uint64_t  timestamp     = scorep_get_timestamp( location );
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
 
     if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -333,9 +398,11 @@ scorep_calling_context_exit( SCOREP_Location*    location,
 void
 SCOREP_ExitRegion( SCOREP_RegionHandle regionHandle )
 {
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = scorep_get_timestamp( location );
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+    SCOREP_Location* location = SCOREP_Location_GetCurrentCPULocation();
+    drain_samples( location );
+
+    uint64_t  timestamp     = scorep_get_timestamp( location );
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
 
     if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -0,0 +1,377 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Registry of application lock objects, see SCOREP_LockRegistry.h.
+ *
+ * The table uses linear probing and holds at most half as many used slots
+ * (registered locks plus tombstones) as it has slots, thus every probe
+ * sequence ends at an empty slot. When it would become fuller, a new table is
+ * filled under the registry mutex and published with a release store. The old
+ * table is kept until the registry is deleted, thus readers which still
+ * probe it are never left with a dangling pointer. If such a reader misses
+ * a lock which was registered in the meantime, SCOREP_LockRegistry_Get()
+ * repeats the lookup under the mutex.
+ */
+
+#include <config.h>
+
+#include <SCOREP_LockRegistry.h>
+
+#include <SCOREP_Atomic.h>
+#include <SCOREP_Definitions.h>
+#include <SCOREP_Events.h>
+#include <SCOREP_Memory.h>
+#include <SCOREP_Mutex.h>
+#include <UTILS_Error.h>
+
+#include "scorep_environment.h"
+
+#include <stdlib.h>
+#include <string.h>
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+#include <time.h>
+#else
+#include <sys/time.h>
+#endif
+
+
+#define INITIAL_TABLE_POWER 8
+
+/* Marks a slot of a removed lock, probe sequences continue behind it */
+#define TOMBSTONE ( ( SCOREP_Lock* )1 )
+
+
+typedef struct lock_table lock_table;
+struct lock_table
+{
+    lock_table*  retired_next;
+    uint32_t     power;
+    SCOREP_Lock* slots[];
+};
+
+
+struct SCOREP_LockRegistry
+{
+    lock_table*  table;
+    SCOREP_Mutex mutex;
+    size_t       lock_size;
+    uint32_t     number_of_locks;
+    uint32_t     number_of_tombstones;
+    uint32_t     next_id;
+    SCOREP_Lock* free_list;
+    lock_table*  retired_tables;
+};
+
+
+static SCOREP_SamplingSetHandle lock_wait_time_sampling_set = SCOREP_INVALID_SAMPLING_SET;
+
+
+static inline uint32_t
+get_slot( const void* key,
+          uint32_t    power )
+{
+    /* Fibonacci hashing, the low bits of lock addresses carry no information */
+    return ( uint32_t )( ( ( uint64_t )( uintptr_t )key * UINT64_C( 0x9E3779B97F4A7C15 ) )
+                         >> ( 64 - power ) );
+}
+
+
+static lock_table*
+new_table( uint32_t power )
+{
+    lock_table* table = calloc( 1, sizeof( *table ) + ( ( size_t )1 << power ) * sizeof( SCOREP_Lock* ) );
+    UTILS_BUG_ON( table == NULL, "Failed to allocate lock registry table." );
+    table->power = power;
+    return table;
+}
+
+
+static void
+define_lock_wait_time_metric( void )
+{
+    if ( lock_wait_time_sampling_set != SCOREP_INVALID_SAMPLING_SET
+         || !SCOREP_Env_DoLockWaitTime() )
+    {
+        return;
+    }
+
+    SCOREP_MetricHandle metric =
+        SCOREP_Definitions_NewMetric( "lock wait time",
+                                      "Time spent waiting for a lock before it was acquired",
+                                      SCOREP_METRIC_SOURCE_TYPE_OTHER,
+                                      SCOREP_METRIC_MODE_ABSOLUTE_POINT,
+                                      SCOREP_METRIC_VALUE_UINT64,
+                                      SCOREP_METRIC_BASE_DECIMAL,
+                                      -9,
+                                      "s",
+                                      SCOREP_METRIC_PROFILING_TYPE_EXCLUSIVE,
+                                      SCOREP_INVALID_METRIC );
+    lock_wait_time_sampling_set =
+        SCOREP_Definitions_NewSamplingSet( 1, &metric,
+                                           SCOREP_METRIC_OCCURRENCE_ASYNCHRONOUS,
+                                           SCOREP_SAMPLING_SET_CPU );
+}
+
+
+SCOREP_LockRegistry*
+SCOREP_LockRegistry_New( size_t lockSize )
+{
+    UTILS_BUG_ON( lockSize < sizeof( SCOREP_Lock ), "Invalid lock object size." );
+
+    SCOREP_LockRegistry* registry = calloc( 1, sizeof( *registry ) );
+    UTILS_BUG_ON( registry == NULL, "Failed to allocate lock registry." );
+
+    SCOREP_ErrorCode result = SCOREP_MutexCreate( &registry->mutex );
+    UTILS_BUG_ON( result != SCOREP_SUCCESS, "Failed to create lock registry mutex." );
+
+    registry->lock_size = lockSize;
+    registry->table     = new_table( INITIAL_TABLE_POWER );
+
+    define_lock_wait_time_metric();
+
+    return registry;
+}
+
+
+void
+SCOREP_LockRegistry_Delete( SCOREP_LockRegistry* registry )
+{
+    if ( registry == NULL )
+    {
+        return;
+    }
+
+    while ( registry->retired_tables )
+    {
+        lock_table* table = registry->retired_tables;
+        registry->retired_tables = table->retired_next;
+        free( table );
+    }
+    free( registry->table );
+
+    /* The lock objects live in the misc memory of the measurement. */
+    SCOREP_MutexDestroy( &registry->mutex );
+    free( registry );
+}
+
+
+static SCOREP_Lock*
+find_lock( lock_table* table,
+           const void* key )
+{
+    uint32_t mask = ( ( uint32_t )1 << table->power ) - 1;
+    uint32_t slot = get_slot( key, table->power );
+    while ( true )
+    {
+        SCOREP_Lock* lock = SCOREP_ATOMIC_LOAD( &table->slots[ slot ], SCOREP_ATOMIC_ACQUIRE );
+        if ( lock == NULL )
+        {
+            return NULL;
+        }
+        /* Pairs with the release store of the key when the object is
+           (re)used, a matching key comes with the fields set before it. */
+        if ( lock != TOMBSTONE
+             && SCOREP_ATOMIC_LOAD( &lock->key, SCOREP_ATOMIC_ACQUIRE ) == key )
+        {
+            return lock;
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+}
+
+
+/* Call with registry mutex locked. */
+static void
+rebuild_table( SCOREP_LockRegistry* registry )
+{
+    lock_table* old_table = registry->table;
+    uint32_t    power     = INITIAL_TABLE_POWER;
+    while ( ( ( uint64_t )registry->number_of_locks + 1 ) * 4 > ( ( uint64_t )1 << power ) )
+    {
+        power++;
+    }
+    UTILS_BUG_ON( power > 31, "Too many locks in lock registry." );
+
+    lock_table* table = new_table( power );
+    uint32_t    mask  = ( ( uint32_t )1 << power ) - 1;
+    for ( uint64_t i = 0; i < ( ( uint64_t )1 << old_table->power ); i++ )
+    {
+        SCOREP_Lock* lock = old_table->slots[ i ];
+        if ( lock == NULL || lock == TOMBSTONE )
+        {
+            continue;
+        }
+        uint32_t slot = get_slot( lock->key, power );
+        while ( table->slots[ slot ] )
+        {
+            slot = ( slot + 1 ) & mask;
+        }
+        table->slots[ slot ] = lock;
+    }
+    registry->number_of_tombstones = 0;
+
+    SCOREP_ATOMIC_STORE( &registry->table, table, SCOREP_ATOMIC_RELEASE );
+
+    old_table->retired_next  = registry->retired_tables;
+    registry->retired_tables = old_table;
+}
+
+
+SCOREP_Lock*
+SCOREP_LockRegistry_Get( SCOREP_LockRegistry* registry,
+                         const void*          key )
+{
+    SCOREP_Lock* lock = find_lock( SCOREP_ATOMIC_LOAD( &registry->table, SCOREP_ATOMIC_ACQUIRE ), key );
+    if ( lock )
+    {
+        return lock;
+    }
+
+    /* Maybe we probed a table which was replaced in the meantime */
+    SCOREP_MutexLock( registry->mutex );
+    lock = find_lock( registry->table, key );
+    SCOREP_MutexUnlock( registry->mutex );
+    return lock;
+}
+
+
+SCOREP_Lock*
+SCOREP_LockRegistry_Insert( SCOREP_LockRegistry* registry,
+                            const void*          key )
+{
+    SCOREP_MutexLock( registry->mutex );
+
+    SCOREP_Lock* lock = find_lock( registry->table, key );
+    if ( lock )
+    {
+        SCOREP_MutexUnlock( registry->mutex );
+        return lock;
+    }
+
+    if ( ( ( uint64_t )registry->number_of_locks + registry->number_of_tombstones + 1 ) * 2
+         > ( ( uint64_t )1 << registry->table->power ) )
+    {
+        rebuild_table( registry );
+    }
+
+    if ( registry->free_list )
+    {
+        lock                = registry->free_list;
+        registry->free_list = lock->next;
+    }
+    else
+    {
+        lock = SCOREP_Memory_AllocForMisc( registry->lock_size );
+        UTILS_BUG_ON( lock == NULL, "Failed to allocate memory for lock object." );
+    }
+
+    /* A reader of an old table may still inspect the key of a reused object.
+       Set the key last, a reader that sees it sees the other fields too. */
+    memset( ( char* )lock + sizeof( SCOREP_Lock ), 0, registry->lock_size - sizeof( SCOREP_Lock ) );
+    lock->next              = NULL;
+    lock->id                = registry->next_id++;
+    lock->acquisition_order = 0;
+    lock->nesting_level     = 0;
+    SCOREP_ATOMIC_STORE( &lock->key, key, SCOREP_ATOMIC_RELEASE );
+
+    lock_table* table = registry->table;
+    uint32_t    mask  = ( ( uint32_t )1 << table->power ) - 1;
+    uint32_t    slot  = get_slot( key, table->power );
+    while ( table->slots[ slot ] && table->slots[ slot ] != TOMBSTONE )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+    if ( table->slots[ slot ] == TOMBSTONE )
+    {
+        registry->number_of_tombstones--;
+    }
+    SCOREP_ATOMIC_STORE( &table->slots[ slot ], lock, SCOREP_ATOMIC_RELEASE );
+    registry->number_of_locks++;
+
+    SCOREP_MutexUnlock( registry->mutex );
+    return lock;
+}
+
+
+bool
+SCOREP_LockRegistry_Remove( SCOREP_LockRegistry* registry,
+                            const void*          key )
+{
+    SCOREP_MutexLock( registry->mutex );
+
+    lock_table* table = registry->table;
+    uint32_t    mask  = ( ( uint32_t )1 << table->power ) - 1;
+    uint32_t    slot  = get_slot( key, table->power );
+    while ( table->slots[ slot ] )
+    {
+        SCOREP_Lock* lock = table->slots[ slot ];
+        if ( lock != TOMBSTONE && lock->key == key )
+        {
+            SCOREP_ATOMIC_STORE( &table->slots[ slot ], TOMBSTONE, SCOREP_ATOMIC_RELEASE );
+            SCOREP_ATOMIC_STORE( &lock->key, NULL, SCOREP_ATOMIC_RELAXED );
+            lock->next          = registry->free_list;
+            registry->free_list = lock;
+            registry->number_of_locks--;
+            registry->number_of_tombstones++;
+
+            SCOREP_MutexUnlock( registry->mutex );
+            return true;
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+
+    SCOREP_MutexUnlock( registry->mutex );
+    return false;
+}
+
+
+/* The resolution of the measurement timer is only known after the
+ * measurement, wait times are thus taken from a clock in nanoseconds. */
+static inline uint64_t
+get_wait_clock( void )
+{
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+    struct timespec time;
+    clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+#else
+    struct timeval time;
+    gettimeofday( &time, NULL );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_usec * 1000;
+#endif
+}
+
+
+uint64_t
+SCOREP_Lock_BeginWait( void )
+{
+    if ( lock_wait_time_sampling_set == SCOREP_INVALID_SAMPLING_SET )
+    {
+        return 0;
+    }
+    return get_wait_clock();
+}
+
+
+void
+SCOREP_Lock_EndWait( uint64_t beginWait )
+{
+    if ( beginWait == 0 )
+    {
+        return;
+    }
+    SCOREP_TriggerCounterUint64( lock_wait_time_sampling_set,
+                                 get_wait_clock() - beginWait );
+}
@@ -86,7 +86,7 @@ static SCOREP_Mutex out_of_memory_mutex;
 
 /// The one and only allocator for the measurement and the adapters
 static SCOREP_Allocator_Allocator* allocator;
-static uint32_t                    total_memory;
+static uint64_t                    total_memory;
 static uint32_t                    page_size;
 
 static bool is_initialized;
@@ -96,7 +96,8 @@ static SCOREP_Allocator_PageManager* definitions_page_manager;
 
 void
 SCOREP_Memory_Initialize( uint64_t totalMemory,
-                          uint64_t pageSize )
+                          uint64_t pageSize,
+                          bool     hugePages )
 {
     if ( is_initialized )
     {
@@ -107,28 +108,46 @@ SCOREP_Memory_Initialize( uint64_t totalMemory,
     SCOREP_MutexCreate( &memory_lock );
     SCOREP_MutexCreate( &out_of_memory_mutex );
 
-    if ( totalMemory > ( uint64_t )UINT32_MAX )
+    /* Only the arena allocator can address more than 4 GiB */
+    bool use_arenas = SIZE_MAX > UINT32_MAX
+                      && ( totalMemory > ( uint64_t )UINT32_MAX || hugePages );
+    if ( !use_arenas && totalMemory > ( uint64_t )UINT32_MAX )
     {
         UTILS_WARNING( "Too many memory requested. "
                        "Score-P supports only up to, but not including, 4 GiB of "
-                       "total memory per process. Reducing to its maximum value." );
+                       "total memory per process on this platform. Reducing to "
+                       "its maximum value." );
         totalMemory = UINT32_MAX;
     }
 
-    UTILS_BUG_ON( totalMemory < pageSize,
+    UTILS_BUG_ON( totalMemory < pageSize || pageSize > UINT32_MAX,
                   "Requested page size must fit into the total memory "
                   "(SCOREP_TOTAL_MEMORY=%" PRIu64 ", SCOREP_PAGE_SIZE=%" PRIu64 ")",
                   totalMemory, pageSize );
 
-    total_memory = totalMemory;
-    page_size    = pageSize;
-
-    allocator = SCOREP_Allocator_CreateAllocator(
-        &total_memory,
-        &page_size,
-        ( SCOREP_Allocator_Guard )SCOREP_MutexLock,
-        ( SCOREP_Allocator_Guard )SCOREP_MutexUnlock,
-        ( SCOREP_Allocator_GuardObject )memory_lock );
+    page_size = pageSize;
+    if ( use_arenas )
+    {
+        total_memory = totalMemory;
+        allocator    = SCOREP_Allocator_CreateArenaAllocator(
+            &total_memory,
+            &page_size,
+            hugePages,
+            ( SCOREP_Allocator_Guard )SCOREP_MutexLock,
+            ( SCOREP_Allocator_Guard )SCOREP_MutexUnlock,
+            ( SCOREP_Allocator_GuardObject )memory_lock );
+    }
+    else
+    {
+        uint32_t total_memory_32 = totalMemory;
+        allocator = SCOREP_Allocator_CreateAllocator(
+            &total_memory_32,
+            &page_size,
+            ( SCOREP_Allocator_Guard )SCOREP_MutexLock,
+            ( SCOREP_Allocator_Guard )SCOREP_MutexUnlock,
+            ( SCOREP_Allocator_GuardObject )memory_lock );
+        total_memory = total_memory_32;
+    }
 
     UTILS_BUG_ON( !allocator,
                   "Cannot create memory manager for "
@@ -186,7 +205,7 @@ SCOREP_Memory_HandleOutOfMemory( void )
     }
 
     UTILS_ERROR( SCOREP_ERROR_MEMORY_OUT_OF_PAGES,
-                 "Out of memory. Please increase SCOREP_TOTAL_MEMORY=%zu and try again.",
+                 "Out of memory. Please increase SCOREP_TOTAL_MEMORY=%" PRIu64 " and try again.",
                  total_memory );
     if ( SCOREP_Env_DoTracing() )
     {
@@ -470,7 +489,7 @@ memory_dump_stats_common( const char* message, bool report )
 
         /* requested */
         fprintf( stderr,     "[Score-P] Memory: Requested:\n" );
-        fprintf( stderr,     "[Score-P] %-55s %-15" PRIu32 "\n", "SCOREP_TOTAL_MEMORY [bytes]", total_memory );
+        fprintf( stderr,     "[Score-P] %-55s %-15" PRIu64 "\n", "SCOREP_TOTAL_MEMORY [bytes]", total_memory );
         fprintf( stderr,     "[Score-P] %-55s %-15" PRIu32 "\n", "SCOREP_PAGE_SIZE [bytes]", page_size );
         fprintf( stderr,     "[Score-P] %-55s %-15" PRIu32 "\n\n", "Number of pages of size SCOREP_PAGE_SIZE",
                  SCOREP_Allocator_GetMaxNumberOfPages( allocator ) );
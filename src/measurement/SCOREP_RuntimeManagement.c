@@ -485,7 +485,8 @@ SCOREP_InitMeasurementWithArgs( int argc, char* argv[] )
     SCOREP_TIME( SCOREP_Status_Initialize, ( ) );
 
     SCOREP_TIME( SCOREP_Memory_Initialize,
-                 ( SCOREP_Env_GetTotalMemory(), SCOREP_Env_GetPageSize() ) );
+                 ( SCOREP_Env_GetTotalMemory(), SCOREP_Env_GetPageSize(),
+                   SCOREP_Env_DoMemoryHugePages() ) );
 
 
     SCOREP_TIME( SCOREP_Paradigms_Initialize, ( ) );
@@ -1054,4 +1055,9 @@ synchronize( SCOREP_SynchronizationMode syncMode )
 {
     scorep_subsystems_synchronize( syncMode );
     SCOREP_SynchronizeClocks();
+    if ( syncMode != SCOREP_SYNCHRONIZATION_MODE_END )
+    {
+        /* At the end, SCOREP_Timer_GetClockResolution() checks again */
+        SCOREP_Timer_CheckFrequencies();
+    }
 }
@@ -50,6 +50,7 @@
 #include <scorep/SCOREP_PublicTypes.h>
 #include <SCOREP_Mutex.h>
 #include <SCOREP_Memory.h>
+#include <SCOREP_Atomic.h>
 #include <scorep_system_tree_sequence.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -110,11 +111,20 @@ SCOREP_Definitions_Initialized( void )
 }
 
 
+/* Hash tables do not grow beyond this size */
+#define SCOREP_DEFINITIONS_MAX_HASH_TABLE_POWER ( 28 )
+
+struct scorep_definitions_retired_hash_table
+{
+    struct scorep_definitions_retired_hash_table* next;
+    SCOREP_AnyHandle*                             hash_table;
+};
+
 void
 scorep_definitions_manager_entry_alloc_hash_table( scorep_definitions_manager_entry* entry,
                                                    uint32_t                          hashTablePower )
 {
-    UTILS_BUG_ON( hashTablePower > 15,
+    UTILS_BUG_ON( hashTablePower > SCOREP_DEFINITIONS_MAX_HASH_TABLE_POWER,
                   "Hash table too big: %u", hashTablePower );
     entry->hash_table_mask = hashmask( hashTablePower );
     entry->hash_table      = calloc( hashsize( hashTablePower ), sizeof( *entry->hash_table ) );
@@ -123,6 +133,125 @@ scorep_definitions_manager_entry_alloc_hash_table( scorep_definitions_manager_en
                   hashTablePower );
 }
 
+
+/* Buckets of the replaced hash table moved per added definition. The table
+ * grows again only after more definitions were added than the replaced table
+ * has buckets, thus the moving is usually finished by then. */
+#define SCOREP_DEFINITIONS_MOVED_BUCKETS_PER_ADD ( 2 )
+
+static void
+move_buckets( scorep_definitions_manager_entry* entry,
+              SCOREP_Allocator_PageManager*     pageManager,
+              uint32_t                          numberOfBuckets )
+{
+    uint32_t old_size = entry->old_hash_table_mask + 1;
+    uint32_t end      = old_size - entry->moved_buckets > numberOfBuckets
+                        ? entry->moved_buckets + numberOfBuckets
+                        : old_size;
+
+    /* Lookups without the lock may still traverse the chains while they are
+     * re-linked. They may then miss a definition, but never find a wrong one,
+     * and will find it with the lock held. */
+    for ( uint32_t i = entry->moved_buckets; i < end; i++ )
+    {
+        SCOREP_AnyHandle handle = entry->old_hash_table[ i ];
+        while ( handle != SCOREP_MOVABLE_NULL )
+        {
+            SCOREP_AnyDef* definition =
+                SCOREP_Allocator_GetAddressFromMovableMemory( pageManager, handle );
+            SCOREP_AnyHandle  next   = definition->hash_next;
+            SCOREP_AnyHandle* bucket =
+                &entry->hash_table[ definition->hash_value & entry->hash_table_mask ];
+            SCOREP_ATOMIC_STORE( &definition->hash_next, *bucket, SCOREP_ATOMIC_RELAXED );
+            SCOREP_ATOMIC_STORE( bucket, handle, SCOREP_ATOMIC_RELEASE );
+            handle = next;
+        }
+        SCOREP_ATOMIC_STORE( &entry->old_hash_table[ i ], SCOREP_MOVABLE_NULL, SCOREP_ATOMIC_RELAXED );
+    }
+    entry->moved_buckets = end;
+
+    if ( end == old_size )
+    {
+        /* Lookups read the mask before the table, a mask of 0 is valid for
+         * any table */
+        SCOREP_ATOMIC_STORE( &entry->old_hash_table_mask, 0, SCOREP_ATOMIC_RELEASE );
+        SCOREP_ATOMIC_STORE( &entry->old_hash_table, NULL, SCOREP_ATOMIC_RELEASE );
+        entry->moved_buckets = 0;
+    }
+}
+
+
+void
+scorep_definitions_manager_entry_move_buckets( scorep_definitions_manager_entry* entry,
+                                               SCOREP_Allocator_PageManager*     pageManager )
+{
+    if ( entry->old_hash_table )
+    {
+        move_buckets( entry, pageManager, SCOREP_DEFINITIONS_MOVED_BUCKETS_PER_ADD );
+    }
+}
+
+
+void
+scorep_definitions_manager_entry_grow_hash_table( scorep_definitions_manager_entry* entry,
+                                                  SCOREP_Allocator_PageManager*     pageManager )
+{
+    uint32_t old_size = entry->hash_table_mask + 1;
+    if ( old_size >= hashsize( SCOREP_DEFINITIONS_MAX_HASH_TABLE_POWER ) )
+    {
+        return;
+    }
+
+    struct scorep_definitions_retired_hash_table* retired = malloc( sizeof( *retired ) );
+    SCOREP_AnyHandle*                             new_hash_table =
+        calloc( 2 * old_size, sizeof( *new_hash_table ) );
+    if ( !retired || !new_hash_table )
+    {
+        /* Keep the current table, only the chains get longer */
+        free( retired );
+        free( new_hash_table );
+        return;
+    }
+
+    /* Only one table can be replaced at a time */
+    if ( entry->old_hash_table )
+    {
+        move_buckets( entry, pageManager, UINT32_MAX );
+    }
+
+    retired->hash_table        = entry->hash_table;
+    retired->next              = entry->retired_hash_tables;
+    entry->retired_hash_tables = retired;
+
+    /* Lookups read the mask before the table, thus they use either the old
+     * mask, which is valid for both tables, or the new mask with the new
+     * table. The same holds for the replaced table. */
+    SCOREP_ATOMIC_STORE( &entry->old_hash_table, entry->hash_table, SCOREP_ATOMIC_RELEASE );
+    SCOREP_ATOMIC_STORE( &entry->old_hash_table_mask, entry->hash_table_mask, SCOREP_ATOMIC_RELEASE );
+    entry->moved_buckets = 0;
+    SCOREP_ATOMIC_STORE( &entry->hash_table, new_hash_table, SCOREP_ATOMIC_RELEASE );
+    SCOREP_ATOMIC_STORE( &entry->hash_table_mask, 2 * old_size - 1, SCOREP_ATOMIC_RELEASE );
+}
+
+
+void
+scorep_definitions_manager_entry_free_hash_table( scorep_definitions_manager_entry* entry )
+{
+    free( entry->hash_table );
+    entry->hash_table          = 0;
+    entry->hash_table_mask     = 0;
+    entry->old_hash_table      = 0;
+    entry->old_hash_table_mask = 0;
+    entry->moved_buckets       = 0;
+    while ( entry->retired_hash_tables )
+    {
+        struct scorep_definitions_retired_hash_table* retired = entry->retired_hash_tables;
+        entry->retired_hash_tables = retired->next;
+        free( retired->hash_table );
+        free( retired );
+    }
+}
+
 #define SCOREP_DEFINITIONS_DEFAULT_HASH_TABLE_POWER ( 8 )
 
 /**
@@ -229,33 +358,33 @@ SCOREP_Definitions_InitializeDefinitionManager( SCOREP_DefinitionManager**    de
 static void
 finalize_definition_manager( SCOREP_DefinitionManager* definitionManager )
 {
-    free( definitionManager->string.hash_table );
-    free( definitionManager->system_tree_node.hash_table );
-    free( definitionManager->system_tree_node_property.hash_table );
-    free( definitionManager->source_file.hash_table );
-    free( definitionManager->region.hash_table );
-    free( definitionManager->group.hash_table );
-    free( definitionManager->interim_communicator.hash_table );
-    free( definitionManager->communicator.hash_table );
-    free( definitionManager->rma_window.hash_table );
-    free( definitionManager->cartesian_topology.hash_table );
-    free( definitionManager->cartesian_coords.hash_table );
-    free( definitionManager->metric.hash_table );
-    free( definitionManager->sampling_set.hash_table );
-    free( definitionManager->sampling_set_recorder.hash_table );
-    free( definitionManager->io_handle.hash_table );
-    free( definitionManager->io_file.hash_table );
-    free( definitionManager->io_file_property.hash_table );
-    free( definitionManager->marker_group.hash_table );
-    free( definitionManager->marker.hash_table );
-    free( definitionManager->parameter.hash_table );
-    free( definitionManager->callpath.hash_table );
-    free( definitionManager->property.hash_table );
-    free( definitionManager->attribute.hash_table );
-    free( definitionManager->location_property.hash_table );
-    free( definitionManager->source_code_location.hash_table );
-    free( definitionManager->calling_context.hash_table );
-    free( definitionManager->interrupt_generator.hash_table );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->string );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->system_tree_node );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->system_tree_node_property );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->source_file );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->region );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->group );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->interim_communicator );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->communicator );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->rma_window );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->cartesian_topology );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->cartesian_coords );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->metric );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->sampling_set );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->sampling_set_recorder );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->io_handle );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->io_file );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->io_file_property );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->marker_group );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->marker );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->parameter );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->callpath );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->property );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->attribute );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->location_property );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->source_code_location );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->calling_context );
+    scorep_definitions_manager_entry_free_hash_table( &definitionManager->interrupt_generator );
 }
 
 void
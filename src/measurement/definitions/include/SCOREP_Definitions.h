@@ -142,12 +142,19 @@ struct SCOREP_Allocator_PageManager;
  */
 typedef struct scorep_definitions_manager_entry
 {
-    SCOREP_AnyHandle  head;
-    SCOREP_AnyHandle* tail;
-    SCOREP_AnyHandle* hash_table;
-    uint32_t          hash_table_mask;
-    uint32_t          counter;
-    uint32_t*         mapping;
+    SCOREP_AnyHandle                              head;
+    SCOREP_AnyHandle*                             tail;
+    SCOREP_AnyHandle*                             hash_table;
+    uint32_t                                      hash_table_mask;
+    uint32_t                                      counter;
+    uint32_t*                                     mapping;
+    /** The table replaced by hash_table, while its definitions are moved */
+    SCOREP_AnyHandle*                             old_hash_table;
+    uint32_t                                      old_hash_table_mask;
+    /** Number of buckets of old_hash_table already moved to hash_table */
+    uint32_t                                      moved_buckets;
+    /** Hash tables replaced by a bigger one, freed with the current one */
+    struct scorep_definitions_retired_hash_table* retired_hash_tables;
 } scorep_definitions_manager_entry;
 
 
@@ -160,12 +167,16 @@ typedef struct scorep_definitions_manager_entry
 static inline void
 scorep_definitions_manager_init_entry( scorep_definitions_manager_entry* entry )
 {
-    entry->head            = SCOREP_MOVABLE_NULL;
-    entry->tail            = &entry->head;
-    entry->hash_table      = 0;
-    entry->hash_table_mask = 0;
-    entry->counter         = 0;
-    entry->mapping         = 0;
+    entry->head                = SCOREP_MOVABLE_NULL;
+    entry->tail                = &entry->head;
+    entry->hash_table          = 0;
+    entry->hash_table_mask     = 0;
+    entry->counter             = 0;
+    entry->mapping             = 0;
+    entry->old_hash_table      = 0;
+    entry->old_hash_table_mask = 0;
+    entry->moved_buckets       = 0;
+    entry->retired_hash_tables = 0;
 }
 
 
@@ -179,6 +190,41 @@ scorep_definitions_manager_entry_alloc_hash_table( scorep_definitions_manager_en
                                                    uint32_t                          hashTablePower );
 
 
+/**
+ * Doubles the size of the hash_table of @a entry. @a pageManager is the page
+ * manager of the definitions.
+ *
+ * The definitions are not rehashed at once. The replaced table becomes the
+ * old_hash_table of @a entry, and each added definition moves a few of its
+ * buckets with @a scorep_definitions_manager_entry_move_buckets. Lookups need
+ * to search both tables until all buckets are moved.
+ *
+ * The replaced table stays valid until the hash table is freed, so that
+ * lookups without the definitions lock are safe. Needs to be called with the
+ * definitions lock held.
+ */
+void
+scorep_definitions_manager_entry_grow_hash_table( scorep_definitions_manager_entry*    entry,
+                                                  struct SCOREP_Allocator_PageManager* pageManager );
+
+
+/**
+ * Moves the definitions of the next few buckets of the old_hash_table of
+ * @a entry into its hash_table. Drops the old_hash_table, when all buckets
+ * are moved. Needs to be called with the definitions lock held.
+ */
+void
+scorep_definitions_manager_entry_move_buckets( scorep_definitions_manager_entry*    entry,
+                                               struct SCOREP_Allocator_PageManager* pageManager );
+
+
+/**
+ * Frees the hash_table of @a entry, including all tables it replaced.
+ */
+void
+scorep_definitions_manager_entry_free_hash_table( scorep_definitions_manager_entry* entry );
+
+
 /**
  * Iterator functions for definition. The iterator variable is named
  * @definition.
@@ -75,4 +75,17 @@ scorep_definitions_new_string( SCOREP_DefinitionManager*         definition_mana
                                scorep_string_definition_modifier modifier );
 
 
+/**
+ * Looks up the string @a str, modified by @a modifier if not NULL, in
+ * @a definition_manager without holding the definitions lock.
+ *
+ * @return The handle of the string or SCOREP_INVALID_STRING, if it is not
+ *         defined yet or was added concurrently.
+ */
+SCOREP_StringHandle
+scorep_definitions_find_string( SCOREP_DefinitionManager*         definition_manager,
+                                const char*                       str,
+                                scorep_string_definition_modifier modifier );
+
+
 #endif /* SCOREP_PRIVATE_DEFINITIONS_STRING_H */
@@ -38,6 +38,7 @@
 
 
 #include <jenkins_hash.h>
+#include <SCOREP_Atomic.h>
 
 
 #define SCOREP_MEMORY_DEREF_LOCAL( localMemory, targetType ) \
@@ -154,7 +155,13 @@
  * If its found, discard the definition allocation done for @a new_allocation.
  *
  * If not, chain @a new_definition into the hash table and the definition
- * manager definitions list and assign the sequence number.
+ * manager definitions list and assign the sequence number. The definition is
+ * published to the hash table only after it is complete, so that
+ * @a SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION can be used without
+ * holding the definitions lock. The hash table grows when it holds more than
+ * twice as many definitions as buckets. While the definitions of the replaced
+ * table are moved, a few buckets per added definition, both tables are
+ * searched.
  *
  * @return Let return the calling function with the found definition's handle
  *         or the new definition as return value.
@@ -171,34 +178,145 @@
                                                          new_handle ) \
     do \
     { \
+        SCOREP_AnyHandle* hash_table_bucket = NULL; \
         if ( ( entry )->hash_table ) \
         { \
-            SCOREP_AnyHandle* hash_table_bucket = \
+            hash_table_bucket = \
                 &( entry )->hash_table[ \
                     new_definition->hash_value & ( entry )->hash_table_mask ]; \
-            SCOREP_AnyHandle hash_list_iterator = *hash_table_bucket; \
+            SCOREP_AnyHandle* search_bucket = hash_table_bucket; \
+            while ( search_bucket ) \
+            { \
+                SCOREP_AnyHandle hash_list_iterator = *search_bucket; \
+                while ( hash_list_iterator != SCOREP_MOVABLE_NULL ) \
+                { \
+                    SCOREP_ ## Type ## Def * existing_definition = \
+                        SCOREP_Allocator_GetAddressFromMovableMemory( \
+                            page_manager, \
+                            hash_list_iterator ); \
+                    if ( existing_definition->hash_value == new_definition->hash_value \
+                         && equal_ ## type( existing_definition, new_definition ) ) \
+                    { \
+                        SCOREP_Allocator_RollbackAllocMovable( \
+                            page_manager, \
+                            new_handle ); \
+                        return hash_list_iterator; \
+                    } \
+                    hash_list_iterator = existing_definition->hash_next; \
+                } \
+                /* Definitions not yet moved are still in the replaced table */ \
+                search_bucket = \
+                    search_bucket == hash_table_bucket && ( entry )->old_hash_table \
+                    ? &( entry )->old_hash_table[ \
+                        new_definition->hash_value & ( entry )->old_hash_table_mask ] \
+                    : NULL; \
+            } \
+        } \
+        *( entry )->tail = new_handle; \
+        ( entry )->tail  = &new_definition->next; \
+        new_definition->sequence_number = ( entry )->counter++; \
+        if ( hash_table_bucket ) \
+        { \
+            new_definition->hash_next = *hash_table_bucket; \
+            SCOREP_ATOMIC_STORE( hash_table_bucket, new_handle, SCOREP_ATOMIC_RELEASE ); \
+            if ( ( entry )->old_hash_table ) \
+            { \
+                scorep_definitions_manager_entry_move_buckets( entry, page_manager ); \
+            } \
+            if ( ( entry )->counter > 2 * ( ( entry )->hash_table_mask + 1 ) ) \
+            { \
+                scorep_definitions_manager_entry_grow_hash_table( entry, page_manager ); \
+            } \
+        } \
+    } \
+    while ( 0 )
+/* *INDENT-ON* */
+
+
+/**
+ * Search the hash table @a table_member of @a entry, with the mask
+ * @a mask_member, for a definition of type @a Type equal to
+ * @a new_definition, without holding the definitions lock. Helper for
+ * @a SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION.
+ *
+ * @note This returns the calling function, if the definition was found!
+ */
+/* *INDENT-OFF* */
+#define SCOREP_DEFINITIONS_FIND_IN_HASH_TABLE( table_member, \
+                                               mask_member, \
+                                               entry, \
+                                               Type, \
+                                               type, \
+                                               page_manager, \
+                                               new_definition ) \
+    do \
+    { \
+        /* The mask is valid for the table, if it is read first */ \
+        uint32_t hash_table_mask = \
+            SCOREP_ATOMIC_LOAD( &( entry )->mask_member, SCOREP_ATOMIC_ACQUIRE ); \
+        SCOREP_AnyHandle* hash_table = \
+            SCOREP_ATOMIC_LOAD( &( entry )->table_member, SCOREP_ATOMIC_ACQUIRE ); \
+        if ( hash_table ) \
+        { \
+            SCOREP_AnyHandle hash_list_iterator = SCOREP_ATOMIC_LOAD( \
+                &hash_table[ ( new_definition )->hash_value & hash_table_mask ], \
+                SCOREP_ATOMIC_ACQUIRE ); \
             while ( hash_list_iterator != SCOREP_MOVABLE_NULL ) \
             { \
                 SCOREP_ ## Type ## Def * existing_definition = \
                     SCOREP_Allocator_GetAddressFromMovableMemory( \
                         page_manager, \
                         hash_list_iterator ); \
-                if ( existing_definition->hash_value == new_definition->hash_value \
+                if ( existing_definition->hash_value == ( new_definition )->hash_value \
                      && equal_ ## type( existing_definition, new_definition ) ) \
                 { \
-                    SCOREP_Allocator_RollbackAllocMovable( \
-                        page_manager, \
-                        new_handle ); \
                     return hash_list_iterator; \
                 } \
-                hash_list_iterator = existing_definition->hash_next; \
+                hash_list_iterator = SCOREP_ATOMIC_LOAD( \
+                    &existing_definition->hash_next, SCOREP_ATOMIC_ACQUIRE ); \
             } \
-            new_definition->hash_next = *hash_table_bucket; \
-            *hash_table_bucket        = new_handle; \
         } \
-        *( entry )->tail = new_handle; \
-        ( entry )->tail  = &new_definition->next; \
-        new_definition->sequence_number = ( entry )->counter++; \
+    } \
+    while ( 0 )
+/* *INDENT-ON* */
+
+
+/**
+ * Search for a definition of type @a Type equal to @a new_definition in the
+ * hash table of @a entry, without holding the definitions lock.
+ * @a new_definition only needs the members compared by @a equal_type and the
+ * hash value. It may thus live on the stack.
+ *
+ * A definition added concurrently, or moved while the hash table grows, may
+ * not be found. Thus, if this does not return, the definition needs to be
+ * added with the lock held as usual.
+ *
+ * @return Let return the calling function with the found definition's handle.
+ *
+ * @note This returns the calling function, if the definition was found!
+ */
+/* *INDENT-OFF* */
+#define SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION( entry, \
+                                                          Type, \
+                                                          type, \
+                                                          page_manager, \
+                                                          new_definition ) \
+    do \
+    { \
+        SCOREP_DEFINITIONS_FIND_IN_HASH_TABLE( hash_table, \
+                                               hash_table_mask, \
+                                               entry, \
+                                               Type, \
+                                               type, \
+                                               page_manager, \
+                                               new_definition ); \
+        SCOREP_DEFINITIONS_FIND_IN_HASH_TABLE( old_hash_table, \
+                                               old_hash_table_mask, \
+                                               entry, \
+                                               Type, \
+                                               type, \
+                                               page_manager, \
+                                               new_definition ); \
     } \
     while ( 0 )
 /* *INDENT-ON* */
@@ -64,19 +64,63 @@ equal_source_code_location( const SCOREP_SourceCodeLocationDef* existingDefiniti
                             const SCOREP_SourceCodeLocationDef* newDefinition );
 
 
+static SCOREP_SourceCodeLocationHandle
+find_source_code_location( SCOREP_DefinitionManager* definition_manager,
+                           const char*               file,
+                           SCOREP_LineNo             lineNumber )
+{
+    SCOREP_StringHandle file_handle = scorep_definitions_find_string( definition_manager,
+                                                                      file,
+                                                                      UTILS_IO_SimplifyPath );
+    if ( file_handle == SCOREP_INVALID_STRING )
+    {
+        return SCOREP_INVALID_SOURCE_CODE_LOCATION;
+    }
+
+    SCOREP_SourceCodeLocationDef key;
+    key.hash_value = 0;
+    initialize_source_code_location( &key,
+                                     definition_manager,
+                                     file_handle,
+                                     lineNumber );
+
+    /* Does return if found */
+    SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION( &definition_manager->source_code_location,
+                                                      SourceCodeLocation,
+                                                      source_code_location,
+                                                      definition_manager->page_manager,
+                                                      &key );
+
+    return SCOREP_INVALID_SOURCE_CODE_LOCATION;
+}
+
+
 SCOREP_SourceCodeLocationHandle
 SCOREP_Definitions_NewSourceCodeLocation( const char*   file,
                                           SCOREP_LineNo lineNumber )
 {
     UTILS_DEBUG_ENTRY( "%s:%d", file, lineNumber );
 
+    if ( !file )
+    {
+        file = "";
+    }
+
+    /* Most locations are defined more than once, try without the lock first */
+    SCOREP_SourceCodeLocationHandle new_handle =
+        find_source_code_location( &scorep_local_definition_manager, file, lineNumber );
+    if ( new_handle != SCOREP_INVALID_SOURCE_CODE_LOCATION )
+    {
+        return new_handle;
+    }
+
     SCOREP_Definitions_Lock();
 
-    SCOREP_SourceCodeLocationHandle new_handle = define_source_code_location(
+    new_handle = define_source_code_location(
         &scorep_local_definition_manager,
         scorep_definitions_new_string(
             &scorep_local_definition_manager,
-            file ? file : "",
+            file,
             UTILS_IO_SimplifyPath ),
         lineNumber );
 
@@ -79,6 +79,31 @@ equal_source_file( const SCOREP_SourceFileDef* existingDefinition,
                    const SCOREP_SourceFileDef* newDefinition );
 
 
+static SCOREP_SourceFileHandle
+find_source_file( SCOREP_DefinitionManager* definition_manager,
+                  const char*               fileName )
+{
+    SCOREP_SourceFileDef key;
+    key.name_handle = scorep_definitions_find_string( definition_manager,
+                                                      fileName,
+                                                      UTILS_IO_SimplifyPath );
+    if ( key.name_handle == SCOREP_INVALID_STRING )
+    {
+        return SCOREP_INVALID_SOURCE_FILE;
+    }
+    key.hash_value = SCOREP_GET_HASH_OF_LOCAL_HANDLE( key.name_handle, String );
+
+    /* Does return if found */
+    SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION( &definition_manager->source_file,
+                                                      SourceFile,
+                                                      source_file,
+                                                      definition_manager->page_manager,
+                                                      &key );
+
+    return SCOREP_INVALID_SOURCE_FILE;
+}
+
+
 /**
  * Associate a file name with a process unique file handle.
  */
@@ -87,13 +112,26 @@ SCOREP_Definitions_NewSourceFile( const char* fileName )
 {
     UTILS_DEBUG_ENTRY( "%s", fileName );
 
+    if ( !fileName )
+    {
+        fileName = "<unknown source file>";
+    }
+
+    /* Adapters define the file of each region, try without the lock first */
+    SCOREP_SourceFileHandle new_handle = find_source_file( &scorep_local_definition_manager,
+                                                           fileName );
+    if ( new_handle != SCOREP_INVALID_SOURCE_FILE )
+    {
+        return new_handle;
+    }
+
     SCOREP_Definitions_Lock();
 
-    SCOREP_SourceFileHandle new_handle = define_source_file(
+    new_handle = define_source_file(
         &scorep_local_definition_manager,
         scorep_definitions_new_string(
             &scorep_local_definition_manager,
-            fileName ? fileName : "<unknown source file>",
+            fileName,
             UTILS_IO_SimplifyPath ) );
 
     SCOREP_Definitions_Unlock();
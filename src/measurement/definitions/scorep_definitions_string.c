@@ -66,11 +66,86 @@
 #include <scorep_type_utils.h>
 
 
+/* The members of a string definition needed for a lookup */
+typedef struct
+{
+    uint32_t    hash_value;
+    uint32_t    string_length;
+    const char* string_data;
+} string_key;
+
+
+static bool
+equal_string_key( const SCOREP_StringDef* existingDefinition,
+                  const string_key*       key )
+{
+    return existingDefinition->string_length == key->string_length
+           && 0 == memcmp( existingDefinition->string_data,
+                           key->string_data,
+                           existingDefinition->string_length );
+}
+
+
+static SCOREP_StringHandle
+find_string_key( SCOREP_DefinitionManager* definition_manager,
+                 const string_key*         key )
+{
+    /* Does return if found */
+    SCOREP_DEFINITIONS_MANAGER_ENTRY_FIND_DEFINITION( &definition_manager->string,
+                                                      String,
+                                                      string_key,
+                                                      definition_manager->page_manager,
+                                                      key );
+
+    return SCOREP_INVALID_STRING;
+}
+
+
+SCOREP_StringHandle
+scorep_definitions_find_string( SCOREP_DefinitionManager*         definition_manager,
+                                const char*                       str,
+                                scorep_string_definition_modifier modifier )
+{
+    string_key key;
+    key.string_length = strlen( str );
+    key.string_data   = str;
+    if ( !modifier )
+    {
+        key.hash_value = jenkins_hash( str, key.string_length, 0 );
+        return find_string_key( definition_manager, &key );
+    }
+
+    char* modified_string = malloc( key.string_length + 1 );
+    if ( !modified_string )
+    {
+        return SCOREP_INVALID_STRING;
+    }
+    memcpy( modified_string, str, key.string_length + 1 );
+    modifier( modified_string );
+
+    /* Same hash as scorep_definitions_new_string */
+    key.string_length = strlen( modified_string );
+    key.string_data   = modified_string;
+    key.hash_value    = jenkins_hash( str, key.string_length, 0 );
+
+    SCOREP_StringHandle handle = find_string_key( definition_manager, &key );
+    free( modified_string );
+    return handle;
+}
+
+
 SCOREP_StringHandle
 SCOREP_Definitions_NewString( const char* str )
 {
     UTILS_DEBUG_ENTRY( "%s", str );
 
+    /* Most strings are defined more than once, try without the lock first */
+    SCOREP_StringHandle handle = scorep_definitions_find_string( &scorep_local_definition_manager, str, NULL );
+    if ( handle != SCOREP_INVALID_STRING )
+    {
+        return handle;
+    }
+
     SCOREP_Definitions_Lock();
 
     SCOREP_StringHandle new_handle = scorep_definitions_new_string(
@@ -117,6 +117,25 @@ void
 SCOREP_Sample( SCOREP_InterruptGeneratorHandle interruptGeneratorHandle,
                void*                           contextPtr );
 
+/**
+ * Process a sample event in the measurement system which was not taken in
+ * the signal context but recorded together with its callchain, e.g., by the
+ * kernel. Must be called before the next enter or exit event of @a location.
+ *
+ * @param location                 Location which was sampled
+ * @param timestamp                Time of the sample
+ * @param interruptGeneratorHandle Source generating the interrupt of this sample
+ * @param callchain                The sampled instruction address followed
+ *                                 by the return addresses of its callers
+ * @param callchainDepth           Number of elements in @a callchain
+ */
+void
+SCOREP_Location_SampleCallchain( SCOREP_Location*                location,
+                                 uint64_t                        timestamp,
+                                 SCOREP_InterruptGeneratorHandle interruptGeneratorHandle,
+                                 const uint64_t*                 callchain,
+                                 uint32_t                        callchainDepth );
+
 /**
  * Trigger a sample with an invalid current calling context,
  *
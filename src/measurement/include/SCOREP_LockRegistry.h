@@ -0,0 +1,123 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCOREP_LOCK_REGISTRY_H
+#define SCOREP_LOCK_REGISTRY_H
+
+/**
+ * @file
+ *
+ * Maps the addresses of application lock objects (OpenMP locks, Pthread
+ * mutexes, named critical regions) to the Score-P representation of the lock,
+ * which carries the lock id and the acquisition order used in the
+ * AcquireLock/ReleaseLock events.
+ *
+ * The registry is an open-addressing hash table which grows with the number
+ * of registered locks. SCOREP_LockRegistry_Get() does not take a lock in
+ * the common case, registering and removing locks is serialized by a mutex.
+ * The objects returned by the registry stay valid until they are removed, the
+ * members besides @a key are only modified by the thread holding the
+ * application lock.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef struct SCOREP_LockRegistry SCOREP_LockRegistry;
+
+
+/**
+ * The Score-P representation of an application lock. Adapters which need
+ * additional per-lock data embed this as the first member of their own
+ * structure and pass its size to SCOREP_LockRegistry_New().
+ */
+typedef struct SCOREP_Lock SCOREP_Lock;
+struct SCOREP_Lock
+{
+    /** Address of the application lock object, used as key. */
+    const void*  key;
+    /** Used by the registry to link removed objects. */
+    SCOREP_Lock* next;
+    /** Lock id in the AcquireLock/ReleaseLock events, [0, N[ per registry. */
+    uint32_t     id;
+    uint32_t     acquisition_order;
+    uint32_t     nesting_level;
+};
+
+
+/**
+ * Creates a new registry.
+ *
+ * @param lockSize  Size of the objects managed by this registry, at least
+ *                  sizeof( SCOREP_Lock ).
+ */
+SCOREP_LockRegistry*
+SCOREP_LockRegistry_New( size_t lockSize );
+
+
+/**
+ * Releases the registry and its tables. Must not be called while other
+ * threads still access the registry.
+ */
+void
+SCOREP_LockRegistry_Delete( SCOREP_LockRegistry* registry );
+
+
+/**
+ * Returns the object registered for @a key, or NULL.
+ */
+SCOREP_Lock*
+SCOREP_LockRegistry_Get( SCOREP_LockRegistry* registry,
+                         const void*          key );
+
+
+/**
+ * Returns the object registered for @a key. A new object with a new id and
+ * all other members zeroed is registered if there is none yet.
+ */
+SCOREP_Lock*
+SCOREP_LockRegistry_Insert( SCOREP_LockRegistry* registry,
+                            const void*          key );
+
+
+/**
+ * Removes the object registered for @a key. Its memory is reused for locks
+ * registered later.
+ *
+ * @return false if there was no object for @a key.
+ */
+bool
+SCOREP_LockRegistry_Remove( SCOREP_LockRegistry* registry,
+                            const void*          key );
+
+
+/**
+ * Returns the current timestamp if SCOREP_LOCK_WAIT_TIME is enabled, and 0
+ * otherwise. To be called right before the application's locking call.
+ */
+uint64_t
+SCOREP_Lock_BeginWait( void );
+
+
+/**
+ * Triggers the 'lock wait time' metric with the time since @a beginWait, if
+ * this is not 0. To be called after the lock was acquired and the acquire lock
+ * event was recorded.
+ */
+void
+SCOREP_Lock_EndWait( uint64_t beginWait );
+
+
+#endif /* SCOREP_LOCK_REGISTRY_H */
@@ -79,10 +79,12 @@ typedef enum SCOREP_MemoryType
  * @param totalMemory total amount of memory in bytes the measurement system
  * should use.
  * @param pageSize size of a single page in bytes, needs to be <= @a totalMemory
+ * @param hugePages back the memory with transparent huge pages, if possible.
  */
 void
 SCOREP_Memory_Initialize( uint64_t totalMemory,
-                          uint64_t pageSize );
+                          uint64_t pageSize,
+                          bool     hugePages );
 
 
 /**
@@ -13,6 +13,16 @@
 /**
  * @file
  * @brief
+ *
+ * Active I/O handles are found by their paradigm specific value in a hash
+ * table per paradigm, which is protected by the paradigm mutex. Paradigms
+ * which work on file descriptors of the operating system (i.e., POSIX I/O)
+ * use a table indexed by the file descriptor instead, which is read without
+ * taking the mutex. Modifications are still serialized by the mutex. When a
+ * file descriptor does not fit into the table, a larger copy is published
+ * with a release store and the old table is kept until the paradigm is
+ * de-registered. A reader which still uses the old table may miss only
+ * modifications which do not happen before its lookup.
  */
 
 #include <config.h>
@@ -22,6 +32,7 @@
 #include <string.h>
 
 #include <scorep_environment.h>
+#include <SCOREP_Atomic.h>
 #include <SCOREP_Definitions.h>
 #include <SCOREP_Hashtab.h>
 #include <SCOREP_IoManagement.h>
@@ -41,6 +52,8 @@
 #define SCOREP_IO_HANDLE_HASHTABLE_MASK hashmask( SCOREP_IO_HANDLE_HASHTABLE_POWER )
 #define SCOREP_IO_HANDLE_HASHTABLE_SIZE hashsize( SCOREP_IO_HANDLE_HASHTABLE_POWER )
 
+#define SCOREP_IO_FD_TABLE_INITIAL_SIZE 256
+
 static SCOREP_Hashtab* io_file_handle_hashtable = NULL;
 
 /** @brief Payload in every IoHandleHandle definition. */
@@ -65,6 +78,17 @@ typedef struct io_handle_stack_entry
     uint32_t recursive_creation_counter;
 } io_handle_stack_entry;
 
+/** @brief Active I/O handles indexed by file descriptor. */
+typedef struct io_fd_table io_fd_table;
+struct io_fd_table
+{
+    /** @brief Next replaced table */
+    io_fd_table*          retired_next;
+    /** @brief Number of entries in @a handles */
+    uint32_t              size;
+    SCOREP_IoHandleHandle handles[];
+};
+
 /** @brief context for one registered I/O paradigm. */
 typedef struct io_mgmt_paradigm
 {
@@ -75,6 +99,12 @@ typedef struct io_mgmt_paradigm
     size_t                payload_size;
     /** @brief Hash table of all active I/O handles. */
     SCOREP_IoHandleHandle handles[ SCOREP_IO_HANDLE_HASHTABLE_SIZE ];
+    /** @brief Active I/O handles indexed by file descriptor, replaces
+        @a handles for paradigms with the SCOREP_IO_PARADIGM_FLAG_OS flag.
+        May be read without holding @a mutex. */
+    io_fd_table*          fd_table;
+    /** @brief Replaced fd tables, released when the paradigm is de-registered. */
+    io_fd_table*          retired_fd_tables;
     /** @brief mutex to protect @a handles table for this I/O paradigm */
     SCOREP_Mutex          mutex;
 } io_mgmt_paradigm;
@@ -154,6 +184,75 @@ payload_get_handle( io_handle_payload* payload )
     return payload + 1;
 }
 
+static io_fd_table*
+fd_table_new( uint32_t size )
+{
+    io_fd_table* table = calloc( 1, sizeof( *table ) + size * sizeof( SCOREP_IoHandleHandle ) );
+    UTILS_BUG_ON( table == NULL, "Failed to allocate I/O handle table." );
+    /* SCOREP_INVALID_IO_HANDLE is 0 */
+    table->size = size;
+    return table;
+}
+
+/** @brief Returns the handle of file descriptor @a ioHandle, without
+    taking the paradigm mutex. */
+static inline SCOREP_IoHandleHandle
+fd_table_get( io_mgmt_paradigm* paradigm,
+              const void*       ioHandle )
+{
+    int          fd    = *( const int* )ioHandle;
+    io_fd_table* table = SCOREP_ATOMIC_LOAD( &paradigm->fd_table, SCOREP_ATOMIC_ACQUIRE );
+    if ( fd < 0 || ( uint32_t )fd >= table->size )
+    {
+        return SCOREP_INVALID_IO_HANDLE;
+    }
+    /* Pairs with the release store in fd_table_set, the payload of the
+       handle is complete when it is found. */
+    return SCOREP_ATOMIC_LOAD( &table->handles[ fd ], SCOREP_ATOMIC_ACQUIRE );
+}
+
+/** @brief Sets the handle of file descriptor @a ioHandle and returns the
+    previous one. Negative descriptors, e.g., of memory streams, have no
+    slot. Call with paradigm mutex locked. */
+static SCOREP_IoHandleHandle
+fd_table_set( io_mgmt_paradigm*     paradigm,
+              const void*           ioHandle,
+              SCOREP_IoHandleHandle handle )
+{
+    int          fd    = *( const int* )ioHandle;
+    io_fd_table* table = paradigm->fd_table;
+    if ( fd < 0 )
+    {
+        return SCOREP_INVALID_IO_HANDLE;
+    }
+
+    if ( ( uint32_t )fd >= table->size )
+    {
+        if ( handle == SCOREP_INVALID_IO_HANDLE )
+        {
+            return SCOREP_INVALID_IO_HANDLE;
+        }
+
+        uint32_t size = table->size;
+        while ( ( uint32_t )fd >= size )
+        {
+            size *= 2;
+        }
+        io_fd_table* new_table = fd_table_new( size );
+        memcpy( new_table->handles, table->handles,
+                table->size * sizeof( SCOREP_IoHandleHandle ) );
+        SCOREP_ATOMIC_STORE( &paradigm->fd_table, new_table, SCOREP_ATOMIC_RELEASE );
+
+        table->retired_next         = paradigm->retired_fd_tables;
+        paradigm->retired_fd_tables = table;
+        table                       = new_table;
+    }
+
+    SCOREP_IoHandleHandle old_handle = table->handles[ fd ];
+    SCOREP_ATOMIC_STORE( &table->handles[ fd ], handle, SCOREP_ATOMIC_RELEASE );
+    return old_handle;
+}
+
 static inline SCOREP_IoHandleHandle*
 get_handle_ref( SCOREP_IoParadigmType paradigm,
                 const void*           ioHandle,
@@ -192,6 +291,17 @@ insert_handle( SCOREP_IoParadigmType paradigm,
                const void*           ioHandle,
                uint32_t              hash )
 {
+    if ( io_paradigms[ paradigm ]->fd_table )
+    {
+        if ( fd_table_set( io_paradigms[ paradigm ], ioHandle, handle ) != SCOREP_INVALID_IO_HANDLE
+             && SCOREP_Env_RunVerbose() )
+        {
+            fprintf( stderr, "[Score-P] warning: duplicate %s handle, previous handle not destroyed",
+                     io_paradigms[ paradigm ]->definition->name );
+        }
+        return;
+    }
+
     io_handle_payload*     entry;
     SCOREP_IoHandleHandle* handle_iterator = get_handle_ref( paradigm, ioHandle, hash, &entry );
     if ( *handle_iterator != SCOREP_INVALID_IO_HANDLE )
@@ -265,6 +375,13 @@ SCOREP_IoMgmt_RegisterParadigm( SCOREP_IoParadigmType     paradigm,
 
     io_paradigms[ paradigm ]->payload_size = payloadSize;
 
+    if ( paradigmFlags & SCOREP_IO_PARADIGM_FLAG_OS )
+    {
+        UTILS_BUG_ON( payloadSize != sizeof( int ),
+                      "I/O handles of operating system paradigms must be file descriptors" );
+        io_paradigms[ paradigm ]->fd_table = fd_table_new( SCOREP_IO_FD_TABLE_INITIAL_SIZE );
+    }
+
     SCOREP_MutexCreate( &io_paradigms[ paradigm ]->mutex );
 }
 
@@ -278,6 +395,14 @@ SCOREP_IoMgmt_DeregisterParadigm( SCOREP_IoParadigmType paradigm )
 
     SCOREP_MutexDestroy( &io_paradigms[ paradigm ]->mutex );
 
+    while ( io_paradigms[ paradigm ]->retired_fd_tables )
+    {
+        io_fd_table* table = io_paradigms[ paradigm ]->retired_fd_tables;
+        io_paradigms[ paradigm ]->retired_fd_tables = table->retired_next;
+        free( table );
+    }
+    free( io_paradigms[ paradigm ]->fd_table );
+
     free( io_paradigms[ paradigm ] );
 
     io_paradigms[ paradigm ] = NULL;
@@ -342,9 +467,16 @@ SCOREP_IoMgmt_CreatePreCreatedHandle( SCOREP_IoParadigmType            paradigm,
 
     SCOREP_MutexLock( io_paradigms[ paradigm ]->mutex );
 
-    /* do we need to check for duplicates? */
-    payload->next                              = io_paradigms[ paradigm ]->handles[ index ];
-    io_paradigms[ paradigm ]->handles[ index ] = handle;
+    if ( io_paradigms[ paradigm ]->fd_table )
+    {
+        fd_table_set( io_paradigms[ paradigm ], ioHandle, handle );
+    }
+    else
+    {
+        /* do we need to check for duplicates? */
+        payload->next                              = io_paradigms[ paradigm ]->handles[ index ];
+        io_paradigms[ paradigm ]->handles[ index ] = handle;
+    }
 
     SCOREP_MutexUnlock( io_paradigms[ paradigm ]->mutex );
 }
@@ -430,14 +562,15 @@ SCOREP_IoMgmt_CompleteHandleCreation( SCOREP_IoParadigmType paradigm,
     entry->hash = jenkins_hash( ioHandle, io_paradigms[ paradigm ]->payload_size, 0 );
     memcpy( payload_get_handle( entry ), ioHandle, io_paradigms[ paradigm ]->payload_size );
 
+    /* Complete the handle before other threads can find it. */
+    SCOREP_IoHandleHandle_SetIoFile( handle, file );
+
     SCOREP_MutexLock( io_paradigms[ paradigm ]->mutex );
 
     insert_handle( paradigm, handle, payload_get_handle( entry ), entry->hash );
 
     SCOREP_MutexUnlock( io_paradigms[ paradigm ]->mutex );
 
-    SCOREP_IoHandleHandle_SetIoFile( handle, file );
-
     SCOREP_CALL_SUBSTRATE_MGMT( IoParadigmLeave, IO_PARADIGM_LEAVE,
                                 ( SCOREP_Location_GetCurrentCPULocation(), paradigm ) );
 
@@ -521,14 +654,15 @@ SCOREP_IoMgmt_CompleteHandleDuplication( SCOREP_IoParadigmType paradigm,
     entry->hash = jenkins_hash( ioHandle, io_paradigms[ paradigm ]->payload_size, 0 );
     memcpy( payload_get_handle( entry ), ioHandle, io_paradigms[ paradigm ]->payload_size );
 
+    /* Complete the handle before other threads can find it. */
+    SCOREP_IoHandleHandle_SetIoFile( handle, file );
+
     SCOREP_MutexLock( io_paradigms[ paradigm ]->mutex );
 
     insert_handle( paradigm, handle, payload_get_handle( entry ), entry->hash );
 
     SCOREP_MutexUnlock( io_paradigms[ paradigm ]->mutex );
 
-    SCOREP_IoHandleHandle_SetIoFile( handle, file );
-
     SCOREP_CALL_SUBSTRATE_MGMT( IoParadigmLeave, IO_PARADIGM_LEAVE,
                                 ( SCOREP_Location_GetCurrentCPULocation(), paradigm ) );
 
@@ -563,6 +697,20 @@ SCOREP_IoMgmt_RemoveHandle( SCOREP_IoParadigmType paradigm,
 
     SCOREP_MutexLock( io_paradigms[ paradigm ]->mutex );
 
+    if ( io_paradigms[ paradigm ]->fd_table )
+    {
+        SCOREP_IoHandleHandle old_handle =
+            fd_table_set( io_paradigms[ paradigm ], ioHandle, SCOREP_INVALID_IO_HANDLE );
+
+        SCOREP_MutexUnlock( io_paradigms[ paradigm ]->mutex );
+
+        if ( old_handle == SCOREP_INVALID_IO_HANDLE && *( const int* )ioHandle >= 0 )
+        {
+            UTILS_WARNING( "[Paradigm: %d] Could not find I/O handle in table", paradigm );
+        }
+        return old_handle;
+    }
+
     io_handle_payload*     entry;
     SCOREP_IoHandleHandle* handle_iterator = get_handle_ref( paradigm, ioHandle, 0, &entry );
     if ( *handle_iterator == SCOREP_INVALID_IO_HANDLE )
@@ -663,6 +811,18 @@ SCOREP_IoMgmt_GetIoHandle( SCOREP_IoParadigmType paradigm,
                   "Invalid I/O paradigm %d", paradigm );
     UTILS_BUG_ON( !io_paradigms[ paradigm ], "The given paradigm was not registered" );
 
+    if ( io_paradigms[ paradigm ]->fd_table )
+    {
+        SCOREP_IoHandleHandle handle = fd_table_get( io_paradigms[ paradigm ], ioHandle );
+        if ( handle == SCOREP_INVALID_IO_HANDLE )
+        {
+            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_IO_MANAGEMENT,
+                                "[Paradigm: %d] Could not find I/O handle in table",
+                                paradigm );
+        }
+        return handle;
+    }
+
     SCOREP_MutexLock( io_paradigms[ paradigm ]->mutex );
 
     io_handle_payload*     entry;
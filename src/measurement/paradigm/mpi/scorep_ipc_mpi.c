@@ -299,6 +299,62 @@ SCOREP_IpcGroup_Recv( SCOREP_Ipc_Group*   group,
 }
 
 
+struct SCOREP_Ipc_Request
+{
+    MPI_Request request;
+};
+
+
+int
+SCOREP_IpcGroup_Irecv( SCOREP_Ipc_Group*    group,
+                       void*                buf,
+                       int                  count,
+                       SCOREP_Ipc_Datatype  datatype,
+                       int                  source,
+                       SCOREP_Ipc_Request** request )
+{
+    *request = malloc( sizeof( **request ) );
+    UTILS_ASSERT( *request );
+
+    return PMPI_Irecv( buf,
+                       count,
+                       get_mpi_datatype( datatype ),
+                       source,
+                       0,
+                       resolve_comm( group ),
+                       &( *request )->request ) != MPI_SUCCESS;
+}
+
+
+int
+SCOREP_Ipc_Waitany( int                  count,
+                    SCOREP_Ipc_Request** requests,
+                    int*                 index )
+{
+    MPI_Request* mpi_requests = malloc( count * sizeof( *mpi_requests ) );
+    UTILS_ASSERT( count == 0 || mpi_requests );
+    for ( int i = 0; i < count; i++ )
+    {
+        mpi_requests[ i ] = requests[ i ] ? requests[ i ]->request : MPI_REQUEST_NULL;
+    }
+
+    int ret = PMPI_Waitany( count, mpi_requests, index, MPI_STATUS_IGNORE );
+    free( mpi_requests );
+
+    if ( *index == MPI_UNDEFINED )
+    {
+        *index = -1;
+    }
+    else
+    {
+        free( requests[ *index ] );
+        requests[ *index ] = NULL;
+    }
+
+    return ret != MPI_SUCCESS;
+}
+
+
 int
 SCOREP_IpcGroup_Barrier( SCOREP_Ipc_Group* group )
 {
@@ -42,8 +42,12 @@
 #include <SCOREP_Timer_Utils.h>
 #include <scorep_ipc.h>
 #include <scorep_environment.h>
+#include <SCOREP_Platform.h>
+
+#include <UTILS_Error.h>
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <assert.h>
 
 #define N_PINGPONGS 10
@@ -53,8 +57,14 @@ extern void scorep_interpolate_epoch(uint64_t* epochBegin, uint64_t* epochEnd);
 /* *INDENT-ON*  */
 
 
-static uint64_t
-synchronize_with_worker( int worker, int* min_index )
+/**
+ * Measures the offset of @a worker relative to this process and passes it
+ * on together with this process' own offset and error relative to the root.
+ */
+static void
+synchronize_with_worker( int     worker,
+                         int64_t masterOffset,
+                         double  masterError )
 {
     uint64_t master_send_time[ N_PINGPONGS ];
     uint64_t master_recv_time[ N_PINGPONGS ];
@@ -73,77 +83,245 @@ synchronize_with_worker( int worker, int* min_index )
     }
 
     uint64_t ping_pong_time = UINT64_MAX;
+    int      min_index      = 0;
     for ( int i = 0; i < N_PINGPONGS; ++i )
     {
         uint64_t time_diff = master_recv_time[ i ] - master_send_time[ i ];
         if ( time_diff < ping_pong_time )
         {
             ping_pong_time = time_diff;
-            *min_index     = i;
+            min_index      = i;
         }
     }
 
-    return master_send_time[ *min_index ] + ping_pong_time / 2;
+    /* sync time, index of the fastest ping-pong, its round-trip time, and the
+     * master's offset to the root */
+    uint64_t sync_info[ 4 ];
+    sync_info[ 0 ] = master_send_time[ min_index ] + ping_pong_time / 2;
+    sync_info[ 1 ] = min_index;
+    sync_info[ 2 ] = ping_pong_time;
+    sync_info[ 3 ] = ( uint64_t )masterOffset;
+    SCOREP_Ipc_Send( sync_info, 4, SCOREP_IPC_UINT64_T, worker );
+    SCOREP_Ipc_Send( &masterError, 1, SCOREP_IPC_DOUBLE, worker );
 }
 
 
-void
-SCOREP_SynchronizeClocks( void )
+/**
+ * Counterpart of synchronize_with_worker. The offset to the root is the
+ * offset to @a master plus the master's own offset. The error of a single
+ * measurement is bounded by half of the fastest round-trip time, the bounds
+ * add up along the path to the root.
+ */
+static void
+synchronize_with_master( int       master,
+                         uint64_t* offsetTime,
+                         int64_t*  offset,
+                         double*   error )
 {
-    if ( SCOREP_Timer_ClockIsGlobal() || !SCOREP_Env_DoTracing() )
+    uint64_t worker_time[ N_PINGPONGS ];
+    for ( int i = 0; i < N_PINGPONGS; ++i )
     {
-        SCOREP_AddClockOffset( SCOREP_Timer_GetClockTicks(), 0, 0 );
-        return;
+        /*
+         * Some SHMEM implementations don't support zero-count put/get
+         * operations and/or NULL buffers. That's why we send a dummy
+         * integer value.
+         */
+        int dummy = 0;
+        SCOREP_Ipc_Recv( &dummy, 1, SCOREP_IPC_INT, master );
+        worker_time[ i ] = SCOREP_Timer_GetClockTicks();
+        SCOREP_Ipc_Send( &dummy, 1, SCOREP_IPC_INT, master );
     }
 
+    uint64_t sync_info[ 4 ];
+    double   master_error;
+    SCOREP_Ipc_Recv( sync_info, 4, SCOREP_IPC_UINT64_T, master );
+    SCOREP_Ipc_Recv( &master_error, 1, SCOREP_IPC_DOUBLE, master );
+
+    *offsetTime = worker_time[ sync_info[ 1 ] ];
+    *offset     = ( int64_t )( sync_info[ 0 ] - *offsetTime ) + ( int64_t )sync_info[ 3 ];
+    *error      = master_error + sync_info[ 2 ] / 2.0;
+}
+
+
+static void
+synchronize_linear( uint64_t* offsetTime,
+                    int64_t*  offset,
+                    double*   error )
+{
     int size = SCOREP_Ipc_GetSize();
     int rank = SCOREP_Ipc_GetRank();
 
-    uint64_t offset_time;
-    int64_t  offset;
-
     if ( rank == 0 )
     {
         for ( int worker = 1; worker < size; ++worker )
         {
-            int      min_index;
-            uint64_t sync_time = synchronize_with_worker( worker, &min_index );
-
-            SCOREP_Ipc_Send( &sync_time, 1, SCOREP_IPC_UINT64_T, worker );
-            SCOREP_Ipc_Send( &min_index, 1, SCOREP_IPC_INT, worker );
+            synchronize_with_worker( worker, 0, 0.0 );
         }
 
-        offset_time = SCOREP_Timer_GetClockTicks();
-        offset      = 0;
+        *offsetTime = SCOREP_Timer_GetClockTicks();
+        *offset     = 0;
+        *error      = 0.0;
     }
     else
     {
-        uint64_t worker_time[ N_PINGPONGS ];
-        int      master = 0;
-        for ( int i = 0; i < N_PINGPONGS; ++i )
+        synchronize_with_master( 0, offsetTime, offset, error );
+    }
+}
+
+
+typedef struct
+{
+    int32_t node_id;
+    int     rank;
+} node_rank;
+
+
+static int
+compare_node_rank( const void* a,
+                   const void* b )
+{
+    const node_rank* lhs = a;
+    const node_rank* rhs = b;
+    if ( lhs->node_id != rhs->node_id )
+    {
+        return lhs->node_id < rhs->node_id ? -1 : 1;
+    }
+    return lhs->rank - rhs->rank;
+}
+
+
+static int
+compare_int( const void* a,
+             const void* b )
+{
+    return *( const int* )a - *( const int* )b;
+}
+
+
+/**
+ * Two-level synchronization: the node leaders, i.e., the lowest rank on each
+ * node, synchronize along a binomial tree rooted at rank 0. Afterwards every
+ * leader synchronizes the remaining processes of its node. All pairs of one
+ * tree level and all nodes work concurrently.
+ */
+static void
+synchronize_tree( uint64_t* offsetTime,
+                  int64_t*  offset,
+                  double*   error )
+{
+    int size = SCOREP_Ipc_GetSize();
+    int rank = SCOREP_Ipc_GetRank();
+
+    int32_t  node_id  = SCOREP_Platform_GetNodeId();
+    int32_t* node_ids = malloc( size * sizeof( *node_ids ) );
+    UTILS_ASSERT( node_ids );
+    SCOREP_Ipc_Allgather( &node_id, node_ids, 1, SCOREP_IPC_INT32_T );
+
+    /* Group the ranks by node, the first rank of each group is its leader */
+    node_rank* by_node = malloc( size * sizeof( *by_node ) );
+    UTILS_ASSERT( by_node );
+    for ( int i = 0; i < size; i++ )
+    {
+        by_node[ i ].node_id = node_ids[ i ];
+        by_node[ i ].rank    = i;
+    }
+    free( node_ids );
+    qsort( by_node, size, sizeof( *by_node ), compare_node_rank );
+
+    /* Collect the leaders and the range of this process' node in by_node */
+    int* leaders    = malloc( size * sizeof( *leaders ) );
+    int  n_leaders  = 0;
+    int  node_begin = 0;
+    int  node_end   = 0;
+    UTILS_ASSERT( leaders );
+    for ( int i = 0; i < size; i++ )
+    {
+        if ( i == 0 || by_node[ i ].node_id != by_node[ i - 1 ].node_id )
         {
-            /*
-             * Some SHMEM implementations don't support zero-count put/get
-             * operations and/or NULL buffers. That's why we send a dummy
-             * integer value.
-             */
-            int dummy = 0;
-            SCOREP_Ipc_Recv( &dummy, 1, SCOREP_IPC_INT, master );
-            worker_time[ i ] = SCOREP_Timer_GetClockTicks();
-            SCOREP_Ipc_Send( &dummy, 1, SCOREP_IPC_INT, master );
+            leaders[ n_leaders++ ] = by_node[ i ].rank;
         }
+        if ( by_node[ i ].node_id == node_id )
+        {
+            if ( node_end == node_begin )
+            {
+                node_begin = i;
+            }
+            node_end = i + 1;
+        }
+    }
+    qsort( leaders, n_leaders, sizeof( *leaders ), compare_int );
 
-        uint64_t sync_time;
-        int      min_index;
-        SCOREP_Ipc_Recv( &sync_time, 1, SCOREP_IPC_UINT64_T, master );
-        SCOREP_Ipc_Recv( &min_index, 1, SCOREP_IPC_INT, master );
+    int leader = by_node[ node_begin ].rank;
+
+    *offsetTime = 0;
+    *offset     = 0;
+    *error      = 0.0;
+
+    if ( rank == leader )
+    {
+        int* me = bsearch( &rank, leaders, n_leaders, sizeof( *leaders ), compare_int );
+        UTILS_BUG_ON( me == NULL, "Node leader %d not in list of leaders.", rank );
+        int index = me - leaders;
+
+        /* Rank 0 is the lowest rank on its node, thus always leader 0 */
+        for ( int mask = 1; mask < n_leaders; mask <<= 1 )
+        {
+            if ( index < mask && index + mask < n_leaders )
+            {
+                synchronize_with_worker( leaders[ index + mask ], *offset, *error );
+            }
+            else if ( index >= mask && index < 2 * mask )
+            {
+                synchronize_with_master( leaders[ index - mask ], offsetTime, offset, error );
+            }
+        }
+
+        for ( int i = node_begin + 1; i < node_end; i++ )
+        {
+            synchronize_with_worker( by_node[ i ].rank, *offset, *error );
+        }
+
+        if ( rank == 0 )
+        {
+            *offsetTime = SCOREP_Timer_GetClockTicks();
+        }
+    }
+    else
+    {
+        synchronize_with_master( leader, offsetTime, offset, error );
+    }
+
+    free( leaders );
+    free( by_node );
+}
+
+
+void
+SCOREP_SynchronizeClocks( void )
+{
+    if ( SCOREP_Timer_ClockIsGlobal() || !SCOREP_Env_DoTracing() )
+    {
+        SCOREP_AddClockOffset( SCOREP_Timer_GetClockTicks(), 0, 0 );
+        return;
+    }
+
+    uint64_t offset_time;
+    int64_t  offset;
+    double   error;
+
+    switch ( SCOREP_Env_GetClockSyncMode() )
+    {
+        case SCOREP_CLOCK_SYNC_TREE:
+            synchronize_tree( &offset_time, &offset, &error );
+            break;
 
-        offset_time = worker_time[ min_index ];
-        offset      = sync_time - offset_time;
+        case SCOREP_CLOCK_SYNC_LINEAR:
+        default:
+            synchronize_linear( &offset_time, &offset, &error );
+            break;
     }
 
-    double stddev_not_calculated_yet = 0;
-    SCOREP_AddClockOffset( offset_time, offset, stddev_not_calculated_yet );
+    SCOREP_AddClockOffset( offset_time, offset, error );
 }
 
 
@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include <scorep_ipc.h>
 #include <scorep_unify.h>
@@ -57,12 +58,22 @@
 static void
 unify_mpp_hierarchical( void );
 static void
+unify_mpp_tree( void );
+static void
 apply_mappings_to_local_manager( void );
 
 void
 SCOREP_Unify_Mpp( void )
 {
-    unify_mpp_hierarchical();
+    switch ( SCOREP_Env_GetUnifyMode() )
+    {
+        case SCOREP_UNIFY_HYPERCUBE:
+            unify_mpp_hierarchical();
+            break;
+        case SCOREP_UNIFY_TREE:
+            unify_mpp_tree();
+            break;
+    }
 
     /*
      * Now apply the mappings from the final unified definitions
@@ -84,11 +95,28 @@ receive_and_unify_remote_definitions( int                           rank,
                                       uint32_t**                    moved_page_ids,
                                       uint32_t**                    moved_page_fills,
                                       uint32_t*                     max_number_of_pages );
+static int
+calculate_tree_partners( uint32_t arity,
+                         int*     parent,
+                         int**    children );
+static void
+receive_remote_pages( int                           rank,
+                      SCOREP_DefinitionManager*     remote_definition_manager,
+                      SCOREP_Allocator_PageManager* remote_page_manager,
+                      uint32_t**                    moved_page_ids,
+                      uint32_t**                    moved_page_fills,
+                      uint32_t*                     max_number_of_pages,
+                      void*                         pack_buffer,
+                      uint32_t                      pack_size );
+static void
+unify_remote_definitions( SCOREP_DefinitionManager* remote_definition_manager );
 static void
 send_local_unified_definitions_to_parent( int        parent,
                                           uint32_t** moved_page_ids,
                                           uint32_t** moved_page_fills,
-                                          uint32_t*  max_number_of_pages );
+                                          uint32_t*  max_number_of_pages,
+                                          void*      pack_buffer,
+                                          uint32_t   pack_size );
 static void
 apply_and_send_mappings( int                       rank,
                          SCOREP_DefinitionManager* remote_definition_manager );
@@ -143,7 +171,8 @@ unify_mpp_hierarchical( void )
         send_local_unified_definitions_to_parent( parent,
                                                   &moved_page_ids,
                                                   &moved_page_fills,
-                                                  &max_number_of_pages );
+                                                  &max_number_of_pages,
+                                                  NULL, 0 );
 
         /*
          * Phase 2a: Get the mapping from our parent and store them in the local
@@ -175,6 +204,122 @@ unify_mpp_hierarchical( void )
     free( remote_definition_managers );
 }
 
+/**
+ * Unify the definitions within MPI_COMM_WORLD along a k-ary tree.
+ *
+ * Same phases as in unify_mpp_hierarchical, but in phase 1 the receives of
+ * the definition managers of all children are posted at once, and the pages
+ * of each child are received as soon as its definition manager arrived.
+ * Small pages are packed into transfers of up to one page size.
+ *
+ * The children are still unified in rank order, as soon as all children
+ * with lower ranks are received. As the subtree of each process covers a
+ * contiguous range of ranks, the unified definitions are in the same order
+ * as with unify_mpp_hierarchical.
+ */
+void
+unify_mpp_tree( void )
+{
+    int  parent;
+    int  me       = SCOREP_Ipc_GetRank();
+    int* children = NULL;
+
+    int num_children = calculate_tree_partners( SCOREP_Env_GetUnifyTreeArity(),
+                                                &parent, &children );
+
+    SCOREP_DefinitionManager* remote_definition_managers =
+        calloc( num_children, sizeof( *remote_definition_managers ) );
+    SCOREP_Allocator_PageManager** remote_page_managers =
+        calloc( num_children, sizeof( *remote_page_managers ) );
+    SCOREP_Ipc_Request** requests =
+        calloc( num_children, sizeof( *requests ) );
+    bool* received = calloc( num_children, sizeof( *received ) );
+    UTILS_BUG_ON( num_children && ( !remote_definition_managers
+                                    || !remote_page_managers
+                                    || !requests
+                                    || !received ),
+                  "Can't allocate memory for %d children", num_children );
+
+    uint32_t pack_size   = SCOREP_Env_GetPageSize();
+    void*    pack_buffer = malloc( pack_size );
+    UTILS_BUG_ON( pack_buffer == NULL,
+                  "Can't allocate memory for pack buffer of size: %u", pack_size );
+
+    uint32_t* moved_page_ids      = NULL;
+    uint32_t* moved_page_fills    = NULL;
+    uint32_t  max_number_of_pages = 0;
+
+    /* Phase 1a: Get all definitions from my children and unify them into my. */
+    for ( int child = 0; child < num_children; child++ )
+    {
+        remote_page_managers[ child ] = SCOREP_Memory_CreateMovedPagedMemory();
+        SCOREP_Ipc_Irecv( &remote_definition_managers[ child ],
+                          sizeof( remote_definition_managers[ child ] ),
+                          SCOREP_IPC_BYTE,
+                          children[ child ],
+                          &requests[ child ] );
+    }
+    int next_child = 0;
+    for ( int i = 0; i < num_children; i++ )
+    {
+        int child;
+        SCOREP_Ipc_Waitany( num_children, requests, &child );
+        UTILS_BUG_ON( child < 0, "No pending receive for child definitions." );
+
+        receive_remote_pages( children[ child ],
+                              &remote_definition_managers[ child ],
+                              remote_page_managers[ child ],
+                              &moved_page_ids,
+                              &moved_page_fills,
+                              &max_number_of_pages,
+                              pack_buffer,
+                              pack_size );
+        received[ child ] = true;
+
+        while ( next_child < num_children && received[ next_child ] )
+        {
+            unify_remote_definitions( &remote_definition_managers[ next_child ] );
+            SCOREP_Allocator_DeletePageManager( remote_page_managers[ next_child ] );
+            next_child++;
+        }
+    }
+
+    /*
+     * Phase 1b & 2a: Send my unified definitions up to my parent and receive
+     *                the mappings from it.
+     */
+    if ( parent != me )
+    {
+        send_local_unified_definitions_to_parent( parent,
+                                                  &moved_page_ids,
+                                                  &moved_page_fills,
+                                                  &max_number_of_pages,
+                                                  pack_buffer,
+                                                  pack_size );
+        receive_mappings( parent );
+    }
+
+    free( pack_buffer );
+    free( moved_page_ids );
+    free( moved_page_fills );
+
+    /*
+     * Phase 2b: Apply the mapping to all of my children and send the resulting
+     *           mapping to our children.
+     */
+    for ( int child = 0; child < num_children; child++ )
+    {
+        apply_and_send_mappings( children[ child ],
+                                 &remote_definition_managers[ child ] );
+    }
+
+    free( children );
+    free( received );
+    free( requests );
+    free( remote_page_managers );
+    free( remote_definition_managers );
+}
+
 /**
  * Calculate the smallest power-of-two number which is greater/equal to @a v.
  */
@@ -252,6 +397,61 @@ calculate_comm_partners( int*  parent,
 }
 
 
+/**
+ * Calculate the communication partners of me in a k-ary tree, in which the
+ * subtree of each process covers a contiguous range of ranks, starting with
+ * the process itself. The remaining ranks of a subtree are split evenly into
+ * at most @a arity subtrees of the children.
+ *
+ * @return the number of children.
+ */
+int
+calculate_tree_partners( uint32_t arity,
+                         int*     parent,
+                         int**    children )
+{
+    uint32_t me    = SCOREP_Ipc_GetRank();
+    uint32_t first = 0;
+    uint32_t end   = SCOREP_Ipc_GetSize();
+
+    /* Be your own parent, ie. the root, by default */
+    *parent = me;
+
+    /* Descend from the root to the subtree starting with me */
+    while ( true )
+    {
+        uint32_t remaining          = end - first - 1;
+        uint32_t number_of_children = remaining < arity ? remaining : arity;
+
+        if ( first == me )
+        {
+            *children = malloc( sizeof( **children ) * number_of_children );
+            for ( uint32_t i = 0; i < number_of_children; i++ )
+            {
+                ( *children )[ i ] = first + 1
+                                     + ( uint64_t )i * remaining / number_of_children;
+            }
+            return number_of_children;
+        }
+
+        for ( uint32_t i = 0; i < number_of_children; i++ )
+        {
+            uint32_t child_first = first + 1
+                                   + ( uint64_t )i * remaining / number_of_children;
+            uint32_t child_end = first + 1
+                                 + ( uint64_t )( i + 1 ) * remaining / number_of_children;
+            if ( me < child_end )
+            {
+                *parent = first;
+                first   = child_first;
+                end     = child_end;
+                break;
+            }
+        }
+    }
+}
+
+
 void
 receive_and_unify_remote_definitions( int                           rank,
                                       SCOREP_DefinitionManager*     remote_definition_manager,
@@ -266,6 +466,53 @@ receive_and_unify_remote_definitions( int                           rank,
                      SCOREP_IPC_BYTE,
                      rank );
 
+    receive_remote_pages( rank,
+                          remote_definition_manager,
+                          remote_page_manager,
+                          moved_page_ids,
+                          moved_page_fills,
+                          max_number_of_pages,
+                          NULL, 0 );
+
+    unify_remote_definitions( remote_definition_manager );
+}
+
+
+/**
+ * Returns the number of pages, starting with @a page, which are transferred
+ * together, without exceeding @a pack_size bytes, and their total fill in
+ * @a packed_bytes. A @a pack_size of 0 disables packing.
+ */
+static uint32_t
+number_of_packed_pages( const uint32_t* page_fills,
+                        uint32_t        page,
+                        uint32_t        number_of_pages,
+                        uint32_t        pack_size,
+                        uint32_t*       packed_bytes )
+{
+    uint32_t n     = 1;
+    uint64_t bytes = page_fills[ page ];
+    while ( page + n < number_of_pages
+            && bytes + page_fills[ page + n ] <= pack_size )
+    {
+        bytes += page_fills[ page + n ];
+        n++;
+    }
+    *packed_bytes = bytes;
+    return n;
+}
+
+
+void
+receive_remote_pages( int                           rank,
+                      SCOREP_DefinitionManager*     remote_definition_manager,
+                      SCOREP_Allocator_PageManager* remote_page_manager,
+                      uint32_t**                    moved_page_ids,
+                      uint32_t**                    moved_page_fills,
+                      uint32_t*                     max_number_of_pages,
+                      void*                         pack_buffer,
+                      uint32_t                      pack_size )
+{
     // 2) Create and receive page manager infos
 
     // page_manager member was overwritten by recv
@@ -309,31 +556,62 @@ receive_and_unify_remote_definitions( int                           rank,
                      rank );
 
     // 5) Receive all remote pages from rank
-    for ( uint32_t page = 0; page < number_of_pages; page++ )
+    for ( uint32_t page = 0; page < number_of_pages; )
     {
-        /* Allocate local page */
-        void* page_memory = SCOREP_Allocator_AllocMovedPage(
-            remote_page_manager,
-            ( *moved_page_ids )[ page ],
-            ( *moved_page_fills )[ page ] );
-        if ( !page_memory )
+        uint32_t packed_bytes;
+        uint32_t n = number_of_packed_pages( *moved_page_fills,
+                                             page,
+                                             number_of_pages,
+                                             pack_size,
+                                             &packed_bytes );
+        if ( n > 1 )
         {
-            // aborts
-            SCOREP_Memory_HandleOutOfMemory();
+            SCOREP_Ipc_Recv( pack_buffer,
+                             packed_bytes,
+                             SCOREP_IPC_BYTE,
+                             rank );
         }
 
-        SCOREP_Ipc_Recv( page_memory,
-                         ( *moved_page_fills )[ page ],
-                         SCOREP_IPC_BYTE,
-                         rank );
+        char* packed = pack_buffer;
+        for ( uint32_t end = page + n; page < end; page++ )
+        {
+            /* Allocate local page */
+            void* page_memory = SCOREP_Allocator_AllocMovedPage(
+                remote_page_manager,
+                ( *moved_page_ids )[ page ],
+                ( *moved_page_fills )[ page ] );
+            if ( !page_memory )
+            {
+                // aborts
+                SCOREP_Memory_HandleOutOfMemory();
+            }
+
+            if ( n > 1 )
+            {
+                memcpy( page_memory, packed, ( *moved_page_fills )[ page ] );
+                packed += ( *moved_page_fills )[ page ];
+            }
+            else
+            {
+                SCOREP_Ipc_Recv( page_memory,
+                                 ( *moved_page_fills )[ page ],
+                                 SCOREP_IPC_BYTE,
+                                 rank );
+            }
+        }
     }
+}
+
 
+void
+unify_remote_definitions( SCOREP_DefinitionManager* remote_definition_manager )
+{
     // 6) Unify received remote definitions to our one
     SCOREP_CopyDefinitionsToUnified( remote_definition_manager );
     SCOREP_CreateDefinitionMappings( remote_definition_manager );
     SCOREP_AssignDefinitionMappingsFromUnified( remote_definition_manager );
 
-    SCOREP_Allocator_Free( remote_page_manager );
+    SCOREP_Allocator_Free( remote_definition_manager->page_manager );
     remote_definition_manager->page_manager = NULL;
 }
 
@@ -342,7 +620,9 @@ void
 send_local_unified_definitions_to_parent( int        parent,
                                           uint32_t** moved_page_ids,
                                           uint32_t** moved_page_fills,
-                                          uint32_t*  max_number_of_pages )
+                                          uint32_t*  max_number_of_pages,
+                                          void*      pack_buffer,
+                                          uint32_t   pack_size )
 {
     // 1) Send my local unified definition manager to my parent
     SCOREP_Ipc_Send( scorep_unified_definition_manager,
@@ -395,10 +675,32 @@ send_local_unified_definitions_to_parent( int        parent,
                      SCOREP_IPC_UINT32_T, parent );
 
     // 3) Send all pages to my parent
-    for ( uint32_t page = 0; page < number_of_used_pages; page++ )
+    for ( uint32_t page = 0; page < number_of_used_pages; )
     {
-        SCOREP_Ipc_Send( moved_page_starts[ page ],
-                         ( *moved_page_fills )[ page ],
+        uint32_t packed_bytes;
+        uint32_t n = number_of_packed_pages( *moved_page_fills,
+                                             page,
+                                             number_of_used_pages,
+                                             pack_size,
+                                             &packed_bytes );
+        if ( n == 1 )
+        {
+            SCOREP_Ipc_Send( moved_page_starts[ page ],
+                             ( *moved_page_fills )[ page ],
+                             SCOREP_IPC_BYTE, parent );
+            page++;
+            continue;
+        }
+
+        /* Pack small pages into one transfer */
+        char* packed = pack_buffer;
+        for ( uint32_t end = page + n; page < end; page++ )
+        {
+            memcpy( packed, moved_page_starts[ page ], ( *moved_page_fills )[ page ] );
+            packed += ( *moved_page_fills )[ page ];
+        }
+        SCOREP_Ipc_Send( pack_buffer,
+                         packed_bytes,
                          SCOREP_IPC_BYTE, parent );
     }
 
@@ -391,6 +391,46 @@ SCOREP_IpcGroup_Barrier( SCOREP_Ipc_Group* group )
 }
 
 
+/* There is no non-blocking receive, thus requests complete immediately. */
+struct SCOREP_Ipc_Request
+{
+    int completed;
+};
+static SCOREP_Ipc_Request completed_request = { 1 };
+
+
+int
+SCOREP_IpcGroup_Irecv( SCOREP_Ipc_Group*    group,
+                       void*                buf,
+                       int                  count,
+                       SCOREP_Ipc_Datatype  datatype,
+                       int                  source,
+                       SCOREP_Ipc_Request** request )
+{
+    *request = &completed_request;
+    return SCOREP_IpcGroup_Recv( group, buf, count, datatype, source );
+}
+
+
+int
+SCOREP_Ipc_Waitany( int                  count,
+                    SCOREP_Ipc_Request** requests,
+                    int*                 index )
+{
+    *index = -1;
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( requests[ i ] )
+        {
+            requests[ i ] = NULL;
+            *index        = i;
+            break;
+        }
+    }
+    return 0;
+}
+
+
 int
 SCOREP_IpcGroup_Bcast( SCOREP_Ipc_Group*   group,
                        void*               buf,
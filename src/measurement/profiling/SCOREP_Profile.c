@@ -69,6 +69,7 @@
 #include <SCOREP_Profile_MpiEvents.h>
 #include <SCOREP_Thread_Mgmt.h>
 #include <scorep_profile_io.h>
+#include "scorep_profile_live.h"
 
 #include <string.h>
 
@@ -152,6 +153,12 @@ SCOREP_Profile_Initialize( size_t substrateId )
     scorep_profile_task_initialize();
     scorep_profile_init_rma();
     scorep_profile_io_init();
+#if HAVE_BACKEND( PROFILE_LIVE_SNAPSHOTS )
+    if ( scorep_profile_enable_live_snapshots )
+    {
+        scorep_profile_live_initialize();
+    }
+#endif
 
     if ( !scorep_profile.reinitialize )
     {
@@ -180,6 +187,13 @@ SCOREP_Profile_Initialize( size_t substrateId )
                 scorep_profile_init_dense_metric_array( current->dense_metrics,
                                                         num_dense_metrics );
             }
+            if ( scorep_profile_enable_time_histograms )
+            {
+                current->time_histogram = ( uint64_t* )
+                                          SCOREP_Location_AllocForProfile( profile_location->location_data,
+                                                                           SCOREP_PROFILE_HISTOGRAM_BUCKETS * sizeof( uint64_t ) );
+                scorep_profile_init_histogram( current->time_histogram );
+            }
             current = current->next_sibling;
         }
     }
@@ -266,6 +280,7 @@ SCOREP_Profile_Finalize( void )
 
             /* Metrics are freed, too */
             current->dense_metrics       = NULL;
+            current->time_histogram      = NULL;
             current->first_double_sparse = NULL;
             current->first_int_sparse    = NULL;
 
@@ -496,6 +511,9 @@ on_location_creation( SCOREP_Location* locationData,
 static void
 delete_location_data( SCOREP_Location* location )
 {
+#if HAVE_BACKEND( PROFILE_LIVE_SNAPSHOTS )
+    scorep_profile_live_delete( scorep_profile_get_profile_data( location ) );
+#endif
     SCOREP_Memory_FreeProfileMem( location );
     scorep_profile_delete_location_data( scorep_profile_get_profile_data( location ) );
 }
@@ -830,6 +848,13 @@ SCOREP_Profile_Exit( SCOREP_Location*    thread,
 
     /* Update current node */
     scorep_profile_set_current_node( location, parent );
+
+#if HAVE_BACKEND( PROFILE_LIVE_SNAPSHOTS )
+    if ( scorep_profile_enable_live_snapshots )
+    {
+        scorep_profile_live_on_exit( location, timestamp, type, metrics );
+    }
+#endif
 }
 
 
@@ -74,8 +74,8 @@ print_region_definitions( void );
  * Prints given hash table
  */
 static void
-print_hash_table( const SCOREP_Hashtab* hashTable,
-                  char*                 tag );
+print_hash_table( const SCOREP_ConcurrentHashtab* hashTable,
+                  char*                           tag );
 
 #endif /* HAVE( SCOREP_DEBUG ) */
 
@@ -179,17 +179,17 @@ SCOREP_OAConsumer_DismissData( void )
     free( thread_index_pointer_array[ 0 ]->shared_index->merged_region_def_buffer );
     free( thread_index_pointer_array[ 0 ]->shared_index->static_measurement_buffer );
     free( thread_index_pointer_array[ 0 ]->shared_index->counter_definition_buffer );
-    SCOREP_Hashtab_FreeAll( thread_index_pointer_array[ 0 ]->shared_index->merged_regions_def_table,
-                            &SCOREP_Hashtab_DeleteFree,
-                            &SCOREP_Hashtab_DeleteNone );
+    SCOREP_ConcurrentHashtab_FreeAll( thread_index_pointer_array[ 0 ]->shared_index->merged_regions_def_table,
+                                      &SCOREP_Hashtab_DeleteFree,
+                                      &SCOREP_Hashtab_DeleteNone );
     free( thread_index_pointer_array[ 0 ]->shared_index );
 
     int i;
     for ( i = 0; i < thread_count; i++ )
     {
-        SCOREP_Hashtab_FreeAll( thread_index_pointer_array[ i ]->static_measurements_table,
-                                &SCOREP_Hashtab_DeleteFree,
-                                &SCOREP_Hashtab_DeleteNone );
+        SCOREP_ConcurrentHashtab_FreeAll( thread_index_pointer_array[ i ]->static_measurements_table,
+                                          &SCOREP_Hashtab_DeleteFree,
+                                          &SCOREP_Hashtab_DeleteNone );
         free( thread_index_pointer_array[ i ] );
     }
     free( thread_index_pointer_array );
@@ -222,34 +222,29 @@ print_region_definitions( void )
 }
 
 static void
-print_hash_table( const SCOREP_Hashtab* hashTable,
-                  char*                 tag )
+print_hash_table_entry( SCOREP_Hashtab_Entry* entry )
 {
-    UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "\n/////////////%s///////////\n", tag );
-    SCOREP_Hashtab_Iterator* iter;
-    SCOREP_Hashtab_Entry*    entry;
-
-    iter  = SCOREP_Hashtab_IteratorCreate( hashTable );
-    entry = SCOREP_Hashtab_IteratorFirst( iter );
-    while ( entry )
+    if ( entry->key )
     {
-        if ( entry->key )
-        {
-            UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "Item (%d,%d,%d)-",
-                                    ( *( scorep_oa_key_type* )entry->key ).parent_region_id,
-                                    ( *( scorep_oa_key_type* )entry->key ).region_id,
-                                    ( *( scorep_oa_key_type* )entry->key ).metric_id );
-        }
-        else
-        {
-            UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "Item (X,X,X)-" );
-        }
+        UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "Item (%d,%d,%d)-",
+                                ( *( scorep_oa_key_type* )entry->key ).parent_region_id,
+                                ( *( scorep_oa_key_type* )entry->key ).region_id,
+                                ( *( scorep_oa_key_type* )entry->key ).metric_id );
+    }
+    else
+    {
+        UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "Item (X,X,X)-" );
+    }
 
-        UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "%d\n", entry->value.uint32 );
+    UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "%d\n", entry->value.uint32 );
+}
 
-        entry = SCOREP_Hashtab_IteratorNext( iter );
-    }
-    SCOREP_Hashtab_IteratorFree( iter );
+static void
+print_hash_table( const SCOREP_ConcurrentHashtab* hashTable,
+                  char*                           tag )
+{
+    UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "\n/////////////%s///////////\n", tag );
+    SCOREP_ConcurrentHashtab_Foreach( hashTable, &print_hash_table_entry );
     UTILS_DEBUG_RAW_PRINTF( SCOREP_DEBUG_OA, "///////////////////////////\n\n" );
 }
 #endif /* HAVE( SCOREP_DEBUG ) */
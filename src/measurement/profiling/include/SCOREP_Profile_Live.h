@@ -0,0 +1,182 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCOREP_PROFILE_LIVE_H
+#define SCOREP_PROFILE_LIVE_H
+
+/**
+ * @file
+ *
+ * @brief Layout of the live profile snapshots in POSIX shared memory.
+ *
+ * If SCOREP_PROFILING_ENABLE_LIVE_SNAPSHOTS is set, every location publishes
+ * a flat summary of its call tree in a shared-memory segment named
+ * "/scorep-live-<pid>-<location id>". The segment starts with a
+ * SCOREP_Profile_LiveHeader, followed by the names of the dense metrics and
+ * two buffers. The location writes into the buffer that is not active and
+ * makes it active afterwards. Each buffer starts with a
+ * SCOREP_Profile_LiveBuffer, followed by the records in depth-first order.
+ * A record consists of a SCOREP_Profile_LiveRecord and the sums of the dense
+ * metrics.
+ *
+ * Readers copy the active buffer and accept the copy if the sequence number
+ * of the buffer was even and did not change meanwhile, see
+ * SCOREP_Profile_LiveReadBuffer(). This file is shared by the measurement
+ * system and the scorep-live-profile tool.
+ */
+
+#include <SCOREP_Atomic.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Set in the header once the segment is completely initialized. */
+#define SCOREP_PROFILE_LIVE_MAGIC UINT64_C( 0x53434f5245504c56 )
+
+/** Version of the layout, incremented on incompatible changes. */
+#define SCOREP_PROFILE_LIVE_VERSION 1
+
+/** Prefix of the segment names, followed by "<pid>-<location id>". */
+#define SCOREP_PROFILE_LIVE_PREFIX "scorep-live-"
+
+/** Size of the name fields, including the terminating zero. */
+#define SCOREP_PROFILE_LIVE_NAME_LENGTH 64
+
+/**
+ * Header of a live snapshot segment.
+ */
+typedef struct SCOREP_Profile_LiveHeader
+{
+    uint64_t magic;                                           /**< SCOREP_PROFILE_LIVE_MAGIC */
+    uint32_t version;                                         /**< SCOREP_PROFILE_LIVE_VERSION */
+    uint32_t number_of_metrics;                               /**< Dense metrics per record */
+    uint64_t pid;                                             /**< Process that writes the segment */
+    int64_t  rank;                                            /**< MPP rank, -1 until known */
+    uint64_t location_id;                                     /**< Local id of the location */
+    uint64_t max_records;                                     /**< Capacity of each buffer in records */
+    uint64_t record_size;                                     /**< Size of one record in bytes */
+    uint64_t buffer_offset[ 2 ];                              /**< Offsets of the buffers in the segment */
+    uint64_t active_buffer;                                   /**< Index of the buffer to read */
+    char     location_name[ SCOREP_PROFILE_LIVE_NAME_LENGTH ];
+} SCOREP_Profile_LiveHeader;
+
+/**
+ * Header of one of the two buffers.
+ */
+typedef struct SCOREP_Profile_LiveBuffer
+{
+    uint64_t sequence;          /**< Odd while the buffer is written */
+    uint64_t timestamp;         /**< Timer ticks at the refresh */
+    uint64_t timer_resolution;  /**< Timer ticks per second, estimated at the refresh */
+    uint64_t wallclock;         /**< Seconds since the epoch at the refresh */
+    uint64_t number_of_records; /**< Number of valid records */
+    uint64_t dropped_records;   /**< Call-tree nodes that did not fit */
+} SCOREP_Profile_LiveBuffer;
+
+/**
+ * One call path of the location. Times are in timer ticks. Regions that are
+ * currently entered include the time up to the refresh.
+ */
+typedef struct SCOREP_Profile_LiveRecord
+{
+    uint64_t callpath_id;                            /**< Identifies the call path across refreshes */
+    int64_t  parent;                                 /**< Index of the parent record, -1 for roots */
+    uint64_t depth;                                  /**< Depth of the record, 0 for roots */
+    uint64_t visits;                                 /**< Number of visits */
+    uint64_t inclusive_time;                         /**< Inclusive time */
+    uint64_t exclusive_time;                         /**< Inclusive time minus that of the children */
+    char     name[ SCOREP_PROFILE_LIVE_NAME_LENGTH ]; /**< Region name, possibly truncated */
+} SCOREP_Profile_LiveRecord;
+
+
+/**
+ * Returns the name of the dense metric @a index.
+ */
+static inline const char*
+SCOREP_Profile_LiveMetricName( const SCOREP_Profile_LiveHeader* header,
+                               uint32_t                         index )
+{
+    return ( const char* )( header + 1 ) + index * SCOREP_PROFILE_LIVE_NAME_LENGTH;
+}
+
+/**
+ * Returns the buffer @a index of the segment.
+ */
+static inline SCOREP_Profile_LiveBuffer*
+SCOREP_Profile_LiveGetBuffer( const SCOREP_Profile_LiveHeader* header,
+                              uint64_t                         index )
+{
+    return ( SCOREP_Profile_LiveBuffer* )( ( char* )header + header->buffer_offset[ index ] );
+}
+
+/**
+ * Returns the record @a index of @a buffer.
+ */
+static inline SCOREP_Profile_LiveRecord*
+SCOREP_Profile_LiveGetRecord( const SCOREP_Profile_LiveHeader* header,
+                              const SCOREP_Profile_LiveBuffer* buffer,
+                              uint64_t                         index )
+{
+    return ( SCOREP_Profile_LiveRecord* )( ( char* )( buffer + 1 ) + index * header->record_size );
+}
+
+/**
+ * Returns the dense metric sums of @a record.
+ */
+static inline uint64_t*
+SCOREP_Profile_LiveGetMetrics( SCOREP_Profile_LiveRecord* record )
+{
+    return ( uint64_t* )( record + 1 );
+}
+
+/**
+ * Returns the size of one buffer including its header.
+ */
+static inline uint64_t
+SCOREP_Profile_LiveBufferSize( uint64_t maxRecords,
+                               uint64_t recordSize )
+{
+    return sizeof( SCOREP_Profile_LiveBuffer ) + maxRecords * recordSize;
+}
+
+/**
+ * Copies a consistent state of the active buffer into @a destination, which
+ * must provide SCOREP_Profile_LiveBufferSize() bytes. Returns false if the
+ * writer refreshed the buffer during the copy, in which case the caller
+ * should try again.
+ */
+static inline bool
+SCOREP_Profile_LiveReadBuffer( const SCOREP_Profile_LiveHeader* header,
+                               SCOREP_Profile_LiveBuffer*       destination )
+{
+    uint64_t                   active   = SCOREP_ATOMIC_LOAD( &header->active_buffer, SCOREP_ATOMIC_ACQUIRE );
+    SCOREP_Profile_LiveBuffer* buffer   = SCOREP_Profile_LiveGetBuffer( header, active & 1 );
+    uint64_t                   sequence = SCOREP_ATOMIC_LOAD( &buffer->sequence, SCOREP_ATOMIC_ACQUIRE );
+    if ( sequence & 1 )
+    {
+        return false;
+    }
+
+    uint64_t number_of_records = buffer->number_of_records;
+    if ( number_of_records > header->max_records )
+    {
+        return false;
+    }
+    memcpy( destination, buffer,
+            SCOREP_Profile_LiveBufferSize( number_of_records, header->record_size ) );
+
+    SCOREP_ATOMIC_THREAD_FENCE( SCOREP_ATOMIC_ACQUIRE );
+    return SCOREP_ATOMIC_LOAD( &buffer->sequence, SCOREP_ATOMIC_RELAXED ) == sequence;
+}
+
+#endif /* SCOREP_PROFILE_LIVE_H */
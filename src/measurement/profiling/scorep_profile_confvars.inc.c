@@ -57,6 +57,12 @@ uint64_t scorep_profile_task_exchange_num;
  */
 uint64_t scorep_profile_max_callpath_depth;
 
+/**
+   Number of children after which the children of a node are looked up via the
+   per-location child index.
+ */
+uint64_t scorep_profile_child_index_threshold;
+
 /**
    Contains the basename for profile files.
  */
@@ -67,6 +73,12 @@ char* scorep_profile_basename = NULL;
  */
 uint64_t scorep_profile_output_format;
 
+/**
+   Stores the size of the buffer for gathering callpath blocks when writing
+   Cube4 profiles.
+ */
+uint64_t scorep_profile_cube_write_buffer_size;
+
 /**
    Stores the number of clusters
  */
@@ -92,6 +104,27 @@ bool scorep_profile_enable_clustering;
  */
 bool scorep_profile_enable_core_files;
 
+/**
+   Stores whether a histogram of the inclusive time is recorded per callpath.
+ */
+bool scorep_profile_enable_time_histograms;
+
+/**
+   Stores whether the live snapshots are enabled.
+ */
+bool scorep_profile_enable_live_snapshots;
+
+/**
+   Minimum time between two timed refreshes of the live snapshots in
+   milliseconds.
+ */
+uint64_t scorep_profile_live_snapshot_interval;
+
+/**
+   Maximum number of call paths in a live snapshot.
+ */
+uint64_t scorep_profile_live_snapshot_callpaths;
+
 
 /**
    Option table for output format configuration.
@@ -221,6 +254,20 @@ static const SCOREP_ConfigVariable scorep_profile_confvars[] = {
         "Maximum depth of the calltree",
         ""
     },
+    {
+        "child_index_threshold",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_profile_child_index_threshold,
+        NULL,
+        "32",
+        "Number of children after which a call-tree node uses a hashed child lookup",
+        "By default, the children of a call-tree node are stored in a list, which "
+        "is searched on every enter. If a node has more children than this value, "
+        "the children are additionally stored in a per-location hash table, which "
+        "keeps the enter cost constant for nodes with a high fan-out, e.g., "
+        "regions with many parameter values or dynamic regions. A value of 0 "
+        "disables the hashed lookup."
+    },
 /*
     {
         "max_callpath_num",
@@ -252,6 +299,21 @@ static const SCOREP_ConfigVariable scorep_profile_confvars[] = {
         "\n"
         "The following formats are supported:"
     },
+    {
+        "cube_write_buffer",
+        SCOREP_CONFIG_TYPE_SIZE,
+        &scorep_profile_cube_write_buffer_size,
+        NULL,
+        "8M",
+        "Buffer size for collecting Cube4 profile data on the writing rank",
+        "When writing a Cube4 profile, the values of every metric are collected "
+        "on one rank. To reduce the number of collective operations, the values "
+        "of several callpaths are collected at once. This variable limits the "
+        "memory that is used for one such block on the writing rank. The "
+        "number of callpaths per block is this size divided by the size of one "
+        "row of values for all locations. A value of 0 collects one callpath "
+        "at a time."
+    },
     {
         "enable_clustering",
         SCOREP_CONFIG_TYPE_BOOL,
@@ -304,6 +366,63 @@ static const SCOREP_ConfigVariable scorep_profile_confvars[] = {
         "stack at these points. It is not recommended to enable this feature for "
         "large scale measurements."
     },
+    {
+        "enable_time_histograms",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_profile_enable_time_histograms,
+        NULL,
+        "false",
+        "Record a histogram of the inclusive time per callpath",
+        "If enabled, every callpath counts the inclusive times of its visits in a "
+        "log-linear histogram, which divides every power of two into 4 buckets. "
+        "The histograms have a fixed size of about 2 KiB per callpath and location. "
+        "They are merged when locations are aggregated and are written to Cube4 "
+        "profiles as the metrics \"time_p50\" and \"time_p99\", which estimate the "
+        "median and the 99th percentile of the inclusive time, and as the bucket "
+        "counts below \"time_histogram\", one metric per bucket, grouped by powers "
+        "of two. The percentiles are estimated per location, or per process for "
+        "the thread_sum format, thus aggregating them over locations yields their "
+        "maximum. Summing the bucket counts over locations yields the histogram of "
+        "the aggregated locations. Not available for the thread_tuple format."
+    },
+#if HAVE_BACKEND( PROFILE_LIVE_SNAPSHOTS )
+    {
+        "enable_live_snapshots",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_profile_enable_live_snapshots,
+        NULL,
+        "false",
+        "Publish live profile snapshots in POSIX shared memory",
+        "If enabled, every location publishes a flat summary of its call tree "
+        "in a shared-memory segment named /scorep-live-<pid>-<location id>, "
+        "which the scorep-live-profile tool displays while the application "
+        "runs. For every call path, the summary contains the number of visits, "
+        "the inclusive and exclusive time, and the sums of the dense metrics.\n"
+        "A location refreshes its summary when it exits a phase region, or when "
+        "it exits any region and the time given in "
+        "SCOREP_PROFILING_LIVE_SNAPSHOT_INTERVAL elapsed since its last refresh. "
+        "The segments are removed at the end of the measurement."
+    },
+    {
+        "live_snapshot_interval",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_profile_live_snapshot_interval,
+        NULL,
+        "1000",
+        "Minimum time between two timed refreshes of a live profile snapshot in milliseconds",
+        "A value of 0 refreshes the snapshots only when a phase region is exited."
+    },
+    {
+        "live_snapshot_callpaths",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_profile_live_snapshot_callpaths,
+        NULL,
+        "4096",
+        "Maximum number of call paths in a live profile snapshot",
+        "Determines the size of the shared-memory segment of every location. "
+        "Call paths beyond this number are counted, but not published."
+    },
+#endif
     SCOREP_CONFIG_TERMINATOR
 };
 
@@ -42,6 +42,7 @@
 #include <scorep_profile_cube4_writer.h>
 #include <sys/stat.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include <SCOREP_RuntimeManagement.h>
 #include <SCOREP_Memory.h>
@@ -342,6 +343,113 @@ get_hits_tuple( scorep_profile_node* node, void* data )
     return value;
 }
 
+/**
+   Data of get_time_percentile.
+ */
+typedef struct
+{
+    scorep_cube_writing_data* write_set;  /**< The write data of the profile */
+    double                    percentile; /**< Requested percentile */
+    uint64_t*                 histogram;  /**< Buffer to merge the thread histograms */
+} scorep_profile_percentile_data;
+
+/**
+   Returns an estimate of a percentile of the inclusive time of @a node.
+   If the format sums up all threads, the histograms of all threads are merged
+   and the estimate is returned for the first thread, while the other threads
+   return 0.
+   This functions are given to scorep_profile_write_cube_metric.
+   @param node Pointer to a node which should return the metric value.
+   @param data Pointer to a scorep_profile_percentile_data instance.
+   @returns the estimated percentile of the inclusive time of @a node.
+ */
+static double
+get_time_percentile( scorep_profile_node* node, void* data )
+{
+    scorep_profile_percentile_data* percentile_data = ( scorep_profile_percentile_data* )data;
+    scorep_cube_writing_data*       write_set       = percentile_data->write_set;
+
+    if ( node->time_histogram == NULL )
+    {
+        return 0.0;
+    }
+
+    uint64_t* histogram = node->time_histogram;
+    uint64_t  min       = node->inclusive_time.min;
+    uint64_t  max       = node->inclusive_time.max;
+    if ( write_set->format == SCOREP_PROFILE_OUTPUT_THREAD_SUM )
+    {
+        uint64_t cp_index = SCOREP_CallpathHandle_GetUnifiedId( node->callpath_handle );
+        bool     first    = true;
+
+        histogram = percentile_data->histogram;
+        scorep_profile_init_histogram( histogram );
+        for ( uint64_t thread_index = 0;
+              thread_index < write_set->local_threads; thread_index++ )
+        {
+            scorep_profile_node* current =
+                write_set->id_2_node[ thread_index * write_set->callpath_number + cp_index ];
+            if ( current == NULL || current->time_histogram == NULL )
+            {
+                continue;
+            }
+            if ( first && current != node )
+            {
+                return 0.0;
+            }
+            first = false;
+
+            scorep_profile_merge_histogram( histogram, current->time_histogram );
+            if ( min > current->inclusive_time.min )
+            {
+                min = current->inclusive_time.min;
+            }
+            if ( max < current->inclusive_time.max )
+            {
+                max = current->inclusive_time.max;
+            }
+        }
+    }
+
+    return ( ( double )scorep_profile_get_histogram_percentile( histogram,
+                                                                percentile_data->percentile,
+                                                                min, max ) )
+           / ( ( double )SCOREP_Timer_GetClockResolution() );
+}
+
+/**
+   Returns the number of visits of @a node whose inclusive time falls into
+   one bucket of the histogram.
+   This functions are given to scorep_profile_write_cube_metric.
+   @param node Pointer to a node which should return the metric value.
+   @param data Pointer to a uint32_t value that contains the index of the
+               bucket.
+   @returns the number of visits in the bucket.
+ */
+static uint64_t
+get_histogram_bucket_value( scorep_profile_node* node, void* data )
+{
+    if ( node->time_histogram == NULL )
+    {
+        return 0;
+    }
+    return node->time_histogram[ *( uint32_t* )data ];
+}
+
+/**
+   Returns 0 for every node. Used for the parent metrics of the histogram
+   buckets, whose inclusive values are the sums of the buckets.
+   This functions are given to scorep_profile_write_cube_metric.
+   @param node Ignored.
+   @param data Ignored.
+   @returns 0.
+ */
+static uint64_t
+get_zero_value( scorep_profile_node* node, void* data )
+{
+    return 0;
+}
+
 /**
    Returns the values of metrics for @a node.
    This functions are given to scorep_profile_write_cube_metric.
@@ -603,11 +711,47 @@ set_bitstring_for_unknown_metric( scorep_cube_writing_data* writeSet,
 }
 
 
+/**
+   Returns the number of callpaths whose values are gathered to the root rank
+   in one collective operation. The block size is limited by
+   SCOREP_PROFILING_CUBE_WRITE_BUFFER, which bounds the memory needed on the
+   root rank, and by the maximum count of a single collective operation.
+   @param writeSet  Structure containing write data.
+   @param itemSize  Size of one data item in bytes.
+ */
+static uint32_t
+get_block_size( scorep_cube_writing_data* writeSet,
+                size_t                    itemSize )
+{
+    uint64_t row_size   = ( uint64_t )writeSet->global_items * itemSize;
+    uint64_t block_size = row_size > 0
+                          ? scorep_profile_get_cube_write_buffer_size() / row_size
+                          : writeSet->callpath_number;
+    if ( row_size > 0 && block_size > INT32_MAX / row_size )
+    {
+        block_size = INT32_MAX / row_size;
+    }
+    if ( block_size > writeSet->callpath_number )
+    {
+        block_size = writeSet->callpath_number;
+    }
+    if ( block_size == 0 )
+    {
+        block_size = 1;
+    }
+    return block_size;
+}
+
 /* *INDENT-OFF* */
 
 /**
    @def SCOREP_PROFILE_WRITE_CUBE_METRIC
    Code to write metric values in cube format. Used to reduce code replication.
+   The values of the callpaths are gathered in blocks of callpaths to reduce the
+   number of collective operations. Each rank sends the values of all callpaths
+   of a block in one contiguous buffer. Thus, the root rank receives for every
+   rank a block of callpath rows, which is transposed into the rows for
+   cube_write_sev_row_of_*.
  */
 #define SCOREP_PROFILE_WRITE_CUBE_METRIC( type, TYPE, NUMBER, cube_type, zero )                          \
     static void                                                                                          \
@@ -622,90 +766,133 @@ set_bitstring_for_unknown_metric( scorep_cube_writing_data* writeSet,
         cube_cnode*          cnode             = NULL;                                                   \
         type*                aggregated_values = NULL;                                                   \
         type*                local_values      = NULL;                                                   \
+        type*                block_values      = NULL;                                                   \
         type*                global_values     = NULL;                                                   \
+        type*                global_block      = NULL;                                                   \
+        uint64_t*            block_callpaths   = NULL;                                                   \
+        int*                 counts_per_rank   = NULL;                                                   \
         if ( writeSet->callpath_number == 0 ) {                                                          \
             return; }                                                                                    \
                                                                                                          \
+        uint32_t block_size = get_block_size( writeSet, sizeof( type ) );                                \
         local_values      = ( type* )malloc( writeSet->local_threads * sizeof( type ) );                 \
-        aggregated_values = ( type* )malloc( writeSet->local_items * sizeof( type ) );                   \
+        aggregated_values = ( type* )malloc( writeSet->local_threads * sizeof( type ) );                 \
+        block_values      = ( type* )malloc( block_size * writeSet->local_items * sizeof( type ) );      \
+        block_callpaths   = ( uint64_t* )malloc( block_size * sizeof( uint64_t ) );                      \
         UTILS_ASSERT( local_values );                                                                    \
         UTILS_ASSERT( aggregated_values );                                                               \
+        UTILS_ASSERT( block_values );                                                                    \
+        UTILS_ASSERT( block_callpaths );                                                                 \
                                                                                                          \
         if ( writeSet->my_rank == writeSet->root_rank )                                                  \
         {                                                                                                \
             /* Array of all values for one metric for one callpath for all locations */                  \
             global_values = ( type* )malloc( writeSet->global_items * sizeof( type ) );                  \
+            global_block  = ( type* )malloc( ( size_t )block_size * writeSet->global_items *             \
+                                             sizeof( type ) );                                           \
+            UTILS_ASSERT( global_values );                                                               \
+            UTILS_ASSERT( global_block );                                                                \
+            if ( !writeSet->same_thread_num )                                                            \
+            {                                                                                            \
+                counts_per_rank = ( int* )malloc( writeSet->ranks_number * sizeof( int ) );              \
+                UTILS_ASSERT( counts_per_rank );                                                         \
+            }                                                                                            \
                                                                                                          \
             /* Initialize writing of a new metric */                                                     \
             cube_set_known_cnodes_for_metric( writeSet->my_cube, metric,                                 \
                                               ( char* )writeSet->bit_vector );                           \
         }                                                                                                \
-        /* Iterate over all unified callpathes */                                                        \
-        for ( uint64_t cp_index = 0; cp_index < writeSet->callpath_number; cp_index++ )                  \
+        /* Iterate over all unified callpathes. The bit vector is the same on all                        \
+           ranks, thus, all ranks build the same blocks. */                                              \
+        uint64_t cp_index = 0;                                                                           \
+        while ( cp_index < writeSet->callpath_number )                                                   \
         {                                                                                                \
-            if ( !SCOREP_Bitstring_IsSet( writeSet->bit_vector, cp_index ) )                             \
-            {                                                                                            \
-                continue;                                                                                \
-            }                                                                                            \
-            for ( uint64_t thread_index = 0;                                                             \
-                  thread_index < writeSet->local_threads; thread_index++ )                               \
+            uint32_t block_fill = 0;                                                                     \
+            for ( ; cp_index < writeSet->callpath_number && block_fill < block_size; cp_index++ )        \
             {                                                                                            \
-                uint64_t node_index = thread_index * writeSet->callpath_number + cp_index;               \
-                node = writeSet->id_2_node[ node_index ];                                                \
-                if ( node != NULL )                                                                      \
+                if ( !SCOREP_Bitstring_IsSet( writeSet->bit_vector, cp_index ) )                         \
                 {                                                                                        \
-                    local_values[ thread_index ] = getValue( node, funcData );                           \
+                    continue;                                                                            \
                 }                                                                                        \
-                else                                                                                     \
+                for ( uint64_t thread_index = 0;                                                         \
+                      thread_index < writeSet->local_threads; thread_index++ )                           \
                 {                                                                                        \
-                    local_values[ thread_index ] = zero;                                                 \
+                    uint64_t node_index = thread_index * writeSet->callpath_number + cp_index;           \
+                    node = writeSet->id_2_node[ node_index ];                                            \
+                    if ( node != NULL )                                                                  \
+                    {                                                                                    \
+                        local_values[ thread_index ] = getValue( node, funcData );                       \
+                    }                                                                                    \
+                    else                                                                                 \
+                    {                                                                                    \
+                        local_values[ thread_index ] = zero;                                             \
+                    }                                                                                    \
                 }                                                                                        \
+                scorep_profile_aggregate_##type( &local_values,                                          \
+                                                 &aggregated_values,                                     \
+                                                 writeSet );                                             \
+                memcpy( &block_values[ block_fill * writeSet->local_items ],                             \
+                        aggregated_values,                                                               \
+                        writeSet->local_items * sizeof( type ) );                                        \
+                block_callpaths[ block_fill ] = cp_index;                                                \
+                block_fill++;                                                                            \
+            }                                                                                            \
+            if ( block_fill == 0 )                                                                       \
+            {                                                                                            \
+                break;                                                                                   \
             }                                                                                            \
-            scorep_profile_aggregate_##type( &local_values,                                              \
-                                             &aggregated_values,                                         \
-                                             writeSet );                                                 \
+                                                                                                         \
             /* Collect data from all processes */                                                        \
-            SCOREP_IpcGroup_Barrier( comm );                                                             \
             if ( writeSet->same_thread_num )                                                             \
             {                                                                                            \
-                SCOREP_IpcGroup_Gather( comm, aggregated_values, global_values,                          \
-                                        writeSet->local_items * NUMBER,                                  \
+                SCOREP_IpcGroup_Gather( comm, block_values, global_block,                                \
+                                        block_fill * writeSet->local_items * NUMBER,                     \
                                         SCOREP_IPC_##TYPE, writeSet->root_rank );                        \
             }                                                                                            \
             else                                                                                         \
             {                                                                                            \
-                uint32_t* items_per_rank = writeSet->items_per_rank;                                     \
-                if ( NUMBER != 1 && writeSet->my_rank == writeSet->root_rank )                           \
+                if ( writeSet->my_rank == writeSet->root_rank )                                          \
                 {                                                                                        \
-                    items_per_rank = ( uint32_t* )malloc( writeSet->ranks_number * sizeof( uint32_t ) ); \
-                    UTILS_ASSERT( items_per_rank );                                                      \
                     for ( uint32_t rank = 0; rank < writeSet->ranks_number; rank++ )                     \
                     {                                                                                    \
-                        items_per_rank[ rank ] = writeSet->items_per_rank[ rank ] * NUMBER;              \
+                        counts_per_rank[ rank ] =                                                        \
+                            writeSet->items_per_rank[ rank ] * block_fill * NUMBER;                      \
                     }                                                                                    \
                 }                                                                                        \
                 SCOREP_IpcGroup_Gatherv( comm,                                                           \
-                                         aggregated_values,                                              \
-                                         writeSet->local_items * NUMBER,                                 \
-                                         global_values, items_per_rank,                                  \
+                                         block_values,                                                   \
+                                         block_fill * writeSet->local_items * NUMBER,                    \
+                                         global_block, counts_per_rank,                                  \
                                          SCOREP_IPC_##TYPE, writeSet->root_rank );                       \
-                if ( NUMBER != 1 && writeSet->my_rank == writeSet->root_rank )                           \
-                {                                                                                        \
-                    free( items_per_rank );                                                              \
-                }                                                                                        \
             }                                                                                            \
                                                                                                          \
-            /* Write data for one callpath */                                                            \
+            /* Write data for the callpaths of this block */                                             \
             if ( writeSet->my_rank == writeSet->root_rank )                                              \
             {                                                                                            \
-                cnode = cube_get_cnode( writeSet->my_cube, cp_index );                                   \
-                cube_write_sev_row_of_##cube_type( writeSet->my_cube, metric,                            \
-                                                   cnode, global_values );                               \
+                for ( uint32_t block_index = 0; block_index < block_fill; block_index++ )                \
+                {                                                                                        \
+                    for ( uint32_t rank = 0; rank < writeSet->ranks_number; rank++ )                     \
+                    {                                                                                    \
+                        uint64_t offset = writeSet->offsets_per_rank[ rank ];                            \
+                        uint64_t items  = writeSet->items_per_rank[ rank ];                              \
+                        memcpy( &global_values[ offset ],                                                \
+                                &global_block[ offset * block_fill + block_index * items ],              \
+                                items * sizeof( type ) );                                                \
+                    }                                                                                    \
+                    cnode = cube_get_cnode( writeSet->my_cube,                                           \
+                                            block_callpaths[ block_index ] );                            \
+                    cube_write_sev_row_of_##cube_type( writeSet->my_cube, metric,                        \
+                                                       cnode, global_values );                           \
+                }                                                                                        \
             }                                                                                            \
         }                                                                                                \
                                                                                                          \
         /* Clean up */                                                                                   \
+        free( counts_per_rank );                                                                         \
+        free( global_block );                                                                            \
         free( global_values );                                                                           \
+        free( block_callpaths );                                                                         \
+        free( block_values );                                                                            \
         free( local_values );                                                                            \
         free( aggregated_values );                                                                       \
     }
@@ -1071,6 +1258,162 @@ cleanup:
     }
 }
 
+/**
+   Returns the lower bound of @a bucket in timer ticks. The bound of
+   SCOREP_PROFILE_HISTOGRAM_BUCKETS is the upper bound of the last bucket.
+ */
+static double
+get_histogram_bucket_bound( uint32_t bucket )
+{
+    if ( bucket == SCOREP_PROFILE_HISTOGRAM_BUCKETS )
+    {
+        return 2.0 * ( double )( UINT64_C( 1 ) << 63 );
+    }
+    return ( double )scorep_profile_get_histogram_lower_bound( bucket );
+}
+
+/**
+   Defines and writes the metrics of the inclusive time histograms: estimates
+   of the median and the 99th percentile per location, and the number of
+   visits per bucket, grouped by powers of two. Only the powers of two that
+   contain visits on any rank are written.
+   @param writeSet Structure containing write data.
+   @param comm     The communicator of the ranks that write the profile.
+ */
+static void
+write_time_histograms( scorep_cube_writing_data* writeSet,
+                       SCOREP_Ipc_Group*         comm )
+{
+    static const double percentiles[] = { 50.0, 99.0 };
+    const uint32_t      number_of_powers =
+        SCOREP_PROFILE_HISTOGRAM_BUCKETS / SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS;
+    cube_metric* metric = NULL; /* Only used on root */
+
+    /* Percentile estimates */
+    scorep_profile_percentile_data percentile_data;
+    percentile_data.write_set = writeSet;
+    percentile_data.histogram = malloc( SCOREP_PROFILE_HISTOGRAM_BUCKETS * sizeof( uint64_t ) );
+    UTILS_ASSERT( percentile_data.histogram );
+    for ( uint32_t i = 0; i < sizeof( percentiles ) / sizeof( percentiles[ 0 ] ); i++ )
+    {
+        if ( writeSet->my_rank == writeSet->root_rank )
+        {
+            char unique_name[ 32 ];
+            char display_name[ 64 ];
+            char description[ 128 ];
+            sprintf( unique_name, "time_p%g", percentiles[ i ] );
+            sprintf( display_name, "Inclusive Time P%g", percentiles[ i ] );
+            sprintf( description,
+                     "Estimated %gth percentile of the inclusive CPU allocation "
+                     "time of each location",
+                     percentiles[ i ] );
+            metric = cube_def_met( writeSet->my_cube, display_name, unique_name,
+                                   "MAXDOUBLE", "sec", "", "", description,
+                                   NULL, CUBE_METRIC_EXCLUSIVE );
+        }
+        percentile_data.percentile = percentiles[ i ];
+        write_cube_doubles( writeSet, comm, metric,
+                            &get_time_percentile, &percentile_data );
+    }
+    free( percentile_data.histogram );
+
+    /* Find the range of powers of two which contain visits */
+    uint32_t local_range[ 2 ] = { number_of_powers, 0 };
+    for ( uint64_t i = 0; i < ( uint64_t )writeSet->local_threads * writeSet->callpath_number; i++ )
+    {
+        scorep_profile_node* node = writeSet->id_2_node[ i ];
+        if ( node == NULL || node->time_histogram == NULL )
+        {
+            continue;
+        }
+        for ( uint32_t bucket = 0; bucket < SCOREP_PROFILE_HISTOGRAM_BUCKETS; bucket++ )
+        {
+            if ( node->time_histogram[ bucket ] == 0 )
+            {
+                continue;
+            }
+            uint32_t power = bucket / SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS;
+            if ( local_range[ 0 ] > power )
+            {
+                local_range[ 0 ] = power;
+            }
+            if ( local_range[ 1 ] < power )
+            {
+                local_range[ 1 ] = power;
+            }
+        }
+    }
+    uint32_t range[ 2 ];
+    SCOREP_IpcGroup_Allreduce( comm, &local_range[ 0 ], &range[ 0 ], 1,
+                               SCOREP_IPC_UINT32_T, SCOREP_IPC_MIN );
+    SCOREP_IpcGroup_Allreduce( comm, &local_range[ 1 ], &range[ 1 ], 1,
+                               SCOREP_IPC_UINT32_T, SCOREP_IPC_MAX );
+    if ( range[ 0 ] > range[ 1 ] )
+    {
+        return;
+    }
+
+    /* Bucket counts below a parent metric that has no values of its own */
+    cube_metric* parent = NULL;
+    if ( writeSet->my_rank == writeSet->root_rank )
+    {
+        parent = cube_def_met( writeSet->my_cube, "Inclusive Time Histogram",
+                               "time_histogram", "UINT64", "occ", "", "",
+                               "Number of visits per bucket of the inclusive time",
+                               NULL, CUBE_METRIC_EXCLUSIVE );
+    }
+    write_cube_uint64( writeSet, comm, parent, &get_zero_value, NULL );
+
+    /* Every power of two has a parent metric with the buckets below it */
+    double resolution = ( double )SCOREP_Timer_GetClockResolution();
+    for ( uint32_t power = range[ 0 ]; power <= range[ 1 ]; power++ )
+    {
+        uint32_t first_bucket = power * SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS;
+        uint32_t last_bucket  = first_bucket + SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS - 1;
+        char     unique_name[ 32 ];
+        char     display_name[ 64 ];
+        char     description[ 128 ];
+
+        cube_metric* power_metric = NULL;
+        if ( writeSet->my_rank == writeSet->root_rank )
+        {
+            double lower = get_histogram_bucket_bound( first_bucket ) / resolution;
+            double upper = get_histogram_bucket_bound( last_bucket + 1 ) / resolution;
+            sprintf( unique_name, "time_histogram_%" PRIu32, power );
+            sprintf( display_name, "[%.3g s, %.3g s)", lower, upper );
+            sprintf( description,
+                     "Number of visits with an inclusive time of at least %.3g s "
+                     "and less than %.3g s",
+                     lower, upper );
+            power_metric = cube_def_met( writeSet->my_cube, display_name, unique_name,
+                                         "UINT64", "occ", "", "", description,
+                                         parent, CUBE_METRIC_EXCLUSIVE );
+        }
+        write_cube_uint64( writeSet, comm, power_metric, &get_zero_value, NULL );
+
+        for ( uint32_t bucket = first_bucket; bucket <= last_bucket; bucket++ )
+        {
+            if ( writeSet->my_rank == writeSet->root_rank )
+            {
+                double lower = get_histogram_bucket_bound( bucket ) / resolution;
+                double upper = get_histogram_bucket_bound( bucket + 1 ) / resolution;
+                sprintf( unique_name, "time_histogram_%" PRIu32 "_%" PRIu32,
+                         power, bucket - first_bucket );
+                sprintf( display_name, "[%.3g s, %.3g s)", lower, upper );
+                sprintf( description,
+                         "Number of visits with an inclusive time of at least %.3g s "
+                         "and less than %.3g s",
+                         lower, upper );
+                metric = cube_def_met( writeSet->my_cube, display_name, unique_name,
+                                       "UINT64", "occ", "", "", description,
+                                       power_metric, CUBE_METRIC_EXCLUSIVE );
+            }
+            write_cube_uint64( writeSet, comm, metric,
+                               &get_histogram_bucket_value, &bucket );
+        }
+    }
+}
+
 /* *****************************************************************************
    Main writer function
 *******************************************************************************/
@@ -1249,6 +1592,21 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
         }
     }
 
+    /* Write the histograms of the inclusive time */
+    if ( scorep_profile_enable_time_histograms )
+    {
+        if ( layout.dense_metric_type == SCOREP_CUBE_DATA_TUPLE )
+        {
+            UTILS_WARN_ONCE( "The inclusive time histograms are not written in "
+                             "the thread_tuple profile format." );
+        }
+        else
+        {
+            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PROFILE, "Writing time histograms" );
+            write_time_histograms( &write_set, comm );
+        }
+    }
+
     /* -------------------------------- sparse metrics */
 
     /* Write sparse metrics (e.g. user metrics) */
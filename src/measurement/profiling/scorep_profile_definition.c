@@ -56,8 +56,10 @@
 
 extern uint64_t scorep_profile_task_exchange_num;
 extern uint64_t scorep_profile_max_callpath_depth;
+extern uint64_t scorep_profile_child_index_threshold;
 extern char*    scorep_profile_basename;
 extern uint64_t scorep_profile_output_format;
+extern uint64_t scorep_profile_cube_write_buffer_size;
 extern uint64_t scorep_profile_cluster_count;
 extern uint64_t scorep_profile_cluster_mode;
 extern char*    scorep_profile_clustered_region;
@@ -150,6 +152,12 @@ scorep_profile_get_task_exchange_num( void )
     return scorep_profile_task_exchange_num;
 }
 
+uint64_t
+scorep_profile_get_child_index_threshold( void )
+{
+    return scorep_profile_child_index_threshold;
+}
+
 const char*
 scorep_profile_get_basename( void )
 {
@@ -162,6 +170,12 @@ scorep_profile_get_output_format( void )
     return scorep_profile_output_format;
 }
 
+uint64_t
+scorep_profile_get_cube_write_buffer_size( void )
+{
+    return scorep_profile_cube_write_buffer_size;
+}
+
 uint64_t
 scorep_profile_get_cluster_count( void )
 {
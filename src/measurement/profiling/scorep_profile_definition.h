@@ -156,6 +156,12 @@ scorep_profile_delete_definition( void );
 uint64_t
 scorep_profile_get_task_exchange_num( void );
 
+/**
+   Returns the configuration value for SCOREP_PROFILING_CHILD_INDEX_THRESHOLD.
+ */
+uint64_t
+scorep_profile_get_child_index_threshold( void );
+
 /**
    Returns the configuration value for SCOREP_PROFILE_BASENAME.
  */
@@ -168,6 +174,12 @@ scorep_profile_get_basename( void );
 uint64_t
 scorep_profile_get_output_format( void );
 
+/**
+   Returns the configuration value for SCOREP_PROFILING_CUBE_WRITE_BUFFER.
+ */
+uint64_t
+scorep_profile_get_cube_write_buffer_size( void );
+
 /**
    Returns the configuration value for SCOREP_PROFILE_CLUSTER_COUNT.
  */
@@ -165,6 +165,12 @@ scorep_profile_exit( SCOREP_Profile_LocationData* location,
 
         /* Update metrics */
         node->last_exit_time = timestamp;
+        if ( node->time_histogram != NULL )
+        {
+            scorep_profile_update_histogram( node->time_histogram,
+                                             timestamp - node->inclusive_time.start_value
+                                             + node->inclusive_time.intermediate_sum );
+        }
         scorep_profile_update_dense_metric( &node->inclusive_time, timestamp );
         for ( uint32_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
         {
@@ -0,0 +1,430 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * @brief Publishes live profile snapshots in POSIX shared memory.
+ *
+ * The call tree of a location is only modified by the location itself. Thus,
+ * the location also writes its snapshot, without any locking. It writes
+ * into the inactive one of the two buffers of its segment and activates it
+ * afterwards, while readers copy the active buffer. The sequence number of
+ * a buffer is odd while it is written, which lets a reader detect that the
+ * writer refreshed twice during its copy.
+ */
+
+#include <config.h>
+
+#include "scorep_profile_live.h"
+
+#include <SCOREP_Profile_Live.h>
+#include <SCOREP_Atomic.h>
+#include <SCOREP_Definitions.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_Memory.h>
+#include <SCOREP_Metric_Management.h>
+#include <SCOREP_Timer_Ticks.h>
+#include <scorep_status.h>
+
+#define SCOREP_DEBUG_MODULE_NAME PROFILE
+#include <UTILS_Debug.h>
+#include <UTILS_Error.h>
+
+#include "scorep_profile_location.h"
+#include "scorep_profile_node.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* The buffers start at cache-line boundaries */
+#define LIVE_ALIGNMENT 64
+#define LIVE_ALIGN( size ) ( ( ( size ) + LIVE_ALIGNMENT - 1 ) & ~( uint64_t )( LIVE_ALIGNMENT - 1 ) )
+
+/* Reference points to estimate the timer resolution, which is only known
+   after the measurement */
+static uint64_t live_start_ticks;
+static uint64_t live_start_nanoseconds;
+
+struct scorep_profile_live_segment
+{
+    SCOREP_Profile_LiveHeader* header;       /**< Mapped segment, NULL if not available */
+    size_t                     size;         /**< Size of the mapping */
+    uint64_t                   next_refresh; /**< Earliest timestamp of the next timed refresh */
+    scorep_profile_node**      stack;        /**< Nodes on the call stack, the root first */
+    uint32_t                   stack_capacity;
+    char                       name[ 64 ];   /**< Name of the segment */
+};
+
+/* State of one refresh */
+typedef struct
+{
+    SCOREP_Profile_LiveHeader* header;
+    SCOREP_Profile_LiveBuffer* buffer;
+    scorep_profile_node**      stack;
+    uint32_t                   stack_depth;
+    uint32_t                   number_of_metrics;
+    uint64_t                   timestamp;
+    const uint64_t*            metrics;
+} live_writer;
+
+
+static uint64_t
+get_nanoseconds( void )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( uint64_t )now.tv_sec * UINT64_C( 1000000000 ) + now.tv_nsec;
+}
+
+
+void
+scorep_profile_live_initialize( void )
+{
+    live_start_ticks       = SCOREP_Timer_GetClockTicks();
+    live_start_nanoseconds = get_nanoseconds();
+}
+
+
+static bool
+create_segment( SCOREP_Profile_LocationData* location,
+                scorep_profile_live_segment* segment )
+{
+    uint32_t number_of_metrics = SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics();
+    uint64_t record_size       = sizeof( SCOREP_Profile_LiveRecord )
+                                 + number_of_metrics * sizeof( uint64_t );
+    uint64_t buffer_size = SCOREP_Profile_LiveBufferSize( scorep_profile_live_snapshot_callpaths,
+                                                          record_size );
+    uint64_t first_offset = LIVE_ALIGN( sizeof( SCOREP_Profile_LiveHeader )
+                                        + number_of_metrics * SCOREP_PROFILE_LIVE_NAME_LENGTH );
+    uint64_t second_offset = first_offset + LIVE_ALIGN( buffer_size );
+    segment->size = second_offset + buffer_size;
+
+    snprintf( segment->name, sizeof( segment->name ),
+              "/" SCOREP_PROFILE_LIVE_PREFIX "%" PRIu64 "-%" PRIu32,
+              ( uint64_t )getpid(), SCOREP_Location_GetId( location->location_data ) );
+
+    /* Remove a left-over segment of an earlier process with the same pid */
+    shm_unlink( segment->name );
+    int fd = shm_open( segment->name, O_CREAT | O_EXCL | O_RDWR,
+                       S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
+    if ( fd == -1 )
+    {
+        UTILS_ERROR_POSIX( "Cannot create live profile segment '%s'", segment->name );
+        return false;
+    }
+    if ( ftruncate( fd, segment->size ) != 0 )
+    {
+        UTILS_ERROR_POSIX( "Cannot resize live profile segment '%s'", segment->name );
+        close( fd );
+        shm_unlink( segment->name );
+        return false;
+    }
+    void* mapping = mmap( NULL, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( mapping == MAP_FAILED )
+    {
+        UTILS_ERROR_POSIX( "Cannot map live profile segment '%s'", segment->name );
+        shm_unlink( segment->name );
+        return false;
+    }
+
+    /* The mapping is zero-initialized, thus both buffers are empty and even */
+    SCOREP_Profile_LiveHeader* header = mapping;
+    header->version            = SCOREP_PROFILE_LIVE_VERSION;
+    header->number_of_metrics  = number_of_metrics;
+    header->pid                = getpid();
+    header->rank               = -1;
+    header->location_id        = SCOREP_Location_GetId( location->location_data );
+    header->max_records        = scorep_profile_live_snapshot_callpaths;
+    header->record_size        = record_size;
+    header->buffer_offset[ 0 ] = first_offset;
+    header->buffer_offset[ 1 ] = second_offset;
+    header->active_buffer      = 0;
+    strncpy( header->location_name, SCOREP_Location_GetName( location->location_data ),
+             SCOREP_PROFILE_LIVE_NAME_LENGTH - 1 );
+    for ( uint32_t i = 0; i < number_of_metrics; i++ )
+    {
+        SCOREP_MetricHandle metric = SCOREP_Metric_GetStrictlySynchronousMetricHandle( i );
+        strncpy( ( char* )SCOREP_Profile_LiveMetricName( header, i ),
+                 SCOREP_MetricHandle_GetName( metric ),
+                 SCOREP_PROFILE_LIVE_NAME_LENGTH - 1 );
+    }
+    SCOREP_ATOMIC_STORE( &header->magic, SCOREP_PROFILE_LIVE_MAGIC, SCOREP_ATOMIC_RELEASE );
+
+    segment->header = header;
+    return true;
+}
+
+
+/* Returns true if @a node is on the call stack */
+static inline bool
+is_active( const live_writer*   writer,
+           scorep_profile_node* node,
+           uint32_t             treeDepth )
+{
+    return treeDepth < writer->stack_depth && writer->stack[ treeDepth ] == node;
+}
+
+
+/* Returns the inclusive time of @a node, including the time since the
+   current visit started, if the node is on the call stack */
+static uint64_t
+get_inclusive_time( const live_writer*   writer,
+                    scorep_profile_node* node,
+                    uint32_t             treeDepth )
+{
+    uint64_t time = node->inclusive_time.sum;
+    if ( is_active( writer, node, treeDepth ) &&
+         writer->timestamp > node->inclusive_time.start_value )
+    {
+        time += writer->timestamp - node->inclusive_time.start_value;
+    }
+    return time;
+}
+
+
+static void
+get_name( scorep_profile_node* node,
+          char*                name )
+{
+    switch ( node->node_type )
+    {
+        case SCOREP_PROFILE_NODE_REGULAR_REGION:
+        case SCOREP_PROFILE_NODE_TASK_ROOT:
+            strncpy( name,
+                     SCOREP_RegionHandle_GetName( scorep_profile_type_get_region_handle( node->type_specific_data ) ),
+                     SCOREP_PROFILE_LIVE_NAME_LENGTH - 1 );
+            break;
+        case SCOREP_PROFILE_NODE_PARAMETER_STRING:
+            snprintf( name, SCOREP_PROFILE_LIVE_NAME_LENGTH, "%s=%s",
+                      SCOREP_ParameterHandle_GetName( scorep_profile_type_get_parameter_handle( node->type_specific_data ) ),
+                      SCOREP_StringHandle_Get( scorep_profile_type_get_string_handle( node->type_specific_data ) ) );
+            break;
+        case SCOREP_PROFILE_NODE_PARAMETER_INTEGER:
+            snprintf( name, SCOREP_PROFILE_LIVE_NAME_LENGTH, "%s=%" PRIi64,
+                      SCOREP_ParameterHandle_GetName( scorep_profile_type_get_parameter_handle( node->type_specific_data ) ),
+                      ( int64_t )scorep_profile_type_get_int_value( node->type_specific_data ) );
+            break;
+        case SCOREP_PROFILE_NODE_COLLAPSE:
+            strncpy( name, "COLLAPSE", SCOREP_PROFILE_LIVE_NAME_LENGTH - 1 );
+            break;
+        default:
+            name[ 0 ] = '\0';
+    }
+}
+
+
+static uint64_t
+count_nodes( scorep_profile_node* node )
+{
+    uint64_t count = 0;
+    for ( ; node != NULL; node = node->next_sibling )
+    {
+        count += 1 + count_nodes( node->first_child );
+    }
+    return count;
+}
+
+
+/* Appends records for @a node, its siblings and their subtrees. Thread root
+   and thread start nodes are not published, but their children. */
+static void
+write_nodes( live_writer*         writer,
+             scorep_profile_node* node,
+             uint32_t             treeDepth,
+             int64_t              parent,
+             uint64_t             depth,
+             uint64_t             parentId )
+{
+    for ( ; node != NULL; node = node->next_sibling )
+    {
+        if ( node->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT ||
+             node->node_type == SCOREP_PROFILE_NODE_THREAD_START )
+        {
+            write_nodes( writer, node->first_child, treeDepth + 1, parent, depth, parentId );
+            continue;
+        }
+
+        SCOREP_Profile_LiveBuffer* buffer = writer->buffer;
+        if ( buffer->number_of_records == writer->header->max_records )
+        {
+            buffer->dropped_records += 1 + count_nodes( node->first_child );
+            continue;
+        }
+
+        uint64_t                   index  = buffer->number_of_records++;
+        SCOREP_Profile_LiveRecord* record = SCOREP_Profile_LiveGetRecord( writer->header, buffer, index );
+        record->callpath_id = ( parentId ^ scorep_profile_node_hash( node ) ) * UINT64_C( 0x100000001b3 );
+        record->parent      = parent;
+        record->depth       = depth;
+        record->visits      = node->count;
+        get_name( node, record->name );
+
+        uint64_t inclusive     = get_inclusive_time( writer, node, treeDepth );
+        uint64_t children_time = 0;
+        for ( scorep_profile_node* child = node->first_child; child != NULL; child = child->next_sibling )
+        {
+            children_time += get_inclusive_time( writer, child, treeDepth + 1 );
+        }
+        record->inclusive_time = inclusive;
+        record->exclusive_time = inclusive > children_time ? inclusive - children_time : 0;
+
+        uint64_t* metrics = SCOREP_Profile_LiveGetMetrics( record );
+        bool      active  = is_active( writer, node, treeDepth );
+        for ( uint32_t i = 0; i < writer->number_of_metrics; i++ )
+        {
+            metrics[ i ] = node->dense_metrics[ i ].sum;
+            if ( active && writer->metrics[ i ] > node->dense_metrics[ i ].start_value )
+            {
+                metrics[ i ] += writer->metrics[ i ] - node->dense_metrics[ i ].start_value;
+            }
+        }
+
+        write_nodes( writer, node->first_child, treeDepth + 1,
+                     ( int64_t )index, depth + 1, record->callpath_id );
+    }
+}
+
+
+static void
+refresh( SCOREP_Profile_LocationData* location,
+         scorep_profile_live_segment* segment,
+         uint64_t                     timestamp,
+         uint64_t                     resolution,
+         const uint64_t*              metrics )
+{
+    live_writer writer;
+    writer.header            = segment->header;
+    writer.timestamp         = timestamp;
+    writer.metrics           = metrics;
+    writer.number_of_metrics = metrics != NULL ? segment->header->number_of_metrics : 0;
+
+    /* Remember the call stack, to add the running time of its nodes */
+    uint32_t             depth   = 0;
+    scorep_profile_node* current = scorep_profile_get_current_node( location );
+    for ( scorep_profile_node* node = current; node != NULL; node = node->parent )
+    {
+        depth++;
+    }
+    if ( depth > segment->stack_capacity )
+    {
+        segment->stack_capacity = depth + 16;
+        segment->stack          = realloc( segment->stack,
+                                           segment->stack_capacity * sizeof( *segment->stack ) );
+        UTILS_BUG_ON( segment->stack == NULL, "Cannot allocate call stack for live profile" );
+    }
+    writer.stack       = segment->stack;
+    writer.stack_depth = depth;
+    for ( scorep_profile_node* node = current; node != NULL; node = node->parent )
+    {
+        segment->stack[ --depth ] = node;
+    }
+
+    SCOREP_Profile_LiveHeader* header = segment->header;
+    if ( header->rank == -1 && SCOREP_Status_IsMppInitialized() )
+    {
+        header->rank = SCOREP_Status_GetRank();
+    }
+
+    uint64_t active = header->active_buffer;
+    writer.buffer = SCOREP_Profile_LiveGetBuffer( header, 1 - active );
+    uint64_t sequence = writer.buffer->sequence;
+    SCOREP_ATOMIC_STORE( &writer.buffer->sequence, sequence + 1, SCOREP_ATOMIC_RELAXED );
+    SCOREP_ATOMIC_THREAD_FENCE( SCOREP_ATOMIC_RELEASE );
+
+    writer.buffer->timestamp         = timestamp;
+    writer.buffer->timer_resolution  = resolution;
+    writer.buffer->wallclock         = ( uint64_t )time( NULL );
+    writer.buffer->number_of_records = 0;
+    writer.buffer->dropped_records   = 0;
+    write_nodes( &writer, location->root_node, 0, -1, 0, 0 );
+
+    SCOREP_ATOMIC_STORE( &writer.buffer->sequence, sequence + 2, SCOREP_ATOMIC_RELEASE );
+    SCOREP_ATOMIC_STORE( &header->active_buffer, 1 - active, SCOREP_ATOMIC_RELEASE );
+}
+
+
+void
+scorep_profile_live_on_exit( SCOREP_Profile_LocationData* location,
+                             uint64_t                     timestamp,
+                             SCOREP_RegionType            regionType,
+                             const uint64_t*              metrics )
+{
+    scorep_profile_live_segment* segment = location->live_segment;
+    bool                         phase   = regionType == SCOREP_REGION_PHASE ||
+                                           regionType == SCOREP_REGION_DYNAMIC_PHASE ||
+                                           regionType == SCOREP_REGION_DYNAMIC_LOOP_PHASE;
+
+    if ( segment != NULL && !phase &&
+         ( scorep_profile_live_snapshot_interval == 0 || timestamp < segment->next_refresh ) )
+    {
+        return;
+    }
+
+    if ( segment == NULL )
+    {
+        segment = SCOREP_Location_AllocForMisc( location->location_data, sizeof( *segment ) );
+        memset( segment, 0, sizeof( *segment ) );
+        location->live_segment = segment;
+        if ( !create_segment( location, segment ) )
+        {
+            /* Do not try again */
+            segment->next_refresh = UINT64_MAX;
+            return;
+        }
+    }
+    if ( segment->header == NULL )
+    {
+        return;
+    }
+
+    uint64_t elapsed    = get_nanoseconds() - live_start_nanoseconds;
+    uint64_t resolution = 0;
+    if ( elapsed > 0 && timestamp > live_start_ticks )
+    {
+        resolution = ( uint64_t )( ( double )( timestamp - live_start_ticks ) * 1e9 / elapsed );
+    }
+
+    refresh( location, segment, timestamp, resolution, metrics );
+    segment->next_refresh = timestamp
+                            + scorep_profile_live_snapshot_interval * resolution / 1000;
+}
+
+
+void
+scorep_profile_live_delete( SCOREP_Profile_LocationData* location )
+{
+    if ( location == NULL || location->live_segment == NULL )
+    {
+        return;
+    }
+
+    scorep_profile_live_segment* segment = location->live_segment;
+    if ( segment->header != NULL )
+    {
+        munmap( segment->header, segment->size );
+        shm_unlink( segment->name );
+        segment->header = NULL;
+    }
+    free( segment->stack );
+    segment->stack          = NULL;
+    segment->stack_capacity = 0;
+    location->live_segment  = NULL;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCOREP_PROFILE_LIVE_SNAPSHOT_H
+#define SCOREP_PROFILE_LIVE_SNAPSHOT_H
+
+/**
+ * @file
+ *
+ * @brief Publishes live profile snapshots in POSIX shared memory.
+ *
+ * Each location refreshes its own segment on region exits, if the exited
+ * region is a phase or if SCOREP_PROFILING_LIVE_SNAPSHOT_INTERVAL elapsed
+ * since the last refresh. The layout is described in SCOREP_Profile_Live.h.
+ */
+
+#include <SCOREP_Types.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct SCOREP_Profile_LocationData;
+
+/**
+ * Per-location state of the live snapshots.
+ */
+typedef struct scorep_profile_live_segment scorep_profile_live_segment;
+
+/**
+   Stores whether the live snapshots are enabled.
+ */
+extern bool scorep_profile_enable_live_snapshots;
+
+/**
+   Minimum time between two timed refreshes in milliseconds.
+ */
+extern uint64_t scorep_profile_live_snapshot_interval;
+
+/**
+   Maximum number of call paths in a snapshot.
+ */
+extern uint64_t scorep_profile_live_snapshot_callpaths;
+
+/**
+ * Records the reference points to estimate the timer resolution during the
+ * measurement. Called during the initialization of the profiling substrate.
+ */
+void
+scorep_profile_live_initialize( void );
+
+/**
+ * Refreshes the segment of @a location, if @a regionType is a phase or the
+ * refresh interval elapsed. Creates the segment on the first call.
+ *
+ * @param location   The location whose call tree is published.
+ * @param timestamp  Timestamp of the exit event.
+ * @param regionType Type of the exited region.
+ * @param metrics    Dense metric values of the exit event.
+ */
+void
+scorep_profile_live_on_exit( struct SCOREP_Profile_LocationData* location,
+                             uint64_t                            timestamp,
+                             SCOREP_RegionType                   regionType,
+                             const uint64_t*                     metrics );
+
+/**
+ * Unmaps and removes the segment of @a location.
+ */
+void
+scorep_profile_live_delete( struct SCOREP_Profile_LocationData* location );
+
+#endif /* SCOREP_PROFILE_LIVE_SNAPSHOT_H */
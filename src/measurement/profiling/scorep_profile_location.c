@@ -44,6 +44,7 @@
 #include <UTILS_Error.h>
 
 #include <assert.h>
+#include <stdlib.h>
 
 /* **************************************************************************************
  *                                                              Local types and variables
@@ -132,6 +133,10 @@ scorep_profile_finalize_location( SCOREP_Profile_LocationData* location )
     location->foreign_stubs         = NULL;
     location->num_foreign_tasks     = 0;
     location->num_foreign_stubs     = 0;
+    free( location->child_index );
+    location->child_index           = NULL;
+    location->child_index_capacity  = 0;
+    location->child_index_size      = 0;
 }
 
 
@@ -169,10 +174,14 @@ scorep_profile_create_location_data( SCOREP_Location* locationData )
     location->free_stubs            = NULL;
     location->num_foreign_tasks     = 0;
     location->num_foreign_stubs     = 0;
+    location->child_index           = NULL;
+    location->child_index_capacity  = 0;
+    location->child_index_size      = 0;
     location->location_data         = locationData;
     location->migration_sum         = 1;
     location->migration_win         = 0;
     location->current_io_paradigm   = NULL;
+    location->live_segment          = NULL;
 
     scorep_profile_io_init_location( location );
 
@@ -71,6 +71,9 @@ struct SCOREP_Profile_LocationData
     scorep_profile_node*                 free_stubs;               /**< List of stubs for recycling */
     scorep_profile_node*                 foreign_stubs;            /**< List of stubs from other locations */
     uint32_t                             num_foreign_stubs;        /**< Number of objects in @a foreign_stubs */
+    scorep_profile_child_index_entry*    child_index;              /**< Hash table of children of wide nodes */
+    uint32_t                             child_index_capacity;     /**< Number of slots in @a child_index */
+    uint32_t                             child_index_size;         /**< Number of used slots in @a child_index */
 
     scorep_profile_node*                 current_task_node;        /**< Callpath node of the current task */
     struct scorep_profile_task*          current_task;             /**< Current task instance */
@@ -84,6 +87,7 @@ struct SCOREP_Profile_LocationData
     scorep_profile_fork_list_node*       fork_list_head;           /**< Pointer to the list head of fork points */
     scorep_profile_fork_list_node*       fork_list_tail;           /**< Pointer to the list tail of fork points */
     struct scorep_profile_io_paradigm*   current_io_paradigm;
+    struct scorep_profile_live_segment*  live_segment;             /**< Live snapshot of this location, if enabled */
 };
 
 /**
@@ -38,6 +38,7 @@
 
 #include <config.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "SCOREP_Memory.h"
 
@@ -423,3 +424,138 @@ scorep_profile_merge_sparse_metric_double( scorep_profile_sparse_metric_double*
     }
     destination->squares += source->squares;
 }
+
+/* ***************************************************************************************
+   Inclusive time histograms
+*****************************************************************************************/
+
+/* Returns the bucket of a log-linear histogram for a value */
+uint32_t
+scorep_profile_get_histogram_bucket( uint64_t value )
+{
+    if ( value < SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS )
+    {
+        return ( uint32_t )value;
+    }
+
+    /* Position of the highest set bit */
+    uint32_t exponent = 0;
+    for ( uint32_t shift = 32; shift > 0; shift /= 2 )
+    {
+        if ( value >> ( exponent + shift ) )
+        {
+            exponent += shift;
+        }
+    }
+
+    uint32_t shift = exponent - SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS;
+    return ( ( shift + 1 ) << SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS )
+           + ( uint32_t )( ( value >> shift ) & ( SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS - 1 ) );
+}
+
+/* Returns the smallest value of a bucket */
+uint64_t
+scorep_profile_get_histogram_lower_bound( uint32_t bucket )
+{
+    if ( bucket < SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS )
+    {
+        return bucket;
+    }
+
+    uint32_t shift = ( bucket >> SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS ) - 1;
+    uint64_t sub   = bucket & ( SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS - 1 );
+    return ( SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS + sub ) << shift;
+}
+
+/* Sets all buckets of a histogram to zero */
+void
+scorep_profile_init_histogram( uint64_t* histogram )
+{
+    memset( histogram, 0, SCOREP_PROFILE_HISTOGRAM_BUCKETS * sizeof( uint64_t ) );
+}
+
+/* Counts a duration in a histogram */
+void
+scorep_profile_update_histogram( uint64_t* histogram,
+                                 uint64_t  value )
+{
+    histogram[ scorep_profile_get_histogram_bucket( value ) ]++;
+}
+
+/* Copies a histogram */
+void
+scorep_profile_copy_histogram( uint64_t*       destination,
+                               const uint64_t* source )
+{
+    memcpy( destination, source, SCOREP_PROFILE_HISTOGRAM_BUCKETS * sizeof( uint64_t ) );
+}
+
+/* Adds the buckets of a histogram to another histogram */
+void
+scorep_profile_merge_histogram( uint64_t*       destination,
+                                const uint64_t* source )
+{
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_HISTOGRAM_BUCKETS; i++ )
+    {
+        destination[ i ] += source[ i ];
+    }
+}
+
+/* Subtracts the buckets of a histogram from another histogram */
+void
+scorep_profile_subtract_histogram( uint64_t*       minuend,
+                                   const uint64_t* subtrahend )
+{
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_HISTOGRAM_BUCKETS; i++ )
+    {
+        minuend[ i ] -= subtrahend[ i ];
+    }
+}
+
+/* Estimates a percentile from a histogram */
+uint64_t
+scorep_profile_get_histogram_percentile( const uint64_t* histogram,
+                                         double          percentile,
+                                         uint64_t        min,
+                                         uint64_t        max )
+{
+    uint64_t count = 0;
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_HISTOGRAM_BUCKETS; i++ )
+    {
+        count += histogram[ i ];
+    }
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    /* Number of durations which are smaller or equal to the percentile */
+    uint64_t rank = ( uint64_t )( percentile / 100.0 * ( double )count + 0.5 );
+    if ( rank == 0 )
+    {
+        rank = 1;
+    }
+
+    uint32_t bucket = 0;
+    uint64_t seen   = histogram[ 0 ];
+    while ( seen < rank && bucket + 1 < SCOREP_PROFILE_HISTOGRAM_BUCKETS )
+    {
+        bucket++;
+        seen += histogram[ bucket ];
+    }
+
+    uint64_t lower = scorep_profile_get_histogram_lower_bound( bucket );
+    uint64_t upper = bucket + 1 < SCOREP_PROFILE_HISTOGRAM_BUCKETS
+                     ? scorep_profile_get_histogram_lower_bound( bucket + 1 )
+                     : UINT64_MAX;
+    uint64_t value = lower + ( upper - lower ) / 2;
+    if ( value < min )
+    {
+        value = min;
+    }
+    if ( value > max )
+    {
+        value = max;
+    }
+    return value;
+}
@@ -38,6 +38,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <SCOREP_Types.h>
@@ -281,5 +282,110 @@ void
 scorep_profile_merge_sparse_metric_double( scorep_profile_sparse_metric_double* destination,
                                            scorep_profile_sparse_metric_double* source );
 
+/* ***************************************************************************************
+   Functions for inclusive time histograms.
+*****************************************************************************************/
+
+/**
+   Number of bits of a duration that select the bucket within one power of two. Each
+   power of two is divided into 2^SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS buckets,
+   which limits the relative width of a bucket to 25%.
+ */
+#define SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS 2
+
+/**
+   Number of buckets per power of two.
+ */
+#define SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS ( 1 << SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS )
+
+/**
+   Number of buckets of a histogram, which covers all 64 bit durations.
+ */
+#define SCOREP_PROFILE_HISTOGRAM_BUCKETS \
+    ( ( 64 - SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS + 1 ) * SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS )
+
+/**
+   Stores whether a histogram of the inclusive time is recorded for every node.
+ */
+extern bool scorep_profile_enable_time_histograms;
+
+/**
+   Returns the bucket of a log-linear histogram for @a value. Values below
+   SCOREP_PROFILE_HISTOGRAM_SUB_BUCKETS have a bucket each, larger values share a bucket
+   with all values that have the same highest SCOREP_PROFILE_HISTOGRAM_SUB_BUCKET_BITS + 1
+   bits.
+   @param value The recorded duration.
+ */
+uint32_t
+scorep_profile_get_histogram_bucket( uint64_t value );
+
+/**
+   Returns the smallest value that falls into @a bucket.
+   @param bucket A bucket index smaller than SCOREP_PROFILE_HISTOGRAM_BUCKETS.
+ */
+uint64_t
+scorep_profile_get_histogram_lower_bound( uint32_t bucket );
+
+/**
+   Sets all buckets of @a histogram to zero.
+   @param histogram Pointer to an array of SCOREP_PROFILE_HISTOGRAM_BUCKETS counters.
+ */
+void
+scorep_profile_init_histogram( uint64_t* histogram );
+
+/**
+   Counts @a value in @a histogram.
+   @param histogram Pointer to the histogram which is updated.
+   @param value     The duration of the visit.
+ */
+void
+scorep_profile_update_histogram( uint64_t* histogram,
+                                 uint64_t  value );
+
+/**
+   Copies the buckets of @a source to @a destination.
+   @param destination Pointer to the histogram which is overwritten.
+   @param source      Pointer to the histogram which is copied.
+ */
+void
+scorep_profile_copy_histogram( uint64_t*       destination,
+                               const uint64_t* source );
+
+/**
+   Adds the buckets of @a source to @a destination. Because the bucket boundaries are
+   the same for all histograms, the result is the histogram of all durations that were
+   counted in either of them.
+   @param destination Pointer to the histogram to which the buckets are added.
+   @param source      Pointer to the histogram which buckets are added.
+ */
+void
+scorep_profile_merge_histogram( uint64_t*       destination,
+                                const uint64_t* source );
+
+/**
+   Subtracts the buckets of @a subtrahend from @a minuend. All durations counted in
+   @a subtrahend must be counted in @a minuend, too.
+   @param minuend    Pointer to the histogram from which the buckets are subtracted.
+   @param subtrahend Pointer to the histogram which buckets are subtracted.
+ */
+void
+scorep_profile_subtract_histogram( uint64_t*       minuend,
+                                   const uint64_t* subtrahend );
+
+/**
+   Estimates a percentile of the durations counted in @a histogram. Returns the middle
+   of the bucket that contains the requested percentile, limited to the range of
+   @a min and @a max, which are the exact extremes of the durations.
+   @param histogram  Pointer to the histogram.
+   @param percentile The requested percentile between 0 and 100.
+   @param min        The smallest counted duration.
+   @param max        The largest counted duration.
+   @returns the estimated percentile or 0 if @a histogram is empty.
+ */
+uint64_t
+scorep_profile_get_histogram_percentile( const uint64_t* histogram,
+                                         double          percentile,
+                                         uint64_t        min,
+                                         uint64_t        max );
 
 #endif /* SCOREP_PROFILE_METRIC_H */
@@ -41,6 +41,9 @@
 
 #include <config.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
 #include <string.h>
 #include <assert.h>
 
@@ -92,6 +95,10 @@ scorep_profile_create_node( SCOREP_Profile_LocationData* location,
     scorep_profile_init_dense_metric( &node->inclusive_time );
     scorep_profile_init_dense_metric_array( node->dense_metrics,
                                             SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics() );
+    if ( node->time_histogram != NULL )
+    {
+        scorep_profile_init_histogram( node->time_histogram );
+    }
 
     return node;
 }
@@ -186,6 +193,8 @@ scorep_profile_release_subtree( SCOREP_Profile_LocationData* location,
     }
     else
     {
+        /* Invalidate possible entries in the child index */
+        root->parent         = NULL;
         root->first_child    = location->free_nodes;
         location->free_nodes = root;
     }
@@ -256,6 +265,14 @@ scorep_profile_alloc_node( SCOREP_Profile_LocationData* location,
         new_node->dense_metrics = NULL;
     }
 
+    /* Reserve space for the time histogram, the same way as for dense metrics */
+    if ( scorep_profile_enable_time_histograms )
+    {
+        new_node->time_histogram = ( uint64_t* )
+                                   SCOREP_Location_AllocForProfile( location->location_data,
+                                                                    SCOREP_PROFILE_HISTOGRAM_BUCKETS * sizeof( uint64_t ) );
+    }
+
     scorep_profile_set_task_context( new_node, context );
 
     return new_node;
@@ -328,6 +345,10 @@ scorep_profile_copy_all_dense_metrics( scorep_profile_node* destination,
 
     /* Copy dense metric values */
     scorep_profile_copy_dense_metric( &destination->inclusive_time, &source->inclusive_time );
+    if ( destination->time_histogram != NULL && source->time_histogram != NULL )
+    {
+        scorep_profile_copy_histogram( destination->time_histogram, source->time_histogram );
+    }
     for ( uint32_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         scorep_profile_copy_dense_metric( &destination->dense_metrics[ i ],
@@ -517,6 +538,158 @@ scorep_profile_find_child( scorep_profile_node* parent,
     return child;
 }
 
+/* ***************************************************************************************
+   Child index
+*****************************************************************************************/
+
+/** Initial number of slots in the child index of a location */
+#define SCOREP_PROFILE_CHILD_INDEX_INITIAL_CAPACITY 256
+
+static inline uint64_t
+child_index_hash( scorep_profile_node*       parent,
+                  scorep_profile_node_type   nodeType,
+                  scorep_profile_type_data_t specificData )
+{
+    uint64_t val = ( uint64_t )( uintptr_t )parent;
+    val += ( ( uint64_t )nodeType << 56 ) +
+           scorep_profile_hash_for_type_data( specificData, nodeType );
+
+    /* Finalizer of MurmurHash3, the type data hashes are mostly small handles */
+    val ^= val >> 33;
+    val *= UINT64_C( 0xff51afd7ed558ccd );
+    val ^= val >> 33;
+    val *= UINT64_C( 0xc4ceb9fe1a85ec53 );
+    val ^= val >> 33;
+    return val;
+}
+
+static scorep_profile_node*
+child_index_lookup( SCOREP_Profile_LocationData* location,
+                    scorep_profile_node*         parent,
+                    scorep_profile_node_type     nodeType,
+                    scorep_profile_type_data_t   specificData )
+{
+    if ( location->child_index == NULL )
+    {
+        return NULL;
+    }
+
+    uint32_t mask = location->child_index_capacity - 1;
+    uint32_t slot = child_index_hash( parent, nodeType, specificData ) & mask;
+    while ( location->child_index[ slot ].child != NULL )
+    {
+        scorep_profile_child_index_entry* entry = &location->child_index[ slot ];
+        scorep_profile_node*              child = entry->child;
+
+        /* Entries whose child was moved or released are skipped */
+        if ( ( entry->parent == parent ) &&
+             ( child->parent == parent ) &&
+             ( child->node_type == nodeType ) &&
+             scorep_profile_compare_type_data( specificData,
+                                               child->type_specific_data,
+                                               nodeType ) )
+        {
+            return child;
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+    return NULL;
+}
+
+static void
+child_index_put( scorep_profile_child_index_entry* table,
+                 uint32_t                          capacity,
+                 scorep_profile_node*              parent,
+                 scorep_profile_node*              child )
+{
+    uint32_t mask = capacity - 1;
+    uint32_t slot = child_index_hash( parent,
+                                      child->node_type,
+                                      child->type_specific_data ) & mask;
+    while ( table[ slot ].child != NULL )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+    table[ slot ].parent = parent;
+    table[ slot ].child  = child;
+}
+
+/**
+   Doubles the capacity of the child index of @a location. Stale entries are dropped
+   during rehashing. The table is allocated with malloc, because the profile memory
+   cannot release single allocations, and the retired table would otherwise stay
+   until the profile memory is freed. If no memory is available, the index keeps
+   its current capacity.
+ */
+static void
+child_index_grow( SCOREP_Profile_LocationData* location )
+{
+    uint32_t new_capacity = location->child_index_capacity * 2;
+    if ( new_capacity == 0 )
+    {
+        new_capacity = SCOREP_PROFILE_CHILD_INDEX_INITIAL_CAPACITY;
+    }
+
+    scorep_profile_child_index_entry* new_table =
+        calloc( new_capacity, sizeof( *new_table ) );
+    if ( new_table == NULL )
+    {
+        UTILS_ERROR_POSIX( "Cannot grow the child index to %" PRIu32 " entries",
+                           new_capacity );
+        return;
+    }
+
+    uint32_t new_size = 0;
+    for ( uint32_t i = 0; i < location->child_index_capacity; i++ )
+    {
+        scorep_profile_child_index_entry* entry = &location->child_index[ i ];
+        if ( ( entry->child != NULL ) && ( entry->child->parent == entry->parent ) )
+        {
+            child_index_put( new_table, new_capacity, entry->parent, entry->child );
+            new_size++;
+        }
+    }
+
+    free( location->child_index );
+    location->child_index          = new_table;
+    location->child_index_capacity = new_capacity;
+    location->child_index_size     = new_size;
+}
+
+static void
+child_index_insert( SCOREP_Profile_LocationData* location,
+                    scorep_profile_node*         parent,
+                    scorep_profile_node*         child )
+{
+    /* Keep the load factor below 0.5 */
+    if ( 2 * ( location->child_index_size + 1 ) > location->child_index_capacity )
+    {
+        child_index_grow( location );
+        if ( 2 * ( location->child_index_size + 1 ) > location->child_index_capacity )
+        {
+            /* The index is only a cache, the child is still found in the list */
+            return;
+        }
+    }
+    child_index_put( location->child_index, location->child_index_capacity,
+                     parent, child );
+    location->child_index_size++;
+}
+
+/** Inserts all children of @a parent into the child index of @a location */
+static void
+child_index_add_children( SCOREP_Profile_LocationData* location,
+                          scorep_profile_node*         parent )
+{
+    for ( scorep_profile_node* child = parent->first_child;
+          child != NULL;
+          child = child->next_sibling )
+    {
+        child_index_insert( location, parent, child );
+    }
+    parent->flags |= SCOREP_PROFILE_FLAG_CHILD_INDEX;
+}
+
 /* Find or create a child node of a specified type */
 scorep_profile_node*
 scorep_profile_find_create_child( SCOREP_Profile_LocationData* location,
@@ -525,9 +698,26 @@ scorep_profile_find_create_child( SCOREP_Profile_LocationData* location,
                                   scorep_profile_type_data_t   specific_data,
                                   uint64_t                     timestamp )
 {
-    /* Search matching node */
     UTILS_ASSERT( parent != NULL );
-    scorep_profile_node* child = parent->first_child;
+
+    /* Nodes with many children are looked up in the child index first. The index
+       is only a cache, thus, on a miss we still search the list of children, e.g.,
+       if the child was added by another location or by other tree operations. */
+    bool use_index = ( location != NULL ) &&
+                     ( parent->flags & SCOREP_PROFILE_FLAG_CHILD_INDEX );
+    if ( use_index )
+    {
+        scorep_profile_node* child = child_index_lookup( location, parent,
+                                                         node_type, specific_data );
+        if ( child != NULL )
+        {
+            return child;
+        }
+    }
+
+    /* Search matching node */
+    uint64_t             num_children = 0;
+    scorep_profile_node* child        = parent->first_child;
     while ( ( child != NULL ) &&
             ( ( child->node_type != node_type ) ||
               ( !scorep_profile_compare_type_data( specific_data,
@@ -535,6 +725,7 @@ scorep_profile_find_create_child( SCOREP_Profile_LocationData* location,
                                                    node_type ) ) ) )
     {
         child = child->next_sibling;
+        num_children++;
     }
 
     /* If not found -> create new node */
@@ -548,6 +739,21 @@ scorep_profile_find_create_child( SCOREP_Profile_LocationData* location,
         parent->first_child = child;
     }
 
+    /* Maintain the child index. Nodes of untied tasks are not indexed, because
+       they may be released and recycled by other locations. */
+    uint64_t threshold = scorep_profile_get_child_index_threshold();
+    if ( use_index )
+    {
+        child_index_insert( location, parent, child );
+    }
+    else if ( ( threshold > 0 ) &&
+              ( num_children >= threshold ) &&
+              ( location != NULL ) &&
+              ( scorep_profile_get_task_context( parent ) == SCOREP_PROFILE_TASK_CONTEXT_TIED ) )
+    {
+        child_index_add_children( location, parent );
+    }
+
     return child;
 }
 
@@ -631,6 +837,10 @@ scorep_profile_merge_node_inclusive( scorep_profile_node* destination,
 
     /* Merge dense metrics */
     scorep_profile_merge_dense_metric( &destination->inclusive_time, &source->inclusive_time );
+    if ( destination->time_histogram != NULL && source->time_histogram != NULL )
+    {
+        scorep_profile_merge_histogram( destination->time_histogram, source->time_histogram );
+    }
     for ( i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         scorep_profile_merge_dense_metric( &destination->dense_metrics[ i ],
@@ -727,6 +937,10 @@ scorep_profile_subtract_node( scorep_profile_node* minuend,
     minuend->count                  -= subtrahend->count;
     minuend->inclusive_time.sum     -= subtrahend->inclusive_time.sum;
     minuend->inclusive_time.squares -= subtrahend->inclusive_time.squares;
+    if ( minuend->time_histogram != NULL && subtrahend->time_histogram != NULL )
+    {
+        scorep_profile_subtract_histogram( minuend->time_histogram, subtrahend->time_histogram );
+    }
     for ( uint64_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         minuend->dense_metrics[ i ].sum     -= subtrahend->dense_metrics[ i ].sum;
@@ -129,6 +129,9 @@ typedef enum
     <dd>The region handle</dd>
    </dl>
 
+   If SCOREP_PROFILING_ENABLE_TIME_HISTOGRAMS is set, @a time_histogram points to
+   SCOREP_PROFILE_HISTOGRAM_BUCKETS counters of the inclusive time of the visits.
+
    The  field @a flag is an bitstring to set various flags. Possible flags are defined
    in @a scorep_profile_node_flag.
  */
@@ -142,6 +145,7 @@ typedef struct scorep_profile_node_struct
     scorep_profile_sparse_metric_double* first_double_sparse;
     scorep_profile_sparse_metric_int*    first_int_sparse;
     scorep_profile_dense_metric          inclusive_time;
+    uint64_t*                            time_histogram;   // NULL if disabled
     uint64_t                             count;            // For dense metrics
     uint64_t                             hits;             // For samples
     uint64_t                             first_enter_time; // Required by Scalasca
@@ -158,9 +162,23 @@ typedef enum
 {
     SCOREP_PROFILE_FLAG_MPI_IN_SUBTREE = 1, /**< Set if the subtree contains MPI calls */
     SCOREP_PROFILE_FLAG_IS_FORK_NODE   = 2, /**< Set if another thread was forked here */
-    SCOREP_PROFILE_FLAG_IN_UNTIED_TASK = 4  /**< Set if in untied task */
+    SCOREP_PROFILE_FLAG_IN_UNTIED_TASK = 4, /**< Set if in untied task */
+    SCOREP_PROFILE_FLAG_CHILD_INDEX    = 8  /**< Set if the children are in the child index */
 } scorep_profile_node_flag;
 
+/**
+   Entry of the per-location child index. Nodes with many children get their
+   children inserted into an open-addressing hash table, which avoids walking
+   the complete sibling list on every enter. An entry is only valid as long as
+   @a child is still a child of @a parent, thus, restructuring the tree does not
+   require to update the index.
+ */
+typedef struct
+{
+    scorep_profile_node* parent;
+    scorep_profile_node* child;
+} scorep_profile_child_index_entry;
+
 /**
    Type of function pointer that must be passed to @ref scorep_profile_for_all().
    to be processed for each node.
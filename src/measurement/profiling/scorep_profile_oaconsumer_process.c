@@ -111,9 +111,9 @@ generate_static_measurement_key( scorep_oa_key_type* regionKey,
  * @param currentIndex suggested index for the new entry
  */
 static uint32_t
-index_data_key( SCOREP_Hashtab*     hashTable,
-                scorep_oa_key_type* key,
-                uint32_t            currentIndex );
+index_data_key( SCOREP_ConcurrentHashtab* hashTable,
+                scorep_oa_key_type*       key,
+                uint32_t                  currentIndex );
 
 /**
  * Hash-compare functions for region ids
@@ -410,8 +410,8 @@ scorep_oaconsumer_initialize_index( SCOREP_RegionHandle phaseHandle )
     shared_index->rank                     = ( uint64_t )SCOREP_Ipc_GetRank();
     shared_index->num_static_measurements  = 0;
     shared_index->num_def_regions_merged   = 0;
-    shared_index->merged_regions_def_table = SCOREP_Hashtab_CreateSize( 11, &hash_oa_keys,
-                                                                        &compare_oa_keys );
+    shared_index->merged_regions_def_table = SCOREP_ConcurrentHashtab_CreateSize( 16, &hash_oa_keys,
+                                                                                  &compare_oa_keys );
     UTILS_ASSERT( shared_index->merged_regions_def_table );
 
     shared_index->merged_region_def_buffer  = NULL;
@@ -439,8 +439,8 @@ scorep_oaconsumer_initialize_index( SCOREP_RegionHandle phaseHandle )
 
             private_index_pointer_array[ i ]->thread = i;
 
-            private_index_pointer_array[ i ]->static_measurements_table = SCOREP_Hashtab_CreateSize( 10, &hash_oa_keys,
-                                                                                                     &compare_oa_keys );
+            private_index_pointer_array[ i ]->static_measurements_table = SCOREP_ConcurrentHashtab_CreateSize( 16, &hash_oa_keys,
+                                                                                                               &compare_oa_keys );
 
             UTILS_ASSERT( private_index_pointer_array[ i ]->static_measurements_table );
 
@@ -564,17 +564,17 @@ scorep_oaconsumer_count_index( scorep_profile_node* node,
 
 
 static uint32_t
-index_data_key( SCOREP_Hashtab*     hashTable,
-                scorep_oa_key_type* key,
-                uint32_t            currentIndex )
+index_data_key( SCOREP_ConcurrentHashtab* hashTable,
+                scorep_oa_key_type*       key,
+                uint32_t                  currentIndex )
 {
     SCOREP_Hashtab_Entry* entry = NULL;
     size_t                index;
 
     /** Search for already indexed key */
-    entry = SCOREP_Hashtab_Find(    hashTable,
-                                    &( *key ),
-                                    &index );
+    entry = SCOREP_ConcurrentHashtab_Find(    hashTable,
+                                              &( *key ),
+                                              &index );
     /** If not found, store given key-index pair*/
     if ( !entry )
     {
@@ -588,10 +588,10 @@ index_data_key( SCOREP_Hashtab*     hashTable,
         entry_key->parent_region_id = key->parent_region_id;
         entry_key->region_id        = key->region_id;
         entry_key->metric_id        = key->metric_id;
-        SCOREP_Hashtab_InsertUint32( hashTable,
-                                     ( void* )( entry_key ),
-                                     currentIndex,
-                                     &index );
+        SCOREP_ConcurrentHashtab_InsertUint32( hashTable,
+                                               ( void* )( entry_key ),
+                                               currentIndex,
+                                               &index );
         currentIndex++;
     }
     else
@@ -673,9 +673,9 @@ update_static_measurement( scorep_oa_key_type*        staticMeasKey,
     size_t                index;
 
     /** Search for static measurement key and acquire the index */
-    entry = SCOREP_Hashtab_Find(    threadPrivateIndex->static_measurements_table,
-                                    &( *staticMeasKey ),
-                                    &index );
+    entry = SCOREP_ConcurrentHashtab_Find(    threadPrivateIndex->static_measurements_table,
+                                              &( *staticMeasKey ),
+                                              &index );
 
 
     UTILS_ASSERT( entry );
@@ -691,9 +691,9 @@ update_static_measurement( scorep_oa_key_type*        staticMeasKey,
     /** Search for merged region definition key and acquire the index */
     index = 0;
     entry = NULL;
-    entry = SCOREP_Hashtab_Find(    shared_index->merged_regions_def_table,
-                                    &( *staticMeasKey ),
-                                    &index );
+    entry = SCOREP_ConcurrentHashtab_Find(    shared_index->merged_regions_def_table,
+                                              &( *staticMeasKey ),
+                                              &index );
 
     UTILS_ASSERT( entry );
 
@@ -834,9 +834,9 @@ copy_merged_region_definitions( scorep_profile_node* node,
         size_t                index;
 
         /** Search for static measurement key and acquire the index */
-        entry = SCOREP_Hashtab_Find( shared_index->merged_regions_def_table,
-                                     &( *region_key ),
-                                     &index );
+        entry = SCOREP_ConcurrentHashtab_Find( shared_index->merged_regions_def_table,
+                                               &( *region_key ),
+                                               &index );
         /** Check whether entry was found. If not then a region being currently parsed was not previously indexed*/
         UTILS_ASSERT( entry );
 
@@ -951,7 +951,11 @@ compare_oa_keys( const void* key,
 static size_t
 hash_oa_keys( const void* key )
 {
-    return ( ( scorep_oa_key_type* )key )->region_id * UINT32_C( 2654435761l );
+    const scorep_oa_key_type* oa_key = key;
+    uint64_t                  hash   = ( ( uint64_t )oa_key->parent_region_id << 32 ) | oa_key->region_id;
+
+    /* The metric id and parent distinguish the keys of the same region. */
+    return ( hash ^ ( ( uint64_t )oa_key->metric_id << 16 ) ) * UINT64_C( 11400714819323199488 );
 }
 
 
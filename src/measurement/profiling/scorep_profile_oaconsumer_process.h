@@ -87,7 +87,7 @@ typedef struct
     uint32_t                          num_static_measurements;
     uint32_t                          num_def_regions_merged;
     uint32_t                          num_counter_definitions;
-    SCOREP_Hashtab*                   merged_regions_def_table;     ///Hash table for mapping already registered region names region handles.
+    SCOREP_ConcurrentHashtab*         merged_regions_def_table;     ///Hash table for mapping already registered region names region handles.
     SCOREP_OA_CallPathRegionDef*      merged_region_def_buffer;
     SCOREP_OA_FlatProfileMeasurement* static_measurement_buffer;
     SCOREP_OA_CallPathCounterDef*     counter_definition_buffer;
@@ -118,10 +118,10 @@ typedef struct
  */
 typedef struct
 {
-    scorep_profile_node* phase_node;
-    uint32_t             thread;
-    SCOREP_Hashtab*      static_measurements_table;
-    shared_index_type*   shared_index;
+    scorep_profile_node*      phase_node;
+    uint32_t                  thread;
+    SCOREP_ConcurrentHashtab* static_measurements_table;
+    shared_index_type*        shared_index;
 } thread_private_index_type;
 
 /**
@@ -68,12 +68,17 @@ static bool env_variables_initialized = false;
 static bool     env_verbose;
 static uint64_t env_total_memory;
 static uint64_t env_page_size;
+static bool     env_memory_huge_pages;
 static char*    env_experiment_directory;
 static bool     env_overwrite_experiment_directory;
 static char*    env_machine_name;
 static char*    env_executable;
 static bool     env_system_tree_sequence;
 static bool     force_cfg_files;
+static uint64_t env_clock_sync_mode;
+static uint64_t env_unify_mode;
+static uint64_t env_unify_tree_arity;
+static bool     env_lock_wait_time;
 
 /*
  * Tracing setup
@@ -91,6 +96,39 @@ static bool env_profiling;
 static bool env_unwinding;
 
 
+static const SCOREP_ConfigType_SetEntry clock_sync_mode_table[] = {
+    {
+        "linear",
+        SCOREP_CLOCK_SYNC_LINEAR,
+        "Rank 0 synchronizes with every other process, one after another."
+    },
+    {
+        "tree",
+        SCOREP_CLOCK_SYNC_TREE,
+        "Node leaders are synchronized along a binomial tree rooted at rank 0, "
+        "each leader then synchronizes the processes on its node."
+    },
+    { NULL, 0, NULL }
+};
+
+
+static const SCOREP_ConfigType_SetEntry unify_mode_table[] = {
+    {
+        "hypercube",
+        SCOREP_UNIFY_HYPERCUBE,
+        "Definitions are reduced along an embedded hypercube, each process "
+        "receives the definitions of its children one after another."
+    },
+    {
+        "tree",
+        SCOREP_UNIFY_TREE,
+        "Definitions are reduced along a k-ary tree, each process receives the "
+        "definitions of its children in the order they arrive."
+    },
+    { NULL, 0, NULL }
+};
+
+
 /** @brief Measurement system configure variables */
 static const SCOREP_ConfigVariable core_enable_confvars[] = {
     {
@@ -153,8 +191,10 @@ static const SCOREP_ConfigVariable core_confvars[] = {
         "16000k",
         "Total memory in bytes per process to be consumed by the measurement system",
         "SCOREP_TOTAL_MEMORY will be split into pages of size SCOREP_PAGE_SIZE "
-        "(potentially reduced to a multiple of SCOREP_PAGE_SIZE). Maximum size is 4 GB"
-        "minus one SCOREP_PAGE_SIZE."
+        "(potentially reduced to a multiple of SCOREP_PAGE_SIZE). On 64-bit "
+        "platforms more than 4 GB can be requested, the memory is then only "
+        "reserved and committed in chunks of 64 MB when needed. Otherwise, "
+        "the maximum size is 4 GB minus one SCOREP_PAGE_SIZE."
     },
     {
         "page_size",
@@ -167,6 +207,17 @@ static const SCOREP_ConfigVariable core_confvars[] = {
         "larger power of two. SCOREP_TOTAL_MEMORY will be split up into pages "
         "of (the adjusted) SCOREP_PAGE_SIZE. Minimum size is 512 bytes."
     },
+    {
+        "memory_huge_pages",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &env_memory_huge_pages,
+        NULL,
+        "false",
+        "Back the measurement memory with transparent huge pages",
+        "Advises the operating system to use transparent huge pages for "
+        "SCOREP_TOTAL_MEMORY, which reduces TLB misses when writing large "
+        "traces. Only available on 64-bit platforms providing madvise."
+    },
     {
         "experiment_directory",
         SCOREP_CONFIG_TYPE_PATH,
@@ -246,6 +297,56 @@ static const SCOREP_ConfigVariable core_confvars[] = {
         "If this is set to 'false', the directory will only be created if any "
         "substrate actually writes data."
     },
+    {
+        "clock_synchronization",
+        SCOREP_CONFIG_TYPE_OPTIONSET,
+        &env_clock_sync_mode,
+        ( void* )clock_sync_mode_table,
+        "tree",
+        "Algorithm used to synchronize the clocks of all processes",
+        "Determines how the clock offsets of all processes relative to rank 0 "
+        "are measured at the begin and end of the measurement, if the timer is "
+        "not global and tracing is enabled. 'linear' needs a time proportional "
+        "to the number of processes, 'tree' a time logarithmic in the number of "
+        "nodes plus proportional to the number of processes per node. In 'tree' "
+        "mode the offsets are composed along the tree, the reported error "
+        "estimate accumulates accordingly."
+    },
+    {
+        "unification",
+        SCOREP_CONFIG_TYPE_OPTIONSET,
+        &env_unify_mode,
+        ( void* )unify_mode_table,
+        "tree",
+        "Communication pattern used to unify the definitions of all processes",
+        "In 'tree' mode receives from all children are posted at once and "
+        "small definition pages are packed into a single transfer. The arity "
+        "of the tree is set by SCOREP_UNIFICATION_TREE_ARITY."
+    },
+    {
+        "unification_tree_arity",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &env_unify_tree_arity,
+        NULL,
+        "8",
+        "Number of children per process in the 'tree' unification",
+        "A higher arity reduces the depth of the tree, and thus the number of "
+        "sequential latencies, but each process has to unify the definitions "
+        "of more children."
+    },
+    {
+        "lock_wait_time",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &env_lock_wait_time,
+        NULL,
+        "false",
+        "Record the time spent waiting for OpenMP locks and Pthread mutexes",
+        "If enabled, each successful lock acquisition triggers the metric "
+        "'lock wait time' with the time in nanoseconds the thread waited in the "
+        "locking call. In the trace the metric record follows the acquire lock "
+        "record, thus the wait time can be attributed to individual locks. In "
+        "the profile the metric is aggregated per call path."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
 
@@ -313,6 +414,14 @@ SCOREP_Env_GetPageSize( void )
     return env_page_size;
 }
 
+
+bool
+SCOREP_Env_DoMemoryHugePages( void )
+{
+    assert( env_variables_initialized );
+    return env_memory_huge_pages;
+}
+
 const char*
 SCOREP_Env_GetExperimentDirectory( void )
 {
@@ -348,6 +457,42 @@ SCOREP_Env_DoForceCfgFiles( void )
     return force_cfg_files;
 }
 
+SCOREP_ClockSyncMode
+SCOREP_Env_GetClockSyncMode( void )
+{
+    assert( env_variables_initialized );
+    return env_clock_sync_mode;
+}
+
+SCOREP_UnifyMode
+SCOREP_Env_GetUnifyMode( void )
+{
+    assert( env_variables_initialized );
+    return env_unify_mode;
+}
+
+uint32_t
+SCOREP_Env_GetUnifyTreeArity( void )
+{
+    assert( env_variables_initialized );
+    if ( env_unify_tree_arity < 2 )
+    {
+        return 2;
+    }
+    if ( env_unify_tree_arity > UINT16_MAX )
+    {
+        return UINT16_MAX;
+    }
+    return env_unify_tree_arity;
+}
+
+bool
+SCOREP_Env_DoLockWaitTime( void )
+{
+    assert( env_variables_initialized );
+    return env_lock_wait_time;
+}
+
 bool
 SCOREP_Env_UseSystemTreeSequence( void )
 {
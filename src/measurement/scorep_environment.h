@@ -46,6 +46,26 @@
 UTILS_BEGIN_C_DECLS
 
 
+/**
+ * Algorithms to synchronize the clocks of all processes.
+ */
+typedef enum SCOREP_ClockSyncMode
+{
+    SCOREP_CLOCK_SYNC_LINEAR,
+    SCOREP_CLOCK_SYNC_TREE
+} SCOREP_ClockSyncMode;
+
+
+/**
+ * Communication patterns for the definition unification.
+ */
+typedef enum SCOREP_UnifyMode
+{
+    SCOREP_UNIFY_HYPERCUBE,
+    SCOREP_UNIFY_TREE
+} SCOREP_UnifyMode;
+
+
 void
 SCOREP_RegisterAllConfigVariables( void );
 
@@ -67,6 +87,9 @@ SCOREP_Env_GetTotalMemory( void );
 uint64_t
 SCOREP_Env_GetPageSize( void );
 
+bool
+SCOREP_Env_DoMemoryHugePages( void );
+
 const char*
 SCOREP_Env_GetExperimentDirectory( void );
 
@@ -82,6 +105,18 @@ SCOREP_Env_GetExecutable( void );
 bool
 SCOREP_Env_UseSystemTreeSequence( void );
 
+SCOREP_ClockSyncMode
+SCOREP_Env_GetClockSyncMode( void );
+
+SCOREP_UnifyMode
+SCOREP_Env_GetUnifyMode( void );
+
+uint32_t
+SCOREP_Env_GetUnifyTreeArity( void );
+
+bool
+SCOREP_Env_DoLockWaitTime( void );
+
 /*
  * Tracing setup
  */
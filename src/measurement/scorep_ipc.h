@@ -165,6 +165,54 @@ SCOREP_Ipc_Recv( void*               buf,
 }
 
 
+/**
+ * Handle of a pending non-blocking receive.
+ */
+typedef struct SCOREP_Ipc_Request SCOREP_Ipc_Request;
+
+
+/**
+ *  Starts a receive from @a source, which is completed by SCOREP_Ipc_Waitany.
+ *  Paradigms without non-blocking point-to-point communication may complete
+ *  the receive before returning. Messages from the same source are matched
+ *  in order, regardless of whether they are received blocking or not.
+ */
+int
+SCOREP_IpcGroup_Irecv( SCOREP_Ipc_Group*    group,
+                       void*                buf,
+                       int                  count,
+                       SCOREP_Ipc_Datatype  datatype,
+                       int                  source,
+                       SCOREP_Ipc_Request** request );
+
+
+static inline int
+SCOREP_Ipc_Irecv( void*                buf,
+                  int                  count,
+                  SCOREP_Ipc_Datatype  datatype,
+                  int                  source,
+                  SCOREP_Ipc_Request** request )
+{
+    return SCOREP_IpcGroup_Irecv( SCOREP_IPC_GROUP_WORLD,
+                                  buf,
+                                  count,
+                                  datatype,
+                                  source,
+                                  request );
+}
+
+
+/**
+ *  Waits until one of the @a count pending @a requests has completed, stores
+ *  its position in @a index, and sets this request to NULL. NULL requests
+ *  are ignored. If all requests are NULL, @a index is set to -1.
+ */
+int
+SCOREP_Ipc_Waitany( int                  count,
+                    SCOREP_Ipc_Request** requests,
+                    int*                 index );
+
+
 int
 SCOREP_IpcGroup_Barrier( SCOREP_Ipc_Group* group );
 
@@ -63,6 +63,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <inttypes.h>
+#include <time.h>
 
 
 /** @def FORMAT_TIME_SIZE length for generated experiment directory names based on timestamp */
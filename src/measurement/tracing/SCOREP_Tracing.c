@@ -54,6 +54,7 @@
 #include <SCOREP_Definitions.h>
 #include "scorep_tracing_definitions.h"
 #include <scorep_clock_synchronization.h>
+#include <scorep_ipc.h>
 #include "scorep_tracing_internal.h"
 
 #include <SCOREP_Substrates_Management.h>
@@ -62,7 +63,22 @@
 #define SCOREP_DEBUG_MODULE_NAME TRACING
 #include <UTILS_Debug.h>
 
+#include <SCOREP_InMeasurement.h>
+
+#include <UTILS_IO.h>
+
 #include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+#include <time.h>
+#else
+#include <sys/time.h>
+#endif
+
+#if defined( SCOREP_TRACING_FLUSH_THREAD )
+#include <pthread.h>
+#endif
 
 static OTF2_Archive* scorep_otf2_archive;
 
@@ -76,6 +92,9 @@ static bool event_files_opened;
 size_t scorep_tracing_substrate_id;
 
 
+uint64_t scorep_tracing_min_region_ticks;
+
+
 /** @todo croessel in OTF2_Archive_Open we need to specify an event
     chunk size and a definition chunk size. */
 #define SCOREP_TRACING_CHUNK_SIZE ( 1024 * 1024 )
@@ -102,6 +121,315 @@ scorep_tracing_get_file_substrate( void )
 }
 
 
+#if HAVE( OTF2_DEFERRED_FLUSH )
+
+/**
+ * Memory of an event writer in asynchronous flush mode.
+ *
+ * The event writer records into the first set of pages. On a flush, OTF2
+ * detaches the chunks into a flush job, which is written by the writer thread,
+ * and the two sets are swapped. The second set is released again, before it
+ * becomes the first set on the next flush.
+ */
+struct scorep_tracing_flush_buffer
+{
+    SCOREP_Allocator_PageManager* page_managers[ 2 ];
+    /* Bytes allocated from the first set of pages */
+    uint64_t                      used;
+    /* The chunks of the second set of pages, while not yet written */
+    OTF2_FlushJob*                job;
+    /* Link in the queue of the writer thread */
+    scorep_tracing_flush_buffer*  next;
+};
+
+
+#if defined( SCOREP_TRACING_FLUSH_THREAD )
+
+static pthread_mutex_t              flush_thread_mutex   = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t               flush_job_available  = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t               flush_job_written    = PTHREAD_COND_INITIALIZER;
+static scorep_tracing_flush_buffer* flush_queue_head;
+static scorep_tracing_flush_buffer* flush_queue_tail;
+static bool                         flush_thread_running;
+static bool                         flush_thread_stop;
+static pthread_t                    flush_thread;
+
+
+static void
+write_flush_job( OTF2_FlushJob* job )
+{
+    OTF2_ErrorCode err = OTF2_FlushJob_Write( job );
+    if ( OTF2_SUCCESS != err )
+    {
+        UTILS_WARNING( "Could not write trace buffer: %s",
+                       OTF2_Error_GetDescription( err ) );
+    }
+}
+
+
+static void*
+flush_thread_main( void* arg )
+{
+    /* This thread does not belong to the measurement, let all wrapped
+     * calls pass through. */
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    pthread_mutex_lock( &flush_thread_mutex );
+    while ( true )
+    {
+        while ( !flush_queue_head && !flush_thread_stop )
+        {
+            pthread_cond_wait( &flush_job_available, &flush_thread_mutex );
+        }
+        if ( !flush_queue_head )
+        {
+            break;
+        }
+
+        scorep_tracing_flush_buffer* buffer = flush_queue_head;
+        flush_queue_head = buffer->next;
+        if ( !flush_queue_head )
+        {
+            flush_queue_tail = NULL;
+        }
+        buffer->next = NULL;
+        pthread_mutex_unlock( &flush_thread_mutex );
+
+        /* The writer of this buffer does not touch the job meanwhile */
+        write_flush_job( buffer->job );
+
+        pthread_mutex_lock( &flush_thread_mutex );
+        buffer->job = NULL;
+        pthread_cond_broadcast( &flush_job_written );
+    }
+    pthread_mutex_unlock( &flush_thread_mutex );
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return NULL;
+}
+
+
+static void
+flush_buffer_submit( scorep_tracing_flush_buffer* buffer,
+                     OTF2_FlushJob*               job )
+{
+    pthread_mutex_lock( &flush_thread_mutex );
+
+    if ( !flush_thread_running )
+    {
+        flush_thread_stop = false;
+        if ( 0 != pthread_create( &flush_thread, NULL, flush_thread_main, NULL ) )
+        {
+            pthread_mutex_unlock( &flush_thread_mutex );
+            UTILS_WARNING( "Could not create trace writer thread, "
+                           "writing trace buffer synchronously." );
+            write_flush_job( job );
+            return;
+        }
+        flush_thread_running = true;
+    }
+
+    buffer->job = job;
+    if ( flush_queue_tail )
+    {
+        flush_queue_tail->next = buffer;
+    }
+    else
+    {
+        flush_queue_head = buffer;
+    }
+    flush_queue_tail = buffer;
+    pthread_cond_signal( &flush_job_available );
+
+    pthread_mutex_unlock( &flush_thread_mutex );
+}
+
+
+static void
+flush_buffer_wait( scorep_tracing_flush_buffer* buffer )
+{
+    pthread_mutex_lock( &flush_thread_mutex );
+    while ( buffer->job )
+    {
+        pthread_cond_wait( &flush_job_written, &flush_thread_mutex );
+    }
+    pthread_mutex_unlock( &flush_thread_mutex );
+}
+
+
+static void
+flush_thread_join( void )
+{
+    pthread_mutex_lock( &flush_thread_mutex );
+    if ( !flush_thread_running )
+    {
+        pthread_mutex_unlock( &flush_thread_mutex );
+        return;
+    }
+    flush_thread_stop = true;
+    pthread_cond_signal( &flush_job_available );
+    pthread_mutex_unlock( &flush_thread_mutex );
+
+    pthread_join( flush_thread, NULL );
+    flush_thread_running = false;
+}
+
+#else /* !SCOREP_TRACING_FLUSH_THREAD */
+
+static void
+flush_buffer_submit( scorep_tracing_flush_buffer* buffer,
+                     OTF2_FlushJob*               job )
+{
+    OTF2_ErrorCode err = OTF2_FlushJob_Write( job );
+    if ( OTF2_SUCCESS != err )
+    {
+        UTILS_WARNING( "Could not write trace buffer: %s",
+                       OTF2_Error_GetDescription( err ) );
+    }
+}
+
+
+static void
+flush_buffer_wait( scorep_tracing_flush_buffer* buffer )
+{
+}
+
+
+static void
+flush_thread_join( void )
+{
+}
+
+#endif /* !SCOREP_TRACING_FLUSH_THREAD */
+
+
+static void
+scorep_on_trace_deferred_flush( void*            userData,
+                                OTF2_FileType    fileType,
+                                OTF2_LocationRef locationId,
+                                void*            callerData,
+                                void**           perBufferData,
+                                OTF2_FlushJob*   flushJob )
+{
+    scorep_tracing_flush_buffer* buffer = *perBufferData;
+    UTILS_BUG_ON( !buffer, "Deferred flush without memory." );
+
+    void*          user_data = NULL;
+    OTF2_ErrorCode err       = OTF2_EvtWriter_GetUserData( callerData, &user_data );
+    UTILS_ASSERT( err == OTF2_SUCCESS && user_data );
+    scorep_tracing_get_trace_data( ( SCOREP_Location* )user_data )->flush_buffer = buffer;
+
+    /* The previous flush must be written, before we can reuse its pages */
+    flush_buffer_wait( buffer );
+    SCOREP_Allocator_Free( buffer->page_managers[ 1 ] );
+
+    SCOREP_Allocator_PageManager* flushed = buffer->page_managers[ 0 ];
+    buffer->page_managers[ 0 ] = buffer->page_managers[ 1 ];
+    buffer->page_managers[ 1 ] = flushed;
+    buffer->used               = 0;
+
+    flush_buffer_submit( buffer, flushJob );
+}
+
+
+static void*
+flush_buffer_allocate( void**   perBufferData,
+                       uint64_t chunkSize )
+{
+    scorep_tracing_flush_buffer* buffer = *perBufferData;
+    if ( !buffer )
+    {
+        buffer = SCOREP_Location_AllocForMisc( SCOREP_Location_GetCurrentCPULocation(),
+                                               sizeof( *buffer ) );
+        buffer->page_managers[ 0 ] = SCOREP_Memory_CreateTracingPageManager();
+        buffer->page_managers[ 1 ] = SCOREP_Memory_CreateTracingPageManager();
+        buffer->used               = 0;
+        buffer->job                = NULL;
+        buffer->next               = NULL;
+        *perBufferData             = buffer;
+    }
+
+    /* Let OTF2 flush, when the first set reached its size */
+    if ( buffer->used > 0
+         && buffer->used + chunkSize > scorep_tracing_async_flush_size )
+    {
+        return NULL;
+    }
+
+    void* chunk = SCOREP_Allocator_Alloc( buffer->page_managers[ 0 ], chunkSize );
+    if ( !chunk && buffer->job )
+    {
+        /* Out of memory, the second set needs to be written first */
+        flush_buffer_wait( buffer );
+        SCOREP_Allocator_Free( buffer->page_managers[ 1 ] );
+        chunk = SCOREP_Allocator_Alloc( buffer->page_managers[ 0 ], chunkSize );
+    }
+    if ( chunk )
+    {
+        buffer->used += chunkSize;
+    }
+
+    return chunk;
+}
+
+
+static void
+flush_buffer_free_all( void** perBufferData,
+                       bool   final )
+{
+    scorep_tracing_flush_buffer* buffer = *perBufferData;
+    if ( !buffer )
+    {
+        return;
+    }
+
+    flush_buffer_wait( buffer );
+    SCOREP_Allocator_Free( buffer->page_managers[ 0 ] );
+    SCOREP_Allocator_Free( buffer->page_managers[ 1 ] );
+    buffer->used = 0;
+
+    if ( final )
+    {
+        SCOREP_Allocator_DeletePageManager( buffer->page_managers[ 0 ] );
+        SCOREP_Allocator_DeletePageManager( buffer->page_managers[ 1 ] );
+        *perBufferData = NULL;
+    }
+}
+
+#else /* !HAVE( OTF2_DEFERRED_FLUSH ) */
+
+/* Without deferred flushes in OTF2, scorep_tracing_async_flush_size is 0
+ * and all buffers are flushed synchronously. */
+
+static void
+flush_buffer_wait( scorep_tracing_flush_buffer* buffer )
+{
+}
+
+
+static void*
+flush_buffer_allocate( void**   perBufferData,
+                       uint64_t chunkSize )
+{
+    return NULL;
+}
+
+
+static void
+flush_buffer_free_all( void** perBufferData,
+                       bool   final )
+{
+}
+
+
+static void
+flush_thread_join( void )
+{
+}
+
+#endif /* !HAVE( OTF2_DEFERRED_FLUSH ) */
+
+
 static OTF2_FlushType
 scorep_on_trace_pre_flush( void*         userData,
                            OTF2_FileType fileType,
@@ -127,7 +455,8 @@ scorep_on_trace_pre_flush( void*         userData,
                         fileType == OTF2_FILETYPE_LOCAL_DEFS ? "Def" : "Evt",
                         fileType == OTF2_FILETYPE_GLOBAL_DEFS ? 0 : locationId );
 
-    if ( fileType == OTF2_FILETYPE_EVENTS && !final )
+    if ( fileType == OTF2_FILETYPE_EVENTS && !final
+         && scorep_tracing_async_flush_size == 0 )
     {
         /* A buffer flush happen in an event buffer before the end of the measurement */
 
@@ -152,6 +481,14 @@ scorep_on_trace_pre_flush( void*         userData,
         /* Always flush if this is the final one. */
         do_flush = OTF2_FLUSH;
     }
+#if HAVE( OTF2_DEFERRED_FLUSH )
+    else if ( fileType == OTF2_FILETYPE_EVENTS
+              && scorep_tracing_async_flush_size > 0 )
+    {
+        /* Hand the buffer over to the writer thread */
+        do_flush = OTF2_FLUSH_DEFERRED;
+    }
+#endif
 
     if ( fileType == OTF2_FILETYPE_EVENTS )
     {
@@ -162,6 +499,16 @@ scorep_on_trace_pre_flush( void*         userData,
         SCOREP_Location* location = ( SCOREP_Location* )user_data;
         SCOREP_Location_EnsureGlobalId( location );
         scorep_rewind_stack_delete( location );
+
+        /* OTF2 forgets all rewind points of this buffer */
+        SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+        tracing_data->flush_generation++;
+
+        /* Previous flushes of this buffer need to be written first */
+        if ( tracing_data->flush_buffer )
+        {
+            flush_buffer_wait( tracing_data->flush_buffer );
+        }
     }
 
     return do_flush;
@@ -199,6 +546,16 @@ scorep_tracing_register_flush_callbacks( OTF2_Archive* archive )
                                         &flush_callbacks,
                                         NULL );
     UTILS_ASSERT( status == OTF2_SUCCESS );
+
+#if HAVE( OTF2_DEFERRED_FLUSH )
+    if ( scorep_tracing_async_flush_size > 0 )
+    {
+        status = OTF2_Archive_SetDeferredFlushCallback( archive,
+                                                        scorep_on_trace_deferred_flush,
+                                                        NULL );
+        UTILS_ASSERT( status == OTF2_SUCCESS );
+    }
+#endif
 }
 
 
@@ -211,6 +568,11 @@ scorep_tracing_chunk_allocate( void*         userData,
 {
     UTILS_DEBUG_ENTRY( "chunk size: %" PRIu64, chunkSize );
 
+    if ( OTF2_FILETYPE_EVENTS == fileType && scorep_tracing_async_flush_size > 0 )
+    {
+        return flush_buffer_allocate( perBufferData, chunkSize );
+    }
+
     if ( !*perBufferData )
     {
         /* This manager has a pre-allocated page, which is much smaller
@@ -251,6 +613,12 @@ scorep_tracing_chunk_free_all( void*         userData,
 {
     UTILS_DEBUG_ENTRY( "%s", final ? "final" : "intermediate" );
 
+    if ( OTF2_FILETYPE_EVENTS == fileType && scorep_tracing_async_flush_size > 0 )
+    {
+        flush_buffer_free_all( perBufferData, final );
+        return;
+    }
+
     /* maybe we were called without one allocate */
     if ( !*perBufferData )
     {
@@ -304,6 +672,45 @@ scorep_tracing_otf2_error_callback( void*          userData,
 #endif
 
 
+static inline uint64_t
+get_calibration_clock( void )
+{
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+    struct timespec time;
+    clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+#else
+    struct timeval time;
+    gettimeofday( &time, NULL );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_usec * 1000;
+#endif
+}
+
+
+/**
+ * Converts SCOREP_TRACING_MIN_REGION_DURATION into clock ticks. The resolution
+ * of the measurement timer is only known after the measurement, thus it is
+ * compared against a clock in nanoseconds for a millisecond.
+ */
+static uint64_t
+calibrate_min_region_ticks( void )
+{
+    uint64_t ticks_begin = SCOREP_Timer_GetClockTicks();
+    uint64_t ns_begin    = get_calibration_clock();
+    uint64_t ns_end;
+    do
+    {
+        ns_end = get_calibration_clock();
+    }
+    while ( ns_end - ns_begin < UINT64_C( 1000000 ) );
+    uint64_t ticks_end = SCOREP_Timer_GetClockTicks();
+
+    uint64_t ticks = ( uint64_t )( ( double )scorep_tracing_min_region_duration
+                                   * ( ticks_end - ticks_begin ) / ( ns_end - ns_begin ) );
+    return ticks > 0 ? ticks : 1;
+}
+
+
 void
 SCOREP_Tracing_Initialize( size_t substrateId )
 {
@@ -323,6 +730,40 @@ SCOREP_Tracing_Initialize( size_t substrateId )
     }
 #endif
 
+#if !HAVE( OTF2_DEFERRED_FLUSH )
+    if ( scorep_tracing_async_flush_size > 0 )
+    {
+        UTILS_WARNING( "Ignoring asynchronous trace buffer flushes requested via "
+                       "SCOREP_TRACING_ASYNC_FLUSH_SIZE, as OTF2 does not support "
+                       "deferred flushes." );
+        scorep_tracing_async_flush_size = 0;
+    }
+#endif
+
+#if !defined( SCOREP_TRACING_FLUSH_THREAD )
+    if ( scorep_tracing_async_flush_size > 0 )
+    {
+        UTILS_WARNING( "Ignoring asynchronous trace buffer flushes requested via "
+                       "SCOREP_TRACING_ASYNC_FLUSH_SIZE, as Score-P was built "
+                       "without Pthread support." );
+        scorep_tracing_async_flush_size = 0;
+    }
+#endif
+
+    if ( scorep_tracing_async_flush_size > 0
+         && scorep_tracing_get_file_substrate() != OTF2_SUBSTRATE_POSIX )
+    {
+        UTILS_WARNING( "Ignoring asynchronous trace buffer flushes requested via "
+                       "SCOREP_TRACING_ASYNC_FLUSH_SIZE, as they are not supported "
+                       "with the SIONlib trace substrate." );
+        scorep_tracing_async_flush_size = 0;
+    }
+
+    if ( scorep_tracing_min_region_duration > 0 )
+    {
+        scorep_tracing_min_region_ticks = calibrate_min_region_ticks();
+    }
+
     /* Check for valid scorep_tracing_max_procs_per_sion_file */
     if ( 0 == scorep_tracing_max_procs_per_sion_file )
     {
@@ -456,6 +897,9 @@ SCOREP_Tracing_FinalizeEventWriters( void )
     SCOREP_Location_ForAll( scorep_trace_finalize_event_writer_cb,
                             NULL );
 
+    /* All event writers are closed, thus nothing is left to write */
+    flush_thread_join();
+
     OTF2_ErrorCode err = OTF2_Archive_CloseEvtFiles( scorep_otf2_archive );
     if ( OTF2_SUCCESS != err )
     {
@@ -574,9 +1018,113 @@ write_properties( void )
 }
 
 
+static bool
+sum_dropped_regions_cb( SCOREP_Location* location,
+                        void*            userData )
+{
+    uint64_t*           dropped      = userData;
+    SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+    if ( !tracing_data )
+    {
+        return false;
+    }
+
+    const uint32_t* mappings = scorep_local_definition_manager.region.mapping;
+    for ( uint32_t i = 0; i < tracing_data->dropped_regions_capacity; i++ )
+    {
+        if ( tracing_data->dropped_regions[ i ].visits == 0 )
+        {
+            continue;
+        }
+        uint32_t global_id = mappings ? mappings[ i ] : i;
+        dropped[ 2 * global_id ]     += tracing_data->dropped_regions[ i ].visits;
+        dropped[ 2 * global_id + 1 ] += tracing_data->dropped_regions[ i ].ticks;
+    }
+
+    return false;
+}
+
+
+/**
+ * Writes the number and time of the region visits, which were discarded
+ * because of SCOREP_TRACING_MIN_REGION_DURATION, summed up over all
+ * locations.
+ */
+static void
+write_dropped_regions( void )
+{
+    uint32_t number_of_regions = 0;
+    if ( SCOREP_Status_GetRank() == 0 )
+    {
+        number_of_regions = scorep_unified_definition_manager->region.counter;
+    }
+    SCOREP_Ipc_Bcast( &number_of_regions, 1, SCOREP_IPC_UINT32_T, 0 );
+    if ( number_of_regions == 0 )
+    {
+        return;
+    }
+
+    uint64_t* dropped = calloc( 2 * ( size_t )number_of_regions, sizeof( *dropped ) );
+    UTILS_BUG_ON( dropped == NULL, "Failed to allocate summary of discarded regions." );
+    SCOREP_Location_ForAll( sum_dropped_regions_cb, dropped );
+
+    uint64_t* dropped_sum = NULL;
+    if ( SCOREP_Status_GetRank() == 0 )
+    {
+        dropped_sum = calloc( 2 * ( size_t )number_of_regions, sizeof( *dropped_sum ) );
+        UTILS_BUG_ON( dropped_sum == NULL, "Failed to allocate summary of discarded regions." );
+    }
+    SCOREP_Ipc_Reduce( dropped, dropped_sum, 2 * number_of_regions,
+                       SCOREP_IPC_UINT64_T, SCOREP_IPC_SUM, 0 );
+    free( dropped );
+
+    if ( SCOREP_Status_GetRank() != 0 )
+    {
+        return;
+    }
+
+    char* filename = UTILS_IO_JoinPath( 2, SCOREP_GetExperimentDirName(), "traces.dropped" );
+    FILE* file     = filename ? fopen( filename, "w" ) : NULL;
+    if ( !file )
+    {
+        UTILS_ERROR_POSIX( "Could not write summary of discarded regions" );
+        free( filename );
+        free( dropped_sum );
+        return;
+    }
+
+    double resolution = ( double )SCOREP_Timer_GetClockResolution();
+    fprintf( file, "# Region visits shorter than %" PRIu64 " ns, which were "
+             "discarded from the trace\n", scorep_tracing_min_region_duration );
+    fprintf( file, "# visits\ttime [s]\tregion\n" );
+    SCOREP_DEFINITIONS_MANAGER_FOREACH_DEFINITION_BEGIN( scorep_unified_definition_manager, Region, region )
+    {
+        uint32_t id = definition->sequence_number;
+        if ( dropped_sum[ 2 * id ] == 0 )
+        {
+            continue;
+        }
+        fprintf( file, "%" PRIu64 "\t%.9f\t%s\n",
+                 dropped_sum[ 2 * id ],
+                 dropped_sum[ 2 * id + 1 ] / resolution,
+                 SCOREP_UNIFIED_HANDLE_DEREF( definition->name_handle, String )->string_data );
+    }
+    SCOREP_DEFINITIONS_MANAGER_FOREACH_DEFINITION_END();
+
+    fclose( file );
+    free( filename );
+    free( dropped_sum );
+}
+
+
 void
 SCOREP_Tracing_Write( void )
 {
     write_properties();
     write_definitions();
+
+    if ( scorep_tracing_min_region_ticks )
+    {
+        write_dropped_regions();
+    }
 }
@@ -46,6 +46,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 
 #include <UTILS_Error.h>
@@ -204,6 +205,101 @@ program_end( SCOREP_Location*    location,
 
 
 
+/**
+ * Stores a rewind point for a region visit, which may be discarded at its
+ * leave, see SCOREP_TRACING_MIN_REGION_DURATION. To be called before the
+ * events which belong to the enter are written.
+ */
+static inline scorep_tracing_short_region*
+begin_short_region( SCOREP_TracingData* tracingData,
+                    uint64_t            timestamp,
+                    SCOREP_RegionHandle regionHandle )
+{
+    uint32_t                     slot   = ++tracingData->region_depth % SCOREP_TRACING_SHORT_REGIONS;
+    scorep_tracing_short_region* region = &tracingData->short_regions[ slot ];
+
+    /* A flush while writing the enter event drops the rewind point again */
+    region->flush_generation = tracingData->flush_generation;
+    region->depth            = tracingData->region_depth;
+    region->region           = regionHandle;
+    region->timestamp        = timestamp;
+    OTF2_EvtWriter_StoreRewindPoint( tracingData->otf_writer,
+                                     SCOREP_TRACING_SHORT_REGION_REWIND_ID( slot ) );
+
+    return region;
+}
+
+
+static void
+count_dropped_region( SCOREP_TracingData* tracingData,
+                      SCOREP_RegionHandle regionHandle,
+                      uint64_t            duration )
+{
+    uint32_t region_id = SCOREP_LOCAL_HANDLE_TO_ID( regionHandle, Region );
+    if ( region_id >= tracingData->dropped_regions_capacity )
+    {
+        uint32_t capacity = tracingData->dropped_regions_capacity
+                            ? tracingData->dropped_regions_capacity : 64;
+        while ( region_id >= capacity )
+        {
+            capacity *= 2;
+        }
+        scorep_tracing_dropped_region* dropped_regions =
+            realloc( tracingData->dropped_regions, capacity * sizeof( *dropped_regions ) );
+        UTILS_BUG_ON( dropped_regions == NULL,
+                      "Failed to allocate summary of discarded regions." );
+        memset( dropped_regions + tracingData->dropped_regions_capacity, 0,
+                ( capacity - tracingData->dropped_regions_capacity ) * sizeof( *dropped_regions ) );
+        tracingData->dropped_regions          = dropped_regions;
+        tracingData->dropped_regions_capacity = capacity;
+    }
+
+    tracingData->dropped_regions[ region_id ].visits++;
+    tracingData->dropped_regions[ region_id ].ticks += duration;
+}
+
+
+/**
+ * Discards the enter event of the region visit which ends at @a timestamp,
+ * if it is shorter than SCOREP_TRACING_MIN_REGION_DURATION and nothing else
+ * remained in the trace buffer since.
+ *
+ * @return true if the visit was discarded and no leave event must be written.
+ */
+static inline bool
+end_short_region( SCOREP_TracingData* tracingData,
+                  uint64_t            timestamp,
+                  SCOREP_RegionHandle regionHandle )
+{
+    uint32_t                     depth  = tracingData->region_depth--;
+    uint32_t                     slot   = depth % SCOREP_TRACING_SHORT_REGIONS;
+    scorep_tracing_short_region* region = &tracingData->short_regions[ slot ];
+
+    if ( region->depth != depth
+         || region->region != regionHandle
+         || region->flush_generation != tracingData->flush_generation
+         || timestamp - region->timestamp >= scorep_tracing_min_region_ticks )
+    {
+        return false;
+    }
+
+    /* Any other event, including kept visits of sub-regions, prevents
+     * discarding this visit */
+    uint64_t number_of_events;
+    OTF2_EvtWriter_GetNumberOfEvents( tracingData->otf_writer, &number_of_events );
+    if ( number_of_events != region->number_of_events
+         || OTF2_EvtWriter_Rewind( tracingData->otf_writer,
+                                   SCOREP_TRACING_SHORT_REGION_REWIND_ID( slot ) ) != OTF2_SUCCESS )
+    {
+        return false;
+    }
+    region->depth = 0;
+
+    count_dropped_region( tracingData, regionHandle, timestamp - region->timestamp );
+    return true;
+}
+
+
 static void
 enter( SCOREP_Location*    location,
        uint64_t            timestamp,
@@ -215,12 +311,25 @@ enter( SCOREP_Location*    location,
     OTF2_AttributeList* attribute_list = tracing_data->otf_attribute_list;
 
     SCOREP_Metric_WriteAsynchronousMetrics( location, write_metric );
+
+    /* Asynchronous metrics are kept, even if this visit is discarded */
+    scorep_tracing_short_region* short_region = NULL;
+    if ( scorep_tracing_min_region_ticks )
+    {
+        short_region = begin_short_region( tracing_data, timestamp, regionHandle );
+    }
+
     SCOREP_Metric_WriteStrictlySynchronousMetrics( location, timestamp, write_metric );
     SCOREP_Metric_WriteSynchronousMetrics( location, timestamp, write_metric );
     OTF2_EvtWriter_Enter( evt_writer,
                           attribute_list,
                           timestamp,
                           SCOREP_LOCAL_HANDLE_TO_ID( regionHandle, Region ) );
+
+    if ( short_region )
+    {
+        OTF2_EvtWriter_GetNumberOfEvents( evt_writer, &short_region->number_of_events );
+    }
 }
 
 
@@ -234,6 +343,14 @@ leave( SCOREP_Location*    location,
     OTF2_EvtWriter*     evt_writer     = tracing_data->otf_writer;
     OTF2_AttributeList* attribute_list = tracing_data->otf_attribute_list;
 
+    if ( scorep_tracing_min_region_ticks
+         && end_short_region( tracing_data, timestamp, regionHandle ) )
+    {
+        /* The attributes belonged to the discarded visit */
+        OTF2_AttributeList_RemoveAllAttributes( attribute_list );
+        return;
+    }
+
     SCOREP_Metric_WriteAsynchronousMetrics( location, write_metric );
     SCOREP_Metric_WriteStrictlySynchronousMetrics( location, timestamp, write_metric );
     SCOREP_Metric_WriteSynchronousMetrics( location, timestamp, write_metric );
@@ -1991,6 +2108,10 @@ dump_manifest( FILE* manifestFile, const char* relativeSourceDir, const char* ta
     SCOREP_ConfigManifestSectionEntry( manifestFile, "traces.otf2", "OTF2 anchor file." );
     SCOREP_ConfigManifestSectionEntry( manifestFile, "traces.def", "OTF2 global definitions file." );
     SCOREP_ConfigManifestSectionEntry( manifestFile, "traces/", "Sub-directory containing per location trace data." );
+    if ( scorep_tracing_min_region_ticks )
+    {
+        SCOREP_ConfigManifestSectionEntry( manifestFile, "traces.dropped", "Number and time of the region visits discarded from the trace." );
+    }
 }
 
 static bool
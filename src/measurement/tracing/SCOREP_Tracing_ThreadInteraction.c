@@ -41,6 +41,7 @@
 
 
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 
@@ -68,6 +69,12 @@ SCOREP_Tracing_CreateLocationData( SCOREP_Location* locationData )
     new_data->rewind_stack       = 0;
     new_data->rewind_free_list   = 0;
     new_data->otf_attribute_list = OTF2_AttributeList_New();
+    new_data->flush_buffer       = NULL;
+    memset( new_data->short_regions, 0, sizeof( new_data->short_regions ) );
+    new_data->region_depth             = 0;
+    new_data->flush_generation         = 0;
+    new_data->dropped_regions          = NULL;
+    new_data->dropped_regions_capacity = 0;
     UTILS_BUG_ON( NULL == new_data->otf_attribute_list,
                   "Couldn't create event attribute list." );
 
@@ -85,6 +92,10 @@ SCOREP_Tracing_DeleteLocationData( SCOREP_Location* location )
         // writer will be deleted by otf in call to OTF2_Archive_Close()
 
         OTF2_AttributeList_Delete( trace_location_data->otf_attribute_list );
+
+        free( trace_location_data->dropped_regions );
+        trace_location_data->dropped_regions          = NULL;
+        trace_location_data->dropped_regions_capacity = 0;
     }
 }
 
@@ -44,6 +44,8 @@
 
 bool     scorep_tracing_use_sion;
 uint64_t scorep_tracing_max_procs_per_sion_file;
+uint64_t scorep_tracing_async_flush_size;
+uint64_t scorep_tracing_min_region_duration;
 /* Need to initialize variable, as it is not guaranteed that it will be set by
  * the config system, if unwinding is not supported.
  */
@@ -72,6 +74,40 @@ static const SCOREP_ConfigVariable scorep_tracing_confvars[] = {
         "files to fulfill this constraint. E.g., having 4 processes and setting "
         "the maximum to 3 would result in 2 files each holding 2 processes."
     },
+    {
+        "async_flush_size",
+        SCOREP_CONFIG_TYPE_SIZE,
+        &scorep_tracing_async_flush_size,
+        NULL,
+        "0",
+        "Write full trace buffers in a background thread",
+        "If set to a non-zero value, the event buffer of a location is handed "
+        "over to a writer thread each time it holds this amount of data. "
+        "Recording continues into a second set of pages meanwhile and the "
+        "flush shows up only as a short BUFFER FLUSH region in the trace. If "
+        "the second set is full before the writer finished the first one, or "
+        "SCOREP_TOTAL_MEMORY is exhausted, the location waits for the writer.\n"
+        "Each location may hold up to twice this amount of trace data, thus "
+        "the value should not exceed SCOREP_TOTAL_MEMORY divided by twice the "
+        "number of locations per process. Not supported with the SIONlib "
+        "substrate."
+    },
+    {
+        "min_region_duration",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_tracing_min_region_duration,
+        NULL,
+        "0",
+        "Discard region visits shorter than this many nanoseconds from the trace",
+        "If set to a non-zero value, the enter and leave events of a region "
+        "visit are removed from the trace buffer again when the region is left "
+        "before this duration elapsed, and no other event than the likewise "
+        "removed visits of sub-regions was recorded in between. Regions with "
+        "communication, I/O, or other events are always kept.\n"
+        "The number of removed visits and their time are summed up per region "
+        "and written to 'traces.dropped' in the experiment directory. A value "
+        "of 0 keeps all visits."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
 
@@ -51,20 +51,68 @@
 
 extern bool     scorep_tracing_use_sion;
 extern uint64_t scorep_tracing_max_procs_per_sion_file;
+extern uint64_t scorep_tracing_async_flush_size;
 extern bool     scorep_tracing_convert_calling_context;
+extern uint64_t scorep_tracing_min_region_duration;
+
+/**
+ * SCOREP_TRACING_MIN_REGION_DURATION in clock ticks, 0 if region visits are
+ * never discarded. Set during initialization.
+ */
+extern uint64_t scorep_tracing_min_region_ticks;
 
 /**
  * Stores the substrate id of the tracing substrate. Set during initialization.
  */
 extern size_t scorep_tracing_substrate_id;
 
+typedef struct scorep_tracing_flush_buffer scorep_tracing_flush_buffer;
+
+/* Number of nested region visits which may be discarded at their leave */
+#define SCOREP_TRACING_SHORT_REGIONS 16
+
+/* OTF2 rewind ids of the short region candidates, distinct from the region ids
+ * used by user rewind regions */
+#define SCOREP_TRACING_SHORT_REGION_REWIND_ID( slot ) ( UINT32_MAX - ( slot ) )
+
+/** An entered region, which is discarded when it is left early enough. */
+typedef struct scorep_tracing_short_region
+{
+    uint64_t            timestamp;
+    /* Number of events in the trace buffer after the enter event */
+    uint64_t            number_of_events;
+    /* Value of SCOREP_TracingData::flush_generation at the enter */
+    uint32_t            flush_generation;
+    uint32_t            depth;
+    SCOREP_RegionHandle region;
+} scorep_tracing_short_region;
+
+/** Summary of the discarded visits of one region. */
+typedef struct scorep_tracing_dropped_region
+{
+    uint64_t visits;
+    uint64_t ticks;
+} scorep_tracing_dropped_region;
+
 typedef struct SCOREP_TracingData SCOREP_TracingData;
 struct SCOREP_TracingData
 {
-    OTF2_EvtWriter*      otf_writer;
-    scorep_rewind_stack* rewind_stack;
-    scorep_rewind_stack* rewind_free_list;
-    OTF2_AttributeList*  otf_attribute_list;
+    OTF2_EvtWriter*              otf_writer;
+    scorep_rewind_stack*         rewind_stack;
+    scorep_rewind_stack*         rewind_free_list;
+    OTF2_AttributeList*          otf_attribute_list;
+    /* Pages of the event writer, if flushed asynchronously */
+    scorep_tracing_flush_buffer* flush_buffer;
+
+    /* Candidates to be discarded, indexed by depth modulo
+     * SCOREP_TRACING_SHORT_REGIONS, see SCOREP_TRACING_MIN_REGION_DURATION */
+    scorep_tracing_short_region    short_regions[ SCOREP_TRACING_SHORT_REGIONS ];
+    uint32_t                       region_depth;
+    /* Incremented on every flush, which invalidates all rewind points */
+    uint32_t                       flush_generation;
+    /* Discarded visits, indexed by local region id */
+    scorep_tracing_dropped_region* dropped_regions;
+    uint32_t                       dropped_regions_capacity;
 };
 
 
@@ -74,6 +74,16 @@ uint64_t
 SCOREP_Timer_GetClockResolution( void );
 
 
+/**
+ * Compares the timer frequencies of all processes and warns if they differ,
+ * e.g., because the time stamp counters are not invariant or the processes
+ * use different timers. Needs to be called by all processes, as part of the
+ * clock synchronization at the begin of the measurement.
+ */
+void
+SCOREP_Timer_CheckFrequencies( void );
+
+
 /**
  * @return true if we have a global clock, e.g. on Blue Gene systems. Usually false.
  */
@@ -102,6 +102,71 @@ SCOREP_Unwinding_GetCallingContext( SCOREP_Location*             location,
                                     SCOREP_CallingContextHandle* previousCallingContext,
                                     uint32_t*                    unwindDistance );
 
+/**
+ * Create the calling context of a sample from a callchain recorded outside of
+ * the signal context, e.g., by the kernel.
+ *
+ * Must only be called while the instrumented regions of @a location are the
+ * same as when the sample was taken, see SCOREP_Unwinding_DrainSamples().
+ *
+ * @param location                    Score-P location
+ * @param callchain                   The sampled instruction address followed
+ *                                    by the return addresses of its callers
+ * @param callchainDepth              Number of elements in @a callchain
+ * @param[out] currentCallingContext  Handle of the current calling context,
+ *                                    SCOREP_INVALID_CALLING_CONTEXT if the
+ *                                    sample should be ignored
+ * @param[out] previousCallingContext Handle of the last known calling context
+ * @param[out] unwindDistance         Number of stack levels changed since the last sample
+ */
+void
+SCOREP_Unwinding_GetCallchainCallingContext( SCOREP_Location*             location,
+                                             const uint64_t*              callchain,
+                                             uint32_t                     callchainDepth,
+                                             SCOREP_CallingContextHandle* currentCallingContext,
+                                             SCOREP_CallingContextHandle* previousCallingContext,
+                                             uint32_t*                    unwindDistance );
+
+/**
+ * Callback which records the samples collected for @a location since its
+ * last call, see SCOREP_Unwinding_SetSampleDrain().
+ */
+typedef void ( * SCOREP_Unwinding_SampleDrainCb )( SCOREP_Location* location,
+                                                   void*            drainArg );
+
+/**
+ * Set once a sample drain is registered, see SCOREP_Unwinding_SetSampleDrain().
+ * Until then, the event functions do not call SCOREP_Unwinding_DrainSamples().
+ */
+extern bool scorep_unwinding_has_sample_drains;
+
+/**
+ * Register a callback which records the deferred samples of the CPU location
+ * @a location, i.e., samples which were buffered instead of being recorded
+ * in the signal context. Pass NULL as @a drainCb to remove the callback.
+ *
+ * @param location                    Score-P CPU location
+ * @param drainCb                     The callback
+ * @param drainArg                    Passed to @a drainCb
+ */
+void
+SCOREP_Unwinding_SetSampleDrain( SCOREP_Location*               location,
+                                 SCOREP_Unwinding_SampleDrainCb drainCb,
+                                 void*                          drainArg );
+
+/**
+ * Record the deferred samples of the CPU location @a location.
+ *
+ * Called before the instrumented regions of @a location change, i.e., before
+ * the timestamp of an enter or exit event is taken and when the location is
+ * deactivated, thus deferred samples get the same calling context as if they
+ * were unwound in the signal context.
+ *
+ * @param location                    Score-P CPU location
+ */
+void
+SCOREP_Unwinding_DrainSamples( SCOREP_Location* location );
+
 void
 SCOREP_Unwinding_ProcessCallingContext( SCOREP_Location*                location,
                                         uint64_t                        timestamp,
@@ -47,6 +47,8 @@
 
 #include "scorep_metric_perf_confvars.inc.c"
 
+#include "scorep_metric_system_confvars.inc.c"
+
 static SCOREP_ErrorCode
 metric_subsystem_register( size_t subsystem_id )
 {
@@ -62,6 +64,9 @@ metric_subsystem_register( size_t subsystem_id )
     SCOREP_ConfigRegisterCond( "metric",
                                scorep_metric_perf_confvars,
                                HAVE_BACKEND_METRIC_PERF );
+    SCOREP_ConfigRegisterCond( "metric",
+                               scorep_metric_system_confvars,
+                               HAVE_BACKEND_METRIC_SYSTEM_SAMPLER );
 
     return SCOREP_SUCCESS;
 }
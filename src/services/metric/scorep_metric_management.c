@@ -85,6 +85,9 @@
 #if HAVE( METRIC_PERF )
 #include "scorep_metric_perf.h"
 #endif
+#if HAVE( METRIC_SYSTEM_SAMPLER )
+#include "scorep_metric_system.h"
+#endif
 
 #include <unistd.h>
 #include <sys/types.h>
@@ -102,7 +105,10 @@ static const SCOREP_MetricSource* scorep_metric_sources[] = {
     &SCOREP_Metric_Plugins,
 #endif
 #if HAVE( METRIC_PERF )
-    &SCOREP_Metric_Perf
+    &SCOREP_Metric_Perf,
+#endif
+#if HAVE( METRIC_SYSTEM_SAMPLER )
+    &SCOREP_Metric_System
 #endif
 };
 
@@ -332,18 +338,18 @@ cleanup_asynchronous_metric_set( SCOREP_Metric_LocationAsynchronousMetricSet* as
     {
         if ( asyncMetricSet->metrics_counts[ source_index ] > 0 )
         {
-            for ( uint32_t metric_index = 0;
-                  metric_index < asyncMetricSet->metrics_counts[ source_index ];
-                  metric_index++ )
+            if ( asyncMetricSet->time_value_pairs[ source_index ] != NULL )
             {
-                if ( asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] != NULL )
+                for ( uint32_t metric_index = 0;
+                      metric_index < asyncMetricSet->metrics_counts[ source_index ];
+                      metric_index++ )
                 {
-                    free( asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] );
-                    asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] = NULL;
+                    if ( asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] != NULL )
+                    {
+                        free( asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] );
+                        asyncMetricSet->time_value_pairs[ source_index ][ metric_index ] = NULL;
+                    }
                 }
-            }
-            if ( asyncMetricSet->time_value_pairs[ source_index ] != NULL )
-            {
                 free( asyncMetricSet->time_value_pairs[ source_index ] );
                 asyncMetricSet->time_value_pairs[ source_index ] = NULL;
             }
@@ -43,6 +43,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/syscall.h>
 
 #include "SCOREP_Metric_Source.h"
@@ -60,6 +61,11 @@
 #define PER_PROCESS_METRIC          1
 #define MAX_METRIC_INDEX            2
 
+/* Counters can be read in user space with rdpmc, if the kernel allows it */
+#if ( defined( __GNUC__ ) || defined( __ICC ) || defined( __PGI ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define HAVE_METRIC_PERF_RDPMC 1
+#endif
+
 /** @defgroup SCOREP_Metric_PERF SCOREP PERF Metric Source
  *  @ingroup SCOREP_Metric
  *
@@ -82,6 +88,10 @@
  *
  *  In addition it is possible to specify metrics that will be recorded per-process. Please use
  *  \c SCOREP_METRIC_PERF_PER_PROCESS for that reason.
+ *
+ *  On x86, hardware counters are read in user space with the rdpmc instruction
+ *  if the kernel permits it, which avoids a read() system call per enter and
+ *  exit. This can be disabled with \c SCOREP_METRIC_PERF_RDPMC=false.
  */
 
 /**
@@ -124,6 +134,10 @@ typedef struct scorep_event_map
     int      num_events;
     /** Component identifier */
     int      component;
+    /** File descriptors of the events in this set, in the order of @a values */
+    int      event_fds[ SCOREP_METRIC_MAXNUM ];
+    /** Mapped control pages of the events, NULL if counters cannot be read in user space */
+    struct perf_event_mmap_page* pages[ SCOREP_METRIC_MAXNUM ];
 } scorep_event_map;
 
 /**
@@ -181,6 +195,15 @@ metric_perf_error( int   errcode,
 static scorep_perf_metric
 metric_perf_create_event_code( char* name );
 
+static void
+metric_perf_map_pages( scorep_event_map* eventMap );
+
+static void
+metric_perf_unmap_pages( scorep_event_map* eventMap );
+
+static void
+metric_perf_read( scorep_event_map* eventMap );
+
 
 
 /* *********************************************************************
@@ -598,7 +621,8 @@ metric_perf_create_event_set( scorep_metric_definition_data* definitions )
                 event_set->event_map[ j ]->component = component;
                 event_map                            = event_set->event_map[ j ];
                 /* we have to think of the offset (1) that is needed for reading a group of PERF events */
-                event_set->values[ i ] = &( event_map->values[ event_map->num_events + 1 ] );
+                event_set->values[ i ]                        = &( event_map->values[ event_map->num_events + 1 ] );
+                event_map->event_fds[ event_map->num_events ] = event_map->event_fd;
                 event_map->num_events++;
             }
         }
@@ -613,7 +637,8 @@ metric_perf_create_event_set( scorep_metric_definition_data* definitions )
             {
                 event_map = event_set->event_map[ j ];
                 /* we have to think of the offset (1) that is needed for reading a group of PERF events */
-                event_set->values[ i ] = &( event_map->values[ event_map->num_events + 1 ] );
+                event_set->values[ i ]                        = &( event_map->values[ event_map->num_events + 1 ] );
+                event_map->event_fds[ event_map->num_events ] = fd;
                 event_map->num_events++;
             }
         }
@@ -628,11 +653,139 @@ metric_perf_create_event_set( scorep_metric_definition_data* definitions )
         {
             metric_perf_error( errno, "ioctl( fd, PERF_EVENT_IOC_ENABLE )" );
         }
+
+        metric_perf_map_pages( event_set->event_map[ i ] );
     }
 
     return event_set;
 }
 
+/** @brief Maps the control page of each event in @a eventMap, which allows
+ *         to read the counters in user space. Leaves all pages unmapped if
+ *         this is not possible.
+ */
+static void
+metric_perf_map_pages( scorep_event_map* eventMap )
+{
+    memset( eventMap->pages, 0, sizeof( eventMap->pages ) );
+
+#if HAVE( METRIC_PERF_RDPMC )
+    if ( !scorep_metrics_perf_rdpmc )
+    {
+        return;
+    }
+
+    size_t page_size = sysconf( _SC_PAGESIZE );
+    for ( int i = 0; i < eventMap->num_events; i++ )
+    {
+        void* page = mmap( NULL, page_size, PROT_READ, MAP_SHARED, eventMap->event_fds[ i ], 0 );
+        if ( page == MAP_FAILED )
+        {
+            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, "[PERF] Cannot map event page, using read(): %s",
+                                strerror( errno ) );
+            metric_perf_unmap_pages( eventMap );
+            return;
+        }
+        eventMap->pages[ i ] = page;
+    }
+#endif /* HAVE( METRIC_PERF_RDPMC ) */
+}
+
+/** @brief Unmaps the control pages of all events in @a eventMap.
+ */
+static void
+metric_perf_unmap_pages( scorep_event_map* eventMap )
+{
+    size_t page_size = sysconf( _SC_PAGESIZE );
+    for ( int i = 0; i < eventMap->num_events && eventMap->pages[ i ] != NULL; i++ )
+    {
+        munmap( eventMap->pages[ i ], page_size );
+        eventMap->pages[ i ] = NULL;
+    }
+}
+
+#if HAVE( METRIC_PERF_RDPMC )
+static inline uint64_t
+metric_perf_rdpmc( uint32_t counter )
+{
+    uint32_t low, high;
+    __asm__ __volatile__ ( "rdpmc" : "=a" ( low ), "=d" ( high ) : "c" ( counter ) );
+    return ( uint64_t )low | ( ( uint64_t )high << 32 );
+}
+
+/** @brief Reads all counters of @a eventMap in user space, following the
+ *         protocol described for struct perf_event_mmap_page in
+ *         linux/perf_event.h. The kernel updates the page under a sequence
+ *         lock, we retry if it changed while we read.
+ *
+ *  @return false if any counter is not readable in user space right now, e.g.,
+ *          because it is not scheduled on the PMU or the kernel disallows
+ *          rdpmc. The caller needs to fall back to read() then.
+ */
+static bool
+metric_perf_read_user( scorep_event_map* eventMap )
+{
+    for ( int i = 0; i < eventMap->num_events; i++ )
+    {
+        volatile struct perf_event_mmap_page* page = eventMap->pages[ i ];
+        uint32_t                              seq;
+        uint64_t                              count;
+        do
+        {
+            seq = page->lock;
+            __asm__ __volatile__ ( "" ::: "memory" );
+
+            /* An index of 0 means the counter is currently not on the PMU,
+             * e.g., multiplexed out. Like read() without
+             * PERF_FORMAT_TOTAL_TIME_ENABLED we do not scale the value by
+             * time_enabled/time_running. */
+            uint32_t index = page->index;
+            if ( !page->cap_user_rdpmc || index == 0 )
+            {
+                return false;
+            }
+
+            count = page->offset;
+            uint16_t width = page->pmc_width;
+            int64_t  pmc   = metric_perf_rdpmc( index - 1 );
+            /* sign-extend the raw counter value to 64 bit */
+            pmc  <<= 64 - width;
+            pmc  >>= 64 - width;
+            count += pmc;
+
+            __asm__ __volatile__ ( "" ::: "memory" );
+        }
+        while ( page->lock != seq );
+
+        eventMap->values[ i + 1 ] = count;
+    }
+    eventMap->values[ 0 ] = eventMap->num_events;
+
+    return true;
+}
+#endif /* HAVE( METRIC_PERF_RDPMC ) */
+
+/** @brief Reads the counters of @a eventMap into its value buffer, with
+ *         rdpmc if possible, otherwise with one read() of the group.
+ */
+static void
+metric_perf_read( scorep_event_map* eventMap )
+{
+#if HAVE( METRIC_PERF_RDPMC )
+    if ( eventMap->pages[ 0 ] != NULL && metric_perf_read_user( eventMap ) )
+    {
+        return;
+    }
+#endif /* HAVE( METRIC_PERF_RDPMC ) */
+
+    size_t size   = ( eventMap->num_events + 1 ) * sizeof( uint64_t );
+    int    retval = read( eventMap->event_fd, eventMap->values, size );
+    if ( retval != size )
+    {
+        metric_perf_error( retval, "PERF read" );
+    }
+}
+
 /** @brief Adds a new metric to internally managed vector.
  */
 static void
@@ -957,16 +1110,10 @@ strictly_synchronous_read( SCOREP_Metric_EventSet* eventSet,
     UTILS_ASSERT( eventSet );
     UTILS_ASSERT( values );
 
-    int retval;
-
     /* For each used eventset */
     for ( uint32_t i = 0; i < SCOREP_METRIC_MAXNUM && eventSet->event_map[ i ] != NULL; i++ )
     {
-        retval = read( eventSet->event_map[ i ]->event_fd, eventSet->event_map[ i ]->values, ( eventSet->event_map[ i ]->num_events + 1 ) * sizeof( uint64_t ) );
-        if ( retval != ( eventSet->event_map[ i ]->num_events + 1 ) * sizeof( uint64_t ) )
-        {
-            metric_perf_error( retval, "PERF read" );
-        }
+        metric_perf_read( eventSet->event_map[ i ] );
     }
 
     for ( uint32_t i = 0; i < eventSet->definitions->number_of_metrics; i++ )
@@ -997,16 +1144,10 @@ synchronous_read( SCOREP_Metric_EventSet* eventSet,
     UTILS_ASSERT( values );
     UTILS_ASSERT( isUpdated );
 
-    int retval;
-
     /* For each used eventset */
     for ( uint32_t i = 0; i < SCOREP_METRIC_MAXNUM && eventSet->event_map[ i ] != NULL; i++ )
     {
-        retval = read( eventSet->event_map[ i ]->event_fd, eventSet->event_map[ i ]->values, ( eventSet->event_map[ i ]->num_events + 1 ) * sizeof( uint64_t ) );
-        if ( retval != ( eventSet->event_map[ i ]->num_events + 1 ) * sizeof( uint64_t ) )
-        {
-            metric_perf_error( retval, "PERF read" );
-        }
+        metric_perf_read( eventSet->event_map[ i ] );
     }
 
     for ( uint32_t i = 0; i < eventSet->definitions->number_of_metrics; i++ )
@@ -1034,6 +1175,8 @@ free_event_set( SCOREP_Metric_EventSet* eventSet )
     /* For each used event map */
     for ( uint32_t i = 0; i < SCOREP_METRIC_MAXNUM && eventSet->event_map[ i ] != NULL; i++ )
     {
+        metric_perf_unmap_pages( eventSet->event_map[ i ] );
+
         int retval = ioctl( eventSet->event_map[ i ]->event_fd, PERF_EVENT_IOC_DISABLE );
         if ( retval )
         {
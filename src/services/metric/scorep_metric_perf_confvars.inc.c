@@ -30,6 +30,9 @@ static char* scorep_metrics_perf_per_process = NULL;
 /** Contains the separator of metric names. */
 static char* scorep_metrics_perf_separator = NULL;
 
+/** Whether counters are read in user space with rdpmc if possible. */
+static bool scorep_metrics_perf_rdpmc = true;
+
 /**
  *  List of configuration variables for the PERF metric adapter.
  *
@@ -41,6 +44,7 @@ static char* scorep_metrics_perf_separator = NULL;
  *  @li @c SCOREP_METRIC_PERF list of requested metric names.
  *  @li @c SCOREP_METRIC_PERF_PER_PROCESS list of requested metric names recorded per-process.
  *  @li @c SCOREP_METRIC_PERF_SEP character that separates single metric names.
+ *  @li @c SCOREP_METRIC_PERF_RDPMC read counters in user space if possible.
  */
 static const SCOREP_ConfigVariable scorep_metric_perf_confvars[] = {
     {
@@ -71,5 +75,18 @@ static const SCOREP_ConfigVariable scorep_metric_perf_confvars[] = {
         "Character that separates metric names in SCOREP_METRIC_PERF and "
         "SCOREP_METRIC_PERF_PER_PROCESS."
     },
+    {
+        "perf_rdpmc",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_metrics_perf_rdpmc,
+        NULL,
+        "true",
+        "Read PERF counters in user space",
+        "Read hardware counters with the rdpmc instruction from the mapped "
+        "perf event page instead of issuing a read() system call on every "
+        "enter and exit. Falls back to read() if the kernel does not permit "
+        "user-space access or a counter is currently not scheduled. Only "
+        "available on x86."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
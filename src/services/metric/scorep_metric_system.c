@@ -0,0 +1,937 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ *
+ *  @file
+ *
+ *
+ *  @brief This module implements support for system metrics sampled by a
+ *         background thread.
+ */
+
+#include <config.h>
+
+#include "SCOREP_Metric_Source.h"
+#include "scorep_metric_system.h"
+
+#include <SCOREP_Atomic.h>
+#include <SCOREP_InMeasurement.h>
+#include <SCOREP_Timer_Ticks.h>
+
+#include <UTILS_Debug.h>
+#include <UTILS_Error.h>
+#include <UTILS_CStr.h>
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @defgroup SCOREP_Metric_SYSTEM System Metric Source
+ *  @ingroup SCOREP_Metric
+ *
+ *  This metric source provides process- and node-level information of the
+ *  operating system, which is not available through \c getrusage, e.g., the
+ *  I/O volume of the process from \c /proc/self/io, the load average, the
+ *  available memory and the memory pressure of the node, and the used memory
+ *  of each NUMA node.
+ *
+ *  The values are not read at the events of the application. A background
+ *  thread with the lowest scheduling priority samples them every
+ *  \c SCOREP_METRIC_SYSTEM_INTERVAL microseconds into a ring buffer. The first
+ *  thread of each process writes the buffered samples as asynchronous metrics
+ *  at its next event, thus they only appear in traces.
+ *
+ *  You can enable recording of system metrics by setting the environment variable
+ *  \c SCOREP_METRIC_SYSTEM to a comma-separated list of metric names, e.g.,
+ *  @verbatim SCOREP_METRIC_SYSTEM=io_read_bytes,io_write_bytes,loadavg @endverbatim
+ *  or to \c all to record all metrics available on this system. Metrics
+ *  whose source is not available on this system, e.g., the memory pressure
+ *  on kernels without PSI support, are ignored with a warning.
+ *
+ *  The sampler reads the @c /proc files itself, thus the rchar metric
+ *  includes a few kilobytes per sample.
+ */
+
+/** Number of samples the ring buffer can hold, needs to be a power of two */
+#define RING_BUFFER_SAMPLES 1024
+
+/** Size of the buffer for the content of a single file */
+#define FILE_BUFFER_SIZE 4096
+
+/** Directory with an entry per NUMA node */
+#define NODE_DIRECTORY "/sys/devices/system/node"
+
+/** Path of the meminfo file of a NUMA node */
+#define NODE_MEMINFO_PATH NODE_DIRECTORY "/node%u/meminfo"
+
+
+/** Specification of a system metric */
+typedef struct system_metric_spec
+{
+    /** Name of this metric */
+    const char*       name;
+    /** File which contains the value of this metric */
+    const char*       path;
+    /** Text in front of the value in the file, NULL if the value comes first */
+    const char*       key;
+    /** Factor to convert the value into the unit, 0 if it is a fractional number */
+    uint64_t          scale;
+    /** Whether the metric is provided per NUMA node, @a path is then a format */
+    bool              per_numa_node;
+    /** Mode of this metric (absolute or accumulated) */
+    SCOREP_MetricMode mode;
+    /** Base unit of this metric */
+    const char*       unit;
+    /** Longer description of this metric */
+    const char*       description;
+} system_metric_spec;
+
+
+static const system_metric_spec system_metric_specs[] =
+{
+    {
+        "io_rchar", "/proc/self/io", "rchar:", 1, false,
+        SCOREP_METRIC_MODE_ACCUMULATED_START, "bytes",
+        "Bytes read by the process with read() and similar system calls"
+    },
+    {
+        "io_wchar", "/proc/self/io", "wchar:", 1, false,
+        SCOREP_METRIC_MODE_ACCUMULATED_START, "bytes",
+        "Bytes written by the process with write() and similar system calls"
+    },
+    {
+        "io_read_bytes", "/proc/self/io", "read_bytes:", 1, false,
+        SCOREP_METRIC_MODE_ACCUMULATED_START, "bytes",
+        "Bytes the process caused to be fetched from the storage layer"
+    },
+    {
+        "io_write_bytes", "/proc/self/io", "write_bytes:", 1, false,
+        SCOREP_METRIC_MODE_ACCUMULATED_START, "bytes",
+        "Bytes the process caused to be sent to the storage layer"
+    },
+    {
+        "loadavg", "/proc/loadavg", NULL, 0, false,
+        SCOREP_METRIC_MODE_ABSOLUTE_POINT, "#",
+        "System load average of the last minute"
+    },
+    {
+        "mem_available", "/proc/meminfo", "MemAvailable:", 1024, false,
+        SCOREP_METRIC_MODE_ABSOLUTE_POINT, "bytes",
+        "Memory available on the node for new allocations without swapping"
+    },
+    {
+        "mem_pressure", "/proc/pressure/memory", "some avg10=", 0, false,
+        SCOREP_METRIC_MODE_ABSOLUTE_POINT, "%",
+        "Share of the last 10 seconds in which at least one task stalled on memory"
+    },
+    {
+        "numa_mem_used", NODE_MEMINFO_PATH, "MemUsed:", 1024, true,
+        SCOREP_METRIC_MODE_ABSOLUTE_POINT, "bytes",
+        "Used memory of the NUMA node"
+    }
+};
+
+#define NUMBER_OF_SPECS ( sizeof( system_metric_specs ) / sizeof( system_metric_specs[ 0 ] ) )
+
+
+/** A file which is read at every sample */
+typedef struct system_file
+{
+    char* path;
+    int   fd;
+} system_file;
+
+
+/** A requested metric */
+typedef struct system_metric
+{
+    const system_metric_spec* spec;
+    char*                     name;
+    char*                     description;
+    /** Index into @a files */
+    uint32_t                  file;
+    /** Value at the start of the measurement for accumulated metrics */
+    uint64_t                  start_value;
+} system_metric;
+
+
+/** All requested metrics of the process share the same event set */
+struct SCOREP_Metric_EventSet
+{
+    uint32_t  number_of_metrics;
+    /** The sample being taken, the timestamp followed by the values */
+    uint64_t* sample;
+    /** Contents of all @a files, FILE_BUFFER_SIZE bytes each */
+    char*     file_buffers;
+};
+
+
+/* *********************************************************************
+ * Global variables
+ **********************************************************************/
+
+#include "scorep_metric_system_confvars.inc.c"
+
+static bool           system_initialized;
+static system_metric* metrics;
+static uint32_t       number_of_metrics;
+static system_file*   files;
+static uint32_t       number_of_files;
+
+static SCOREP_Metric_EventSet event_set;
+
+/** Samples of the background thread. Each sample holds the timestamp
+ *  followed by the values of all metrics. The sampler is the only writer of
+ *  @a ring_head and the first thread of the process the only writer of
+ *  @a ring_tail, thus no lock is needed. */
+static uint64_t* ring;
+static uint64_t  ring_head;
+static uint64_t  ring_tail;
+static uint64_t  dropped_samples;
+
+static pthread_mutex_t sampler_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  sampler_wakeup;
+static pthread_t       sampler_thread;
+static bool            sampler_running;
+static bool            sampler_stop;
+
+
+/* *********************************************************************
+ * Reading of system files
+ **********************************************************************/
+
+static uint32_t
+add_file( const char* path )
+{
+    for ( uint32_t i = 0; i < number_of_files; i++ )
+    {
+        if ( strcmp( files[ i ].path, path ) == 0 )
+        {
+            return i;
+        }
+    }
+
+    int fd = open( path, O_RDONLY );
+    if ( fd == -1 )
+    {
+        return UINT32_MAX;
+    }
+
+    files = realloc( files, ( number_of_files + 1 ) * sizeof( *files ) );
+    UTILS_BUG_ON( files == NULL, "Failed to allocate memory for system metric files." );
+    files[ number_of_files ].path = UTILS_CStr_dup( path );
+    files[ number_of_files ].fd   = fd;
+    return number_of_files++;
+}
+
+
+/** The proc and sysfs files are generated at read time, reading at offset 0
+ *  gives the current values without reopening the file. */
+static bool
+read_file( const system_file* file,
+           char*              buffer )
+{
+    ssize_t length = pread( file->fd, buffer, FILE_BUFFER_SIZE - 1, 0 );
+    if ( length < 0 )
+    {
+        buffer[ 0 ] = '\0';
+        return false;
+    }
+    buffer[ length ] = '\0';
+    return true;
+}
+
+
+static uint64_t
+parse_value( const system_metric_spec* spec,
+             const char*               content )
+{
+    const char* position = content;
+    if ( spec->key )
+    {
+        position = strstr( content, spec->key );
+        if ( !position )
+        {
+            return 0;
+        }
+        position += strlen( spec->key );
+    }
+
+    if ( spec->scale == 0 )
+    {
+        double   value = strtod( position, NULL );
+        uint64_t bits;
+        memcpy( &bits, &value, sizeof( bits ) );
+        return bits;
+    }
+    return strtoull( position, NULL, 10 ) * spec->scale;
+}
+
+
+/** Reads all metrics into @a values, using @a buffers for the file contents */
+static void
+read_values( uint64_t* values,
+             char*     buffers )
+{
+    for ( uint32_t i = 0; i < number_of_files; i++ )
+    {
+        read_file( &files[ i ], buffers + ( size_t )i * FILE_BUFFER_SIZE );
+    }
+    for ( uint32_t i = 0; i < number_of_metrics; i++ )
+    {
+        values[ i ] = parse_value( metrics[ i ].spec,
+                                   buffers + ( size_t )metrics[ i ].file * FILE_BUFFER_SIZE );
+        if ( metrics[ i ].spec->mode == SCOREP_METRIC_MODE_ACCUMULATED_START )
+        {
+            values[ i ] -= metrics[ i ].start_value;
+        }
+    }
+}
+
+
+/* *********************************************************************
+ * Metric selection
+ **********************************************************************/
+
+static void
+add_metric( const system_metric_spec* spec,
+            const char*               path,
+            const char*               name,
+            const char*               description )
+{
+    uint32_t file = add_file( path );
+    if ( file == UINT32_MAX )
+    {
+        UTILS_WARNING( "System metric '%s' is not available, cannot open '%s': %s",
+                       name, path, strerror( errno ) );
+        return;
+    }
+
+    metrics = realloc( metrics, ( number_of_metrics + 1 ) * sizeof( *metrics ) );
+    UTILS_BUG_ON( metrics == NULL, "Failed to allocate memory for system metrics." );
+    metrics[ number_of_metrics ].spec        = spec;
+    metrics[ number_of_metrics ].name        = UTILS_CStr_dup( name );
+    metrics[ number_of_metrics ].description = UTILS_CStr_dup( description );
+    metrics[ number_of_metrics ].file        = file;
+    metrics[ number_of_metrics ].start_value = 0;
+    number_of_metrics++;
+}
+
+
+static void
+add_numa_node_metrics( const system_metric_spec* spec )
+{
+    bool found = false;
+    DIR* nodes = opendir( NODE_DIRECTORY );
+    if ( nodes )
+    {
+        struct dirent* entry;
+        while ( ( entry = readdir( nodes ) ) != NULL )
+        {
+            unsigned node;
+            char     suffix;
+            if ( sscanf( entry->d_name, "node%u%c", &node, &suffix ) != 1 )
+            {
+                continue;
+            }
+            found = true;
+
+            char path[ 128 ];
+            snprintf( path, sizeof( path ), spec->path, node );
+            char name[ 64 ];
+            snprintf( name, sizeof( name ), "numa%u_%s", node, spec->name + strlen( "numa_" ) );
+            char description[ 128 ];
+            snprintf( description, sizeof( description ), "%s %u", spec->description, node );
+            add_metric( spec, path, name, description );
+        }
+        closedir( nodes );
+    }
+    if ( !found )
+    {
+        UTILS_WARNING( "System metric '%s' is not available, no NUMA node information found.",
+                       spec->name );
+    }
+}
+
+
+static void
+add_spec( const system_metric_spec* spec )
+{
+    if ( spec->per_numa_node )
+    {
+        add_numa_node_metrics( spec );
+    }
+    else
+    {
+        add_metric( spec, spec->path, spec->name, spec->description );
+    }
+}
+
+
+static void
+open_metrics( const char* listOfMetricNames,
+              const char* metricsSeparator )
+{
+    char* env_metrics = UTILS_CStr_dup( listOfMetricNames );
+    for ( char* c = env_metrics; *c; c++ )
+    {
+        *c = tolower( *c );
+    }
+
+    if ( strcmp( env_metrics, "all" ) == 0 )
+    {
+        for ( size_t i = 0; i < NUMBER_OF_SPECS; i++ )
+        {
+            add_spec( &system_metric_specs[ i ] );
+        }
+    }
+    else
+    {
+        for ( char* token = strtok( env_metrics, metricsSeparator );
+              token;
+              token = strtok( NULL, metricsSeparator ) )
+        {
+            size_t i = 0;
+            while ( i < NUMBER_OF_SPECS && strcmp( system_metric_specs[ i ].name, token ) != 0 )
+            {
+                i++;
+            }
+            UTILS_BUG_ON( i == NUMBER_OF_SPECS,
+                          "Invalid system metric name ('%s') specified. "
+                          "Please use 'scorep-info config-vars --full' to get "
+                          "a list of available system metrics.", token );
+            add_spec( &system_metric_specs[ i ] );
+        }
+    }
+
+    free( env_metrics );
+}
+
+
+/* *********************************************************************
+ * Sampler thread
+ **********************************************************************/
+
+static void
+take_sample( uint64_t* sample,
+             char*     buffers )
+{
+    sample[ 0 ] = SCOREP_Timer_GetClockTicks();
+    read_values( sample + 1, buffers );
+
+    uint64_t head = SCOREP_ATOMIC_LOAD( &ring_head, SCOREP_ATOMIC_RELAXED );
+    uint64_t tail = SCOREP_ATOMIC_LOAD( &ring_tail, SCOREP_ATOMIC_ACQUIRE );
+    if ( head - tail == RING_BUFFER_SAMPLES )
+    {
+        /* The first thread had no event for a long time */
+        dropped_samples++;
+        return;
+    }
+
+    memcpy( ring + ( head & ( RING_BUFFER_SAMPLES - 1 ) ) * ( number_of_metrics + 1 ),
+            sample,
+            ( number_of_metrics + 1 ) * sizeof( uint64_t ) );
+    SCOREP_ATOMIC_STORE( &ring_head, head + 1, SCOREP_ATOMIC_RELEASE );
+}
+
+
+static void*
+sampler_main( void* arg )
+{
+    /* This thread does not belong to the measurement, let all wrapped
+     * calls pass through. */
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    /* Neither compete with the application for the CPU, nor take its signals */
+#if defined( SCHED_IDLE )
+    struct sched_param param = { 0 };
+    pthread_setschedparam( pthread_self(), SCHED_IDLE, &param );
+#endif
+    sigset_t all_signals;
+    sigfillset( &all_signals );
+    pthread_sigmask( SIG_BLOCK, &all_signals, NULL );
+
+    struct timespec deadline;
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
+
+    pthread_mutex_lock( &sampler_mutex );
+    while ( !sampler_stop )
+    {
+        pthread_mutex_unlock( &sampler_mutex );
+        take_sample( event_set.sample, event_set.file_buffers );
+        pthread_mutex_lock( &sampler_mutex );
+
+        deadline.tv_sec  += scorep_metric_system_interval / 1000000;
+        deadline.tv_nsec += ( scorep_metric_system_interval % 1000000 ) * 1000;
+        if ( deadline.tv_nsec >= 1000000000 )
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        while ( !sampler_stop
+                && pthread_cond_timedwait( &sampler_wakeup, &sampler_mutex, &deadline ) != ETIMEDOUT )
+        {
+        }
+    }
+    pthread_mutex_unlock( &sampler_mutex );
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return NULL;
+}
+
+
+static void
+start_sampler( void )
+{
+    pthread_mutex_lock( &sampler_mutex );
+    if ( sampler_running || sampler_stop )
+    {
+        pthread_mutex_unlock( &sampler_mutex );
+        return;
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init( &attr );
+    pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );
+    pthread_cond_init( &sampler_wakeup, &attr );
+    pthread_condattr_destroy( &attr );
+
+    if ( 0 != pthread_create( &sampler_thread, NULL, sampler_main, NULL ) )
+    {
+        UTILS_WARNING( "Could not create system metric sampler thread, "
+                       "system metrics will not be recorded." );
+        pthread_cond_destroy( &sampler_wakeup );
+        sampler_stop = true;
+        pthread_mutex_unlock( &sampler_mutex );
+        return;
+    }
+    sampler_running = true;
+    pthread_mutex_unlock( &sampler_mutex );
+}
+
+
+static void
+stop_sampler( void )
+{
+    pthread_mutex_lock( &sampler_mutex );
+    if ( !sampler_running )
+    {
+        pthread_mutex_unlock( &sampler_mutex );
+        return;
+    }
+    sampler_stop = true;
+    pthread_cond_signal( &sampler_wakeup );
+    pthread_mutex_unlock( &sampler_mutex );
+
+    pthread_join( sampler_thread, NULL );
+    pthread_cond_destroy( &sampler_wakeup );
+    sampler_running = false;
+
+    if ( dropped_samples )
+    {
+        UTILS_WARNING( "Dropped %" PRIu64 " samples of system metrics, because the "
+                       "first thread of the process had no event for a long time. "
+                       "Consider to increase SCOREP_METRIC_SYSTEM_INTERVAL.",
+                       dropped_samples );
+    }
+}
+
+
+/* *********************************************************************
+ * Metric source management
+ **********************************************************************/
+
+/** @brief  Registers configuration variables for the metric sources.
+ *
+ *  @return It returns SCOREP_SUCCESS if successful,
+ *          otherwise an error code will be reported.
+ */
+static SCOREP_ErrorCode
+scorep_metric_system_register( void )
+{
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " register system metric source!" );
+
+    SCOREP_ErrorCode status = SCOREP_ConfigRegister( "metric", scorep_metric_system_confvars );
+    if ( status != SCOREP_SUCCESS )
+    {
+        UTILS_WARNING( "Registration of system metric configuration variables failed." );
+    }
+
+    return status;
+}
+
+/** @brief Called on deregistration of the metric source.
+ */
+static void
+scorep_metric_system_deregister( void )
+{
+    free( scorep_metric_system );
+    free( scorep_metric_system_separator );
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " system metric source deregister!" );
+}
+
+/** @brief  Initialize system metric source.
+ *
+ *  Opens the files of the requested metrics. System metrics are only
+ *  recorded per-process, thus there are no 'strictly synchronous' ones.
+ *
+ *  @return Returns 0, the number of used 'synchronous strict' metrics.
+ */
+static uint32_t
+scorep_metric_system_initialize_source( void )
+{
+    if ( system_initialized )
+    {
+        return 0;
+    }
+    system_initialized = true;
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, "[SYSTEM] per-process metrics = %s", scorep_metric_system );
+    open_metrics( scorep_metric_system, scorep_metric_system_separator );
+    if ( number_of_metrics == 0 )
+    {
+        return 0;
+    }
+
+    if ( scorep_metric_system_interval == 0 )
+    {
+        UTILS_WARNING( "Invalid SCOREP_METRIC_SYSTEM_INTERVAL of 0, using 1 microsecond." );
+        scorep_metric_system_interval = 1;
+    }
+
+    ring = malloc( RING_BUFFER_SAMPLES * ( number_of_metrics + 1 ) * sizeof( uint64_t ) );
+    UTILS_BUG_ON( ring == NULL, "Failed to allocate memory for system metric samples." );
+    ring_head       = 0;
+    ring_tail       = 0;
+    dropped_samples = 0;
+    sampler_stop    = false;
+
+    /* Used by the sampler thread for every sample */
+    event_set.number_of_metrics = number_of_metrics;
+    event_set.sample            = malloc( ( number_of_metrics + 1 ) * sizeof( uint64_t ) );
+    event_set.file_buffers      = malloc( ( size_t )number_of_files * FILE_BUFFER_SIZE );
+    UTILS_BUG_ON( event_set.sample == NULL || event_set.file_buffers == NULL,
+                  "Failed to allocate memory for system metric values." );
+
+    /* Accumulated metrics start at 0, the sampler is not yet running */
+    uint64_t* values = event_set.sample + 1;
+    read_values( values, event_set.file_buffers );
+    for ( uint32_t i = 0; i < number_of_metrics; i++ )
+    {
+        if ( metrics[ i ].spec->mode == SCOREP_METRIC_MODE_ACCUMULATED_START )
+        {
+            metrics[ i ].start_value = values[ i ];
+        }
+    }
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " initialization of system metric source done." );
+    return 0;
+}
+
+/** @brief Metric source finalization.
+ */
+static void
+scorep_metric_system_finalize_source( void )
+{
+    if ( !system_initialized )
+    {
+        return;
+    }
+
+    stop_sampler();
+
+    for ( uint32_t i = 0; i < number_of_metrics; i++ )
+    {
+        free( metrics[ i ].name );
+        free( metrics[ i ].description );
+    }
+    free( metrics );
+    metrics           = NULL;
+    number_of_metrics = 0;
+    for ( uint32_t i = 0; i < number_of_files; i++ )
+    {
+        close( files[ i ].fd );
+        free( files[ i ].path );
+    }
+    free( files );
+    files           = NULL;
+    number_of_files = 0;
+    free( ring );
+    ring = NULL;
+    free( event_set.sample );
+    free( event_set.file_buffers );
+    event_set.sample       = NULL;
+    event_set.file_buffers = NULL;
+
+    event_set.number_of_metrics = 0;
+    system_initialized          = false;
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " finalize system metric source." );
+}
+
+/** @brief  Location specific initialization function for metric sources.
+ *
+ *  System metrics are asynchronous per-process metrics. The management
+ *  asks only the first location of the process for them.
+ */
+static SCOREP_Metric_EventSet*
+scorep_metric_system_initialize_location( struct SCOREP_Location*    locationData,
+                                          SCOREP_MetricSynchronicity syncType,
+                                          SCOREP_MetricPer           metricType )
+{
+    if ( syncType == SCOREP_METRIC_ASYNC_EVENT
+         && metricType == SCOREP_METRIC_PER_PROCESS
+         && number_of_metrics > 0 )
+    {
+        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, "[SYSTEM] This location will record per-process metrics." );
+        return &event_set;
+    }
+
+    return NULL;
+}
+
+/** @brief Location specific finalization function for metric sources.
+ *
+ *  @param eventSet  Reference to active set of metrics.
+ */
+static void
+scorep_metric_system_finalize_location( SCOREP_Metric_EventSet* eventSet )
+{
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " metric source finalized location!" );
+}
+
+/** @brief Stops the sampler, as nobody will consume its samples anymore.
+ *
+ *  @param eventSet  Reference to active set of metrics.
+ */
+static void
+scorep_metric_system_free_event_set( SCOREP_Metric_EventSet* eventSet )
+{
+    stop_sampler();
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_METRIC, " metric source freed event set!" );
+}
+
+/** @brief Hands the samples taken since the last call over to the metric
+ *         management. Called by the first location at each of its events.
+ *
+ *  The sampler is started at the first call, thus it does not run when no
+ *  substrate records asynchronous metrics.
+ */
+static void
+scorep_metric_system_asynchronous_read( SCOREP_Metric_EventSet*      eventSet,
+                                        SCOREP_MetricTimeValuePair** timeValuePairs,
+                                        uint64_t**                   numPairs,
+                                        bool                         forceUpdate )
+{
+    UTILS_ASSERT( eventSet );
+    UTILS_ASSERT( timeValuePairs );
+
+    if ( !sampler_running )
+    {
+        start_sampler();
+    }
+
+    *numPairs = malloc( number_of_metrics * sizeof( uint64_t ) );
+    UTILS_ASSERT( *numPairs );
+
+    uint64_t tail  = SCOREP_ATOMIC_LOAD( &ring_tail, SCOREP_ATOMIC_RELAXED );
+    uint64_t head  = SCOREP_ATOMIC_LOAD( &ring_head, SCOREP_ATOMIC_ACQUIRE );
+    uint64_t count = head - tail;
+
+    for ( uint32_t i = 0; i < number_of_metrics; i++ )
+    {
+        ( *numPairs )[ i ]  = count;
+        timeValuePairs[ i ] = NULL;
+        if ( count )
+        {
+            timeValuePairs[ i ] = malloc( count * sizeof( SCOREP_MetricTimeValuePair ) );
+            UTILS_ASSERT( timeValuePairs[ i ] );
+        }
+    }
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    for ( uint64_t j = 0; j < count; j++ )
+    {
+        const uint64_t* sample = ring + ( ( tail + j ) & ( RING_BUFFER_SAMPLES - 1 ) ) * ( number_of_metrics + 1 );
+        for ( uint32_t i = 0; i < number_of_metrics; i++ )
+        {
+            timeValuePairs[ i ][ j ].timestamp = sample[ 0 ];
+            timeValuePairs[ i ][ j ].value     = sample[ i + 1 ];
+        }
+    }
+
+    /* The sampler may reuse the slots now */
+    SCOREP_ATOMIC_STORE( &ring_tail, head, SCOREP_ATOMIC_RELEASE );
+}
+
+/** @brief  Gets number of active metrics.
+ *
+ *  @param  eventSet    Reference to active set of metrics.
+ *
+ *  @return Returns number of active metrics.
+ */
+static uint32_t
+scorep_metric_system_get_number_of_metrics( SCOREP_Metric_EventSet* eventSet )
+{
+    if ( eventSet == NULL )
+    {
+        return 0;
+    }
+
+    return eventSet->number_of_metrics;
+}
+
+/** @brief  Returns name of metric @metricIndex.
+ *
+ *  @param  eventSet    Reference to active set of metrics.
+ *  @param  metricIndex Index of requested metric.
+ *
+ *  @return Returns name of requested metric.
+ */
+static const char*
+scorep_metric_system_get_metric_name( SCOREP_Metric_EventSet* eventSet,
+                                      uint32_t                metricIndex )
+{
+    UTILS_ASSERT( eventSet );
+
+    if ( metricIndex < eventSet->number_of_metrics )
+    {
+        return metrics[ metricIndex ].name;
+    }
+    return "";
+}
+
+/** @brief  Gets description of requested metric.
+ *
+ *  @param  eventSet    Reference to active set of metrics.
+ *  @param  metricIndex Index of requested metric.
+ *
+ *  @return Returns description of requested metric.
+ */
+static const char*
+scorep_metric_system_get_metric_description( SCOREP_Metric_EventSet* eventSet,
+                                             uint32_t                metricIndex )
+{
+    UTILS_ASSERT( eventSet );
+
+    if ( metricIndex < eventSet->number_of_metrics )
+    {
+        return metrics[ metricIndex ].description;
+    }
+    return "";
+}
+
+/** @brief  Gets unit of requested metric.
+ *
+ *  @param  eventSet    Reference to active set of metrics.
+ *  @param  metricIndex Index of requested metric.
+ *
+ *  @return Returns unit of requested metric.
+ */
+static const char*
+scorep_metric_system_get_metric_unit( SCOREP_Metric_EventSet* eventSet,
+                                      uint32_t                metricIndex )
+{
+    UTILS_ASSERT( eventSet );
+
+    if ( metricIndex < eventSet->number_of_metrics )
+    {
+        return metrics[ metricIndex ].spec->unit;
+    }
+    return "";
+}
+
+/** @brief  Gets properties of requested metric.
+ *
+ *  @param  eventSet    Reference to active set of metrics.
+ *  @param  metricIndex Index of requested metric.
+ *
+ *  @return Returns properties of requested metric.
+ */
+static SCOREP_Metric_Properties
+scorep_metric_system_get_metric_properties( SCOREP_Metric_EventSet* eventSet,
+                                            uint32_t                metricIndex )
+{
+    UTILS_ASSERT( eventSet );
+
+    SCOREP_Metric_Properties props;
+
+    if ( metricIndex < eventSet->number_of_metrics )
+    {
+        const system_metric_spec* spec = metrics[ metricIndex ].spec;
+
+        props.name        = metrics[ metricIndex ].name;
+        props.description = metrics[ metricIndex ].description;
+        props.source_type = SCOREP_METRIC_SOURCE_TYPE_OTHER;
+        props.mode        = spec->mode;
+        props.value_type  = spec->scale == 0
+                            ? SCOREP_METRIC_VALUE_DOUBLE
+                            : SCOREP_METRIC_VALUE_UINT64;
+        props.base           = SCOREP_METRIC_BASE_DECIMAL;
+        props.exponent       = 0;
+        props.unit           = spec->unit;
+        props.profiling_type = spec->mode == SCOREP_METRIC_MODE_ACCUMULATED_START
+                               ? SCOREP_METRIC_PROFILING_TYPE_INCLUSIVE
+                               : SCOREP_METRIC_PROFILING_TYPE_MAX;
+    }
+    else
+    {
+        props.name           = "";
+        props.description    = "";
+        props.source_type    = SCOREP_INVALID_METRIC_SOURCE_TYPE;
+        props.mode           = SCOREP_INVALID_METRIC_MODE;
+        props.value_type     = SCOREP_INVALID_METRIC_VALUE_TYPE;
+        props.base           = SCOREP_INVALID_METRIC_BASE;
+        props.exponent       = 0;
+        props.unit           = "";
+        props.profiling_type = SCOREP_INVALID_METRIC_PROFILING_TYPE;
+    }
+
+    return props;
+}
+
+/** Implementation of the metric source initialization/finalization struct */
+const SCOREP_MetricSource SCOREP_Metric_System =
+{
+    SCOREP_METRIC_SOURCE_TYPE_OTHER,
+    &scorep_metric_system_register,
+    &scorep_metric_system_initialize_source,
+    &scorep_metric_system_initialize_location,
+    NULL,                                           // no synchronization function needed
+    &scorep_metric_system_free_event_set,
+    &scorep_metric_system_finalize_location,
+    &scorep_metric_system_finalize_source,
+    &scorep_metric_system_deregister,
+    NULL,                                           // no strictly synchronous read function needed
+    NULL,                                           // no synchronous read function needed
+    &scorep_metric_system_asynchronous_read,
+    &scorep_metric_system_get_number_of_metrics,
+    &scorep_metric_system_get_metric_name,
+    &scorep_metric_system_get_metric_description,
+    &scorep_metric_system_get_metric_unit,
+    &scorep_metric_system_get_metric_properties
+};
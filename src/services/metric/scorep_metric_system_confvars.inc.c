@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ *
+ */
+
+#include <SCOREP_Config.h>
+
+/** Contains the name of requested metrics. */
+static char* scorep_metric_system = NULL;
+
+/** Contains the separator of metric names. */
+static char* scorep_metric_system_separator = NULL;
+
+/** Sampling interval in microseconds. */
+static uint64_t scorep_metric_system_interval = 0;
+
+/** List of configuration variables for the system metric source.
+ *
+ *  Current configuration variables are:
+ *  @li @c SCOREP_METRIC_SYSTEM list of requested metric names.
+ *  @li @c SCOREP_METRIC_SYSTEM_INTERVAL sampling interval of the background thread.
+ *  @li @c SCOREP_METRIC_SYSTEM_SEP character that separates single metric names.
+ */
+static const SCOREP_ConfigVariable scorep_metric_system_confvars[] = {
+    {
+        "system",
+        SCOREP_CONFIG_TYPE_STRING,
+        &scorep_metric_system,
+        NULL,
+        "",
+        "System metric names to sample per-process",
+        "List of requested system metric names, which are sampled by a "
+        "background thread and recorded as asynchronous metrics by the first "
+        "thread of each process. Use 'all' to record all metrics available on "
+        "this system.\n"
+        "Available metrics are io_rchar, io_wchar, io_read_bytes, and "
+        "io_write_bytes from /proc/self/io, loadavg, mem_available, "
+        "mem_pressure (memory pressure stall information), and numa_mem_used, "
+        "which records the used memory of every NUMA node."
+    },
+    {
+        "system_interval",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_metric_system_interval,
+        NULL,
+        "100000",
+        "Sampling interval of system metrics in microseconds",
+        "Time between two samples of the metrics in SCOREP_METRIC_SYSTEM. The "
+        "samples are buffered and written at the next event of the first "
+        "thread of the process."
+    },
+    {
+        "system_sep",
+        SCOREP_CONFIG_TYPE_STRING,
+        &scorep_metric_system_separator,
+        NULL,
+        ",",
+        "Separator of system metric names",
+        "Character that separates metric names in SCOREP_METRIC_SYSTEM."
+    },
+    SCOREP_CONFIG_TERMINATOR
+};
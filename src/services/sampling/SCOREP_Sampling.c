@@ -36,6 +36,8 @@ extern const scorep_sampling_interrupt_generator scorep_sampling_interrupt_gener
 #if HAVE( METRIC_PERF )
 /** Signal handler for PERF interrupts */
 extern const scorep_sampling_interrupt_generator scorep_sampling_interrupt_generator_perf;
+/** Ring buffer for PERF samples */
+extern const scorep_sampling_interrupt_generator scorep_sampling_interrupt_generator_perf_buffer;
 #endif
 
 /* Insert signal handlers according to the order of
@@ -53,8 +55,10 @@ static const scorep_sampling_interrupt_generator* scorep_sampling_interrupt_gene
     NULL,
 #endif
 #if HAVE( METRIC_PERF )
-    &scorep_sampling_interrupt_generator_perf
+    &scorep_sampling_interrupt_generator_perf,
+    &scorep_sampling_interrupt_generator_perf_buffer
 #else
+    NULL,
     NULL
 #endif
 };
@@ -170,3 +174,35 @@ scorep_finalize_interrupt_sources( SCOREP_Sampling_LocationData*
         }
     }
 }
+
+bool
+scorep_has_buffering_interrupt_sources( scorep_sampling_interrupt_generator_definition* samplingDef,
+                                        size_t                                          nrSamplingDef )
+{
+    for ( size_t i = 0; i < nrSamplingDef; i++ )
+    {
+        if ( scorep_sampling_interrupt_generators[ samplingDef[ i ].type ] &&
+             scorep_sampling_interrupt_generators[ samplingDef[ i ].type ]->drain_interrupt_generator )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+scorep_drain_interrupt_sources( struct SCOREP_Location*                         location,
+                                SCOREP_Sampling_LocationData*                   samplingData,
+                                scorep_sampling_interrupt_generator_definition* samplingDef,
+                                size_t                                          nrSamplingDef )
+{
+    for ( size_t i = 0; i < nrSamplingDef; i++ )
+    {
+        if ( scorep_sampling_interrupt_generators[ samplingDef[ i ].type ] &&
+             scorep_sampling_interrupt_generators[ samplingDef[ i ].type ]->drain_interrupt_generator )
+        {
+            scorep_sampling_interrupt_generators[ samplingDef[ i ].type ]->drain_interrupt_generator( location,
+                                                                                                      &( samplingData->data[ i ] ) );
+        }
+    }
+}
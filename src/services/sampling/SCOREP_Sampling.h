@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <unistd.h>
 
+struct SCOREP_Location;
+
 
 /* *********************************************************************
  * Data types
@@ -37,6 +39,8 @@ typedef enum scorep_sampling_interrupt_generator_type
     SCOREP_SAMPLING_TRIGGER_PAPI,
     /** Linux perf event */
     SCOREP_SAMPLING_TRIGGER_PERF,
+    /** Linux perf event, samples with callchains are taken from a ring buffer */
+    SCOREP_SAMPLING_TRIGGER_PERF_BUFFER,
 
     /** For internal use only. */
     SCOREP_SAMPLING_TRIGGER_MAX
@@ -54,6 +58,16 @@ typedef struct scorep_sampling_single_location_data
 #if HAVE( METRIC_PERF )
     int   perf_fd;
     void* perf_mmap_buffer;
+
+    /** Size of the data area of the ring buffer, 0 if samples are signaled */
+    size_t   perf_buffer_size;
+    /** Copy of a record which wraps around the end of the ring buffer */
+    char*    perf_record_copy;
+    /** Perf clock and Score-P timer at the last drain, to convert sample times */
+    uint64_t perf_anchor_time;
+    uint64_t perf_anchor_ticks;
+    /** Number of samples the kernel dropped because the buffer was full */
+    uint64_t perf_lost_samples;
 #endif
 
 #if !HAVE( PAPI ) && !HAVE( METRIC_PERF )
@@ -81,6 +95,8 @@ typedef struct scorep_sampling_interrupt_generator_definition
     char*                                    event;
     /** Interrupt period */
     uint64_t                                 period;
+    /** Size of the ring buffer, used only by PERF_BUFFER */
+    uint64_t                                 buffer_size;
 } scorep_sampling_interrupt_generator_definition;
 
 
@@ -101,6 +117,10 @@ typedef struct scorep_sampling_interrupt_generator
     void ( * disable_interrupt_generator )( scorep_sampling_single_location_data* samplingData );
 
     void ( * finalize_interrupt_generator )( scorep_sampling_single_location_data* samplingData );
+
+    /** Records buffered samples, NULL if samples are recorded in the signal handler */
+    void ( * drain_interrupt_generator )( struct SCOREP_Location*               location,
+                                          scorep_sampling_single_location_data* samplingData );
 } scorep_sampling_interrupt_generator;
 
 
@@ -190,4 +210,30 @@ scorep_finalize_interrupt_sources( SCOREP_Sampling_LocationData*
                                    scorep_sampling_interrupt_generator_definition* definitions,
                                    size_t                                          numDefinitions );
 
+/**
+ * Check whether any of the interrupt sources buffers its samples.
+ *
+ * @param definitions       List of interrupt generator definitions
+ * @param numDefinitions    Number of elements in @ definitions
+ *
+ * @return True if scorep_drain_interrupt_sources() needs to be called
+ */
+bool
+scorep_has_buffering_interrupt_sources( scorep_sampling_interrupt_generator_definition* definitions,
+                                        size_t                                          numDefinitions );
+
+/**
+ * Record the buffered samples of all interrupt sources of a location.
+ *
+ * @param location          The location the samples belong to
+ * @param samplingData      Location specific sampling data
+ * @param definitions       List of interrupt generator definitions
+ * @param numDefinitions    Number of elements in @ definitions
+ */
+void
+scorep_drain_interrupt_sources( struct SCOREP_Location*                         location,
+                                SCOREP_Sampling_LocationData*                   samplingData,
+                                scorep_sampling_interrupt_generator_definition* definitions,
+                                size_t                                          numDefinitions );
+
 #endif /* SCOREP_SAMPLING_H */
@@ -21,6 +21,7 @@
 #include <SCOREP_Memory.h>
 #include <SCOREP_ErrorCodes.h>
 #include <SCOREP_Subsystem.h>
+#include <SCOREP_Unwinding.h>
 
 #include <UTILS_Error.h>
 
@@ -45,6 +46,20 @@ static scorep_sampling_interrupt_generator_definition* sampling_sources = NULL;
 static size_t num_sampling_sources = 0;
 
 
+/**
+ * Records the buffered samples of a location, registered with the unwinding.
+ *
+ * @param location          The location the samples belong to
+ * @param drainArg          Sampling data of @a location
+ */
+static void
+drain_samples( SCOREP_Location* location,
+               void*            drainArg )
+{
+    scorep_drain_interrupt_sources( location, drainArg, sampling_sources, num_sampling_sources );
+}
+
+
 /* *********************************************************************
  * Implementation of the subsystem API
  * ********************************************************************/
@@ -151,6 +166,13 @@ sampling_subsystem_init( void )
             {
                 sampling_sources[ list_len ].period = 1000000;
                 sampling_sources[ list_len ].type   = SCOREP_SAMPLING_TRIGGER_PERF;
+#if HAVE( METRIC_PERF )
+                if ( scorep_sampling_perf_buffer )
+                {
+                    sampling_sources[ list_len ].type        = SCOREP_SAMPLING_TRIGGER_PERF_BUFFER;
+                    sampling_sources[ list_len ].buffer_size = scorep_sampling_perf_buffer_size;
+                }
+#endif
             }
             else
             {
@@ -228,6 +250,11 @@ sampling_subsystem_init_location( SCOREP_Location* location,
         scorep_create_interrupt_sources( sampling_data, sampling_sources, num_sampling_sources );
         sampling_data->nr_data = num_sampling_sources;
 
+        if ( scorep_has_buffering_interrupt_sources( sampling_sources, num_sampling_sources ) )
+        {
+            SCOREP_Unwinding_SetSampleDrain( location, drain_samples, sampling_data );
+        }
+
         SCOREP_MutexUnlock( init_sampling_mutex );
 
         sig_atomic_t touch = scorep_sampling_is_known_pthread;
@@ -331,6 +358,11 @@ sampling_subsystem_finalize_location( SCOREP_Location* location )
         return;
     }
 
+    if ( scorep_has_buffering_interrupt_sources( sampling_sources, num_sampling_sources ) )
+    {
+        SCOREP_Unwinding_SetSampleDrain( location, NULL, NULL );
+    }
+
     scorep_finalize_interrupt_sources( location_data, sampling_sources, num_sampling_sources );
 }
 
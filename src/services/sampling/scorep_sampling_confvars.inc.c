@@ -33,6 +33,19 @@ static char* scorep_sampling_events;
  */
 static char* scorep_sampling_separator;
 
+#if HAVE_BACKEND( METRIC_PERF )
+/**
+ * Take perf samples with their callchains from a ring buffer instead of
+ * unwinding in the signal handler.
+ */
+static bool scorep_sampling_perf_buffer;
+
+/**
+ * Size of the perf ring buffer per location and event.
+ */
+static uint64_t scorep_sampling_perf_buffer_size;
+#endif
+
 /**
  * Array of configuration variables.
  * They are registered to the measurement system and are filled during
@@ -80,5 +93,36 @@ static const SCOREP_ConfigVariable scorep_sampling_confvars[] = {
         "Separator of sampling event names",
         "Character that separates sampling event names in SCOREP_SAMPLING_EVENTS"
     },
+#if HAVE_BACKEND( METRIC_PERF )
+    {
+        "perf_buffer",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_sampling_perf_buffer,
+        NULL,
+        "false",
+        "Let the kernel record perf samples and their callchains in a ring buffer",
+        "Instead of interrupting the program for every sample and unwinding its "
+        "stack in the signal handler, the kernel writes the sampled instruction "
+        "address, the time, and the callchain into a ring buffer per location. "
+        "The buffer is processed in batches at region enter and exit events and "
+        "whenever it is half full. This reduces the overhead per sample "
+        "considerably, but the kernel follows frame pointers to collect the "
+        "callchain, thus the application should be compiled with "
+        "-fno-omit-frame-pointer. Samples in functions without a frame of "
+        "their own, like optimized leaf functions, miss the caller of that "
+        "function.\n"
+        "Applies to all perf events in SCOREP_SAMPLING_EVENTS."
+    },
+    {
+        "perf_buffer_size",
+        SCOREP_CONFIG_TYPE_SIZE,
+        &scorep_sampling_perf_buffer_size,
+        NULL,
+        "256k",
+        "Size of the perf ring buffer per location in bytes",
+        "Only in effect if SCOREP_SAMPLING_PERF_BUFFER is set. The size will be "
+        "increased to the next power-of-two multiple of the system page size."
+    },
+#endif
     SCOREP_CONFIG_TERMINATOR
 };
@@ -20,9 +20,13 @@
 
 #include "SCOREP_Sampling.h"
 
+#include <SCOREP_Atomic.h>
 #include <SCOREP_Definitions.h>
 #include <SCOREP_InMeasurement.h>
 #include <SCOREP_Events.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_Timer_Ticks.h>
+#include <SCOREP_Unwinding.h>
 #include <UTILS_Error.h>
 
 #if defined( __PGI )
@@ -32,9 +36,11 @@
 #endif
 #include <linux/perf_event.h>
 
+#include <inttypes.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <sys/ioctl.h>
 #include <sys/syscall.h>
 #include <fcntl.h>
@@ -45,9 +51,27 @@
  *  first page is a metadata page */
 #define MMAP_LENGTH     ( 3 ) * sysconf( _SC_PAGESIZE )
 
+/** Maximal size of a perf record, the size in the record header has 16 bits */
+#define MAX_RECORD_SIZE ( 1 << 16 )
+
+/** Maximal number of callchain entries of a buffered sample */
+#define MAX_CALLCHAIN_DEPTH 128
+
 /** Definition handle if this interrupt generator */
 static SCOREP_InterruptGeneratorHandle perf_interrupt_generator = SCOREP_INVALID_INTERRUPT_GENERATOR;
 
+/** Definition handle of the interrupt generator with ring buffer */
+static SCOREP_InterruptGeneratorHandle perf_buffer_interrupt_generator = SCOREP_INVALID_INTERRUPT_GENERATOR;
+
+
+/** Layout of PERF_RECORD_LOST */
+typedef struct perf_lost_record
+{
+    struct perf_event_header header;
+    uint64_t                 id;
+    uint64_t                 lost;
+} perf_lost_record;
+
 
 /* *********************************************************************
  * Helper functions
@@ -285,6 +309,109 @@ initialize_interrupt_generator( scorep_sampling_interrupt_generator_definition d
                                                   definition.period );
 }
 
+/**
+ * Opens the perf event for the calling thread and lets it signal SIGPROF,
+ * which is handled by @a signalHandler.
+ *
+ * @param samplingData      Location specific sampling data
+ * @param perfAttr          Attributes of the event
+ * @param mmapLength        Size of the ring buffer including the metadata page
+ * @param signalHandler     Handler for SIGPROF
+ *
+ * @return true on success
+ */
+static bool
+open_perf_event( scorep_sampling_single_location_data* samplingData,
+                 struct perf_event_attr*               perfAttr,
+                 size_t                                mmapLength,
+                 void ( *                              signalHandler )( int, siginfo_t*, void* ) )
+{
+    struct sigaction  action;
+    struct f_owner_ex fown_ex;
+
+    samplingData->perf_fd = syscall( __NR_perf_event_open, perfAttr, 0, -1, -1, 0 ); /* allocate memory for mmap */
+    if ( samplingData->perf_fd < 1 )
+    {
+        UTILS_WARNING( "Error: perf_event_open failed." );
+        return false;
+    }
+
+    if ( fcntl( samplingData->perf_fd, F_SETFL, O_ASYNC | O_NONBLOCK ) )
+    {
+        UTILS_WARNING( "perf event sampling: Error changing fd" );
+        return false;
+    }
+
+    fown_ex.type = F_OWNER_TID;
+    fown_ex.pid  = syscall( SYS_gettid );
+    if ( fcntl( samplingData->perf_fd, F_SETOWN_EX, ( unsigned long )&fown_ex ) < 0 )
+    {
+        UTILS_WARNING( "perf event sampling: Error owning fd" );
+        return false;
+    }
+    if ( fcntl( samplingData->perf_fd, F_SETFD, FD_CLOEXEC ) )
+    {
+        UTILS_WARNING( "perf event sampling: Error while setting close-on-exec flag" );
+        return false;
+    }
+
+    /*
+     * Call mmap to work around Linux kernel bug:
+     *
+     * Before kernel 2.6.39, there is a bug that means you must
+     * allocate a mmap ring buffer when sampling even if you
+     * do not plan to access it. This ring-buffer is created
+     * and accessed through mmap.
+     */
+    samplingData->perf_mmap_buffer = mmap( NULL, mmapLength, PROT_READ | PROT_WRITE, MAP_SHARED, samplingData->perf_fd, 0 );
+    if ( samplingData->perf_mmap_buffer == MAP_FAILED )
+    {
+        UTILS_WARNING( "perf event sampling: Error: mmap failed (%i).\n", errno );
+        return false;
+    }
+
+    if ( fcntl( samplingData->perf_fd, F_SETSIG, SIGPROF ) )
+    {
+        UTILS_WARNING( "perf event sampling: Unable to create signal" );
+        return false;
+    }
+    memset( &action, 0, sizeof( struct sigaction ) );
+    action.sa_flags     = SA_RESTART;
+    action.sa_flags    |= SA_SIGINFO;
+    action.sa_sigaction = signalHandler;
+    if ( sigaction( SIGPROF, &action, NULL ) < 0 )
+    {
+        UTILS_WARNING( "perf event sampling: Unable to install signal handler" );
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Sets the type and config of @a perfAttr from the event name of
+ * @a definition.
+ *
+ * @return true on success
+ */
+static bool
+parse_definition( scorep_sampling_interrupt_generator_definition definition,
+                  struct perf_event_attr*                        perfAttr )
+{
+    /* parse samplingEvent for name and interval */
+    if ( strstr( definition.event, "perf_" ) != definition.event )
+    {
+        UTILS_WARNING( "%s is not a valid perf event\n", definition.event );
+        return false;
+    }
+    if ( perf_parse_event( &( definition.event[ 5 ] ), perfAttr ) )
+    {
+        UTILS_WARNING( "%s is not a valid perf event\n", definition.event );
+        return false;
+    }
+    return true;
+}
+
 static void
 create_interrupt_generator( scorep_sampling_single_location_data*          samplingData,
                             scorep_sampling_interrupt_generator_definition definition )
@@ -292,22 +419,13 @@ create_interrupt_generator( scorep_sampling_single_location_data*          sampl
     if ( !samplingData->perf_fd )
     {
         struct perf_event_attr perf_attr;
-        struct sigaction       action;
-        struct f_owner_ex      fown_ex;
 
         memset( &perf_attr, 0, sizeof( struct perf_event_attr ) );
         perf_attr.disabled = 1;
         perf_attr.type     = PERF_TYPE_HARDWARE;
 
-        /* parse samplingEvent for name and interval */
-        if ( strstr( definition.event, "perf_" ) != definition.event )
-        {
-            UTILS_WARNING( "%s is not a valid perf event\n", definition.event );
-            return;
-        }
-        if ( perf_parse_event( &( definition.event[ 5 ] ), &perf_attr ) )
+        if ( !parse_definition( definition, &perf_attr ) )
         {
-            UTILS_WARNING( "%s is not a valid perf event\n", definition.event );
             return;
         }
         perf_attr.sample_type    = PERF_SAMPLE_IP;
@@ -318,60 +436,8 @@ create_interrupt_generator( scorep_sampling_single_location_data*          sampl
         perf_attr.size           = sizeof( struct perf_event_attr );
         perf_attr.sample_period  = definition.period;
 
-        samplingData->perf_fd = syscall( __NR_perf_event_open, &perf_attr, 0, -1, -1, 0 ); /* allocate memory for mmap */
-        if ( samplingData->perf_fd < 1 )
-        {
-            UTILS_WARNING( "Error: perf_event_open failed." );
-            return;
-        }
-
-        if ( fcntl( samplingData->perf_fd, F_SETFL, O_ASYNC | O_NONBLOCK ) )
-        {
-            UTILS_WARNING( "perf event sampling: Error changing fd" );
-            return;
-        }
-
-        fown_ex.type = F_OWNER_TID;
-        fown_ex.pid  = syscall( SYS_gettid );
-        if ( fcntl( samplingData->perf_fd, F_SETOWN_EX, ( unsigned long )&fown_ex ) < 0 )
-        {
-            UTILS_WARNING( "perf event sampling: Error owning fd" );
-            return;
-        }
-        if ( fcntl( samplingData->perf_fd, F_SETFD, FD_CLOEXEC ) )
-        {
-            UTILS_WARNING( "perf event sampling: Error while setting close-on-exec flag" );
-            return;
-        }
-
-        /*
-         * Call mmap to work around Linux kernel bug:
-         *
-         * Before kernel 2.6.39, there is a bug that means you must
-         * allocate a mmap ring buffer when sampling even if you
-         * do not plan to access it. This ring-buffer is created
-         * and accessed through mmap.
-         */
-        samplingData->perf_mmap_buffer = mmap( NULL, MMAP_LENGTH, PROT_READ | PROT_WRITE, MAP_SHARED, samplingData->perf_fd, 0 );
-        if ( samplingData->perf_mmap_buffer == MAP_FAILED )
-        {
-            UTILS_WARNING( "perf event sampling: Error: mmap failed (%i).\n", errno );
-            return;
-        }
-
-        if ( fcntl( samplingData->perf_fd, F_SETSIG, SIGPROF ) )
-        {
-            UTILS_WARNING( "perf event sampling: Unable to create signal" );
-            return;
-        }
-        memset( &action, 0, sizeof( struct sigaction ) );
-        action.sa_flags     = SA_RESTART;
-        action.sa_flags    |= SA_SIGINFO;
-        action.sa_sigaction =
-            ( void ( * )( int, siginfo_t*, void* ) )perf_signal_handler;
-        if ( sigaction( SIGPROF, &action, NULL ) < 0 )
+        if ( !open_perf_event( samplingData, &perf_attr, MMAP_LENGTH, perf_signal_handler ) )
         {
-            UTILS_WARNING( "perf event sampling: Unable to install signal handler" );
             return;
         }
     }
@@ -426,3 +492,280 @@ const scorep_sampling_interrupt_generator scorep_sampling_interrupt_generator_pe
     .disable_interrupt_generator    = disable_interrupt_generator,
     .finalize_interrupt_generator   = finalize_interrupt_generator
 };
+
+/* *********************************************************************
+ * Ring buffer with callchains
+ **********************************************************************/
+
+/**
+ * Signal handler of the ring buffer, triggered when it is half full.
+ *
+ * @param signalNumber          Signal number
+ * @param signalInfo            Signal information
+ * @param contextPtr            Context
+ */
+static void
+perf_buffer_signal_handler( int        signalNumber,
+                            siginfo_t* signalInfo,
+                            void*      contextPtr )
+{
+    bool outside = SCOREP_IN_MEASUREMENT_TEST_AND_INCREMENT();
+    SCOREP_ENTER_SIGNAL_CONTEXT();
+
+    /* Inside the measurement, the buffer will be drained at the next
+       enter or exit event */
+    if ( outside && scorep_sampling_is_enabled() )
+    {
+        SCOREP_Unwinding_DrainSamples( SCOREP_Location_GetCurrentCPULocation() );
+    }
+
+    SCOREP_EXIT_SIGNAL_CONTEXT();
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+}
+
+/** Returns the time of the clock the kernel uses for the samples */
+static uint64_t
+get_perf_time( void )
+{
+    struct timespec time;
+    clock_gettime( CLOCK_MONOTONIC, &time );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+}
+
+/**
+ * Converts the time of a sample taken since the last drain into Score-P
+ * timer ticks, by interpolating between the last drain and now.
+ */
+static uint64_t
+convert_time( const scorep_sampling_single_location_data* samplingData,
+              uint64_t                                    time,
+              uint64_t                                    nowTime,
+              uint64_t                                    nowTicks )
+{
+    if ( time <= samplingData->perf_anchor_time )
+    {
+        return samplingData->perf_anchor_ticks;
+    }
+    if ( time >= nowTime )
+    {
+        return nowTicks;
+    }
+    double fraction = ( double )( time - samplingData->perf_anchor_time )
+                      / ( double )( nowTime - samplingData->perf_anchor_time );
+    return samplingData->perf_anchor_ticks
+           + ( uint64_t )( fraction * ( double )( nowTicks - samplingData->perf_anchor_ticks ) );
+}
+
+/**
+ * Records a PERF_RECORD_SAMPLE with the layout requested in
+ * create_buffer_interrupt_generator().
+ */
+static void
+process_sample( SCOREP_Location*                            location,
+                const scorep_sampling_single_location_data* samplingData,
+                const struct perf_event_header*             record,
+                uint64_t                                    nowTime,
+                uint64_t                                    nowTicks )
+{
+    /* PERF_SAMPLE_IP, PERF_SAMPLE_TIME, and PERF_SAMPLE_CALLCHAIN */
+    size_t          num_values = ( record->size - sizeof( *record ) ) / sizeof( uint64_t );
+    const uint64_t* values     = ( const uint64_t* )( record + 1 );
+    if ( num_values < 3 )
+    {
+        return;
+    }
+    uint64_t        ip   = values[ 0 ];
+    uint64_t        time = values[ 1 ];
+    uint64_t        nr   = values[ 2 ];
+    const uint64_t* ips  = &values[ 3 ];
+    if ( nr > num_values - 3 )
+    {
+        nr = num_values - 3;
+    }
+
+    uint64_t callchain[ MAX_CALLCHAIN_DEPTH ];
+    uint32_t depth = 0;
+    for ( uint64_t i = 0; i < nr && depth < MAX_CALLCHAIN_DEPTH; i++ )
+    {
+        /* Skip context markers, like PERF_CONTEXT_USER */
+        if ( ips[ i ] >= PERF_CONTEXT_MAX )
+        {
+            continue;
+        }
+        callchain[ depth++ ] = ips[ i ];
+    }
+    if ( depth == 0 )
+    {
+        callchain[ depth++ ] = ip;
+    }
+
+    SCOREP_Location_SampleCallchain( location,
+                                     convert_time( samplingData, time, nowTime, nowTicks ),
+                                     perf_buffer_interrupt_generator,
+                                     callchain,
+                                     depth );
+}
+
+static void
+drain_buffer_interrupt_generator( SCOREP_Location*                      location,
+                                  scorep_sampling_single_location_data* samplingData )
+{
+    if ( samplingData->perf_buffer_size == 0 )
+    {
+        return;
+    }
+
+    struct perf_event_mmap_page* control = samplingData->perf_mmap_buffer;
+    uint64_t                     head    = SCOREP_ATOMIC_LOAD( &control->data_head, SCOREP_ATOMIC_ACQUIRE );
+    uint64_t                     tail    = control->data_tail;
+    if ( head == tail )
+    {
+        return;
+    }
+
+    uint64_t now_time  = get_perf_time();
+    uint64_t now_ticks = SCOREP_Timer_GetClockTicks();
+
+    /* The data area follows the metadata page. Records are 8-byte aligned,
+       thus only their body may wrap around the end of the buffer. */
+    const char* data = ( const char* )samplingData->perf_mmap_buffer + sysconf( _SC_PAGESIZE );
+    size_t      size = samplingData->perf_buffer_size;
+    while ( tail != head )
+    {
+        size_t                          offset = tail & ( size - 1 );
+        const struct perf_event_header* record = ( const void* )( data + offset );
+        if ( record->size < sizeof( *record ) )
+        {
+            UTILS_WARNING( "perf event sampling: Invalid record in ring buffer, dropping %" PRIu64 " bytes.",
+                           head - tail );
+            tail = head;
+            break;
+        }
+        if ( offset + record->size > size )
+        {
+            size_t first = size - offset;
+            memcpy( samplingData->perf_record_copy, record, first );
+            memcpy( samplingData->perf_record_copy + first, data, record->size - first );
+            record = ( const void* )samplingData->perf_record_copy;
+        }
+
+        switch ( record->type )
+        {
+            case PERF_RECORD_SAMPLE:
+                process_sample( location, samplingData, record, now_time, now_ticks );
+                break;
+            case PERF_RECORD_LOST:
+                samplingData->perf_lost_samples += ( ( const perf_lost_record* )record )->lost;
+                break;
+        }
+
+        tail += record->size;
+    }
+    SCOREP_ATOMIC_STORE( &control->data_tail, tail, SCOREP_ATOMIC_RELEASE );
+
+    samplingData->perf_anchor_time  = now_time;
+    samplingData->perf_anchor_ticks = now_ticks;
+}
+
+static void
+initialize_buffer_interrupt_generator( scorep_sampling_interrupt_generator_definition definition )
+{
+    perf_buffer_interrupt_generator =
+        SCOREP_Definitions_NewInterruptGenerator( definition.event,
+                                                  SCOREP_INTERRUPT_GENERATOR_MODE_COUNT,
+                                                  SCOREP_METRIC_BASE_DECIMAL,
+                                                  0,
+                                                  definition.period );
+}
+
+static void
+create_buffer_interrupt_generator( scorep_sampling_single_location_data*          samplingData,
+                                   scorep_sampling_interrupt_generator_definition definition )
+{
+    if ( !samplingData->perf_fd )
+    {
+        struct perf_event_attr perf_attr;
+
+        memset( &perf_attr, 0, sizeof( struct perf_event_attr ) );
+        perf_attr.disabled = 1;
+        perf_attr.type     = PERF_TYPE_HARDWARE;
+
+        if ( !parse_definition( definition, &perf_attr ) )
+        {
+            return;
+        }
+
+        /* mmap size should be 1+2^n pages */
+        size_t page_size   = sysconf( _SC_PAGESIZE );
+        size_t buffer_size = page_size;
+        while ( buffer_size < definition.buffer_size )
+        {
+            buffer_size *= 2;
+        }
+
+        perf_attr.sample_type              = PERF_SAMPLE_IP | PERF_SAMPLE_TIME | PERF_SAMPLE_CALLCHAIN;
+        perf_attr.exclude_kernel           = 1; /* don't count kernel */
+        perf_attr.exclude_hv               = 1; /* don't count hypervisor */
+        perf_attr.exclude_callchain_kernel = 1;
+        perf_attr.use_clockid              = 1;
+        perf_attr.clockid                  = CLOCK_MONOTONIC;
+        perf_attr.watermark                = 1;
+        perf_attr.wakeup_watermark         = buffer_size / 2;
+        perf_attr.size                     = sizeof( struct perf_event_attr );
+        perf_attr.sample_period            = definition.period;
+
+        samplingData->perf_record_copy = malloc( MAX_RECORD_SIZE );
+        if ( !samplingData->perf_record_copy )
+        {
+            UTILS_WARNING( "perf event sampling: Unable to allocate record buffer" );
+            return;
+        }
+
+        if ( !open_perf_event( samplingData, &perf_attr, page_size + buffer_size, perf_buffer_signal_handler ) )
+        {
+            return;
+        }
+        samplingData->perf_buffer_size  = buffer_size;
+        samplingData->perf_anchor_time  = get_perf_time();
+        samplingData->perf_anchor_ticks = SCOREP_Timer_GetClockTicks();
+    }
+
+    if ( ioctl( samplingData->perf_fd, PERF_EVENT_IOC_ENABLE ) < 0 )
+    {
+        UTILS_WARNING( "perf event sampling: Error while enabling event " );
+        return;
+    }
+}
+
+static void
+finalize_buffer_interrupt_generator( scorep_sampling_single_location_data* samplingData )
+{
+    finalize_interrupt_generator( samplingData );
+
+    if ( samplingData->perf_buffer_size )
+    {
+        munmap( samplingData->perf_mmap_buffer, sysconf( _SC_PAGESIZE ) + samplingData->perf_buffer_size );
+        samplingData->perf_buffer_size = 0;
+    }
+    free( samplingData->perf_record_copy );
+    samplingData->perf_record_copy = NULL;
+
+    if ( samplingData->perf_lost_samples )
+    {
+        UTILS_WARNING( "perf event sampling: The kernel dropped %" PRIu64 " samples "
+                       "because the ring buffer was full. Consider increasing "
+                       "SCOREP_SAMPLING_PERF_BUFFER_SIZE.",
+                       samplingData->perf_lost_samples );
+    }
+}
+
+
+const scorep_sampling_interrupt_generator scorep_sampling_interrupt_generator_perf_buffer =
+{
+    .initialize_interrupt_generator = initialize_buffer_interrupt_generator,
+    .create_interrupt_generator     = create_buffer_interrupt_generator,
+    .enable_interrupt_generator     = enable_interrupt_generator,
+    .disable_interrupt_generator    = disable_interrupt_generator,
+    .finalize_interrupt_generator   = finalize_buffer_interrupt_generator,
+    .drain_interrupt_generator      = drain_buffer_interrupt_generator
+};
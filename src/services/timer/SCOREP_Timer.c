@@ -25,16 +25,67 @@
 #include <SCOREP_Timer_Utils.h>
 
 #include <SCOREP_InMeasurement.h>
+#include <scorep_ipc.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 
 #if HAVE( BACKEND_SCOREP_TIMER_TSC ) && !HAVE( SCOREP_ARMV8_TSC )
-#include <scorep_ipc.h>
 #include <UTILS_IO.h>
-#include <string.h>
 #include <stdlib.h>
-#include <inttypes.h>
 #include <math.h>
 #endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && ! HAVE( SCOREP_ARMV8_TSC ) */
 
+
+/* Includes needed by specific timers. */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGL )
+# include <bglpersonality.h>
+# include <rts.h>
+#endif /* BACKEND_SCOREP_TIMER_BGL */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGP )
+# include <common/bgp_personality.h>
+# include <common/bgp_personality_inlines.h>
+# include <spi/kernel_interface.h>
+#endif /* BACKEND_SCOREP_TIMER_BGP */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGQ )
+# include <firmware/include/personality.h>
+# ifdef __GNUC__
+#  include <ppu_intrinsics.h>
+# endif
+# ifndef DEFAULT_FREQ_MHZ
+#  error "DEFAULT_FREQ_MHZ not defined. Check your includes."
+# endif
+#endif /* BACKEND_SCOREP_TIMER_BGQ */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MINGW )
+# include <windows.h>
+#endif /* BACKEND_SCOREP_TIMER_MINGW */
+
+#if HAVE( BACKEND_SCOREP_TIMER_AIX )
+# include <sys/time.h>
+# include <sys/systemcfg.h>
+#endif /* BACKEND_SCOREP_TIMER_AIX */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MAC )
+#include <mach/mach_time.h>
+#endif /* BACKEND_SCOREP_TIMER_MAC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_TSC )
+# include "scorep_timer_tsc.h"
+#endif /* BACKEND_SCOREP_TIMER_TSC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY )
+# include <sys/time.h>
+#endif /* BACKEND_SCOREP_TIMER_GETTIMEOFDAY */
+
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+# include <time.h>
+#endif /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
+
 /* *INDENT-OFF* */
 /* *INDENT-ON*  */
 
@@ -72,6 +123,7 @@ double scorep_ticks_to_nsec_mac;
 
 #include "scorep_timer_confvars.inc.c"
 
+
 void
 SCOREP_Timer_Register( void )
 {
@@ -79,6 +131,179 @@ SCOREP_Timer_Register( void )
 }
 
 
+/* The read functions of the available timers. SCOREP_Timer_Initialize()
+ * selects one of them for scorep_timer_get_clock_ticks. */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGL )
+static uint64_t
+get_clock_ticks_bgl( void )
+{
+    return ( uint64_t )rts_get_timebase();
+}
+#endif  /* BACKEND_SCOREP_TIMER_BGL */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGP )
+static uint64_t
+get_clock_ticks_bgp( void )
+{
+    return ( uint64_t )_bgp_GetTimeBase();
+}
+#endif  /* BACKEND_SCOREP_TIMER_BGP */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGQ )
+static uint64_t
+get_clock_ticks_bgq( void )
+{
+    return ( uint64_t )__mftb();
+}
+#endif  /* BACKEND_SCOREP_TIMER_BGQ */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MINGW )
+static uint64_t
+get_clock_ticks_mingw( void )
+{
+    LARGE_INTEGER ticks;
+    QueryPerformanceCounter( &ticks );
+    return ( uint64_t )ticks.QuadPart;
+}
+#endif  /* BACKEND_SCOREP_TIMER_MINGW */
+
+#if HAVE( BACKEND_SCOREP_TIMER_AIX )
+static uint64_t
+get_clock_ticks_aix( void )
+{
+    timebasestruct_t tmp;
+    read_real_time( &tmp, TIMEBASE_SZ );
+    /* Convert to seconds and nanoseconds, if necessary. */
+    time_base_to_time( &tmp, TIMEBASE_SZ );
+    return ( uint64_t )tmp.tb_high * UINT64_C( 1e9 ) + ( uint64_t )tmp.tb_low;
+}
+#endif  /* BACKEND_SCOREP_TIMER_AIX */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MAC )
+static uint64_t
+get_clock_ticks_mac( void )
+{
+    return ( uint64_t )( scorep_ticks_to_nsec_mac * mach_absolute_time() );
+}
+#endif  /* BACKEND_SCOREP_TIMER_MAC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_TSC )
+static uint64_t
+get_clock_ticks_tsc( void )
+{
+    #include "scorep_timer_tsc.inc.c"
+}
+#endif  /* BACKEND_SCOREP_TIMER_TSC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY )
+static uint64_t
+get_clock_ticks_gettimeofday( void )
+{
+    struct timeval tp;
+    gettimeofday( &tp, 0 );
+    return ( uint64_t )tp.tv_sec * UINT64_C( 1000000 ) + ( uint64_t )tp.tv_usec;
+}
+#endif  /* BACKEND_SCOREP_TIMER_GETTIMEOFDAY */
+
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+static uint64_t
+get_clock_ticks_clock_gettime( void )
+{
+    struct timespec time;
+    int             result = clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
+    UTILS_ASSERT( result == 0 );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+}
+#endif  /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
+
+
+typedef uint64_t ( * clock_ticks_function )( void );
+
+static clock_ticks_function
+get_clock_ticks_function( timer_type timer )
+{
+    switch ( timer )
+    {
+#if HAVE( BACKEND_SCOREP_TIMER_BGL )
+        case TIMER_BGL:
+            return get_clock_ticks_bgl;
+#endif  /* BACKEND_SCOREP_TIMER_BGL */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGP )
+        case TIMER_BGP:
+            return get_clock_ticks_bgp;
+#endif  /* BACKEND_SCOREP_TIMER_BGP */
+
+#if HAVE( BACKEND_SCOREP_TIMER_BGQ )
+        case TIMER_BGQ:
+            return get_clock_ticks_bgq;
+#endif  /* BACKEND_SCOREP_TIMER_BGQ */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MINGW )
+        case TIMER_MINGW:
+            return get_clock_ticks_mingw;
+#endif  /* BACKEND_SCOREP_TIMER_MINGW */
+
+#if HAVE( BACKEND_SCOREP_TIMER_AIX )
+        case TIMER_AIX:
+            return get_clock_ticks_aix;
+#endif  /* BACKEND_SCOREP_TIMER_AIX */
+
+#if HAVE( BACKEND_SCOREP_TIMER_MAC )
+        case TIMER_MAC:
+            return get_clock_ticks_mac;
+#endif  /* BACKEND_SCOREP_TIMER_MAC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_TSC )
+        case TIMER_TSC:
+            return get_clock_ticks_tsc;
+#endif  /* BACKEND_SCOREP_TIMER_TSC */
+
+#if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY )
+        case TIMER_GETTIMEOFDAY:
+            return get_clock_ticks_gettimeofday;
+#endif  /* BACKEND_SCOREP_TIMER_GETTIMEOFDAY */
+
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+        case TIMER_CLOCK_GETTIME:
+            return get_clock_ticks_clock_gettime;
+#endif  /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
+
+        default:
+            UTILS_FATAL( "Invalid timer selected, shouldn't happen." );
+    }
+}
+
+
+/* Used until SCOREP_Timer_Initialize() selected the timer */
+static uint64_t
+get_clock_ticks_dispatch( void )
+{
+    return get_clock_ticks_function( scorep_timer )();
+}
+
+
+uint64_t ( * scorep_timer_get_clock_ticks )( void ) = get_clock_ticks_dispatch;
+
+
+#if HAVE( BACKEND_SCOREP_TIMER_TSC ) && !HAVE( SCOREP_ARMV8_TSC )
+/* Reads the timer the tsc frequency is interpolated against. Either
+ * BACKEND_SCOREP_TIMER_CLOCK_GETTIME or BACKEND_SCOREP_TIMER_GETTIMEOFDAY
+ * are available, see check in scorep_timer_tsc.h */
+static uint64_t
+get_cmp_ticks( void )
+{
+# if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+    return get_clock_ticks_clock_gettime();
+# else  /* HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) */
+    return get_clock_ticks_gettimeofday();
+# endif
+}
+#endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && ! HAVE( SCOREP_ARMV8_TSC ) */
+
+
+
 void
 SCOREP_Timer_Initialize( void )
 {
@@ -180,36 +405,44 @@ SCOREP_Timer_Initialize( void )
                     if ( status != SCOREP_ERROR_END_OF_BUFFER )
                     {
                         UTILS_ERROR( status, "Error reading %s for timer consistency check.", proc_cpuinfo );
+                        UTILS_WARNING( "From %s, could not determine if tsc timer is (\'nonstop_tsc\' "
+                                       "&& \'constant_tsc\'). Timings likely to be unreliable. "
+                                       "Switch to a timer different from SCOREP_TIMER=\'tsc\' if you have "
+                                       "issues with timings.", proc_cpuinfo );
+                    }
+                    else
+                    {
+#   if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+                        /* No timestamps were taken yet, we can still switch */
+                        UTILS_WARNING( "From %s, tsc timer is not (\'nonstop_tsc\' && "
+                                       "\'constant_tsc\'). Using SCOREP_TIMER=\'clock_gettime\' "
+                                       "instead.", proc_cpuinfo );
+                        scorep_timer = TIMER_CLOCK_GETTIME;
+#   else
+                        UTILS_WARNING( "From %s, tsc timer is not (\'nonstop_tsc\' && "
+                                       "\'constant_tsc\'). Timings likely to be unreliable. "
+                                       "Switch to a timer different from SCOREP_TIMER=\'tsc\' if you have "
+                                       "issues with timings.", proc_cpuinfo );
+#   endif
                     }
-                    UTILS_WARNING( "From %s, could not determine if tsc timer is (\'nonstop_tsc\' "
-                                   "&& \'constant_tsc\'). Timings likely to be unreliable. "
-                                   "Switch to a timer different from SCOREP_TIMER=\'tsc\' if you have "
-                                   "issues with timings.", proc_cpuinfo );
                 }
                 free( line );
             }
+            if ( scorep_timer != TIMER_TSC )
+            {
+                break;
+            }
 #  endif    /* HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC ) */
 
-            /* TODO: assert that all processes use TIMER_TSC running at the
-             * same frequency. For this we need to MPP communicate but MPP might
-             * not be initialized here. The frequency is interpolated at the end
-             * of the measurement, if we detect different frequencies there, this
-             * measurement is useless. Both problems can be solved by introducing
-             * a timer record per process/location. */
-            timer_tsc_t0 = SCOREP_Timer_GetClockTicks();
-            /* Either BACKEND_SCOREP_TIMER_CLOCK_GETTIME or
-             * BACKEND_SCOREP_TIMER_GETTIMEOFDAY are available, see check in
-             * scorep_timer_tsc.h */
+            /* The frequencies of all processes are compared in
+             * SCOREP_Timer_CheckFrequencies() when the clocks are
+             * synchronized at the begin, and again in
+             * SCOREP_Timer_GetClockResolution() at the end of the measurement. */
+            timer_tsc_t0   = get_clock_ticks_tsc();
+            timer_cmp_t0   = get_cmp_ticks();
 #  if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
-            struct timespec time;
-            int             result = clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
-            UTILS_ASSERT( result == 0 );
-            timer_cmp_t0   = ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
             timer_cmp_freq = UINT64_C( 1000000000 );
 #  else      /* HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) */
-            struct timeval tp;
-            gettimeofday( &tp, 0 );
-            timer_cmp_t0   =  ( uint64_t )tp.tv_sec * UINT64_C( 1000000 ) + ( uint64_t )tp.tv_usec;
             timer_cmp_freq = UINT64_C( 1000000 );
 #  endif
 # endif     /* ! HAVE( SCOREP_ARMV8_TSC ) */
@@ -231,15 +464,18 @@ SCOREP_Timer_Initialize( void )
             UTILS_FATAL( "Invalid timer selected, shouldn't happen." );
     }
 
+    /* From now on, read the selected timer without dispatching */
+    scorep_timer_get_clock_ticks = get_clock_ticks_function( scorep_timer );
+
     is_initialized = true;
 }
 
 
-uint64_t
-SCOREP_Timer_GetClockResolution( void )
+/* Resolution of the selected timer. For tsc, the frequency is interpolated
+ * since SCOREP_Timer_Initialize(). */
+static uint64_t
+get_resolution( void )
 {
-    UTILS_BUG_ON( !( SCOREP_IS_MEASUREMENT_PHASE( POST ) ),
-                  "Do not call SCOREP_Timer_GetClockResolution before finalization." );
     switch ( scorep_timer )
     {
 #if HAVE( BACKEND_SCOREP_TIMER_BGL )
@@ -280,128 +516,10 @@ SCOREP_Timer_GetClockResolution( void )
             asm ( "mrs %[result], CNTFRQ_EL0\n\t" :[ result ] "=r" ( timer_tsc_freq ) );
             return ( uint64_t )timer_tsc_freq;
 # else      /* ! HAVE( SCOREP_ARMV8_TSC ) */
-            uint64_t timer_tsc_t1 = SCOREP_Timer_GetClockTicks();
-            /* Either BACKEND_SCOREP_TIMER_CLOCK_GETTIME or
-             * BACKEND_SCOREP_TIMER_GETTIMEOFDAY are available, see check in
-             * scorep_timer_tsc.h */
-#  if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
-            struct timespec time;
-            int             result = clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
-            UTILS_ASSERT( result == 0 );
-            uint64_t timer_cmp_t1 = ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
-#  else      /* HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) */
-            struct timeval tp;
-            gettimeofday( &tp, 0 );
-            uint64_t timer_cmp_t1 =  ( uint64_t )tp.tv_sec * UINT64_C( 1000000 ) + ( uint64_t )tp.tv_usec;
-#  endif
-            /* Use interpolation to determine frequency.
-             * Interpolate and check consistency only once during finalization. */
-            static bool     first_visit = true;
-            static uint64_t timer_tsc_freq;
-            if ( first_visit )
-            {
-                first_visit = false;
-                UTILS_BUG_ON( timer_cmp_t1 - timer_cmp_t0 == 0, "Start and stop timestamps must differ." );
-                timer_tsc_freq = ( double )( timer_tsc_t1 - timer_tsc_t0 ) / ( timer_cmp_t1 - timer_cmp_t0 ) * timer_cmp_freq;
-
-                /* Assert that all processes use roughly the same frequency.
-                 * Problems with non-uniform frequencies to be solved by timer
-                 * per location-group record.*/
-                if ( SCOREP_Ipc_GetRank() != 0 )
-                {
-                    SCOREP_Ipc_Gather( &timer_tsc_freq, 0, 1, SCOREP_IPC_UINT64_T, 0 );
-                }
-                else
-                {
-                    int size = SCOREP_Ipc_GetSize();
-                    UTILS_BUG_ON( size == 0 );
-                    uint64_t frequencies[ size ];
-                    SCOREP_Ipc_Gather( &timer_tsc_freq,
-                                       frequencies,
-                                       1,
-                                       SCOREP_IPC_UINT64_T,
-                                       0 );
-
-                    /* Compute average of (non-negative) frequencies using integers, see
-                     * https://www.quora.com/How-can-I-compute-the-average-of-a-large-array-of-integers-without-running-into-overflow */
-                    uint64_t avg_frequency = 0;
-                    {
-                        uint64_t x = 0;
-                        uint64_t y = 0;
-                        for ( uint64_t i = 0; i < size; ++i )
-                        {
-                            x += frequencies[ i ] / size;
-                            uint64_t b = frequencies[ i ] % size;
-                            if ( y >= size - b )
-                            {
-                                x++;
-                                y -= size - b;
-                            }
-                            else
-                            {
-                                y += b;
-                            }
-                        }
-                        /* Average is exactly x + y / N, with 0 <= y < N.
-                         * Take the integer part only. */
-                        avg_frequency = x;
-                    }
-
-                    /* HPC CPU clock frequencies are in the order of 10^9 since
-                     * 2000. We observed CPUs frequencies to differ in the order
-                     * of 10^3. Thus, we will 'accept' frequencies in the range
-                     * [average_freq - threshold, average_freq + threshold] where
-                     * threshold is 'average_freq / 10^5' (i.e. in the order of
-                     * 10^4 or 0.01%).
-                     * For slower CPUs make sure the threshold larger than (the
-                     * arbitrarily chosen) 10. */
-                    uint64_t dividend  = 100000;
-                    uint64_t threshold = avg_frequency / dividend; /* Usually in the order of 10^4 */
-                    while ( threshold < 10 &&  dividend > 0 )
-                    {
-                        dividend  = dividend / 10;
-                        threshold = avg_frequency / dividend;
-                    }
-                    /* Check for frequency outliers. */
-                    uint64_t outliers[ size ];
-                    memset( outliers, 0, sizeof( uint64_t ) * size );
-                    bool has_outlier = false;
-                    for ( int i = 0; i < size; ++i )
-                    {
-                        uint64_t abs_diff;
-                        if ( avg_frequency > frequencies[ i ] )
-                        {
-                            abs_diff = avg_frequency - frequencies[ i ];
-                        }
-                        else
-                        {
-                            abs_diff = frequencies[ i ] - avg_frequency;
-                        }
-                        if ( abs_diff > threshold )
-                        {
-                            has_outlier   = true;
-                            outliers[ i ] = frequencies[ i ];
-                        }
-                    }
-
-                    /* Report if there are outliers. */
-                    if ( has_outlier )
-                    {
-                        UTILS_WARNING( "Calculated timer (tsc) frequencies differ from average frequency "
-                                       "(%" PRIu64 " Hz) by more than %" PRIu64 " Hz. "
-                                       "Consider using a timer with a fixed frequency like gettimeofday "
-                                       "or clock_gettime. Prolonging the measurement duration might "
-                                       "mitigate the frequency variations.",
-                                       avg_frequency, threshold );
-                        for ( int i = 0; i < size; ++i )
-                        {
-                            char* is_outlier = ( outliers[ i ] != 0 ) ? " (outlier)" : "";
-                            printf( "rank[%d]:\t frequency = %" PRIu64 " Hz%s\n", i, frequencies[ i ], is_outlier );
-                        }
-                    }
-                }
-            }
-            return timer_tsc_freq;
+            uint64_t timer_tsc_t1 = get_clock_ticks_tsc();
+            uint64_t timer_cmp_t1 = get_cmp_ticks();
+            UTILS_BUG_ON( timer_cmp_t1 - timer_cmp_t0 == 0, "Start and stop timestamps must differ." );
+            return ( double )( timer_tsc_t1 - timer_tsc_t0 ) / ( timer_cmp_t1 - timer_cmp_t0 ) * timer_cmp_freq;
 # endif /* ! HAVE( SCOREP_ARMV8_TSC ) */
         }
 #endif  /* BACKEND_SCOREP_TIMER_TSC */
@@ -422,6 +540,155 @@ SCOREP_Timer_GetClockResolution( void )
 }
 
 
+/* Collective over all processes. Reports on rank 0 the processes whose
+ * @a frequency differs from the average of all processes by more than
+ * 1/@a dividend of the average. Processes that use different timers show up
+ * as outliers, too. */
+static void
+check_frequencies( uint64_t    frequency,
+                   uint64_t    dividend,
+                   const char* advice )
+{
+    if ( SCOREP_Ipc_GetRank() != 0 )
+    {
+        SCOREP_Ipc_Gather( &frequency, 0, 1, SCOREP_IPC_UINT64_T, 0 );
+        return;
+    }
+
+    int size = SCOREP_Ipc_GetSize();
+    UTILS_BUG_ON( size == 0 );
+    uint64_t frequencies[ size ];
+    SCOREP_Ipc_Gather( &frequency,
+                       frequencies,
+                       1,
+                       SCOREP_IPC_UINT64_T,
+                       0 );
+
+    /* Compute average of (non-negative) frequencies using integers, see
+     * https://www.quora.com/How-can-I-compute-the-average-of-a-large-array-of-integers-without-running-into-overflow */
+    uint64_t avg_frequency = 0;
+    {
+        uint64_t x = 0;
+        uint64_t y = 0;
+        for ( uint64_t i = 0; i < size; ++i )
+        {
+            x += frequencies[ i ] / size;
+            uint64_t b = frequencies[ i ] % size;
+            if ( y >= size - b )
+            {
+                x++;
+                y -= size - b;
+            }
+            else
+            {
+                y += b;
+            }
+        }
+        /* Average is exactly x + y / N, with 0 <= y < N.
+         * Take the integer part only. */
+        avg_frequency = x;
+    }
+
+    /* For slower CPUs make sure the threshold larger than (the arbitrarily
+     * chosen) 10. */
+    uint64_t threshold = avg_frequency / dividend;
+    while ( threshold < 10 && dividend > 1 )
+    {
+        dividend  = dividend / 10;
+        threshold = avg_frequency / dividend;
+    }
+    /* Check for frequency outliers. */
+    uint64_t outliers[ size ];
+    memset( outliers, 0, sizeof( uint64_t ) * size );
+    bool has_outlier = false;
+    for ( int i = 0; i < size; ++i )
+    {
+        uint64_t abs_diff;
+        if ( avg_frequency > frequencies[ i ] )
+        {
+            abs_diff = avg_frequency - frequencies[ i ];
+        }
+        else
+        {
+            abs_diff = frequencies[ i ] - avg_frequency;
+        }
+        if ( abs_diff > threshold )
+        {
+            has_outlier   = true;
+            outliers[ i ] = frequencies[ i ];
+        }
+    }
+
+    /* Report if there are outliers. */
+    if ( has_outlier )
+    {
+        UTILS_WARNING( "Timer frequencies differ from average frequency "
+                       "(%" PRIu64 " Hz) by more than %" PRIu64 " Hz. %s",
+                       avg_frequency, threshold, advice );
+        for ( int i = 0; i < size; ++i )
+        {
+            char* is_outlier = ( outliers[ i ] != 0 ) ? " (outlier)" : "";
+            printf( "rank[%d]:\t frequency = %" PRIu64 " Hz%s\n", i, frequencies[ i ], is_outlier );
+        }
+    }
+}
+
+
+void
+SCOREP_Timer_CheckFrequencies( void )
+{
+#if HAVE( BACKEND_SCOREP_TIMER_TSC ) && !HAVE( SCOREP_ARMV8_TSC )
+    if ( scorep_timer == TIMER_TSC )
+    {
+        /* Interpolate over at least 10 ms, usually the initialization
+         * already took longer. */
+        while ( get_cmp_ticks() - timer_cmp_t0 < timer_cmp_freq / 100 )
+        {
+        }
+    }
+#endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && ! HAVE( SCOREP_ARMV8_TSC ) */
+
+    /* The interpolation period is short, thus accept deviations of 0.1%.
+     * Time stamp counters that are not invariant, e.g., scale with the
+     * CPU frequency, differ by far more. */
+    check_frequencies( get_resolution(), 1000,
+                       "The time stamp counters are likely not invariant or the processes "
+                       "use different timers. Consider using a timer with a fixed frequency "
+                       "like gettimeofday or clock_gettime." );
+}
+
+
+uint64_t
+SCOREP_Timer_GetClockResolution( void )
+{
+    UTILS_BUG_ON( !( SCOREP_IS_MEASUREMENT_PHASE( POST ) ),
+                  "Do not call SCOREP_Timer_GetClockResolution before finalization." );
+
+    /* Interpolate and check consistency only once during finalization. */
+    static bool     first_visit = true;
+    static uint64_t resolution;
+    if ( first_visit )
+    {
+        first_visit = false;
+        resolution  = get_resolution();
+
+        /* HPC CPU clock frequencies are in the order of 10^9 since
+         * 2000. We observed CPUs frequencies to differ in the order
+         * of 10^3. Thus, we will 'accept' frequencies in the range
+         * [average_freq - threshold, average_freq + threshold] where
+         * threshold is 'average_freq / 10^5' (i.e. in the order of
+         * 10^4 or 0.01%).
+         * Problems with non-uniform frequencies to be solved by timer
+         * per location-group record. */
+        check_frequencies( resolution, 100000,
+                           "Consider using a timer with a fixed frequency like gettimeofday "
+                           "or clock_gettime. Prolonging the measurement duration might "
+                           "mitigate the frequency variations." );
+    }
+    return resolution;
+}
+
+
 bool
 SCOREP_Timer_ClockIsGlobal( void )
 {
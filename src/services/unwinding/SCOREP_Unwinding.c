@@ -40,6 +40,8 @@
 /** Our subsystem id, used to address our per-location unwinding data */
 size_t scorep_unwinding_subsystem_id;
 
+bool scorep_unwinding_has_sample_drains;
+
 /* *********************************************************************
  * Public functions
  * ****************************************************************** */
@@ -186,6 +188,74 @@ SCOREP_Unwinding_GetCallingContext( SCOREP_Location*             location,
     }
 }
 
+void
+SCOREP_Unwinding_GetCallchainCallingContext( SCOREP_Location*             location,
+                                             const uint64_t*              callchain,
+                                             uint32_t                     callchainDepth,
+                                             SCOREP_CallingContextHandle* currentCallingContext,
+                                             SCOREP_CallingContextHandle* previousCallingContext,
+                                             uint32_t*                    unwindDistance )
+{
+    *currentCallingContext  = SCOREP_INVALID_CALLING_CONTEXT;
+    *previousCallingContext = SCOREP_INVALID_CALLING_CONTEXT;
+
+    if ( location == NULL )
+    {
+        return;
+    }
+
+    SCOREP_LocationType location_type = SCOREP_Location_GetType( location );
+    UTILS_BUG_ON( location_type != SCOREP_LOCATION_TYPE_CPU_THREAD,
+                  "Processing samples on non-CPU location is currently not supported" );
+    void* location_data = SCOREP_Location_GetSubsystemData( location, scorep_unwinding_subsystem_id );
+
+    SCOREP_ErrorCode result = scorep_unwinding_cpu_handle_callchain( location_data,
+                                                                     callchain,
+                                                                     callchainDepth,
+                                                                     currentCallingContext,
+                                                                     unwindDistance,
+                                                                     previousCallingContext );
+    if ( SCOREP_SUCCESS != result )
+    {
+        UTILS_ERROR( result, "Could not process calling context request" );
+    }
+}
+
+void
+SCOREP_Unwinding_SetSampleDrain( SCOREP_Location*               location,
+                                 SCOREP_Unwinding_SampleDrainCb drainCb,
+                                 void*                          drainArg )
+{
+    SCOREP_LocationType location_type = SCOREP_Location_GetType( location );
+    UTILS_BUG_ON( location_type != SCOREP_LOCATION_TYPE_CPU_THREAD, "This function should not have been called for non-cpu locations." );
+    SCOREP_Unwinding_CpuLocationData* location_data = SCOREP_Location_GetSubsystemData( location, scorep_unwinding_subsystem_id );
+    UTILS_BUG_ON( location_data == NULL, "location has no unwind data?" );
+
+    location_data->sample_drain     = drainCb;
+    location_data->sample_drain_arg = drainArg;
+    if ( drainCb )
+    {
+        scorep_unwinding_has_sample_drains = true;
+    }
+}
+
+void
+SCOREP_Unwinding_DrainSamples( SCOREP_Location* location )
+{
+    SCOREP_Unwinding_CpuLocationData* location_data = SCOREP_Location_GetSubsystemData( location, scorep_unwinding_subsystem_id );
+
+    /* Recording a sample never triggers a drain, but the drain may be
+       interrupted by a signal which wants to drain too */
+    if ( location_data
+         && location_data->sample_drain
+         && !location_data->in_sample_drain )
+    {
+        location_data->in_sample_drain = true;
+        location_data->sample_drain( location, location_data->sample_drain_arg );
+        location_data->in_sample_drain = false;
+    }
+}
+
 typedef struct process_calling_context_data_struct
 {
     SCOREP_Location*                location;
@@ -285,6 +355,39 @@ unwinding_subsystem_register( size_t subsystemId )
     return SCOREP_ConfigRegister( "unwinding", scorep_unwinding_confvars );
 }
 
+/** @brief Sets up the regions shared by all CPU locations.
+ *
+ *  @return It returns SCOREP_SUCCESS if successful,
+ *          otherwise an error code will be reported.
+ */
+static SCOREP_ErrorCode
+unwinding_subsystem_init( void )
+{
+    if ( !SCOREP_IsUnwindingEnabled() )
+    {
+        return SCOREP_SUCCESS;
+    }
+
+    scorep_unwinding_region_initialize();
+    if ( scorep_unwinding_preload_symbols )
+    {
+        scorep_unwinding_cpu_preload_regions();
+    }
+
+    return SCOREP_SUCCESS;
+}
+
+static void
+unwinding_subsystem_finalize( void )
+{
+    if ( !SCOREP_IsUnwindingEnabled() )
+    {
+        return;
+    }
+
+    scorep_unwinding_region_finalize();
+}
+
 static SCOREP_ErrorCode
 unwinding_subsystem_pre_unify( void )
 {
@@ -356,7 +459,9 @@ unwinding_subsystem_deactivate_cpu_location( SCOREP_Location*        location,
 
     if ( phase == SCOREP_CPU_LOCATION_PHASE_EVENTS )
     {
-        /* The location really goes into idle state, thus tear down */
+        /* The location really goes into idle state, thus tear down, deferred
+           samples still belong to the current instrumented regions */
+        SCOREP_Unwinding_DrainSamples( location );
         void* location_data = SCOREP_Location_GetSubsystemData( location, scorep_unwinding_subsystem_id );
         scorep_unwinding_cpu_deactivate( location_data );
     }
@@ -373,7 +478,9 @@ const SCOREP_Subsystem SCOREP_Subsystem_UnwindingService =
 {
     .subsystem_name                    = "UNWINDING",
     .subsystem_register                = &unwinding_subsystem_register,
+    .subsystem_init                    = &unwinding_subsystem_init,
     .subsystem_init_location           = &unwinding_subsystem_init_location,
     .subsystem_deactivate_cpu_location = &unwinding_subsystem_deactivate_cpu_location,
-    .subsystem_pre_unify               = &unwinding_subsystem_pre_unify
+    .subsystem_pre_unify               = &unwinding_subsystem_pre_unify,
+    .subsystem_finalize                = &unwinding_subsystem_finalize
 };
@@ -48,6 +48,31 @@ SCOREP_Unwinding_GetCallingContext( SCOREP_Location*             location,
     UTILS_BUG( "This function should not have been called." );
 }
 
+void
+SCOREP_Unwinding_GetCallchainCallingContext( SCOREP_Location*             location,
+                                             const uint64_t*              callchain,
+                                             uint32_t                     callchainDepth,
+                                             SCOREP_CallingContextHandle* currentCallingContext,
+                                             SCOREP_CallingContextHandle* previousCallingContext,
+                                             uint32_t*                    unwindDistance )
+{
+    UTILS_BUG( "This function should not have been called." );
+}
+
+void
+SCOREP_Unwinding_SetSampleDrain( SCOREP_Location*               location,
+                                 SCOREP_Unwinding_SampleDrainCb drainCb,
+                                 void*                          drainArg )
+{
+    UTILS_BUG( "This function should not have been called." );
+}
+
+void
+SCOREP_Unwinding_DrainSamples( SCOREP_Location* location )
+{
+    UTILS_BUG( "This function should not have been called." );
+}
+
 void
 SCOREP_Unwinding_ProcessCallingContext( SCOREP_Location*                location,
                                         uint64_t                        timestamp,
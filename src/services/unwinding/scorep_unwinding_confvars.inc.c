@@ -26,6 +26,21 @@
  * They are registered to the measurement system and are filled during
  * until the initialization function is called.
  */
+static bool scorep_unwinding_preload_symbols;
+
 static const SCOREP_ConfigVariable scorep_unwinding_confvars[] = {
+    {
+        "preload_symbols",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_unwinding_preload_symbols,
+        NULL,
+        "false",
+        "Read the function symbols of all loaded executables and libraries at start",
+        "Reads the symbol tables of the executable and all shared libraries "
+        "loaded at measurement start, to avoid looking up every newly seen "
+        "function with libunwind during the measurement. The functions are "
+        "shared by all threads of the process. This needs memory for all "
+        "functions of these files, even for those never sampled."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
@@ -22,6 +22,7 @@
 #include <SCOREP_Subsystem.h>
 #include <SCOREP_Location.h>
 #include <SCOREP_Events.h>
+#include <SCOREP_Atomic.h>
 
 #define SCOREP_DEBUG_MODULE_NAME UNWINDING
 #include <UTILS_Debug.h>
@@ -48,44 +49,45 @@ scorep_unwinding_cpu_get_location_data( SCOREP_Location* location )
     return cpu_unwind_data;
 }
 
+/** Start address of the main function, shared by all locations */
+static uint64_t start_ip_of_main;
+/** Start address of the function which started the thread */
+static uint64_t start_ip_of_fork;
+
 /**
  * Determine whether @region is the main region. If it is, we can
  * stop going up the stack.
  *
- * @param unwindData    Unwinding data of this location
  * @param region        Region to check
  *
  * @return True if @region is the main region, otherwise false
  */
 static bool
-check_is_main( SCOREP_Unwinding_CpuLocationData* unwindData,
-               scorep_unwinding_region*          region )
+check_is_main( scorep_unwinding_region* region )
 {
-    if ( 0 == unwindData->start_ip_of_main &&
+    if ( 0 == start_ip_of_main &&
          ( 0 == strcmp( "main",   region->name ) ||
            0 == strcmp( "MAIN__", region->name ) ) )
     {
-        unwindData->start_ip_of_main = region->start;
+        start_ip_of_main = region->start;
     }
 
-    return unwindData->start_ip_of_main == region->start;
+    return start_ip_of_main == region->start;
 }
 
 /**
  * Determine whether @region represents a thread fork event.
  * If it does, we can stop going up the stack.
  *
- * @param unwindData    Unwinding data of this location
  * @param region        Region to check
  *
  * @return True if @region represents a thread fork event,
  *         otherwise false
  */
 static bool
-check_is_fork( SCOREP_Unwinding_CpuLocationData* unwindData,
-               scorep_unwinding_region*          region )
+check_is_fork( scorep_unwinding_region* region )
 {
-    if ( ( 0 == unwindData->start_ip_of_fork ) &&
+    if ( ( 0 == start_ip_of_fork ) &&
          ( 0 == strcmp( "GOMP_taskwait",          region->name ) ||
            0 == strcmp( "GOMP_single_start",      region->name ) ||
            0 == strcmp( "gomp_thread_start",      region->name ) ||
@@ -94,10 +96,25 @@ check_is_fork( SCOREP_Unwinding_CpuLocationData* unwindData,
            0 == strcmp( "start_thread",           region->name ) ||
            0 == strcmp( "clone",                  region->name ) ) )
     {
-        unwindData->start_ip_of_fork = region->start;
+        start_ip_of_fork = region->start;
     }
 
-    return unwindData->start_ip_of_fork == region->start;
+    return start_ip_of_fork == region->start;
+}
+
+/**
+ * Checks the function name and returns true if the function belongs to
+ * the measurement system.
+ *
+ * @param regionName Region name to check
+ *
+ * @return True if this region is part of Score-P.
+ */
+static bool
+region_in_measurement( const char* regionName )
+{
+    return 0 == strncmp( "scorep_", regionName, 7 ) ||
+           0 == strncmp( "SCOREP_", regionName, 7 );
 }
 
 /**
@@ -111,8 +128,7 @@ check_is_fork( SCOREP_Unwinding_CpuLocationData* unwindData,
 static bool
 region_to_skip( const char* regionName )
 {
-    if ( 0 == strncmp( "scorep_", regionName, 7 ) ||
-         0 == strncmp( "SCOREP_", regionName, 7 ) ||
+    if ( region_in_measurement( regionName ) ||
          NULL != strstr( regionName, "._omp_fn." ) )
     {
         return true;
@@ -121,35 +137,47 @@ region_to_skip( const char* regionName )
     return false;
 }
 
+/**
+ * Initialize a new known region, called before other locations can see it.
+ *
+ * @param region        The new region
+ */
+static void
+init_region( scorep_unwinding_region* region )
+{
+    region->skip           = region_to_skip( region->name );
+    region->in_measurement = region_in_measurement( region->name );
+    region->is_main        = check_is_main( region );
+    region->is_fork        = check_is_fork( region );
+}
+
 /**
  * Create a new known region
  *
- * @param unwindData    Unwinding data of this location
  * @param startIp       Instruction pointer marking the beginning of a function
  * @param endIp         Instruction pointer marking the end of a function
  * @param regionName    Name of the region
  *
- * @return The newly created region.
+ * @return The newly created region, or the one another location created
+ *         for the same function.
  */
 static scorep_unwinding_region*
-create_region( SCOREP_Unwinding_CpuLocationData* unwindData,
-               uint64_t                          startIp,
-               uint64_t                          endIp,
-               const char*                       regionName )
+create_region( uint64_t    startIp,
+               uint64_t    endIp,
+               const char* regionName )
 {
     UTILS_DEBUG_ENTRY( "name=%s@[%p,%p)", regionName, startIp, endIp );
 
-    scorep_unwinding_region* region =
-        scorep_unwinding_region_insert( unwindData,
-                                        startIp,
-                                        endIp,
-                                        regionName );
-
-    region->skip    = region_to_skip( regionName );
-    region->is_main = check_is_main( unwindData, region );
-    region->is_fork = check_is_fork( unwindData, region );
+    return scorep_unwinding_region_insert( startIp,
+                                           endIp,
+                                           regionName,
+                                           init_region );
+}
 
-    return region;
+void
+scorep_unwinding_cpu_preload_regions( void )
+{
+    scorep_unwinding_region_preload( init_region );
 }
 
 /**
@@ -214,12 +242,53 @@ get_region( SCOREP_Unwinding_CpuLocationData* unwindData,
         // ??? return NULL;
     }
 
-    return create_region( unwindData,
-                          proc_info.start_ip,
+    return create_region( proc_info.start_ip,
                           proc_info.end_ip,
                           unwindData->region_name_buffer );
 }
 
+/**
+ * Looks-up the region by IP without a cursor of the current stack. If not
+ * found, a cursor is positioned at @a ip to create one.
+ *
+ * @param unwindData    Unwinding data of this location
+ * @param ip            The instruction address
+ *
+ * @return The region belonging to the instruction address.
+ */
+static scorep_unwinding_region*
+get_region_by_ip( SCOREP_Unwinding_CpuLocationData* unwindData,
+                  uint64_t                          ip )
+{
+    scorep_unwinding_region* region = scorep_unwinding_region_find( unwindData, ip );
+
+    if ( region )
+    {
+        return region;
+    }
+
+    int ret = unw_getcontext( &unwindData->context );
+    if ( ret < 0 )
+    {
+        UTILS_DEBUG( "Could not get libunwind context: %s", unw_strerror( ret ) );
+        return NULL;
+    }
+    ret = unw_init_local( &unwindData->cursor, &unwindData->context );
+    if ( ret < 0 )
+    {
+        UTILS_DEBUG( "Could not get libunwind cursor: %s", unw_strerror( ret ) );
+        return NULL;
+    }
+    ret = unw_set_reg( &unwindData->cursor, UNW_REG_IP, ip );
+    if ( ret < 0 )
+    {
+        UTILS_DEBUG( "Could not set IP %#tx in libunwind cursor: %s", ip, unw_strerror( ret ) );
+        return NULL;
+    }
+
+    return get_region( unwindData, &unwindData->cursor, ip );
+}
+
 static void
 put_unused( SCOREP_Unwinding_CpuLocationData* unwindData,
             void*                             unusedObject )
@@ -448,6 +517,66 @@ get_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData )
     return current_stack;
 }
 
+/** Creates the current stack out of a callchain
+ *
+ *  @param unwindData             Unwinding data of the location
+ *  @param callchain              Sampled IP followed by the return addresses
+ *  @param callchainDepth         Number of elements in @a callchain
+ *
+ *  @return the stack
+ */
+static scorep_unwinding_frame*
+get_callchain_stack( SCOREP_Unwinding_CpuLocationData* unwindData,
+                     const uint64_t*                   callchain,
+                     uint32_t                          callchainDepth )
+{
+    scorep_unwinding_frame* current_stack = NULL;
+
+    UTILS_DEBUG_ENTRY();
+
+    for ( uint32_t i = 0; i < callchainDepth; i++ )
+    {
+        /* Attribute return addresses to the call instruction, as they may
+           already belong to the next function */
+        uint64_t ip = callchain[ i ] - ( i > 0 ? 1 : 0 );
+
+        scorep_unwinding_region* region = get_region_by_ip( unwindData, ip );
+        if ( !region )
+        {
+            continue;
+        }
+
+        /* The kernel takes samples inside the measurement system too, which
+           the signal handler would ignore. Ignore them here as well. */
+        if ( region->in_measurement )
+        {
+            UTILS_DEBUG( " Drop sample inside the measurement system" );
+            drop_stack( unwindData, current_stack );
+            return NULL;
+        }
+        if ( region->skip )
+        {
+            continue;
+        }
+
+        push_stack( unwindData, &current_stack, region, ip );
+
+        if ( region->is_fork )
+        {
+            UTILS_DEBUG( " Break on is_fork" );
+            break;
+        }
+
+        if ( region->is_main )
+        {
+            UTILS_DEBUG( " Break on main" );
+            break;
+        }
+    }
+
+    return current_stack;
+}
+
 static scorep_unwinding_surrogate*
 get_surrogate( SCOREP_Unwinding_CpuLocationData* unwindData,
                uint64_t                          ip,
@@ -634,6 +763,14 @@ drop_unhandled_wrappers( SCOREP_Unwinding_CpuLocationData* unwindData )
     }
 }
 
+static SCOREP_ErrorCode
+descend_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData,
+                       scorep_unwinding_frame*           currentStack,
+                       SCOREP_RegionHandle               instrumentedRegionHandle,
+                       scorep_unwinding_surrogate*       newSurrogates,
+                       SCOREP_CallingContextHandle*      callingContext,
+                       uint32_t*                         unwindDistance );
+
 SCOREP_ErrorCode
 scorep_unwinding_cpu_handle_enter( SCOREP_Unwinding_CpuLocationData* unwindData,
                                    void*                             contextPtr,
@@ -800,6 +937,37 @@ scorep_unwinding_cpu_handle_enter( SCOREP_Unwinding_CpuLocationData* unwindData,
     }
 
     scorep_unwinding_frame* current_stack = get_current_stack( unwindData );
+
+    return descend_current_stack( unwindData,
+                                  current_stack,
+                                  instrumentedRegionHandle,
+                                  new_surrogates,
+                                  callingContext,
+                                  unwindDistance );
+}
+
+/**
+ * Descends with @a currentStack into the calling context tree, starting
+ * below the instrumented regions of the location.
+ *
+ * @param unwindData                Unwinding data of the location
+ * @param currentStack              The current stack, outermost frame first,
+ *                                  consumed by this function
+ * @param instrumentedRegionHandle  The entered instrumented region, or
+ *                                  SCOREP_INVALID_REGION for a sample
+ * @param newSurrogates             Resolved wrappers to enter
+ */
+static SCOREP_ErrorCode
+descend_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData,
+                       scorep_unwinding_frame*           currentStack,
+                       SCOREP_RegionHandle               instrumentedRegionHandle,
+                       scorep_unwinding_surrogate*       newSurrogates,
+                       SCOREP_CallingContextHandle*      callingContext,
+                       uint32_t*                         unwindDistance )
+{
+    scorep_unwinding_frame*     current_stack  = currentStack;
+    scorep_unwinding_surrogate* new_surrogates = newSurrogates;
+
     if ( !current_stack )
     {
         UTILS_BUG_ON( instrumentedRegionHandle, "Empty stack for enter" );
@@ -858,25 +1026,15 @@ scorep_unwinding_cpu_handle_enter( SCOREP_Unwinding_CpuLocationData* unwindData,
     {
         UTILS_BUG_ON( current_stack->region == NULL, "Missing region for stack frame" );
 
-        if ( current_stack->region->handle == SCOREP_INVALID_REGION )
-        {
-            /* Need to define the region first */
-            current_stack->region->handle = SCOREP_Definitions_NewRegion(
-                current_stack->region->name,
-                NULL,
-                SCOREP_INVALID_SOURCE_FILE,
-                SCOREP_INVALID_LINE_NO,
-                SCOREP_INVALID_LINE_NO,
-                SCOREP_PARADIGM_SAMPLING,
-                SCOREP_REGION_FUNCTION );
-        }
+        SCOREP_RegionHandle region_handle =
+            scorep_unwinding_region_get_handle( current_stack->region );
 
         /* Decent into the calling context tree */
         calling_context_descent( unwindData->location,
                                  &unwind_context,
                                  unwindDistance,
                                  current_stack->ip,
-                                 current_stack->region->handle );
+                                 region_handle );
 
         /* We want to enter an instrumented region, thus we need to create
            the augmented stack, thus convert the current frame to an augmented
@@ -1031,6 +1189,60 @@ scorep_unwinding_cpu_handle_exit( SCOREP_Unwinding_CpuLocationData* unwindData,
     return SCOREP_SUCCESS;
 }
 
+SCOREP_ErrorCode
+scorep_unwinding_cpu_handle_callchain( SCOREP_Unwinding_CpuLocationData* unwindData,
+                                       const uint64_t*                   callchain,
+                                       uint32_t                          callchainDepth,
+                                       SCOREP_CallingContextHandle*      callingContext,
+                                       uint32_t*                         unwindDistance,
+                                       SCOREP_CallingContextHandle*      previousCallingContext )
+{
+    if ( !unwindData )
+    {
+        return UTILS_ERROR( SCOREP_ERROR_INVALID_ARGUMENT, "location has no unwind data?" );
+    }
+
+    UTILS_DEBUG_ENTRY( "%p depth=%u", unwindData->location, callchainDepth );
+
+    *previousCallingContext = unwindData->previous_calling_context;
+
+    /* Unhandled wrappers are resolved by stepping a cursor through the
+       stack, which a callchain does not provide. Ignore the sample. */
+    if ( callchainDepth == 0 || unwindData->unhandled_wrappers )
+    {
+        return SCOREP_SUCCESS;
+    }
+
+    if ( unwindData->augmented_stack
+         && unwindData->augmented_stack->surrogates->is_wrapped )
+    {
+        /* sample inside wrapped region */
+        scorep_unwinding_calling_context_tree_node* unwind_context = unwindData->augmented_stack->surrogates->unwind_context;
+        *unwindDistance = 0;
+        calling_context_descent( unwindData->location,
+                                 &unwind_context,
+                                 unwindDistance,
+                                 callchain[ 0 ],
+                                 unwindData->augmented_stack->surrogates->region_handle );
+
+        *callingContext                      = unwind_context->handle;
+        unwindData->previous_calling_context = *callingContext;
+
+        return SCOREP_SUCCESS;
+    }
+
+    scorep_unwinding_frame* current_stack = get_callchain_stack( unwindData,
+                                                                 callchain,
+                                                                 callchainDepth );
+
+    return descend_current_stack( unwindData,
+                                  current_stack,
+                                  SCOREP_INVALID_REGION,
+                                  NULL,
+                                  callingContext,
+                                  unwindDistance );
+}
+
 void
 scorep_unwinding_cpu_deactivate( SCOREP_Unwinding_CpuLocationData* unwindData )
 {
@@ -60,6 +60,21 @@ scorep_unwinding_cpu_handle_exit( SCOREP_Unwinding_CpuLocationData* unwindData,
                                   uint32_t*                         unwindDistance,
                                   SCOREP_CallingContextHandle*      previousCallingContext );
 
+/**
+ * Called by @a SCOREP_Unwinding_GetCallchainCallingContext for CPU locations.
+ */
+SCOREP_ErrorCode
+scorep_unwinding_cpu_handle_callchain( SCOREP_Unwinding_CpuLocationData* unwindData,
+                                       const uint64_t*                   callchain,
+                                       uint32_t                          callchainDepth,
+                                       SCOREP_CallingContextHandle*      callingContext,
+                                       uint32_t*                         unwindDistance,
+                                       SCOREP_CallingContextHandle*      previousCallingContext );
+
+/** Makes the functions of all loaded ELF files known to all CPU locations. */
+void
+scorep_unwinding_cpu_preload_regions( void );
+
 void
 scorep_unwinding_cpu_deactivate( SCOREP_Unwinding_CpuLocationData* unwindData );
 
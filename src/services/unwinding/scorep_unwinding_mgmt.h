@@ -23,6 +23,7 @@
 #include <UTILS_Error.h>
 
 #include <SCOREP_DefinitionHandles.h>
+#include <SCOREP_Unwinding.h>
 
 #define UNW_LOCAL_ONLY
 #include <libunwind.h>
@@ -35,6 +36,9 @@
 /** Size of the region name buffer passed to libunwind. */
 #define  MAX_FUNC_NAME_LENGTH 1024
 
+/** Log2 of the number of entries in the per-location region cache */
+#define REGION_CACHE_POWER   6
+
 
 /** Our subsystem id, used to address our per-location unwinding data */
 extern size_t scorep_unwinding_subsystem_id;
@@ -46,9 +50,8 @@ extern size_t scorep_unwinding_subsystem_id;
  */
 typedef struct scorep_unwinding_region
 {
-    /** left and right child in the splay tree */
-    struct scorep_unwinding_region* left;
-    struct scorep_unwinding_region* right;
+    /** Next region not yet merged into the sorted region table */
+    struct scorep_unwinding_region* next;
 
     /** Start IP of a function */
     uint64_t            start;
@@ -63,6 +66,8 @@ typedef struct scorep_unwinding_region
     bool is_main;
     /** True if this region represents a fork event spawning additional threads */
     bool is_fork;
+    /** True if this function belongs to the measurement system */
+    bool in_measurement;
 
     /** Region name */
     char name[ 1 ];
@@ -186,13 +191,9 @@ typedef struct SCOREP_Unwinding_CpuLocationData
     /** Wrapper meta data, before they re used in actual unwinding */
     scorep_unwinding_unhandled_wrapper* unhandled_wrappers;
 
-    /** The address of the main function */
-    uint64_t start_ip_of_main;
-    /** Instruction pointer of the fork event */
-    uint64_t start_ip_of_fork;
-
-    /** Splay tree containing already known regions */
-    scorep_unwinding_region* known_regions;
+    /** Regions recently found by this location, indexed by a hash of the
+        looked-up address, in front of the process-wide region table */
+    scorep_unwinding_region* region_cache[ 1 << REGION_CACHE_POWER ];
 
     /** Stack unwinding management data, keep it here instead of on the stack because they tend to be large */
     unw_context_t context;
@@ -206,6 +207,12 @@ typedef struct SCOREP_Unwinding_CpuLocationData
     /** Last known calling context */
     SCOREP_CallingContextHandle previous_calling_context;
 
+    /** Records the deferred samples of this location, see SCOREP_Unwinding_SetSampleDrain() */
+    SCOREP_Unwinding_SampleDrainCb sample_drain;
+    void*                          sample_drain_arg;
+    /** True while @a sample_drain runs */
+    bool                           in_sample_drain;
+
     /* Below is storage normally allocated on the stack.
        As they are rather big, we allocate them in the per-location data.
        None of these variables are used in recursive calls. */
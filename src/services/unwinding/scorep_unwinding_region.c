@@ -21,257 +21,640 @@
 #include <SCOREP_Definitions.h>
 #include <SCOREP_Subsystem.h>
 #include <SCOREP_Location.h>
+#include <SCOREP_Atomic.h>
+#include <SCOREP_Mutex.h>
 
 #define SCOREP_DEBUG_MODULE_NAME UNWINDING
 #include <UTILS_Debug.h>
+#include <UTILS_IO.h>
 
 #include <unistd.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Regions added since the last rebuild of the table are kept in a list, which
+ * is searched linearly. */
+#define MAX_PENDING_REGIONS 32
+
+/* Regions are allocated in chunks of this size */
+#define REGION_CHUNK_SIZE   ( 64 * 1024 )
+
+
+typedef struct
+{
+    scorep_unwinding_region* region;
+    /* Largest end address of this and all preceding regions. Functions may
+     * nest, e.g., symbols covering a whole object, thus the region containing
+     * an address is not necessarily the last one starting before it. */
+    uint64_t                 max_end;
+} region_table_entry;
+
+
+typedef struct region_table region_table;
+struct region_table
+{
+    region_table*      retired_next;
+    size_t             size;
+    region_table_entry entries[];
+};
+
+
+typedef struct region_chunk region_chunk;
+struct region_chunk
+{
+    region_chunk* next;
+    size_t        used;
+    size_t        size;
+    char          memory[];
+};
 
-/* Splay tree based on: */
-/*
-                An implementation of top-down splaying
-                    D. Sleator <sleator@cs.cmu.edu>
-                            March 1992
-
-   "Splay trees", or "self-adjusting search trees" are a simple and
-   efficient data structure for storing an ordered set.  The data
-   structure consists of a binary tree, without parent pointers, and no
-   additional fields.  It allows searching, insertion, deletion,
-   deletemin, deletemax, splitting, joining, and many other operations,
-   all with amortized logarithmic performance.  Since the trees adapt to
-   the sequence of requests, their performance on real access patterns is
-   typically even better.  Splay trees are described in a number of texts
-   and papers [1,2,3,4,5].
-
-   The code here is adapted from simple top-down splay, at the bottom of
-   page 669 of [3].  It can be obtained via anonymous ftp from
-   spade.pc.cs.cmu.edu in directory /usr/sleator/public.
-
-   The chief modification here is that the splay operation works even if the
-   item being splayed is not in the tree, and even if the tree root of the
-   tree is NULL.  So the line:
-
-                              t = splay(i, t);
-
-   causes it to search for item with key i in the tree rooted at t.  If it's
-   there, it is splayed to the root.  If it isn't there, then the node put
-   at the root is the last one before NULL that would have been reached in a
-   normal binary search for i.  (It's a neighbor of i in the tree.)  This
-   allows many other operations to be easily implemented, as shown below.
-
-   [1] "Fundamentals of data structures in C", Horowitz, Sahni,
-       and Anderson-Freed, Computer Science Press, pp 542-547.
-   [2] "Data Structures and Their Algorithms", Lewis and Denenberg,
-       Harper Collins, 1991, pp 243-251.
-   [3] "Self-adjusting Binary Search Trees" Sleator and Tarjan,
-       JACM Volume 32, No 3, July 1985, pp 652-686.
-   [4] "Data Structure and Algorithm Analysis", Mark Weiss,
-       Benjamin Cummins, 1992, pp 119-130.
-   [5] "Data Structures, Algorithms, and Performance", Derick Wood,
-       Addison-Wesley, 1993, pp 367-375.
- */
 
+static SCOREP_Mutex             region_cache_mutex;
+static region_table*            region_cache_table;
+static scorep_unwinding_region* pending_regions;
+static size_t                   number_of_pending_regions;
+static region_table*            retired_tables;
+static region_chunk*            region_chunks;
+
+
+/* Call with the region cache mutex locked. */
 static scorep_unwinding_region*
-splay( scorep_unwinding_region* root,
-       uint64_t                 key )
+new_region( uint64_t    start,
+            uint64_t    end,
+            const char* name )
 {
-    scorep_unwinding_region  sentinel;
-    scorep_unwinding_region* left;
-    scorep_unwinding_region* right;
-    scorep_unwinding_region* node;
+    size_t len  = strlen( name );
+    size_t size = ( sizeof( scorep_unwinding_region ) + len + 7 ) & ~( size_t )7;
+    if ( region_chunks == NULL || region_chunks->size - region_chunks->used < size )
+    {
+        size_t        chunk_size = size > REGION_CHUNK_SIZE ? size : REGION_CHUNK_SIZE;
+        region_chunk* chunk      = malloc( sizeof( *chunk ) + chunk_size );
+        UTILS_BUG_ON( chunk == NULL, "Failed to allocate memory for unwinding regions." );
+        chunk->next   = region_chunks;
+        chunk->used   = 0;
+        chunk->size   = chunk_size;
+        region_chunks = chunk;
+    }
+
+    scorep_unwinding_region* new = ( scorep_unwinding_region* )( region_chunks->memory + region_chunks->used );
+    region_chunks->used += size;
+
+    memset( new, 0, sizeof( *new ) );
+    new->start  = start;
+    new->end    = end;
+    new->handle = SCOREP_INVALID_REGION;
+    memcpy( new->name, name, len + 1 );
+    return new;
+}
+
 
-    if ( root == NULL )
+static region_table*
+new_table( size_t size )
+{
+    region_table* table = malloc( sizeof( *table ) + size * sizeof( region_table_entry ) );
+    UTILS_BUG_ON( table == NULL, "Failed to allocate unwinding region table." );
+    table->retired_next = NULL;
+    table->size         = 0;
+    return table;
+}
+
+
+void
+scorep_unwinding_region_initialize( void )
+{
+    SCOREP_ErrorCode result = SCOREP_MutexCreate( &region_cache_mutex );
+    UTILS_BUG_ON( result != SCOREP_SUCCESS, "Failed to create unwinding region mutex." );
+
+    region_cache_table = new_table( 0 );
+}
+
+
+void
+scorep_unwinding_region_finalize( void )
+{
+    while ( retired_tables )
+    {
+        region_table* table = retired_tables;
+        retired_tables = table->retired_next;
+        free( table );
+    }
+    free( region_cache_table );
+    region_cache_table = NULL;
+
+    while ( region_chunks )
     {
-        return root;
+        region_chunk* chunk = region_chunks;
+        region_chunks = chunk->next;
+        free( chunk );
     }
+    pending_regions           = NULL;
+    number_of_pending_regions = 0;
+
+    SCOREP_MutexDestroy( &region_cache_mutex );
+}
 
-    sentinel.left = sentinel.right = NULL;
-    left          = right = &sentinel;
 
-    for (;; )
+/* Returns the index of the first region starting behind @a addr. */
+static size_t
+search_table( const region_table* table,
+              uint64_t            addr )
+{
+    size_t low  = 0;
+    size_t high = table->size;
+    while ( low < high )
     {
-        if ( key < root->start )
+        size_t mid = low + ( high - low ) / 2;
+        if ( table->entries[ mid ].region->start <= addr )
         {
-            if ( root->left == NULL )
-            {
-                break;
-            }
-            if ( key < root->left->start )
-            {
-                node        = root->left;                    /* rotate right */
-                root->left  = node->right;
-                node->right = root;
-                root        = node;
-                if ( root->left == NULL )
-                {
-                    break;
-                }
-            }
-            right->left = root;                               /* link right */
-            right       = root;
-            root        = root->left;
+            low = mid + 1;
         }
-        else if ( key > root->start )
+        else
         {
-            if ( root->right == NULL )
+            high = mid;
+        }
+    }
+    return low;
+}
+
+
+static int
+compare_regions( const void* a,
+                 const void* b )
+{
+    uint64_t start_a = ( *( scorep_unwinding_region* const* )a )->start;
+    uint64_t start_b = ( *( scorep_unwinding_region* const* )b )->start;
+    return start_a < start_b ? -1 : start_a > start_b;
+}
+
+
+/* Call with the region cache mutex locked. Merges @a regions into a new
+ * table, regions with the start address of an already taken one are
+ * dropped. */
+static void
+merge_regions( scorep_unwinding_region** regions,
+               size_t                    numberOfRegions,
+               scorep_unwinding_region_init init )
+{
+    qsort( regions, numberOfRegions, sizeof( *regions ), compare_regions );
+
+    region_table* old_table = region_cache_table;
+    region_table* table     = new_table( old_table->size + numberOfRegions );
+    size_t        i         = 0;
+    size_t        j         = 0;
+    while ( i < old_table->size || j < numberOfRegions )
+    {
+        scorep_unwinding_region* region;
+        if ( j == numberOfRegions
+             || ( i < old_table->size && old_table->entries[ i ].region->start <= regions[ j ]->start ) )
+        {
+            region = old_table->entries[ i++ ].region;
+        }
+        else
+        {
+            region = regions[ j++ ];
+            if ( table->size > 0 && table->entries[ table->size - 1 ].region->start == region->start )
             {
-                break;
+                continue;
             }
-            if ( key > root->right->start )
+            if ( init )
             {
-                node        = root->right;                   /* rotate left */
-                root->right = node->left;
-                node->left  = root;
-                root        = node;
-                if ( root->right == NULL )
-                {
-                    break;
-                }
+                init( region );
             }
-            left->right = root;                              /* link left */
-            left        = root;
-            root        = root->right;
         }
-        else
+        uint64_t max_end = SCOREP_ATOMIC_LOAD( &region->end, SCOREP_ATOMIC_RELAXED );
+        if ( table->size > 0 && table->entries[ table->size - 1 ].max_end > max_end )
         {
-            break;
+            max_end = table->entries[ table->size - 1 ].max_end;
         }
+        table->entries[ table->size ].region  = region;
+        table->entries[ table->size ].max_end = max_end;
+        table->size++;
     }
 
-    left->right = root->left;                                /* assemble */
-    right->left = root->right;
-    root->left  = sentinel.right;
-    root->right = sentinel.left;
+    SCOREP_ATOMIC_STORE( &region_cache_table, table, SCOREP_ATOMIC_RELEASE );
 
-    return root;
+    old_table->retired_next = retired_tables;
+    retired_tables          = old_table;
 }
 
 
-static scorep_unwinding_region*
-alloc_region( SCOREP_Unwinding_CpuLocationData* unwindData,
-              uint64_t                          start,
-              uint64_t                          end,
-              const char*                       name )
+/* Call with the region cache mutex locked. */
+static void
+merge_pending_regions( void )
 {
-    size_t                   len = strlen( name );
-    scorep_unwinding_region* new = SCOREP_Location_AllocForMisc( unwindData->location, sizeof( *new ) + len );
-    memset( new, 0, sizeof( *new ) );
-    new->start = start;
-    new->end   = end;
-    memcpy( new->name, name, len + 1 );
-    new->left = new->right = NULL;
-    return new;
+    scorep_unwinding_region** regions = malloc( number_of_pending_regions * sizeof( *regions ) );
+    UTILS_BUG_ON( regions == NULL, "Failed to allocate unwinding region table." );
+    size_t n = 0;
+    for ( scorep_unwinding_region* region = pending_regions; region; region = region->next )
+    {
+        regions[ n++ ] = region;
+    }
+    merge_regions( regions, n, NULL );
+    free( regions );
+
+    /* Readers which still see the old list also see all regions of the old
+       table, readers which see the empty list also see the new table. */
+    SCOREP_ATOMIC_STORE( &pending_regions, NULL, SCOREP_ATOMIC_RELEASE );
+    number_of_pending_regions = 0;
 }
 
 
 scorep_unwinding_region*
-scorep_unwinding_region_insert( SCOREP_Unwinding_CpuLocationData* unwindData,
-                                uint64_t                          start,
-                                uint64_t                          end,
-                                const char*                       name )
+scorep_unwinding_region_insert( uint64_t                     start,
+                                uint64_t                     end,
+                                const char*                  name,
+                                scorep_unwinding_region_init init )
 {
-    if ( unwindData == NULL )
+    SCOREP_MutexLock( region_cache_mutex );
+
+    scorep_unwinding_region* region   = NULL;
+    size_t                   index    = search_table( region_cache_table, start );
+    bool                     in_table = false;
+    if ( index > 0 && region_cache_table->entries[ index - 1 ].region->start == start )
     {
-        return NULL;
+        region   = region_cache_table->entries[ index - 1 ].region;
+        in_table = true;
     }
-
-    if ( unwindData->known_regions == NULL )
+    for ( scorep_unwinding_region* pending = pending_regions; !region && pending; pending = pending->next )
     {
-        unwindData->known_regions = alloc_region( unwindData, start, end, name );
+        if ( pending->start == start )
+        {
+            region = pending;
+        }
     }
-    else
+
+    if ( region )
     {
-        unwindData->known_regions = splay( unwindData->known_regions, start );
-        if ( start < unwindData->known_regions->start )
+        /* Another location resolved this function in the meantime, or the
+           same code is known under an alias name. */
+        UTILS_DEBUG( "Region '%s@[%#" PRIx64 ", %#" PRIx64 ")' known as '%s@[%#" PRIx64 ", %#" PRIx64 ")'",
+                     name, start, end, region->name, region->start, region->end );
+        if ( end > region->end && 0 == strcmp( name, region->name ) )
         {
-            scorep_unwinding_region* new = alloc_region( unwindData, start, end, name );
-            new->right                = unwindData->known_regions;
-            new->left                 = new->right->left;
-            new->right->left          = NULL;
-            unwindData->known_regions = new;
+            SCOREP_ATOMIC_STORE( &region->end, end, SCOREP_ATOMIC_RELAXED );
+
+            /* Pending regions get their max_end when merged. A reader missing
+               the update only resolves the address again. */
+            for ( size_t i = index - 1;
+                  in_table && i < region_cache_table->size
+                  && region_cache_table->entries[ i ].max_end < end;
+                  i++ )
+            {
+                SCOREP_ATOMIC_STORE( &region_cache_table->entries[ i ].max_end, end, SCOREP_ATOMIC_RELAXED );
+            }
         }
-        else if ( start > unwindData->known_regions->start )
+        SCOREP_MutexUnlock( region_cache_mutex );
+        return region;
+    }
+
+    region = new_region( start, end, name );
+    if ( init )
+    {
+        init( region );
+    }
+
+    region->next = pending_regions;
+    SCOREP_ATOMIC_STORE( &pending_regions, region, SCOREP_ATOMIC_RELEASE );
+    if ( ++number_of_pending_regions == MAX_PENDING_REGIONS )
+    {
+        merge_pending_regions();
+    }
+
+    SCOREP_MutexUnlock( region_cache_mutex );
+    return region;
+}
+
+
+static inline bool
+region_contains( scorep_unwinding_region* region,
+                 uint64_t                 addr )
+{
+    return region->start <= addr
+           && addr < SCOREP_ATOMIC_LOAD( &region->end, SCOREP_ATOMIC_RELAXED );
+}
+
+
+/* Returns the innermost region containing @a addr. @a cacheable is set if no
+ * other known region starts inside of it. */
+static scorep_unwinding_region*
+lookup_region( uint64_t addr,
+               bool*    cacheable )
+{
+    /* Load the list first, see merge_pending_regions() */
+    scorep_unwinding_region* pending = SCOREP_ATOMIC_LOAD( &pending_regions, SCOREP_ATOMIC_ACQUIRE );
+    region_table*            table   = SCOREP_ATOMIC_LOAD( &region_cache_table, SCOREP_ATOMIC_ACQUIRE );
+    if ( table == NULL )
+    {
+        return NULL;
+    }
+
+    /* Walk back from the last region starting at or before @a addr, as long
+       as a region can still contain it */
+    scorep_unwinding_region* region = NULL;
+    for ( size_t index = search_table( table, addr );
+          index > 0
+          && SCOREP_ATOMIC_LOAD( &table->entries[ index - 1 ].max_end, SCOREP_ATOMIC_RELAXED ) > addr;
+          index-- )
+    {
+        if ( region_contains( table->entries[ index - 1 ].region, addr ) )
         {
-            scorep_unwinding_region* new = alloc_region( unwindData, start, end, name );
-            new->left                 = unwindData->known_regions;
-            new->right                = new->left->right;
-            new->left->right          = NULL;
-            unwindData->known_regions = new;
+            region     = table->entries[ index - 1 ].region;
+            *cacheable = index == table->size
+                         || table->entries[ index ].region->start
+                         >= SCOREP_ATOMIC_LOAD( &region->end, SCOREP_ATOMIC_RELAXED );
+            break;
         }
-        else
+    }
+
+    /* A pending region may be nested in the one from the table, or enclose it */
+    for (; pending; pending = pending->next )
+    {
+        if ( region_contains( pending, addr ) && ( !region || pending->start > region->start ) )
         {
-            /* start is the same, if the name matches, than just extend the end */
-            UTILS_BUG_ON( 0 != strcmp( name, unwindData->known_regions->name ),
-                          "Region already known: %s@[%#" PRIx64 ", %#" PRIx64 ") "
-                          "existing: %s@[%#" PRIx64 ", %#" PRIx64 ")",
-                          name, start, end,
-                          unwindData->known_regions->name,
-                          unwindData->known_regions->start,
-                          unwindData->known_regions->end );
-            UTILS_BUG_ON( end < unwindData->known_regions->end,
-                          "Region '%s@%#" PRIx64 "' does not extend: %#" PRIx64 " < %#" PRIx64,
-                          name, start, end, unwindData->known_regions->end );
-            UTILS_DEBUG( "Extending existing region '%s@%#" PRIx64 "': %#" PRIx64 " -> %#" PRIx64 "",
-                         name, start, unwindData->known_regions->end, end );
-            unwindData->known_regions->end = end;
+            region     = pending;
+            *cacheable = false;
         }
     }
 
-    return unwindData->known_regions;
+    return region;
 }
 
+
 scorep_unwinding_region*
 scorep_unwinding_region_find( SCOREP_Unwinding_CpuLocationData* unwindData,
                               uint64_t                          addr )
 {
-    if ( unwindData == NULL || unwindData->known_regions == NULL )
+    if ( unwindData == NULL )
     {
         return NULL;
     }
 
-    scorep_unwinding_region* node = unwindData->known_regions;
-    while ( node )
+    /* Fibonacci hashing, consecutive addresses of a loop map to different entries */
+    uint32_t                 slot   = ( uint32_t )( ( addr * UINT64_C( 0x9E3779B97F4A7C15 ) )
+                                                    >> ( 64 - REGION_CACHE_POWER ) );
+    scorep_unwinding_region* region = unwindData->region_cache[ slot ];
+    if ( region && region_contains( region, addr ) )
+    {
+        return region;
+    }
+
+    /* Regions with nested regions would hide these in the cache */
+    bool cacheable = false;
+    region = lookup_region( addr, &cacheable );
+    if ( region && cacheable )
+    {
+        unwindData->region_cache[ slot ] = region;
+    }
+
+    return region;
+}
+
+
+SCOREP_RegionHandle
+scorep_unwinding_region_get_handle( scorep_unwinding_region* region )
+{
+    SCOREP_RegionHandle handle = SCOREP_ATOMIC_LOAD( &region->handle, SCOREP_ATOMIC_ACQUIRE );
+    if ( handle != SCOREP_INVALID_REGION )
+    {
+        return handle;
+    }
+
+    /* The region is shared by all locations, only the first one defines it */
+    SCOREP_MutexLock( region_cache_mutex );
+    handle = SCOREP_ATOMIC_LOAD( &region->handle, SCOREP_ATOMIC_RELAXED );
+    if ( handle == SCOREP_INVALID_REGION )
+    {
+        handle = SCOREP_Definitions_NewRegion( region->name,
+                                               NULL,
+                                               SCOREP_INVALID_SOURCE_FILE,
+                                               SCOREP_INVALID_LINE_NO,
+                                               SCOREP_INVALID_LINE_NO,
+                                               SCOREP_PARADIGM_SAMPLING,
+                                               SCOREP_REGION_FUNCTION );
+        SCOREP_ATOMIC_STORE( &region->handle, handle, SCOREP_ATOMIC_RELEASE );
+    }
+    SCOREP_MutexUnlock( region_cache_mutex );
+
+    return handle;
+}
+
+
+void
+scorep_unwinding_region_foreach( scorep_unwinding_region_callback callback,
+                                 void*                            arg )
+{
+    SCOREP_MutexLock( region_cache_mutex );
+
+    for ( size_t i = 0; i < region_cache_table->size; i++ )
+    {
+        callback( region_cache_table->entries[ i ].region, arg );
+    }
+    for ( scorep_unwinding_region* region = pending_regions; region; region = region->next )
+    {
+        callback( region, arg );
+    }
+
+    SCOREP_MutexUnlock( region_cache_mutex );
+}
+
+
+/* Regions read from the symbol tables, before they are merged. */
+typedef struct
+{
+    scorep_unwinding_region** regions;
+    size_t                    size;
+    size_t                    capacity;
+} preload_data;
+
+
+static void
+add_preload_region( preload_data* data,
+                    uint64_t      start,
+                    uint64_t      end,
+                    const char*   name )
+{
+    if ( data->size == data->capacity )
+    {
+        size_t                    capacity = data->capacity ? 2 * data->capacity : 1024;
+        scorep_unwinding_region** regions  = realloc( data->regions, capacity * sizeof( *regions ) );
+        if ( regions == NULL )
+        {
+            return;
+        }
+        data->regions  = regions;
+        data->capacity = capacity;
+    }
+
+    data->regions[ data->size++ ] = new_region( start, end, name );
+}
+
+
+/* Adds the functions of the ELF file @a pathname which lie inside the
+ * executable mapping [@a mapStart, @a mapEnd) of file offset @a mapOffset. */
+static void
+preload_image( preload_data* data,
+               const char*   pathname,
+               uint64_t      mapStart,
+               uint64_t      mapEnd,
+               uint64_t      mapOffset )
+{
+    int fd = open( pathname, O_RDONLY );
+    if ( fd == -1 )
+    {
+        return;
+    }
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 || ( size_t )st.st_size < sizeof( ElfW( Ehdr ) ) )
+    {
+        close( fd );
+        return;
+    }
+    size_t      size  = st.st_size;
+    const char* image = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( image == MAP_FAILED )
+    {
+        return;
+    }
+
+    const ElfW( Ehdr )* ehdr = ( const ElfW( Ehdr )* )image;
+    if ( memcmp( ehdr->e_ident, ELFMAG, SELFMAG ) != 0
+         || ehdr->e_ident[ EI_CLASS ] != ( sizeof( void* ) == 8 ? ELFCLASS64 : ELFCLASS32 )
+         || ehdr->e_phoff + ( uint64_t )ehdr->e_phnum * sizeof( ElfW( Phdr ) ) > size
+         || ehdr->e_shoff + ( uint64_t )ehdr->e_shnum * sizeof( ElfW( Shdr ) ) > size )
+    {
+        goto out;
+    }
+
+    /* Find the load segment of the mapping to compute the load bias */
+    const ElfW( Phdr )* phdrs   = ( const ElfW( Phdr )* )( image + ehdr->e_phoff );
+    const ElfW( Phdr )* segment = NULL;
+    for ( ElfW( Half ) i = 0; i < ehdr->e_phnum; i++ )
+    {
+        if ( phdrs[ i ].p_type == PT_LOAD
+             && phdrs[ i ].p_offset <= mapOffset
+             && mapOffset < phdrs[ i ].p_offset + phdrs[ i ].p_filesz )
+        {
+            segment = &phdrs[ i ];
+            break;
+        }
+    }
+    if ( segment == NULL )
+    {
+        goto out;
+    }
+    uint64_t bias = mapStart - mapOffset + segment->p_offset - segment->p_vaddr;
+
+    /* Prefer the full symbol table over the dynamic one */
+    const ElfW( Shdr )* shdrs  = ( const ElfW( Shdr )* )( image + ehdr->e_shoff );
+    const ElfW( Shdr )* symtab = NULL;
+    for ( ElfW( Half ) i = 0; i < ehdr->e_shnum; i++ )
     {
-        if ( addr < node->start )
+        if ( shdrs[ i ].sh_type == SHT_SYMTAB
+             || ( shdrs[ i ].sh_type == SHT_DYNSYM && symtab == NULL ) )
         {
-            node = node->left;
+            symtab = &shdrs[ i ];
         }
-        else if ( addr >= node->end )
+    }
+    if ( symtab == NULL
+         || symtab->sh_link >= ehdr->e_shnum
+         || symtab->sh_offset + symtab->sh_size > size
+         || shdrs[ symtab->sh_link ].sh_offset + shdrs[ symtab->sh_link ].sh_size > size )
+    {
+        goto out;
+    }
+
+    const ElfW( Sym )* symbols        = ( const ElfW( Sym )* )( image + symtab->sh_offset );
+    size_t             number_of_syms = symtab->sh_size / sizeof( ElfW( Sym ) );
+    const char*        strings        = image + shdrs[ symtab->sh_link ].sh_offset;
+    size_t             strings_size   = shdrs[ symtab->sh_link ].sh_size;
+    for ( size_t i = 0; i < number_of_syms; i++ )
+    {
+        /* ELF32_ST_TYPE is also used for 64-bit symbols */
+        const ElfW( Sym )* sym = &symbols[ i ];
+        if ( ELF32_ST_TYPE( sym->st_info ) != STT_FUNC
+             || sym->st_shndx == SHN_UNDEF
+             || sym->st_size == 0
+             || sym->st_name == 0
+             || sym->st_name >= strings_size
+             || memchr( strings + sym->st_name, 0, strings_size - sym->st_name ) == NULL )
         {
-            node = node->right;
+            continue;
         }
-        else
+
+        uint64_t start = sym->st_value + bias;
+        if ( start < mapStart || start >= mapEnd )
         {
-            break;
+            continue;
         }
+        add_preload_region( data, start, start + sym->st_size, strings + sym->st_name );
     }
 
-    return node;
+out:
+    munmap( ( void* )image, size );
 }
 
+
 void
-scorep_unwinding_region_clear( SCOREP_Unwinding_CpuLocationData* unwindData,
-                               scorep_unwinding_region_cleanup   cleanup,
-                               void*                             arg )
+scorep_unwinding_region_preload( scorep_unwinding_region_init init )
 {
-    while ( unwindData && unwindData->known_regions )
+    FILE* maps = fopen( "/proc/self/maps", "rb" );
+    if ( !maps )
     {
-        scorep_unwinding_region* node = NULL;
-        if ( unwindData->known_regions->left == NULL )
+        return;
+    }
+
+    SCOREP_MutexLock( region_cache_mutex );
+
+    if ( number_of_pending_regions > 0 )
+    {
+        merge_pending_regions();
+    }
+
+    preload_data data      = { NULL, 0, 0 };
+    size_t       line_size = 0;
+    char*        line      = NULL;
+    while ( UTILS_IO_GetLine( &line, &line_size, maps ) == SCOREP_SUCCESS )
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t offset;
+        char     perms[ 5 ];
+        int      pathname_pos = 0;
+        if ( sscanf( line, "%" SCNx64 "-%" SCNx64 " %4s %" SCNx64 " %*s %*s %n",
+                     &start, &end, perms, &offset, &pathname_pos ) < 4
+             || pathname_pos == 0
+             || perms[ 2 ] != 'x' )
         {
-            node = unwindData->known_regions->right;
+            continue;
         }
-        else
+
+        char*  pathname = line + pathname_pos;
+        size_t len      = strlen( pathname );
+        while ( len > 0 && pathname[ len - 1 ] == '\n' )
         {
-            node = splay( unwindData->known_regions->left,
-                          unwindData->known_regions->start );
-            node->right = unwindData->known_regions->right;
+            pathname[ --len ] = 0;
         }
-        if ( cleanup )
+        if ( *pathname != '/' )
         {
-            cleanup( unwindData->known_regions, arg );
+            continue;
         }
-        unwindData->known_regions = node;
+
+        preload_image( &data, pathname, start, end, offset );
     }
+    free( line );
+    fclose( maps );
+
+    UTILS_DEBUG( "Preloaded %zu function symbols", data.size );
+    merge_regions( data.regions, data.size, init );
+    free( data.regions );
+
+    SCOREP_MutexUnlock( region_cache_mutex );
 }
@@ -17,27 +17,55 @@
 #include "scorep_unwinding_mgmt.h"
 
 
+/*
+ * The known regions are shared by all locations of the process. They are kept
+ * in an address-sorted table which is replaced as a whole when regions are
+ * added, thus lookups do not need a lock. Regions are never removed during
+ * the measurement.
+ */
+
+
+/** Function type for the init argument of @a scorep_unwinding_region_insert
+ *  and @a scorep_unwinding_region_preload.
+ *
+ *  Called for new regions before other locations can see them, with the
+ *  region cache locked.
+ */
+typedef void ( * scorep_unwinding_region_init )( scorep_unwinding_region* region );
+
+
+/** Sets up the empty set of known regions. */
+void
+scorep_unwinding_region_initialize( void );
+
+
+/** Releases all known regions. */
+void
+scorep_unwinding_region_finalize( void );
+
+
 /** Inserts a new region into the known regions set.
  *
- *  Caller must ensure that this region is not known already.
+ *  If a region with the same start address is known already, this one is
+ *  returned instead, and its end is extended to @p end if needed.
  *
- *  @param unwindData  The unwindData which holds the known regions
  *  @param start     The start address of the region (inclusive)
  *  @param end       The end address of the region (exclusive)
  *  @param name      Name of the region
+ *  @param init      Initializes the remaining members of a new region
  *
- *  @return New region
+ *  @return New or existing region
  */
 scorep_unwinding_region*
-scorep_unwinding_region_insert( SCOREP_Unwinding_CpuLocationData* unwindData,
-                                uint64_t                          start,
-                                uint64_t                          end,
-                                const char*                       name );
+scorep_unwinding_region_insert( uint64_t                     start,
+                                uint64_t                     end,
+                                const char*                  name,
+                                scorep_unwinding_region_init init );
 
 
 /** Finds a known region by an address inside the range of the region.
  *
- *  @param unwindData  The unwindData which holds the known regions
+ *  @param unwindData  The unwindData which holds the region cache of the location
  *  @param addr      The address to search the region for
  *
  *  @return Found region, or @a NULL of not found
@@ -47,20 +75,38 @@ scorep_unwinding_region_find( SCOREP_Unwinding_CpuLocationData* unwindData,
                               uint64_t                          addr );
 
 
-/** Function type for the cleanup argument of @a scorep_unwinding_region_clear. */
-typedef void ( * scorep_unwinding_region_cleanup )( scorep_unwinding_region* node,
-                                                    void*                    arg );
+/** Returns the definition of a known region, and defines it on first use.
+ *  Racing locations get the same definition.
+ *  @param region    The region
+ *  @return The region handle
+ */
+SCOREP_RegionHandle
+scorep_unwinding_region_get_handle( scorep_unwinding_region* region );
+
+
+/** Inserts the function symbols of all executable mappings of the process.
+ *
+ *  The symbols are read from the symbol table of the ELF files listed in
+ *  @a /proc/self/maps, or from the dynamic symbol table if they are stripped.
+ *
+ *  @param init      Initializes the remaining members of a new region
+ */
+void
+scorep_unwinding_region_preload( scorep_unwinding_region_init init );
+
+
+/** Function type for the callback argument of @a scorep_unwinding_region_foreach. */
+typedef void ( * scorep_unwinding_region_callback )( scorep_unwinding_region* node,
+                                                     void*                    arg );
 
-/** Clears all known regions and apply a custom operation before tha fact
+/** Applies an operation to all known regions.
  *
- *  @param unwindData  The unwindData which holds the known regions
- *  @param cleanup   Opeation to be performed before region is cleared
- *  @param arg       Argument to @p cleanup
+ *  @param callback  Operation to be performed for every region
+ *  @param arg       Argument to @p callback
  */
 void
-scorep_unwinding_region_clear( SCOREP_Unwinding_CpuLocationData* unwindData,
-                               scorep_unwinding_region_cleanup   cleanup,
-                               void*                             arg );
+scorep_unwinding_region_foreach( scorep_unwinding_region_callback callback,
+                                 void*                            arg );
 
 
 #endif /* SCOREP_UNWINDING_REGION_H */
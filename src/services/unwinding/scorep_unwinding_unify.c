@@ -547,28 +547,6 @@ finalize_region( scorep_unwinding_region* region,
     }
 }
 
-static bool
-finalize_region_definitions( SCOREP_Location* location,
-                             void*            data )
-{
-    struct addr_range** addr_ranges = data;
-
-    SCOREP_LocationType location_type = SCOREP_Location_GetType( location );
-
-    if ( location_type != SCOREP_LOCATION_TYPE_CPU_THREAD )
-    {
-        return false;
-    }
-
-    SCOREP_Unwinding_CpuLocationData* unwind_data =
-        SCOREP_Location_GetSubsystemData( location, scorep_unwinding_subsystem_id );
-
-    /* we clear the known regions and apply the post processing while at it */
-    scorep_unwinding_region_clear( unwind_data, finalize_region, addr_ranges );
-
-    return false;
-}
-
 static void
 open_image( struct addr_range* range )
 {
@@ -710,7 +688,8 @@ scorep_unwinding_unify( void )
     }
     SCOREP_DEFINITIONS_MANAGER_FOREACH_DEFINITION_END();
 
-    SCOREP_Location_ForAll( finalize_region_definitions, &addr_ranges );
+    /* apply the post processing to the regions known to all locations */
+    scorep_unwinding_region_foreach( finalize_region, &addr_ranges );
 
     addr_range_clear( &addr_ranges, close_image );
 
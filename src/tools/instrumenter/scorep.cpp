@@ -86,6 +86,9 @@ print_help( void )
               << "  --keep-files    Do not delete temporarily created files after successful\n"
               << "                  instrumentation. By default, temporary files are deleted\n"
               << "                  if no error occurs during instrumentation.\n"
+              << "  --jobs=<n>      Preprocesses, instruments, and compiles up to <n> source\n"
+              << "                  files concurrently, if the command compiles more than\n"
+              << "                  one source file. The default is 1.\n"
               << "  --instrument-filter=<file>\n"
               << "                  Specifies the filter file for filtering functions during\n"
               << "                  compile-time. Not supported by all instrumentation methods.\n"
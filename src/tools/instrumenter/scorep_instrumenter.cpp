@@ -47,6 +47,10 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/wait.h>
 
 #include <UTILS_Error.h>
 #include <UTILS_IO.h>
@@ -76,6 +80,40 @@
 void
 print_help();
 
+/**
+   Returns the config tool action for the compiler flags of @a sourceFile.
+ */
+static std::string
+get_compile_flags_action( const std::string& sourceFile )
+{
+    if ( is_cpp_file( sourceFile ) )
+    {
+        return "--cxxflags";
+    }
+    else if ( is_fortran_file( sourceFile ) )
+    {
+        return "--fflags";
+    }
+    return "--cflags";
+}
+
+/**
+   Returns the config tool action for the preprocessor flags of @a sourceFile.
+ */
+static std::string
+get_preprocess_flags_action( const std::string& sourceFile )
+{
+    if ( is_cpp_file( sourceFile ) )
+    {
+        return "--cppflags=c++";
+    }
+    else if ( is_fortran_file( sourceFile ) )
+    {
+        return "--cppflags=fortran";
+    }
+    return "--cppflags=c";
+}
+
 /* ****************************************************************************
                                                                  public methods
  * ***************************************************************************/
@@ -170,6 +208,24 @@ SCOREP_Instrumenter::Run( void )
         std::string              cwd         = ( cwd_to_free ? cwd_to_free : "" );
         cwd = backslash_special_chars( cwd );
 
+        /* Source files are processed in child processes, if more than one
+           job is allowed and more than one source file is compiled. */
+        size_t number_of_sources = 0;
+        for ( std::vector<std::string>::iterator current_file = m_input_files.begin();
+              current_file != m_input_files.end();
+              current_file++ )
+        {
+            if ( is_source_file( *current_file ) )
+            {
+                number_of_sources++;
+            }
+        }
+        bool run_parallel = m_command_line.isCompiling()
+                            && !m_command_line.isDryRun()
+                            && m_command_line.getJobs() > 1
+                            && number_of_sources > 1;
+        bool failed = false;
+
         /* If the original command compile and link in one step,
            we need to split compilation and linking, because for Opari
            we need to run the script on the object files.
@@ -219,75 +275,31 @@ SCOREP_Instrumenter::Run( void )
                     addTempFile( object_file );
                 }
 
-                /* If we create modified source, we must add the original
-                     source directory to the include dirs, because local
-                     files may be included
-                 */
-                std::string search_path                = extract_path( *current_file );
-                std::string pdt_include_search_path    = " -I" + search_path;
-                std::string opari2_include_search_path = " -I" +  search_path;
-                if ( is_c_file( *current_file ) )
+                if ( run_parallel )
                 {
-                    #if SCOREP_BACKEND_HAVE_C_IQUOTE_SUPPORT
-                    opari2_include_search_path = " -iquote " +  search_path;
-                    #endif /* SCOREP_BACKEND_HAVE_IQUOTE_SUPPORT */
-                }
-                else if ( is_cpp_file( *current_file ) )
-                {
-                    #if SCOREP_BACKEND_HAVE_CXX_IQUOTE_SUPPORT
-                    opari2_include_search_path = " -iquote " +  search_path;
-                        #endif /* SCOREP_BACKEND_HAVE_IQUOTE_SUPPORT */
-                }
-                std::string compiler_flags_save = m_compiler_flags;
+                    /* Call the config tool in this process, instead of once
+                       per job */
+                    getConfigToolOutput( get_compile_flags_action( *current_file ) );
+                    if ( m_command_line.getPreprocessMode() == SCOREP_Instrumenter_CmdLine::EXPLICIT_STEP &&
+                         !is_assembler_file( *current_file ) )
+                    {
+                        getConfigToolOutput( get_preprocess_flags_action( *current_file ) );
+                    }
 
-                // Perform preprocessing steps
-                if ( m_command_line.getPreprocessMode() != SCOREP_Instrumenter_CmdLine::DISABLE &&
-                     !is_assembler_file( *current_file ) )
-                {
-                    std::string orig_extension = get_extension( *current_file );
-                    *current_file = preprocess( *current_file );
-                    if ( m_command_line.getPreprocessMode() == SCOREP_Instrumenter_CmdLine::EXPLICIT_STEP )
+                    if ( !start_source_job( *current_file, object_file ) )
                     {
-                        std::string prep_file = m_command_line.getOutputName();
-                        if ( m_command_line.isCompiling() )
-                        {
-                            prep_file = remove_extension( remove_path( *current_file ) )
-                                        + ".prep"
-                                        + orig_extension;
-                            addTempFile( prep_file );
-                        }
-                        m_compiler_flags += opari2_include_search_path;
-                        preprocess_source_file( *current_file, prep_file );
-                        *current_file = prep_file;
+                        failed = true;
+                        break;
                     }
                 }
-                m_compiler_flags = compiler_flags_save;
+                else
+                {
+                    instrument_source_file( *current_file, object_file );
+                }
 
-                // Perform compile step
+                // Add object file to the input file list for the link command
                 if ( m_command_line.isCompiling() )
                 {
-                    if ( m_pdt_adapter->isEnabled() )
-                    {
-                        m_compiler_flags += pdt_include_search_path;
-                    }
-                    else if ( m_opari_adapter->isEnabled() &&
-                              m_command_line.getPreprocessMode() != SCOREP_Instrumenter_CmdLine::EXPLICIT_STEP )
-                    {
-                        m_compiler_flags += opari2_include_search_path;
-                    }
-                    *current_file = precompile( *current_file );
-
-                    #if SCOREP_BACKEND_COMPILER_CRAY
-                    if ( m_opari_adapter->isEnabled() &&
-                         m_command_line.getCompilerName().find( "ftn" ) != std::string::npos )
-                    {
-                        m_compiler_flags += " -I.";
-                    }
-                    #endif
-
-                    compile_source_file( *current_file, object_file );
-
-                    // Add object file to the input file list for the link command
                     object_files.push_back( object_file );
                 }
             }
@@ -299,6 +311,20 @@ SCOREP_Instrumenter::Run( void )
         }
         free( cwd_to_free );
 
+        while ( !m_source_jobs.empty() )
+        {
+            if ( !wait_for_source_job() )
+            {
+                failed = true;
+            }
+        }
+        if ( failed )
+        {
+            /* Remove the objects of the other jobs, if they are temporary */
+            clean_temp_files();
+            exit( EXIT_FAILURE );
+        }
+
         // Replace sources by compiled by their object file names for the link command
         m_input_files = object_files;
     }
@@ -363,6 +389,66 @@ SCOREP_Instrumenter::getConfigBaseCall( void )
     return m_config_base;
 }
 
+std::string
+SCOREP_Instrumenter::getConfigToolOutput( const std::string& arguments )
+{
+    std::string call = m_config_base + " " + arguments;
+    if ( m_command_line.isDryRun() )
+    {
+        return "`" + call + "`";
+    }
+
+    std::map<std::string, std::string>::iterator cached = m_config_tool_outputs.find( call );
+    if ( cached != m_config_tool_outputs.end() )
+    {
+        return cached->second;
+    }
+
+    if ( m_command_line.getVerbosity() >= 1 )
+    {
+        std::cerr << " Executing: " << call << std::endl;
+    }
+
+    std::string              output;
+    std::vector<std::string> words;
+    int                      return_value = -1;
+    if ( split_shell_command( call, words ) )
+    {
+        return_value = spawn_command( words, &output );
+    }
+    else
+    {
+        FILE* config_tool = popen( call.c_str(), "r" );
+        if ( config_tool )
+        {
+            char   buffer[ 4096 ];
+            size_t length;
+            while ( ( length = fread( buffer, 1, sizeof( buffer ), config_tool ) ) > 0 )
+            {
+                output.append( buffer, length );
+            }
+            return_value = pclose( config_tool );
+        }
+    }
+    if ( return_value != 0 )
+    {
+        std::cerr << "[Score-P] ERROR: Execution failed: " << call << std::endl;
+        exit( EXIT_FAILURE );
+    }
+
+    /* Split the output into words and protect them from the shell, like a
+       command substitution would do. */
+    std::istringstream output_words( output );
+    std::string        word;
+    std::string        result;
+    while ( output_words >> word )
+    {
+        result += ( result.empty() ? "" : " " ) + backslash_special_chars( word );
+    }
+    m_config_tool_outputs[ call ] = result;
+    return result;
+}
+
 /* ****************************************************************************
  *                                                              private methods
  * ***************************************************************************/
@@ -407,7 +493,7 @@ SCOREP_Instrumenter::clean_temp_files( void )
 {
     if ( ( !m_command_line.hasKeepFiles() ) && ( !m_temp_files.empty() ) )
     {
-        executeCommand( scorep_vector_to_string( m_temp_files, "rm ", "", " " ) );
+        executeCommand( scorep_vector_to_string( m_temp_files, "rm -f ", "", " " ) );
     }
 }
 
@@ -441,24 +527,228 @@ SCOREP_Instrumenter::prepare_config_tool_calls( const std::string& input_file )
 }
 
 void
-SCOREP_Instrumenter::compile_source_file( const std::string& input_file,
-                                          const std::string& output_file )
+SCOREP_Instrumenter::instrument_source_file( std::string&       current_file,
+                                             const std::string& object_file )
 {
-    std::string cflags = "--cflags";
-    if ( is_cpp_file( input_file ) )
+    /* If we create modified source, we must add the original
+         source directory to the include dirs, because local
+         files may be included
+     */
+    std::string search_path                = extract_path( current_file );
+    std::string pdt_include_search_path    = " -I" + search_path;
+    std::string opari2_include_search_path = " -I" +  search_path;
+    if ( is_c_file( current_file ) )
     {
-        cflags = "--cxxflags";
+        #if SCOREP_BACKEND_HAVE_C_IQUOTE_SUPPORT
+        opari2_include_search_path = " -iquote " +  search_path;
+        #endif /* SCOREP_BACKEND_HAVE_IQUOTE_SUPPORT */
     }
-    else if ( is_fortran_file( input_file ) )
+    else if ( is_cpp_file( current_file ) )
     {
-        cflags = "--fflags";
+        #if SCOREP_BACKEND_HAVE_CXX_IQUOTE_SUPPORT
+        opari2_include_search_path = " -iquote " +  search_path;
+            #endif /* SCOREP_BACKEND_HAVE_IQUOTE_SUPPORT */
     }
+    std::string compiler_flags_save = m_compiler_flags;
 
+    // Perform preprocessing steps
+    if ( m_command_line.getPreprocessMode() != SCOREP_Instrumenter_CmdLine::DISABLE &&
+         !is_assembler_file( current_file ) )
+    {
+        std::string orig_extension = get_extension( current_file );
+        current_file = preprocess( current_file );
+        if ( m_command_line.getPreprocessMode() == SCOREP_Instrumenter_CmdLine::EXPLICIT_STEP )
+        {
+            std::string prep_file = m_command_line.getOutputName();
+            if ( m_command_line.isCompiling() )
+            {
+                prep_file = remove_extension( remove_path( current_file ) )
+                            + ".prep"
+                            + orig_extension;
+                addTempFile( prep_file );
+            }
+            m_compiler_flags += opari2_include_search_path;
+            preprocess_source_file( current_file, prep_file );
+            current_file = prep_file;
+        }
+    }
+    m_compiler_flags = compiler_flags_save;
+
+    // Perform compile step
+    if ( m_command_line.isCompiling() )
+    {
+        if ( m_pdt_adapter->isEnabled() )
+        {
+            m_compiler_flags += pdt_include_search_path;
+        }
+        else if ( m_opari_adapter->isEnabled() &&
+                  m_command_line.getPreprocessMode() != SCOREP_Instrumenter_CmdLine::EXPLICIT_STEP )
+        {
+            m_compiler_flags += opari2_include_search_path;
+        }
+        current_file = precompile( current_file );
+
+        #if SCOREP_BACKEND_COMPILER_CRAY
+        if ( m_opari_adapter->isEnabled() &&
+             m_command_line.getCompilerName().find( "ftn" ) != std::string::npos )
+        {
+            m_compiler_flags += " -I.";
+        }
+        #endif
+
+        compile_source_file( current_file, object_file );
+    }
+
+    /* Do not pass the include paths of this file to the next one */
+    m_compiler_flags = compiler_flags_save;
+}
+
+bool
+SCOREP_Instrumenter::start_source_job( std::string&       current_file,
+                                       const std::string& object_file )
+{
+    if ( m_source_jobs.size() >= ( size_t )m_command_line.getJobs()
+         && !wait_for_source_job() )
+    {
+        return false;
+    }
+
+    int job_pipe[ 2 ];
+    if ( pipe( job_pipe ) != 0 )
+    {
+        std::cerr << "[Score-P] ERROR: Failed to create pipe: " << strerror( errno ) << std::endl;
+        return false;
+    }
+
+    /* Do not duplicate buffered output in the child */
+    std::cout.flush();
+    std::cerr.flush();
+    fflush( NULL );
+
+    pid_t pid = fork();
+    if ( pid == -1 )
+    {
+        std::cerr << "[Score-P] ERROR: Failed to create process: " << strerror( errno ) << std::endl;
+        close( job_pipe[ 0 ] );
+        close( job_pipe[ 1 ] );
+        return false;
+    }
+    if ( pid == 0 )
+    {
+        close( job_pipe[ 0 ] );
+
+        /* executeCommand() exits with EXIT_FAILURE if a step fails */
+        size_t first_temp_file = m_temp_files.size();
+        instrument_source_file( current_file, object_file );
+
+        /* Report the new temporary files, one per line */
+        std::string temp_files;
+        for ( size_t i = first_temp_file; i < m_temp_files.size(); i++ )
+        {
+            temp_files += m_temp_files[ i ] + "\n";
+        }
+        const char* buffer = temp_files.c_str();
+        size_t      length = temp_files.length();
+        while ( length > 0 )
+        {
+            ssize_t written = write( job_pipe[ 1 ], buffer, length );
+            if ( written < 0 && errno != EINTR )
+            {
+                _exit( EXIT_FAILURE );
+            }
+            if ( written > 0 )
+            {
+                buffer += written;
+                length -= written;
+            }
+        }
+        close( job_pipe[ 1 ] );
+
+        std::cout.flush();
+        std::cerr.flush();
+        fflush( NULL );
+        _exit( EXIT_SUCCESS );
+    }
+
+    close( job_pipe[ 1 ] );
+    source_job job;
+    job.pid = pid;
+    job.fd  = job_pipe[ 0 ];
+    m_source_jobs.push_back( job );
+    return true;
+}
+
+bool
+SCOREP_Instrumenter::wait_for_source_job( void )
+{
+    /* Read the pipes until one of them is closed, because a child blocks
+       if its pipe is full */
+    while ( true )
+    {
+        std::vector<struct pollfd> fds( m_source_jobs.size() );
+        for ( size_t i = 0; i < m_source_jobs.size(); i++ )
+        {
+            fds[ i ].fd     = m_source_jobs[ i ].fd;
+            fds[ i ].events = POLLIN;
+        }
+        if ( poll( &fds[ 0 ], fds.size(), -1 ) < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            std::cerr << "[Score-P] ERROR: Failed to wait for jobs: " << strerror( errno ) << std::endl;
+            exit( EXIT_FAILURE );
+        }
+
+        for ( size_t i = 0; i < m_source_jobs.size(); i++ )
+        {
+            if ( fds[ i ].revents == 0 )
+            {
+                continue;
+            }
+            source_job& job = m_source_jobs[ i ];
+            char        buffer[ 4096 ];
+            ssize_t     length = read( job.fd, buffer, sizeof( buffer ) );
+            if ( length > 0 )
+            {
+                job.temp_files.append( buffer, length );
+                continue;
+            }
+            if ( length < 0 && errno == EINTR )
+            {
+                continue;
+            }
+
+            /* The child closed its pipe */
+            close( job.fd );
+            int status = 0;
+            while ( waitpid( job.pid, &status, 0 ) == -1 && errno == EINTR )
+            {
+            }
+
+            std::istringstream temp_files( job.temp_files );
+            std::string        temp_file;
+            while ( std::getline( temp_files, temp_file ) )
+            {
+                addTempFile( temp_file );
+            }
+            m_source_jobs.erase( m_source_jobs.begin() + i );
+
+            return WIFEXITED( status ) && WEXITSTATUS( status ) == EXIT_SUCCESS;
+        }
+    }
+}
+
+void
+SCOREP_Instrumenter::compile_source_file( const std::string& input_file,
+                                          const std::string& output_file )
+{
     /* Construct command */
     std::stringstream command;
     command << SCOREP_Instrumenter_InstallData::getCompilerEnvironmentVars();
     command << m_command_line.getCompilerName();
-    command << " `" << m_config_base << " " <<  cflags << "`";
+    command << " " << getConfigToolOutput( get_compile_flags_action( input_file ) );
     command << " " << m_compiler_flags;
     command << " " << m_command_line.getFlagsBeforeInterpositionLib();
     command << " " << m_command_line.getFlagsAfterInterpositionLib();
@@ -473,22 +763,11 @@ SCOREP_Instrumenter::preprocess_source_file( const std::string& source_file,
 {
     std::string command;
 
-    // Determine language
-    std::string language = "c";
-    if ( is_cpp_file( source_file ) )
-    {
-        language = "c++";
-    }
-    else if ( is_fortran_file( source_file ) )
-    {
-        language = "fortran";
-    }
-
     // Preprocess file
     command = SCOREP_Instrumenter_InstallData::getCompilerEnvironmentVars()
               + m_command_line.getCompilerName()
               + " " + m_command_line.getFlagsBeforeInterpositionLib()
-              + " `" + getConfigBaseCall() + " --cppflags=" + language + "`"
+              + " " + getConfigToolOutput( get_preprocess_flags_action( source_file ) )
               + " " + getCompilerFlags()
               + " " + m_command_line.getFlagsAfterInterpositionLib()
               + " " + source_file;
@@ -645,10 +924,10 @@ SCOREP_Instrumenter::link_step( void )
 #if HAVE_BACKEND( COMPILER_CONSTRUCTOR_SUPPORT )
     if ( !m_command_line.isTargetSharedLib() )
     {
-        command << " `" << m_config_base << " --constructor`";
+        command << " " << getConfigToolOutput( "--constructor" );
     }
 #endif
-    command << " `" << m_config_base << " --ldflags`";
+    command << " " << getConfigToolOutput( "--ldflags" );
     command << " " << m_command_line.getFlagsBeforeInterpositionLib();
 
     std::string linker_start_group_flags;
@@ -662,16 +941,16 @@ SCOREP_Instrumenter::link_step( void )
         linker_end_group_flags   = linker_prefix + "-end-group";
     }
 #if SCOREP_BACKEND_HAVE_LINKER_START_END_GROUP
-    command << libs_prefix << linker_start_group_flags << " `" << m_config_base << " --event-libs`";
+    command << libs_prefix << linker_start_group_flags << " " << getConfigToolOutput( "--event-libs" );
     command << " " << m_command_line.getFlagsAfterInterpositionLib() << libs_suffix;
 #else
-    command << libs_prefix << " `" << m_config_base << " --event-libs`" << libs_suffix;
+    command << libs_prefix << " " << getConfigToolOutput( "--event-libs" ) << libs_suffix;
     command << " " << m_command_line.getFlagsAfterInterpositionLib();
 #endif
 #if SCOREP_BACKEND_HAVE_LINKER_START_END_GROUP
-    command << libs_prefix << " `" << m_config_base << " --mgmt-libs`" << linker_end_group_flags << libs_suffix;
+    command << libs_prefix << " " << getConfigToolOutput( "--mgmt-libs" ) << linker_end_group_flags << libs_suffix;
 #else
-    command << libs_prefix << " `" << m_config_base << " --mgmt-libs`" << libs_suffix;
+    command << libs_prefix << " " << getConfigToolOutput( "--mgmt-libs" ) << libs_suffix;
 #endif
     if ( m_command_line.getOutputName() != "" )
     {
@@ -695,12 +974,36 @@ SCOREP_Instrumenter::executeCommand( const std::string& orig_command )
         {
             return;
         }
-
-        /* Let the shell do its job and show us all executed commands. */
-        command = "PS4=' Executing: '; set -x; " + command;
     }
 
-    int return_value = system( command.c_str() );
+    /* Execute the command directly, unless it needs a shell */
+    std::vector<std::string> words;
+    int                      return_value;
+    if ( split_shell_command( orig_command, words ) )
+    {
+        if ( m_command_line.getVerbosity() >= 1 )
+        {
+            /* Compose the line first, concurrent jobs write to the same stream */
+            std::string line = " Executing:";
+            for ( std::vector<std::string>::iterator word = words.begin();
+                  word != words.end();
+                  word++ )
+            {
+                line += " " + backslash_special_chars( *word );
+            }
+            std::cerr << line << std::endl;
+        }
+        return_value = spawn_command( words, NULL );
+    }
+    else
+    {
+        if ( m_command_line.getVerbosity() >= 1 )
+        {
+            /* Let the shell do its job and show us all executed commands. */
+            command = "PS4=' Executing: '; set -x; " + command;
+        }
+        return_value = system( command.c_str() );
+    }
     if ( return_value != 0 )
     {
         std::cerr << "[Score-P] ERROR: Execution failed: " << orig_command << std::endl;
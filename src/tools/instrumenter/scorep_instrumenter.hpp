@@ -45,8 +45,11 @@
 #include <iostream>
 #include <string>
 #include <deque>
+#include <map>
 #include <vector>
 
+#include <sys/types.h>
+
 class SCOREP_Instrumenter_Adapter;
 //class SCOREP_Instrumenter_CobiAdapter;
 class SCOREP_Instrumenter_CompilerAdapter;
@@ -124,6 +127,15 @@ public:
     const std::string&
     getConfigBaseCall( void );
 
+    /**
+       Returns the output of the config tool call with the action parameters
+       @a arguments, split into words like a command substitution would do.
+       The config tool is called only once per configuration and action.
+       In a dry run, the call is returned as command substitution instead.
+     */
+    std::string
+    getConfigToolOutput( const std::string& arguments );
+
     SCOREP_Instrumenter_CmdLine&
     getCommandLine( void )
     {
@@ -168,6 +180,33 @@ private:
     compile_source_file( const std::string& input_file,
                          const std::string& output_file );
 
+    /**
+       Preprocesses, instruments, and compiles one source file.
+       @param current_file The source file. Receives the name of the file
+                           passed to the compiler.
+       @param object_file  Filename for the object file.
+     */
+    void
+    instrument_source_file( std::string&       current_file,
+                            const std::string& object_file );
+
+    /**
+       Runs instrument_source_file() in a child process. Waits for a running
+       child first, if the maximum number of jobs is reached.
+       @returns false if a job failed.
+     */
+    bool
+    start_source_job( std::string&       current_file,
+                      const std::string& object_file );
+
+    /**
+       Waits until one of the running jobs ends and adds the temporary
+       files it created.
+       @returns false if the job failed.
+     */
+    bool
+    wait_for_source_job( void );
+
     /**
        Removes temporarily created files.
      */
@@ -247,6 +286,27 @@ private:
      */
     std::string m_config_base;
 
+    /**
+       Outputs of the config tool calls, see getConfigToolOutput().
+     */
+    std::map<std::string, std::string> m_config_tool_outputs;
+
+    /**
+       A child process that instruments and compiles a source file. It
+       reports the temporary files it created through a pipe.
+     */
+    struct source_job
+    {
+        pid_t       pid;
+        int         fd;
+        std::string temp_files;
+    };
+
+    /**
+       The running source jobs.
+     */
+    std::vector<source_job> m_source_jobs;
+
     /**
        Additional compiler flags added by the instrumenter
      */
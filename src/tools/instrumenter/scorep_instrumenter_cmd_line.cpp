@@ -47,6 +47,8 @@
 
 #include <iostream>
 #include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
 
 #include <UTILS_IO.h>
 
@@ -85,6 +87,7 @@ SCOREP_Instrumenter_CmdLine::SCOREP_Instrumenter_CmdLine( SCOREP_Instrumenter_In
     /* Instrumenter flags */
     m_is_dry_run     = false;
     m_keep_files     = false;
+    m_jobs           = 1;
     m_verbosity      = 0;
     m_is_build_check = false;
 
@@ -283,6 +286,12 @@ SCOREP_Instrumenter_CmdLine::getVerbosity( void )
     return m_verbosity;
 }
 
+int
+SCOREP_Instrumenter_CmdLine::getJobs( void )
+{
+    return m_jobs;
+}
+
 bool
 SCOREP_Instrumenter_CmdLine::isBuildCheck( void )
 {
@@ -417,6 +426,21 @@ SCOREP_Instrumenter_CmdLine::parse_parameter( const std::string& arg )
         return scorep_parse_mode_param;
     }
 
+    else if ( ( arg.length() >= 7 ) && ( arg.substr( 0, 7 ) == "--jobs=" ) )
+    {
+        std::string jobs = arg.substr( 7 );
+        char*       end;
+        errno = 0;
+        long value = strtol( jobs.c_str(), &end, 10 );
+        if ( jobs.empty() || *end != '\0' || errno != 0 || value < 1 || value > INT_MAX )
+        {
+            std::cerr << "[Score-P] ERROR: Invalid number of jobs: '" << jobs << "'" << std::endl;
+            exit( EXIT_FAILURE );
+        }
+        m_jobs = value;
+        return scorep_parse_mode_param;
+    }
+
     else if ( arg == "--help" || arg == "-h" )
     {
         print_help();
@@ -196,6 +196,8 @@ public:
     hasKeepFiles( void );
     int
     getVerbosity( void );
+    int
+    getJobs( void );
     bool
     isBuildCheck( void );
     std::string
@@ -487,6 +489,12 @@ private:
      */
     bool m_keep_files;
 
+    /**
+       The maximum number of source files that are preprocessed, instrumented,
+       and compiled concurrently.
+     */
+    int m_jobs;
+
     /**
        The level of verbosity. Currently, we know the levels:
        <ul>
@@ -83,7 +83,7 @@ SCOREP_Instrumenter_PdtAdapter::precompile( SCOREP_Instrumenter&         instrum
                                              "_pdt" + extension );
     std::string       pdb_file = remove_path( remove_extension( source_file ) + ".pdb" );
     std::stringstream command;
-    std::string       cflags = "`" + instrumenter.getConfigBaseCall() + " --inc` "
+    std::string       cflags = instrumenter.getConfigToolOutput( "--inc" ) + " "
                                + instrumenter.getCompilerFlags();
 
     // Create database file
@@ -48,7 +48,13 @@
 #include <fstream>
 #include <sstream>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
 #include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 bool
 is_fortran_file( const std::string& filename )
@@ -274,3 +280,197 @@ create_random_string( void )
                   << "_" << tv.tv_usec;
     return random_string.str();
 }
+
+bool
+split_shell_command( const std::string&        command,
+                     std::vector<std::string>& words )
+{
+    static const std::string whitespace = " \t\n";
+    static const std::string special    = "|&;<>()$`*?[";
+
+    words.clear();
+    std::string::size_type pos = 0;
+    while ( true )
+    {
+        pos = command.find_first_not_of( whitespace, pos );
+        if ( pos == std::string::npos )
+        {
+            break;
+        }
+
+        /* Tilde expansion and comments are only recognized at the start of
+           a word */
+        if ( command[ pos ] == '~' || command[ pos ] == '#' )
+        {
+            return false;
+        }
+
+        std::string word;
+        bool        is_quoted     = false;
+        bool        is_assignment = words.empty();
+        while ( pos < command.length() && whitespace.find( command[ pos ] ) == std::string::npos )
+        {
+            char c = command[ pos++ ];
+            if ( c == '\\' || c == '\'' || c == '"' )
+            {
+                is_assignment = false;
+                is_quoted     = is_quoted || c != '\\' || command[ pos ] != '\n';
+            }
+
+            if ( c == '\\' )
+            {
+                if ( pos == command.length() )
+                {
+                    return false;
+                }
+                /* A backslash-newline pair is removed */
+                if ( command[ pos ] != '\n' )
+                {
+                    word += command[ pos ];
+                }
+                pos++;
+            }
+            else if ( c == '\'' )
+            {
+                std::string::size_type end = command.find( '\'', pos );
+                if ( end == std::string::npos )
+                {
+                    return false;
+                }
+                word += command.substr( pos, end - pos );
+                pos   = end + 1;
+            }
+            else if ( c == '"' )
+            {
+                while ( pos < command.length() && command[ pos ] != '"' )
+                {
+                    c = command[ pos++ ];
+                    if ( c == '$' || c == '`' )
+                    {
+                        return false;
+                    }
+                    if ( c == '\\' && pos < command.length()
+                         && std::string( "$`\"\\\n" ).find( command[ pos ] ) != std::string::npos )
+                    {
+                        c = command[ pos++ ];
+                        if ( c == '\n' )
+                        {
+                            continue;
+                        }
+                    }
+                    word += c;
+                }
+                if ( pos == command.length() )
+                {
+                    return false;
+                }
+                pos++;
+            }
+            else if ( special.find( c ) != std::string::npos )
+            {
+                return false;
+            }
+            else
+            {
+                /* An unquoted '=' in the first word makes it a variable
+                   assignment, if the preceding characters form a name */
+                if ( c == '=' && is_assignment && !word.empty() )
+                {
+                    return false;
+                }
+                is_assignment &= ( c == '_' || isalpha( ( unsigned char )c )
+                                   || ( isdigit( ( unsigned char )c ) && !word.empty() ) );
+                word          += c;
+            }
+        }
+        /* A removed backslash-newline pair does not form a word */
+        if ( !word.empty() || is_quoted )
+        {
+            words.push_back( word );
+        }
+    }
+    return !words.empty();
+}
+
+int
+spawn_command( const std::vector<std::string>& words,
+               std::string*                    output )
+{
+    std::vector<char*> argv;
+    for ( std::vector<std::string>::const_iterator word = words.begin();
+          word != words.end();
+          word++ )
+    {
+        argv.push_back( const_cast<char*>( word->c_str() ) );
+    }
+    argv.push_back( NULL );
+
+    int output_pipe[ 2 ];
+    if ( output && pipe( output_pipe ) != 0 )
+    {
+        return -1;
+    }
+
+    /* Do not duplicate buffered output in the child */
+    std::cout.flush();
+    std::cerr.flush();
+    fflush( NULL );
+
+    pid_t pid = fork();
+    if ( pid == -1 )
+    {
+        if ( output )
+        {
+            close( output_pipe[ 0 ] );
+            close( output_pipe[ 1 ] );
+        }
+        return -1;
+    }
+    if ( pid == 0 )
+    {
+        if ( output )
+        {
+            close( output_pipe[ 0 ] );
+            dup2( output_pipe[ 1 ], STDOUT_FILENO );
+            close( output_pipe[ 1 ] );
+        }
+        execvp( argv[ 0 ], &argv[ 0 ] );
+        std::cerr << "[Score-P] ERROR: Cannot execute '" << argv[ 0 ] << "': "
+                  << strerror( errno ) << std::endl;
+        _exit( 127 );
+    }
+
+    if ( output )
+    {
+        close( output_pipe[ 1 ] );
+        output->clear();
+        char    buffer[ 4096 ];
+        ssize_t length;
+        while ( ( length = read( output_pipe[ 0 ], buffer, sizeof( buffer ) ) ) != 0 )
+        {
+            if ( length > 0 )
+            {
+                output->append( buffer, length );
+            }
+            else if ( errno != EINTR )
+            {
+                break;
+            }
+        }
+        close( output_pipe[ 0 ] );
+    }
+
+    int status;
+    while ( waitpid( pid, &status, 0 ) == -1 )
+    {
+        if ( errno != EINTR )
+        {
+            return -1;
+        }
+    }
+    if ( WIFEXITED( status ) )
+    {
+        return WEXITSTATUS( status );
+    }
+    return -1;
+}
@@ -41,6 +41,7 @@
  */
 
 #include <string>
+#include <vector>
 
 /**
     Checks whether a file is a source file.
@@ -148,4 +149,28 @@ std::string
 create_random_string( void );
 
 
+/**
+    Splits a command into its words the way the shell would do it, including
+    the removal of quotes and backslashes.
+    @param command The command line.
+    @param words   Receives the words of @p command.
+    @returns false if @p command needs other shell features, e.g., variable
+             assignments, redirections, pipes, command substitution, or
+             pathname expansion. In this case, @p words is undefined.
+ */
+bool
+split_shell_command( const std::string&        command,
+                     std::vector<std::string>& words );
+
+/**
+    Executes a program directly without a shell and waits for its end.
+    @param words  The program, searched in PATH, followed by its arguments.
+    @param output If not NULL, receives the standard output of the program.
+    @returns the exit status of the program, or -1 if it could not be
+             executed or was terminated by a signal.
+ */
+int
+spawn_command( const std::vector<std::string>& words,
+               std::string*                    output );
+
 #endif // SCOREP_INSTRUMENTER_UTILS_HPP
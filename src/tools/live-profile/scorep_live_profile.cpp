@@ -0,0 +1,444 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Displays the live profile snapshots that measurements publish in POSIX
+ * shared memory, if SCOREP_PROFILING_ENABLE_LIVE_SNAPSHOTS is set:
+ * scorep-live-profile.
+ */
+
+#include <config.h>
+
+#include <SCOREP_Profile_Live.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+   Contains the name of the tool for help output
+ */
+static const std::string toolname = "scorep-live-profile";
+
+/**
+   Directory in which Linux exposes the POSIX shared-memory segments
+ */
+static const char* shm_directory = "/dev/shm";
+
+/**
+   Number of attempts to copy a buffer that is refreshed meanwhile
+ */
+static const int read_attempts = 100;
+
+/**
+   A mapped segment
+ */
+struct live_segment
+{
+    std::string                name;
+    SCOREP_Profile_LiveHeader* header;
+    size_t                     size;
+};
+
+/**
+   Prints a short usage message.
+ */
+static void
+print_short_usage( std::ostream& out )
+{
+    out << "Usage: " << toolname << " [options] [<pid>]" << std::endl;
+}
+
+/**
+   Prints the long help text.
+ */
+static void
+print_help( void )
+{
+    print_short_usage( std::cout );
+    std::cout << "\n"
+              << "Without <pid>, lists the processes and locations which currently publish\n"
+              << "live profile snapshots. With <pid>, prints the latest snapshot of every\n"
+              << "location of this process. Snapshots are published by measurements with\n"
+              << "SCOREP_PROFILING_ENABLE_LIVE_SNAPSHOTS=true.\n"
+              << "\n"
+              << "Options:\n"
+              << "  -l, --location <id>  Print only the location with the local id <id>.\n"
+              << "  -f, --flat           Print the call paths sorted by exclusive time\n"
+              << "                       instead of as a tree.\n"
+              << "  -n, --top <n>        Print at most <n> call paths per location.\n"
+              << "  -h, --help           Show this help and exit.\n"
+              << std::endl;
+    std::cout << "Report bugs to <" << PACKAGE_BUGREPORT << ">" << std::endl;
+}
+
+/**
+   Maps the segment @a name read-only and checks its header. Returns false
+   if the segment is not a complete live snapshot.
+ */
+static bool
+map_segment( const std::string& name,
+             live_segment&      segment )
+{
+    int fd = shm_open( ( "/" + name ).c_str(), O_RDONLY, 0 );
+    if ( fd == -1 )
+    {
+        return false;
+    }
+    struct stat status;
+    if ( fstat( fd, &status ) != 0 ||
+         ( size_t )status.st_size < sizeof( SCOREP_Profile_LiveHeader ) )
+    {
+        close( fd );
+        return false;
+    }
+    void* mapping = mmap( NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( mapping == MAP_FAILED )
+    {
+        return false;
+    }
+
+    SCOREP_Profile_LiveHeader* header = ( SCOREP_Profile_LiveHeader* )mapping;
+    uint64_t                   buffer_size =
+        SCOREP_Profile_LiveBufferSize( header->max_records, header->record_size );
+    if ( SCOREP_ATOMIC_LOAD( &header->magic, SCOREP_ATOMIC_ACQUIRE ) != SCOREP_PROFILE_LIVE_MAGIC ||
+         header->version != SCOREP_PROFILE_LIVE_VERSION ||
+         header->buffer_offset[ 0 ] + buffer_size > ( uint64_t )status.st_size ||
+         header->buffer_offset[ 1 ] + buffer_size > ( uint64_t )status.st_size )
+    {
+        munmap( mapping, status.st_size );
+        return false;
+    }
+
+    segment.name   = name;
+    segment.header = header;
+    segment.size   = status.st_size;
+    return true;
+}
+
+/**
+   Orders segments by process and location.
+ */
+static bool
+compare_segments( const live_segment& a,
+                  const live_segment& b )
+{
+    if ( a.header->pid != b.header->pid )
+    {
+        return a.header->pid < b.header->pid;
+    }
+    return a.header->location_id < b.header->location_id;
+}
+
+/**
+   Maps all segments, or those of process @a pid if it is not zero.
+ */
+static std::vector< live_segment >
+find_segments( uint64_t pid )
+{
+    std::vector< live_segment > segments;
+    DIR*                        directory = opendir( shm_directory );
+    if ( directory == NULL )
+    {
+        std::cerr << "ERROR: Cannot open '" << shm_directory << "': "
+                  << strerror( errno ) << std::endl;
+        return segments;
+    }
+
+    std::ostringstream prefix_stream;
+    prefix_stream << SCOREP_PROFILE_LIVE_PREFIX;
+    if ( pid != 0 )
+    {
+        prefix_stream << pid << "-";
+    }
+    std::string    prefix = prefix_stream.str();
+    struct dirent* entry;
+    while ( ( entry = readdir( directory ) ) != NULL )
+    {
+        std::string  name( entry->d_name );
+        live_segment segment;
+        if ( name.compare( 0, prefix.size(), prefix ) == 0 &&
+             map_segment( name, segment ) )
+        {
+            segments.push_back( segment );
+        }
+    }
+    closedir( directory );
+
+    std::sort( segments.begin(), segments.end(), compare_segments );
+    return segments;
+}
+
+/**
+   Copies a consistent state of the active buffer of @a segment. Returns
+   false if the writer refreshed too often during the attempts.
+ */
+static bool
+read_snapshot( const live_segment&     segment,
+               std::vector< uint64_t >& storage )
+{
+    const SCOREP_Profile_LiveHeader* header = segment.header;
+    uint64_t                         size   =
+        SCOREP_Profile_LiveBufferSize( header->max_records, header->record_size );
+    storage.resize( ( size + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) );
+    for ( int i = 0; i < read_attempts; i++ )
+    {
+        if ( SCOREP_Profile_LiveReadBuffer( header, ( SCOREP_Profile_LiveBuffer* )&storage[ 0 ] ) )
+        {
+            return true;
+        }
+        usleep( 1000 );
+    }
+    return false;
+}
+
+static std::string
+format_rank( const SCOREP_Profile_LiveHeader* header )
+{
+    if ( header->rank < 0 )
+    {
+        return "-";
+    }
+    std::ostringstream rank;
+    rank << header->rank;
+    return rank.str();
+}
+
+/**
+   Orders records by decreasing exclusive time.
+ */
+static bool
+compare_exclusive_time( const SCOREP_Profile_LiveRecord* a,
+                        const SCOREP_Profile_LiveRecord* b )
+{
+    return a->exclusive_time > b->exclusive_time;
+}
+
+/**
+   Prints one line per segment.
+ */
+static void
+list_segments( const std::vector< live_segment >& segments )
+{
+    printf( "%10s %6s %8s %8s %10s  %s\n",
+            "pid", "rank", "location", "records", "age [s]", "name" );
+    std::vector< uint64_t > storage;
+    for ( size_t i = 0; i < segments.size(); i++ )
+    {
+        const live_segment&              segment = segments[ i ];
+        const SCOREP_Profile_LiveHeader* header  = segment.header;
+        if ( !read_snapshot( segment, storage ) )
+        {
+            continue;
+        }
+        const SCOREP_Profile_LiveBuffer* buffer = ( const SCOREP_Profile_LiveBuffer* )&storage[ 0 ];
+        if ( buffer->wallclock == 0 )
+        {
+            printf( "%10" PRIu64 " %6s %8" PRIu64 " %8s %10s  %s\n",
+                    header->pid, format_rank( header ).c_str(), header->location_id,
+                    "-", "-", header->location_name );
+            continue;
+        }
+        printf( "%10" PRIu64 " %6s %8" PRIu64 " %8" PRIu64 " %10" PRIi64 "  %s\n",
+                header->pid, format_rank( header ).c_str(), header->location_id,
+                buffer->number_of_records,
+                ( int64_t )time( NULL ) - ( int64_t )buffer->wallclock,
+                header->location_name );
+    }
+}
+
+/**
+   Prints the snapshot of one segment.
+ */
+static void
+print_segment( const live_segment& segment,
+               bool                flat,
+               uint64_t            top )
+{
+    const SCOREP_Profile_LiveHeader* header = segment.header;
+    std::vector< uint64_t >          storage;
+    if ( !read_snapshot( segment, storage ) )
+    {
+        std::cerr << "WARNING: Snapshot '" << segment.name
+                  << "' changes too fast, skipped" << std::endl;
+        return;
+    }
+    const SCOREP_Profile_LiveBuffer* buffer = ( const SCOREP_Profile_LiveBuffer* )&storage[ 0 ];
+
+    printf( "Location %" PRIu64 " (%s), pid %" PRIu64 ", rank %s",
+            header->location_id, header->location_name, header->pid,
+            format_rank( header ).c_str() );
+    if ( buffer->wallclock == 0 )
+    {
+        printf( ": no snapshot yet\n\n" );
+        return;
+    }
+    printf( ", refreshed %" PRIi64 " s ago\n",
+            ( int64_t )time( NULL ) - ( int64_t )buffer->wallclock );
+
+    std::vector< SCOREP_Profile_LiveRecord* > records;
+    for ( uint64_t i = 0; i < buffer->number_of_records; i++ )
+    {
+        records.push_back( SCOREP_Profile_LiveGetRecord( header, buffer, i ) );
+    }
+    if ( flat )
+    {
+        std::stable_sort( records.begin(), records.end(), compare_exclusive_time );
+    }
+    if ( top != 0 && records.size() > top )
+    {
+        records.resize( top );
+    }
+
+    double resolution = buffer->timer_resolution > 0 ? buffer->timer_resolution : 1;
+    printf( "%12s %12s %12s", "visits", "incl [s]", "excl [s]" );
+    for ( uint32_t m = 0; m < header->number_of_metrics; m++ )
+    {
+        printf( " %16.16s", SCOREP_Profile_LiveMetricName( header, m ) );
+    }
+    printf( "  %s\n", "region" );
+    for ( size_t i = 0; i < records.size(); i++ )
+    {
+        const SCOREP_Profile_LiveRecord* record = records[ i ];
+        printf( "%12" PRIu64 " %12.6f %12.6f",
+                record->visits,
+                record->inclusive_time / resolution,
+                record->exclusive_time / resolution );
+        const uint64_t* metrics = SCOREP_Profile_LiveGetMetrics( ( SCOREP_Profile_LiveRecord* )record );
+        for ( uint32_t m = 0; m < header->number_of_metrics; m++ )
+        {
+            printf( " %16" PRIu64, metrics[ m ] );
+        }
+        int indent = flat ? 0 : 2 * ( int )record->depth;
+        printf( "  %*s%.*s\n", indent, "",
+                SCOREP_PROFILE_LIVE_NAME_LENGTH, record->name );
+    }
+    if ( buffer->dropped_records > 0 )
+    {
+        printf( "%" PRIu64 " further call paths did not fit into the snapshot, "
+                "see SCOREP_PROFILING_LIVE_SNAPSHOT_CALLPATHS\n",
+                buffer->dropped_records );
+    }
+    printf( "\n" );
+}
+
+static bool
+parse_number( const char* text,
+              uint64_t&   value )
+{
+    char* end;
+    errno = 0;
+    value = strtoull( text, &end, 10 );
+    return errno == 0 && end != text && *end == '\0';
+}
+
+int
+main( int   argc,
+      char* argv[] )
+{
+    bool     flat         = false;
+    bool     has_location = false;
+    uint64_t location     = 0;
+    uint64_t top          = 0;
+    uint64_t pid          = 0;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg( argv[ i ] );
+        if ( arg == "-h" || arg == "--help" )
+        {
+            print_help();
+            return EXIT_SUCCESS;
+        }
+        else if ( arg == "-f" || arg == "--flat" )
+        {
+            flat = true;
+        }
+        else if ( ( arg == "-l" || arg == "--location" ) && i + 1 < argc )
+        {
+            has_location = true;
+            if ( !parse_number( argv[ ++i ], location ) )
+            {
+                std::cerr << "ERROR: Invalid location id '" << argv[ i ] << "'" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( ( arg == "-n" || arg == "--top" ) && i + 1 < argc )
+        {
+            if ( !parse_number( argv[ ++i ], top ) )
+            {
+                std::cerr << "ERROR: Invalid number '" << argv[ i ] << "'" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( pid == 0 && parse_number( argv[ i ], pid ) && pid != 0 )
+        {
+            continue;
+        }
+        else
+        {
+            std::cerr << "ERROR: Invalid argument '" << arg << "'" << std::endl;
+            print_short_usage( std::cerr );
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector< live_segment > segments = find_segments( pid );
+    if ( segments.empty() )
+    {
+        if ( pid != 0 )
+        {
+            std::cerr << "ERROR: No live profile snapshots of process " << pid << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "No live profile snapshots found" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if ( pid == 0 )
+    {
+        list_segments( segments );
+    }
+    else
+    {
+        for ( size_t i = 0; i < segments.size(); i++ )
+        {
+            if ( !has_location || segments[ i ].header->location_id == location )
+            {
+                print_segment( segments[ i ], flat, top );
+            }
+        }
+    }
+
+    for ( size_t i = 0; i < segments.size(); i++ )
+    {
+        munmap( segments[ i ].header, segments[ i ].size );
+    }
+    return EXIT_SUCCESS;
+}
@@ -297,6 +297,7 @@ SCOREP_Score_Estimator::SCOREP_Score_Estimator( SCOREP_Score_Profile* profile,
     , m_bytes_per_num_parameter( 0 )
     , m_bytes_per_str_parameter( 0 )
     , m_bytes_per_hit( 0 )
+    , m_totals_per_thread( 0 )
 {
     SCOREP_Score_Event* timestamp_event = new SCOREP_Score_TimestampEvent();
     registerEvent( timestamp_event );
@@ -731,8 +732,9 @@ SCOREP_Score_Estimator::bytesPerVisit( uint64_t region )
 
 
 void
-SCOREP_Score_Estimator::calculate( bool showRegions,
-                                   bool useMangled )
+SCOREP_Score_Estimator::calculate( bool     showRegions,
+                                   bool     useMangled,
+                                   uint32_t numberOfThreads )
 {
     /* we need access to this predicate in our operator() */
     m_show_regions = showRegions;
@@ -741,11 +743,26 @@ SCOREP_Score_Estimator::calculate( bool showRegions,
         initialize_regions( useMangled );
     }
 
-    /* Apply region data for each process */
-    for ( uint64_t process = 0; process < m_process_num; process++ )
+    /* The filter decision only depends on the region */
+    if ( m_has_filter )
     {
-        m_profile->iterateCalltree( process, *this );
+        m_filter_decisions.resize( m_region_num );
+        for ( uint64_t region = 0; region < m_region_num; region++ )
+        {
+            m_filter_decisions[ region ] = match_filter( region );
+        }
     }
+
+    /* Apply region data for all processes */
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = 1;
+    }
+    m_totals_per_thread = 2 * SCOREP_SCORE_TYPE_NUM + ( m_show_regions ? m_region_num : 0 );
+    group_totals zero   = { 0, 0, 0, 0.0, false };
+    m_thread_totals.assign( numberOfThreads * m_totals_per_thread, zero );
+    m_profile->iterateCalltree( *this, numberOfThreads );
+    merge_thread_totals();
 }
 
 void
@@ -940,15 +957,52 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
                                     uint64_t hits,
                                     uint32_t numParameters,
                                     uint32_t strParameters )
+{
+    visit( NULL, process, region, parentRegion,
+           visits, time, hits, numParameters, strParameters );
+}
+
+void
+SCOREP_Score_Estimator::operator()( uint32_t thread,
+                                    uint64_t process,
+                                    uint64_t region,
+                                    uint64_t parentRegion,
+                                    uint64_t visits,
+                                    double   time,
+                                    uint64_t hits,
+                                    uint32_t numParameters,
+                                    uint32_t strParameters )
+{
+    visit( &m_thread_totals[ thread * m_totals_per_thread ],
+           process, region, parentRegion,
+           visits, time, hits, numParameters, strParameters );
+}
+
+/* ****************************************************** private methods */
+
+void
+SCOREP_Score_Estimator::visit( group_totals* totals,
+                               uint64_t      process,
+                               uint64_t      region,
+                               uint64_t      parentRegion,
+                               uint64_t      visits,
+                               double        time,
+                               uint64_t      hits,
+                               uint32_t      numParameters,
+                               uint32_t      strParameters )
 {
     if ( visits == 0 && hits == 0 )
     {
         return;
     }
 
+    /* Indices of the groups in totals */
+    group_totals* type_totals     = totals;
+    group_totals* filtered_totals = totals ? totals + SCOREP_SCORE_TYPE_NUM : NULL;
+    group_totals* region_totals   = totals ? totals + 2 * SCOREP_SCORE_TYPE_NUM : NULL;
+
     SCOREP_Score_Type group = m_profile->getGroup( region );
 
-    const string& region_name = m_profile->getRegionName( region );
     if ( m_profile->isDynamicRegion( region ) && parentRegion != -1 )
     {
         /* Attribute bytes, visits, and time to parent node. Only parent contributes and
@@ -956,11 +1010,16 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
            iteration/instance childs. Note that dynamic regions wont trigger parameters in
            the trace */
         uint64_t bytes = visits * ( m_bytes_per_visits[ parentRegion ] );
-        m_groups[ group ]->updateProcess( process, bytes, visits, 0, time );
-        m_groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, 0, time );
+        update_group( m_groups[ group ], totals ? &type_totals[ group ] : NULL,
+                      process, bytes, visits, 0, time );
+        update_group( m_groups[ SCOREP_SCORE_TYPE_ALL ],
+                      totals ? &type_totals[ SCOREP_SCORE_TYPE_ALL ] : NULL,
+                      process, bytes, visits, 0, time );
         if ( m_show_regions )
         {
-            m_regions[ parentRegion ]->updateProcess( process, bytes, visits, 0, time );
+            update_group( m_regions[ parentRegion ],
+                          totals ? &region_totals[ parentRegion ] : NULL,
+                          process, bytes, visits, 0, time );
         }
         return;
     }
@@ -971,36 +1030,111 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
                                 + strParameters * m_bytes_per_str_parameter )
                      + hits * m_bytes_per_hit;
 
-    m_groups[ group ]->updateProcess( process, bytes, visits, hits, time );
-    m_groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time );
+    update_group( m_groups[ group ], totals ? &type_totals[ group ] : NULL,
+                  process, bytes, visits, hits, time );
+    update_group( m_groups[ SCOREP_SCORE_TYPE_ALL ],
+                  totals ? &type_totals[ SCOREP_SCORE_TYPE_ALL ] : NULL,
+                  process, bytes, visits, hits, time );
 
     if ( m_show_regions )
     {
-        m_regions[ region ]->updateProcess( process, bytes, visits, hits, time );
+        update_group( m_regions[ region ], totals ? &region_totals[ region ] : NULL,
+                      process, bytes, visits, hits, time );
     }
 
     if ( m_has_filter )
     {
-        bool do_filter = match_filter( region );
+        bool do_filter = region < m_filter_decisions.size() ?
+                         m_filter_decisions[ region ] :
+                         match_filter( region );
         if ( m_show_regions )
         {
-            m_regions[ region ]->doFilter( do_filter ?
-                                           SCOREP_SCORE_FILTER_YES :
-                                           SCOREP_SCORE_FILTER_NO );
+            if ( totals )
+            {
+                /* the threads would race on the filter state of the region */
+                region_totals[ region ].filter_applied = true;
+            }
+            else
+            {
+                m_regions[ region ]->doFilter( do_filter ?
+                                               SCOREP_SCORE_FILTER_YES :
+                                               SCOREP_SCORE_FILTER_NO );
+            }
         }
         if ( !do_filter )
         {
-            m_filtered[ group ]->updateProcess( process, bytes, visits, hits, time );
-            m_filtered[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time );
+            update_group( m_filtered[ group ], totals ? &filtered_totals[ group ] : NULL,
+                          process, bytes, visits, hits, time );
+            update_group( m_filtered[ SCOREP_SCORE_TYPE_ALL ],
+                          totals ? &filtered_totals[ SCOREP_SCORE_TYPE_ALL ] : NULL,
+                          process, bytes, visits, hits, time );
         }
         else
         {
-            m_filtered[ SCOREP_SCORE_TYPE_FLT ]->updateProcess( process, bytes, visits, hits, time );
+            update_group( m_filtered[ SCOREP_SCORE_TYPE_FLT ],
+                          totals ? &filtered_totals[ SCOREP_SCORE_TYPE_FLT ] : NULL,
+                          process, bytes, visits, hits, time );
         }
     }
 }
 
-/* ****************************************************** private methods */
+void
+SCOREP_Score_Estimator::update_group( SCOREP_Score_Group* group,
+                                      group_totals*       totals,
+                                      uint64_t            process,
+                                      uint64_t            bytes,
+                                      uint64_t            visits,
+                                      uint64_t            hits,
+                                      double              time )
+{
+    if ( !totals )
+    {
+        group->updateProcess( process, bytes, visits, hits, time );
+        return;
+    }
+    group->updateProcessBuffer( process, bytes );
+    totals->bytes  += bytes;
+    totals->visits += visits;
+    totals->hits   += hits;
+    totals->time   += time;
+}
+
+void
+SCOREP_Score_Estimator::merge_thread_totals( void )
+{
+    for ( uint64_t i = 0; i < m_thread_totals.size(); i++ )
+    {
+        const group_totals& totals = m_thread_totals[ i ];
+        uint64_t            index  = i % m_totals_per_thread;
+
+        SCOREP_Score_Group* group;
+        if ( index < SCOREP_SCORE_TYPE_NUM )
+        {
+            group = m_groups[ index ];
+        }
+        else if ( index < 2 * SCOREP_SCORE_TYPE_NUM )
+        {
+            if ( !m_has_filter )
+            {
+                continue;
+            }
+            group = m_filtered[ index - SCOREP_SCORE_TYPE_NUM ];
+        }
+        else
+        {
+            uint64_t region = index - 2 * SCOREP_SCORE_TYPE_NUM;
+            group = m_regions[ region ];
+            if ( totals.filter_applied )
+            {
+                group->doFilter( m_filter_decisions[ region ] ?
+                                 SCOREP_SCORE_FILTER_YES :
+                                 SCOREP_SCORE_FILTER_NO );
+            }
+        }
+        group->addTotals( totals.bytes, totals.visits, totals.hits, totals.time );
+    }
+    m_thread_totals.clear();
+}
 
 void
 SCOREP_Score_Estimator::delete_groups( SCOREP_Score_Group** groups,
@@ -54,7 +54,8 @@ typedef struct SCOREP_Filter SCOREP_Filter;
  * This class implements the estimation logic.
  */
 class SCOREP_Score_Estimator
-    : public SCOREP_Score_CalltreeVisitor
+    : public SCOREP_Score_CalltreeVisitor,
+    public SCOREP_Score_ParallelCalltreeVisitor
 {
 public:
     /**
@@ -77,10 +78,12 @@ public:
      *                     in addition to the groups.
      * @param useMangled   Whether mangled or demangled region names are used for
      *                     display.
+     * @param numberOfThreads  Number of threads which evaluate the processes.
      */
     void
-    calculate( bool showRegions,
-               bool useMangled );
+    calculate( bool     showRegions,
+               bool     useMangled,
+               uint32_t numberOfThreads = 1 );
 
     /**
      * Returns bytes per visit of for a region
@@ -127,7 +130,68 @@ public:
                 uint32_t numParameters,
                 uint32_t strParameters );
 
+    // SCOREP_Score_ParallelCalltreeVisitor
+    void
+    operator()( uint32_t thread,
+                uint64_t process,
+                uint64_t region,
+                uint64_t parentRegion,
+                uint64_t visits,
+                double   time,
+                uint64_t hits,
+                uint32_t numParameters,
+                uint32_t strParameters );
+
 private:
+    /**
+     * Sums over all processes of a group, accumulated per thread during the
+     * parallel evaluation.
+     */
+    struct group_totals
+    {
+        uint64_t bytes;
+        uint64_t visits;
+        uint64_t hits;
+        double   time;
+        bool     filter_applied;
+    };
+
+    /**
+     * Accounts one call tree node of @a process. If @a totals is not NULL,
+     * the sums over all processes are added to @a totals instead of the
+     * groups, indexed like the groups in m_groups, m_filtered, and m_regions
+     * one after another.
+     */
+    void
+    visit( group_totals* totals,
+           uint64_t      process,
+           uint64_t      region,
+           uint64_t      parentRegion,
+           uint64_t      visits,
+           double        time,
+           uint64_t      hits,
+           uint32_t      numParameters,
+           uint32_t      strParameters );
+
+    /**
+     * Updates @a group, or only its per-process data and @a totals if
+     * @a totals is not NULL.
+     */
+    void
+    update_group( SCOREP_Score_Group* group,
+                  group_totals*       totals,
+                  uint64_t            process,
+                  uint64_t            bytes,
+                  uint64_t            visits,
+                  uint64_t            hits,
+                  double              time );
+
+    /**
+     * Adds the sums over all processes collected by the threads to the groups.
+     */
+    void
+    merge_thread_totals( void );
+
     /**
      * Checks whether @a region is filtered.
      * @param regionId  Specifies the region by its ID.
@@ -242,6 +306,23 @@ private:
     uint64_t                m_bytes_per_hit;
     std::vector< uint64_t > m_bytes_per_visits;
 
+    /**
+     * Stores for every region whether it is filtered, only valid if a filter
+     * is used.
+     */
+    std::vector<bool> m_filter_decisions;
+
+    /**
+     * Stores the per-thread sums of the groups during the parallel evaluation.
+     */
+    std::vector<group_totals> m_thread_totals;
+
+    /**
+     * Stores the number of groups, filtered groups, and regions in
+     * m_thread_totals per thread.
+     */
+    uint64_t m_totals_per_thread;
+
     /**
      * Stores all events by its name.
      */
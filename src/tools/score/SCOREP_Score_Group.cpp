@@ -118,6 +118,25 @@ SCOREP_Score_Group::updateProcess( uint64_t process,
     m_total_time         += time;
 }
 
+void
+SCOREP_Score_Group::updateProcessBuffer( uint64_t process,
+                                         uint64_t bytes )
+{
+    m_max_buf[ process ] += bytes;
+}
+
+void
+SCOREP_Score_Group::addTotals( uint64_t bytes,
+                               uint64_t numberOfVisits,
+                               uint64_t numberOfHits,
+                               double   time )
+{
+    m_total_buf  += bytes;
+    m_visits     += numberOfVisits;
+    m_hits       += numberOfHits;
+    m_total_time += time;
+}
+
 void
 SCOREP_Score_Group::updateWidths( SCOREP_Score_FieldWidths& widths )
 {
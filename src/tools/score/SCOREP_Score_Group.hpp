@@ -133,6 +133,30 @@ public:
                    uint64_t numberOfHits,
                    double   time );
 
+    /**
+     * Adds @a bytes to the trace buffer requirements of @a process, without
+     * updating the sums over all processes. May be called concurrently for
+     * distinct processes.
+     * @param process        The process num for which the data added.
+     * @param bytes          Number of bytes that are written to the trace.
+     */
+    void
+    updateProcessBuffer( uint64_t process,
+                         uint64_t bytes );
+
+    /**
+     * Adds sums over processes, which were not added by updateProcessBuffer().
+     * @param bytes          Number of bytes that are written to the trace.
+     * @param numberOfVisits Number of visits for the new region.
+     * @param numberOfHits   Number of hits for the new region.
+     * @param time           Sum of time spent in this region in all visits.
+     */
+    void
+    addTotals( uint64_t bytes,
+               uint64_t numberOfVisits,
+               uint64_t numberOfHits,
+               double   time );
+
     /**
      * Updates the field width to the required values.
      * @param widths Current field widths.
@@ -39,7 +39,9 @@
 #include "SCOREP_Score_Profile.hpp"
 #include <Cube.h>
 #include <CubeTypes.h>
+#include <CubeServices.h>
 #include <assert.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <sstream>
 #include <cctype>
@@ -47,6 +49,122 @@
 using namespace std;
 using namespace cube;
 
+/* Number of call tree nodes which are read before they are evaluated */
+#define SCOREP_SCORE_CALLTREE_BATCH_SIZE 256
+
+/**
+ * Severities of a batch of call tree nodes for all processes, stored as
+ * [node * number of processes + process].
+ */
+struct scorep_score_calltree_batch
+{
+    vector<Cnode*>   nodes;
+    vector<uint64_t> visits;
+    vector<double>   time;
+    vector<uint64_t> hits;
+    uint64_t         number_of_processes;
+};
+
+/* Number of batches which are read ahead of their evaluation */
+#define SCOREP_SCORE_CALLTREE_QUEUE_LENGTH 2
+
+/**
+ * Batches handed from the main thread, which reads the CUBE report, to the
+ * evaluating threads. Every thread evaluates every batch, in queue order. A
+ * batch is refilled after all threads have evaluated it.
+ */
+struct scorep_score_batch_queue
+{
+    scorep_score_calltree_batch batches[ SCOREP_SCORE_CALLTREE_QUEUE_LENGTH ];
+    /* Number of threads which have not yet evaluated the batch */
+    uint32_t                    pending[ SCOREP_SCORE_CALLTREE_QUEUE_LENGTH ];
+    uint64_t                    number_of_batches;
+    bool                        closed;
+    pthread_mutex_t             mutex;
+    /* Signaled when a batch is queued or the queue is closed */
+    pthread_cond_t              queued;
+    /* Signaled when a batch is evaluated by all threads */
+    pthread_cond_t              evaluated;
+};
+
+/**
+ * The part of the batches evaluated by one thread.
+ */
+struct scorep_score_batch_worker
+{
+    SCOREP_Score_ParallelCalltreeVisitor* visitor;
+    scorep_score_batch_queue*             queue;
+    uint32_t                              thread;
+    uint64_t                              first_process;
+    uint64_t                              end_process;
+};
+
+static void
+evaluate_batch( scorep_score_batch_worker*         worker,
+                const scorep_score_calltree_batch& batch )
+{
+    for ( uint64_t i = 0; i < batch.nodes.size(); i++ )
+    {
+        Cnode*   node          = batch.nodes[ i ];
+        uint64_t region        = node->get_callee()->get_id();
+        uint64_t parent_region = -1;
+        if ( node->get_parent() )
+        {
+            parent_region = node->get_parent()->get_callee()->get_id();
+        }
+        uint32_t num_parameters = node->get_num_parameters().size();
+        uint32_t str_parameters = node->get_str_parameters().size();
+
+        uint64_t row = i * batch.number_of_processes;
+        for ( uint64_t process = worker->first_process;
+              process < worker->end_process;
+              process++ )
+        {
+            ( *worker->visitor )( worker->thread,
+                                  process,
+                                  region,
+                                  parent_region,
+                                  batch.visits[ row + process ],
+                                  batch.time[ row + process ],
+                                  batch.hits[ row + process ],
+                                  num_parameters,
+                                  str_parameters );
+        }
+    }
+}
+
+static void*
+run_batch_worker( void* arg )
+{
+    scorep_score_batch_worker* worker = ( scorep_score_batch_worker* )arg;
+    scorep_score_batch_queue*  queue  = worker->queue;
+
+    for ( uint64_t next = 0;; next++ )
+    {
+        pthread_mutex_lock( &queue->mutex );
+        while ( next == queue->number_of_batches && !queue->closed )
+        {
+            pthread_cond_wait( &queue->queued, &queue->mutex );
+        }
+        bool done = next == queue->number_of_batches;
+        pthread_mutex_unlock( &queue->mutex );
+        if ( done )
+        {
+            return NULL;
+        }
+
+        uint32_t slot = next % SCOREP_SCORE_CALLTREE_QUEUE_LENGTH;
+        evaluate_batch( worker, queue->batches[ slot ] );
+
+        pthread_mutex_lock( &queue->mutex );
+        if ( --queue->pending[ slot ] == 0 )
+        {
+            pthread_cond_signal( &queue->evaluated );
+        }
+        pthread_mutex_unlock( &queue->mutex );
+    }
+}
+
 
 SCOREP_Score_Profile::SCOREP_Score_Profile( cube::Cube* cube   ) : m_cube( cube ), m_num_arguments( -1 )
 {
@@ -92,6 +210,23 @@ SCOREP_Score_Profile::SCOREP_Score_Profile( cube::Cube* cube   ) : m_cube( cube
     m_processes = m_cube->get_procv();
     m_regions   = m_cube->get_regv();
 
+    map<LocationGroup*, uint64_t> process_indices;
+    for ( uint64_t i = 0; i < m_processes.size(); i++ )
+    {
+        process_indices[ m_processes[ i ] ] = i;
+    }
+    const vector<Location*>& locations = m_cube->get_locationv();
+    m_location_processes.resize( locations.size(), -1 );
+    for ( uint64_t i = 0; i < locations.size(); i++ )
+    {
+        map<LocationGroup*, uint64_t>::const_iterator it =
+            process_indices.find( locations[ i ]->get_parent() );
+        if ( it != process_indices.end() )
+        {
+            m_location_processes[ i ] = it->second;
+        }
+    }
+
     // Make sure the id of the region definitions match their position in the vector
     // and add special regions to containers.
     for ( uint32_t i = 0; i < getNumberOfRegions(); i++ )
@@ -333,7 +468,142 @@ SCOREP_Score_Profile::iterateCalltree( uint64_t                      process,
     }
 }
 
+void
+SCOREP_Score_Profile::iterateCalltree( SCOREP_Score_ParallelCalltreeVisitor& visitor,
+                                       uint32_t                              numberOfThreads )
+{
+    uint64_t number_of_processes = getNumberOfProcesses();
+    if ( numberOfThreads > number_of_processes )
+    {
+        numberOfThreads = number_of_processes;
+    }
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = 1;
+    }
+
+    /* Visit the nodes in the same order as the recursive iteration */
+    vector<Cnode*> stack;
+    vector<Cnode*> roots = m_cube->get_root_cnodev();
+    for ( uint64_t i = roots.size(); i > 0; i-- )
+    {
+        stack.push_back( roots[ i - 1 ] );
+    }
+
+    scorep_score_batch_queue         queue;
+    vector<scorep_score_batch_worker> workers( numberOfThreads );
+    for ( uint32_t t = 0; t < numberOfThreads; t++ )
+    {
+        workers[ t ].visitor       = &visitor;
+        workers[ t ].queue         = &queue;
+        workers[ t ].thread        = t;
+        workers[ t ].first_process = number_of_processes * t / numberOfThreads;
+        workers[ t ].end_process   = number_of_processes * ( t + 1 ) / numberOfThreads;
+    }
+
+    if ( numberOfThreads == 1 )
+    {
+        while ( !stack.empty() )
+        {
+            read_batch( stack, queue.batches[ 0 ] );
+            evaluate_batch( &workers[ 0 ], queue.batches[ 0 ] );
+        }
+        return;
+    }
+
+    /* The threads evaluate a batch while this thread reads the next one */
+    for ( uint32_t slot = 0; slot < SCOREP_SCORE_CALLTREE_QUEUE_LENGTH; slot++ )
+    {
+        queue.pending[ slot ] = 0;
+    }
+    queue.number_of_batches = 0;
+    queue.closed            = false;
+    pthread_mutex_init( &queue.mutex, NULL );
+    pthread_cond_init( &queue.queued, NULL );
+    pthread_cond_init( &queue.evaluated, NULL );
+
+    vector<pthread_t> threads( numberOfThreads );
+    for ( uint32_t t = 0; t < numberOfThreads; t++ )
+    {
+        if ( pthread_create( &threads[ t ], NULL, run_batch_worker, &workers[ t ] ) != 0 )
+        {
+            cerr << "ERROR: Cannot create thread" << endl;
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    while ( !stack.empty() )
+    {
+        uint32_t slot = queue.number_of_batches % SCOREP_SCORE_CALLTREE_QUEUE_LENGTH;
+        pthread_mutex_lock( &queue.mutex );
+        while ( queue.pending[ slot ] > 0 )
+        {
+            pthread_cond_wait( &queue.evaluated, &queue.mutex );
+        }
+        pthread_mutex_unlock( &queue.mutex );
+
+        read_batch( stack, queue.batches[ slot ] );
+
+        pthread_mutex_lock( &queue.mutex );
+        queue.pending[ slot ] = numberOfThreads;
+        queue.number_of_batches++;
+        pthread_cond_broadcast( &queue.queued );
+        pthread_mutex_unlock( &queue.mutex );
+    }
+
+    pthread_mutex_lock( &queue.mutex );
+    queue.closed = true;
+    pthread_cond_broadcast( &queue.queued );
+    pthread_mutex_unlock( &queue.mutex );
+    for ( uint32_t t = 0; t < numberOfThreads; t++ )
+    {
+        pthread_join( threads[ t ], NULL );
+    }
+
+    pthread_cond_destroy( &queue.evaluated );
+    pthread_cond_destroy( &queue.queued );
+    pthread_mutex_destroy( &queue.mutex );
+}
+
 /* **************************************************** private members */
+void
+SCOREP_Score_Profile::read_batch( vector<Cnode*>&              stack,
+                                  scorep_score_calltree_batch& batch )
+{
+    uint64_t number_of_processes = getNumberOfProcesses();
+
+    batch.number_of_processes = number_of_processes;
+    batch.nodes.clear();
+    while ( !stack.empty() && batch.nodes.size() < SCOREP_SCORE_CALLTREE_BATCH_SIZE )
+    {
+        Cnode* node = stack.back();
+        stack.pop_back();
+        batch.nodes.push_back( node );
+        for ( uint32_t i = node->num_children(); i > 0; i-- )
+        {
+            stack.push_back( node->get_child( i - 1 ) );
+        }
+    }
+
+    uint64_t size = batch.nodes.size() * number_of_processes;
+    batch.visits.assign( size, 0 );
+    batch.time.assign( size, 0.0 );
+    batch.hits.assign( size, 0 );
+    for ( uint64_t i = 0; i < batch.nodes.size(); i++ )
+    {
+        uint64_t row = i * number_of_processes;
+        add_location_values( m_visits, CUBE_CALCULATE_EXCLUSIVE,
+                             batch.nodes[ i ], &batch.visits[ row ] );
+        add_location_values( m_time, CUBE_CALCULATE_INCLUSIVE,
+                             batch.nodes[ i ], &batch.time[ row ] );
+        if ( m_hits )
+        {
+            add_location_values( m_hits, CUBE_CALCULATE_EXCLUSIVE,
+                                 batch.nodes[ i ], &batch.hits[ row ] );
+        }
+    }
+}
+
 SCOREP_Score_Type
 SCOREP_Score_Profile::get_definition_type( uint64_t region )
 {
@@ -499,6 +769,58 @@ SCOREP_Score_Profile::get_time( Cnode*   node,
     }
 }
 
+/* Conversion of the values of the visits, hits, and time metric, as in
+   get_visits(), get_hits(), and get_time() */
+static inline void
+add_value( Value* value, uint64_t& sum )
+{
+    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+    {
+        sum += ( ( TauAtomicValue* )value )->getN().getUnsignedLong();
+    }
+    else
+    {
+        sum += value->getUnsignedLong();
+    }
+}
+
+static inline void
+add_value( Value* value, double& sum )
+{
+    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+    {
+        sum += ( ( TauAtomicValue* )value )->getSum().getDouble();
+    }
+    else
+    {
+        sum += value->getDouble();
+    }
+}
+
+template< typename T >
+void
+SCOREP_Score_Profile::add_location_values( Metric*            metric,
+                                           CalculationFlavour metricFlavour,
+                                           Cnode*             node,
+                                           T*                 perProcess )
+{
+    uint64_t number_of_locations = m_location_processes.size();
+    Value**  values              = m_cube->get_sevs_adv( metric, metricFlavour,
+                                                         node, CUBE_CALCULATE_EXCLUSIVE );
+    if ( !values )
+    {
+        return;
+    }
+    for ( uint64_t i = 0; i < number_of_locations; i++ )
+    {
+        if ( values[ i ] && m_location_processes[ i ] != ( uint64_t )-1 )
+        {
+            add_value( values[ i ], perProcess[ m_location_processes[ i ] ] );
+        }
+    }
+    services::delete_row_of_values( values, number_of_locations );
+}
+
 uint64_t
 SCOREP_Score_Profile::get_hits( Cnode*   node,
                                 uint64_t process )
@@ -57,6 +57,29 @@ public:
                 uint32_t strParameters ) = 0;
 };
 
+/**
+ * Visitor for the parallel traversal of the call tree, see
+ * SCOREP_Score_Profile::iterateCalltree( SCOREP_Score_ParallelCalltreeVisitor&, uint32_t ).
+ * @a thread is the index of the calling thread. Different threads visit
+ * distinct processes concurrently.
+ */
+class SCOREP_Score_ParallelCalltreeVisitor
+{
+public:
+    virtual void
+    operator()( uint32_t thread,
+                uint64_t process,
+                uint64_t region,
+                uint64_t parentRegion,
+                uint64_t visits,
+                double   time,
+                uint64_t hits,
+                uint32_t numParameters,
+                uint32_t strParameters ) = 0;
+};
+
+struct scorep_score_calltree_batch;
+
 /**
  * This class encapsulates the access of the estimator to the CUBE4 profile.
  */
@@ -181,6 +204,17 @@ public:
     iterateCalltree( uint64_t                      process,
                      SCOREP_Score_CalltreeVisitor& visitor );
 
+    /**
+     * Iterates over the call tree of all processes. The severities of a
+     * batch of call tree nodes are read for all locations at once and then
+     * evaluated by @a numberOfThreads threads, each visiting the nodes of a
+     * distinct range of processes in call tree order. The threads are
+     * created once and evaluate a batch while the next one is read.
+     */
+    void
+    iterateCalltree( SCOREP_Score_ParallelCalltreeVisitor& visitor,
+                     uint32_t                              numberOfThreads );
+
     /**
      * Returns a value >= 0 if the number of program arguments is provided by the cube file.
      * Note: in a future version this function should return independent values per (MPMD) root
@@ -205,6 +239,14 @@ private:
                           SCOREP_Score_CalltreeVisitor& visitor,
                           cube::Cnode*                  node );
 
+    /**
+     * Moves the next nodes in call tree order from @a stack into @a batch
+     * and reads their severities. The children of the nodes are pushed.
+     */
+    void
+    read_batch( std::vector<cube::Cnode*>&   stack,
+                scorep_score_calltree_batch& batch );
+
     /**
      * Checks whether a region is an MPI or OpenMP region.
      * @param regionID  ID of the region for which the type is requested.
@@ -234,6 +276,17 @@ private:
     get_hits( cube::Cnode* node,
               uint64_t     process );
 
+    /**
+     * Adds the values of @a metric for @a node on every location to
+     * @a perProcess, which is indexed by the process of the location.
+     */
+    template< typename T >
+    void
+    add_location_values( cube::Metric*            metric,
+                         cube::CalculationFlavour metricFlavour,
+                         cube::Cnode*             node,
+                         T*                       perProcess );
+
 private:
     /**
      * Stores a pointer to the CUBE data structure.
@@ -260,6 +313,11 @@ private:
      */
     std::vector<cube::Process*> m_processes;
 
+    /**
+     * Stores the index of the process of every location in the CUBE report.
+     */
+    std::vector<uint64_t> m_location_processes;
+
     /**
      * Stores a list of CUBE region objects.
      */
@@ -38,6 +38,7 @@
 #include <config.h>
 #include "SCOREP_Score_Profile.hpp"
 #include "SCOREP_Score_Estimator.hpp"
+#include <unistd.h>
 
 using namespace std;
 
@@ -60,6 +61,7 @@ main( int    argc,
     int64_t dense_num    = 0;
     bool    show_regions = false;
     bool    use_mangled  = false;
+    int64_t num_threads  = -1;
 
     //--------------------------------------- Parameter options parsing
 
@@ -112,6 +114,20 @@ main( int    argc,
             {
                 use_mangled = true;
             }
+            else if ( arg == "-j" )
+            {
+                if ( i + 1 < argc )
+                {
+                    num_threads = atoi( argv[ i + 1 ] );
+                    i++;
+                }
+                else
+                {
+                    cerr << "ERROR: Missing number of threads" << endl;
+                    print_help();
+                    exit( EXIT_FAILURE );
+                }
+            }
             else
             {
                 cerr << "ERROR: Unknown argment: '" << arg << "'" << endl;
@@ -143,6 +159,19 @@ main( int    argc,
         exit( EXIT_FAILURE );
     }
 
+    if ( num_threads == -1 )
+    {
+        long num_cpus = sysconf( _SC_NPROCESSORS_ONLN );
+        num_threads = num_cpus > 0 ? num_cpus : 1;
+    }
+    else if ( num_threads < 1 )
+    {
+        cerr << "ERROR: The number of threads must be at least one: "
+             << "'" << num_threads << "'" << endl;
+        print_help();
+        exit( EXIT_FAILURE );
+    }
+
     //-------------------------------------- Scoreing
 
     SCOREP_Score_Profile* profile;
@@ -165,7 +194,7 @@ main( int    argc,
     {
         estimator.initializeFilter( filter_file );
     }
-    estimator.calculate( show_regions, use_mangled );
+    estimator.calculate( show_regions, use_mangled, num_threads );
     estimator.printGroups();
 
     if ( show_regions )
@@ -38,6 +38,7 @@
 #include <SCOREP_Timer_Ticks.h>
 #include <SCOREP_Events.h>
 #include <SCOREP_Memory.h>
+#include <SCOREP_Atomic.h>
 #include <scorep_substrates_definition.h>
 
 #define SCOREP_DEBUG_MODULE_NAME MEMORY
@@ -64,12 +65,35 @@ typedef struct free_list_item
     struct free_list_item* next;
 } free_list_item;
 
-struct SCOREP_AllocMetric
+/*
+ * The allocations are distributed by their address over independent shards,
+ * each with its own lock and splay tree. Threads allocating or freeing
+ * different addresses thus rarely touch the same shard, also if the memory
+ * is freed by a different thread than the one which allocated it.
+ */
+#define SHARD_BITS        7
+#define NUMBER_OF_SHARDS  ( 1 << SHARD_BITS )
+#define CACHE_LINE_SIZE   64
+
+typedef struct allocation_shard
 {
-    SCOREP_Mutex             mutex;
+    SCOREP_Mutex     lock;
+    allocation_item* allocations;
+    free_list_item*  free_list;
+} allocation_shard;
+
+/* Avoid false sharing between the shards, each one occupies whole cache
+ * lines. SCOREP_AllocMetric_New aligns the shards to the cache line. */
+typedef union padded_allocation_shard
+{
+    allocation_shard shard;
+    char             padding[ ( ( sizeof( allocation_shard ) + CACHE_LINE_SIZE - 1 )
+                                / CACHE_LINE_SIZE ) * CACHE_LINE_SIZE ];
+} padded_allocation_shard;
 
-    allocation_item*         allocations;
-    free_list_item*          free_list;
+struct SCOREP_AllocMetric
+{
+    padded_allocation_shard  shards[ NUMBER_OF_SHARDS ];
 
     SCOREP_SamplingSetHandle sampling_set;
     uint64_t                 total_allocated_memory;
@@ -196,22 +220,43 @@ splay( allocation_item* root,
 }
 
 
+static allocation_shard*
+get_shard( SCOREP_AllocMetric* allocMetric,
+           uint64_t            addr )
+{
+    /* Fibonacci hashing, the lowest bits are always zero due to alignment */
+    uint64_t hash = ( addr >> 4 ) * UINT64_C( 0x9E3779B97F4A7C15 );
+    return &allocMetric->shards[ hash >> ( 64 - SHARD_BITS ) ].shard;
+}
+
+static void
+lock_shard( allocation_shard* shard )
+{
+    SCOREP_MutexLock( shard->lock );
+}
+
 static void
-insert_memory_allocation( SCOREP_AllocMetric* allocMetric,
-                          allocation_item*    allocation )
+unlock_shard( allocation_shard* shard )
 {
-    if ( allocMetric->allocations )
+    SCOREP_MutexUnlock( shard->lock );
+}
+
+static void
+insert_memory_allocation( allocation_shard* shard,
+                          allocation_item*  allocation )
+{
+    if ( shard->allocations )
     {
-        allocMetric->allocations = splay( allocMetric->allocations, allocation->address );
-        if ( allocation->address < allocMetric->allocations->address )
+        shard->allocations = splay( shard->allocations, allocation->address );
+        if ( allocation->address < shard->allocations->address )
         {
-            allocation->right       = allocMetric->allocations;
+            allocation->right       = shard->allocations;
             allocation->left        = allocation->right->left;
             allocation->right->left = NULL;
         }
-        else if ( allocation->address > allocMetric->allocations->address )
+        else if ( allocation->address > shard->allocations->address )
         {
-            allocation->left        = allocMetric->allocations;
+            allocation->left        = shard->allocations;
             allocation->right       = allocation->left->right;
             allocation->left->right = NULL;
         }
@@ -220,7 +265,18 @@ insert_memory_allocation( SCOREP_AllocMetric* allocMetric,
             UTILS_WARNING( "Allocation already known: 0x%" PRIx64, allocation->address );
         }
     }
-    allocMetric->allocations = allocation;
+    shard->allocations = allocation;
+}
+
+/* Inserts the allocation into the shard of its address, takes the shard lock */
+static void
+publish_memory_allocation( SCOREP_AllocMetric* allocMetric,
+                           allocation_item*    allocation )
+{
+    allocation_shard* shard = get_shard( allocMetric, allocation->address );
+    lock_shard( shard );
+    insert_memory_allocation( shard, allocation );
+    unlock_shard( shard );
 }
 
 static allocation_item*
@@ -233,37 +289,46 @@ add_memory_allocation( SCOREP_AllocMetric* allocMetric,
         return NULL;
     }
 
-    allocation_item* new_item = ( allocation_item* )allocMetric->free_list;
+    allocation_shard* shard = get_shard( allocMetric, addr );
+    lock_shard( shard );
+
+    allocation_item* new_item = ( allocation_item* )shard->free_list;
     if ( new_item )
     {
-        allocMetric->free_list = allocMetric->free_list->next;
+        shard->free_list = shard->free_list->next;
     }
     else
     {
+        /* Misc memory is allocated from the page manager of the current
+         * location, thus this does not need the shard lock */
+        unlock_shard( shard );
         new_item = SCOREP_Memory_AllocForMisc( sizeof( *new_item ) );
+        lock_shard( shard );
     }
     memset( new_item, 0, sizeof( *new_item ) );
     new_item->address = addr;
     new_item->size    = size;
 
-    insert_memory_allocation( allocMetric, new_item );
+    insert_memory_allocation( shard, new_item );
+
+    unlock_shard( shard );
 
     return new_item;
 }
 
 static allocation_item*
-find_memory_allocation( SCOREP_AllocMetric* allocMetric,
-                        uint64_t            addr )
+find_memory_allocation( allocation_shard* shard,
+                        uint64_t          addr )
 {
-    if ( allocMetric == NULL || allocMetric->allocations == NULL )
+    if ( shard->allocations == NULL )
     {
         return NULL;
     }
 
-    allocMetric->allocations = splay( allocMetric->allocations, addr );
-    if ( addr == allocMetric->allocations->address )
+    shard->allocations = splay( shard->allocations, addr );
+    if ( addr == shard->allocations->address )
     {
-        return allocMetric->allocations;
+        return shard->allocations;
     }
 
     return NULL;
@@ -271,26 +336,25 @@ find_memory_allocation( SCOREP_AllocMetric* allocMetric,
 
 
 static void
-remove_memory_allocation( SCOREP_AllocMetric* allocMetric,
-                          allocation_item*    allocation )
+remove_memory_allocation( allocation_shard* shard,
+                          allocation_item*  allocation )
 {
-    if ( allocMetric == NULL
-         || allocMetric->allocations == NULL
-         || allocMetric->allocations != allocation )
+    if ( shard->allocations == NULL
+         || shard->allocations != allocation )
     {
         return;
     }
 
     if ( allocation->left == NULL )
     {
-        allocMetric->allocations = allocation->right;
+        shard->allocations = allocation->right;
     }
     else
     {
         /* Serach in the sub-tree where all entries are smaller than the allocation
          * to delete, the bigest, for this, the right child must be NULL */
-        allocMetric->allocations        = splay( allocation->left, allocation->address );
-        allocMetric->allocations->right = allocation->right;
+        shard->allocations        = splay( allocation->left, allocation->address );
+        shard->allocations->right = allocation->right;
     }
 
     allocation->right = NULL;
@@ -298,42 +362,33 @@ remove_memory_allocation( SCOREP_AllocMetric* allocMetric,
 }
 
 static void
-free_memory_allocation( SCOREP_AllocMetric* allocMetric,
-                        allocation_item*    allocation )
-{
-    free_list_item* next = allocMetric->free_list;
-    allocMetric->free_list       = ( free_list_item* )allocation;
-    allocMetric->free_list->next = next;
-}
-
-static void
-delete_memory_allocation( SCOREP_AllocMetric* allocMetric,
-                          allocation_item*    allocation )
+free_memory_allocation( allocation_shard* shard,
+                        allocation_item*  allocation )
 {
-    remove_memory_allocation( allocMetric, allocation );
-    free_memory_allocation( allocMetric, allocation );
+    free_list_item* next = shard->free_list;
+    shard->free_list       = ( free_list_item* )allocation;
+    shard->free_list->next = next;
 }
 
 /* Keep track of the allocated memory per process, not only per SCOREP_AllocMetric */
-static size_t       process_allocated_memory;
-static SCOREP_Mutex process_allocated_memory_mutex;
-static int          n_alloc_metric_objects;
+static uint64_t process_allocated_memory;
 
 SCOREP_ErrorCode
 SCOREP_AllocMetric_New( const char*          name,
                         SCOREP_AllocMetric** allocMetric )
 {
-    /* not so nice. Make AllocMetric a subsystem? */
-    if ( n_alloc_metric_objects == 0 )
-    {
-        SCOREP_MutexCreate( &process_allocated_memory_mutex );
-    }
-    n_alloc_metric_objects += 1;
-
-    *allocMetric = SCOREP_Memory_AllocForMisc( sizeof( **allocMetric ) );
+    /* Misc memory is not aligned to the cache line, thus allocate one more
+     * and align the object, i.e., its first shard, manually */
+    uintptr_t memory = ( uintptr_t )
+                       SCOREP_Memory_AllocForMisc( sizeof( **allocMetric ) + CACHE_LINE_SIZE - 1 );
+    *allocMetric = ( SCOREP_AllocMetric* )
+                   ( ( memory + CACHE_LINE_SIZE - 1 ) & ~( uintptr_t )( CACHE_LINE_SIZE - 1 ) );
     memset( *allocMetric, 0, sizeof( **allocMetric ) );
 
-    SCOREP_MutexCreate( &( *allocMetric )->mutex );
+    for ( uint32_t i = 0; i < NUMBER_OF_SHARDS; i++ )
+    {
+        SCOREP_MutexCreate( &( *allocMetric )->shards[ i ].shard.lock );
+    }
 
     SCOREP_MetricHandle metric_handle =
         SCOREP_Definitions_NewMetric( name,
@@ -369,41 +424,85 @@ SCOREP_AllocMetric_New( const char*          name,
 void
 SCOREP_AllocMetric_Destroy( SCOREP_AllocMetric* allocMetric )
 {
-    SCOREP_MutexDestroy( &allocMetric->mutex );
-    /* not so nice. Make AllocMetric a subsystem? */
-    n_alloc_metric_objects -= 1;
-    if ( n_alloc_metric_objects == 0 )
+    for ( uint32_t i = 0; i < NUMBER_OF_SHARDS; i++ )
     {
-        SCOREP_MutexDestroy( &process_allocated_memory_mutex );
+        SCOREP_MutexDestroy( &allocMetric->shards[ i ].shard.lock );
     }
 }
 
 
+/* Changes the total of the metric by @a change and triggers the new value.
+ * The update happens while the per-process metrics location is acquired, so
+ * that the recorded values are in timestamp order and their maximum is the
+ * exact peak. @a released is subtracted afterwards without triggering it.
+ * Returns the triggered total. */
+static uint64_t
+trigger_total_allocated_memory( SCOREP_AllocMetric* allocMetric,
+                                uint64_t            change,
+                                uint64_t            released )
+{
+    /* We need to ensure, that we take the timestamp  *after* we acquired
+       the metric location, else we may end up with an invalid timestamp order */
+    uint64_t         timestamp;
+    SCOREP_Location* per_process_metric_location =
+        SCOREP_Location_AcquirePerProcessMetricsLocation( &timestamp );
+
+    uint64_t total_allocated_memory =
+        SCOREP_ATOMIC_FETCH_ADD( &allocMetric->total_allocated_memory, change,
+                                 SCOREP_ATOMIC_RELAXED ) + change;
+    SCOREP_Location_TriggerCounterUint64( per_process_metric_location,
+                                          timestamp,
+                                          allocMetric->sampling_set,
+                                          total_allocated_memory );
+    SCOREP_ATOMIC_FETCH_SUB( &allocMetric->total_allocated_memory, released,
+                             SCOREP_ATOMIC_RELAXED );
+
+    SCOREP_Location_ReleasePerProcessMetricsLocation();
+
+    return total_allocated_memory;
+}
+
+
+/* Same as trigger_total_allocated_memory for the process total, without
+ * triggering a metric */
+static uint64_t
+update_process_allocated_memory( uint64_t change,
+                                 uint64_t released )
+{
+    uint64_t process_allocated_memory_save =
+        SCOREP_ATOMIC_FETCH_ADD( &process_allocated_memory, change,
+                                 SCOREP_ATOMIC_RELAXED ) + change;
+    SCOREP_ATOMIC_FETCH_SUB( &process_allocated_memory, released,
+                             SCOREP_ATOMIC_RELAXED );
+    return process_allocated_memory_save;
+}
+
+
 void
 SCOREP_AllocMetric_AcquireAlloc( SCOREP_AllocMetric* allocMetric,
                                  uint64_t            addr,
                                  void**              allocation )
 {
-    SCOREP_MutexLock( allocMetric->mutex );
-
     UTILS_DEBUG_ENTRY( "%p", ( void* )addr );
 
     UTILS_BUG_ON( addr == 0, "Can't acquire allocation for NULL pointers." );
 
-    *allocation = find_memory_allocation( allocMetric, addr );
+    allocation_shard* shard = get_shard( allocMetric, addr );
+    lock_shard( shard );
+    *allocation = find_memory_allocation( shard, addr );
     if ( *allocation )
     {
-        remove_memory_allocation( allocMetric, *allocation );
+        remove_memory_allocation( shard, *allocation );
     }
-    else
+    unlock_shard( shard );
+
+    if ( !*allocation )
     {
         UTILS_WARNING( "Could not find allocation %p.",
                        ( void* )addr );
     }
 
     UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, allocMetric->total_allocated_memory );
-
-    SCOREP_MutexUnlock( allocMetric->mutex );
 }
 
 
@@ -412,37 +511,22 @@ SCOREP_AllocMetric_HandleAlloc( SCOREP_AllocMetric* allocMetric,
                                 uint64_t            resultAddr,
                                 size_t              size )
 {
-    SCOREP_MutexLock( allocMetric->mutex );
-
     UTILS_DEBUG_ENTRY( "%p , %zu", ( void* )resultAddr, size );
 
-    SCOREP_MutexLock( process_allocated_memory_mutex );
-    process_allocated_memory += size;
-    uint64_t process_allocated_memory_save = process_allocated_memory;
-    SCOREP_MutexUnlock( process_allocated_memory_mutex );
+    uint64_t process_allocated_memory_save =
+        update_process_allocated_memory( size, 0 );
 
-    allocMetric->total_allocated_memory += size;
     allocation_item* allocation =
         add_memory_allocation( allocMetric, resultAddr, size );
 
-    /* We need to ensure, that we take the timestamp  *after* we acquired
-       the metric location, else we may end up with an invalid timestamp order */
-    uint64_t         timestamp;
-    SCOREP_Location* per_process_metric_location =
-        SCOREP_Location_AcquirePerProcessMetricsLocation( &timestamp );
-    SCOREP_Location_TriggerCounterUint64( per_process_metric_location,
-                                          timestamp,
-                                          allocMetric->sampling_set,
-                                          allocMetric->total_allocated_memory );
-    SCOREP_Location_ReleasePerProcessMetricsLocation();
+    uint64_t total_allocated_memory_save =
+        trigger_total_allocated_memory( allocMetric, size, 0 );
 
     SCOREP_TrackAlloc( resultAddr, size, allocation->substrate_data,
-                       allocMetric->total_allocated_memory,
+                       total_allocated_memory_save,
                        process_allocated_memory_save );
 
-    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, allocMetric->total_allocated_memory );
-
-    SCOREP_MutexUnlock( allocMetric->mutex );
+    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, total_allocated_memory_save );
 }
 
 
@@ -453,14 +537,13 @@ SCOREP_AllocMetric_HandleRealloc( SCOREP_AllocMetric* allocMetric,
                                   void*               prevAllocation,
                                   uint64_t*           prevSize )
 {
-    SCOREP_MutexLock( allocMetric->mutex );
-
     UTILS_DEBUG_ENTRY( "%p , %zu, %p", ( void* )resultAddr, size, prevAllocation );
 
     uint64_t total_allocated_memory_save;
     uint64_t process_allocated_memory_save;
 
-    /* get the handle of the previously allocated memory */
+    /* get the handle of the previously allocated memory, it was already
+     * removed from the shards by SCOREP_AllocMetric_AcquireAlloc */
     allocation_item* allocation = prevAllocation;
     if ( allocation )
     {
@@ -475,21 +558,10 @@ SCOREP_AllocMetric_HandleRealloc( SCOREP_AllocMetric* allocMetric,
          * the new size to the handle. */
         if ( allocation->address == resultAddr )
         {
-            SCOREP_MutexLock( process_allocated_memory_mutex );
-            process_allocated_memory     += ( size - allocation->size );
-            process_allocated_memory_save = process_allocated_memory;
-            SCOREP_MutexUnlock( process_allocated_memory_mutex );
-
-            allocMetric->total_allocated_memory += ( size - allocation->size );
-            total_allocated_memory_save          = allocMetric->total_allocated_memory;
-
-            SCOREP_TrackRealloc( allocation->address, allocation->size, allocation->substrate_data,
-                                 resultAddr, size, allocation->substrate_data,
-                                 total_allocated_memory_save,
-                                 process_allocated_memory_save );
-
-            allocation->size = size;
-            insert_memory_allocation( allocMetric, allocation );
+            process_allocated_memory_save =
+                update_process_allocated_memory( size - allocation->size, 0 );
+            total_allocated_memory_save =
+                trigger_total_allocated_memory( allocMetric, size - allocation->size, 0 );
         }
         /* System allocates size before freeing allocation->size (actually,
          * a free(prevAddr) is done), report the memory usage after the allocation
@@ -497,25 +569,20 @@ SCOREP_AllocMetric_HandleRealloc( SCOREP_AllocMetric* allocMetric,
          * about freed_mem. */
         else
         {
-            SCOREP_MutexLock( process_allocated_memory_mutex );
-            process_allocated_memory     += size;
-            process_allocated_memory_save = process_allocated_memory;
-            process_allocated_memory     -= allocation->size;
-            SCOREP_MutexUnlock( process_allocated_memory_mutex );
-
-            allocMetric->total_allocated_memory += size;
-            total_allocated_memory_save          = allocMetric->total_allocated_memory;
-            allocMetric->total_allocated_memory -= allocation->size;
-
-            SCOREP_TrackRealloc( allocation->address, allocation->size, allocation->substrate_data,
-                                 resultAddr, size, allocation->substrate_data,
-                                 total_allocated_memory_save,
-                                 process_allocated_memory_save );
-
-            allocation->address = resultAddr;
-            allocation->size    = size;
-            insert_memory_allocation( allocMetric, allocation );
+            process_allocated_memory_save =
+                update_process_allocated_memory( size, allocation->size );
+            total_allocated_memory_save =
+                trigger_total_allocated_memory( allocMetric, size, allocation->size );
         }
+
+        SCOREP_TrackRealloc( allocation->address, allocation->size, allocation->substrate_data,
+                             resultAddr, size, allocation->substrate_data,
+                             total_allocated_memory_save,
+                             process_allocated_memory_save );
+
+        allocation->address = resultAddr;
+        allocation->size    = size;
+        publish_memory_allocation( allocMetric, allocation );
     }
     else
     {
@@ -526,34 +593,19 @@ SCOREP_AllocMetric_HandleRealloc( SCOREP_AllocMetric* allocMetric,
             *prevSize = 0;
         }
 
-        SCOREP_MutexLock( process_allocated_memory_mutex );
-        process_allocated_memory     += size;
-        process_allocated_memory_save = process_allocated_memory;
-        SCOREP_MutexUnlock( process_allocated_memory_mutex );
-
-        allocMetric->total_allocated_memory += size;
-        total_allocated_memory_save          = allocMetric->total_allocated_memory;
+        process_allocated_memory_save = update_process_allocated_memory( size, 0 );
 
         allocation = add_memory_allocation( allocMetric, resultAddr, size );
+
+        total_allocated_memory_save =
+            trigger_total_allocated_memory( allocMetric, size, 0 );
+
         SCOREP_TrackAlloc( resultAddr, size, allocation->substrate_data,
                            total_allocated_memory_save,
                            process_allocated_memory_save );
     }
 
-    /* We need to ensure, that we take the timestamp  *after* we acquired
-       the metric location, else we may end up with an invalid timestamp order */
-    uint64_t         timestamp;
-    SCOREP_Location* per_process_metric_location =
-        SCOREP_Location_AcquirePerProcessMetricsLocation( &timestamp );
-    SCOREP_Location_TriggerCounterUint64( per_process_metric_location,
-                                          timestamp,
-                                          allocMetric->sampling_set,
-                                          total_allocated_memory_save );
-    SCOREP_Location_ReleasePerProcessMetricsLocation();
-
-    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, allocMetric->total_allocated_memory );
-
-    SCOREP_MutexUnlock( allocMetric->mutex );
+    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, total_allocated_memory_save );
 }
 
 
@@ -562,8 +614,6 @@ SCOREP_AllocMetric_HandleFree( SCOREP_AllocMetric* allocMetric,
                                void*               allocation_,
                                uint64_t*           size )
 {
-    SCOREP_MutexLock( allocMetric->mutex );
-
     UTILS_DEBUG_ENTRY( "%p", allocation_ );
 
     allocation_item* allocation = allocation_;
@@ -576,35 +626,28 @@ SCOREP_AllocMetric_HandleFree( SCOREP_AllocMetric* allocMetric,
             *size = 0;
         }
 
-        SCOREP_MutexUnlock( allocMetric->mutex );
         return;
     }
 
     uint64_t allocation_addr   = allocation->address;
     uint64_t deallocation_size = allocation->size;
 
-    SCOREP_MutexLock( process_allocated_memory_mutex );
-    process_allocated_memory -= deallocation_size;
-    uint64_t process_allocated_memory_save = process_allocated_memory;
-    SCOREP_MutexUnlock( process_allocated_memory_mutex );
-
-    allocMetric->total_allocated_memory -= deallocation_size;
+    uint64_t process_allocated_memory_save =
+        update_process_allocated_memory( -deallocation_size, 0 );
 
     void* substrate_data[ SCOREP_SUBSTRATES_NUM_SUBSTRATES ];
     memcpy( substrate_data, allocation->substrate_data,
             SCOREP_SUBSTRATES_NUM_SUBSTRATES * sizeof( void* ) );
-    free_memory_allocation( allocMetric, allocation );
 
-    /* We need to ensure, that we take the timestamp  *after* we acquired
-       the metric location, else we may end up with an invalid timestamp order */
-    uint64_t         timestamp;
-    SCOREP_Location* per_process_metric_location =
-        SCOREP_Location_AcquirePerProcessMetricsLocation( &timestamp );
-    SCOREP_Location_TriggerCounterUint64( per_process_metric_location,
-                                          timestamp,
-                                          allocMetric->sampling_set,
-                                          allocMetric->total_allocated_memory );
-    SCOREP_Location_ReleasePerProcessMetricsLocation();
+    /* The item goes to the free list of the shard of its address, which
+     * may be a different one than it was allocated from */
+    allocation_shard* shard = get_shard( allocMetric, allocation_addr );
+    lock_shard( shard );
+    free_memory_allocation( shard, allocation );
+    unlock_shard( shard );
+
+    uint64_t total_allocated_memory_save =
+        trigger_total_allocated_memory( allocMetric, -deallocation_size, 0 );
 
     if ( size )
     {
@@ -612,30 +655,34 @@ SCOREP_AllocMetric_HandleFree( SCOREP_AllocMetric* allocMetric,
     }
 
     SCOREP_TrackFree( allocation_addr, deallocation_size, substrate_data,
-                      allocMetric->total_allocated_memory,
+                      total_allocated_memory_save,
                       process_allocated_memory_save );
 
-    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, allocMetric->total_allocated_memory );
-
-    SCOREP_MutexUnlock( allocMetric->mutex );
+    UTILS_DEBUG_EXIT( "Total Memory: %" PRIu64, total_allocated_memory_save );
 }
 
 
 void
 SCOREP_AllocMetric_ReportLeaked( SCOREP_AllocMetric* allocMetric )
 {
-    /* walk through tree, every item represents leaked memory */
-    while ( allocMetric->allocations != NULL )
+    for ( uint32_t i = 0; i < NUMBER_OF_SHARDS; i++ )
     {
-        allocation_item* node = allocMetric->allocations;
+        allocation_shard* shard = &allocMetric->shards[ i ].shard;
 
-        UTILS_DEBUG( "[leaked] ptr %p, size %zu",
-                     ( void* )( node->address ), node->size );
+        /* walk through tree, every item represents leaked memory */
+        while ( shard->allocations != NULL )
+        {
+            allocation_item* node = shard->allocations;
+
+            UTILS_DEBUG( "[leaked] ptr %p, size %zu",
+                         ( void* )( node->address ), node->size );
 
-        SCOREP_LeakedMemory( node->address,
-                             node->size,
-                             node->substrate_data );
-        delete_memory_allocation( allocMetric, node );
+            SCOREP_LeakedMemory( node->address,
+                                 node->size,
+                                 node->substrate_data );
+            remove_memory_allocation( shard, node );
+            free_memory_allocation( shard, node );
+        }
     }
 }
 
@@ -35,9 +35,10 @@
  *
  * Maintains the internal filter rules and performs the pattern matching requests.
  * We maintain two rule lists: One for the function name rules and one for the
- * file name rules. Due to the possible include/exclude
- * combinations, the rules must be evaluated in sequential order. Thus, the use of a
- * single linked list it sufficient.
+ * file name rules. Due to the possible include/exclude combinations, the rules
+ * must be evaluated in sequential order, which means that the last matching
+ * rule decides. Instead of evaluating every rule with fnmatch, the rules are
+ * compiled into matchers while they are added, see scorep_filter_matcher_t.
  */
 
 #include <config.h>
@@ -63,58 +64,590 @@
  */
 struct scorep_filter_rule_struct
 {
-    char*                 pattern;    /**< Pointer to the pattern string */
-    bool                  is_mangled; /**< Apply this rule on the mangled name */
-    bool                  is_exclude; /**< True if it is a exclude rule, false else */
-    scorep_filter_rule_t* next;       /**< Next filter rule */
+    char* pattern;                    /**< Pointer to the pattern string */
+    bool  is_mangled;                 /**< Apply this rule on the mangled name */
+    bool  is_exclude;                 /**< True if it is a exclude rule, false else */
+};
+
+/**
+ * Rule without wildcards, or with a trailing '*' only.
+ */
+struct scorep_filter_literal_struct
+{
+    const char* literal;              /**< Points into the rule's pattern, NULL if unused */
+    size_t      length;               /**< Length of the literal, without the '*' */
+    uint32_t    hash;
+    bool        is_prefix;            /**< Whether the pattern ends with '*' */
+    uint32_t    rule;                 /**< Index of the last rule with this pattern */
+};
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME        16777619u
+
+#define NO_STATE         UINT32_MAX
+#define NO_OUTPUT        UINT32_MAX
+
+/**
+ * Edge of the automaton, stored in a hash table keyed by the source state
+ * and the input byte.
+ */
+typedef struct
+{
+    uint32_t key;                     /**< state * 256 + byte + 1, 0 if unused */
+    uint32_t target;
+} scorep_filter_edge_t;
+
+/**
+ * Output of the automaton, a wildcard rule whose literal part ends in this
+ * state.
+ */
+typedef struct
+{
+    uint32_t rule;
+    uint32_t next;                    /**< next output of the same state */
+} scorep_filter_output_t;
+
+struct scorep_filter_automaton_struct
+{
+    uint32_t                number_of_states;
+    uint32_t*               fail;         /**< longest proper suffix state */
+    uint32_t*               first_output; /**< per state, NO_OUTPUT if none */
+    uint32_t*               output_link;  /**< next suffix state with outputs, 0 if none */
+    scorep_filter_edge_t*   edges;
+    uint32_t                edge_capacity;
+    scorep_filter_output_t* outputs;
+    /** Wildcard rules without literal part, which are candidates for every name */
+    uint32_t*               unconditional_rules;
+    uint32_t                number_of_unconditional_rules;
 };
 
 /* **************************************************************************************
    Rule representation manipulation functions
 ****************************************************************************************/
 
+static void
+free_automaton( scorep_filter_automaton_t* automaton );
+
+static uint32_t
+hash_literal( const char* literal,
+              size_t      length )
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for ( size_t i = 0; i < length; i++ )
+    {
+        hash = ( hash ^ ( unsigned char )literal[ i ] ) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool
+is_literal( const char* pattern,
+            size_t      length )
+{
+    for ( size_t i = 0; i < length; i++ )
+    {
+        switch ( pattern[ i ] )
+        {
+            case '*':
+            case '?':
+            case '[':
+            case '\\':
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns false, if a literal with the same pattern was already in @a literals.
+ */
+static bool
+insert_literal( scorep_filter_literal_t* literals,
+                uint32_t                 capacity,
+                scorep_filter_literal_t* literal )
+{
+    uint32_t slot = literal->hash & ( capacity - 1 );
+    while ( literals[ slot ].literal )
+    {
+        scorep_filter_literal_t* entry = &literals[ slot ];
+        if ( entry->hash == literal->hash
+             && entry->length == literal->length
+             && entry->is_prefix == literal->is_prefix
+             && memcmp( entry->literal, literal->literal, literal->length ) == 0 )
+        {
+            /* Same pattern as an earlier rule, the later one decides */
+            entry->rule = literal->rule;
+            return false;
+        }
+        slot = ( slot + 1 ) & ( capacity - 1 );
+    }
+    literals[ slot ] = *literal;
+    return true;
+}
+
+static SCOREP_ErrorCode
+add_literal( scorep_filter_matcher_t* matcher,
+             const char*              pattern,
+             size_t                   length,
+             bool                     isPrefix,
+             uint32_t                 rule )
+{
+    /* Keep the load factor below 0.5 */
+    if ( 2 * ( matcher->number_of_literals + 1 ) > matcher->literal_capacity )
+    {
+        uint32_t                 capacity = matcher->literal_capacity ? 2 * matcher->literal_capacity : 64;
+        scorep_filter_literal_t* literals = calloc( capacity, sizeof( *literals ) );
+        if ( literals == NULL )
+        {
+            UTILS_ERROR_POSIX( "Failed to allocate memory for filter rule." );
+            return SCOREP_ERROR_MEM_ALLOC_FAILED;
+        }
+        for ( uint32_t i = 0; i < matcher->literal_capacity; i++ )
+        {
+            if ( matcher->literals[ i ].literal )
+            {
+                insert_literal( literals, capacity, &matcher->literals[ i ] );
+            }
+        }
+        free( matcher->literals );
+        matcher->literals         = literals;
+        matcher->literal_capacity = capacity;
+    }
+
+    if ( isPrefix && length >= matcher->max_prefix_length )
+    {
+        bool* prefix_lengths = realloc( matcher->prefix_lengths,
+                                        ( length + 1 ) * sizeof( *prefix_lengths ) );
+        if ( prefix_lengths == NULL )
+        {
+            UTILS_ERROR_POSIX( "Failed to allocate memory for filter rule." );
+            return SCOREP_ERROR_MEM_ALLOC_FAILED;
+        }
+        memset( prefix_lengths + matcher->max_prefix_length, 0,
+                ( length + 1 - matcher->max_prefix_length ) * sizeof( *prefix_lengths ) );
+        matcher->prefix_lengths    = prefix_lengths;
+        matcher->max_prefix_length = length + 1;
+    }
+    if ( isPrefix )
+    {
+        matcher->prefix_lengths[ length ] = true;
+    }
+
+    scorep_filter_literal_t literal = {
+        .literal   = pattern,
+        .length    = length,
+        .hash      = hash_literal( pattern, length ),
+        .is_prefix = isPrefix,
+        .rule      = rule
+    };
+    if ( insert_literal( matcher->literals, matcher->literal_capacity, &literal ) )
+    {
+        matcher->number_of_literals++;
+    }
+
+    return SCOREP_SUCCESS;
+}
+
+static SCOREP_ErrorCode
+add_wildcard_rule( scorep_filter_matcher_t* matcher,
+                   uint32_t                 rule )
+{
+    if ( matcher->number_of_wildcard_rules == matcher->wildcard_capacity )
+    {
+        uint32_t  capacity       = matcher->wildcard_capacity ? 2 * matcher->wildcard_capacity : 16;
+        uint32_t* wildcard_rules = realloc( matcher->wildcard_rules,
+                                            capacity * sizeof( *wildcard_rules ) );
+        if ( wildcard_rules == NULL )
+        {
+            UTILS_ERROR_POSIX( "Failed to allocate memory for filter rule." );
+            return SCOREP_ERROR_MEM_ALLOC_FAILED;
+        }
+        matcher->wildcard_rules    = wildcard_rules;
+        matcher->wildcard_capacity = capacity;
+    }
+    matcher->wildcard_rules[ matcher->number_of_wildcard_rules++ ] = rule;
+    return SCOREP_SUCCESS;
+}
+
 SCOREP_ErrorCode
-scorep_filter_add_rule( scorep_filter_rule_t*** tail,
-                        const char*             rule,
-                        bool                    is_exclude,
-                        bool                    is_mangled )
+scorep_filter_add_rule( scorep_filter_rules_t* rules,
+                        const char*            rule,
+                        bool                   is_exclude,
+                        bool                   is_mangled )
 {
     if ( !rule || !rule[ 0 ] )
     {
-        return SCOREP_ERROR_INVALID_ARGUMENT;
+        return UTILS_ERROR( SCOREP_ERROR_INVALID_ARGUMENT,
+                            "Empty filter rule." );
     }
 
     /* Create new rule entry */
-    scorep_filter_rule_t* new_rule = calloc( 1, sizeof( *new_rule ) );
-    if ( new_rule == NULL )
+    if ( rules->number_of_rules == rules->capacity )
+    {
+        uint32_t              capacity  = rules->capacity ? 2 * rules->capacity : 16;
+        scorep_filter_rule_t* new_rules = realloc( rules->rules,
+                                                   capacity * sizeof( *new_rules ) );
+        if ( new_rules == NULL )
+        {
+            UTILS_ERROR_POSIX( "Failed to allocate memory for filter rule." );
+            return SCOREP_ERROR_MEM_ALLOC_FAILED;
+        }
+        rules->rules    = new_rules;
+        rules->capacity = capacity;
+    }
+
+    uint32_t              index    = rules->number_of_rules;
+    scorep_filter_rule_t* new_rule = &rules->rules[ index ];
+    new_rule->pattern = UTILS_CStr_dup( rule );
+    if ( new_rule->pattern == NULL )
     {
         UTILS_ERROR_POSIX( "Failed to allocate memory for filter rule." );
         return SCOREP_ERROR_MEM_ALLOC_FAILED;
     }
-
-    new_rule->pattern    = UTILS_CStr_dup( rule );
     new_rule->is_mangled = is_mangled;
     new_rule->is_exclude = is_exclude;
-    new_rule->next       = NULL;
+    rules->number_of_rules++;
+
+    /* 'INCLUDE *' matches everything, but does not explicitly include */
+    if ( !is_exclude && strcmp( rule, "*" ) == 0 )
+    {
+        rules->include_all = index + 1;
+        return SCOREP_SUCCESS;
+    }
+
+    scorep_filter_matcher_t* matcher = is_mangled ? &rules->mangled_matcher : &rules->matcher;
+    size_t                   length  = strlen( rule );
+
+    /* The automaton does not know this rule */
+    free_automaton( matcher->automaton );
+    matcher->automaton = NULL;
+
+    if ( is_literal( new_rule->pattern, length ) )
+    {
+        return add_literal( matcher, new_rule->pattern, length, false, index );
+    }
+    if ( new_rule->pattern[ length - 1 ] == '*'
+         && is_literal( new_rule->pattern, length - 1 ) )
+    {
+        return add_literal( matcher, new_rule->pattern, length - 1, true, index );
+    }
+    return add_wildcard_rule( matcher, index );
+}
+
+/**
+ * Returns the position behind the ']' which closes the bracket expression
+ * starting at @a p, just behind its '['. Returns NULL if the bracket
+ * expression is not closed.
+ */
+static const char*
+skip_bracket( const char* p )
+{
+    if ( *p == '!' || *p == '^' )
+    {
+        p++;
+    }
+    /* A ']' right after the opening bracket or negation is part of the set */
+    if ( *p == ']' )
+    {
+        p++;
+    }
+    while ( *p && *p != ']' )
+    {
+        if ( *p == '[' && ( p[ 1 ] == ':' || p[ 1 ] == '=' || p[ 1 ] == '.' ) )
+        {
+            /* A character class, equivalence class, or collating symbol
+               may contain a ']', it ends with the delimiter and ']' */
+            char        delimiter = p[ 1 ];
+            const char* end       = p + 2;
+            while ( *end && !( end[ 0 ] == delimiter && end[ 1 ] == ']' ) )
+            {
+                end++;
+            }
+            if ( *end )
+            {
+                p = end + 2;
+                continue;
+            }
+        }
+        else if ( *p == '\\' && p[ 1 ] )
+        {
+            p++;
+        }
+        p++;
+    }
+    return *p == ']' ? p + 1 : NULL;
+}
+
+/**
+ * Stores the longest run of literal characters in @a pattern, without escape
+ * characters, in @a literal and returns its length. @a literal needs to be as
+ * large as @a pattern.
+ */
+static size_t
+longest_literal( const char* pattern,
+                 char*       literal )
+{
+    size_t      longest = 0;
+    size_t      length  = 0;
+    char*       current = literal;
+    const char* p       = pattern;
+    while ( *p )
+    {
+        char c = *p++;
+        if ( c == '\\' && *p )
+        {
+            c = *p++;
+        }
+        else if ( c == '*' || c == '?' || c == '[' )
+        {
+            if ( c == '[' )
+            {
+                const char* end = skip_bracket( p );
+                if ( end )
+                {
+                    p = end;
+                }
+                /* else, the '[' is matched literally by fnmatch, but treating
+                   it as wildcard is safe */
+            }
+            length  = 0;
+            current = literal + longest + 1;
+            continue;
+        }
+
+        if ( length == 0 )
+        {
+            /* Start a new run behind the longest so far */
+            current = literal + longest;
+        }
+        current[ length++ ] = c;
+        if ( length > longest )
+        {
+            /* The current run is the longest now, move it to the front */
+            memmove( literal, current, length );
+            current = literal;
+            longest = length;
+        }
+    }
+    return longest;
+}
+
+static uint32_t
+edge_slot( const scorep_filter_automaton_t* automaton,
+           uint32_t                         key )
+{
+    uint32_t mask = automaton->edge_capacity - 1;
+    uint32_t slot = ( key * 2654435761u ) & mask;
+    while ( automaton->edges[ slot ].key != 0 && automaton->edges[ slot ].key != key )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+static inline uint32_t
+edge_target( const scorep_filter_automaton_t* automaton,
+             uint32_t                         state,
+             unsigned char                    c )
+{
+    uint32_t key  = state * 256 + c + 1;
+    uint32_t slot = edge_slot( automaton, key );
+    return automaton->edges[ slot ].key ? automaton->edges[ slot ].target : NO_STATE;
+}
+
+static SCOREP_ErrorCode
+compile_matcher( const scorep_filter_rules_t* rules,
+                 scorep_filter_matcher_t*     matcher )
+{
+    free_automaton( matcher->automaton );
+    matcher->automaton = NULL;
+    if ( matcher->number_of_wildcard_rules == 0 )
+    {
+        return SCOREP_SUCCESS;
+    }
+
+    /* The trie has at most one state per pattern character plus the root */
+    size_t max_states = 1;
+    size_t max_length = 0;
+    for ( uint32_t i = 0; i < matcher->number_of_wildcard_rules; i++ )
+    {
+        size_t length = strlen( rules->rules[ matcher->wildcard_rules[ i ] ].pattern );
+        max_states += length;
+        if ( length > max_length )
+        {
+            max_length = length;
+        }
+    }
+    uint32_t edge_capacity = 64;
+    while ( edge_capacity < 2 * max_states )
+    {
+        edge_capacity *= 2;
+    }
+    if ( max_states >= UINT32_MAX / 256 )
+    {
+        return UTILS_ERROR( SCOREP_ERROR_INVALID_ARGUMENT,
+                            "Wildcard filter patterns too long to compile, "
+                            "%zu characters in total.",
+                            max_states - 1 );
+    }
+
+    scorep_filter_automaton_t* automaton = calloc( 1, sizeof( *automaton ) );
+    char*                      literal   = malloc( max_length + 1 );
+    /* Per state for building: first child and next sibling in the trie */
+    uint32_t*      first_child  = malloc( max_states * sizeof( *first_child ) );
+    uint32_t*      next_sibling = malloc( max_states * sizeof( *next_sibling ) );
+    unsigned char* label        = malloc( max_states * sizeof( *label ) );
+    uint32_t*      queue        = malloc( max_states * sizeof( *queue ) );
+    if ( automaton )
+    {
+        automaton->fail                = calloc( max_states, sizeof( *automaton->fail ) );
+        automaton->first_output        = malloc( max_states * sizeof( *automaton->first_output ) );
+        automaton->output_link         = calloc( max_states, sizeof( *automaton->output_link ) );
+        automaton->edges               = calloc( edge_capacity, sizeof( *automaton->edges ) );
+        automaton->outputs             = malloc( matcher->number_of_wildcard_rules * sizeof( *automaton->outputs ) );
+        automaton->unconditional_rules = malloc( matcher->number_of_wildcard_rules * sizeof( *automaton->unconditional_rules ) );
+        automaton->edge_capacity       = edge_capacity;
+    }
+    if ( !automaton || !literal || !first_child || !next_sibling || !label || !queue
+         || !automaton->fail || !automaton->first_output || !automaton->output_link
+         || !automaton->edges || !automaton->outputs || !automaton->unconditional_rules )
+    {
+        UTILS_ERROR_POSIX( "Failed to allocate memory for filter rules." );
+        free_automaton( automaton );
+        free( literal );
+        free( first_child );
+        free( next_sibling );
+        free( label );
+        free( queue );
+        return SCOREP_ERROR_MEM_ALLOC_FAILED;
+    }
+
+    /* Build the trie of the literals */
+    automaton->number_of_states = 1;
+    automaton->first_output[ 0 ] = NO_OUTPUT;
+    first_child[ 0 ]             = NO_STATE;
+    uint32_t number_of_outputs = 0;
+    for ( uint32_t i = 0; i < matcher->number_of_wildcard_rules; i++ )
+    {
+        uint32_t rule   = matcher->wildcard_rules[ i ];
+        size_t   length = longest_literal( rules->rules[ rule ].pattern, literal );
+        if ( length == 0 )
+        {
+            automaton->unconditional_rules[ automaton->number_of_unconditional_rules++ ] = rule;
+            continue;
+        }
+
+        uint32_t state = 0;
+        for ( size_t j = 0; j < length; j++ )
+        {
+            uint32_t key  = state * 256 + ( unsigned char )literal[ j ] + 1;
+            uint32_t slot = edge_slot( automaton, key );
+            if ( automaton->edges[ slot ].key == 0 )
+            {
+                uint32_t new_state = automaton->number_of_states++;
+                automaton->first_output[ new_state ] = NO_OUTPUT;
+                first_child[ new_state ]             = NO_STATE;
+                next_sibling[ new_state ]            = first_child[ state ];
+                label[ new_state ]                   = literal[ j ];
+                first_child[ state ]                 = new_state;
+                automaton->edges[ slot ].key         = key;
+                automaton->edges[ slot ].target      = new_state;
+            }
+            state = automaton->edges[ slot ].target;
+        }
+
+        automaton->outputs[ number_of_outputs ].rule = rule;
+        automaton->outputs[ number_of_outputs ].next = automaton->first_output[ state ];
+        automaton->first_output[ state ]             = number_of_outputs++;
+    }
+
+    /* Compute the failure and output links in breadth-first order, thus the
+       links of all shorter states are known already. */
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    for ( uint32_t child = first_child[ 0 ]; child != NO_STATE; child = next_sibling[ child ] )
+    {
+        queue[ tail++ ] = child;
+    }
+    while ( head < tail )
+    {
+        uint32_t state = queue[ head++ ];
+        for ( uint32_t child = first_child[ state ]; child != NO_STATE; child = next_sibling[ child ] )
+        {
+            uint32_t fail = automaton->fail[ state ];
+            uint32_t target;
+            while ( ( target = edge_target( automaton, fail, label[ child ] ) ) == NO_STATE
+                    && fail != 0 )
+            {
+                fail = automaton->fail[ fail ];
+            }
+            fail                     = target == NO_STATE ? 0 : target;
+            automaton->fail[ child ] = fail;
+            automaton->output_link[ child ] =
+                automaton->first_output[ fail ] != NO_OUTPUT
+                ? fail
+                : automaton->output_link[ fail ];
+
+            queue[ tail++ ] = child;
+        }
+    }
 
-    **tail = new_rule;
-    *tail  = &new_rule->next;
+    free( literal );
+    free( first_child );
+    free( next_sibling );
+    free( label );
+    free( queue );
 
+    matcher->automaton = automaton;
     return SCOREP_SUCCESS;
 }
 
-void
-scorep_filter_free_rules( scorep_filter_rule_t* head )
+SCOREP_ErrorCode
+scorep_filter_compile_rules( scorep_filter_rules_t* rules )
+{
+    SCOREP_ErrorCode err = compile_matcher( rules, &rules->matcher );
+    if ( err != SCOREP_SUCCESS )
+    {
+        return err;
+    }
+    return compile_matcher( rules, &rules->mangled_matcher );
+}
+
+static void
+free_automaton( scorep_filter_automaton_t* automaton )
 {
-    /* Free function rules. */
-    while ( head )
+    if ( automaton )
     {
-        scorep_filter_rule_t* next = head->next;
+        free( automaton->fail );
+        free( automaton->first_output );
+        free( automaton->output_link );
+        free( automaton->edges );
+        free( automaton->outputs );
+        free( automaton->unconditional_rules );
+        free( automaton );
+    }
+}
 
-        free( head->pattern );
-        free( head );
-        head = next;
+static void
+free_matcher( scorep_filter_matcher_t* matcher )
+{
+    free_automaton( matcher->automaton );
+    free( matcher->literals );
+    free( matcher->prefix_lengths );
+    free( matcher->wildcard_rules );
+}
+
+void
+scorep_filter_free_rules( scorep_filter_rules_t* rules )
+{
+    for ( uint32_t i = 0; i < rules->number_of_rules; i++ )
+    {
+        free( rules->rules[ i ].pattern );
     }
+    free( rules->rules );
+    free_matcher( &rules->matcher );
+    free_matcher( &rules->mangled_matcher );
+    memset( rules, 0, sizeof( *rules ) );
 }
 
 
@@ -123,14 +656,41 @@ scorep_filter_free_rules( scorep_filter_rule_t* head )
    Matching requests
 ****************************************************************************************/
 
-static bool
-scorep_filter_match_file_rule( const char*                 with_path,
-                               const scorep_filter_rule_t* rule,
-                               SCOREP_ErrorCode*           err )
+static void
+find_literal( const scorep_filter_matcher_t* matcher,
+              const char*                    name,
+              size_t                         length,
+              uint32_t                       hash,
+              bool                           isPrefix,
+              int64_t*                       lastMatch )
 {
-    int error_value = fnmatch( rule->pattern, with_path, 0 );
+    uint32_t mask = matcher->literal_capacity - 1;
+    uint32_t slot = hash & mask;
+    while ( matcher->literals[ slot ].literal )
+    {
+        const scorep_filter_literal_t* entry = &matcher->literals[ slot ];
+        if ( entry->hash == hash
+             && entry->length == length
+             && entry->is_prefix == isPrefix
+             && memcmp( entry->literal, name, length ) == 0 )
+        {
+            if ( ( int64_t )entry->rule > *lastMatch )
+            {
+                *lastMatch = entry->rule;
+            }
+            return;
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+}
 
-    *err = SCOREP_SUCCESS;
+static bool
+match_wildcard_rule( const scorep_filter_rules_t* rules,
+                     uint32_t                     rule,
+                     const char*                  name,
+                     SCOREP_ErrorCode*            err )
+{
+    int error_value = fnmatch( rules->rules[ rule ].pattern, name, 0 );
     if ( error_value == 0 )
     {
         return true;
@@ -139,136 +699,298 @@ scorep_filter_match_file_rule( const char*                 with_path,
     {
         *err = UTILS_ERROR( SCOREP_ERROR_PROCESSED_WITH_FAULTS,
                             "Error in pattern matching during evaluation of filter rules"
-                            "with file '%s' and pattern '%s'. Disable filtering",
-                            with_path, rule->pattern );
-        return false;
+                            "with '%s' and pattern '%s'. Disable filtering",
+                            name, rules->rules[ rule ].pattern );
     }
     return false;
 }
 
-bool
-scorep_filter_match_file( const scorep_filter_rule_t* fileRules,
-                          const char*                 fileName,
-                          SCOREP_ErrorCode*           err )
+/**
+ * Matches the wildcard rules after @a lastMatch with fnmatch, from the last to
+ * the first.
+ */
+static int64_t
+scan_wildcard_rules( const scorep_filter_rules_t*   rules,
+                     const scorep_filter_matcher_t* matcher,
+                     const char*                    name,
+                     int64_t                        lastMatch,
+                     SCOREP_ErrorCode*              err )
 {
-    bool excluded = false;                      /* Start with all included */
-    *err = SCOREP_SUCCESS;
+    for ( uint32_t i = matcher->number_of_wildcard_rules; i-- > 0; )
+    {
+        uint32_t rule = matcher->wildcard_rules[ i ];
+        if ( ( int64_t )rule <= lastMatch )
+        {
+            break;
+        }
+        if ( match_wildcard_rule( rules, rule, name, err ) )
+        {
+            return rule;
+        }
+        if ( *err != SCOREP_SUCCESS )
+        {
+            break;
+        }
+    }
+    return lastMatch;
+}
 
-    if ( fileName )
+typedef struct
+{
+    uint32_t* rules;
+    uint32_t  size;
+    uint32_t  capacity;
+    uint32_t  buffer[ 64 ];
+} candidate_list;
+
+static bool
+add_candidate( candidate_list* candidates,
+               uint32_t        rule )
+{
+    if ( candidates->size == candidates->capacity )
     {
-        while ( fileRules )
+        uint32_t  capacity = 2 * candidates->capacity;
+        uint32_t* new_rules;
+        if ( candidates->rules == candidates->buffer )
         {
-            /* If included so far and we have an exclude rule */
-            if ( ( !excluded ) && fileRules->is_exclude )
+            new_rules = malloc( capacity * sizeof( *new_rules ) );
+            if ( new_rules )
             {
-                excluded = scorep_filter_match_file_rule( fileName,
-                                                          fileRules,
-                                                          err );
-                if ( *err != SCOREP_SUCCESS )
-                {
-                    return false;
-                }
+                memcpy( new_rules, candidates->buffer, sizeof( candidates->buffer ) );
             }
-            /* If excluded so far and we have an include rule */
-            else if ( excluded && ( !fileRules->is_exclude ) )
-            {
-                excluded = !scorep_filter_match_file_rule( fileName,
-                                                           fileRules,
-                                                           err );
+        }
+        else
+        {
+            new_rules = realloc( candidates->rules, capacity * sizeof( *new_rules ) );
+        }
+        if ( new_rules == NULL )
+        {
+            return false;
+        }
+        candidates->rules    = new_rules;
+        candidates->capacity = capacity;
+    }
+    candidates->rules[ candidates->size++ ] = rule;
+    return true;
+}
 
-                if ( *err != SCOREP_SUCCESS )
+static int
+compare_rules_descending( const void* a,
+                          const void* b )
+{
+    uint32_t rule_a = *( const uint32_t* )a;
+    uint32_t rule_b = *( const uint32_t* )b;
+    return rule_a < rule_b ? 1 : rule_a > rule_b ? -1 : 0;
+}
+
+/**
+ * Runs @a automaton over @a name to find the wildcard rules after @a lastMatch
+ * whose literal part occurs in @a name, and matches them with fnmatch from the
+ * last to the first.
+ */
+static int64_t
+find_last_wildcard_match( const scorep_filter_rules_t*   rules,
+                          const scorep_filter_matcher_t* matcher,
+                          const char*                    name,
+                          int64_t                        lastMatch,
+                          SCOREP_ErrorCode*              err )
+{
+    const scorep_filter_automaton_t* automaton = matcher->automaton;
+    candidate_list                   candidates;
+    candidates.rules    = candidates.buffer;
+    candidates.size     = 0;
+    candidates.capacity = sizeof( candidates.buffer ) / sizeof( candidates.buffer[ 0 ] );
+    bool complete = true;
+
+    for ( uint32_t i = 0; i < automaton->number_of_unconditional_rules; i++ )
+    {
+        if ( ( int64_t )automaton->unconditional_rules[ i ] > lastMatch )
+        {
+            complete &= add_candidate( &candidates, automaton->unconditional_rules[ i ] );
+        }
+    }
+
+    uint32_t state = 0;
+    for ( const char* p = name; *p; p++ )
+    {
+        unsigned char c = *p;
+        uint32_t      target;
+        while ( ( target = edge_target( automaton, state, c ) ) == NO_STATE && state != 0 )
+        {
+            state = automaton->fail[ state ];
+        }
+        state = target == NO_STATE ? 0 : target;
+
+        for ( uint32_t s = automaton->first_output[ state ] != NO_OUTPUT ? state : automaton->output_link[ state ];
+              s != 0;
+              s = automaton->output_link[ s ] )
+        {
+            for ( uint32_t o = automaton->first_output[ s ]; o != NO_OUTPUT; o = automaton->outputs[ o ].next )
+            {
+                if ( ( int64_t )automaton->outputs[ o ].rule > lastMatch )
                 {
-                    return false;
+                    complete &= add_candidate( &candidates, automaton->outputs[ o ].rule );
                 }
             }
-
-            fileRules = fileRules->next;
         }
     }
 
-    if ( excluded )
+    if ( !complete )
     {
-        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_FILTERING,
-                            "Filtered file %s\n", fileName );
+        /* Out of memory for the candidates */
+        lastMatch = scan_wildcard_rules( rules, matcher, name, lastMatch, err );
+    }
+    else
+    {
+        qsort( candidates.rules, candidates.size, sizeof( *candidates.rules ),
+               compare_rules_descending );
+        for ( uint32_t i = 0; i < candidates.size; i++ )
+        {
+            if ( i > 0 && candidates.rules[ i ] == candidates.rules[ i - 1 ] )
+            {
+                continue;
+            }
+            if ( match_wildcard_rule( rules, candidates.rules[ i ], name, err ) )
+            {
+                lastMatch = candidates.rules[ i ];
+                break;
+            }
+            if ( *err != SCOREP_SUCCESS )
+            {
+                break;
+            }
+        }
     }
 
-    return excluded;
+    if ( candidates.rules != candidates.buffer )
+    {
+        free( candidates.rules );
+    }
+    return lastMatch;
 }
 
-static bool
-scorep_filter_match_function_rule( const char*                 functionName,
-                                   const char*                 mangledName,
-                                   const scorep_filter_rule_t* rule,
-                                   SCOREP_ErrorCode*           err )
+/**
+ * Returns the index of the last rule in @a matcher, which matches @a name, if
+ * it comes after @a lastMatch, else @a lastMatch.
+ */
+static int64_t
+find_last_match( const scorep_filter_rules_t*   rules,
+                 const scorep_filter_matcher_t* matcher,
+                 const char*                    name,
+                 int64_t                        lastMatch,
+                 SCOREP_ErrorCode*              err )
 {
-    int error_value = 0;
-    if ( rule->is_mangled && ( mangledName != NULL ) )
+    if ( matcher->number_of_literals )
     {
-        error_value = fnmatch( rule->pattern, mangledName, 0 );
+        /* Probe all prefixes of name for which a prefix rule exists, and finally
+           the whole name, while hashing it once. */
+        uint32_t hash   = FNV_OFFSET_BASIS;
+        size_t   length = 0;
+        while ( true )
+        {
+            if ( length < matcher->max_prefix_length
+                 && matcher->prefix_lengths[ length ] )
+            {
+                find_literal( matcher, name, length, hash, true, &lastMatch );
+            }
+            if ( name[ length ] == '\0' )
+            {
+                break;
+            }
+            hash = ( hash ^ ( unsigned char )name[ length ] ) * FNV_PRIME;
+            length++;
+        }
+        find_literal( matcher, name, length, hash, false, &lastMatch );
     }
-    else
+
+    /* Only wildcard rules after the last match can change the result */
+    if ( matcher->automaton )
     {
-        error_value = fnmatch( rule->pattern, functionName, 0 );
+        return find_last_wildcard_match( rules, matcher, name, lastMatch, err );
     }
+    return scan_wildcard_rules( rules, matcher, name, lastMatch, err );
+}
 
+bool
+scorep_filter_match_file( const scorep_filter_rules_t* fileRules,
+                          const char*                  fileName,
+                          SCOREP_ErrorCode*            err )
+{
+    bool excluded = false;                      /* Start with all included */
     *err = SCOREP_SUCCESS;
-    if ( error_value == 0 )
+
+    if ( fileName )
     {
-        return true;
+        int64_t last_match = find_last_match( fileRules,
+                                              &fileRules->matcher,
+                                              fileName,
+                                              ( int64_t )fileRules->include_all - 1,
+                                              err );
+        if ( *err != SCOREP_SUCCESS )
+        {
+            return false;
+        }
+        excluded = last_match >= 0 && fileRules->rules[ last_match ].is_exclude;
     }
-    else if ( error_value != FNM_NOMATCH )
+
+    if ( excluded )
     {
-        *err = UTILS_ERROR( SCOREP_ERROR_PROCESSED_WITH_FAULTS,
-                            "Error in pattern matching during evaluation of filter rules"
-                            "with file '%s' and pattern '%s'. Disable filtering",
-                            functionName, rule->pattern );
-        return false;
+        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_FILTERING,
+                            "Filtered file %s\n", fileName );
     }
-    return false;
+
+    return excluded;
+}
+
+/**
+ * Returns the index of the last function rule that matches, or -1.
+ */
+static int64_t
+find_last_function_match( const scorep_filter_rules_t* functionRules,
+                          const char*                  functionName,
+                          const char*                  mangledName,
+                          int64_t                      lastMatch,
+                          SCOREP_ErrorCode*            err )
+{
+    lastMatch = find_last_match( functionRules,
+                                 &functionRules->matcher,
+                                 functionName,
+                                 lastMatch,
+                                 err );
+    if ( *err != SCOREP_SUCCESS )
+    {
+        return lastMatch;
+    }
+
+    /* Mangled rules apply to the demangled name, if there is no mangled name */
+    return find_last_match( functionRules,
+                            &functionRules->mangled_matcher,
+                            mangledName ? mangledName : functionName,
+                            lastMatch,
+                            err );
 }
 
 bool
-scorep_filter_match_function( const scorep_filter_rule_t* functionRules,
-                              const char*                 functionName,
-                              const char*                 mangledName,
-                              SCOREP_ErrorCode*           err )
+scorep_filter_match_function( const scorep_filter_rules_t* functionRules,
+                              const char*                  functionName,
+                              const char*                  mangledName,
+                              SCOREP_ErrorCode*            err )
 {
     bool excluded = false;                      /* Start with all included */
     *err = SCOREP_SUCCESS;
 
     if ( functionName )
     {
-        while ( functionRules )
+        int64_t last_match = find_last_function_match( functionRules,
+                                                       functionName,
+                                                       mangledName,
+                                                       ( int64_t )functionRules->include_all - 1,
+                                                       err );
+        if ( *err != SCOREP_SUCCESS )
         {
-            /* If included so far and we have an exclude rule */
-            if ( ( !excluded ) && functionRules->is_exclude )
-            {
-                excluded = scorep_filter_match_function_rule( functionName,
-                                                              mangledName,
-                                                              functionRules,
-                                                              err );
-
-                if ( *err != SCOREP_SUCCESS )
-                {
-                    return false;
-                }
-            }
-            /* If excluded so far and we have an include rule */
-            else if ( excluded && ( !functionRules->is_exclude ) )
-            {
-                excluded = !scorep_filter_match_function_rule( functionName,
-                                                               mangledName,
-                                                               functionRules,
-                                                               err );
-
-                if ( *err != SCOREP_SUCCESS )
-                {
-                    return false;
-                }
-            }
-
-            functionRules = functionRules->next;
+            return false;
         }
+        excluded = last_match >= 0 && functionRules->rules[ last_match ].is_exclude;
     }
 
     if ( excluded )
@@ -281,13 +1003,11 @@ scorep_filter_match_function( const scorep_filter_rule_t* functionRules,
 }
 
 bool
-scorep_filter_include_function( const scorep_filter_rule_t* functionRules,
-                                const char*                 functionName,
-                                const char*                 mangledName,
-                                SCOREP_ErrorCode*           err )
+scorep_filter_include_function( const scorep_filter_rules_t* functionRules,
+                                const char*                  functionName,
+                                const char*                  mangledName,
+                                SCOREP_ErrorCode*            err )
 {
-    bool excluded            = false;           /* Start with all included */
-    bool explicitly_included = false;
     *err = SCOREP_SUCCESS;
 
     if ( !functionName )
@@ -295,54 +1015,25 @@ scorep_filter_include_function( const scorep_filter_rule_t* functionRules,
         return true;
     }
 
-    while ( functionRules )
+    /* 'INCLUDE *' rules neither exclude nor explicitly include, thus only the
+       last other matching rule decides. */
+    int64_t last_match = find_last_function_match( functionRules,
+                                                   functionName,
+                                                   mangledName,
+                                                   -1,
+                                                   err );
+    if ( *err != SCOREP_SUCCESS )
     {
-        bool matched = scorep_filter_match_function_rule( functionName,
-                                                          mangledName,
-                                                          functionRules,
-                                                          err );
-
-        if ( matched )
-        {
-            if ( functionRules->is_exclude )
-            {
-                explicitly_included = false;
-            }
-            else if ( 0 != strcmp( functionRules->pattern, "*" ) )
-            {
-                explicitly_included = true;
-            }
-        }
-
-        /* If included so far and we have an exclude rule */
-        if ( ( !excluded ) && functionRules->is_exclude )
-        {
-            excluded = matched;
-
-            if ( *err != SCOREP_SUCCESS )
-            {
-                return true;
-            }
-        }
-        /* If excluded so far and we have an include rule */
-        else if ( excluded && ( !functionRules->is_exclude ) )
-        {
-            excluded = !matched;
-
-            if ( *err != SCOREP_SUCCESS )
-            {
-                return true;
-            }
-        }
-
-        functionRules = functionRules->next;
+        return true;
     }
 
-    if ( excluded )
+    bool explicitly_included = last_match >= 0
+                               && !functionRules->rules[ last_match ].is_exclude;
+    if ( !explicitly_included && last_match >= ( int64_t )functionRules->include_all )
     {
         UTILS_DEBUG_PRINTF( SCOREP_DEBUG_FILTERING,
                             "Filtered function %s\n", functionName );
     }
 
-    return !excluded && explicitly_included;
+    return explicitly_included;
 }
@@ -40,6 +40,8 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <SCOREP_ErrorCodes.h>
 
 /**
@@ -47,46 +49,108 @@
  */
 typedef struct scorep_filter_rule_struct scorep_filter_rule_t;
 
+/**
+ * Entry of the literal table of a scorep_filter_matcher_t.
+ */
+typedef struct scorep_filter_literal_struct scorep_filter_literal_t;
+
+/**
+ * Aho-Corasick automaton over the longest literal part of each wildcard rule
+ * of a scorep_filter_matcher_t.
+ */
+typedef struct scorep_filter_automaton_struct scorep_filter_automaton_t;
+
+/**
+ * Compiled form of the rules that apply to the same name (i.e., either the
+ * demangled or the mangled name). Rules without wildcards and rules whose
+ * only wildcard is a trailing '*' are stored in a hash table keyed by their
+ * literal (prefix), and are found in a single pass over the name. All other
+ * rules are matched with fnmatch, but only if they come after the last
+ * matching literal rule, and only if the longest literal part of their
+ * pattern occurs in the name, which is determined by a single pass of the
+ * automaton.
+ */
+typedef struct
+{
+    scorep_filter_literal_t*   literals;
+    uint32_t                   literal_capacity;
+    uint32_t                   number_of_literals;
+    /** prefix_lengths[ i ] is true, if there is a prefix rule of length i */
+    bool*                      prefix_lengths;
+    size_t                     max_prefix_length;
+    /** Indices of rules that need fnmatch, in rule order */
+    uint32_t*                  wildcard_rules;
+    uint32_t                   number_of_wildcard_rules;
+    uint32_t                   wildcard_capacity;
+    /** Built by scorep_filter_compile_rules, NULL if not up-to-date */
+    scorep_filter_automaton_t* automaton;
+} scorep_filter_matcher_t;
+
+/**
+ * Ordered list of filter rules plus their compiled matchers.
+ *
+ * As the rules are evaluated in sequential order, the result is determined by
+ * the last rule that matches a name. The matchers find this rule without
+ * evaluating every rule.
+ */
+typedef struct
+{
+    scorep_filter_rule_t*   rules;
+    uint32_t                number_of_rules;
+    uint32_t                capacity;
+    /** Last 'INCLUDE *' rule plus one, 0 if there is none */
+    uint32_t                include_all;
+    scorep_filter_matcher_t matcher;         /**< rules on the demangled name */
+    scorep_filter_matcher_t mangled_matcher; /**< rules on the mangled name */
+} scorep_filter_rules_t;
+
 struct SCOREP_Filter
 {
-    scorep_filter_rule_t*  file_rules;
-    scorep_filter_rule_t** file_rules_tail;
-    scorep_filter_rule_t*  function_rules;
-    scorep_filter_rule_t** function_rules_tail;
+    scorep_filter_rules_t file_rules;
+    scorep_filter_rules_t function_rules;
 };
 
 /**
- * Adds a filter rule to the file filter rule list.
+ * Appends a filter rule to @a rules.
  * @param rule       The rule's string pattern.
  * @param is_exclude True if it is an exclude rule, false otherwise.
+ * @param is_mangled True if the rule applies to the mangled name.
+ */
+SCOREP_ErrorCode
+scorep_filter_add_rule( scorep_filter_rules_t* rules,
+                        const char*            rule,
+                        bool                   isExclude,
+                        bool                   isMangled );
+
+/**
+ * Builds the automata for the wildcard rules in @a rules. Needs to be called
+ * after rules were added, otherwise all wildcard rules are evaluated with
+ * fnmatch.
  */
 SCOREP_ErrorCode
-scorep_filter_add_rule( scorep_filter_rule_t*** tail,
-                        const char*             rule,
-                        bool                    isExclude,
-                        bool                    isMangled );
+scorep_filter_compile_rules( scorep_filter_rules_t* rules );
 
 /**
  * Frees memory allocations for filter rules.
  */
 void
-scorep_filter_free_rules( scorep_filter_rule_t* head );
+scorep_filter_free_rules( scorep_filter_rules_t* rules );
 
 bool
-scorep_filter_match_file( const scorep_filter_rule_t* fileRules,
-                          const char*                 fileName,
-                          SCOREP_ErrorCode*           err );
+scorep_filter_match_file( const scorep_filter_rules_t* fileRules,
+                          const char*                  fileName,
+                          SCOREP_ErrorCode*            err );
 
 bool
-scorep_filter_match_function( const scorep_filter_rule_t* functionRules,
-                              const char*                 functionName,
-                              const char*                 mangledName,
-                              SCOREP_ErrorCode*           err );
+scorep_filter_match_function( const scorep_filter_rules_t* functionRules,
+                              const char*                  functionName,
+                              const char*                  mangledName,
+                              SCOREP_ErrorCode*            err );
 
 bool
-scorep_filter_include_function( const scorep_filter_rule_t* functionRules,
-                                const char*                 functionName,
-                                const char*                 mangledName,
-                                SCOREP_ErrorCode*           err );
+scorep_filter_include_function( const scorep_filter_rules_t* functionRules,
+                                const char*                  functionName,
+                                const char*                  mangledName,
+                                SCOREP_ErrorCode*            err );
 
 #endif /* SCOREP_FILTER_MATCHING_H */
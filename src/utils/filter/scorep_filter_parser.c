@@ -121,8 +121,8 @@ typedef int scorep_filter_parse_modes;
 
 struct parse_state
 {
-    scorep_filter_rule_t***   file_rule_tail;
-    scorep_filter_rule_t***   function_rule_tail;
+    scorep_filter_rules_t*    file_rules;
+    scorep_filter_rules_t*    function_rules;
     scorep_filter_parse_modes mode;
 };
 
@@ -133,7 +133,8 @@ struct parse_state
  * @param mode    The current mode of the parser. This value may be changed when
  *                the token is evaluated.
  * @returns SCOREP_SUCCESS if the token was processed succesfully. Else an error code
- *          is returned. The only possible error code is SCOREP_ERROR_PARSE_SYNTAX.
+ *          is returned, SCOREP_ERROR_PARSE_SYNTAX for unexpected tokens or the error
+ *          of adding the rule.
  */
 static SCOREP_ErrorCode
 process_token( struct parse_state* state,
@@ -277,20 +278,18 @@ process_token( struct parse_state* state,
             case SCOREP_FILTER_PARSE_FILES_EXCLUDE:
                 exclude = true;
             case SCOREP_FILTER_PARSE_FILES_INCLUDE:
-                scorep_filter_add_rule( state->file_rule_tail,
-                                        token,
-                                        exclude,
-                                        false );
-                break;
+                return scorep_filter_add_rule( state->file_rules,
+                                               token,
+                                               exclude,
+                                               false );
 
             case SCOREP_FILTER_PARSE_REGIONS_EXCLUDE:
                 exclude = true;
             case SCOREP_FILTER_PARSE_REGIONS_INCLUDE:
-                scorep_filter_add_rule( state->function_rule_tail,
-                                        token,
-                                        exclude,
-                                        SCOREP_FILTER_MODE_IS_MANGLED( state->mode ) );
-                break;
+                return scorep_filter_add_rule( state->function_rules,
+                                               token,
+                                               exclude,
+                                               SCOREP_FILTER_MODE_IS_MANGLED( state->mode ) );
 
             default:
                 UTILS_ERROR( SCOREP_ERROR_PARSE_SYNTAX,
@@ -310,8 +309,6 @@ SCOREP_Filter_New( void )
     {
         return NULL;
     }
-    new_filter->file_rules_tail     = &new_filter->file_rules;
-    new_filter->function_rules_tail = &new_filter->function_rules;
     return new_filter;
 }
 
@@ -320,8 +317,8 @@ SCOREP_Filter_Delete( SCOREP_Filter* filter )
 {
     if ( filter )
     {
-        scorep_filter_free_rules( filter->file_rules );
-        scorep_filter_free_rules( filter->function_rules );
+        scorep_filter_free_rules( &filter->file_rules );
+        scorep_filter_free_rules( &filter->function_rules );
         free( filter );
     }
 }
@@ -360,9 +357,9 @@ SCOREP_Filter_ParseFile( SCOREP_Filter* filter,
         goto cleanup;
     }
 
-    state.file_rule_tail     = &filter->file_rules_tail;
-    state.function_rule_tail = &filter->function_rules_tail;
-    state.mode               = SCOREP_FILTER_PARSE_START;
+    state.file_rules     = &filter->file_rules;
+    state.function_rules = &filter->function_rules;
+    state.mode           = SCOREP_FILTER_PARSE_START;
 
     /* Read file line by line */
     while ( !feof( filter_file ) )
@@ -430,7 +427,11 @@ SCOREP_Filter_ParseFile( SCOREP_Filter* filter,
         }
     }
 
-    return SCOREP_SUCCESS;
+    err = scorep_filter_compile_rules( &filter->file_rules );
+    if ( err == SCOREP_SUCCESS )
+    {
+        err = scorep_filter_compile_rules( &filter->function_rules );
+    }
 
 cleanup:
     if ( filter_file )
@@ -454,7 +455,7 @@ SCOREP_Filter_MatchFile( const SCOREP_Filter* filter,
 
     SCOREP_ErrorCode err;
 
-    *result = scorep_filter_match_file( filter->file_rules, fileName, &err );
+    *result = scorep_filter_match_file( &filter->file_rules, fileName, &err );
 
     return err;
 }
@@ -472,7 +473,7 @@ SCOREP_Filter_MatchFunction( const SCOREP_Filter* filter,
 
     SCOREP_ErrorCode err;
 
-    *result = scorep_filter_match_function( filter->function_rules,
+    *result = scorep_filter_match_function( &filter->function_rules,
                                             functionName,
                                             mangledName,
                                             &err );
@@ -493,7 +494,7 @@ SCOREP_Filter_IncludeFunction( const SCOREP_Filter* filter,
 
     SCOREP_ErrorCode err;
 
-    *result = scorep_filter_include_function( filter->function_rules,
+    *result = scorep_filter_include_function( &filter->function_rules,
                                               functionName,
                                               mangledName,
                                               &err );
@@ -515,8 +516,8 @@ SCOREP_Filter_Match( const SCOREP_Filter* filter,
 
     SCOREP_ErrorCode err;
 
-    *result = scorep_filter_match_file( filter->file_rules, fileName, &err ) ||
-              scorep_filter_match_function( filter->function_rules, functionName, mangledName, &err );
+    *result = scorep_filter_match_file( &filter->file_rules, fileName, &err ) ||
+              scorep_filter_match_function( &filter->function_rules, functionName, mangledName, &err );
 
     return err;
 }
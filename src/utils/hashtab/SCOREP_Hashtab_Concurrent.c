@@ -0,0 +1,438 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ * @ingroup         SCOREP_Hashtab_module
+ *
+ * @brief           Implementation of a growing hash table with lock-free lookups.
+ *
+ * Each entry carries two chain links. The bucket array of generation @e g
+ * chains the entries via link <tt>g % 2</tt>. While the table grows, the
+ * entries are pushed, a few buckets per insertion, into the chains of the
+ * next generation via the other link, which is not used by the published
+ * bucket array. Hence, readers of the published array never observe a
+ * modified chain. Only a reader which still uses the array from two
+ * generations back might follow a re-used link and miss an entry. It
+ * detects this by a change of the published array and searches again.
+ */
+
+#include <config.h>
+#include <SCOREP_Hashtab.h>
+
+#include <UTILS_Error.h>
+
+#include <SCOREP_Atomic.h>
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+
+/*--- Type definitions ----------------------------------------------------*/
+
+typedef struct scorep_concurrent_hashtab_item scorep_concurrent_hashtab_item;
+
+/* Chain entry */
+struct scorep_concurrent_hashtab_item
+{
+    SCOREP_Hashtab_Entry            entry;      /* Table entry (key, value) */
+    size_t                          hash_value; /* hash value for entry.key, for fast comparison */
+    scorep_concurrent_hashtab_item* next[ 2 ];  /* Links, used alternately by the generations */
+};
+
+typedef struct scorep_concurrent_hashtab_slab scorep_concurrent_hashtab_slab;
+
+/* Contiguous storage for entries, slabs are never moved or freed before the table */
+struct scorep_concurrent_hashtab_slab
+{
+    scorep_concurrent_hashtab_slab* next;     /* Next younger slab */
+    size_t                          capacity; /* Number of items in this slab */
+    size_t                          used;     /* Number of items handed out */
+    scorep_concurrent_hashtab_item  items[];
+};
+
+typedef struct scorep_concurrent_hashtab_buckets scorep_concurrent_hashtab_buckets;
+
+/* One generation of buckets */
+struct scorep_concurrent_hashtab_buckets
+{
+    scorep_concurrent_hashtab_buckets* previous;   /* Replaced generation, kept for late readers */
+    size_t                             mask;       /* Number of buckets - 1 */
+    uint32_t                           generation; /* Selects the link in the items */
+    scorep_concurrent_hashtab_item*    heads[];
+};
+
+/* Actual hash table data type */
+struct scorep_concurrent_hashtab_struct
+{
+    scorep_concurrent_hashtab_buckets* buckets;      /* Published generation */
+    scorep_concurrent_hashtab_buckets* next_buckets; /* Generation being filled, or NULL */
+    size_t                             migrated;     /* Buckets already pushed into next_buckets */
+    size_t                             size;         /* Number of items stored */
+    scorep_concurrent_hashtab_slab*    first_slab;   /* Oldest slab */
+    scorep_concurrent_hashtab_slab*    last_slab;    /* Slab to allocate from */
+    SCOREP_Hashtab_HashFunction        hash;         /* Hashing function */
+    SCOREP_Hashtab_CompareFunction     kcmp;         /* Comparison function */
+};
+
+/* Number of old buckets moved into the grown generation per insertion */
+#define MIGRATION_STEP 8
+
+/* Minimal number of items in the first slab */
+#define MIN_SLAB_CAPACITY 16
+
+
+/*--- Helper functions ----------------------------------------------------*/
+
+/* The multiplicative hash functions of the module carry their entropy in the
+   upper bits, but the power-of-two tables only use the lowest bits. */
+static inline size_t
+bucket_index( size_t hashValue,
+              size_t mask )
+{
+    uint64_t h = hashValue;
+    h ^= h >> 33;
+    h *= UINT64_C( 0xff51afd7ed558ccd );
+    h ^= h >> 33;
+    return ( size_t )h & mask;
+}
+
+
+static scorep_concurrent_hashtab_buckets*
+create_buckets( size_t   numberOfBuckets,
+                uint32_t generation )
+{
+    scorep_concurrent_hashtab_buckets* buckets =
+        calloc( 1, sizeof( *buckets ) + numberOfBuckets * sizeof( scorep_concurrent_hashtab_item* ) );
+    if ( !buckets )
+    {
+        UTILS_ERROR_POSIX();
+        return NULL;
+    }
+    buckets->mask       = numberOfBuckets - 1;
+    buckets->generation = generation;
+    return buckets;
+}
+
+
+/* Only the inserting thread touches the private link of @a item, the release
+   store publishes it together with the item's content. */
+static inline void
+push_item( scorep_concurrent_hashtab_buckets* buckets,
+           scorep_concurrent_hashtab_item*    item )
+{
+    size_t   index = bucket_index( item->hash_value, buckets->mask );
+    uint32_t link  = buckets->generation % 2;
+    SCOREP_ATOMIC_STORE( &item->next[ link ], buckets->heads[ index ], SCOREP_ATOMIC_RELEASE );
+    SCOREP_ATOMIC_STORE( &buckets->heads[ index ], item, SCOREP_ATOMIC_RELEASE );
+}
+
+
+static void
+migrate_buckets( SCOREP_ConcurrentHashtab* instance )
+{
+    scorep_concurrent_hashtab_buckets* old_buckets = instance->buckets;
+    scorep_concurrent_hashtab_buckets* new_buckets = instance->next_buckets;
+    uint32_t                           link        = old_buckets->generation % 2;
+
+    for ( size_t step = 0;
+          step < MIGRATION_STEP && instance->migrated <= old_buckets->mask;
+          step++, instance->migrated++ )
+    {
+        scorep_concurrent_hashtab_item* item = old_buckets->heads[ instance->migrated ];
+        while ( item )
+        {
+            /* Pushing does not touch the link of the old generation. */
+            push_item( new_buckets, item );
+            item = item->next[ link ];
+        }
+    }
+
+    if ( instance->migrated > old_buckets->mask )
+    {
+        new_buckets->previous = old_buckets;
+        SCOREP_ATOMIC_STORE( &instance->buckets, new_buckets, SCOREP_ATOMIC_RELEASE );
+        instance->next_buckets = NULL;
+        instance->migrated     = 0;
+    }
+}
+
+
+static scorep_concurrent_hashtab_item*
+allocate_item( SCOREP_ConcurrentHashtab* instance )
+{
+    scorep_concurrent_hashtab_slab* slab = instance->last_slab;
+    if ( slab->used == slab->capacity )
+    {
+        /* Double the total capacity. */
+        size_t capacity = instance->size;
+        slab = malloc( sizeof( *slab ) + capacity * sizeof( scorep_concurrent_hashtab_item ) );
+        if ( !slab )
+        {
+            UTILS_ERROR_POSIX();
+            return NULL;
+        }
+        slab->next                = NULL;
+        slab->capacity            = capacity;
+        slab->used                = 0;
+        instance->last_slab->next = slab;
+        instance->last_slab       = slab;
+    }
+    return &slab->items[ slab->used++ ];
+}
+
+
+static SCOREP_Hashtab_Entry*
+insert_item( SCOREP_ConcurrentHashtab*       instance,
+             scorep_concurrent_hashtab_item* item )
+{
+    scorep_concurrent_hashtab_buckets* buckets = instance->buckets;
+
+    push_item( buckets, item );
+    instance->size++;
+
+    if ( instance->next_buckets )
+    {
+        /* Buckets not yet migrated will carry the new item along. */
+        if ( bucket_index( item->hash_value, buckets->mask ) < instance->migrated )
+        {
+            push_item( instance->next_buckets, item );
+        }
+        migrate_buckets( instance );
+    }
+    else if ( instance->size > 2 * ( buckets->mask + 1 ) )
+    {
+        instance->next_buckets = create_buckets( 2 * ( buckets->mask + 1 ),
+                                                 buckets->generation + 1 );
+        if ( instance->next_buckets )
+        {
+            migrate_buckets( instance );
+        }
+    }
+
+    return &item->entry;
+}
+
+
+/*--- Construction & destruction ------------------------------------------*/
+
+SCOREP_ConcurrentHashtab*
+SCOREP_ConcurrentHashtab_CreateSize( size_t                         size,
+                                     SCOREP_Hashtab_HashFunction    hashfunc,
+                                     SCOREP_Hashtab_CompareFunction kcmpfunc )
+{
+    SCOREP_ConcurrentHashtab* instance;
+
+    /* Validate arguments */
+    UTILS_ASSERT( size > 0 && hashfunc && kcmpfunc );
+
+    size_t number_of_buckets = 2;
+    while ( number_of_buckets < size )
+    {
+        number_of_buckets *= 2;
+    }
+
+    /* Create hash table data structure */
+    instance = calloc( 1, sizeof( *instance ) );
+    if ( !instance )
+    {
+        UTILS_ERROR_POSIX();
+        return NULL;
+    }
+
+    instance->buckets = create_buckets( number_of_buckets, 0 );
+    if ( !instance->buckets )
+    {
+        free( instance );
+        return NULL;
+    }
+
+    size_t capacity = number_of_buckets < MIN_SLAB_CAPACITY
+                      ? MIN_SLAB_CAPACITY : number_of_buckets;
+    instance->first_slab = malloc( sizeof( scorep_concurrent_hashtab_slab )
+                                   + capacity * sizeof( scorep_concurrent_hashtab_item ) );
+    if ( !instance->first_slab )
+    {
+        UTILS_ERROR_POSIX();
+        free( instance->buckets );
+        free( instance );
+        return NULL;
+    }
+    instance->first_slab->next     = NULL;
+    instance->first_slab->capacity = capacity;
+    instance->first_slab->used     = 0;
+    instance->last_slab            = instance->first_slab;
+
+    /* Initialization */
+    instance->hash = hashfunc;
+    instance->kcmp = kcmpfunc;
+
+    return instance;
+}
+
+
+void
+SCOREP_ConcurrentHashtab_Free( SCOREP_ConcurrentHashtab* instance )
+{
+    /* Validate arguments */
+    UTILS_ASSERT( instance );
+
+    scorep_concurrent_hashtab_slab* slab = instance->first_slab;
+    while ( slab )
+    {
+        scorep_concurrent_hashtab_slab* next = slab->next;
+        free( slab );
+        slab = next;
+    }
+
+    free( instance->next_buckets );
+    scorep_concurrent_hashtab_buckets* buckets = instance->buckets;
+    while ( buckets )
+    {
+        scorep_concurrent_hashtab_buckets* previous = buckets->previous;
+        free( buckets );
+        buckets = previous;
+    }
+
+    free( instance );
+}
+
+
+void
+SCOREP_ConcurrentHashtab_FreeAll( SCOREP_ConcurrentHashtab*     instance,
+                                  SCOREP_Hashtab_DeleteFunction deleteKey,
+                                  SCOREP_Hashtab_DeleteFunction deleteValue )
+{
+    /* Validate arguments */
+    UTILS_ASSERT( instance && deleteKey && deleteValue );
+
+    for ( scorep_concurrent_hashtab_slab* slab = instance->first_slab;
+          slab;
+          slab = slab->next )
+    {
+        for ( size_t i = 0; i < slab->used; i++ )
+        {
+            deleteKey( slab->items[ i ].entry.key );
+            deleteValue( slab->items[ i ].entry.value.ptr );
+        }
+    }
+    SCOREP_ConcurrentHashtab_Free( instance );
+}
+
+
+/*--- Size operations -----------------------------------------------------*/
+
+size_t
+SCOREP_ConcurrentHashtab_Size( const SCOREP_ConcurrentHashtab* instance )
+{
+    /* Validate arguments */
+    UTILS_ASSERT( instance );
+
+    return instance->size;
+}
+
+
+/*--- Inserting elements --------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#define GEN_CONCURRENT_HASHTAB_INSERT_FUNC_DEF( Name, name, type )                          \
+    SCOREP_Hashtab_Entry*                                                                   \
+    SCOREP_ConcurrentHashtab_Insert##Name( SCOREP_ConcurrentHashtab* instance,              \
+                                           void*                     key,                   \
+                                           type                      value,                 \
+                                           size_t*                   hashValPtr )           \
+    {                                                                                       \
+        scorep_concurrent_hashtab_item* item;                                               \
+        /* Validate arguments */                                                            \
+        UTILS_ASSERT( instance && key );                                                    \
+        /* Create new item */                                                               \
+        item = allocate_item( instance );                                                   \
+        if ( !item )                                                                        \
+        {                                                                                   \
+            return NULL;                                                                    \
+        }                                                                                   \
+        /* Initialize item, eventually calculate hash value */                              \
+        item->entry.key        = key;                                                       \
+        item->entry.value.name = value;                                                     \
+        item->hash_value       = hashValPtr ? *hashValPtr : instance->hash( key );          \
+        return insert_item( instance, item );                                               \
+    }
+/* *INDENT-ON* */
+HASHTAB_VALUES( GEN_CONCURRENT_HASHTAB_INSERT_FUNC_DEF )
+
+
+/*--- Algorithms ----------------------------------------------------------*/
+
+SCOREP_Hashtab_Entry*
+SCOREP_ConcurrentHashtab_Find( const SCOREP_ConcurrentHashtab* instance,
+                               const void*                     key,
+                               size_t*                         hashValPtr )
+{
+    /* Validate arguments */
+    UTILS_ASSERT( instance && key );
+
+    /* Calculate hash value */
+    size_t hashval = instance->hash( key );
+    if ( hashValPtr )
+    {
+        *hashValPtr = hashval;
+    }
+
+    scorep_concurrent_hashtab_buckets* buckets =
+        SCOREP_ATOMIC_LOAD( &instance->buckets, SCOREP_ATOMIC_ACQUIRE );
+    while ( true )
+    {
+        uint32_t                        link = buckets->generation % 2;
+        scorep_concurrent_hashtab_item* item =
+            SCOREP_ATOMIC_LOAD( &buckets->heads[ bucket_index( hashval, buckets->mask ) ],
+                                SCOREP_ATOMIC_ACQUIRE );
+        while ( item )
+        {
+            if ( hashval == item->hash_value &&
+                 0 == instance->kcmp( key, item->entry.key ) )
+            {
+                return &item->entry;
+            }
+            item = SCOREP_ATOMIC_LOAD( &item->next[ link ], SCOREP_ATOMIC_ACQUIRE );
+        }
+
+        /* The links followed can only have been re-used if a newer
+           generation was published meanwhile. */
+        scorep_concurrent_hashtab_buckets* current =
+            SCOREP_ATOMIC_LOAD( &instance->buckets, SCOREP_ATOMIC_ACQUIRE );
+        if ( current == buckets )
+        {
+            return NULL;
+        }
+        buckets = current;
+    }
+}
+
+
+void
+SCOREP_ConcurrentHashtab_Foreach( const SCOREP_ConcurrentHashtab* instance,
+                                  SCOREP_Hashtab_ProcessFunction  procfunc )
+{
+    /* Validate arguments */
+    UTILS_ASSERT( instance && procfunc );
+
+    for ( scorep_concurrent_hashtab_slab* slab = instance->first_slab;
+          slab;
+          slab = slab->next )
+    {
+        for ( size_t i = 0; i < slab->used; i++ )
+        {
+            procfunc( &slab->items[ i ].entry );
+        }
+    }
+}
@@ -117,6 +117,35 @@ SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
                                   SCOREP_Allocator_GuardObject lockObject );
 
 
+/**
+ * Create a memory allocator object like SCOREP_Allocator_CreateAllocator(),
+ * which may use more than 4 GiB of memory. The address range for
+ * @a totalMemory is only reserved, it is committed in arenas of 64 MiB when
+ * pages are handed out. Each page is touched first by the thread that
+ * allocates from it, thus placed on its NUMA node. Page managers keep
+ * released pages in a small private cache for their next allocations.
+ * Movable memory is limited to the first 4 GiB of the allocator.
+ *
+ * @param[out] totalMemory See SCOREP_Allocator_CreateAllocator().
+ * @param[out] pageSize    See SCOREP_Allocator_CreateAllocator().
+ * @param hugePages        Advise the kernel to back the memory with
+ *                         transparent huge pages.
+ * @param lockFunction     See SCOREP_Allocator_CreateAllocator().
+ * @param unlockFunction   See SCOREP_Allocator_CreateAllocator().
+ * @param lockObject       See SCOREP_Allocator_CreateAllocator().
+ *
+ * @return A valid allocator object or a null pointer if the creation fails,
+ *         e.g., because the platform does not provide mmap.
+ */
+SCOREP_Allocator_Allocator*
+SCOREP_Allocator_CreateArenaAllocator( uint64_t*                    totalMemory,
+                                       uint32_t*                    pageSize,
+                                       bool                         hugePages,
+                                       SCOREP_Allocator_Guard       lockFunction,
+                                       SCOREP_Allocator_Guard       unlockFunction,
+                                       SCOREP_Allocator_GuardObject lockObject );
+
+
 /**
  * Delete the allocator object @a allocator and free all it's memory.
  *
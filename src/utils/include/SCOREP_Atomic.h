@@ -0,0 +1,122 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCOREP_ATOMIC_H
+#define SCOREP_ATOMIC_H
+
+/**
+ * @file
+ *
+ * Atomic operations on naturally aligned integer and pointer objects.
+ *
+ * Thin wrappers around the __atomic builtins, the memory orders have the C11
+ * semantics. Configure checks for the builtins, compilers without them fall
+ * back to the __sync builtins, which imply a full barrier and are therefore
+ * at least as strong as any requested memory order.
+ */
+
+
+#if HAVE( SCOREP_ATOMIC_BUILTINS )
+
+
+#define SCOREP_ATOMIC_RELAXED __ATOMIC_RELAXED
+#define SCOREP_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+#define SCOREP_ATOMIC_RELEASE __ATOMIC_RELEASE
+#define SCOREP_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+#define SCOREP_ATOMIC_SEQ_CST __ATOMIC_SEQ_CST
+
+
+/**
+ * Returns the value of @a *ptr.
+ */
+#define SCOREP_ATOMIC_LOAD( ptr, memorder ) \
+    __atomic_load_n( ptr, memorder )
+
+/**
+ * Sets @a *ptr to @a val.
+ */
+#define SCOREP_ATOMIC_STORE( ptr, val, memorder ) \
+    __atomic_store_n( ptr, val, memorder )
+
+/**
+ * Sets @a *ptr to @a val and returns the previous value.
+ */
+#define SCOREP_ATOMIC_EXCHANGE( ptr, val, memorder ) \
+    __atomic_exchange_n( ptr, val, memorder )
+
+/**
+ * Adds @a val to @a *ptr and returns the previous value.
+ */
+#define SCOREP_ATOMIC_FETCH_ADD( ptr, val, memorder ) \
+    __atomic_fetch_add( ptr, val, memorder )
+
+/**
+ * Subtracts @a val from @a *ptr and returns the previous value.
+ */
+#define SCOREP_ATOMIC_FETCH_SUB( ptr, val, memorder ) \
+    __atomic_fetch_sub( ptr, val, memorder )
+
+/**
+ * If @a *ptr equals @a *expected, sets @a *ptr to @a desired and returns
+ * true. Otherwise stores the current value of @a *ptr in @a *expected and
+ * returns false.
+ */
+#define SCOREP_ATOMIC_COMPARE_EXCHANGE( ptr, expected, desired, successMemorder, failureMemorder ) \
+    __atomic_compare_exchange_n( ptr, expected, desired, 0, successMemorder, failureMemorder )
+
+/**
+ * Orders the surrounding memory accesses according to @a memorder.
+ */
+#define SCOREP_ATOMIC_THREAD_FENCE( memorder ) \
+    __atomic_thread_fence( memorder )
+
+
+#else /* !HAVE( SCOREP_ATOMIC_BUILTINS ) */
+
+
+#define SCOREP_ATOMIC_RELAXED 0
+#define SCOREP_ATOMIC_ACQUIRE 0
+#define SCOREP_ATOMIC_RELEASE 0
+#define SCOREP_ATOMIC_ACQ_REL 0
+#define SCOREP_ATOMIC_SEQ_CST 0
+
+
+#define SCOREP_ATOMIC_LOAD( ptr, memorder ) \
+    __sync_fetch_and_add( ptr, 0 )
+
+/* __sync_lock_test_and_set is only an acquire barrier */
+#define SCOREP_ATOMIC_STORE( ptr, val, memorder ) \
+    ( __sync_synchronize(), ( void )__sync_lock_test_and_set( ptr, val ), __sync_synchronize() )
+
+#define SCOREP_ATOMIC_EXCHANGE( ptr, val, memorder ) \
+    ( __sync_synchronize(), __sync_lock_test_and_set( ptr, val ) )
+
+#define SCOREP_ATOMIC_FETCH_ADD( ptr, val, memorder ) \
+    __sync_fetch_and_add( ptr, val )
+
+#define SCOREP_ATOMIC_FETCH_SUB( ptr, val, memorder ) \
+    __sync_fetch_and_sub( ptr, val )
+
+/* The current value is read again after a failure, it may already equal
+   @a *expected, as for a spurious failure. */
+#define SCOREP_ATOMIC_COMPARE_EXCHANGE( ptr, expected, desired, successMemorder, failureMemorder ) \
+    ( __sync_bool_compare_and_swap( ptr, *( expected ), desired ) \
+      ? 1 : ( *( expected ) = __sync_fetch_and_add( ptr, 0 ), 0 ) )
+
+#define SCOREP_ATOMIC_THREAD_FENCE( memorder ) \
+    __sync_synchronize()
+
+
+#endif /* !HAVE( SCOREP_ATOMIC_BUILTINS ) */
+
+
+#endif /* SCOREP_ATOMIC_H */
@@ -389,6 +389,134 @@ SCOREP_Hashtab_FreeAll( SCOREP_Hashtab*               instance,
                         SCOREP_Hashtab_DeleteFunction deleteKey,
                         SCOREP_Hashtab_DeleteFunction deleteValue );
 
+/*
+ * --------------------------------------------------------------------------
+ * SCOREP_ConcurrentHashtab
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * Opaque data structure representing a growing hash table which can be
+ * searched without locks.
+ *
+ * In contrast to SCOREP_Hashtab, the number of buckets is a power of two
+ * and doubles once the table holds twice as many entries as buckets. The
+ * entries are not re-chained all at once, each insertion moves a few buckets
+ * into the grown table. Entries are stored in slabs of increasing size and
+ * never move, thus pointers to SCOREP_Hashtab_Entry objects stay valid until
+ * the table is freed. Entries cannot be removed.
+ *
+ * SCOREP_ConcurrentHashtab_Find() may be called by any number of threads
+ * while one thread inserts. Insertions must be serialized by the caller.
+ */
+typedef struct scorep_concurrent_hashtab_struct SCOREP_ConcurrentHashtab;
+
+/* *INDENT-OFF* */
+/**
+ * Inserting elements
+ *
+ * Generates declaration of insertation functions of SCOREP_ConcurrentHashtab
+ * e.g. SCOREP_ConcurrentHashtab_InsertPtr
+ *
+ * Same as the SCOREP_Hashtab_Insert functions, but the entry becomes visible
+ * to concurrent calls to SCOREP_ConcurrentHashtab_Find() only after it is
+ * completely initialized.
+ */
+#define GEN_CONCURRENT_HASHTAB_INSERT_FUNC_DECL( Name, name, type )         \
+    SCOREP_Hashtab_Entry*                                                   \
+    SCOREP_ConcurrentHashtab_Insert##Name( SCOREP_ConcurrentHashtab* instance, \
+                                           void*                     key,   \
+                                           type                      name,  \
+                                           size_t*                   hashValPtr );
+/* *INDENT-ON* */
+
+
+HASHTAB_VALUES( GEN_CONCURRENT_HASHTAB_INSERT_FUNC_DECL )
+
+/**
+ * Creates and returns an instance of SCOREP_ConcurrentHashtab. @a size is
+ * the initial number of buckets, it is rounded up to the next power of two.
+ * If the memory allocation request cannot be fulfilled, an error message is
+ * printed and @c NULL is returned.
+ *
+ * @param size     Initial size of the hash table
+ * @param hashfunc Hashing function
+ * @param kcmpfunc Key comparison function
+ *
+ * @return Pointer to new instance
+ */
+SCOREP_ConcurrentHashtab*
+SCOREP_ConcurrentHashtab_CreateSize( size_t                         size,
+                                     SCOREP_Hashtab_HashFunction    hashfunc,
+                                     SCOREP_Hashtab_CompareFunction kcmpfunc );
+
+/**
+ * Destroys the given @a instance of SCOREP_ConcurrentHashtab and releases the
+ * allocated memory. Like SCOREP_Hashtab_Free(), keys and values are not freed.
+ *
+ * @param instance Object to be freed
+ */
+void
+SCOREP_ConcurrentHashtab_Free( SCOREP_ConcurrentHashtab* instance );
+
+/**
+ * Like SCOREP_Hashtab_FreeAll(), destroys the given @a instance and frees
+ * keys and values with @a deleteKey and @a deleteValue.
+ *
+ * @param instance    Object to be freed
+ * @param deleteKey   Function pointer to a function which deletes the key
+ *                    objects.
+ * @param deleteValue Function pointer to a function which deletes the value
+ *                    objects.
+ */
+void
+SCOREP_ConcurrentHashtab_FreeAll( SCOREP_ConcurrentHashtab*     instance,
+                                  SCOREP_Hashtab_DeleteFunction deleteKey,
+                                  SCOREP_Hashtab_DeleteFunction deleteValue );
+
+/**
+ * Returns the actual number of elements stored in the given
+ * SCOREP_ConcurrentHashtab @a instance.
+ *
+ * @param instance Queried object
+ *
+ * @return Number of elements stored
+ */
+size_t
+SCOREP_ConcurrentHashtab_Size( const SCOREP_ConcurrentHashtab* instance );
+
+/**
+ * Searches for an hash table entry with the specified @a key, see
+ * SCOREP_Hashtab_Find(). Does not need to be synchronized with insertions.
+ * If it returns @c NULL while another thread inserts @a key, the caller has
+ * to search again after it synchronized with the inserting thread.
+ *
+ * @param instance   Object in which the item is searched
+ * @param key        Unique key to search for
+ * @param hashValPtr Storage where hash value of the key will be is stored. For
+ *                   use to a later call to @a SCOREP_ConcurrentHashtab_Insert()
+ *                   with the same key @a key. (ignored if @c NULL)
+ *
+ * @return Pointer to hash table entry if matching item could be found;
+ *         @c NULL otherwise
+ */
+SCOREP_Hashtab_Entry*
+SCOREP_ConcurrentHashtab_Find( const SCOREP_ConcurrentHashtab* instance,
+                               const void*                     key,
+                               size_t*                         hashValPtr );
+
+/**
+ * Calls the unary processing function @a procfunc for each element of
+ * the given SCOREP_ConcurrentHashtab @a instance in the order of insertion.
+ * Must not run concurrently to insertions.
+ *
+ * @param instance Object whose entries should be processed
+ * @param procfunc Unary processing function
+ */
+void
+SCOREP_ConcurrentHashtab_Foreach( const SCOREP_ConcurrentHashtab* instance,
+                                  SCOREP_Hashtab_ProcessFunction  procfunc );
+
 /*
  * --------------------------------------------------------------------------
  * Default Comparison functions
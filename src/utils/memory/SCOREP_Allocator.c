@@ -46,11 +46,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #define SCOREP_DEBUG_MODULE_NAME ALLOCATOR
 #include <UTILS_Debug.h>
 #include <UTILS_Error.h>
 
+#include <SCOREP_Atomic.h>
+
 #include "scorep_bitset.h"
 #include "scorep_page.h"
 
@@ -75,6 +79,12 @@
 /* 8 objects per page should be minimum to be efficient */
 #define MIN_NUMBER_OF_OBJECTS_PER_PAGE 8
 
+/* Arena allocators commit memory in steps of this size */
+#define ARENA_SIZE ( ( size_t )64 * 1024 * 1024 )
+
+/* Alignment of the arenas, to allow the OS to use huge pages */
+#define ARENA_ALIGNMENT ( ( size_t )2 * 1024 * 1024 )
+
 
 #define roundupto( x, to ) ( ( x ) + ( ( to ) - 1 ) - ( ( ( x ) - 1 ) % ( to ) ) )
 
@@ -124,10 +134,18 @@ unlock_allocator( SCOREP_Allocator_Allocator* allocator )
 }
 
 
+/* the allocator object itself may be larger than the union objects */
+static inline size_t
+allocator_size( void )
+{
+    return roundupto( sizeof( SCOREP_Allocator_Allocator ), union_size() );
+}
+
+
 static inline void*
 page_bitset( SCOREP_Allocator_Allocator* allocator )
 {
-    return ( char* )allocator + union_size();
+    return ( char* )allocator + allocator_size();
 }
 
 
@@ -166,21 +184,69 @@ track_bitset_clear_range( SCOREP_Allocator_Allocator* allocator,
     allocator->n_pages_allocated -= length;
 }
 
+/*
+ * Searches only the first @a maxPageId pages, which is either the
+ * capacity or a multiple of the bitset word size.
+ */
 static inline uint32_t
-track_bitset_find_and_set( SCOREP_Allocator_Allocator* allocator )
+track_bitset_find_and_set( SCOREP_Allocator_Allocator* allocator,
+                           uint32_t                    maxPageId )
 {
     allocator->n_pages_allocated++;  /* increment even if there is no new page */
     track_update_high_watermark( allocator );
-    return bitset_find_and_set( page_bitset( allocator ), allocator->n_pages_capacity );
+    return bitset_find_and_set( page_bitset( allocator ), maxPageId );
 }
 
 static inline uint32_t
 track_bitset_find_and_set_range( SCOREP_Allocator_Allocator* allocator,
-                                 uint32_t                    rangeLength )
+                                 uint32_t                    rangeLength,
+                                 uint32_t                    maxPageId )
 {
     allocator->n_pages_allocated += rangeLength;
     track_update_high_watermark( allocator );
-    return bitset_find_and_set_range( page_bitset( allocator ), allocator->n_pages_capacity, rangeLength );
+    return bitset_find_and_set_range( page_bitset( allocator ), maxPageId, rangeLength );
+}
+
+
+/*
+ * Caller needs to hold the allocator lock.
+ *
+ * Makes sure that the pages up to @a endPageId are backed by memory, by
+ * committing further arenas of the reserved address range.
+ */
+static bool
+commit_pages( SCOREP_Allocator_Allocator* allocator,
+              uint32_t                    endPageId )
+{
+    if ( endPageId <= allocator->n_pages_committed )
+    {
+        return true;
+    }
+
+    uint64_t n_pages = roundupto( ( uint64_t )endPageId, allocator->n_pages_per_arena );
+    if ( n_pages > allocator->n_pages_capacity )
+    {
+        n_pages = allocator->n_pages_capacity;
+    }
+
+    char*  start  = ( char* )allocator + ( ( size_t )allocator->n_pages_committed << allocator->page_shift );
+    size_t length = ( size_t )( n_pages - allocator->n_pages_committed ) << allocator->page_shift;
+    if ( mprotect( start, length, PROT_READ | PROT_WRITE ) != 0 )
+    {
+        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "committing %zu bytes failed", length );
+        return false;
+    }
+#if defined( MADV_HUGEPAGE )
+    if ( allocator->huge_pages )
+    {
+        madvise( start, length, MADV_HUGEPAGE );
+    }
+#endif
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "committed pages [%" PRIu32 ", %" PRIu64 ")",
+                        allocator->n_pages_committed, n_pages );
+    allocator->n_pages_committed = n_pages;
+    return true;
 }
 
 
@@ -208,13 +274,19 @@ get_union_object( SCOREP_Allocator_Allocator* allocator )
     if ( !allocator->free_objects )
     {
         /* try to get a new maintenance page */
-        uint32_t page_id = track_bitset_find_and_set( allocator );
+        uint32_t page_id = track_bitset_find_and_set( allocator, allocator->n_pages_capacity );
         if ( page_id >= allocator->n_pages_capacity )
         {
             UTILS_DEBUG_EXIT( "out-of-memory: no free page" );
             return NULL;
         }
-        char*    start_addr  = ( char* )allocator + ( page_id << allocator->page_shift );
+        if ( !commit_pages( allocator, page_id + 1 ) )
+        {
+            track_bitset_clear( allocator, page_id );
+            UTILS_DEBUG_EXIT( "out-of-memory: cannot commit page" );
+            return NULL;
+        }
+        char*    start_addr  = ( char* )allocator + ( ( size_t )page_id << allocator->page_shift );
         uint32_t free_memory = page_size( allocator );
         fill_with_union_objects( free_memory, start_addr, allocator );
         allocator->n_pages_maintenance++;
@@ -270,9 +342,13 @@ put_page( SCOREP_Allocator_Allocator* allocator,
 
 /*
  * Caller needs to hold the allocator lock.
+ *
+ * The page will be below @a maxPageId.
  */
 static SCOREP_Allocator_Page*
-get_page( SCOREP_Allocator_Allocator* allocator, uint32_t order )
+get_page( SCOREP_Allocator_Allocator* allocator,
+          uint32_t                    order,
+          uint32_t                    maxPageId )
 {
     UTILS_DEBUG_ENTRY();
     uint32_t page_id;
@@ -286,19 +362,26 @@ get_page( SCOREP_Allocator_Allocator* allocator, uint32_t order )
 
     if ( order == 1 )
     {
-        page_id = track_bitset_find_and_set( allocator );
+        page_id = track_bitset_find_and_set( allocator, maxPageId );
     }
     else
     {
-        page_id = track_bitset_find_and_set_range( allocator, order );
+        page_id = track_bitset_find_and_set_range( allocator, order, maxPageId );
     }
 
-    if ( page_id >= allocator->n_pages_capacity )
+    if ( page_id >= maxPageId )
     {
         put_union_object( allocator, page );
         UTILS_DEBUG_EXIT( "out-of-memory: no free page(s), order=%" PRIu32 "", order );
         return 0;
     }
+    if ( !commit_pages( allocator, page_id + order ) )
+    {
+        track_bitset_clear_range( allocator, page_id, order );
+        put_union_object( allocator, page );
+        UTILS_DEBUG_EXIT( "out-of-memory: cannot commit page(s), order=%" PRIu32 "", order );
+        return 0;
+    }
     init_page( allocator, page, page_id, order );
 
     UTILS_DEBUG_EXIT( "new page=%p, order=%" PRIu32 ", page_id=%" PRIu32 "", page, order, page_id );
@@ -306,16 +389,142 @@ get_page( SCOREP_Allocator_Allocator* allocator, uint32_t order )
 }
 
 
+/*
+ * Returns the pages in the list @a pages to the allocator.
+ */
+static void
+put_pages( SCOREP_Allocator_Allocator* allocator,
+           SCOREP_Allocator_Page*      pages )
+{
+    if ( !pages )
+    {
+        return;
+    }
+
+    if ( allocator->release_freed_pages )
+    {
+        /* Let the next user of the pages place them on its NUMA node */
+        for ( SCOREP_Allocator_Page* page = pages; page; page = page->next )
+        {
+            madvise( page->memory_start_address, get_page_length( page ), MADV_DONTNEED );
+        }
+    }
+
+    lock_allocator( allocator );
+    while ( pages )
+    {
+        SCOREP_Allocator_Page* next_page = pages->next;
+        put_page( allocator, pages );
+        pages = next_page;
+    }
+    unlock_allocator( allocator );
+}
+
+
+/*
+ * Keeps the freed @a page with @a order pages for the page manager, if
+ * neither its own nor the allocator-wide cache limit is reached. Does not
+ * lock the allocator.
+ */
+static bool
+cache_page( SCOREP_Allocator_PageManager* pageManager,
+            SCOREP_Allocator_Page*        page,
+            uint32_t                      order )
+{
+    SCOREP_Allocator_Allocator* allocator = pageManager->allocator;
+    if ( pageManager->n_cached_pages + order > allocator->n_pages_cache_limit )
+    {
+        return false;
+    }
+    uint32_t n_pages_cached = SCOREP_ATOMIC_FETCH_ADD( &allocator->n_pages_cached, order,
+                                                       SCOREP_ATOMIC_RELAXED );
+    if ( n_pages_cached + order > allocator->n_pages_cache_limit_total )
+    {
+        SCOREP_ATOMIC_FETCH_SUB( &allocator->n_pages_cached, order, SCOREP_ATOMIC_RELAXED );
+        return false;
+    }
+
+    set_page_usage( page, 0 );
+    page->next                   = pageManager->cached_pages;
+    pageManager->cached_pages    = page;
+    pageManager->n_cached_pages += order;
+    return true;
+}
+
+
+/*
+ * Returns all pages the page manager has kept to the allocator.
+ */
+static void
+release_cached_pages( SCOREP_Allocator_PageManager* pageManager )
+{
+    if ( !pageManager->cached_pages )
+    {
+        return;
+    }
+    SCOREP_ATOMIC_FETCH_SUB( &pageManager->allocator->n_pages_cached,
+                             pageManager->n_cached_pages,
+                             SCOREP_ATOMIC_RELAXED );
+    put_pages( pageManager->allocator, pageManager->cached_pages );
+    pageManager->cached_pages   = NULL;
+    pageManager->n_cached_pages = 0;
+}
+
+
+/*
+ * Takes a page with @a order pages below @a maxPageId from the pages the
+ * page manager has kept, without locking the allocator.
+ */
+static SCOREP_Allocator_Page*
+take_cached_page( SCOREP_Allocator_PageManager* pageManager,
+                  uint32_t                      order,
+                  uint32_t                      maxPageId )
+{
+    SCOREP_Allocator_Page** page_it = &pageManager->cached_pages;
+    while ( *page_it )
+    {
+        SCOREP_Allocator_Page* page = *page_it;
+        if ( get_page_order( page ) == order
+             && get_page_id( page ) + order <= maxPageId )
+        {
+            *page_it                     = page->next;
+            pageManager->n_cached_pages -= order;
+            SCOREP_ATOMIC_FETCH_SUB( &pageManager->allocator->n_pages_cached, order,
+                                     SCOREP_ATOMIC_RELAXED );
+            set_page_usage( page, 0 );
+            page->next = NULL;
+            return page;
+        }
+        page_it = &page->next;
+    }
+    return NULL;
+}
+
+
 static SCOREP_Allocator_Page*
 page_manager_get_new_page( SCOREP_Allocator_PageManager* pageManager,
-                           uint32_t                      min_page_size )
+                           uint32_t                      min_page_size,
+                           uint32_t                      maxPageId )
 {
     uint32_t order = get_order( pageManager->allocator, min_page_size );
     UTILS_DEBUG_ENTRY( "min_page_size=%" PRIu32 " -> order=%" PRIu32 "", min_page_size, order );
 
-    lock_allocator( pageManager->allocator );
-    SCOREP_Allocator_Page* page = get_page( pageManager->allocator, order );
-    unlock_allocator( pageManager->allocator );
+    SCOREP_Allocator_Page* page = take_cached_page( pageManager, order, maxPageId );
+    if ( !page )
+    {
+        lock_allocator( pageManager->allocator );
+        page = get_page( pageManager->allocator, order, maxPageId );
+        unlock_allocator( pageManager->allocator );
+    }
+    if ( !page && pageManager->cached_pages )
+    {
+        /* The kept pages do not fit, give them back and try again */
+        release_cached_pages( pageManager );
+
+        lock_allocator( pageManager->allocator );
+        page = get_page( pageManager->allocator, order, maxPageId );
+        unlock_allocator( pageManager->allocator );
+    }
 
     if ( page )
     {
@@ -344,7 +553,8 @@ grab_memory( SCOREP_Allocator_Page* page,
 
 static void*
 page_manager_alloc( SCOREP_Allocator_PageManager* pageManager,
-                    size_t                        requestedSize )
+                    size_t                        requestedSize,
+                    uint32_t                      maxPageId )
 {
     assert( pageManager );
     assert( pageManager->moved_page_id_mapping == 0 );
@@ -361,7 +571,8 @@ page_manager_alloc( SCOREP_Allocator_PageManager* pageManager,
     SCOREP_Allocator_Page* page = pageManager->pages_in_use_list;
     while ( page )
     {
-        if ( roundup( requestedSize ) <= get_page_avail( page ) )
+        if ( roundup( requestedSize ) <= get_page_avail( page )
+             && get_page_id( page ) + get_page_order( page ) <= maxPageId )
         {
             break;
         }
@@ -372,7 +583,7 @@ page_manager_alloc( SCOREP_Allocator_PageManager* pageManager,
     if ( !page )
     {
         UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "requesting new page ..." );
-        page = page_manager_get_new_page( pageManager, requestedSize );
+        page = page_manager_get_new_page( pageManager, requestedSize, maxPageId );
         UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "... got page %p.", page );
     }
 
@@ -394,39 +605,21 @@ SCOREP_Allocator_RoundupToAlignment( size_t size )
 }
 
 
-SCOREP_Allocator_Allocator*
-SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
-                                  uint32_t*                    pageSize,
-                                  SCOREP_Allocator_Guard       lockFunction,
-                                  SCOREP_Allocator_Guard       unlockFunction,
-                                  SCOREP_Allocator_GuardObject lockObject )
+/*
+ * Computes the layout of an allocator with @a nPages pages of size
+ * 1 << @a pageShift. Returns the number of bytes used for the allocator
+ * object and the page bitset, and in @a usedPages the number of pages
+ * reserved for maintenance. Returns 0 if there are too few pages.
+ */
+static uint32_t
+get_maintenance_layout( uint32_t  nPages,
+                        uint32_t  pageShift,
+                        uint32_t* usedPages,
+                        uint32_t* freeMemoryInLastPage )
 {
-    UTILS_DEBUG_ENTRY();
-    *pageSize = npot( *pageSize );
-
-    if ( *totalMemory <= *pageSize || *totalMemory == 0 || *pageSize == 0 )
-    {
-        return 0;
-    }
-    /* min page size 512? */
-    if ( *pageSize / union_size() < MIN_NUMBER_OF_OBJECTS_PER_PAGE )
-    {
-        return 0;
-    }
-
-    uint32_t page_shift = 0;
-    while ( ( *pageSize ) >> ( page_shift + 1 ) )
-    {
-        page_shift++;
-    }
-
-    uint32_t n_pages = ( *totalMemory ) / ( *pageSize );
-    /* round the total memory down to a multiple of pageSize */
-    *totalMemory = n_pages * ( *pageSize );
-
-    uint32_t maint_memory_needed = union_size() + bitset_size( n_pages );
+    uint32_t maint_memory_needed = allocator_size() + bitset_size( nPages );
     maint_memory_needed = roundupto( maint_memory_needed, 64 ); // why 64?
-    if ( ( *totalMemory ) <= maint_memory_needed )
+    if ( ( ( uint64_t )nPages << pageShift ) <= maint_memory_needed )
     {
         /* too few memory to hold maintenance stuff */
         return 0;
@@ -435,44 +628,88 @@ SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
     /* mark the pages used we need for our own maintenance
      * (i.e. this object and the page_map)
      */
-    uint32_t already_used_pages = maint_memory_needed >> page_shift;
+    uint32_t already_used_pages = maint_memory_needed >> pageShift;
     /* always use one more page for the allocator union object */
     already_used_pages++;
-    uint32_t free_memory_in_last_page = ( already_used_pages << page_shift ) - maint_memory_needed;
+    uint32_t free_memory_in_last_page = ( already_used_pages << pageShift ) - maint_memory_needed;
 
-    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "0: m=%zu ps=%u np=%zu mm=%zu fm=%zu aup=%zu puor=%f",
-                        totalMemory, page_shift, n_pages,
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "0: ps=%u np=%u mm=%u fm=%u aup=%u puor=%f",
+                        pageShift, nPages,
                         maint_memory_needed,
                         free_memory_in_last_page,
                         already_used_pages,
-                        ( double )( free_memory_in_last_page / union_size() ) / n_pages );
+                        ( double )( free_memory_in_last_page / union_size() ) / nPages );
 
     /* guarantee at least for .5% of the total number of pages pre-allocated page structs */ // why .5% ?
-    while ( ( free_memory_in_last_page / union_size() ) < ( n_pages / 200 ) )
+    while ( ( free_memory_in_last_page / union_size() ) < ( nPages / 200 ) )
     {
         already_used_pages++;
-        free_memory_in_last_page += ( *pageSize );
+        free_memory_in_last_page += 1 << pageShift;
     }
-    if ( already_used_pages >= n_pages )
+    if ( already_used_pages >= nPages )
     {
         return 0;
     }
 
-    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "1: m=%zu ps=%u np=%zu mm=%zu fm=%zu aup=%zu puor=%f",
-                        totalMemory, page_shift, n_pages,
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "1: ps=%u np=%u mm=%u fm=%u aup=%u puor=%f",
+                        pageShift, nPages,
                         maint_memory_needed,
                         free_memory_in_last_page,
                         already_used_pages,
-                        ( double )( free_memory_in_last_page / union_size() ) / n_pages );
+                        ( double )( free_memory_in_last_page / union_size() ) / nPages );
 
-    SCOREP_Allocator_Allocator* allocator = calloc( 1, *totalMemory );
-    if ( !allocator )
+    *usedPages            = already_used_pages;
+    *freeMemoryInLastPage = free_memory_in_last_page;
+    return maint_memory_needed;
+}
+
+
+/*
+ * Checks @a pageSize and returns its shift, or 0 if it is invalid.
+ */
+static uint32_t
+get_page_shift( uint32_t* pageSize )
+{
+    *pageSize = npot( *pageSize );
+
+    if ( *pageSize == 0 )
+    {
+        return 0;
+    }
+    /* min page size 512? */
+    if ( *pageSize / union_size() < MIN_NUMBER_OF_OBJECTS_PER_PAGE )
     {
         return 0;
     }
-    allocator->page_shift          = page_shift;
-    allocator->n_pages_capacity    = n_pages;
-    allocator->n_pages_maintenance = already_used_pages;
+
+    uint32_t page_shift = 0;
+    while ( ( *pageSize ) >> ( page_shift + 1 ) )
+    {
+        page_shift++;
+    }
+    return page_shift;
+}
+
+
+/*
+ * Initializes the allocator object at the start of its memory.
+ */
+static void
+init_allocator( SCOREP_Allocator_Allocator*  allocator,
+                uint32_t                     pageShift,
+                uint32_t                     nPages,
+                uint32_t                     maintMemoryNeeded,
+                uint32_t                     alreadyUsedPages,
+                uint32_t                     freeMemoryInLastPage,
+                SCOREP_Allocator_Guard       lockFunction,
+                SCOREP_Allocator_Guard       unlockFunction,
+                SCOREP_Allocator_GuardObject lockObject )
+{
+    allocator->page_shift          = pageShift;
+    allocator->n_pages_capacity    = nPages;
+    allocator->n_pages_maintenance = alreadyUsedPages;
+    allocator->n_pages_movable     = nPages;
+    allocator->n_pages_committed   = nPages;
     allocator->free_objects        = NULL;
 
     allocator->lock        = null_guard;
@@ -489,10 +726,144 @@ SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
 
     track_bitset_set_range( allocator, 0, allocator->n_pages_maintenance );
 
-    char* start_addr = ( char* )allocator + maint_memory_needed;
-    fill_with_union_objects( free_memory_in_last_page, start_addr, allocator );
+    char* start_addr = ( char* )allocator + maintMemoryNeeded;
+    fill_with_union_objects( freeMemoryInLastPage, start_addr, allocator );
     UTILS_DEBUG_PRINTF( SCOREP_DEBUG_ALLOCATOR, "\'allocated\' %" PRIu32 " maintenance page(s).",
                         allocator->n_pages_maintenance );
+}
+
+
+SCOREP_Allocator_Allocator*
+SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
+                                  uint32_t*                    pageSize,
+                                  SCOREP_Allocator_Guard       lockFunction,
+                                  SCOREP_Allocator_Guard       unlockFunction,
+                                  SCOREP_Allocator_GuardObject lockObject )
+{
+    UTILS_DEBUG_ENTRY();
+    uint32_t page_shift = get_page_shift( pageSize );
+    if ( page_shift == 0 || *totalMemory <= *pageSize || *totalMemory == 0 )
+    {
+        return 0;
+    }
+
+    uint32_t n_pages = ( *totalMemory ) / ( *pageSize );
+    /* round the total memory down to a multiple of pageSize */
+    *totalMemory = n_pages * ( *pageSize );
+
+    uint32_t already_used_pages;
+    uint32_t free_memory_in_last_page;
+    uint32_t maint_memory_needed = get_maintenance_layout( n_pages, page_shift,
+                                                           &already_used_pages,
+                                                           &free_memory_in_last_page );
+    if ( maint_memory_needed == 0 )
+    {
+        return 0;
+    }
+
+    SCOREP_Allocator_Allocator* allocator = calloc( 1, *totalMemory );
+    if ( !allocator )
+    {
+        return 0;
+    }
+    init_allocator( allocator, page_shift, n_pages,
+                    maint_memory_needed, already_used_pages, free_memory_in_last_page,
+                    lockFunction, unlockFunction, lockObject );
+
+    UTILS_DEBUG_EXIT();
+    return allocator;
+}
+
+
+SCOREP_Allocator_Allocator*
+SCOREP_Allocator_CreateArenaAllocator( uint64_t*                    totalMemory,
+                                       uint32_t*                    pageSize,
+                                       bool                         hugePages,
+                                       SCOREP_Allocator_Guard       lockFunction,
+                                       SCOREP_Allocator_Guard       unlockFunction,
+                                       SCOREP_Allocator_GuardObject lockObject )
+{
+    UTILS_DEBUG_ENTRY();
+    uint32_t page_shift = get_page_shift( pageSize );
+    if ( page_shift == 0 || *totalMemory <= *pageSize )
+    {
+        return 0;
+    }
+
+    /* page ids need to fit into 32 bit */
+    uint64_t n_pages = ( *totalMemory ) / ( *pageSize );
+    if ( n_pages > UINT32_MAX || n_pages > SIZE_MAX >> page_shift )
+    {
+        return 0;
+    }
+    /* round the total memory down to a multiple of pageSize */
+    *totalMemory = n_pages * ( *pageSize );
+
+    uint32_t already_used_pages;
+    uint32_t free_memory_in_last_page;
+    uint32_t maint_memory_needed = get_maintenance_layout( n_pages, page_shift,
+                                                           &already_used_pages,
+                                                           &free_memory_in_last_page );
+    if ( maint_memory_needed == 0 )
+    {
+        return 0;
+    }
+
+    /* Only reserve the address range, arenas are committed on demand */
+    size_t mapping_size = *totalMemory + ARENA_ALIGNMENT;
+    char*  mapping      = mmap( NULL, mapping_size, PROT_NONE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if ( mapping == MAP_FAILED )
+    {
+        return 0;
+    }
+    SCOREP_Allocator_Allocator* allocator =
+        ( SCOREP_Allocator_Allocator* )roundupto( ( uintptr_t )mapping, ARENA_ALIGNMENT );
+
+    size_t   arena_size        = ARENA_SIZE > *pageSize ? ARENA_SIZE : *pageSize;
+    uint32_t n_pages_per_arena = arena_size >> page_shift;
+    uint32_t n_pages_committed = roundupto( already_used_pages, n_pages_per_arena );
+    if ( n_pages_committed > n_pages )
+    {
+        n_pages_committed = n_pages;
+    }
+    if ( mprotect( allocator, ( size_t )n_pages_committed << page_shift, PROT_READ | PROT_WRITE ) != 0 )
+    {
+        munmap( mapping, mapping_size );
+        return 0;
+    }
+
+    init_allocator( allocator, page_shift, n_pages,
+                    maint_memory_needed, already_used_pages, free_memory_in_last_page,
+                    lockFunction, unlockFunction, lockObject );
+    allocator->mapping           = mapping;
+    allocator->mapping_size      = mapping_size;
+    allocator->n_pages_committed = n_pages_committed;
+    allocator->n_pages_per_arena = n_pages_per_arena;
+    allocator->huge_pages        = hugePages;
+#if defined( MADV_HUGEPAGE )
+    if ( hugePages )
+    {
+        madvise( allocator, ( size_t )n_pages_committed << page_shift, MADV_HUGEPAGE );
+    }
+#endif
+
+    /* Movable memory is a 32 bit offset to the allocator, the limit is a
+       multiple of the bitset word size as the page size is a power of two */
+    if ( *totalMemory > UINT32_MAX )
+    {
+        allocator->n_pages_movable = ( ( uint64_t )UINT32_MAX + 1 ) >> page_shift;
+    }
+
+    /* Let every page manager keep up to 1/256 of the pages, but all of them
+       together not more than 1/64, so that kept pages of idle page managers
+       cannot exhaust the memory of the others */
+    allocator->n_pages_cache_limit       = n_pages >> 8;
+    allocator->n_pages_cache_limit_total = n_pages >> 6;
+
+    /* Pages smaller than the OS page cannot be given back individually */
+    long os_page_size = sysconf( _SC_PAGESIZE );
+    allocator->release_freed_pages = os_page_size > 0 && *pageSize >= ( uint64_t )os_page_size;
 
     UTILS_DEBUG_EXIT();
     return allocator;
@@ -502,6 +873,11 @@ SCOREP_Allocator_CreateAllocator( uint32_t*                    totalMemory,
 void
 SCOREP_Allocator_DeleteAllocator( SCOREP_Allocator_Allocator* allocator )
 {
+    if ( allocator && allocator->mapping )
+    {
+        munmap( allocator->mapping, allocator->mapping_size );
+        return;
+    }
     free( allocator );
 }
 
@@ -528,6 +904,8 @@ SCOREP_Allocator_GetMaxNumberOfPages( const SCOREP_Allocator_Allocator* allocato
         pm->pages_in_use_list     = 0; \
         pm->moved_page_id_mapping = 0; \
         pm->last_allocation       = 0; \
+        pm->n_cached_pages        = 0; \
+        pm->cached_pages          = 0; \
     } while ( 0 )
 
 
@@ -539,7 +917,7 @@ SCOREP_Allocator_CreatePageManager( SCOREP_Allocator_Allocator* allocator )
     get_page_manager( allocator, page_manager );
 
     /* may fail, but maybe we have free pages later */
-    page_manager_get_new_page( page_manager, page_size( allocator ) );
+    page_manager_get_new_page( page_manager, page_size( allocator ), allocator->n_pages_movable );
 
     UTILS_DEBUG_EXIT();
     return page_manager;
@@ -555,10 +933,10 @@ SCOREP_Allocator_CreateMovedPageManager( SCOREP_Allocator_Allocator* allocator )
 
     uint32_t order = get_order( allocator,
                                 sizeof( *page_manager->moved_page_id_mapping )
-                                * allocator->n_pages_capacity );
+                                * allocator->n_pages_movable );
 
     lock_allocator( allocator );
-    SCOREP_Allocator_Page* page = get_page( allocator, order );
+    SCOREP_Allocator_Page* page = get_page( allocator, order, allocator->n_pages_capacity );
     unlock_allocator( allocator );
 
     if ( !page )
@@ -585,13 +963,20 @@ SCOREP_Allocator_DeletePageManager( SCOREP_Allocator_PageManager* pageManager )
     assert( pageManager );
     SCOREP_Allocator_Allocator* allocator = pageManager->allocator;
 
-    SCOREP_Allocator_Page* page = pageManager->pages_in_use_list;
+    SCOREP_ATOMIC_FETCH_SUB( &allocator->n_pages_cached, pageManager->n_cached_pages,
+                             SCOREP_ATOMIC_RELAXED );
+
     lock_allocator( allocator );
-    while ( page )
+    SCOREP_Allocator_Page* lists[] = { pageManager->pages_in_use_list, pageManager->cached_pages };
+    for ( size_t i = 0; i < sizeof( lists ) / sizeof( lists[ 0 ] ); i++ )
     {
-        SCOREP_Allocator_Page* next_page = page->next;
-        put_page( allocator, page );
-        page = next_page;
+        SCOREP_Allocator_Page* page = lists[ i ];
+        while ( page )
+        {
+            SCOREP_Allocator_Page* next_page = page->next;
+            put_page( allocator, page );
+            page = next_page;
+        }
     }
 
     if ( pageManager->moved_page_id_mapping )
@@ -601,7 +986,7 @@ SCOREP_Allocator_DeletePageManager( SCOREP_Allocator_PageManager* pageManager )
         uint32_t page_id = offset >> allocator->page_shift;
         uint32_t order   = get_order( allocator,
                                       sizeof( *pageManager->moved_page_id_mapping )
-                                      * allocator->n_pages_capacity );
+                                      * allocator->n_pages_movable );
         if ( order == 1 )
         {
             track_bitset_clear( allocator, page_id );
@@ -623,7 +1008,8 @@ void*
 SCOREP_Allocator_Alloc( SCOREP_Allocator_PageManager* pageManager,
                         size_t                        memorySize )
 {
-    return page_manager_alloc( pageManager, memorySize );
+    return page_manager_alloc( pageManager, memorySize,
+                               pageManager->allocator->n_pages_capacity );
 }
 
 
@@ -634,21 +1020,28 @@ SCOREP_Allocator_Free( SCOREP_Allocator_PageManager* pageManager )
     assert( pageManager );
     assert( pageManager->allocator );
 
-    lock_allocator( pageManager->allocator );
+    /* Keep pages up to the cache limits for the next allocations of this
+     * page manager, the remaining ones go back to the allocator */
+    SCOREP_Allocator_Page* released_pages = NULL;
     while ( pageManager->pages_in_use_list )
     {
-        SCOREP_Allocator_Page* next_page = pageManager->pages_in_use_list->next;
-        put_page( pageManager->allocator, pageManager->pages_in_use_list );
-        pageManager->pages_in_use_list = next_page;
+        SCOREP_Allocator_Page* page  = pageManager->pages_in_use_list;
+        uint32_t               order = get_page_order( page );
+        pageManager->pages_in_use_list = page->next;
+        if ( !cache_page( pageManager, page, order ) )
+        {
+            page->next     = released_pages;
+            released_pages = page;
+        }
     }
-    unlock_allocator( pageManager->allocator );
+    put_pages( pageManager->allocator, released_pages );
 
     if ( pageManager->moved_page_id_mapping )
     {
         memset( pageManager->moved_page_id_mapping,
                 0,
                 sizeof( *pageManager->moved_page_id_mapping )
-                * pageManager->allocator->n_pages_capacity );
+                * pageManager->allocator->n_pages_movable );
     }
 
     pageManager->last_allocation = 0;
@@ -661,7 +1054,8 @@ SCOREP_Allocator_AllocMovable( SCOREP_Allocator_PageManager* pageManager,
                                size_t                        memorySize )
 {
     /// @todo padding?
-    void* memory = page_manager_alloc( pageManager, memorySize );
+    void* memory = page_manager_alloc( pageManager, memorySize,
+                                       pageManager->allocator->n_pages_movable );
     if ( !memory )
     {
         UTILS_DEBUG_EXIT( "out-of-memory" );
@@ -682,11 +1076,12 @@ SCOREP_Allocator_AllocMovedPage( SCOREP_Allocator_PageManager* movedPageManager,
     assert( movedPageManager );
     assert( movedPageManager->moved_page_id_mapping != 0 );
     assert( moved_page_id != 0 );
-    assert( moved_page_id < movedPageManager->allocator->n_pages_capacity );
+    assert( moved_page_id < movedPageManager->allocator->n_pages_movable );
     assert( movedPageManager->moved_page_id_mapping[ moved_page_id ] == 0 );
 
     SCOREP_Allocator_Page* page = page_manager_get_new_page( movedPageManager,
-                                                             page_usage );
+                                                             page_usage,
+                                                             movedPageManager->allocator->n_pages_movable );
     if ( !page )
     {
         UTILS_DEBUG_EXIT( "out-of-memory: no free page" );
@@ -850,12 +1245,18 @@ SCOREP_Allocator_GetPageManagerStats( const SCOREP_Allocator_PageManager* pageMa
             }
             page = page->next;
         }
+        /* kept pages are allocated but not used */
+        stats->pages_allocated += pageManager->n_cached_pages;
+        for ( page = pageManager->cached_pages; page; page = page->next )
+        {
+            stats->memory_allocated += get_page_length( page );
+        }
 
         if ( pageManager->moved_page_id_mapping ) /* moved page manager */
         {
             uint32_t order = get_order( pageManager->allocator,
                                         sizeof( *pageManager->moved_page_id_mapping )
-                                        * pageManager->allocator->n_pages_capacity );
+                                        * pageManager->allocator->n_pages_movable );
             stats->pages_allocated += order;
         }
     }
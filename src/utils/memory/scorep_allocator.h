@@ -74,6 +74,28 @@ struct SCOREP_Allocator_Allocator
     //uint32_t union_size;
     //uint32_t reserved;
 
+    /** pages below this id can be addressed by movable memory */
+    uint32_t n_pages_movable;
+    /** pages below this id are backed by memory, arena allocators only */
+    uint32_t n_pages_committed;
+    /** the committed memory grows by this many pages, arena allocators only */
+    uint32_t n_pages_per_arena;
+    /** number of pages a page manager keeps after freeing them */
+    uint32_t n_pages_cache_limit;
+    /** number of pages all page managers together keep */
+    uint32_t n_pages_cache_limit_total;
+    /** number of pages currently kept by all page managers, updated
+        atomically without the allocator lock */
+    uint32_t n_pages_cached;
+    /** release freed pages to the OS, the next user touches them first */
+    bool     release_freed_pages;
+    /** advise the OS to back the arenas with huge pages */
+    bool     huge_pages;
+
+    /** the reserved address range of an arena allocator, NULL if calloc'ed */
+    void*  mapping;
+    size_t mapping_size;
+
     /** free objects */
     SCOREP_Allocator_Object*     free_objects;
 
@@ -93,6 +115,10 @@ struct SCOREP_Allocator_PageManager
     /* sentinel which allocation could be rolled back */
     /* only movable allocations currently */
     SCOREP_Allocator_MovableMemory last_allocation;
+
+    /* freed pages kept for this page manager, see n_pages_cache_limit */
+    uint32_t                       n_cached_pages;
+    SCOREP_Allocator_Page*         cached_pages;
 };
 
 
@@ -112,7 +138,7 @@ union SCOREP_Allocator_Object
     union SCOREP_Allocator_Object*        next;
     /* 32: 24, 64: 40 */
     struct SCOREP_Allocator_Page          page;
-    /* 32: 16, 64: 32 */
+    /* 32: 24, 64: 40 */
     struct SCOREP_Allocator_PageManager   page_manager;
     /* 32: 16, 64: 32 */
     struct SCOREP_Allocator_ObjectManager object_manager;
@@ -53,10 +53,10 @@ page_size( const SCOREP_Allocator_Allocator* allocator )
 }
 
 
-static inline uint32_t
+static inline uint64_t
 total_memory( const SCOREP_Allocator_Allocator* allocator )
 {
-    return allocator->n_pages_capacity << allocator->page_shift;
+    return ( uint64_t )allocator->n_pages_capacity << allocator->page_shift;
 }
 
 
@@ -105,7 +105,7 @@ init_page( SCOREP_Allocator_Allocator* allocator,
            uint32_t                    order )
 {
     page->allocator            = allocator;
-    page->memory_start_address = ( char* )allocator + ( id << allocator->page_shift );
+    page->memory_start_address = ( char* )allocator + ( ( size_t )id << allocator->page_shift );
     set_page_usage( page, 0 );
     set_page_order( page, order );
     page->next = NULL;
@@ -0,0 +1,262 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Measures the cost of filter lookups for large region filter files.
+ *
+ * Generates filter files with an increasing number of rules, mixing exact,
+ * prefix, and general wildcard patterns in alternating EXCLUDE and INCLUDE
+ * blocks, as produced by generated C++ filter files. Reports the time per
+ * SCOREP_Filter_MatchFunction call and compares it, and the results, with a
+ * sequential evaluation of all rules with fnmatch.
+ *
+ * Exits with a non-zero status if the results differ.
+ */
+
+#include <config.h>
+
+#include <SCOREP_Filter.h>
+
+#include <fnmatch.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NUM_NAMES           20000
+#define NUM_REFERENCE_NAMES 2000
+#define RULES_PER_BLOCK     50
+
+static const unsigned rule_counts[] = { 10, 100, 1000, 10000 };
+
+typedef struct
+{
+    char* pattern;
+    bool  is_exclude;
+} rule;
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static char*
+make_name( unsigned i )
+{
+    char buffer[ 128 ];
+    sprintf( buffer, "ns%u::Class%u<int>::method%u_helper%u(double)",
+             i % 7, i % 211, i, i % 13 );
+    return strdup( buffer );
+}
+
+static char*
+make_pattern( unsigned i,
+              unsigned numberOfNames )
+{
+    char     buffer[ 128 ];
+    unsigned n = ( i * 7919u ) % numberOfNames;
+    switch ( i % 10 )
+    {
+        case 0:
+            sprintf( buffer, "*method%u_helper*", n );
+            break;
+        case 9:
+            sprintf( buffer, "ns?::Class%u<[a-z]*>::method*", n % 211 );
+            break;
+        case 1:
+        case 2:
+        case 3:
+            sprintf( buffer, "ns%u::Class%u<int>::*", n % 7, n % 211 );
+            break;
+        default:
+        {
+            char* name = make_name( n );
+            strcpy( buffer, name );
+            free( name );
+        }
+    }
+    return strdup( buffer );
+}
+
+/* Evaluates all rules in order, like the filter did before rules were compiled */
+static bool
+sequential_match( const rule* rules,
+                  unsigned    numberOfRules,
+                  const char* name )
+{
+    bool excluded = false;
+    for ( unsigned i = 0; i < numberOfRules; i++ )
+    {
+        if ( !excluded && rules[ i ].is_exclude )
+        {
+            excluded = fnmatch( rules[ i ].pattern, name, 0 ) == 0;
+        }
+        else if ( excluded && !rules[ i ].is_exclude )
+        {
+            excluded = fnmatch( rules[ i ].pattern, name, 0 ) != 0;
+        }
+    }
+    return excluded;
+}
+
+static bool
+sequential_include( const rule* rules,
+                    unsigned    numberOfRules,
+                    const char* name )
+{
+    bool explicitly_included = false;
+    for ( unsigned i = 0; i < numberOfRules; i++ )
+    {
+        if ( fnmatch( rules[ i ].pattern, name, 0 ) == 0 )
+        {
+            if ( rules[ i ].is_exclude )
+            {
+                explicitly_included = false;
+            }
+            else if ( strcmp( rules[ i ].pattern, "*" ) != 0 )
+            {
+                explicitly_included = true;
+            }
+        }
+    }
+    return !sequential_match( rules, numberOfRules, name ) && explicitly_included;
+}
+
+static bool
+run( unsigned numberOfRules,
+     char**   names )
+{
+    rule* rules = calloc( numberOfRules, sizeof( *rules ) );
+
+    char filter_file_name[] = "filter_matching_benchmark_XXXXXX";
+    int  fd                 = mkstemp( filter_file_name );
+    if ( fd == -1 )
+    {
+        perror( "mkstemp" );
+        exit( EXIT_FAILURE );
+    }
+    FILE* filter_file = fdopen( fd, "w" );
+    fprintf( filter_file, "SCOREP_REGION_NAMES_BEGIN\n" );
+    for ( unsigned i = 0; i < numberOfRules; i++ )
+    {
+        /* Every INCLUDE block starts with 'INCLUDE *' once in a while */
+        rules[ i ].pattern = i % ( 4 * RULES_PER_BLOCK ) == RULES_PER_BLOCK
+                             ? strdup( "*" )
+                             : make_pattern( i, NUM_NAMES );
+        rules[ i ].is_exclude = ( i / RULES_PER_BLOCK ) % 2 == 0;
+        fprintf( filter_file, "  %s %s\n",
+                 rules[ i ].is_exclude ? "EXCLUDE" : "INCLUDE",
+                 rules[ i ].pattern );
+    }
+    fprintf( filter_file, "SCOREP_REGION_NAMES_END\n" );
+    fclose( filter_file );
+
+    SCOREP_Filter* filter = SCOREP_Filter_New();
+    double         start  = get_time();
+    if ( SCOREP_Filter_ParseFile( filter, filter_file_name ) != SCOREP_SUCCESS )
+    {
+        fprintf( stderr, "Failed to parse filter file\n" );
+        exit( EXIT_FAILURE );
+    }
+    double parse_time = get_time() - start;
+    unlink( filter_file_name );
+
+    unsigned filtered = 0;
+    start = get_time();
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        int result;
+        SCOREP_Filter_MatchFunction( filter, names[ i ], NULL, &result );
+        filtered += result;
+    }
+    double compiled_time = get_time() - start;
+
+    bool* expected = calloc( NUM_REFERENCE_NAMES, sizeof( *expected ) );
+    start = get_time();
+    for ( unsigned i = 0; i < NUM_REFERENCE_NAMES; i++ )
+    {
+        expected[ i ] = sequential_match( rules, numberOfRules, names[ i ] );
+    }
+    double sequential_time = get_time() - start;
+
+    bool correct = true;
+    for ( unsigned i = 0; i < NUM_REFERENCE_NAMES; i++ )
+    {
+        int result;
+        SCOREP_Filter_MatchFunction( filter, names[ i ], NULL, &result );
+        if ( ( bool )result != expected[ i ] )
+        {
+            fprintf( stderr, "Mismatch for '%s': expected %d, got %d\n",
+                     names[ i ], expected[ i ], result );
+            correct = false;
+        }
+
+        bool included = sequential_include( rules, numberOfRules, names[ i ] );
+        SCOREP_Filter_IncludeFunction( filter, names[ i ], NULL, &result );
+        if ( ( bool )result != included )
+        {
+            fprintf( stderr, "Include mismatch for '%s': expected %d, got %d\n",
+                     names[ i ], included, result );
+            correct = false;
+        }
+    }
+
+    printf( "rules %6u: parse %10.1f us, compiled %8.1f ns per name, "
+            "sequential %10.1f ns per name, %u of %u names filtered\n",
+            numberOfRules,
+            parse_time / 1e3,
+            compiled_time / NUM_NAMES,
+            sequential_time / NUM_REFERENCE_NAMES,
+            filtered, NUM_NAMES );
+
+    SCOREP_Filter_Delete( filter );
+    free( expected );
+    for ( unsigned i = 0; i < numberOfRules; i++ )
+    {
+        free( rules[ i ].pattern );
+    }
+    free( rules );
+
+    return correct;
+}
+
+int
+main()
+{
+    char** names = calloc( NUM_NAMES, sizeof( *names ) );
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        names[ i ] = make_name( i );
+    }
+
+    bool correct = true;
+    for ( size_t i = 0; i < sizeof( rule_counts ) / sizeof( rule_counts[ 0 ] ); i++ )
+    {
+        correct &= run( rule_counts[ i ], names );
+    }
+
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        free( names[ i ] );
+    }
+    free( names );
+
+    return correct ? EXIT_SUCCESS : EXIT_FAILURE;
+}
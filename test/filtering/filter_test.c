@@ -94,6 +94,16 @@ main()
     filter_not1();
     filter_not2();
     by_name( "filter_not3", "6" );
+    by_name( "filtered_ax_posix_class_bracket", "7" );
+    by_name( "filter_not_1x_posix_class_bracket", "8" );
+    by_name( "filtered_ay_negated_bracket", "9" );
+    by_name( "filter_not_1y_negated_bracket", "10" );
+    by_name( "filtered_]z_closing_bracket", "11" );
+    by_name( "filter_not_bz_closing_bracket", "12" );
+    by_name( "filtered_[v]_escaped_bracket", "13" );
+    by_name( "filter_not_v_escaped_bracket", "14" );
+    by_name( "filtered_]q_escaped_in_bracket", "15" );
+    by_name( "filter_not_q_escaped_in_bracket", "16" );
     SCOREP_USER_FUNC_END();
     return 0;
 }
@@ -0,0 +1,256 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @ file
+ *
+ * @brief Compares SCOREP_Hashtab and SCOREP_ConcurrentHashtab.
+ *
+ * Inserts an increasing number of region names into both tables, created
+ * with the small initial size the adapters use, and reports the time per
+ * insertion and per successful lookup. Afterwards, reader threads look up
+ * names while the main thread inserts new ones, once without locks into a
+ * SCOREP_ConcurrentHashtab and once guarded by a mutex for SCOREP_Hashtab,
+ * which is what the latter requires. Reports the lookups per second of all
+ * readers.
+ *
+ * Exits with a non-zero status if a lookup fails.
+ */
+
+#include <config.h>
+
+#include <SCOREP_Hashtab.h>
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define INITIAL_SIZE    128
+#define NUM_READERS     4
+#define CONCURRENT_KEYS 200000
+
+static const unsigned key_counts[] = { 1000, 10000, 100000 };
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static char**
+make_names( unsigned numberOfNames )
+{
+    char** names = malloc( numberOfNames * sizeof( *names ) );
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        char buffer[ 128 ];
+        sprintf( buffer, "ns%u::Class%u<int>::method%u(double)", i % 7, i % 211, i );
+        names[ i ] = strdup( buffer );
+    }
+    return names;
+}
+
+static void
+free_names( char**   names,
+            unsigned numberOfNames )
+{
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        free( names[ i ] );
+    }
+    free( names );
+}
+
+static void
+fail( const char* table,
+      const char* name )
+{
+    fprintf( stderr, "%s: lookup of '%s' failed\n", table, name );
+    exit( EXIT_FAILURE );
+}
+
+static void
+benchmark_sequential( unsigned numberOfNames )
+{
+    char** names = make_names( numberOfNames );
+
+    SCOREP_Hashtab* table = SCOREP_Hashtab_CreateSize( INITIAL_SIZE,
+                                                       &SCOREP_Hashtab_HashString,
+                                                       &SCOREP_Hashtab_CompareStrings );
+    double start = get_time();
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        SCOREP_Hashtab_InsertPtr( table, names[ i ], names[ i ], NULL );
+    }
+    double insert = get_time();
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        if ( !SCOREP_Hashtab_Find( table, names[ i ], NULL ) )
+        {
+            fail( "SCOREP_Hashtab", names[ i ] );
+        }
+    }
+    double find = get_time();
+    SCOREP_Hashtab_Free( table );
+
+    SCOREP_ConcurrentHashtab* concurrent_table =
+        SCOREP_ConcurrentHashtab_CreateSize( INITIAL_SIZE,
+                                             &SCOREP_Hashtab_HashString,
+                                             &SCOREP_Hashtab_CompareStrings );
+    double concurrent_start = get_time();
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        SCOREP_ConcurrentHashtab_InsertPtr( concurrent_table, names[ i ], names[ i ], NULL );
+    }
+    double concurrent_insert = get_time();
+    for ( unsigned i = 0; i < numberOfNames; i++ )
+    {
+        if ( !SCOREP_ConcurrentHashtab_Find( concurrent_table, names[ i ], NULL ) )
+        {
+            fail( "SCOREP_ConcurrentHashtab", names[ i ] );
+        }
+    }
+    double concurrent_find = get_time();
+    SCOREP_ConcurrentHashtab_Free( concurrent_table );
+
+    printf( "keys %8u: Hashtab insert %8.1f ns find %8.1f ns, "
+            "ConcurrentHashtab insert %6.1f ns find %6.1f ns\n",
+            numberOfNames,
+            ( insert - start ) / numberOfNames,
+            ( find - insert ) / numberOfNames,
+            ( concurrent_insert - concurrent_start ) / numberOfNames,
+            ( concurrent_find - concurrent_insert ) / numberOfNames );
+
+    free_names( names, numberOfNames );
+}
+
+
+/* Shared state of the concurrent part */
+static char**                    concurrent_names;
+static unsigned                  inserted;
+static bool                      done;
+static pthread_mutex_t           table_mutex = PTHREAD_MUTEX_INITIALIZER;
+static SCOREP_Hashtab*           locked_table;
+static SCOREP_ConcurrentHashtab* lock_free_table;
+
+/* Readers only look for names which were inserted before, and count them. */
+static void*
+reader( void* arg )
+{
+    bool     use_lock = arg != NULL;
+    uint64_t lookups  = 0;
+    unsigned seed     = ( unsigned )( uintptr_t )&lookups;
+    while ( !__atomic_load_n( &done, __ATOMIC_ACQUIRE ) )
+    {
+        unsigned available = __atomic_load_n( &inserted, __ATOMIC_ACQUIRE );
+        if ( available == 0 )
+        {
+            continue;
+        }
+        const char*           name = concurrent_names[ rand_r( &seed ) % available ];
+        SCOREP_Hashtab_Entry* entry;
+        if ( use_lock )
+        {
+            pthread_mutex_lock( &table_mutex );
+            entry = SCOREP_Hashtab_Find( locked_table, name, NULL );
+            pthread_mutex_unlock( &table_mutex );
+        }
+        else
+        {
+            entry = SCOREP_ConcurrentHashtab_Find( lock_free_table, name, NULL );
+        }
+        if ( !entry || strcmp( entry->value.ptr, name ) != 0 )
+        {
+            fail( use_lock ? "SCOREP_Hashtab" : "SCOREP_ConcurrentHashtab", name );
+        }
+        lookups++;
+    }
+    return ( void* )( uintptr_t )lookups;
+}
+
+static void
+benchmark_concurrent( bool useLock )
+{
+    pthread_t readers[ NUM_READERS ];
+    uint64_t  lookups = 0;
+
+    inserted = 0;
+    done     = false;
+    for ( int i = 0; i < NUM_READERS; i++ )
+    {
+        pthread_create( &readers[ i ], NULL, reader, useLock ? &useLock : NULL );
+    }
+
+    double start = get_time();
+    for ( unsigned i = 0; i < CONCURRENT_KEYS; i++ )
+    {
+        if ( useLock )
+        {
+            pthread_mutex_lock( &table_mutex );
+            SCOREP_Hashtab_InsertPtr( locked_table, concurrent_names[ i ], concurrent_names[ i ], NULL );
+            pthread_mutex_unlock( &table_mutex );
+        }
+        else
+        {
+            SCOREP_ConcurrentHashtab_InsertPtr( lock_free_table, concurrent_names[ i ], concurrent_names[ i ], NULL );
+        }
+        __atomic_store_n( &inserted, i + 1, __ATOMIC_RELEASE );
+    }
+    double end = get_time();
+    __atomic_store_n( &done, true, __ATOMIC_RELEASE );
+
+    for ( int i = 0; i < NUM_READERS; i++ )
+    {
+        void* result;
+        pthread_join( readers[ i ], &result );
+        lookups += ( uintptr_t )result;
+    }
+
+    printf( "%d readers during %u inserts into %-27s: %8.2f M lookups/s, %8.1f ns per insert\n",
+            NUM_READERS, CONCURRENT_KEYS,
+            useLock ? "locked Hashtab" : "lock-free ConcurrentHashtab",
+            lookups / ( ( end - start ) / 1e3 ),
+            ( end - start ) / CONCURRENT_KEYS );
+}
+
+int
+main()
+{
+    for ( size_t i = 0; i < sizeof( key_counts ) / sizeof( key_counts[ 0 ] ); i++ )
+    {
+        benchmark_sequential( key_counts[ i ] );
+    }
+
+    concurrent_names = make_names( CONCURRENT_KEYS );
+
+    locked_table = SCOREP_Hashtab_CreateSize( INITIAL_SIZE,
+                                              &SCOREP_Hashtab_HashString,
+                                              &SCOREP_Hashtab_CompareStrings );
+    benchmark_concurrent( true );
+    SCOREP_Hashtab_Free( locked_table );
+
+    lock_free_table = SCOREP_ConcurrentHashtab_CreateSize( INITIAL_SIZE,
+                                                           &SCOREP_Hashtab_HashString,
+                                                           &SCOREP_Hashtab_CompareStrings );
+    benchmark_concurrent( false );
+    SCOREP_ConcurrentHashtab_Free( lock_free_table );
+
+    free_names( concurrent_names, CONCURRENT_KEYS );
+
+    return EXIT_SUCCESS;
+}
@@ -21,6 +21,8 @@
 #include <config.h>
 #include <SCOREP_Hashtab.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
 
 /* Simple hashfunction which returns the pointer address as hash value */
 size_t
@@ -44,6 +46,72 @@ procfunc( SCOREP_Hashtab_Entry* entry )
     printf( "value: %d, key: %d\n", *v, *k );
 }
 
+/* Counts the entries of the concurrent hash table */
+static size_t concurrent_entries = 0;
+
+void
+countfunc( SCOREP_Hashtab_Entry* entry )
+{
+    if ( *( uint64_t* )entry->key != entry->value.uint64 )
+    {
+        printf( "Entry %" PRIu64 " has value %" PRIu64 "\n",
+                *( uint64_t* )entry->key, entry->value.uint64 );
+        exit( 1 );
+    }
+    concurrent_entries++;
+}
+
+/* Lets the concurrent hash table grow several times, while checking
+   that all entries are still found */
+static void
+test_concurrent_hashtab( void )
+{
+    enum { N = 100000 };
+    static uint64_t           keys[ N ];
+    SCOREP_ConcurrentHashtab* ht = SCOREP_ConcurrentHashtab_CreateSize( 4,
+                                                                        &SCOREP_Hashtab_HashInt64,
+                                                                        &SCOREP_Hashtab_CompareUint64 );
+    for ( uint64_t i = 0; i < N; i++ )
+    {
+        keys[ i ] = i * 4096;
+        SCOREP_ConcurrentHashtab_InsertUint64( ht, &keys[ i ], keys[ i ], NULL );
+
+        /* Probe older entries, also while the table grows */
+        uint64_t probe = keys[ i / 2 ];
+        if ( !SCOREP_ConcurrentHashtab_Find( ht, &probe, NULL ) )
+        {
+            printf( "Concurrent hash table lost key %" PRIu64 "\n", probe );
+            exit( 1 );
+        }
+    }
+
+    for ( uint64_t i = 0; i < N; i++ )
+    {
+        SCOREP_Hashtab_Entry* e = SCOREP_ConcurrentHashtab_Find( ht, &keys[ i ], NULL );
+        if ( !e || e->key != &keys[ i ] )
+        {
+            printf( "Concurrent hash table lost key %" PRIu64 "\n", keys[ i ] );
+            exit( 1 );
+        }
+    }
+    uint64_t missing = 1;
+    if ( SCOREP_ConcurrentHashtab_Find( ht, &missing, NULL ) )
+    {
+        printf( "Concurrent hash table found missing key\n" );
+        exit( 1 );
+    }
+
+    SCOREP_ConcurrentHashtab_Foreach( ht, &countfunc );
+    printf( "Concurrent hashtable size %d, visited %d\n",
+            ( int )SCOREP_ConcurrentHashtab_Size( ht ), ( int )concurrent_entries );
+    if ( concurrent_entries != N || SCOREP_ConcurrentHashtab_Size( ht ) != N )
+    {
+        exit( 1 );
+    }
+
+    SCOREP_ConcurrentHashtab_Free( ht );
+}
+
 /* Main program for hash table test */
 int
 main()
@@ -85,5 +153,7 @@ main()
     /* String hash function */
     char* str = "Hallo Welt";
     printf( "String hash: %d\n", ( int )SCOREP_Hashtab_HashString( str ) );
+
+    test_concurrent_hashtab();
     return 0;
 }
@@ -448,13 +448,37 @@ tc_duplicate_handle( CuTest* tc )
     SCOREP_IoMgmt_DestroyHandle( new_handle );
 }
 
+static void
+tc_negative_fd( CuTest* tc )
+{
+    /* e.g., fileno() of a memory stream */
+    int fd = -1;
+
+    SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
+                                       SCOREP_IO_HANDLE_FLAG_NONE,
+                                       SCOREP_INVALID_INTERIM_COMMUNICATOR,
+                                       0, "" );
+    SCOREP_IoFileHandle   file   = SCOREP_Definitions_NewIoFile( "/tmp", SCOREP_INVALID_SYSTEM_TREE_NODE );
+    SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_CompleteHandleCreation(
+        SCOREP_IO_PARADIGM_POSIX, file, &fd );
+    CuAssertIntNotEquals( tc, handle, SCOREP_INVALID_IO_HANDLE );
+
+    SCOREP_IoHandleHandle tmp_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
+    CuAssertIntEquals( tc, tmp_handle, SCOREP_INVALID_IO_HANDLE );
+
+    tmp_handle = SCOREP_IoMgmt_RemoveHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
+    CuAssertIntEquals( tc, tmp_handle, SCOREP_INVALID_IO_HANDLE );
+
+    SCOREP_IoMgmt_DestroyHandle( handle );
+}
+
 static inline void
 init( void )
 {
     SCOREP_IoMgmt_RegisterParadigm( SCOREP_IO_PARADIGM_POSIX,
                                     SCOREP_IO_PARADIGM_CLASS_SERIAL,
                                     "POSIX I/O",
-                                    SCOREP_IO_PARADIGM_FLAG_NONE,
+                                    SCOREP_IO_PARADIGM_FLAG_OS,
                                     sizeof( int ),
                                     SCOREP_IO_PARADIGM_PROPERTY_VERSION, "2.3",
                                     SCOREP_INVALID_IO_PARADIGM_PROPERTY );
@@ -497,6 +521,7 @@ main()
     SUITE_ADD_TEST_NAME( suite, tc_reinsert_handle, "mgmt: reinsert handle" );
     SUITE_ADD_TEST_NAME( suite, tc_remove_handle, "mgmt: remove handle" );
     SUITE_ADD_TEST_NAME( suite, tc_duplicate_handle, "mgmt: duplicate handle" );
+    SUITE_ADD_TEST_NAME( suite, tc_negative_fd, "mgmt: negative file descriptor" );
     SUITE_ADD_TEST_NAME( suite, tc_open, "wrapper: open" );
     SUITE_ADD_TEST_NAME( suite, tc_close, "wrapper: close" );
     SUITE_ADD_TEST_NAME( suite, tc_duplicate, "wrapper: duplicate" );
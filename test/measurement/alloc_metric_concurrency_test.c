@@ -0,0 +1,340 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Frees allocations of an alloc metric on other threads than the one
+ * which allocated them.
+ *
+ * Every thread allocates batches, and frees the batches of its neighbor
+ * thread while allocating the next one. Before freeing, an allocation is
+ * moved by a reallocation to an address of another shard. Thus items go to
+ * the free lists of other shards than they were allocated from, while the
+ * threads reuse them. Every allocation needs
+ * to be found with the right size, and the metric needs to return to zero.
+ *
+ * The measurement is replaced by the definitions below, as the events of all
+ * threads would be recorded on the sole location of the thread mockup.
+ */
+
+#include <config.h>
+
+#include <SCOREP_AllocMetric.h>
+#include <SCOREP_RuntimeManagement.h>
+#include <SCOREP_Definitions.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_Events.h>
+#include <SCOREP_Memory.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#define NUM_THREADS     4
+#define NUM_BATCHES     100
+#define BATCH_SIZE      250
+#define NUM_ALLOCATIONS ( NUM_THREADS * NUM_BATCHES * BATCH_SIZE )
+#define NUM_LEAKED      100
+
+#define ALLOCATION( thread, batch, i ) \
+    ( ( ( batch ) * NUM_THREADS + ( thread ) ) * BATCH_SIZE + ( i ) )
+
+/* Fake addresses, aligned like the ones of malloc */
+#define ADDRESS( i )       ( UINT64_C( 0x10000000 ) + ( uint64_t )( i ) * 16 )
+#define MOVED_ADDRESS( i ) ( ADDRESS( i ) + UINT64_C( 0x1000000 ) )
+#define SIZE( i )          ( ( size_t )( i ) % 1000 + 1 )
+#define MOVED_SIZE( i )    ( SIZE( i ) + 1 )
+
+static SCOREP_AllocMetric* metric;
+
+/* Number of batches each thread has allocated */
+static pthread_mutex_t batches_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  batches_cond = PTHREAD_COND_INITIALIZER;
+static unsigned        allocated_batches[ NUM_THREADS ];
+
+static pthread_mutex_t metrics_location_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t        triggered_total;
+static uint64_t        triggered_peak;
+static uint64_t        leaked_count;
+
+
+void*
+SCOREP_Memory_AllocForMisc( size_t size )
+{
+    return malloc( size );
+}
+
+SCOREP_MetricHandle
+SCOREP_Definitions_NewMetric( const char*                name,
+                              const char*                description,
+                              SCOREP_MetricSourceType    sourceType,
+                              SCOREP_MetricMode          mode,
+                              SCOREP_MetricValueType     valueType,
+                              SCOREP_MetricBase          base,
+                              int64_t                    exponent,
+                              const char*                unit,
+                              SCOREP_MetricProfilingType profilingType,
+                              SCOREP_MetricHandle        parentHandle )
+{
+    return 1;
+}
+
+SCOREP_SamplingSetHandle
+SCOREP_Definitions_NewSamplingSet( uint8_t                    numberOfMetrics,
+                                   const SCOREP_MetricHandle* metrics,
+                                   SCOREP_MetricOccurrence    occurrence,
+                                   SCOREP_SamplingSetClass    klass )
+{
+    return 1;
+}
+
+SCOREP_SamplingSetHandle
+SCOREP_Definitions_NewScopedSamplingSet( SCOREP_SamplingSetHandle samplingSet,
+                                         SCOREP_LocationHandle    recorderHandle,
+                                         SCOREP_MetricScope       scopeType,
+                                         SCOREP_AnyHandle         scopeHandle )
+{
+    return 2;
+}
+
+SCOREP_AttributeHandle
+SCOREP_Definitions_NewAttribute( const char*          name,
+                                 const char*          description,
+                                 SCOREP_AttributeType type )
+{
+    return 1;
+}
+
+SCOREP_LocationGroupHandle
+SCOREP_GetLocationGroup( void )
+{
+    return 1;
+}
+
+SCOREP_Location*
+SCOREP_Location_AcquirePerProcessMetricsLocation( uint64_t* timestamp )
+{
+    pthread_mutex_lock( &metrics_location_lock );
+    if ( timestamp )
+    {
+        *timestamp = 0;
+    }
+    return NULL;
+}
+
+void
+SCOREP_Location_ReleasePerProcessMetricsLocation( void )
+{
+    pthread_mutex_unlock( &metrics_location_lock );
+}
+
+SCOREP_LocationHandle
+SCOREP_Location_GetLocationHandle( SCOREP_Location* locationData )
+{
+    return 1;
+}
+
+/* Called while the per-process metrics location is acquired */
+void
+SCOREP_Location_TriggerCounterUint64( SCOREP_Location*         location,
+                                      uint64_t                 timestamp,
+                                      SCOREP_SamplingSetHandle counterHandle,
+                                      uint64_t                 value )
+{
+    triggered_total = value;
+    if ( value > triggered_peak )
+    {
+        triggered_peak = value;
+    }
+}
+
+void
+SCOREP_TrackAlloc( uint64_t addrAllocated,
+                   size_t   bytesAllocated,
+                   void*    substrateData[],
+                   size_t   bytesAllocatedMetric,
+                   size_t   bytesAllocatedProcess )
+{
+}
+
+void
+SCOREP_TrackRealloc( uint64_t oldAddr,
+                     size_t   oldBytesAllocated,
+                     void*    oldSubstrateData[],
+                     uint64_t newAddr,
+                     size_t   newBytesAllocated,
+                     void*    newSubstrateData[],
+                     size_t   bytesAllocatedMetric,
+                     size_t   bytesAllocatedProcess )
+{
+}
+
+void
+SCOREP_TrackFree( uint64_t addrFreed,
+                  size_t   bytesFreed,
+                  void*    substrateData[],
+                  size_t   bytesAllocatedMetric,
+                  size_t   bytesAllocatedProcess )
+{
+}
+
+void
+SCOREP_LeakedMemory( uint64_t addrLeaked,
+                     size_t   bytesLeaked,
+                     void*    substrateData[] )
+{
+    leaked_count++;
+}
+
+
+static void
+acquire( uint64_t address,
+         void**   allocation )
+{
+    SCOREP_AllocMetric_AcquireAlloc( metric, address, allocation );
+    if ( *allocation == NULL )
+    {
+        fprintf( stderr, "Allocation 0x%" PRIx64 " not found.\n", address );
+        exit( EXIT_FAILURE );
+    }
+}
+
+
+static void
+move_and_free( unsigned i )
+{
+    void*    allocation;
+    uint64_t size;
+    acquire( ADDRESS( i ), &allocation );
+    SCOREP_AllocMetric_HandleRealloc( metric, MOVED_ADDRESS( i ), MOVED_SIZE( i ),
+                                      allocation, &size );
+    if ( size != SIZE( i ) )
+    {
+        fprintf( stderr, "Allocation %u reallocated with size %" PRIu64 " instead of %zu.\n",
+                 i, size, SIZE( i ) );
+        exit( EXIT_FAILURE );
+    }
+
+    acquire( MOVED_ADDRESS( i ), &allocation );
+    SCOREP_AllocMetric_HandleFree( metric, allocation, &size );
+    if ( size != MOVED_SIZE( i ) )
+    {
+        fprintf( stderr, "Allocation %u freed with size %" PRIu64 " instead of %zu.\n",
+                 i, size, MOVED_SIZE( i ) );
+        exit( EXIT_FAILURE );
+    }
+}
+
+
+static void
+wait_for_batch( unsigned thread,
+                unsigned batch )
+{
+    pthread_mutex_lock( &batches_lock );
+    while ( allocated_batches[ thread ] <= batch )
+    {
+        pthread_cond_wait( &batches_cond, &batches_lock );
+    }
+    pthread_mutex_unlock( &batches_lock );
+}
+
+
+/* Allocates the batches of this thread, and frees each batch of the neighbor
+ * thread while allocating the next one */
+static void*
+allocate_and_free( void* arg )
+{
+    unsigned thread   = *( unsigned* )arg;
+    unsigned neighbor = ( thread + 1 ) % NUM_THREADS;
+    for ( unsigned batch = 0; batch <= NUM_BATCHES; batch++ )
+    {
+        if ( batch < NUM_BATCHES )
+        {
+            for ( unsigned i = 0; i < BATCH_SIZE; i++ )
+            {
+                SCOREP_AllocMetric_HandleAlloc( metric,
+                                                ADDRESS( ALLOCATION( thread, batch, i ) ),
+                                                SIZE( ALLOCATION( thread, batch, i ) ) );
+            }
+            pthread_mutex_lock( &batches_lock );
+            allocated_batches[ thread ]++;
+            pthread_cond_broadcast( &batches_cond );
+            pthread_mutex_unlock( &batches_lock );
+        }
+        if ( batch > 0 )
+        {
+            wait_for_batch( neighbor, batch - 1 );
+            for ( unsigned i = 0; i < BATCH_SIZE; i++ )
+            {
+                move_and_free( ALLOCATION( neighbor, batch - 1, i ) );
+            }
+        }
+    }
+    return NULL;
+}
+
+
+int
+main( void )
+{
+    SCOREP_AllocMetric_New( "alloc_metric_concurrency_test", &metric );
+
+    pthread_t threads[ NUM_THREADS ];
+    unsigned  indices[ NUM_THREADS ];
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        indices[ i ] = i;
+        if ( pthread_create( &threads[ i ], NULL, allocate_and_free, &indices[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            return EXIT_FAILURE;
+        }
+    }
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        pthread_join( threads[ i ], NULL );
+    }
+
+    int result = EXIT_SUCCESS;
+    if ( triggered_total != 0 )
+    {
+        fprintf( stderr, "Metric is %" PRIu64 " after all frees.\n", triggered_total );
+        result = EXIT_FAILURE;
+    }
+    if ( triggered_peak == 0 || triggered_peak > NUM_ALLOCATIONS * MOVED_SIZE( 999 ) )
+    {
+        fprintf( stderr, "Metric has an impossible peak of %" PRIu64 ".\n", triggered_peak );
+        result = EXIT_FAILURE;
+    }
+
+    /* Reuses the items from the free lists of all shards */
+    for ( unsigned i = 0; i < NUM_LEAKED; i++ )
+    {
+        SCOREP_AllocMetric_HandleAlloc( metric, ADDRESS( i ), SIZE( i ) );
+    }
+    SCOREP_AllocMetric_ReportLeaked( metric );
+    if ( leaked_count != NUM_LEAKED )
+    {
+        fprintf( stderr, "%" PRIu64 " leaks reported instead of %u.\n",
+                 leaked_count, NUM_LEAKED );
+        result = EXIT_FAILURE;
+    }
+
+    printf( "%u allocations freed by other threads, peak of %" PRIu64 " bytes\n",
+            NUM_ALLOCATIONS, triggered_peak );
+
+    SCOREP_AllocMetric_Destroy( metric );
+    return result;
+}
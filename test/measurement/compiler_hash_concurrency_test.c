@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Inserts compiler regions into the region hash table from several
+ * threads.
+ *
+ * Each thread looks up the same set of keys, starting at a different offset,
+ * without a lock and inserts missing keys as the compiler adapters do: take
+ * the region lock, look up again and put. All threads need to get the same
+ * node for a key, and every key needs to be put once.
+ */
+
+#include <config.h>
+
+#include <scorep_compiler_data.h>
+
+#include <SCOREP_Mutex.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_THREADS 4
+#define NUM_KEYS    20000
+#define NUM_ROUNDS  4
+
+typedef struct
+{
+    pthread_t                  thread;
+    unsigned                   offset;
+    unsigned                   puts;
+    scorep_compiler_hash_node* nodes[ NUM_KEYS ];
+} test_thread;
+
+static test_thread threads[ NUM_THREADS ];
+
+static SCOREP_Mutex region_mutex;
+
+
+static uint64_t
+get_key( unsigned index )
+{
+    /* Looks like a function address */
+    return 0x400000 + 16 * ( uint64_t )index;
+}
+
+
+static void*
+insert( void* arg )
+{
+    test_thread* self = arg;
+    for ( unsigned round = 0; round < NUM_ROUNDS; round++ )
+    {
+        for ( unsigned i = 0; i < NUM_KEYS; i++ )
+        {
+            unsigned                   index = ( i + self->offset ) % NUM_KEYS;
+            uint64_t                   key   = get_key( index );
+            scorep_compiler_hash_node* node  = scorep_compiler_hash_get( key );
+            if ( node == NULL )
+            {
+                SCOREP_MutexLock( region_mutex );
+                node = scorep_compiler_hash_get( key );
+                if ( node == NULL )
+                {
+                    char name[ 32 ];
+                    sprintf( name, "function%u", index );
+                    node = scorep_compiler_hash_put( key, name, name, "file.c", index,
+                                                     SCOREP_INVALID_REGION );
+                    self->puts++;
+                }
+                SCOREP_MutexUnlock( region_mutex );
+            }
+
+            if ( node->key != key || node->line_no_begin != index )
+            {
+                fprintf( stderr, "Key %u found the node of line %u.\n",
+                         index, node->line_no_begin );
+                exit( EXIT_FAILURE );
+            }
+            if ( round > 0 && node != self->nodes[ index ] )
+            {
+                fprintf( stderr, "Key %u got a new node.\n", index );
+                exit( EXIT_FAILURE );
+            }
+            self->nodes[ index ] = node;
+        }
+    }
+    return NULL;
+}
+
+
+int
+main( void )
+{
+    SCOREP_MutexCreate( &region_mutex );
+    scorep_compiler_hash_init();
+
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        threads[ i ].offset = i * ( NUM_KEYS / NUM_THREADS );
+        if ( pthread_create( &threads[ i ].thread, NULL, insert, &threads[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            return EXIT_FAILURE;
+        }
+    }
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        pthread_join( threads[ i ].thread, NULL );
+    }
+
+    int      result = EXIT_SUCCESS;
+    unsigned puts   = 0;
+    for ( unsigned j = 0; j < NUM_THREADS; j++ )
+    {
+        puts += threads[ j ].puts;
+    }
+    if ( puts != NUM_KEYS )
+    {
+        fprintf( stderr, "Expected %u puts, got %u.\n", NUM_KEYS, puts );
+        result = EXIT_FAILURE;
+    }
+    for ( unsigned i = 0; i < NUM_KEYS; i++ )
+    {
+        for ( unsigned j = 1; j < NUM_THREADS; j++ )
+        {
+            if ( threads[ j ].nodes[ i ] != threads[ 0 ].nodes[ i ] )
+            {
+                fprintf( stderr, "Threads 0 and %u got different nodes for key %u.\n",
+                         j, i );
+                result = EXIT_FAILURE;
+            }
+        }
+        if ( scorep_compiler_hash_get( get_key( i ) ) != threads[ 0 ].nodes[ i ] )
+        {
+            fprintf( stderr, "Key %u is not in the table.\n", i );
+            result = EXIT_FAILURE;
+        }
+    }
+
+    printf( "%u threads, %u keys, %u rounds: %u puts\n",
+            NUM_THREADS, NUM_KEYS, NUM_ROUNDS, puts );
+
+    scorep_compiler_hash_free();
+    SCOREP_MutexDestroy( &region_mutex );
+    return result;
+}
@@ -0,0 +1,180 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Looks up functions of the executable and of the C library in the
+ * symbol index used for SCOREP_LAZY_SYMBOLS.
+ *
+ * The index maps the file of an object when it reads its symbol table. Thus
+ * the whole-file mappings in /proc/self/maps show which objects were read:
+ * a lookup needs to read only the object containing the address, and only
+ * once.
+ */
+
+#include <config.h>
+
+#include "scorep_compiler_symbol_table.h"
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+/* Counts the mappings of a file at offset 0, of the file with the inode
+ * @a inode, or of all files if @a inode is 0. Returns -1 on error. */
+static int
+count_mappings( ino_t inode )
+{
+    FILE* maps = fopen( "/proc/self/maps", "r" );
+    if ( maps == NULL )
+    {
+        return -1;
+    }
+    int  count = 0;
+    char line[ 4096 ];
+    while ( fgets( line, sizeof( line ), maps ) )
+    {
+        unsigned long long offset;
+        unsigned long long mapped_inode;
+        if ( sscanf( line, "%*s %*s %llx %*s %llu", &offset, &mapped_inode ) == 2
+             && offset == 0 && mapped_inode != 0
+             && ( inode == 0 || mapped_inode == ( unsigned long long )inode ) )
+        {
+            count++;
+        }
+    }
+    fclose( maps );
+    return count;
+}
+
+
+static ino_t
+get_inode( const char* pathname )
+{
+    struct stat st;
+    if ( stat( pathname, &st ) != 0 )
+    {
+        perror( pathname );
+        exit( EXIT_FAILURE );
+    }
+    return st.st_ino;
+}
+
+
+static int errors;
+
+static void
+expect_mappings( const char* when,
+                 const char* object,
+                 ino_t       inode,
+                 int         expected )
+{
+    int count = count_mappings( inode );
+    if ( count != expected )
+    {
+        fprintf( stderr, "%s: %d mappings of %s, expected %d.\n",
+                 when, count, object, expected );
+        errors++;
+    }
+}
+
+
+static void
+expect_lookup( const void* function,
+               const char* expected )
+{
+    const char* name = scorep_compiler_symbol_index_lookup( ( uintptr_t )function );
+    if ( expected == NULL ? name != NULL : name == NULL || strcmp( name, expected ) != 0 )
+    {
+        fprintf( stderr, "Looked up \"%s\" at %p, expected \"%s\".\n",
+                 name ? name : "(null)", function, expected ? expected : "(null)" );
+        errors++;
+    }
+}
+
+
+void __attribute__( ( noinline ) )
+symbol_index_test_function( void )
+{
+    __asm__ volatile ( "" );
+}
+
+
+int
+main( void )
+{
+    if ( count_mappings( 0 ) < 0 )
+    {
+        printf( "/proc/self/maps is not available, skipping.\n" );
+        return 77;
+    }
+
+    /* Functions of the executable may be resolved to PLT entries of the
+     * executable, thus ask the C library itself for the address of qsort */
+    void* libc = dlopen( "libc.so.6", RTLD_NOW | RTLD_NOLOAD );
+    void* qsort_address;
+    if ( libc == NULL || ( qsort_address = dlsym( libc, "qsort" ) ) == NULL )
+    {
+        printf( "The C library is not libc.so.6, skipping.\n" );
+        return 77;
+    }
+    Dl_info libc_info;
+    if ( dladdr( qsort_address, &libc_info ) == 0 || libc_info.dli_fname == NULL )
+    {
+        fprintf( stderr, "No object contains qsort.\n" );
+        return EXIT_FAILURE;
+    }
+
+    ino_t exe_inode  = get_inode( "/proc/self/exe" );
+    ino_t libc_inode = get_inode( libc_info.dli_fname );
+    int   all        = count_mappings( 0 );
+    int   exe        = count_mappings( exe_inode );
+    int   libc_maps  = count_mappings( libc_inode );
+
+    if ( !scorep_compiler_symbol_index_initialize() )
+    {
+        printf( "The symbol index is not supported, skipping.\n" );
+        return 77;
+    }
+    expect_mappings( "After initialization", "all files", 0, all );
+
+    expect_lookup( ( void* )symbol_index_test_function, "symbol_index_test_function" );
+    expect_mappings( "After the first lookup in the executable", "the executable", exe_inode, exe + 1 );
+    expect_mappings( "After the first lookup in the executable", "all files", 0, all + 1 );
+
+    /* Inside a function, but not its start */
+    expect_lookup( ( char* )symbol_index_test_function + 1, NULL );
+    expect_lookup( ( void* )main, "main" );
+    expect_mappings( "After more lookups in the executable", "all files", 0, all + 1 );
+
+    expect_lookup( qsort_address, "qsort" );
+    expect_mappings( "After the first lookup in the C library", "the C library", libc_inode, libc_maps + 1 );
+    expect_mappings( "After the first lookup in the C library", "all files", 0, all + 2 );
+
+    expect_lookup( ( void* )symbol_index_test_function, "symbol_index_test_function" );
+    expect_lookup( qsort_address, "qsort" );
+    expect_mappings( "After repeated lookups", "all files", 0, all + 2 );
+
+    scorep_compiler_symbol_index_finalize();
+    expect_mappings( "After finalization", "all files", 0, all );
+
+    dlclose( libc );
+
+    printf( "symbol index: %s\n", errors == 0 ? "ok" : "failed" );
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
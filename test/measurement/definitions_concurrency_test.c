@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Defines strings and source code locations from several threads.
+ *
+ * Each thread defines the same set of names, starting at a different offset,
+ * thus most definitions are looked up without the definitions lock while
+ * other threads add new ones and the hash tables grow. All threads need to
+ * get the same handle for a name, and every name needs to be defined once.
+ * Reports the time per definition call.
+ */
+
+#include <config.h>
+
+#include <SCOREP_Substrates_Management.h>
+#include <SCOREP_Memory.h>
+#include <SCOREP_Definitions.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NUM_THREADS 4
+#define NUM_NAMES   50000
+#define NUM_ROUNDS  4
+
+static char* names[ NUM_NAMES ];
+
+typedef struct
+{
+    pthread_t                       thread;
+    unsigned                        offset;
+    SCOREP_StringHandle             strings[ NUM_NAMES ];
+    SCOREP_SourceCodeLocationHandle locations[ NUM_NAMES ];
+} test_thread;
+
+static test_thread threads[ NUM_THREADS ];
+
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+static void*
+define( void* arg )
+{
+    test_thread* self = arg;
+    for ( unsigned round = 0; round < NUM_ROUNDS; round++ )
+    {
+        for ( unsigned i = 0; i < NUM_NAMES; i++ )
+        {
+            unsigned index = ( i + self->offset ) % NUM_NAMES;
+
+            SCOREP_StringHandle string = SCOREP_Definitions_NewString( names[ index ] );
+            if ( round > 0 && string != self->strings[ index ] )
+            {
+                fprintf( stderr, "String '%s' got a new handle.\n", names[ index ] );
+                exit( EXIT_FAILURE );
+            }
+            self->strings[ index ] = string;
+
+            SCOREP_SourceCodeLocationHandle location =
+                SCOREP_Definitions_NewSourceCodeLocation( names[ index % 100 ], index );
+            if ( round > 0 && location != self->locations[ index ] )
+            {
+                fprintf( stderr, "Location %s:%u got a new handle.\n",
+                         names[ index % 100 ], index );
+                exit( EXIT_FAILURE );
+            }
+            self->locations[ index ] = location;
+        }
+    }
+    return NULL;
+}
+
+
+int
+main( void )
+{
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        char buffer[ 64 ];
+        sprintf( buffer, "ns%u::function%u", i % 7, i );
+        names[ i ] = strdup( buffer );
+    }
+
+    SCOREP_Substrates_EarlyInitialize();
+    SCOREP_Memory_Initialize( 256 * 1024 * 1024, 64 * 1024, false );
+    SCOREP_Definitions_Initialize();
+    uint32_t initial_strings   = scorep_local_definition_manager.string.counter;
+    uint32_t initial_locations = scorep_local_definition_manager.source_code_location.counter;
+
+    double start = get_time();
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        threads[ i ].offset = i * ( NUM_NAMES / NUM_THREADS );
+        if ( pthread_create( &threads[ i ].thread, NULL, define, &threads[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            return EXIT_FAILURE;
+        }
+    }
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        pthread_join( threads[ i ].thread, NULL );
+    }
+    double stop = get_time();
+
+    int result = EXIT_SUCCESS;
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        for ( unsigned j = 1; j < NUM_THREADS; j++ )
+        {
+            if ( threads[ j ].strings[ i ] != threads[ 0 ].strings[ i ]
+                 || threads[ j ].locations[ i ] != threads[ 0 ].locations[ i ] )
+            {
+                fprintf( stderr, "Threads 0 and %u got different handles for '%s'.\n",
+                         j, names[ i ] );
+                result = EXIT_FAILURE;
+            }
+        }
+        if ( strcmp( SCOREP_StringHandle_Get( threads[ 0 ].strings[ i ] ), names[ i ] ) != 0 )
+        {
+            fprintf( stderr, "Handle of '%s' refers to '%s'.\n",
+                     names[ i ], SCOREP_StringHandle_Get( threads[ 0 ].strings[ i ] ) );
+            result = EXIT_FAILURE;
+        }
+    }
+
+    /* The locations use the first 100 names as files, which are defined
+       already as strings */
+    uint32_t new_strings   = scorep_local_definition_manager.string.counter - initial_strings;
+    uint32_t new_locations = scorep_local_definition_manager.source_code_location.counter
+                             - initial_locations;
+    if ( new_strings != NUM_NAMES || new_locations != NUM_NAMES )
+    {
+        fprintf( stderr, "Expected %u strings and locations, got %u and %u.\n",
+                 NUM_NAMES, new_strings, new_locations );
+        result = EXIT_FAILURE;
+    }
+
+    printf( "%u threads, %u names, %u rounds: %.1f ns per definition\n",
+            NUM_THREADS, NUM_NAMES, NUM_ROUNDS,
+            ( stop - start ) / ( 2.0 * NUM_THREADS * NUM_NAMES * NUM_ROUNDS ) );
+
+    SCOREP_Definitions_Finalize();
+    SCOREP_Memory_Finalize();
+    for ( unsigned i = 0; i < NUM_NAMES; i++ )
+    {
+        free( names[ i ] );
+    }
+    return result;
+}
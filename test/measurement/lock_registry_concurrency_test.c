@@ -0,0 +1,167 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Looks up locks in the lock registry while another thread removes
+ * and inserts locks.
+ *
+ * The writer removes and inserts again a set of changing locks, thus lock
+ * objects are reused and the table fills with tombstones and is rebuilt. The
+ * readers look up these and a set of stable locks, which are never removed.
+ * Every lookup of a stable lock needs to find its lock object, with the
+ * right key and id.
+ */
+
+#include <config.h>
+
+#include <SCOREP_InMeasurement.h>
+#include <SCOREP_RuntimeManagement.h>
+#include <SCOREP_LockRegistry.h>
+#include <SCOREP_Atomic.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_READERS        3
+#define NUM_STABLE_LOCKS   1000
+#define NUM_CHANGING_LOCKS 1000
+#define NUM_ROUNDS         200
+
+static char stable_objects[ NUM_STABLE_LOCKS ];
+static char changing_objects[ NUM_CHANGING_LOCKS ];
+
+static uint32_t stable_ids[ NUM_STABLE_LOCKS ];
+
+static SCOREP_LockRegistry* registry;
+
+static int writer_done;
+
+
+static void*
+write_locks( void* arg )
+{
+    for ( unsigned round = 0; round < NUM_ROUNDS; round++ )
+    {
+        for ( unsigned i = 0; i < NUM_CHANGING_LOCKS; i++ )
+        {
+            SCOREP_Lock* lock = SCOREP_LockRegistry_Insert( registry, &changing_objects[ i ] );
+            if ( lock->key != &changing_objects[ i ] )
+            {
+                fprintf( stderr, "Inserted changing lock %u has a wrong key.\n", i );
+                exit( EXIT_FAILURE );
+            }
+        }
+        for ( unsigned i = 0; i < NUM_CHANGING_LOCKS; i++ )
+        {
+            if ( !SCOREP_LockRegistry_Remove( registry, &changing_objects[ i ] ) )
+            {
+                fprintf( stderr, "Changing lock %u is not registered.\n", i );
+                exit( EXIT_FAILURE );
+            }
+        }
+    }
+    SCOREP_ATOMIC_STORE( &writer_done, 1, SCOREP_ATOMIC_RELAXED );
+    return NULL;
+}
+
+
+static void*
+read_locks( void* arg )
+{
+    unsigned offset = *( unsigned* )arg;
+    while ( !SCOREP_ATOMIC_LOAD( &writer_done, SCOREP_ATOMIC_RELAXED ) )
+    {
+        for ( unsigned i = 0; i < NUM_STABLE_LOCKS; i++ )
+        {
+            unsigned     index = ( i + offset ) % NUM_STABLE_LOCKS;
+            SCOREP_Lock* lock  = SCOREP_LockRegistry_Get( registry, &stable_objects[ index ] );
+            if ( lock == NULL )
+            {
+                fprintf( stderr, "Stable lock %u not found.\n", index );
+                exit( EXIT_FAILURE );
+            }
+            if ( lock->key != &stable_objects[ index ] || lock->id != stable_ids[ index ] )
+            {
+                fprintf( stderr, "Stable lock %u found with id %u instead of %u.\n",
+                         index, lock->id, stable_ids[ index ] );
+                exit( EXIT_FAILURE );
+            }
+
+            /* May be removed in the meantime, only exercise the lookup */
+            SCOREP_LockRegistry_Get( registry, &changing_objects[ index % NUM_CHANGING_LOCKS ] );
+        }
+    }
+    return NULL;
+}
+
+
+int
+main( void )
+{
+    setenv( "SCOREP_ENABLE_PROFILING", "false", 1 );
+    setenv( "SCOREP_ENABLE_TRACING", "false", 1 );
+
+    /* Lock objects are allocated from the misc memory of the sole location */
+    if ( SCOREP_IS_MEASUREMENT_PHASE( PRE ) )
+    {
+        SCOREP_InitMeasurement();
+    }
+
+    registry = SCOREP_LockRegistry_New( sizeof( SCOREP_Lock ) );
+    for ( unsigned i = 0; i < NUM_STABLE_LOCKS; i++ )
+    {
+        stable_ids[ i ] = SCOREP_LockRegistry_Insert( registry, &stable_objects[ i ] )->id;
+    }
+
+    pthread_t writer;
+    pthread_t readers[ NUM_READERS ];
+    unsigned  offsets[ NUM_READERS ];
+    if ( pthread_create( &writer, NULL, write_locks, NULL ) != 0 )
+    {
+        perror( "pthread_create" );
+        return EXIT_FAILURE;
+    }
+    for ( unsigned i = 0; i < NUM_READERS; i++ )
+    {
+        offsets[ i ] = i * ( NUM_STABLE_LOCKS / NUM_READERS );
+        if ( pthread_create( &readers[ i ], NULL, read_locks, &offsets[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            return EXIT_FAILURE;
+        }
+    }
+    pthread_join( writer, NULL );
+    for ( unsigned i = 0; i < NUM_READERS; i++ )
+    {
+        pthread_join( readers[ i ], NULL );
+    }
+
+    int result = EXIT_SUCCESS;
+    for ( unsigned i = 0; i < NUM_CHANGING_LOCKS; i++ )
+    {
+        if ( SCOREP_LockRegistry_Get( registry, &changing_objects[ i ] ) != NULL )
+        {
+            fprintf( stderr, "Removed lock %u is still registered.\n", i );
+            result = EXIT_FAILURE;
+        }
+    }
+
+    printf( "%u readers, %u stable and %u changing locks, %u rounds\n",
+            NUM_READERS, NUM_STABLE_LOCKS, NUM_CHANGING_LOCKS, NUM_ROUNDS );
+
+    SCOREP_LockRegistry_Delete( registry );
+    return result;
+}
@@ -0,0 +1,221 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Measures the cost of an enter or exit event in ns.
+ *
+ * Each thread repeatedly walks a call tree of @a depth levels with @a width
+ * sibling regions per level. The last sibling of each level calls the next
+ * level, thus the tree has width * depth nodes. With -p, every region sets an
+ * integer parameter, which is counted as an additional event.
+ *
+ * The benchmark is built and run by run_overhead_benchmark.sh with the
+ * installed scorep instrumenter. Built without SCOREP_USER_ENABLE it measures
+ * the cost of the uninstrumented walk. The result is printed as one CSV line:
+ *
+ *   threads,width,depth,parameters,events_per_thread,ns_per_event_mean,ns_per_event_max
+ */
+
+#include <scorep/SCOREP_User.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <time.h>
+
+#define MAX_WIDTH   64
+#define MAX_DEPTH   64
+#define MAX_THREADS 1024
+
+static int      width            = 4;
+static int      depth            = 4;
+static int      with_parameters  = 0;
+static uint64_t events_requested = 1000000;
+static uint64_t iterations;
+
+#ifdef SCOREP_USER_ENABLE
+static SCOREP_User_RegionHandle regions[ MAX_DEPTH ][ MAX_WIDTH ];
+#endif
+
+static pthread_barrier_t barrier;
+
+/* Keeps the compiler from removing the walk in the uninstrumented build */
+static volatile uint64_t sink;
+
+typedef struct
+{
+    pthread_t thread;
+    double    ns_per_event;
+} benchmark_thread;
+
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+static void
+walk( int      level,
+      uint64_t iteration )
+{
+    for ( int i = 0; i < width; i++ )
+    {
+        SCOREP_USER_REGION_ENTER( regions[ level ][ i ] )
+        if ( with_parameters )
+        {
+            /* Few distinct values, the profile tree stays bounded */
+            SCOREP_USER_PARAMETER_INT64( "value", iteration & 3 )
+        }
+        if ( i == width - 1 && level < depth - 1 )
+        {
+            walk( level + 1, iteration );
+        }
+        sink += iteration;
+        SCOREP_USER_REGION_END( regions[ level ][ i ] )
+    }
+}
+
+
+static void*
+run( void* arg )
+{
+    benchmark_thread* self = arg;
+
+    /* Create the call tree before measuring */
+    walk( 0, 0 );
+
+    pthread_barrier_wait( &barrier );
+    double start = get_time();
+    for ( uint64_t i = 0; i < iterations; i++ )
+    {
+        walk( 0, i );
+    }
+    double stop = get_time();
+
+    uint64_t events_per_walk = ( uint64_t )width * depth * ( with_parameters ? 3 : 2 );
+    self->ns_per_event = ( stop - start ) / ( iterations * events_per_walk );
+    return NULL;
+}
+
+
+static void
+usage( const char* name )
+{
+    fprintf( stderr,
+             "Usage: %s [-t threads] [-w width] [-d depth] [-e events] [-p]\n"
+             "  -t  number of threads (default 1)\n"
+             "  -w  sibling regions per level, at most %d (default 4)\n"
+             "  -d  levels of the call tree, at most %d (default 4)\n"
+             "  -e  approximate number of events per thread (default 1000000)\n"
+             "  -p  set an integer parameter in every region\n",
+             name, MAX_WIDTH, MAX_DEPTH );
+}
+
+
+int
+main( int argc, char** argv )
+{
+    int num_threads = 1;
+    int opt;
+    while ( ( opt = getopt( argc, argv, "t:w:d:e:ph" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+            case 't':
+                num_threads = atoi( optarg );
+                break;
+            case 'w':
+                width = atoi( optarg );
+                break;
+            case 'd':
+                depth = atoi( optarg );
+                break;
+            case 'e':
+                events_requested = strtoull( optarg, NULL, 10 );
+                break;
+            case 'p':
+                with_parameters = 1;
+                break;
+            default:
+                usage( argv[ 0 ] );
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if ( num_threads < 1 || num_threads > MAX_THREADS
+         || width < 1 || width > MAX_WIDTH
+         || depth < 1 || depth > MAX_DEPTH
+         || events_requested == 0 )
+    {
+        usage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    uint64_t events_per_walk = ( uint64_t )width * depth * ( with_parameters ? 3 : 2 );
+    iterations = ( events_requested + events_per_walk - 1 ) / events_per_walk;
+
+#ifdef SCOREP_USER_ENABLE
+    for ( int level = 0; level < depth; level++ )
+    {
+        for ( int i = 0; i < width; i++ )
+        {
+            char name[ 32 ];
+            sprintf( name, "level_%d_region_%d", level, i );
+            SCOREP_USER_REGION_INIT( regions[ level ][ i ], name, SCOREP_USER_REGION_TYPE_FUNCTION )
+        }
+    }
+#endif
+
+    benchmark_thread* threads = calloc( num_threads, sizeof( *threads ) );
+    if ( threads == NULL )
+    {
+        perror( "calloc" );
+        return EXIT_FAILURE;
+    }
+    pthread_barrier_init( &barrier, NULL, num_threads );
+    for ( int i = 1; i < num_threads; i++ )
+    {
+        if ( pthread_create( &threads[ i ].thread, NULL, run, &threads[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            return EXIT_FAILURE;
+        }
+    }
+    run( &threads[ 0 ] );
+
+    double mean = threads[ 0 ].ns_per_event;
+    double max  = threads[ 0 ].ns_per_event;
+    for ( int i = 1; i < num_threads; i++ )
+    {
+        pthread_join( threads[ i ].thread, NULL );
+        mean += threads[ i ].ns_per_event;
+        max   = threads[ i ].ns_per_event > max ? threads[ i ].ns_per_event : max;
+    }
+    mean /= num_threads;
+
+    printf( "%d,%d,%d,%d,%" PRIu64 ",%.2f,%.2f\n",
+            num_threads, width, depth, with_parameters,
+            iterations * events_per_walk, mean, max );
+
+    pthread_barrier_destroy( &barrier );
+    free( threads );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#!/bin/bash
+
+##
+## This file is part of the Score-P software (http://www.score-p.org)
+##
+## Copyright (c) 2026,
+## Forschungszentrum Juelich GmbH, Germany
+##
+## This software may be modified and distributed under the terms of
+## a BSD-style license. See the COPYING file in the package base
+## directory for details.
+##
+
+## file       run_overhead_benchmark.sh
+##
+## Measures the cost of the enter and exit events for profiling, tracing and
+## both, with and without metrics, for several thread counts, call-tree shapes
+## and with parameter events. Builds overhead_benchmark.c with the installed
+## scorep instrumenter found in PATH (or set SCOREP) and writes CSV to stdout,
+## one line per configuration. Rows with mode 'none' are the uninstrumented
+## baseline. Example:
+##
+##   PATH=<prefix>/bin:$PATH ./run_overhead_benchmark.sh > overhead.csv
+##
+## The lists below can be overridden from the environment. Metric sets are
+## given as <name>:<variable>=<value>[:<variable>=<value>...], a metric set
+## that cannot be recorded on this machine is reported on stderr and skipped.
+## The sets 'perf-read' and 'perf-rdpmc' compare reading the PERF_METRICS
+## counters by read() and in user space by rdpmc. Hardware counters and rdpmc
+## need to be available, e.g., not inside most virtual machines.
+
+SCOREP=${SCOREP:-scorep}
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--O2}
+EVENTS=${EVENTS:-1000000}
+MODES=${MODES:-"profiling tracing both"}
+PERF_METRICS=${PERF_METRICS:-cycles,instructions}
+METRICS=${METRICS:-"none
+                    rusage:SCOREP_METRIC_RUSAGE=ru_utime,ru_stime
+                    perf-read:SCOREP_METRIC_PERF=$PERF_METRICS:SCOREP_METRIC_PERF_RDPMC=false
+                    perf-rdpmc:SCOREP_METRIC_PERF=$PERF_METRICS:SCOREP_METRIC_PERF_RDPMC=true"}
+THREADS=${THREADS:-"1 2 4"}
+SHAPES=${SHAPES:-"1x1 8x1 1x8 8x8"}
+PARAMETERS=${PARAMETERS:-"0 1"}
+
+SOURCE=$(cd "$(dirname "$0")" && pwd)/overhead_benchmark.c
+WORK_DIR=$(mktemp -d "${TMPDIR:-/tmp}/scorep-overhead-benchmark.XXXXXX")
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if ! command -v "$SCOREP" > /dev/null; then
+    echo "Score-P instrumenter '$SCOREP' not found, add the installation to PATH." >&2
+    exit 1
+fi
+
+# The uninstrumented build is only for the baseline, it still needs the
+# include path of SCOREP_User.h
+SCOREP_CONFIG=$(dirname "$(command -v "$SCOREP")")/scorep-config
+$CC $CFLAGS $("$SCOREP_CONFIG" --inc) -o "$WORK_DIR/baseline" "$SOURCE" -lpthread || exit 1
+$SCOREP --nocompiler --user --thread=pthread \
+    $CC $CFLAGS -o "$WORK_DIR/instrumented" "$SOURCE" || exit 1
+
+# Runs one configuration and prefixes the result with mode and metrics.
+# Further arguments are passed as environment settings to the benchmark.
+run()
+{
+    local mode=$1 metrics=$2 binary=$3 threads=$4 shape=$5 parameters=$6
+    shift 6
+    local args="-t $threads -w ${shape%x*} -d ${shape#*x} -e $EVENTS"
+    if [ "$parameters" = 1 ]; then
+        args="$args -p"
+    fi
+    local result
+    result=$(cd "$WORK_DIR" && env "$@" "$binary" $args 2> "$WORK_DIR/stderr")
+    # Score-P continues without some metrics it cannot record, but reports them
+    if [ $? -ne 0 ] || grep -q "Error:" "$WORK_DIR/stderr"; then
+        cat "$WORK_DIR/stderr" >&2
+        return 1
+    fi
+    echo "$mode,$metrics,$result"
+    rm -rf "$WORK_DIR"/scorep-overhead
+}
+
+echo "mode,metrics,threads,width,depth,parameters,events_per_thread,ns_per_event_mean,ns_per_event_max"
+
+for threads in $THREADS; do
+    for shape in $SHAPES; do
+        for parameters in $PARAMETERS; do
+            run none none "$WORK_DIR/baseline" $threads $shape $parameters
+        done
+    done
+done
+
+export SCOREP_EXPERIMENT_DIRECTORY=scorep-overhead
+export SCOREP_OVERWRITE_EXPERIMENT_DIRECTORY=true
+# Keep trace buffer flushes out of the measurement
+export SCOREP_TOTAL_MEMORY=${SCOREP_TOTAL_MEMORY:-512M}
+
+for mode in $MODES; do
+    case $mode in
+        profiling) profiling=true;  tracing=false ;;
+        tracing)   profiling=false; tracing=true  ;;
+        both)      profiling=true;  tracing=true  ;;
+        *)         echo "Unknown mode '$mode'." >&2; exit 1 ;;
+    esac
+    for metric in $METRICS; do
+        name=${metric%%:*}
+        settings=
+        if [ "$name" != "$metric" ]; then
+            settings=${metric#*:}
+            settings=${settings//:/ }
+        fi
+        for threads in $THREADS; do
+            for shape in $SHAPES; do
+                for parameters in $PARAMETERS; do
+                    if ! run $mode $name "$WORK_DIR/instrumented" $threads $shape $parameters \
+                             SCOREP_ENABLE_PROFILING=$profiling \
+                             SCOREP_ENABLE_TRACING=$tracing \
+                             $settings; then
+                        echo "Skipping metrics '$name' in mode '$mode', the run reported errors." >&2
+                        continue 4
+                    fi
+                done
+            done
+        done
+    done
+done
+
+exit 0
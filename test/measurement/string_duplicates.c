@@ -51,7 +51,7 @@ static void
 test_1( CuTest* tc )
 {
     SCOREP_Substrates_EarlyInitialize();
-    SCOREP_Memory_Initialize( 4 * 4096, 4096 );
+    SCOREP_Memory_Initialize( 4 * 4096, 4096, false );
     SCOREP_Definitions_Initialize();
 
     SCOREP_StringHandle handle1 = SCOREP_Definitions_NewString( "foo" );
@@ -69,7 +69,7 @@ static void
 test_2( CuTest* tc )
 {
     SCOREP_Substrates_EarlyInitialize();
-    SCOREP_Memory_Initialize( 4 * 4096, 4096 );
+    SCOREP_Memory_Initialize( 4 * 4096, 4096, false );
     SCOREP_Definitions_Initialize();
 
     SCOREP_StringHandle foo_handle1 = SCOREP_Definitions_NewString( "foo" );
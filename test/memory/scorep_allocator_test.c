@@ -573,6 +573,129 @@ allocator_test_18( CuTest* tc )
 }
 
 
+void
+allocator_test_19( CuTest* tc )
+{
+    uint64_t total_mem = UINT64_C( 6 ) << 30;
+    uint32_t page_size = 65536;
+
+    if ( sizeof( size_t ) != sizeof( uint64_t ) )
+    {
+        return;
+    }
+
+    SCOREP_Allocator_Allocator* allocator
+        = SCOREP_Allocator_CreateArenaAllocator( &total_mem, &page_size, false, 0, 0, 0 );
+    CuAssertPtrNotNull( tc, allocator );
+    CuAssertTrue( tc, SCOREP_Allocator_GetMaxNumberOfPages( allocator ) == ( total_mem >> 16 ) );
+
+    SCOREP_Allocator_PageManager* page_manager
+        = SCOREP_Allocator_CreatePageManager( allocator );
+    CuAssertPtrNotNull( tc, page_manager );
+
+    SCOREP_Allocator_MovableMemory movable = SCOREP_Allocator_AllocMovable( page_manager, 128 );
+    CuAssertTrue( tc, movable != 0 );
+    memset( SCOREP_Allocator_GetAddressFromMovableMemory( page_manager, movable ), 1, 128 );
+
+    /* 256 pages, below the cache limit of 1/256 of all pages */
+    void* memory = SCOREP_Allocator_Alloc( page_manager, 16 << 20 );
+    CuAssertPtrNotNullMsg( tc, "16 MiB", memory );
+    memset( memory, 1, 16 << 20 );
+
+    SCOREP_Allocator_PageManagerStats stats = { 0 };
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    uint32_t pages_used = stats.pages_used;
+
+    /* freed pages are kept by the page manager and reused */
+    SCOREP_Allocator_Free( page_manager );
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used, stats.pages_used );
+
+    void* memory_2 = SCOREP_Allocator_Alloc( page_manager, 16 << 20 );
+    CuAssertPtrEquals( tc, memory, memory_2 );
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used, stats.pages_used );
+
+    /* 1536 pages, more than one arena and above the cache limit */
+    void* memory_3 = SCOREP_Allocator_Alloc( page_manager, 96 << 20 );
+    CuAssertPtrNotNullMsg( tc, "96 MiB", memory_3 );
+    memset( memory_3, 1, 96 << 20 );
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used + 1536, stats.pages_used );
+
+    /* pages beyond the cache limit go back to the allocator */
+    SCOREP_Allocator_Free( page_manager );
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used, stats.pages_used );
+
+    SCOREP_Allocator_DeletePageManager( page_manager );
+    SCOREP_Allocator_DeleteAllocator( allocator );
+}
+
+
+void
+allocator_test_20( CuTest* tc )
+{
+    uint64_t total_mem = UINT64_C( 6 ) << 30;
+    uint32_t page_size = 65536;
+
+    if ( sizeof( size_t ) != sizeof( uint64_t ) )
+    {
+        return;
+    }
+
+    SCOREP_Allocator_Allocator* allocator
+        = SCOREP_Allocator_CreateArenaAllocator( &total_mem, &page_size, false, 0, 0, 0 );
+    CuAssertPtrNotNull( tc, allocator );
+
+    SCOREP_Allocator_PageManagerStats stats = { 0 };
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    uint32_t pages_used = stats.pages_used;
+
+    /* every page manager keeps its initial page and 256 more, until all of
+       them together keep 1/64 of all pages, i.e., 1536 pages; the initial
+       pages count as used anyway */
+    SCOREP_Allocator_PageManager* page_managers[ 8 ];
+    for ( int i = 0; i < 8; i++ )
+    {
+        page_managers[ i ] = SCOREP_Allocator_CreatePageManager( allocator );
+        CuAssertPtrNotNull( tc, page_managers[ i ] );
+    }
+    pages_used += 8;
+
+    for ( int i = 0; i < 8; i++ )
+    {
+        CuAssertPtrNotNullMsg( tc, "16 MiB", SCOREP_Allocator_Alloc( page_managers[ i ], 16 << 20 ) );
+        SCOREP_Allocator_Free( page_managers[ i ] );
+
+        SCOREP_Allocator_GetPageStats( allocator, &stats );
+        uint32_t kept = ( i < 5 ? i + 1 : 5 ) * 256;
+        CuAssertIntEquals( tc, pages_used + kept, stats.pages_used );
+    }
+
+    /* deleting a page manager makes room for the kept pages of another */
+    SCOREP_Allocator_DeletePageManager( page_managers[ 0 ] );
+    pages_used -= 1;
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used + 4 * 256, stats.pages_used );
+
+    CuAssertPtrNotNull( tc, SCOREP_Allocator_Alloc( page_managers[ 7 ], 16 << 20 ) );
+    SCOREP_Allocator_Free( page_managers[ 7 ] );
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used + 5 * 256, stats.pages_used );
+
+    for ( int i = 1; i < 8; i++ )
+    {
+        SCOREP_Allocator_DeletePageManager( page_managers[ i ] );
+    }
+    pages_used -= 7;
+    SCOREP_Allocator_GetPageStats( allocator, &stats );
+    CuAssertIntEquals( tc, pages_used, stats.pages_used );
+
+    SCOREP_Allocator_DeleteAllocator( allocator );
+}
+
+
 int
 main()
 {
@@ -614,6 +737,10 @@ main()
                          "min page size 512" );
     SUITE_ADD_TEST_NAME( suite, allocator_test_18,
                          "big pages" );
+    SUITE_ADD_TEST_NAME( suite, allocator_test_19,
+                         "arena allocator" );
+    SUITE_ADD_TEST_NAME( suite, allocator_test_20,
+                         "arena allocator cache limit" );
 
     CuSuiteRun( suite );
     CuSuiteSummary( suite, output );
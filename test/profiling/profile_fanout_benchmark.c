@@ -0,0 +1,93 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @ file
+ *
+ * @brief Measures the cost of an enter/exit pair in the profile for call-tree
+ *        nodes with an increasing number of children.
+ *
+ * Each iteration enters the region 'work' and sets an integer parameter, which
+ * creates one call-tree node per distinct parameter value below 'work'. With
+ * the hashed child lookup, the cost per iteration should stay flat with growing
+ * fan-out. Run with SCOREP_PROFILING_CHILD_INDEX_THRESHOLD=0 to compare against
+ * the plain list search.
+ */
+
+#include <config.h>
+
+#include <scorep/SCOREP_User.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+
+#define NUM_ITERATIONS 200000
+
+static const int64_t fanouts[] = { 1, 16, 256, 1024, 4096, 16384 };
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void
+work( int64_t value )
+{
+    SCOREP_USER_REGION_DEFINE( work );
+    SCOREP_USER_REGION_BEGIN( work, "work", SCOREP_USER_REGION_TYPE_FUNCTION );
+    SCOREP_USER_PARAMETER_INT64( "child", value );
+    SCOREP_USER_REGION_END( work );
+}
+
+static void
+run( int64_t fanout )
+{
+    /* Separate the call trees of the different fan-outs */
+    char name[ 32 ];
+    sprintf( name, "fanout_%" PRId64, fanout );
+    SCOREP_USER_REGION_BY_NAME_BEGIN( name, SCOREP_USER_REGION_TYPE_COMMON );
+
+    /* Create all children before measuring */
+    for ( int64_t i = 0; i < fanout; i++ )
+    {
+        work( i );
+    }
+
+    double start = get_time();
+    for ( int64_t i = 0; i < NUM_ITERATIONS; i++ )
+    {
+        work( i % fanout );
+    }
+    double stop = get_time();
+
+    SCOREP_USER_REGION_BY_NAME_END( name );
+
+    printf( "fan-out %6" PRId64 ": %8.1f ns per iteration\n",
+            fanout, ( stop - start ) / NUM_ITERATIONS );
+}
+
+int
+main()
+{
+    for ( size_t i = 0; i < sizeof( fanouts ) / sizeof( fanouts[ 0 ] ); i++ )
+    {
+        run( fanouts[ i ] );
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @ file
+ *
+ * Tests the log-linear histograms of the inclusive time: the bucket
+ * boundaries, merging, and the percentile estimates.
+ */
+
+#include <config.h>
+
+#include <scorep_profile_metric.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int errors = 0;
+
+#define CHECK( condition, ... )                                         \
+    do                                                                  \
+    {                                                                   \
+        if ( !( condition ) )                                           \
+        {                                                               \
+            fprintf( stderr, "%s:%d: ", __FILE__, __LINE__ );           \
+            fprintf( stderr, __VA_ARGS__ );                             \
+            fprintf( stderr, "\n" );                                    \
+            errors++;                                                   \
+        }                                                               \
+    }                                                                   \
+    while ( 0 )
+
+/* Every value must lie within the boundaries of its bucket */
+static void
+check_bucket( uint64_t value )
+{
+    uint32_t bucket = scorep_profile_get_histogram_bucket( value );
+    CHECK( bucket < SCOREP_PROFILE_HISTOGRAM_BUCKETS,
+           "Bucket %" PRIu32 " of %" PRIu64 " out of range", bucket, value );
+    if ( bucket >= SCOREP_PROFILE_HISTOGRAM_BUCKETS )
+    {
+        return;
+    }
+    CHECK( scorep_profile_get_histogram_lower_bound( bucket ) <= value,
+           "%" PRIu64 " below bucket %" PRIu32, value, bucket );
+    if ( bucket + 1 < SCOREP_PROFILE_HISTOGRAM_BUCKETS )
+    {
+        CHECK( value < scorep_profile_get_histogram_lower_bound( bucket + 1 ),
+               "%" PRIu64 " above bucket %" PRIu32, value, bucket );
+    }
+}
+
+static void
+test_buckets( void )
+{
+    for ( uint64_t value = 0; value < 4096; value++ )
+    {
+        check_bucket( value );
+    }
+    for ( uint32_t exponent = 1; exponent < 64; exponent++ )
+    {
+        uint64_t power = UINT64_C( 1 ) << exponent;
+        check_bucket( power - 1 );
+        check_bucket( power );
+        check_bucket( power + 1 );
+        check_bucket( power + power / 3 );
+    }
+    check_bucket( UINT64_MAX );
+    CHECK( scorep_profile_get_histogram_bucket( UINT64_MAX ) == SCOREP_PROFILE_HISTOGRAM_BUCKETS - 1,
+           "UINT64_MAX is not in the last bucket" );
+
+    for ( uint32_t bucket = 1; bucket < SCOREP_PROFILE_HISTOGRAM_BUCKETS; bucket++ )
+    {
+        CHECK( scorep_profile_get_histogram_lower_bound( bucket - 1 )
+               < scorep_profile_get_histogram_lower_bound( bucket ),
+               "Bucket boundaries not increasing at %" PRIu32, bucket );
+    }
+}
+
+static void
+test_merge( void )
+{
+    uint64_t a[ SCOREP_PROFILE_HISTOGRAM_BUCKETS ];
+    uint64_t b[ SCOREP_PROFILE_HISTOGRAM_BUCKETS ];
+    uint64_t all[ SCOREP_PROFILE_HISTOGRAM_BUCKETS ];
+    uint64_t merged[ SCOREP_PROFILE_HISTOGRAM_BUCKETS ];
+
+    scorep_profile_init_histogram( a );
+    scorep_profile_init_histogram( b );
+    scorep_profile_init_histogram( all );
+    for ( uint64_t value = 1; value < 100000; value = value * 3 + 1 )
+    {
+        scorep_profile_update_histogram( value % 2 ? a : b, value );
+        scorep_profile_update_histogram( all, value );
+    }
+
+    scorep_profile_copy_histogram( merged, a );
+    scorep_profile_merge_histogram( merged, b );
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_HISTOGRAM_BUCKETS; i++ )
+    {
+        CHECK( merged[ i ] == all[ i ], "Merged bucket %" PRIu32 " differs", i );
+    }
+
+    scorep_profile_subtract_histogram( merged, b );
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_HISTOGRAM_BUCKETS; i++ )
+    {
+        CHECK( merged[ i ] == a[ i ], "Subtracted bucket %" PRIu32 " differs", i );
+    }
+}
+
+static void
+test_percentiles( void )
+{
+    uint64_t histogram[ SCOREP_PROFILE_HISTOGRAM_BUCKETS ];
+    scorep_profile_init_histogram( histogram );
+
+    CHECK( scorep_profile_get_histogram_percentile( histogram, 50, 0, 0 ) == 0,
+           "Percentile of an empty histogram is not 0" );
+
+    /* 98 short visits and 2 long ones */
+    for ( int i = 0; i < 98; i++ )
+    {
+        scorep_profile_update_histogram( histogram, 1000 );
+    }
+    scorep_profile_update_histogram( histogram, 1000000 );
+    scorep_profile_update_histogram( histogram, 1000000 );
+
+    uint64_t p0   = scorep_profile_get_histogram_percentile( histogram, 0, 1000, 1000000 );
+    uint64_t p50  = scorep_profile_get_histogram_percentile( histogram, 50, 1000, 1000000 );
+    uint64_t p99  = scorep_profile_get_histogram_percentile( histogram, 99, 1000, 1000000 );
+    uint64_t p100 = scorep_profile_get_histogram_percentile( histogram, 100, 1000, 1000000 );
+
+    /* A bucket is at most 25% wide, thus, its middle is within 12.5% */
+    CHECK( p0 >= 1000 && p0 <= 1125, "p0 is %" PRIu64, p0 );
+    CHECK( p50 >= 1000 && p50 <= 1125, "p50 is %" PRIu64, p50 );
+    CHECK( p99 >= 875000 && p99 <= 1000000, "p99 is %" PRIu64, p99 );
+    CHECK( p100 >= 875000 && p100 <= 1000000, "p100 is %" PRIu64, p100 );
+}
+
+int
+main( void )
+{
+    test_buckets();
+    test_merge();
+    test_percentiles();
+
+    if ( errors > 0 )
+    {
+        fprintf( stderr, "%d checks failed\n", errors );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @ file
+ *
+ * Tests the live profile snapshots: the exit of a phase creates the
+ * shared-memory segment of the location, which is read back as the
+ * scorep-live-profile tool does.
+ */
+
+#include <config.h>
+
+#include <SCOREP_InMeasurement.h>
+#include <SCOREP_RuntimeManagement.h>
+#include <SCOREP_Definitions.h>
+#include <SCOREP_Events.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_Profile_Live.h>
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int errors = 0;
+
+#define CHECK( condition, ... )                                         \
+    do                                                                  \
+    {                                                                   \
+        if ( !( condition ) )                                           \
+        {                                                               \
+            fprintf( stderr, "%s:%d: ", __FILE__, __LINE__ );           \
+            fprintf( stderr, __VA_ARGS__ );                             \
+            fprintf( stderr, "\n" );                                    \
+            errors++;                                                   \
+        }                                                               \
+    }                                                                   \
+    while ( 0 )
+
+/* Returns the index of the record of @a name, or -1 */
+static int64_t
+find_record( const SCOREP_Profile_LiveHeader* header,
+             const SCOREP_Profile_LiveBuffer* buffer,
+             const char*                      name )
+{
+    for ( uint64_t i = 0; i < buffer->number_of_records; i++ )
+    {
+        if ( strcmp( SCOREP_Profile_LiveGetRecord( header, buffer, i )->name, name ) == 0 )
+        {
+            return ( int64_t )i;
+        }
+    }
+    return -1;
+}
+
+
+static void
+read_snapshot( uint32_t locationId )
+{
+    char name[ 64 ];
+    snprintf( name, sizeof( name ), "/" SCOREP_PROFILE_LIVE_PREFIX "%" PRIu64 "-%" PRIu32,
+              ( uint64_t )getpid(), locationId );
+
+    int fd = shm_open( name, O_RDONLY, 0 );
+    CHECK( fd != -1, "Segment '%s' does not exist", name );
+    if ( fd == -1 )
+    {
+        return;
+    }
+    struct stat info;
+    fstat( fd, &info );
+    const SCOREP_Profile_LiveHeader* header =
+        mmap( NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    CHECK( header != MAP_FAILED, "Cannot map segment '%s'", name );
+    if ( header == MAP_FAILED )
+    {
+        return;
+    }
+
+    CHECK( header->magic == SCOREP_PROFILE_LIVE_MAGIC, "Wrong magic" );
+    CHECK( header->version == SCOREP_PROFILE_LIVE_VERSION, "Wrong version" );
+    CHECK( header->pid == ( uint64_t )getpid(), "Wrong pid %" PRIu64, header->pid );
+    CHECK( header->location_id == locationId, "Wrong location %" PRIu64, header->location_id );
+
+    SCOREP_Profile_LiveBuffer* buffer =
+        malloc( SCOREP_Profile_LiveBufferSize( header->max_records, header->record_size ) );
+    CHECK( SCOREP_Profile_LiveReadBuffer( header, buffer ), "Inconsistent snapshot" );
+
+    int64_t phase = find_record( header, buffer, "phase" );
+    int64_t child = find_record( header, buffer, "child" );
+    CHECK( phase >= 0, "No record of the phase" );
+    CHECK( child >= 0, "No record of the child" );
+    if ( phase >= 0 && child >= 0 )
+    {
+        SCOREP_Profile_LiveRecord* phase_record = SCOREP_Profile_LiveGetRecord( header, buffer, phase );
+        SCOREP_Profile_LiveRecord* child_record = SCOREP_Profile_LiveGetRecord( header, buffer, child );
+        CHECK( phase_record->visits == 1, "Phase visited %" PRIu64 " times", phase_record->visits );
+        CHECK( child_record->visits == 3, "Child visited %" PRIu64 " times", child_record->visits );
+        CHECK( child_record->parent == phase, "Child is not below the phase" );
+        CHECK( child_record->depth == phase_record->depth + 1, "Wrong depth of the child" );
+        CHECK( child_record->inclusive_time <= phase_record->inclusive_time,
+               "Child takes longer than the phase" );
+    }
+
+    free( buffer );
+    munmap( ( void* )header, info.st_size );
+}
+
+
+int
+main( int argc, char** argv )
+{
+    setenv( "SCOREP_ENABLE_PROFILING", "true", 1 );
+    setenv( "SCOREP_ENABLE_TRACING", "false", 1 );
+    setenv( "SCOREP_PROFILING_ENABLE_LIVE_SNAPSHOTS", "true", 1 );
+
+    if ( SCOREP_IS_MEASUREMENT_PHASE( PRE ) )
+    {
+        SCOREP_InitMeasurement();
+    }
+
+    SCOREP_RegionHandle phase = SCOREP_Definitions_NewRegion( "phase",
+                                                              "phase",
+                                                              SCOREP_INVALID_SOURCE_FILE,
+                                                              SCOREP_INVALID_LINE_NO,
+                                                              SCOREP_INVALID_LINE_NO,
+                                                              SCOREP_PARADIGM_USER,
+                                                              SCOREP_REGION_PHASE );
+    SCOREP_RegionHandle child = SCOREP_Definitions_NewRegion( "child",
+                                                              "child",
+                                                              SCOREP_INVALID_SOURCE_FILE,
+                                                              SCOREP_INVALID_LINE_NO,
+                                                              SCOREP_INVALID_LINE_NO,
+                                                              SCOREP_PARADIGM_USER,
+                                                              SCOREP_REGION_FUNCTION );
+
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+    SCOREP_EnterRegion( phase );
+    for ( int i = 0; i < 3; i++ )
+    {
+        SCOREP_EnterRegion( child );
+        SCOREP_ExitRegion( child );
+    }
+    /* The exit of a phase always refreshes the snapshot */
+    SCOREP_ExitRegion( phase );
+    uint32_t location_id = SCOREP_Location_GetId( SCOREP_Location_GetCurrentCPULocation() );
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+
+    read_snapshot( location_id );
+
+    printf( "live snapshot: %s\n", errors == 0 ? "ok" : "failed" );
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
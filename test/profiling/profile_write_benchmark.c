@@ -0,0 +1,152 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Measures the time Score-P needs to finalize an MPI profile measurement.
+ *
+ * Every rank creates a call tree of @a width outer regions, each calling the
+ * same @a width inner regions, thus the profile has width * ( width + 1 )
+ * callpaths per rank. The values differ between the ranks, so the Cube4
+ * writer has to collect a full row from every rank for every callpath.
+ *
+ * Score-P finalizes the measurement, unifies the definitions and writes the
+ * profile in an exit handler. The benchmark registers its own exit handler
+ * before MPI_Init, which therefore runs after the one of Score-P, and reports
+ * the time from the end of main until then on rank 0. The result is printed
+ * as one CSV line:
+ *
+ *   ranks,callpaths,finalize_ms
+ *
+ * The benchmark is built and run by run_profile_write_benchmark.sh with the
+ * installed scorep instrumenter.
+ */
+
+#include <scorep/SCOREP_User.h>
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#define MAX_WIDTH 1024
+
+static int    width = 150;
+static int    rank;
+static int    size;
+static double end_of_main;
+
+#ifdef SCOREP_USER_ENABLE
+static SCOREP_User_RegionHandle outer_regions[ MAX_WIDTH ];
+static SCOREP_User_RegionHandle inner_regions[ MAX_WIDTH ];
+#endif
+
+/* Keeps the compiler from removing the loops in the uninstrumented build */
+static volatile double sink;
+
+
+static double
+get_time( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+
+static void
+report( void )
+{
+    if ( rank == 0 && end_of_main > 0.0 )
+    {
+        printf( "%d,%d,%.1f\n", size, width * ( width + 1 ), get_time() - end_of_main );
+    }
+}
+
+
+static void
+work( int n )
+{
+    /* Rank dependent amount of work, the values of the ranks differ */
+    for ( int i = 0; i < n * ( rank + 1 ); i++ )
+    {
+        sink += i;
+    }
+}
+
+
+int
+main( int argc, char** argv )
+{
+    /* Must precede MPI_Init, which registers the exit handler of Score-P */
+    atexit( report );
+
+    MPI_Init( &argc, &argv );
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+    int opt;
+    while ( ( opt = getopt( argc, argv, "w:h" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'w':
+                width = atoi( optarg );
+                break;
+            default:
+                if ( rank == 0 )
+                {
+                    fprintf( stderr,
+                             "Usage: %s [-w width]\n"
+                             "  -w  outer and inner regions, at most %d (default 150)\n",
+                             argv[ 0 ], MAX_WIDTH );
+                }
+                MPI_Finalize();
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if ( width < 1 || width > MAX_WIDTH )
+    {
+        MPI_Abort( MPI_COMM_WORLD, EXIT_FAILURE );
+    }
+
+#ifdef SCOREP_USER_ENABLE
+    for ( int i = 0; i < width; i++ )
+    {
+        char name[ 32 ];
+        sprintf( name, "outer_%d", i );
+        SCOREP_USER_REGION_INIT( outer_regions[ i ], name, SCOREP_USER_REGION_TYPE_FUNCTION )
+        sprintf( name, "inner_%d", i );
+        SCOREP_USER_REGION_INIT( inner_regions[ i ], name, SCOREP_USER_REGION_TYPE_FUNCTION )
+    }
+#endif
+
+    for ( int i = 0; i < width; i++ )
+    {
+        SCOREP_USER_REGION_ENTER( outer_regions[ i ] )
+        for ( int j = 0; j < width; j++ )
+        {
+            SCOREP_USER_REGION_ENTER( inner_regions[ j ] )
+            work( j );
+            SCOREP_USER_REGION_END( inner_regions[ j ] )
+        }
+        SCOREP_USER_REGION_END( outer_regions[ i ] )
+    }
+
+    MPI_Finalize();
+
+    end_of_main = get_time();
+    return EXIT_SUCCESS;
+}
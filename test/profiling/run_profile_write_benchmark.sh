@@ -0,0 +1,67 @@
+#!/bin/bash
+
+##
+## This file is part of the Score-P software (http://www.score-p.org)
+##
+## Copyright (c) 2026,
+## Forschungszentrum Juelich GmbH, Germany
+##
+## This software may be modified and distributed under the terms of
+## a BSD-style license. See the COPYING file in the package base
+## directory for details.
+##
+
+## file       run_profile_write_benchmark.sh
+##
+## Compares the time needed to finalize an MPI profile measurement when the
+## Cube4 writer collects the values per callpath
+## (SCOREP_PROFILING_CUBE_WRITE_BUFFER=0) and in blocks of callpaths. Builds
+## profile_write_benchmark.c with the installed scorep instrumenter found in
+## PATH (or set SCOREP) and writes CSV to stdout, one line per run. The
+## finalization also contains the unification, which does not depend on the
+## buffer size. Example:
+##
+##   PATH=<prefix>/bin:$PATH LAUNCHER="mpiexec -np 64" \
+##       ./run_profile_write_benchmark.sh > profile_write.csv
+##
+## The variables below can be overridden from the environment. WIDTH gives
+## WIDTH * ( WIDTH + 1 ) callpaths per rank.
+
+SCOREP=${SCOREP:-scorep}
+MPICC=${MPICC:-mpicc}
+CFLAGS=${CFLAGS:--O2}
+LAUNCHER=${LAUNCHER:-"mpiexec -np 4"}
+WIDTH=${WIDTH:-150}
+BUFFERS=${BUFFERS:-"0 64K 1M 8M"}
+REPEAT=${REPEAT:-3}
+
+SOURCE=$(cd "$(dirname "$0")" && pwd)/profile_write_benchmark.c
+WORK_DIR=$(mktemp -d "${TMPDIR:-/tmp}/scorep-profile-write-benchmark.XXXXXX")
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if ! command -v "$SCOREP" > /dev/null; then
+    echo "Score-P instrumenter '$SCOREP' not found, add the installation to PATH." >&2
+    exit 1
+fi
+
+$SCOREP --nocompiler --user --mpp=mpi \
+    $MPICC $CFLAGS -o "$WORK_DIR/profile_write_benchmark" "$SOURCE" || exit 1
+
+export SCOREP_EXPERIMENT_DIRECTORY=scorep-profile-write
+export SCOREP_OVERWRITE_EXPERIMENT_DIRECTORY=true
+export SCOREP_ENABLE_PROFILING=true
+export SCOREP_ENABLE_TRACING=false
+
+echo "buffer,ranks,callpaths,finalize_ms"
+
+for buffer in $BUFFERS; do
+    for run in $(seq $REPEAT); do
+        result=$(cd "$WORK_DIR" &&
+                 SCOREP_PROFILING_CUBE_WRITE_BUFFER=$buffer \
+                 $LAUNCHER ./profile_write_benchmark -w $WIDTH) || exit 1
+        echo "$buffer,$result"
+        rm -rf "$WORK_DIR"/scorep-profile-write
+    done
+done
+
+exit 0
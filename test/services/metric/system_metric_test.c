@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Writes NUM_WRITES times WRITE_SIZE bytes to /dev/null, each in a
+ *        region. Run with SCOREP_METRIC_SYSTEM=io_wchar, the samples of the
+ *        background thread need to show the written bytes.
+ */
+
+
+#include <config.h>
+#include <scorep/SCOREP_User.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define NUM_WRITES 64
+#define WRITE_SIZE ( 1024 * 1024 )
+
+
+static void
+write_chunk( int         fd,
+             const char* chunk )
+{
+    SCOREP_USER_REGION_DEFINE( write_chunk );
+    SCOREP_USER_REGION_BEGIN( write_chunk, "write_chunk", SCOREP_USER_REGION_TYPE_FUNCTION );
+    for ( size_t written = 0; written < WRITE_SIZE; )
+    {
+        ssize_t length = write( fd, chunk + written, WRITE_SIZE - written );
+        if ( length < 0 )
+        {
+            perror( "write" );
+            exit( EXIT_FAILURE );
+        }
+        written += length;
+    }
+    /* Give the sampler time to take a sample */
+    usleep( 2000 );
+    SCOREP_USER_REGION_END( write_chunk );
+}
+
+
+int
+main( int argc, char* argv[] )
+{
+    char* chunk = calloc( WRITE_SIZE, 1 );
+    int   fd    = open( "/dev/null", O_WRONLY );
+    if ( chunk == NULL || fd == -1 )
+    {
+        perror( "system_metric_test" );
+        return EXIT_FAILURE;
+    }
+
+    for ( int i = 0; i < NUM_WRITES; i++ )
+    {
+        write_chunk( fd, chunk );
+    }
+
+    close( fd );
+    free( chunk );
+    return EXIT_SUCCESS;
+}
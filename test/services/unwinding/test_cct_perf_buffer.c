@@ -0,0 +1,78 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/*
+ * Run with SCOREP_SAMPLING_PERF_BUFFER=true, the samples are taken by the
+ * kernel and recorded when the instrumented region is entered and left.
+ * All samples in spin() need to be attributed to main/USER/spin.
+ *
+ * The ring buffer signal drains the samples asynchronously, thus the events
+ * are triggered inside the measurement, as the user adapter does.
+ */
+
+#include <config.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <SCOREP_InMeasurement.h>
+#include <SCOREP_RuntimeManagement.h>
+#include <SCOREP_Definitions.h>
+#include <SCOREP_Events.h>
+
+static SCOREP_RegionHandle user_region;
+
+static volatile double sink;
+
+static void __attribute__( ( noinline ) )
+spin( long n )
+{
+    for ( long i = 0; i < n; i++ )
+    {
+        sink += i * 0.5;
+    }
+}
+
+int
+main( int ac, char* av[] )
+{
+    if ( SCOREP_IS_MEASUREMENT_PHASE( PRE ) )
+    {
+        SCOREP_InitMeasurement();
+    }
+
+    user_region = SCOREP_Definitions_NewRegion( "USER",
+                                                "USER",
+                                                SCOREP_INVALID_SOURCE_FILE,
+                                                SCOREP_INVALID_LINE_NO,
+                                                SCOREP_INVALID_LINE_NO,
+                                                SCOREP_PARADIGM_USER,
+                                                SCOREP_REGION_FUNCTION );
+
+    long n = ac > 1 ? atol( av[ 1 ] ) : 5000000;
+    for ( int i = 0; i < 20; i++ )
+    {
+        SCOREP_IN_MEASUREMENT_INCREMENT();
+        SCOREP_EnterRegion( user_region );
+        SCOREP_IN_MEASUREMENT_DECREMENT();
+
+        spin( n );
+
+        SCOREP_IN_MEASUREMENT_INCREMENT();
+        SCOREP_ExitRegion( user_region );
+        SCOREP_IN_MEASUREMENT_DECREMENT();
+    }
+
+    printf( "%f\n", sink );
+
+    return 0;
+}
+
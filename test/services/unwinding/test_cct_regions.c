@@ -0,0 +1,191 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/*
+ * Exercises the process-wide region table of the unwinding service directly,
+ * with address ranges no mapping of the process uses:
+ *
+ * - an address inside a region that encloses later regions is found, also
+ *   after the end of the enclosing region was extended
+ * - threads inserting the same regions concurrently get the same region for
+ *   each start address, find it by any of its addresses, and every region is
+ *   created once
+ */
+
+#include <config.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <SCOREP_InMeasurement.h>
+#include <SCOREP_RuntimeManagement.h>
+
+#include <services/unwinding/scorep_unwinding_region.h>
+
+#define NESTED_BASE   UINT64_C( 0x100000000000 )
+#define NESTED_INNER  40
+
+#define THREADED_BASE UINT64_C( 0x110000000000 )
+#define NUM_THREADS   4
+#define NUM_REGIONS   5000
+
+typedef struct
+{
+    pthread_t                        thread;
+    unsigned                         offset;
+    SCOREP_Unwinding_CpuLocationData unwind_data;
+    scorep_unwinding_region*         regions[ NUM_REGIONS ];
+} test_thread;
+
+static test_thread threads[ NUM_THREADS ];
+
+static SCOREP_Unwinding_CpuLocationData unwind_data;
+
+static int result = EXIT_SUCCESS;
+
+
+static void
+expect( uint64_t addr, scorep_unwinding_region* expected )
+{
+    scorep_unwinding_region* region = scorep_unwinding_region_find( &unwind_data, addr );
+    if ( region != expected )
+    {
+        fprintf( stderr, "%#" PRIx64 ": found '%s', expected '%s'\n",
+                 addr, region ? region->name : "(none)", expected ? expected->name : "(none)" );
+        result = EXIT_FAILURE;
+    }
+}
+
+
+static void
+test_nested( void )
+{
+    scorep_unwinding_region* outer = scorep_unwinding_region_insert(
+        NESTED_BASE, NESTED_BASE + 0x1000, "outer", NULL );
+
+    /* Enough regions to get all of them merged into the table */
+    scorep_unwinding_region* inner[ NESTED_INNER ];
+    for ( unsigned i = 0; i < NESTED_INNER; i++ )
+    {
+        char name[ 32 ];
+        sprintf( name, "inner_%u", i );
+        inner[ i ] = scorep_unwinding_region_insert(
+            NESTED_BASE + 0x100 + i * 0x20, NESTED_BASE + 0x110 + i * 0x20, name, NULL );
+    }
+
+    expect( NESTED_BASE, outer );
+    expect( NESTED_BASE + 0x100, inner[ 0 ] );
+    expect( NESTED_BASE + 0x118, outer );
+    expect( NESTED_BASE + 0x100 + ( NESTED_INNER - 1 ) * 0x20, inner[ NESTED_INNER - 1 ] );
+    expect( NESTED_BASE + 0xfff, outer );
+    expect( NESTED_BASE + 0x1000, NULL );
+
+    /* The same function, found with a larger size */
+    if ( scorep_unwinding_region_insert( NESTED_BASE, NESTED_BASE + 0x2000, "outer", NULL ) != outer )
+    {
+        fprintf( stderr, "outer region created twice\n" );
+        result = EXIT_FAILURE;
+    }
+    expect( NESTED_BASE + 0x1000, outer );
+    expect( NESTED_BASE + 0x1fff, outer );
+    expect( NESTED_BASE + 0x2000, NULL );
+}
+
+
+static void*
+insert( void* arg )
+{
+    test_thread* self = arg;
+    for ( unsigned i = 0; i < NUM_REGIONS; i++ )
+    {
+        unsigned index = ( i + self->offset ) % NUM_REGIONS;
+        uint64_t start = THREADED_BASE + index * 0x100;
+        char     name[ 32 ];
+        sprintf( name, "region_%u", index );
+
+        self->regions[ index ] = scorep_unwinding_region_insert( start, start + 0x80, name, NULL );
+        if ( scorep_unwinding_region_find( &self->unwind_data, start + 0x40 )
+             != self->regions[ index ] )
+        {
+            fprintf( stderr, "%s not found by its address\n", name );
+            exit( EXIT_FAILURE );
+        }
+    }
+    return NULL;
+}
+
+
+static void
+count_region( scorep_unwinding_region* region, void* arg )
+{
+    if ( region->start >= THREADED_BASE && region->start < THREADED_BASE + NUM_REGIONS * 0x100 )
+    {
+        ( *( unsigned* )arg )++;
+    }
+}
+
+
+static void
+test_threaded( void )
+{
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        threads[ i ].offset = i * ( NUM_REGIONS / NUM_THREADS );
+        if ( pthread_create( &threads[ i ].thread, NULL, insert, &threads[ i ] ) != 0 )
+        {
+            perror( "pthread_create" );
+            exit( EXIT_FAILURE );
+        }
+    }
+    for ( unsigned i = 0; i < NUM_THREADS; i++ )
+    {
+        pthread_join( threads[ i ].thread, NULL );
+    }
+
+    for ( unsigned i = 0; i < NUM_REGIONS; i++ )
+    {
+        for ( unsigned j = 1; j < NUM_THREADS; j++ )
+        {
+            if ( threads[ j ].regions[ i ] != threads[ 0 ].regions[ i ] )
+            {
+                fprintf( stderr, "Threads 0 and %u got different regions for region_%u\n", j, i );
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+
+    unsigned count = 0;
+    scorep_unwinding_region_foreach( count_region, &count );
+    if ( count != NUM_REGIONS )
+    {
+        fprintf( stderr, "Expected %u regions, got %u\n", NUM_REGIONS, count );
+        result = EXIT_FAILURE;
+    }
+}
+
+
+int
+main( int ac, char* av[] )
+{
+    if ( SCOREP_IS_MEASUREMENT_PHASE( PRE ) )
+    {
+        SCOREP_InitMeasurement();
+    }
+
+    test_nested();
+    test_threaded();
+
+    printf( "regions: %s\n", result == EXIT_SUCCESS ? "ok" : "failed" );
+
+    return result;
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * @brief Checks how the instrumenter executes commands without a shell.
+ *
+ * split_shell_command needs to produce the same words as the shell for
+ * quoted and escaped arguments, and needs to refuse all commands which need
+ * other shell features, as these are passed to system(). spawn_command needs
+ * to pass these words unchanged to the program and report its exit status.
+ */
+
+#include <config.h>
+
+#include "scorep_instrumenter_utils.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int errors = 0;
+
+static string
+join( const vector<string>& words )
+{
+    string result;
+    for ( vector<string>::const_iterator word = words.begin();
+          word != words.end();
+          word++ )
+    {
+        result += "<" + *word + ">";
+    }
+    return result;
+}
+
+static void
+expect_words( const string& command,
+              const string& expected )
+{
+    vector<string> words;
+    if ( !split_shell_command( command, words ) )
+    {
+        cerr << "Command [" << command << "] was not split, expected "
+             << expected << endl;
+        errors++;
+    }
+    else if ( join( words ) != expected )
+    {
+        cerr << "Command [" << command << "] was split into " << join( words )
+             << ", expected " << expected << endl;
+        errors++;
+    }
+}
+
+static void
+expect_shell( const string& command )
+{
+    vector<string> words;
+    if ( split_shell_command( command, words ) )
+    {
+        cerr << "Command [" << command << "] needs a shell, but was split into "
+             << join( words ) << endl;
+        errors++;
+    }
+}
+
+static void
+expect_spawn( const string& command,
+              int           expected_status,
+              const string& expected_output )
+{
+    vector<string> words;
+    string         output;
+    if ( !split_shell_command( command, words ) )
+    {
+        cerr << "Command [" << command << "] was not split" << endl;
+        errors++;
+        return;
+    }
+    int status = spawn_command( words, &output );
+    if ( status != expected_status || output != expected_output )
+    {
+        cerr << "Command [" << command << "] exited with " << status
+             << " and printed [" << output << "], expected " << expected_status
+             << " and [" << expected_output << "]" << endl;
+        errors++;
+    }
+}
+
+int
+main( void )
+{
+    /* Plain words */
+    expect_words( "gcc -c foo.c", "<gcc><-c><foo.c>" );
+    expect_words( "  gcc\t-c \n foo.c  ", "<gcc><-c><foo.c>" );
+    expect_words( "gcc -DVALUE=1 -o foo.o", "<gcc><-DVALUE=1><-o><foo.o>" );
+    expect_words( "/usr/bin/gcc -c a+b.c", "</usr/bin/gcc><-c><a+b.c>" );
+
+    /* Quoting, as done by backslash_special_chars and add_define */
+    expect_words( "gcc -DNAME=\\\"a\\ b\\\" -c foo.c", "<gcc><-DNAME=\"a b\"><-c><foo.c>" );
+    expect_words( "gcc -DNAME=\"\\\"a b\\\"\"", "<gcc><-DNAME=\"a b\">" );
+    expect_words( "gcc '-DNAME=\"a b\"'", "<gcc><-DNAME=\"a b\">" );
+    expect_words( "gcc -I'dir with space'/include", "<gcc><-Idir with space/include>" );
+    expect_words( "echo 'it'\\''s'", "<echo><it's>" );
+    expect_words( "echo 'a\\b' \"a\\b\" a\\\\b", "<echo><a\\b><a\\b><a\\b>" );
+    expect_words( "echo \"a\\\\b\" \"\\$HOME\" \"\\`\"", "<echo><a\\b><$HOME><`>" );
+    expect_words( "echo \\$HOME \\* \\; \\|", "<echo><$HOME><*><;><|>" );
+    expect_words( "echo '$HOME' '*.c' 'a|b' '#'", "<echo><$HOME><*.c><a|b><#>" );
+    expect_words( "echo a#b a~b", "<echo><a#b><a~b>" );
+
+    /* Empty arguments are kept, removed line continuations are not */
+    expect_words( "echo '' \"\" x", "<echo><><><x>" );
+    expect_words( "echo a\\\nb \\\n c", "<echo><ab><c>" );
+
+    /* Assignments are only recognized in the first word */
+    expect_words( "\"CC\"=gcc", "<CC=gcc>" );
+    expect_words( "1CC=gcc", "<1CC=gcc>" );
+    expect_words( "env CC=gcc make", "<env><CC=gcc><make>" );
+
+    /* Commands which need the shell */
+    expect_shell( "" );
+    expect_shell( " \t\n" );
+    expect_shell( "CC=gcc make" );
+    expect_shell( "gcc -c foo.c > log" );
+    expect_shell( "gcc -c foo.c 2>&1" );
+    expect_shell( "gcc -c foo.c | tee log" );
+    expect_shell( "gcc -c foo.c; rm foo.o" );
+    expect_shell( "gcc -c foo.c && rm foo.o" );
+    expect_shell( "gcc `scorep-config --cflags` -c foo.c" );
+    expect_shell( "gcc $(scorep-config --cflags) -c foo.c" );
+    expect_shell( "gcc $CFLAGS -c foo.c" );
+    expect_shell( "gcc \"$CFLAGS\" -c foo.c" );
+    expect_shell( "gcc -c *.c" );
+    expect_shell( "gcc -c foo.[ch]" );
+    expect_shell( "gcc -c ~/foo.c" );
+    expect_shell( "gcc -c foo.c # comment" );
+    expect_shell( "gcc (foo.c)" );
+    expect_shell( "gcc 'foo.c" );
+    expect_shell( "gcc \"foo.c" );
+    expect_shell( "gcc foo.c\\" );
+
+    /* The program gets the words unchanged */
+    expect_spawn( "printf '%s|' 'a b' \"c\\\"d\" e\\ f ''", 0, "a b|c\"d|e f||" );
+    expect_spawn( "sh -c 'exit 3'", 3, "" );
+    expect_spawn( "sh -c 'kill -9 $$'", -1, "" );
+
+    /* A missing program is reported by the child */
+    vector<string> words;
+    words.push_back( "scorep-instrumenter-utils-test-missing-program" );
+    int status = spawn_command( words, NULL );
+    if ( status != 127 )
+    {
+        cerr << "Missing program exited with " << status << ", expected 127" << endl;
+        errors++;
+    }
+
+    cout << "instrumenter utils: " << ( errors == 0 ? "ok" : "failed" ) << endl;
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
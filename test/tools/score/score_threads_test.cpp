@@ -0,0 +1,186 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * @brief Checks that the estimation of scorep-score does not depend on the
+ *        number of evaluating threads.
+ *
+ * Builds a profile of several processes with a call tree spanning multiple
+ * batches of call tree nodes and compares the group and region output of an
+ * evaluation with one thread to evaluations with more threads. The times are
+ * multiples of a power of two, thus their sums do not depend on the order of
+ * the additions.
+ */
+
+#include <config.h>
+
+#include "SCOREP_Score_Profile.hpp"
+#include "SCOREP_Score_Estimator.hpp"
+
+#include <Cube.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace cube;
+
+#define NUMBER_OF_PROCESSES 7
+#define NUMBER_OF_THREADS   2
+#define NUMBER_OF_FUNCTIONS 40
+#define NUMBER_OF_CALLEES   30
+
+static Cube*
+create_profile( void )
+{
+    Cube* cube = new Cube();
+
+    Metric* visits      = cube->def_met( "Visits", "visits", "UINT64", "occ", "", "",
+                                         "Number of visits", NULL, CUBE_METRIC_EXCLUSIVE );
+    Metric* time_metric = cube->def_met( "Time", "time", "DOUBLE", "sec", "", "",
+                                         "Total CPU allocation time", NULL, CUBE_METRIC_INCLUSIVE );
+
+    string           mod  = "score_threads_test.c";
+    Region*          main = cube->def_region( "main", "main", "user", "function",
+                                              1, 10, "", "", mod );
+    vector<Region*>  functions;
+    vector<Region*>  callees;
+    for ( int i = 0; i < NUMBER_OF_FUNCTIONS; i++ )
+    {
+        ostringstream name;
+        name << "function_" << i;
+        functions.push_back( cube->def_region( name.str(), name.str(), "user", "function",
+                                               10 + i, 11 + i, "", "", mod ) );
+    }
+    const char* mpi_names[] = { "MPI_Send", "MPI_Recv", "MPI_Barrier" };
+    for ( int i = 0; i < NUMBER_OF_CALLEES; i++ )
+    {
+        ostringstream name;
+        if ( i < 3 )
+        {
+            name << mpi_names[ i ];
+            callees.push_back( cube->def_region( name.str(), name.str(), "mpi", "function",
+                                                 -1, -1, "", "", "MPI" ) );
+        }
+        else
+        {
+            name << "callee_" << i;
+            callees.push_back( cube->def_region( name.str(), name.str(), "user", "function",
+                                                 100 + i, 101 + i, "", "", mod ) );
+        }
+    }
+
+    vector<Cnode*> cnodes;
+    Cnode*         root = cube->def_cnode( main, mod, 1, NULL );
+    cnodes.push_back( root );
+    for ( int i = 0; i < NUMBER_OF_FUNCTIONS; i++ )
+    {
+        Cnode* function = cube->def_cnode( functions[ i ], mod, 2, root );
+        cnodes.push_back( function );
+        for ( int j = 0; j < NUMBER_OF_CALLEES; j++ )
+        {
+            cnodes.push_back( cube->def_cnode( callees[ j ], mod, 3 + j, function ) );
+        }
+    }
+
+    Machine*        machine = cube->def_mach( "machine", "" );
+    Node*           node    = cube->def_node( "node", machine );
+    vector<Thread*> threads;
+    for ( int p = 0; p < NUMBER_OF_PROCESSES; p++ )
+    {
+        ostringstream name;
+        name << "rank " << p;
+        Process* process = cube->def_proc( name.str(), p, node );
+        for ( int t = 0; t < NUMBER_OF_THREADS; t++ )
+        {
+            ostringstream thread_name;
+            thread_name << "thread " << t;
+            threads.push_back( cube->def_thrd( thread_name.str(), t, process ) );
+        }
+    }
+
+    cube->initialize();
+
+    /* The time is inclusive, the children follow their parent in cnodes */
+    vector<double> inclusive( cnodes.size() * threads.size() );
+    for ( size_t c = cnodes.size(); c > 0; c-- )
+    {
+        Cnode* cnode = cnodes[ c - 1 ];
+        for ( size_t l = 0; l < threads.size(); l++ )
+        {
+            uint64_t n    = ( c * 7919 + l * 104729 ) % 97;
+            double&  time = inclusive[ ( c - 1 ) * threads.size() + l ];
+            time += ( n + 1 ) * 0.125;
+            cube->set_sev( visits, cnode, threads[ l ], ( double )( n + 1 ) );
+            cube->set_sev( time_metric, cnode, threads[ l ], time );
+            if ( cnode->get_parent() )
+            {
+                inclusive[ cnode->get_parent()->get_id() * threads.size() + l ] += time;
+            }
+        }
+    }
+
+    return cube;
+}
+
+
+static string
+estimate( Cube*    cube,
+          uint32_t numberOfThreads )
+{
+    SCOREP_Score_Profile   profile( cube );
+    SCOREP_Score_Estimator estimator( &profile, 0 );
+
+    /* The printing leaves format flags of cout set */
+    ostringstream      output;
+    streambuf*         cout_buffer = cout.rdbuf( output.rdbuf() );
+    ios_base::fmtflags cout_flags  = cout.flags();
+    estimator.calculate( true, false, numberOfThreads );
+    estimator.printGroups();
+    estimator.printRegions();
+    cout.flags( cout_flags );
+    cout.rdbuf( cout_buffer );
+
+    return output.str();
+}
+
+
+int
+main( void )
+{
+    Cube*  cube     = create_profile();
+    string expected = estimate( cube, 1 );
+
+    int result = EXIT_SUCCESS;
+    for ( uint32_t threads = 2; threads <= NUMBER_OF_PROCESSES + 1; threads += 3 )
+    {
+        string output = estimate( cube, threads );
+        if ( output != expected )
+        {
+            cerr << "Output with " << threads << " threads differs:" << endl
+                 << output << endl
+                 << "Output with 1 thread:" << endl
+                 << expected << endl;
+            result = EXIT_FAILURE;
+        }
+    }
+    cout << expected;
+
+    delete cube;
+    return result;
+}
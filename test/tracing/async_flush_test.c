@@ -0,0 +1,49 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Records enough events to trigger several intermediate trace buffer
+ *        flushes. Run with SCOREP_TRACING_ASYNC_FLUSH_SIZE to write them in
+ *        the background.
+ */
+
+
+#include <config.h>
+#include <scorep/SCOREP_User.h>
+#include <stdio.h>
+
+
+#define NUM_ITERATIONS 500000
+
+
+static void
+work( void )
+{
+    SCOREP_USER_REGION_DEFINE( work );
+    SCOREP_USER_REGION_BEGIN( work, "work", SCOREP_USER_REGION_TYPE_FUNCTION );
+    SCOREP_USER_REGION_END( work );
+}
+
+
+int
+main( int argc, char* argv[] )
+{
+    for ( int i = 0; i < NUM_ITERATIONS; i++ )
+    {
+        work();
+    }
+
+    return 0;
+}
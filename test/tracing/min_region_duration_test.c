@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Forschungszentrum Juelich GmbH, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Visits the region 'short' NUM_SHORT times without any work and the
+ *        region 'long' NUM_LONG times for LONG_DURATION nanoseconds, each
+ *        with a visit of 'short' inside. Run with
+ *        SCOREP_TRACING_MIN_REGION_DURATION between both durations, only the
+ *        visits of 'long' need to reach the trace.
+ */
+
+
+#include <config.h>
+#include <scorep/SCOREP_User.h>
+#include <stdint.h>
+#include <time.h>
+
+
+#define NUM_SHORT     1000
+#define NUM_LONG      5
+#define LONG_DURATION UINT64_C( 20000000 )
+
+
+static uint64_t
+get_time( void )
+{
+    struct timespec time;
+    clock_gettime( CLOCK_MONOTONIC, &time );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+}
+
+
+static void
+short_region( void )
+{
+    SCOREP_USER_REGION_DEFINE( short_handle );
+    SCOREP_USER_REGION_BEGIN( short_handle, "short", SCOREP_USER_REGION_TYPE_FUNCTION );
+    SCOREP_USER_REGION_END( short_handle );
+}
+
+
+static void
+long_region( void )
+{
+    SCOREP_USER_REGION_DEFINE( long_handle );
+    SCOREP_USER_REGION_BEGIN( long_handle, "long", SCOREP_USER_REGION_TYPE_FUNCTION );
+    short_region();
+    uint64_t begin = get_time();
+    while ( get_time() - begin < LONG_DURATION )
+    {
+    }
+    SCOREP_USER_REGION_END( long_handle );
+}
+
+
+int
+main( int argc, char* argv[] )
+{
+    for ( int i = 0; i < NUM_SHORT; i++ )
+    {
+        short_region();
+    }
+    for ( int i = 0; i < NUM_LONG; i++ )
+    {
+        long_region();
+    }
+
+    return 0;
+}